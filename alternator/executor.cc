@@ -45,6 +45,7 @@
 #include "db/tags/utils.hh"
 #include "alternator/rmw_operation.hh"
 #include <seastar/core/coroutine.hh>
+#include <seastar/coroutine/maybe_yield.hh>
 #include <boost/range/adaptors.hpp>
 #include <boost/range/algorithm/find_end.hpp>
 #include <unordered_set>
@@ -3164,10 +3165,9 @@ static void check_big_object(const rjson::value& val, int& size_left) {
 
 future<executor::request_return_type> executor::batch_get_item(client_state& client_state, tracing::trace_state_ptr trace_state, service_permit permit, rjson::value request) {
     // FIXME: In this implementation, an unbounded batch size can cause
-    // unbounded response JSON object to be buffered in memory, unbounded
-    // parallelism of the requests, and unbounded amount of non-preemptable
-    // work in the following loops. So we should limit the batch size, and/or
-    // the response size, as DynamoDB does.
+    // unbounded parallelism of the requests, and unbounded amount of
+    // non-preemptable work in the following loops. So we should limit the
+    // batch size, as DynamoDB does.
     _stats.api_operations.batch_get_item++;
     rjson::value& request_items = request["RequestItems"];
 
@@ -3219,43 +3219,86 @@ future<executor::request_return_type> executor::batch_get_item(client_state& cli
         requests.emplace_back(std::move(rs));
     }
 
-    // If we got here, all "requests" are valid, so let's start the
-    // requests for the different partitions all in parallel.
-    std::vector<future<std::vector<rjson::value>>> response_futures;
+    // If we got here, all "requests" are valid. The partitions of a table
+    // without a clustering key are read together, one read of up to
+    // max_partitions_per_read partitions for the partitions which have the
+    // same replicas. A partition of a table with a clustering key is read on
+    // its own, as the slice of a read can't select different rows in
+    // different partitions. All the reads are started in parallel.
+    static constexpr size_t max_partitions_per_read = 16;
+    struct read_group {
+        const table_requests* rs;
+        std::vector<std::pair<dht::decorated_key, const table_requests::clustering_keys*>> partitions;
+    };
+    std::vector<read_group> groups;
     for (const auto& rs : requests) {
-        for (const auto &r : rs.requests) {
-            auto& pk = r.first;
-            auto& cks = r.second;
-            dht::partition_range_vector partition_ranges{dht::partition_range(dht::decorate_key(*rs.schema, pk))};
-            std::vector<query::clustering_range> bounds;
-            if (rs.schema->clustering_key_size() == 0) {
-                bounds.push_back(query::clustering_range::make_open_ended_both_sides());
-            } else {
-                for (auto& ck : cks) {
-                    bounds.push_back(query::clustering_range::make_singular(ck.first));
-                }
+        if (rs.schema->clustering_key_size() != 0) {
+            for (const auto& r : rs.requests) {
+                groups.push_back(read_group{&rs, {}});
+                groups.back().partitions.emplace_back(dht::decorate_key(*rs.schema, r.first), &r.second);
             }
-            auto regular_columns = boost::copy_range<query::column_id_vector>(
-                    rs.schema->regular_columns() | boost::adaptors::transformed([] (const column_definition& cdef) { return cdef.id; }));
-            auto selection = cql3::selection::selection::wildcard(rs.schema);
-            auto partition_slice = query::partition_slice(std::move(bounds), {}, std::move(regular_columns), selection->get_query_options());
-            auto command = ::make_lw_shared<query::read_command>(rs.schema->id(), rs.schema->version(), partition_slice, _proxy.get_max_result_size(partition_slice),
-                    query::tombstone_limit(_proxy.get_tombstone_limit()));
-            command->allow_limit = db::allow_per_partition_rate_limit::yes;
-            future<std::vector<rjson::value>> f = _proxy.query(rs.schema, std::move(command), std::move(partition_ranges), rs.cl,
-                    service::storage_proxy::coordinator_query_options(executor::default_timeout(), permit, client_state, trace_state)).then(
-                    [schema = rs.schema, partition_slice = std::move(partition_slice), selection = std::move(selection), attrs_to_get = rs.attrs_to_get] (service::storage_proxy::coordinator_query_result qr) mutable {
-                utils::get_local_injector().inject("alternator_batch_get_item", [] { throw std::runtime_error("batch_get_item injection"); });
-                std::vector<rjson::value> jsons = describe_multi_item(schema, partition_slice, *selection, *qr.query_result, *attrs_to_get);
-                return make_ready_future<std::vector<rjson::value>>(std::move(jsons));
-            });
-            response_futures.push_back(std::move(f));
+            continue;
+        }
+        auto erm = _proxy.local_db().find_keyspace(rs.schema->ks_name()).get_effective_replication_map();
+        std::map<std::vector<gms::inet_address>, size_t> group_of_replicas;
+        for (const auto& r : rs.requests) {
+            auto dk = dht::decorate_key(*rs.schema, r.first);
+            auto eps = erm->get_natural_endpoints(dk.token());
+            auto [it, inserted] = group_of_replicas.emplace(std::vector<gms::inet_address>(eps.begin(), eps.end()), groups.size());
+            if (!inserted && groups[it->second].partitions.size() >= max_partitions_per_read) {
+                it->second = groups.size();
+                inserted = true;
+            }
+            if (inserted) {
+                groups.push_back(read_group{&rs, {}});
+            }
+            groups[it->second].partitions.emplace_back(std::move(dk), &r.second);
         }
     }
 
+    std::vector<future<std::vector<rjson::value>>> response_futures;
+    for (auto& group : groups) {
+        const auto& rs = *group.rs;
+        std::sort(group.partitions.begin(), group.partitions.end(), [less = dht::decorated_key::less_comparator(rs.schema)] (const auto& a, const auto& b) {
+            return less(a.first, b.first);
+        });
+        dht::partition_range_vector partition_ranges;
+        for (const auto& p : group.partitions) {
+            partition_ranges.push_back(dht::partition_range(p.first));
+        }
+        std::vector<query::clustering_range> bounds;
+        if (rs.schema->clustering_key_size() == 0) {
+            bounds.push_back(query::clustering_range::make_open_ended_both_sides());
+        } else {
+            for (auto& ck : *group.partitions.front().second) {
+                bounds.push_back(query::clustering_range::make_singular(ck.first));
+            }
+        }
+        auto regular_columns = boost::copy_range<query::column_id_vector>(
+                rs.schema->regular_columns() | boost::adaptors::transformed([] (const column_definition& cdef) { return cdef.id; }));
+        auto selection = cql3::selection::selection::wildcard(rs.schema);
+        auto partition_slice = query::partition_slice(std::move(bounds), {}, std::move(regular_columns), selection->get_query_options());
+        auto command = ::make_lw_shared<query::read_command>(rs.schema->id(), rs.schema->version(), partition_slice, _proxy.get_max_result_size(partition_slice),
+                query::tombstone_limit(_proxy.get_tombstone_limit()));
+        command->allow_limit = db::allow_per_partition_rate_limit::yes;
+        future<std::vector<rjson::value>> f = _proxy.query(rs.schema, std::move(command), std::move(partition_ranges), rs.cl,
+                service::storage_proxy::coordinator_query_options(executor::default_timeout(), permit, client_state, trace_state)).then(
+                [schema = rs.schema, partition_slice = std::move(partition_slice), selection = std::move(selection), attrs_to_get = rs.attrs_to_get] (service::storage_proxy::coordinator_query_result qr) mutable {
+            utils::get_local_injector().inject("alternator_batch_get_item", [] { throw std::runtime_error("batch_get_item injection"); });
+            std::vector<rjson::value> jsons = describe_multi_item(schema, partition_slice, *selection, *qr.query_result, *attrs_to_get);
+            return make_ready_future<std::vector<rjson::value>>(std::move(jsons));
+        });
+        response_futures.push_back(std::move(f));
+    }
+
     // Wait for all requests to complete, and then return the response.
     // In case of full failure (no reads succeeded), an arbitrary error
-    // from one of the operations will be returned.
+    // from one of the operations will be returned. Like DynamoDB, we don't
+    // return more than max_response_size of items: the keys of the reads
+    // which complete after the response is that big are returned in
+    // UnprocessedKeys, as are the keys of the reads which failed.
+    static constexpr int max_response_size = 16 * 1024 * 1024;
+    int response_size_left = max_response_size;
     bool some_succeeded = false;
     std::exception_ptr eptr;
 
@@ -3263,47 +3306,57 @@ future<executor::request_return_type> executor::batch_get_item(client_state& cli
     rjson::add(response, "Responses", rjson::empty_object());
     rjson::add(response, "UnprocessedKeys", rjson::empty_object());
 
-    auto fut_it = response_futures.begin();
-    for (const auto& rs : requests) {
-        auto table = table_name(*rs.schema);
-        for (const auto &r : rs.requests) {
-            auto& pk = r.first;
-            auto& cks = r.second;
-            auto& fut = *fut_it;
-            ++fut_it;
-            try {
-                std::vector<rjson::value> results = co_await std::move(fut);
-                some_succeeded = true;
-                if (!response["Responses"].HasMember(table)) {
-                    rjson::add_with_string_name(response["Responses"], table, rjson::empty_array());
-                }
-                for (rjson::value& json : results) {
-                    rjson::push_back(response["Responses"][table], std::move(json));
+    auto add_unprocessed = [&] (const sstring& table, const table_requests::clustering_keys& cks) {
+        if (!response["UnprocessedKeys"].HasMember(table)) {
+            // Add the table's entry in UnprocessedKeys. Need to copy
+            // all the table's parameters from the request except the
+            // Keys field, which we start empty and then build below.
+            rjson::add_with_string_name(response["UnprocessedKeys"], table, rjson::empty_object());
+            rjson::value& unprocessed_item = response["UnprocessedKeys"][table];
+            rjson::value& request_item = request_items[table];
+            for (auto it = request_item.MemberBegin(); it != request_item.MemberEnd(); ++it) {
+                if (it->name != "Keys") {
+                    rjson::add_with_string_name(unprocessed_item,
+                        rjson::to_string_view(it->name), rjson::copy(it->value));
                 }
-            } catch(...) {
-                eptr = std::current_exception();
-                // This read of potentially several rows in one partition,
-                // failed. We need to add the row key(s) to UnprocessedKeys.
-                if (!response["UnprocessedKeys"].HasMember(table)) {
-                    // Add the table's entry in UnprocessedKeys. Need to copy
-                    // all the table's parameters from the request except the
-                    // Keys field, which we start empty and then build below.
-                    rjson::add_with_string_name(response["UnprocessedKeys"], table, rjson::empty_object());
-                    rjson::value& unprocessed_item = response["UnprocessedKeys"][table];
-                    rjson::value& request_item = request_items[table];
-                    for (auto it = request_item.MemberBegin(); it != request_item.MemberEnd(); ++it) {
-                        if (it->name != "Keys") {
-                            rjson::add_with_string_name(unprocessed_item,
-                                rjson::to_string_view(it->name), rjson::copy(it->value));
-                        }
-                    }
-                    rjson::add_with_string_name(unprocessed_item, "Keys", rjson::empty_array());
-                }
-                for (auto& ck : cks) {
-                    rjson::push_back(response["UnprocessedKeys"][table]["Keys"], std::move(*ck.second));
+            }
+            rjson::add_with_string_name(unprocessed_item, "Keys", rjson::empty_array());
+        }
+        for (auto& ck : cks) {
+            rjson::push_back(response["UnprocessedKeys"][table]["Keys"], std::move(*ck.second));
+        }
+    };
+
+    auto fut_it = response_futures.begin();
+    for (const auto& group : groups) {
+        auto table = table_name(*group.rs->schema);
+        auto& fut = *fut_it;
+        ++fut_it;
+        try {
+            std::vector<rjson::value> results = co_await std::move(fut);
+            some_succeeded = true;
+            if (response_size_left < 0) {
+                for (const auto& p : group.partitions) {
+                    add_unprocessed(table, *p.second);
                 }
+                continue;
+            }
+            if (!response["Responses"].HasMember(table)) {
+                rjson::add_with_string_name(response["Responses"], table, rjson::empty_array());
+            }
+            for (rjson::value& json : results) {
+                check_big_object(json, response_size_left);
+                rjson::push_back(response["Responses"][table], std::move(json));
+            }
+        } catch(...) {
+            eptr = std::current_exception();
+            // This read of potentially several rows in several partitions
+            // failed. We need to add the row key(s) to UnprocessedKeys.
+            for (const auto& p : group.partitions) {
+                add_unprocessed(table, *p.second);
             }
         }
+        co_await coroutine::maybe_yield();
     }
     elogger.trace("Unprocessed keys: {}", response["UnprocessedKeys"]);
     if (!some_succeeded && eptr) {
@@ -3524,6 +3577,15 @@ class describe_items_visitor {
     }
 
     void end_row() {
+        if (auto item = finish_row()) {
+            rjson::push_back(_items, std::move(*item));
+        }
+    }
+
+    // Ends the row like end_row(), but returns its item, or nullopt if the
+    // filter rejected it, instead of adding it to the items.
+    std::optional<rjson::value> finish_row() {
+        std::optional<rjson::value> ret;
         if (_filter.check(_item)) {
             // As noted above, we kept entire top-level attributes listed in
             // _attrs_to_get. We may need to only keep parts of them.
@@ -3545,10 +3607,11 @@ class describe_items_visitor {
                 rjson::remove_member(_item, attr);
             }
 
-            rjson::push_back(_items, std::move(_item));
+            ret = std::move(_item);
         }
         _item = rjson::empty_object();
         ++_scanned_count;
+        return ret;
     }
 
     rjson::value get_items() && {
@@ -3582,6 +3645,76 @@ static std::tuple<rjson::value, size_t> describe_items(schema_ptr schema, const
     return {std::move(items_descr), size};
 }
 
+struct streamed_items_state {
+    std::unique_ptr<cql3::result_set> rs;
+    ::shared_ptr<cql3::selection::selection> sel;
+    std::optional<attrs_to_get> attrs;
+    filter item_filter;
+    std::optional<rjson::value> last_key;
+    cql3::cql_stats& stats;
+};
+
+// Query and Scan pages of more rows than this are streamed by
+// make_streamed_items(). Smaller pages are described into a single document,
+// which costs less than a streamed response for a few items.
+static constexpr size_t max_rows_for_single_document = 10;
+
+// Makes the response of a Query or Scan, streaming it like make_streamed(),
+// but describing the items of the result set one by one as they are written,
+// instead of building a document of all of them first. Count and
+// ScannedCount are only known once the filter saw all rows, so they follow
+// the items.
+static json::json_return_type make_streamed_items(std::unique_ptr<cql3::result_set> result_set, ::shared_ptr<cql3::selection::selection> selection,
+        std::optional<attrs_to_get>&& attrs_to_get, filter&& filter, std::optional<rjson::value>&& last_evaluated_key, cql3::cql_stats& cql_stats) {
+    auto st = make_shared<streamed_items_state>(streamed_items_state{std::move(result_set), std::move(selection), std::move(attrs_to_get), std::move(filter), std::move(last_evaluated_key), cql_stats});
+    std::function<future<>(output_stream<char>&&)> func = [st] (output_stream<char>&& os) mutable -> future<> {
+        auto los = std::move(os);
+        auto lst = std::move(st);
+        try {
+            // As in describe_items(), Select=COUNT returns no Items.
+            const bool with_items = !lst->attrs || !lst->attrs->empty();
+            const bool has_filter = bool(lst->item_filter);
+            describe_items_visitor visitor(lst->sel->get_columns(), lst->attrs, lst->item_filter);
+            const auto column_count = lst->rs->get_metadata().column_count();
+            size_t count = 0;
+            co_await los.write(with_items ? "{\"Items\":[" : "{");
+            for (const auto& row : lst->rs->rows()) {
+                visitor.start_row();
+                for (size_t i = 0; i < column_count; ++i) {
+                    const auto& cell = row[i];
+                    visitor.accept_value(cell ? std::optional<query::result_bytes_view>(*cell) : std::optional<query::result_bytes_view>());
+                }
+                if (auto item = visitor.finish_row()) {
+                    if (with_items) {
+                        if (count) {
+                            co_await los.write(",");
+                        }
+                        co_await los.write(rjson::print(*item));
+                    }
+                    ++count;
+                }
+                co_await coroutine::maybe_yield();
+            }
+            co_await los.write(format("{}\"Count\":{},\"ScannedCount\":{}", with_items ? "]," : "", count, visitor.get_scanned_count()));
+            if (lst->last_key) {
+                co_await los.write(",\"LastEvaluatedKey\":");
+                co_await los.write(rjson::print(*lst->last_key));
+            }
+            co_await los.write("}");
+            if (has_filter) {
+                lst->stats.filtered_rows_matched_total += count;
+            }
+            co_await los.flush();
+            co_await los.close();
+        } catch (...) {
+            // As in make_streamed(), the headers are already written.
+            elogger.error("Unhandled exception in data streaming: {}", std::current_exception());
+            throw;
+        }
+    };
+    return func;
+}
+
 static rjson::value encode_paging_state(const schema& schema, const service::pager::paging_state& paging_state) {
     rjson::value last_evaluated_key = rjson::empty_object();
     std::vector<bytes> exploded_pk = paging_state.get_partition_key().explode();
@@ -3664,7 +3797,7 @@ static future<executor::request_return_type> do_query(service::storage_proxy& pr
     auto p = service::pager::query_pagers::pager(proxy, schema, selection, *query_state_ptr, *query_options, command, std::move(partition_ranges), nullptr);
 
     return p->fetch_page(limit, gc_clock::now(), executor::default_timeout()).then(
-            [p = std::move(p), schema, cql_stats, partition_slice = std::move(partition_slice),
+            [p = std::move(p), schema, &cql_stats = cql_stats, partition_slice = std::move(partition_slice),
              selection = std::move(selection), query_state_ptr = std::move(query_state_ptr),
              attrs_to_get = std::move(attrs_to_get),
              query_options = std::move(query_options),
@@ -3674,19 +3807,25 @@ static future<executor::request_return_type> do_query(service::storage_proxy& pr
         }
         auto paging_state = rs->get_metadata().paging_state();
         bool has_filter = filter;
+        if (has_filter) {
+            cql_stats.filtered_rows_read_total += p->stats().rows_read_total;
+        }
+        if (rs->size() > max_rows_for_single_document) {
+            std::optional<rjson::value> last_evaluated_key;
+            if (paging_state) {
+                last_evaluated_key = encode_paging_state(*schema, *paging_state);
+            }
+            return make_ready_future<executor::request_return_type>(make_streamed_items(std::move(rs), std::move(selection),
+                    std::move(attrs_to_get), std::move(filter), std::move(last_evaluated_key), cql_stats));
+        }
         auto [items, size] = describe_items(schema, partition_slice, *selection, std::move(rs), std::move(attrs_to_get), std::move(filter));
         if (paging_state) {
             rjson::add(items, "LastEvaluatedKey", encode_paging_state(*schema, *paging_state));
         }
         if (has_filter){
-            cql_stats.filtered_rows_read_total += p->stats().rows_read_total;
             // update our "filtered_row_matched_total" for all the rows matched, despited the filter
             cql_stats.filtered_rows_matched_total += size;
         }
-        // TODO: better threshold
-        if (size > 10) {
-            return make_ready_future<executor::request_return_type>(make_streamed(std::move(items)));
-        }
         return make_ready_future<executor::request_return_type>(make_jsonable(std::move(items)));
     });
 }
@@ -878,11 +878,12 @@ future<executor::request_return_type> executor::get_records(client_state& client
     if (opts.postimage()) {
         ++mul;
     }
+    const uint64_t row_limit = limit * mul;
     auto command = ::make_lw_shared<query::read_command>(schema->id(), schema->version(), partition_slice, _proxy.get_max_result_size(partition_slice),
-            query::tombstone_limit(_proxy.get_tombstone_limit()), query::row_limit(limit * mul));
+            query::tombstone_limit(_proxy.get_tombstone_limit()), query::row_limit(row_limit));
 
     return _proxy.query(schema, std::move(command), std::move(partition_ranges), cl, service::storage_proxy::coordinator_query_options(default_timeout(), std::move(permit), client_state)).then(
-            [this, schema, partition_slice = std::move(partition_slice), selection = std::move(selection), start_time = std::move(start_time), limit, key_names = std::move(key_names), attr_names = std::move(attr_names), type, iter, high_ts] (service::storage_proxy::coordinator_query_result qr) mutable {       
+            [this, schema, partition_slice = std::move(partition_slice), selection = std::move(selection), start_time = std::move(start_time), limit, key_names = std::move(key_names), attr_names = std::move(attr_names), type, iter, high_ts, high_uuid, row_limit] (service::storage_proxy::coordinator_query_result qr) mutable {
         cql3::selection::result_set_builder builder(*selection, gc_clock::now(), cql_serialization_format::latest());
         query::result_view::consume(*qr.query_result, partition_slice, cql3::selection::result_set_builder::visitor(builder, *schema, *selection));
 
@@ -928,7 +929,9 @@ future<executor::request_return_type> executor::get_records(client_state& client
             }
         };
 
+        size_t rows_described = 0;
         for (auto& row : result_set->rows()) {
+            ++rows_described;
             auto op = static_cast<cdc::operation>(value_cast<op_utype>(data_type_for<op_utype>()->deserialize(*row[op_index])));
             auto ts = value_cast<utils::UUID>(data_type_for<utils::UUID>()->deserialize(*row[ts_index]));
             auto eor = row[eor_index].has_value() ? value_cast<bool>(boolean_type->deserialize(*row[eor_index])) : false;
@@ -993,13 +996,29 @@ future<executor::request_return_type> executor::get_records(client_state& client
             }
         }
 
+        // If all the rows until high_ts were read, and all of them were
+        // described in the records, the next read can start from high_ts:
+        // the rows before it are not expected to change any more, so they
+        // don't have to be read again, which saves polling consumers from
+        // reading the same range of the log, and its tombstones, over and
+        // over. The threshold of the iterator can be after high_ts if the
+        // clock of the node which made it is ahead of ours, and mustn't go
+        // back.
+        const bool read_to_high_ts = !qr.query_result->is_short_read()
+                && result_set->size() < row_limit
+                && rows_described == result_set->size()
+                && dynamodb.ObjectEmpty() && record.ObjectEmpty()
+                && utils::timeuuid_tri_compare(iter.threshold.serialize(), high_uuid.serialize()) < 0;
+
         auto ret = rjson::empty_object();
         auto nrecords = records.Size();
         rjson::add(ret, "Records", std::move(records));
 
         if (nrecords != 0) {
             // #9642. Set next iterators threshold to > last
-            shard_iterator next_iter(iter.table, iter.shard, *timestamp, false);
+            shard_iterator next_iter = read_to_high_ts
+                    ? shard_iterator(iter.table, iter.shard, high_uuid, true)
+                    : shard_iterator(iter.table, iter.shard, *timestamp, false);
             // Note that here we unconditionally return NextShardIterator,
             // without checking if maybe we reached the end-of-shard. If the
             // shard did end, then the next read will have nrecords == 0 and
@@ -1012,7 +1031,7 @@ future<executor::request_return_type> executor::get_records(client_state& client
         // ugh. figure out if we are and end-of-shard
         auto normal_token_owners = _proxy.get_token_metadata_ptr()->count_normal_token_owners();
 
-        return _sdks.cdc_current_generation_timestamp({ normal_token_owners }).then([this, iter, high_ts, start_time, ret = std::move(ret), nrecords](db_clock::time_point ts) mutable {
+        return _sdks.cdc_current_generation_timestamp({ normal_token_owners }).then([this, iter, high_ts, high_uuid, read_to_high_ts, start_time, ret = std::move(ret), nrecords](db_clock::time_point ts) mutable {
             auto& shard = iter.shard;            
 
             if (shard.time < ts && ts < high_ts) {
@@ -1020,12 +1039,11 @@ future<executor::request_return_type> executor::get_records(client_state& client
                 // closed, reading it until the end has NextShardIterator
                 // "set to null". Our test test_streams_closed_read
                 // confirms that by "null" they meant not set at all.
+            } else if (read_to_high_ts) {
+                // We did a search from the iterator until high_ts and found
+                // nothing, so we can start the next search from high_ts.
+                rjson::add(ret, "NextShardIterator", shard_iterator(iter.table, iter.shard, high_uuid, true));
             } else {
-                // We could have return the same iterator again, but we did
-                // a search from it until high_ts and found nothing, so we
-                // can also start the next search from high_ts.
-                // TODO: but why? It's simpler just to leave the iterator be.
-                shard_iterator next_iter(iter.table, iter.shard, utils::UUID_gen::min_time_UUID(high_ts.time_since_epoch()), true);
                 rjson::add(ret, "NextShardIterator", iter);
             }
             _stats.api_operations.get_records_latency.add(std::chrono::steady_clock::now() - start_time);
@@ -242,10 +242,9 @@ static future<> expire_item(service::storage_proxy& proxy,
                             schema_ptr schema,
                             api::timestamp_type ts) {
     // Prepare the row key to delete
-    // NOTICE: the order of columns is guaranteed by the fact that selection::wildcard
-    // is used, which indicates that columns appear in the order defined by
-    // schema::all_columns_in_select_order() - partition key columns goes first,
-    // immediately followed by clustering key columns
+    // NOTICE: the order of columns is guaranteed by the selection made by
+    // scan_ranges_context - partition key columns goes first, immediately
+    // followed by clustering key columns
     std::vector<bytes> exploded_pk;
     const unsigned pk_size = schema->partition_key_size();
     const unsigned ck_size = schema->clustering_key_size();
@@ -479,32 +478,71 @@ class token_ranges_owned_by_this_shard {
     }
 };
 
+// Paces the deletions of expired items done by a scan to a rate, which
+// can be changed while the scan runs. Up to a second's worth of deletions
+// can be done without waiting after a part of the scan without any.
+class deletion_pacer {
+    utils::updateable_value<uint32_t> _deletions_per_second;
+    lowres_clock::time_point _next = lowres_clock::time_point::min();
+public:
+    explicit deletion_pacer(utils::updateable_value<uint32_t> deletions_per_second)
+        : _deletions_per_second(std::move(deletions_per_second))
+    {}
+    // Waits until the next deletion can be done, or the abort source is
+    // triggered.
+    future<> wait(abort_source& as) {
+        uint32_t rate = _deletions_per_second();
+        if (rate == 0) {
+            co_return;
+        }
+        auto now = lowres_clock::now();
+        _next = std::max(_next, now - std::chrono::seconds(1)) + std::chrono::duration_cast<lowres_clock::duration>(std::chrono::duration<double>(1.0 / rate));
+        if (_next > now) {
+            try {
+                co_await seastar::sleep_abortable(_next - now, as);
+            } catch (seastar::sleep_aborted&) {}
+        }
+    }
+};
+
 // Precomputed information needed to perform a scan on partition ranges
 struct scan_ranges_context {
     schema_ptr s;
     bytes column_name;
     std::optional<std::string> member;
+    deletion_pacer pacer;
 
     ::shared_ptr<cql3::selection::selection> selection;
     std::unique_ptr<service::query_state> query_state_ptr;
     std::unique_ptr<cql3::query_options> query_options;
     ::lw_shared_ptr<query::read_command> command;
 
-    scan_ranges_context(schema_ptr s, service::storage_proxy& proxy, bytes column_name, std::optional<std::string> member)
+    scan_ranges_context(schema_ptr s, service::storage_proxy& proxy, const column_definition& cd, std::optional<std::string> member, utils::updateable_value<uint32_t> deletions_per_second)
         : s(s)
-        , column_name(column_name)
+        , column_name(cd.name())
         , member(member)
+        , pacer(std::move(deletions_per_second))
     {
-        // FIXME: don't read the entire items - read only parts of it.
-        // We must read the key columns (to be able to delete) and also
-        // the requested attribute. If the requested attribute is a map's
-        // member we may be forced to read the entire map - but it would
-        // be good if we can read only the single item of the map - it
+        // We read only the key columns (to be able to delete) and the
+        // column of the requested attribute, not the other columns of the
+        // items, like the keys of their indexes. If the requested attribute
+        // is a map's member we are forced to read the entire map - but it
+        // would be good if we can read only the single item of the map - it
         // should be possible (and a must for issue #7751!).
         lw_shared_ptr<service::pager::paging_state> paging_state = nullptr;
-        auto regular_columns = boost::copy_range<query::column_id_vector>(
-            s->regular_columns() | boost::adaptors::transformed([] (const column_definition& cdef) { return cdef.id; }));
-        selection = cql3::selection::selection::wildcard(s);
+        std::vector<const column_definition*> columns;
+        for (const auto& cdef : s->partition_key_columns()) {
+            columns.push_back(&cdef);
+        }
+        for (const auto& cdef : s->clustering_key_columns()) {
+            columns.push_back(&cdef);
+        }
+        query::column_id_vector regular_columns;
+        if (cd.is_regular()) {
+            columns.push_back(&cd);
+            regular_columns.push_back(cd.id);
+        }
+        selection = cql3::selection::selection::for_columns(s, std::move(columns));
         query::partition_slice::option_set opts = selection->get_query_options();
         opts.set<query::partition_slice::option::allow_short_read>();
         // It is important that the scan bypass cache to avoid polluting it:
@@ -531,7 +569,7 @@ struct scan_ranges_context {
 // range for this code to work correctly.
 static future<> scan_table_ranges(
         service::storage_proxy& proxy,
-        const scan_ranges_context& scan_ctx,
+        scan_ranges_context& scan_ctx,
         dht::partition_range_vector&& partition_ranges,
         abort_source& abort_source,
         named_semaphore& page_sem,
@@ -603,6 +641,10 @@ static future<> scan_table_ranges(
                 expired = is_expired(n, now);
             }
             if (expired) {
+                co_await scan_ctx.pacer.wait(abort_source);
+                if (abort_source.abort_requested()) {
+                    co_return;
+                }
                 expiration_stats.items_deleted++;
                 // FIXME: maybe don't recalculate new_timestamp() all the time
                 // FIXME: if expire_item() throws on timeout, we need to retry it.
@@ -689,7 +731,7 @@ static future<bool> scan_table(
     }
     expiration_stats.scan_table++;
     // FIXME: need to pace the scan, not do it all at once.
-    scan_ranges_context scan_ctx{s, proxy, std::move(column_name), std::move(member)};
+    scan_ranges_context scan_ctx{s, proxy, *cd, std::move(member), db.get_config().alternator_ttl_max_deletions_per_second};
     token_ranges_owned_by_this_shard<primary> my_ranges(db.real_database(), gossiper, s);
     while (std::optional<dht::partition_range> range = my_ranges.next_partition_range()) {
         // Note that because of issue #9167 we need to run a separate
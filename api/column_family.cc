@@ -788,6 +788,12 @@ void set_column_family(http_context& ctx, routes& r) {
         });
     });
 
+    cf::get_row_cache_partitions.set(r, [&ctx] (std::unique_ptr<request> req) {
+        return map_reduce_cf(ctx, req->param["name"], uint64_t(0), [] (const replica::column_family& cf) {
+            return cf.get_row_cache().partitions();
+        }, std::plus<uint64_t>());
+    });
+
     cf::get_all_row_cache_hit.set(r, [&ctx] (std::unique_ptr<request> req) {
         return map_reduce_cf_raw(ctx, utils::rate_moving_average(), [](const replica::column_family& cf) {
             return cf.get_row_cache().stats().hits.rate();
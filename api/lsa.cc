@@ -11,6 +11,7 @@
 #include "api/api.hh"
 
 #include <seastar/http/exception.hh>
+#include <seastar/coroutine/maybe_yield.hh>
 #include "utils/logalloc.hh"
 #include "log.hh"
 #include "replica/database.hh"
@@ -21,13 +22,56 @@ static logging::logger alogger("lsa-api");
 
 void set_lsa(http_context& ctx, routes& r) {
     httpd::lsa_json::lsa_compact.set(r, [&ctx](std::unique_ptr<request> req) {
-        alogger.info("Triggering compaction");
-        return ctx.db.invoke_on_all([] (replica::database&) {
-            logalloc::shard_tracker().reclaim(std::numeric_limits<size_t>::max());
+        if (req->get_query_param("max_occupancy").empty() && req->get_query_param("duration").empty()) {
+            alogger.info("Triggering compaction");
+            return ctx.db.invoke_on_all([] (replica::database&) {
+                logalloc::shard_tracker().reclaim(std::numeric_limits<size_t>::max());
+            }).then([] {
+                return json::json_return_type(json::json_void());
+            });
+        }
+        api::req_param<double> max_occupancy(*req, "max_occupancy", 0.5);
+        api::req_param<std::chrono::milliseconds, unsigned> duration(*req, "duration", std::chrono::milliseconds(1000));
+        if (max_occupancy.value < 0 || max_occupancy.value > 1) {
+            throw httpd::bad_param_exception("max_occupancy must be between 0 and 1");
+        }
+        alogger.info("Triggering compaction of segments used less than {} for at most {}", max_occupancy.value, duration.value);
+        return ctx.db.invoke_on_all([max_occupancy = max_occupancy.value, duration = duration.value] (replica::database&) -> future<> {
+            auto deadline = lowres_clock::now() + duration;
+            size_t compacted = 0;
+            while (lowres_clock::now() < deadline) {
+                auto n = logalloc::shard_tracker().compact_sparse_segments(max_occupancy);
+                if (!n) {
+                    break;
+                }
+                compacted += n;
+                co_await coroutine::maybe_yield();
+            }
+            alogger.info("Compacted {} segments", compacted);
         }).then([] {
             return json::json_return_type(json::json_void());
         });
     });
+
+    httpd::lsa_json::get_segment_occupancy.set(r, [&ctx](std::unique_ptr<request> req) {
+        using histograms = std::pair<logalloc::tracker::segment_occupancy_histogram, logalloc::tracker::segment_occupancy_histogram>;
+        return ctx.db.map_reduce0([] (replica::database&) {
+            return histograms(logalloc::shard_tracker().segment_occupancy(true), logalloc::shard_tracker().segment_occupancy(false));
+        }, histograms{}, [] (histograms a, const histograms& b) {
+            for (size_t i = 0; i < a.first.size(); ++i) {
+                a.first[i] += b.first[i];
+                a.second[i] += b.second[i];
+            }
+            return a;
+        }).then([] (histograms h) {
+            httpd::lsa_json::segment_occupancy res;
+            for (size_t i = 0; i < h.first.size(); ++i) {
+                res.evictable.push(h.first[i]);
+                res.non_evictable.push(h.second[i]);
+            }
+            return json::json_return_type(res);
+        });
+    });
 }
 
 }
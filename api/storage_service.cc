@@ -126,32 +126,36 @@ static auto wrap_ks_cf(http_context &ctx, ks_cf_func f) {
     };
 }
 
-seastar::future<json::json_return_type> run_toppartitions_query(db::toppartitions_query& q, http_context &ctx, bool legacy_request) {
+static httpd::column_family_json::toppartitions_query_results toppartitions_results_to_json(db::toppartitions_query::results& topk_results, size_t list_size, bool legacy_request) {
     namespace cf = httpd::column_family_json;
+    apilog.debug("toppartitions query: processing results");
+    cf::toppartitions_query_results results;
+
+    results.read_cardinality = topk_results.read.size();
+    results.write_cardinality = topk_results.write.size();
+
+    for (auto& d: topk_results.read.top(list_size)) {
+        cf::toppartitions_record r;
+        r.partition = (legacy_request ? "" : "(" + d.item.schema->ks_name() + ":" + d.item.schema->cf_name() + ") ") + sstring(d.item);
+        r.count = d.count;
+        r.error = d.error;
+        results.read.push(r);
+    }
+    for (auto& d: topk_results.write.top(list_size)) {
+        cf::toppartitions_record r;
+        r.partition = (legacy_request ? "" : "(" + d.item.schema->ks_name() + ":" + d.item.schema->cf_name() + ") ") + sstring(d.item);
+        r.count = d.count;
+        r.error = d.error;
+        results.write.push(r);
+    }
+    return results;
+}
+
+seastar::future<json::json_return_type> run_toppartitions_query(db::toppartitions_query& q, http_context &ctx, bool legacy_request) {
     return q.scatter().then([&q, legacy_request] {
         return sleep(q.duration()).then([&q, legacy_request] {
             return q.gather(q.capacity()).then([&q, legacy_request] (auto topk_results) {
-                apilog.debug("toppartitions query: processing results");
-                cf::toppartitions_query_results results;
-
-                results.read_cardinality = topk_results.read.size();
-                results.write_cardinality = topk_results.write.size();
-
-                for (auto& d: topk_results.read.top(q.list_size())) {
-                    cf::toppartitions_record r;
-                    r.partition = (legacy_request ? "" : "(" + d.item.schema->ks_name() + ":" + d.item.schema->cf_name() + ") ") + sstring(d.item);
-                    r.count = d.count;
-                    r.error = d.error;
-                    results.read.push(r);
-                }
-                for (auto& d: topk_results.write.top(q.list_size())) {
-                    cf::toppartitions_record r;
-                    r.partition = (legacy_request ? "" : "(" + d.item.schema->ks_name() + ":" + d.item.schema->cf_name() + ") ") + sstring(d.item);
-                    r.count = d.count;
-                    r.error = d.error;
-                    results.write.push(r);
-                }
-                return make_ready_future<json::json_return_type>(results);
+                return make_ready_future<json::json_return_type>(toppartitions_results_to_json(topk_results, q.list_size(), legacy_request));
             });
         });
     });
@@ -478,6 +482,22 @@ void set_storage_service(http_context& ctx, routes& r, sharded<service::storage_
         });
     });
 
+    ss::toppartitions_continuous.set(r, [&ctx] (std::unique_ptr<request> req) -> future<json::json_return_type> {
+        api::req_param<unsigned> list_size(*req, "list_size", 10);
+        api::req_param<bool> reset(*req, "reset", false);
+
+        if (!ctx.db.local().get_config().continuous_toppartitions_capacity()) {
+            throw httpd::bad_param_exception("continuous toppartitions tracking is disabled, see continuous_toppartitions_capacity");
+        }
+        auto topk_results = co_await db::toppartitions_query::gather_continuous(ctx.db, ctx.db.local().get_config().continuous_toppartitions_capacity());
+        if (reset.value) {
+            co_await ctx.db.invoke_on_all([] (replica::database& db) {
+                db.reset_continuous_toppartitions();
+            });
+        }
+        co_return json::json_return_type(toppartitions_results_to_json(topk_results, list_size.value, false));
+    });
+
     ss::get_leaving_nodes.set(r, [&ctx](const_req req) {
         return container_to_vec(ctx.get_token_metadata().get_leaving_endpoints());
     });
@@ -18,12 +18,14 @@
 
 #include <boost/algorithm/cxx11/all_of.hpp>
 #include <seastar/core/seastar.hh>
+#include <seastar/coroutine/maybe_yield.hh>
 
 #include "auth/authenticated_user.hh"
 #include "auth/common.hh"
 #include "auth/passwords.hh"
 #include "auth/roles-metadata.hh"
 #include "cql3/untyped_result_set.hh"
+#include "hashers.hh"
 #include "log.hh"
 #include "service/migration_manager.hh"
 #include "utils/class_registrator.hh"
@@ -56,7 +58,8 @@ password_authenticator::~password_authenticator() {
 password_authenticator::password_authenticator(cql3::query_processor& qp, ::service::migration_manager& mm)
     : _qp(qp)
     , _migration_manager(mm)
-    , _stopped(make_ready_future<>()) {
+    , _stopped(make_ready_future<>())
+    , _credentials_salt(passwords::detail::generate_random_salt_bytes(rng_for_salt)) {
 }
 
 static bool has_salted_hash(const cql3::untyped_result_set_row& row) {
@@ -212,14 +215,18 @@ future<authenticated_user> password_authenticator::authenticate(
                 internal_distributed_query_state(),
                 {username},
                 cql3::query_processor::cache_internal::yes);
-    }).then_wrapped([=](future<::shared_ptr<cql3::untyped_result_set>> f) {
+    }).then([=, this] (::shared_ptr<cql3::untyped_result_set> res) {
+        auto salted_hash = std::optional<sstring>();
+        if (!res->empty()) {
+            salted_hash = res->one().get_opt<sstring>(SALTED_HASH);
+        }
+        if (!salted_hash) {
+            return make_ready_future<bool>(false);
+        }
+        return check_password(username, password, std::move(*salted_hash));
+    }).then_wrapped([=](future<bool> f) {
         try {
-            auto res = f.get0();
-            auto salted_hash = std::optional<sstring>();
-            if (!res->empty()) {
-                salted_hash = res->one().get_opt<sstring>(SALTED_HASH);
-            }
-            if (!salted_hash || !passwords::check(password, *salted_hash)) {
+            if (!f.get0()) {
                 throw exceptions::authentication_exception("Username and/or password are incorrect");
             }
             return make_ready_future<authenticated_user>(username);
@@ -235,6 +242,39 @@ future<authenticated_user> password_authenticator::authenticate(
     });
 }
 
+future<bool> password_authenticator::check_password(sstring username, sstring password, sstring salted_hash) const {
+    const auto validity = std::chrono::milliseconds(_qp.db().get_config().credentials_validity_in_ms());
+    // The password itself is not kept, only a digest of it salted with a
+    // secret of this shard, which is as fast to verify as it is to compute.
+    auto digest = sha256_hasher::calculate(format("{}{}:{}{}", _credentials_salt, username.size(), username, password));
+    auto is_verified = [&] {
+        auto it = _verified_credentials.find(username);
+        return it != _verified_credentials.end() && it->second.expiry > lowres_clock::now()
+                && it->second.salted_hash == salted_hash && it->second.digest == digest;
+    };
+    if (validity.count() && is_verified()) {
+        co_return true;
+    }
+
+    // Hashing can take milliseconds of CPU, which can't be preempted, so let
+    // a login storm run only one hash at a time per shard, and the requests
+    // of the other clients in between.
+    auto units = co_await get_units(_password_check_semaphore, 1);
+    // The same credentials may have been verified meanwhile.
+    if (validity.count() && is_verified()) {
+        co_return true;
+    }
+    co_await coroutine::maybe_yield();
+    const bool ok = passwords::check(password, salted_hash);
+    if (ok && validity.count()) {
+        if (_verified_credentials.size() >= max_verified_credentials) {
+            _verified_credentials.clear();
+        }
+        _verified_credentials[username] = verified_credentials{std::move(salted_hash), std::move(digest), lowres_clock::now() + validity};
+    }
+    co_return ok;
+}
+
 future<> password_authenticator::create(std::string_view role_name, const authentication_options& options) const {
     if (!options.password) {
         return make_ready_future<>();
@@ -258,6 +298,9 @@ future<> password_authenticator::alter(std::string_view role_name, const authent
             SALTED_HASH,
             meta::roles_table::role_col_name);
 
+    // The salted hash changes with the password, so the old credentials would
+    // not be taken as verified anyway, but there is no need to keep them.
+    _verified_credentials.erase(sstring(role_name));
     return _qp.execute_internal(
             query,
             consistency_for_user(role_name),
@@ -10,9 +10,14 @@
 
 #pragma once
 
+#include <unordered_map>
+
 #include <seastar/core/abort_source.hh>
+#include <seastar/core/lowres_clock.hh>
+#include <seastar/core/semaphore.hh>
 
 #include "auth/authenticator.hh"
+#include "bytes.hh"
 
 namespace cql3 {
 
@@ -34,6 +39,17 @@ class password_authenticator : public authenticator {
     future<> _stopped;
     seastar::abort_source _as;
 
+    // Credentials which passed the password check recently, by user name.
+    struct verified_credentials {
+        sstring salted_hash;
+        bytes digest;
+        lowres_clock::time_point expiry;
+    };
+    static constexpr size_t max_verified_credentials = 10000;
+    sstring _credentials_salt;
+    mutable std::unordered_map<sstring, verified_credentials> _verified_credentials;
+    mutable semaphore _password_check_semaphore{1};
+
 public:
     static db::consistency_level consistency_for_user(std::string_view role_name);
 
@@ -73,6 +89,8 @@ class password_authenticator : public authenticator {
     future<> migrate_legacy_metadata() const;
 
     future<> create_default_if_missing() const;
+
+    future<bool> check_password(sstring username, sstring password, sstring salted_hash) const;
 };
 
 }
@@ -11,8 +11,11 @@
 #include <seastar/core/timer.hh>
 #include <seastar/core/gate.hh>
 #include <seastar/core/file.hh>
+#include <algorithm>
 #include <chrono>
 #include <cmath>
+#include <functional>
+#include <optional>
 
 #include "seastarx.hh"
 
@@ -125,16 +128,141 @@ class flush_controller : public backlog_controller {
     {}
 };
 
+// compaction CPU controller.
+//
+// In addition to the proportional response to the backlog, the controller can predict it: the
+// backlog rises with the write rate, so the controller keeps a moving average of its derivative,
+// and feeds the control points with the backlog expected after a lookahead period, so that the
+// shares ramp up ahead of an ingest burst instead of jumping once it has been flushed. Only a
+// rising trend is accounted for, so once the burst is over the shares decay along with the
+// backlog itself. A zero lookahead disables the prediction.
 class compaction_controller : public backlog_controller {
 public:
     static constexpr unsigned normalization_factor = 30;
     static constexpr float disable_backlog = std::numeric_limits<double>::infinity();
     static constexpr float backlog_disabled(float backlog) { return std::isinf(backlog); }
-    compaction_controller(backlog_controller::scheduling_group sg, float static_shares, std::chrono::milliseconds interval, std::function<float()> current_backlog)
-        : backlog_controller(std::move(sg), std::move(interval),
+
+    // Weight of the latest sample in the moving average of the backlog derivative.
+    static constexpr float trend_smoothing = 0.2;
+
+    // The inputs and output of the last adjustment.
+    struct decision {
+        float backlog = 0;
+        // Smoothed derivative of the backlog, per second.
+        float trend = 0;
+        float predicted_backlog = 0;
+        float shares = 0;
+    };
+private:
+    std::chrono::milliseconds _interval;
+    std::chrono::milliseconds _lookahead;
+    std::optional<float> _previous_backlog;
+    decision _last_decision;
+
+    float predict(float backlog) {
+        _last_decision.backlog = backlog;
+        if (_previous_backlog && !backlog_disabled(backlog) && !backlog_disabled(*_previous_backlog)) {
+            auto derivative = (backlog - *_previous_backlog) / std::chrono::duration<float>(_interval).count();
+            _last_decision.trend = trend_smoothing * derivative + (1 - trend_smoothing) * _last_decision.trend;
+        }
+        _previous_backlog = backlog;
+        _last_decision.predicted_backlog = backlog + std::max(_last_decision.trend, 0.0f) * std::chrono::duration<float>(_lookahead).count();
+        return _last_decision.predicted_backlog;
+    }
+protected:
+    virtual void update_controller(float shares) override {
+        _last_decision.shares = shares;
+        backlog_controller::update_controller(shares);
+    }
+public:
+    compaction_controller(backlog_controller::scheduling_group sg, float static_shares, std::chrono::milliseconds interval, std::function<float()> current_backlog,
+                          std::chrono::milliseconds lookahead = std::chrono::milliseconds(0))
+        : backlog_controller(std::move(sg), interval,
           std::vector<backlog_controller::control_point>({{0.0, 50}, {1.5, 100} , {normalization_factor, 1000}}),
-          std::move(current_backlog),
+          [this, current_backlog = std::move(current_backlog)] { return predict(current_backlog()); },
           static_shares
         )
+        , _interval(interval)
+        , _lookahead(lookahead)
     {}
+
+    void set_lookahead(std::chrono::milliseconds lookahead) noexcept {
+        _lookahead = lookahead;
+    }
+
+    const decision& last_decision() const noexcept {
+        return _last_decision;
+    }
+};
+
+// maintenance (streaming, repair) CPU and I/O controller.
+//
+// Unlike the backlog controllers, there is no backlog that must be consumed: maintenance work can
+// always be delayed, so the controller is driven by a latency target of the foreground requests
+// instead. Every interval in which the latency is above the target the shares are halved, and
+// every interval in which it is below they grow back by a tenth of the [min, max] range, so the
+// controller backs off within an interval of a latency spike and ramps into a trough gradually.
+//
+// A zero target disables the controller, which then keeps the maximum shares.
+class maintenance_controller {
+public:
+    struct config {
+        std::function<std::chrono::microseconds()> target;
+        std::function<float()> min_shares;
+        std::function<float()> max_shares;
+    };
+private:
+    backlog_controller::scheduling_group _scheduling_group;
+    config _cfg;
+    // The recent foreground latency, or nullopt if there were no foreground requests.
+    std::function<std::optional<std::chrono::microseconds>()> _current_latency;
+    timer<> _update_timer;
+    future<> _inflight_update;
+    float _shares;
+
+    void adjust() {
+        auto shares = next_shares(_shares, _current_latency(), _cfg.target(), _cfg.min_shares(), _cfg.max_shares());
+        if (shares == _shares || !_inflight_update.available()) {
+            return; // next timer will fix it
+        }
+        _shares = shares;
+        _scheduling_group.cpu.set_shares(shares);
+        _inflight_update = _scheduling_group.io.update_shares(uint32_t(shares));
+    }
+public:
+    maintenance_controller(backlog_controller::scheduling_group sg, std::chrono::milliseconds interval, config cfg,
+                           std::function<std::optional<std::chrono::microseconds>()> current_latency)
+        : _scheduling_group(std::move(sg))
+        , _cfg(std::move(cfg))
+        , _current_latency(std::move(current_latency))
+        , _update_timer([this] { adjust(); })
+        , _inflight_update(make_ready_future<>())
+        , _shares(_cfg.max_shares())
+    {
+        _update_timer.arm_periodic(interval);
+    }
+
+    future<> shutdown() {
+        _update_timer.cancel();
+        return std::move(_inflight_update);
+    }
+
+    float shares() const noexcept {
+        return _shares;
+    }
+
+    static float next_shares(float shares, std::optional<std::chrono::microseconds> latency, std::chrono::microseconds target,
+                             float min_shares, float max_shares) {
+        min_shares = std::max(std::min(min_shares, max_shares), 1.0f);
+        max_shares = std::max(max_shares, min_shares);
+        if (target.count() == 0) {
+            return max_shares;
+        }
+        if (latency && *latency > target) {
+            shares /= 2;
+        } else {
+            shares += (max_shares - min_shares) / 10;
+        }
+        return std::clamp(shares, min_shares, max_shares);
+    }
 };
@@ -292,6 +292,7 @@ inline
 future<> cache_flat_mutation_reader::process_static_row() {
     if (_snp->static_row_continuous()) {
         _read_context.cache().on_row_hit();
+        ++_read_context.permit().stats().cache_row_hits;
         static_row sr = _lsa_manager.run_in_read_section([this] {
             return _snp->static_row(_read_context.digest_requested());
         });
@@ -301,6 +302,7 @@ future<> cache_flat_mutation_reader::process_static_row() {
         return make_ready_future<>();
     } else {
         _read_context.cache().on_row_miss();
+        ++_read_context.permit().stats().cache_row_misses;
         return ensure_underlying().then([this] {
             return (*_underlying)().then([this] (mutation_fragment_v2_opt&& sr) {
                 if (sr) {
@@ -423,6 +425,7 @@ future<> cache_flat_mutation_reader::read_from_underlying() {
         [this] { return _state != state::reading_from_underlying || is_buffer_full(); },
         [this] (mutation_fragment_v2 mf) {
             _read_context.cache().on_row_miss();
+            ++_read_context.permit().stats().cache_row_misses;
             maybe_add_to_cache(mf);
             add_to_buffer(std::move(mf));
         },
@@ -809,6 +812,7 @@ void cache_flat_mutation_reader::add_to_buffer(const partition_snapshot_row_curs
     }
     if (!row.dummy()) {
         _read_context.cache().on_row_hit();
+        ++_read_context.permit().stats().cache_row_hits;
         if (_read_context.digest_requested()) {
             row.latest_row().cells().prepare_hash(table_schema(), column_kind::regular_column);
         }
@@ -12,12 +12,16 @@
 #include "exceptions/exceptions.hh"
 #include "utils/rjson.hh"
 
-caching_options::caching_options(sstring k, sstring r, bool enabled)
-        : _key_cache(k), _row_cache(r), _enabled(enabled) {
+caching_options::caching_options(sstring k, sstring r, bool enabled, double max_share, bool coalesce_reads)
+        : _key_cache(k), _row_cache(r), _enabled(enabled), _max_share(max_share), _coalesce_reads(coalesce_reads) {
     if ((k != "ALL") && (k != "NONE")) {
         throw exceptions::configuration_exception("Invalid key value: " + k); 
     }
 
+    if (!(max_share > 0 && max_share <= 1)) {
+        throw exceptions::configuration_exception(format("Invalid max_share value: {}, must be in (0, 1]", max_share));
+    }
+
     if ((r == "ALL") || (r == "NONE")) {
         return;
     } else {
@@ -40,6 +44,12 @@ caching_options::to_map() const {
     if (!_enabled) {
         res.insert({"enabled", "false"});
     }
+    if (_max_share != 1) {
+        res.insert({"max_share", format("{}", _max_share)});
+    }
+    if (_coalesce_reads) {
+        res.insert({"coalesce_reads", "true"});
+    }
     return res;
 }
 
@@ -58,6 +68,8 @@ caching_options::from_map(const std::map<sstring, sstring>& map) {
     sstring k = default_key;
     sstring r = default_row;
     bool e = true;
+    double max_share = 1;
+    bool coalesce_reads = false;
 
     for (auto& p : map) {
         if (p.first == "keys") {
@@ -66,11 +78,19 @@ caching_options::from_map(const std::map<sstring, sstring>& map) {
             r = p.second;
         } else if (p.first == "enabled") {
             e = p.second == "true";
+        } else if (p.first == "max_share") {
+            try {
+                max_share = boost::lexical_cast<double>(p.second);
+            } catch (boost::bad_lexical_cast&) {
+                throw exceptions::configuration_exception("Invalid max_share value: " + p.second);
+            }
+        } else if (p.first == "coalesce_reads") {
+            coalesce_reads = p.second == "true";
         } else {
             throw exceptions::configuration_exception(format("Invalid caching option: {}", p.first));
         }
     }
-    return caching_options(k, r, e);
+    return caching_options(k, r, e, max_share, coalesce_reads);
 }
 
 caching_options
@@ -81,7 +101,8 @@ caching_options::from_sstring(const sstring& str) {
 bool
 caching_options::operator==(const caching_options& other) const {
     return _key_cache == other._key_cache && _row_cache == other._row_cache
-        && _enabled == other._enabled;
+        && _enabled == other._enabled && _max_share == other._max_share
+        && _coalesce_reads == other._coalesce_reads;
 }
 
 bool
@@ -25,7 +25,13 @@ class caching_options {
     sstring _key_cache;
     sstring _row_cache;
     bool _enabled = true;
-    caching_options(sstring k, sstring r, bool enabled);
+    // Largest part of the cached partitions the table may hold while the
+    // cache is evicting, 1 for no limit.
+    double _max_share = 1;
+    // Whether the coordinator serves identical single-partition reads which
+    // are in flight at the same time with one read.
+    bool _coalesce_reads = false;
+    caching_options(sstring k, sstring r, bool enabled, double max_share = 1, bool coalesce_reads = false);
 
     friend class schema;
     caching_options();
@@ -34,6 +40,14 @@ class caching_options {
         return _enabled;
     }
 
+    double max_share() const {
+        return _max_share;
+    }
+
+    bool coalesce_reads() const {
+        return _coalesce_reads;
+    }
+
     std::map<sstring, sstring> to_map() const;
 
     sstring to_sstring() const;
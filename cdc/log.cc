@@ -1576,7 +1576,8 @@ class transformer final : public change_processor {
     future<lw_shared_ptr<cql3::untyped_result_set>> pre_image_select(
             service::client_state& client_state,
             db::consistency_level write_cl,
-            const mutation& m)
+            const mutation& m,
+            db::timeout_clock::time_point timeout)
     {
         auto& p = m.partition();
         if (p.clustered_rows().empty() && p.static_row().empty()) {
@@ -1661,7 +1662,7 @@ class transformer final : public change_processor {
         const auto select_cl = adjust_cl(write_cl);
 
       try {
-        return _ctx._proxy.query(_schema, std::move(command), std::move(partition_ranges), select_cl, service::storage_proxy::coordinator_query_options(default_timeout(), empty_service_permit(), client_state)).then(
+        return _ctx._proxy.query(_schema, std::move(command), std::move(partition_ranges), select_cl, service::storage_proxy::coordinator_query_options(timeout, empty_service_permit(), client_state)).then(
                 [s = _schema, partition_slice = std::move(partition_slice), selection = std::move(selection)] (service::storage_proxy::coordinator_query_result qr) -> lw_shared_ptr<cql3::untyped_result_set> {
             return make_lw_shared<cql3::untyped_result_set>(*s, std::move(qr.query_result), *selection, partition_slice);
         });
@@ -1774,17 +1775,29 @@ cdc::cdc_service::impl::augment_mutation_call(lowres_clock::time_point timeout,
 
             transformer trans(_ctxt, s, m.decorated_key());
 
+            // Set if the preimage read failed and the images are skipped,
+            // as they can't be made without it.
+            auto images_skipped = make_lw_shared<bool>(false);
             auto f = make_ready_future<lw_shared_ptr<cql3::untyped_result_set>>(nullptr);
             if (s->cdc_options().preimage() || s->cdc_options().postimage()) {
                 // Note: further improvement here would be to coalesce the pre-image selects into one
                 // iff a batch contains several modifications to the same table. Otoh, batch is rare(?)
                 // so this is premature.
                 tracing::trace(tr_state, "CDC: Selecting preimage for {}", m.decorated_key());
-                f = trans.pre_image_select(qs.get_client_state(), write_cl, m).then_wrapped([this] (future<lw_shared_ptr<cql3::untyped_result_set>> f) {
+                const auto best_effort_timeout = std::chrono::milliseconds(_ctxt._proxy.get_db().local().get_config().cdc_best_effort_preimage_timeout_in_ms());
+                const auto timeout = best_effort_timeout.count() ? db::timeout_clock::now() + best_effort_timeout : transformer::default_timeout();
+                f = trans.pre_image_select(qs.get_client_state(), write_cl, m, timeout).then_wrapped([this, best_effort = bool(best_effort_timeout.count()), images_skipped, tr_state] (future<lw_shared_ptr<cql3::untyped_result_set>> f) {
                     auto& cdc_stats = _ctxt._proxy.get_cdc_stats();
                     cdc_stats.counters_total.preimage_selects++;
                     if (f.failed()) {
                         cdc_stats.counters_failed.preimage_selects++;
+                        if (best_effort) {
+                            auto ep = f.get_exception();
+                            tracing::trace(tr_state, "CDC: Preimage select failed, not generating images: {}", ep);
+                            cdc_log.debug("Preimage select failed, not generating images: {}", ep);
+                            *images_skipped = true;
+                            return make_ready_future<lw_shared_ptr<cql3::untyped_result_set>>(nullptr);
+                        }
                     }
                     return f;
                 });
@@ -1792,7 +1805,7 @@ cdc::cdc_service::impl::augment_mutation_call(lowres_clock::time_point timeout,
                 tracing::trace(tr_state, "CDC: Preimage not enabled for the table, not querying current value of {}", m.decorated_key());
             }
 
-            return f.then([trans = std::move(trans), &mutations, idx, tr_state, &details] (lw_shared_ptr<cql3::untyped_result_set> rs) mutable {
+            return f.then([trans = std::move(trans), &mutations, idx, tr_state, &details, images_skipped] (lw_shared_ptr<cql3::untyped_result_set> rs) mutable {
                 auto& m = mutations[idx];
                 auto& s = m.schema();
 
@@ -1802,8 +1815,8 @@ cdc::cdc_service::impl::augment_mutation_call(lowres_clock::time_point timeout,
                     trans.load_preimage_results_into_state(std::move(rs), static_only);
                 }
 
-                const bool preimage = s->cdc_options().preimage();
-                const bool postimage = s->cdc_options().postimage();
+                const bool preimage = s->cdc_options().preimage() && !*images_skipped;
+                const bool postimage = s->cdc_options().postimage() && !*images_skipped;
                 details.had_preimage |= preimage;
                 details.had_postimage |= postimage;
                 tracing::trace(tr_state, "CDC: Generating log mutations for {}", m.decorated_key());
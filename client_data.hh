@@ -45,6 +45,8 @@ struct client_data {
     std::optional<bool> ssl_enabled;
     std::optional<sstring> ssl_protocol;
     std::optional<sstring> username;
+    std::optional<sstring> compression;
+    std::optional<int64_t> compression_bytes_saved;  /// Bytes of responses compression saved, negative if it cost some.
 
     sstring stage_str() const { return to_string(connection_stage); }
     sstring client_type_str() const { return to_string(ct); }
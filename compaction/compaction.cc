@@ -51,6 +51,7 @@
 #include "utils/error_injection.hh"
 #include "readers/filtering.hh"
 #include "readers/compacting.hh"
+#include "readers/multi_range.hh"
 #include "tombstone_gc.hh"
 #include "keys.hh"
 
@@ -468,6 +469,9 @@ class compaction {
     compaction_sstable_replacer_fn _replacer;
     run_id _run_identifier;
     ::io_priority_class _io_priority;
+    // Range of the partitions to compact, see compaction_descriptor::sub_range.
+    dht::partition_range _range;
+    bool _is_sub_range;
     // optional clone of sstable set to be used for expiration purposes, so it will be set if expiration is enabled.
     std::optional<sstable_set> _sstable_set;
     // used to incrementally calculate max purgeable timestamp, as we iterate through decorated keys.
@@ -498,6 +502,8 @@ class compaction {
         , _replacer(std::move(descriptor.replacer))
         , _run_identifier(descriptor.run_identifier)
         , _io_priority(descriptor.io_priority)
+        , _range(descriptor.sub_range.value_or(query::full_partition_range))
+        , _is_sub_range(bool(descriptor.sub_range))
         , _sstable_set(std::move(descriptor.all_sstables_snapshot))
         , _selector(_sstable_set ? _sstable_set->make_incremental_selector() : std::optional<sstable_set::incremental_selector>{})
         , _compacting_for_max_purgeable_func(std::unordered_set<shared_sstable>(_sstables.begin(), _sstables.end()))
@@ -617,7 +623,8 @@ class compaction {
     }
 
     bool enable_garbage_collected_sstable_writer() const noexcept {
-        return _contains_multi_fragment_runs && _max_sstable_size != std::numeric_limits<uint64_t>::max();
+        // The input sstables of a sub-range compaction span other sub-ranges, they cannot be released early.
+        return _contains_multi_fragment_runs && _max_sstable_size != std::numeric_limits<uint64_t>::max() && !_is_sub_range;
     }
 public:
     compaction& operator=(const compaction&) = delete;
@@ -1041,8 +1048,10 @@ class reshape_compaction : public compaction {
 };
 
 class regular_compaction : public compaction {
+protected:
     // keeps track of monitors for input sstable, which are responsible for adjusting backlog as compaction progresses.
     mutable compaction_read_monitor_generator _monitor_generator;
+private:
     seastar::semaphore _replacer_lock = {1};
 public:
     regular_compaction(table_state& table_s, compaction_descriptor descriptor, compaction_data& cdata)
@@ -1054,7 +1063,7 @@ class regular_compaction : public compaction {
     flat_mutation_reader_v2 make_sstable_reader() const override {
         return _compacting->make_local_shard_sstable_reader(_schema,
                 _permit,
-                query::full_partition_range,
+                _range,
                 _schema->full_slice(),
                 _io_priority,
                 tracing::trace_state_ptr(),
@@ -1197,7 +1206,22 @@ class cleanup_compaction final : public regular_compaction {
 
     owned_ranges_ptr _owned_ranges;
     incremental_owned_ranges_checker _owned_ranges_checker;
+    // The owned ranges within the compaction range, sorted and deoverlapped.
+    dht::partition_range_vector _owned_partition_ranges;
 private:
+    dht::partition_range_vector make_owned_partition_ranges() const {
+        auto cmp = dht::ring_position_comparator(*_schema);
+        auto ranges = dht::partition_range::deoverlap(dht::to_partition_ranges(*_owned_ranges), cmp);
+        dht::partition_range_vector ret;
+        ret.reserve(ranges.size());
+        for (auto& r : ranges) {
+            if (auto i = r.intersection(_range, cmp)) {
+                ret.push_back(std::move(*i));
+            }
+        }
+        return ret;
+    }
+
     // Called in a seastar thread
     dht::partition_range_vector
     get_ranges_for_invalidation(const std::vector<shared_sstable>& sstables) {
@@ -1237,6 +1261,7 @@ class cleanup_compaction final : public regular_compaction {
         : regular_compaction(table_s, std::move(descriptor), cdata)
         , _owned_ranges(std::move(owned_ranges))
         , _owned_ranges_checker(*_owned_ranges)
+        , _owned_partition_ranges(make_owned_partition_ranges())
     {
     }
 
@@ -1246,8 +1271,17 @@ class cleanup_compaction final : public regular_compaction {
     cleanup_compaction(table_state& table_s, compaction_descriptor descriptor, compaction_data& cdata, compaction_type_options::upgrade opts)
         : cleanup_compaction(table_s, std::move(descriptor), cdata, std::move(opts.owned_ranges)) {}
 
+    // Reads only the owned ranges, so that the sstable readers use the index
+    // to skip over the data to be dropped, rather than reading, decompressing
+    // and parsing it only to filter it out.
     flat_mutation_reader_v2 make_sstable_reader() const override {
-        return make_filtering_reader(regular_compaction::make_sstable_reader(), make_partition_filter());
+        auto source = mutation_source([this] (schema_ptr s, reader_permit permit, const dht::partition_range& range, const query::partition_slice& slice,
+                const io_priority_class& pc, tracing::trace_state_ptr trace_state, ::streamed_mutation::forwarding fwd, ::mutation_reader::forwarding fwd_mr) {
+            return _compacting->make_local_shard_sstable_reader(std::move(s), std::move(permit), range, slice, pc, std::move(trace_state), fwd, fwd_mr,
+                    _monitor_generator);
+        });
+        return make_filtering_reader(make_flat_multi_range_reader(_schema, _permit, std::move(source), _owned_partition_ranges, _schema->full_slice(),
+                _io_priority, tracing::trace_state_ptr(), ::mutation_reader::forwarding::no), make_partition_filter());
     }
 
     std::string_view report_start_desc() const override {
@@ -1845,6 +1879,79 @@ static future<compaction_result> scrub_sstables_validate_mode(sstables::compacti
     };
 }
 
+// Input sstables which don't overlap each other, have nothing to purge, fit
+// the output size and are in the current format, only need their level to be
+// changed: compacting them would write their data back as it is.
+static bool can_move_without_rewrite(const sstables::compaction_descriptor& descriptor, table_state& table_s) {
+    auto type = descriptor.options.type();
+    if ((type != compaction_type::Compaction && type != compaction_type::Reshape) || descriptor.sub_range) {
+        return false;
+    }
+    auto& s = *table_s.schema();
+    auto compaction_time = gc_clock::now();
+    auto version = table_s.get_sstables_manager().get_highest_supported_format();
+    for (auto& sst : descriptor.sstables) {
+        if (sst->get_sstable_level() == uint32_t(descriptor.level) || sst->is_shared() || sst->get_version() != version
+                || sst->data_size() > descriptor.max_sstable_bytes) {
+            return false;
+        }
+        auto gc_before = sst->get_gc_before_for_drop_estimation(compaction_time, table_s.get_tombstone_gc_state());
+        if (sst->get_stats_metadata().estimated_tombstone_drop_time.sum(gc_before.time_since_epoch().count()) > 0) {
+            return false;
+        }
+    }
+    auto sorted = descriptor.sstables;
+    std::sort(sorted.begin(), sorted.end(), [&s] (const shared_sstable& a, const shared_sstable& b) {
+        return a->get_first_decorated_key().tri_compare(s, b->get_first_decorated_key()) < 0;
+    });
+    for (size_t i = 1; i < sorted.size(); ++i) {
+        if (sorted[i - 1]->get_last_decorated_key().tri_compare(s, sorted[i]->get_first_decorated_key()) >= 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Replaces the input sstables by new generations of them in the target level.
+// Their components are linked under the new generation, of which only the
+// Statistics are rewritten, so no data is read nor written.
+static future<compaction_result> move_without_rewrite(sstables::compaction_descriptor descriptor, compaction_data& cdata, table_state& table_s) {
+    return seastar::async([descriptor = std::move(descriptor), &cdata, &table_s] () mutable {
+        auto s = table_s.schema();
+        std::vector<shared_sstable> new_sstables;
+        uint64_t size = 0;
+        try {
+            for (auto& sst : descriptor.sstables) {
+                auto new_sst = descriptor.creator(this_shard_id());
+                sst->create_links(new_sst->get_dir(), new_sst->generation()).get();
+                new_sstables.push_back(new_sst);
+                new_sst->load(descriptor.io_priority).get();
+                new_sst->mutate_sstable_level(descriptor.level).get();
+                size += new_sst->bytes_on_disk();
+            }
+        } catch (...) {
+            for (auto& new_sst : new_sstables) {
+                new_sst->mark_for_deletion();
+            }
+            throw;
+        }
+        clogger.info("[{} {}.{} {}] Moved {} to level {} as {}, without rewriting them", descriptor.options.type(), s->ks_name(), s->cf_name(), cdata.compaction_uuid,
+                formatted_sstables_list(descriptor.sstables, false), descriptor.level, formatted_sstables_list(new_sstables, false));
+        descriptor.replacer(compaction_completion_desc{
+            .old_sstables = descriptor.sstables,
+            .new_sstables = new_sstables,
+        });
+        return compaction_result{
+            .new_sstables = std::move(new_sstables),
+            .stats = {
+                .ended_at = db_clock::now(),
+                .start_size = size,
+                .end_size = size,
+            },
+        };
+    });
+}
+
 future<compaction_result>
 compact_sstables(sstables::compaction_descriptor descriptor, compaction_data& cdata, table_state& table_s) {
     if (descriptor.sstables.empty()) {
@@ -1856,6 +1963,9 @@ compact_sstables(sstables::compaction_descriptor descriptor, compaction_data& cd
         // Bypass the usual compaction machinery for dry-mode scrub
         return scrub_sstables_validate_mode(std::move(descriptor), cdata, table_s);
     }
+    if (can_move_without_rewrite(descriptor, table_s)) {
+        return move_without_rewrite(std::move(descriptor), cdata, table_s);
+    }
     return compaction::run(make_compaction(table_s, std::move(descriptor), cdata));
 }
 
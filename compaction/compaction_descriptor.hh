@@ -169,6 +169,12 @@ struct compaction_descriptor {
     // Denotes if this compaction task is comprised solely of completely expired SSTables
     sstables::has_only_fully_expired has_only_fully_expired = has_only_fully_expired::no;
 
+    // If engaged, only the partitions of this range are compacted, so that a
+    // compaction can be split into concurrent jobs over disjoint sub-ranges.
+    // Such a compaction never releases its input sstables early, and leaves
+    // the replacement of all of them to the replacer, once it completes.
+    std::optional<dht::partition_range> sub_range;
+
     compaction_descriptor() = default;
 
     static constexpr int default_level = 0;
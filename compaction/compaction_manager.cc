@@ -15,6 +15,8 @@
 #include <seastar/core/coroutine.hh>
 #include <seastar/coroutine/switch_to.hh>
 #include <seastar/coroutine/parallel_for_each.hh>
+#include <seastar/core/loop.hh>
+#include <seastar/coroutine/exception.hh>
 #include "sstables/exceptions.hh"
 #include "locator/abstract_replication_strategy.hh"
 #include "utils/fb_utilities.hh"
@@ -22,6 +24,8 @@
 #include <cmath>
 #include <boost/algorithm/cxx11/any_of.hpp>
 #include <boost/range/algorithm/remove_if.hpp>
+#include <boost/range/numeric.hpp>
+#include <boost/range/adaptor/transformed.hpp>
 
 static logging::logger cmlog("compaction_manager");
 using namespace std::chrono_literals;
@@ -351,6 +355,74 @@ future<> compaction_manager::task::update_history(compaction::table_state& t, co
                                                                     res.stats.start_size, res.stats.end_size);
 }
 
+// Splits the token range spanned by the sstables into up to n sub-ranges of
+// similar width, covering the whole ring.
+static dht::partition_range_vector split_into_sub_ranges(const std::vector<sstables::shared_sstable>& sstables, unsigned n) {
+    auto first = std::numeric_limits<int64_t>::max();
+    auto last = std::numeric_limits<int64_t>::min();
+    for (auto& sst : sstables) {
+        first = std::min(first, sst->get_first_decorated_key().token().raw());
+        last = std::max(last, sst->get_last_decorated_key().token().raw());
+    }
+    std::vector<dht::ring_position> bounds;
+    if (first < last) {
+        auto step = (uint64_t(last) - uint64_t(first)) / n;
+        for (unsigned i = 1; step && i < n; ++i) {
+            bounds.push_back(dht::ring_position::starting_at(dht::token(dht::token::kind::key, int64_t(uint64_t(first) + step * i))));
+        }
+    }
+    if (bounds.empty()) {
+        return { query::full_partition_range };
+    }
+    dht::partition_range_vector ranges;
+    ranges.reserve(bounds.size() + 1);
+    ranges.push_back(dht::partition_range::make_ending_with({bounds.front(), false}));
+    for (size_t i = 1; i < bounds.size(); ++i) {
+        ranges.push_back(dht::partition_range::make({bounds[i - 1], true}, {bounds[i], false}));
+    }
+    ranges.push_back(dht::partition_range::make_starting_with({bounds.back(), true}));
+    return ranges;
+}
+
+// Compacts the partitions of one sub-range of a major compaction.
+// The output sstables are kept out of the table, the parent task replaces
+// the input sstables by the output of all sub-ranges once they all completed.
+class compaction_manager::sub_range_compaction_task : public compaction_manager::task {
+    sstables::compaction_descriptor _descriptor;
+    sstables::compaction_result _result;
+public:
+    sub_range_compaction_task(compaction_manager& mgr, compaction::table_state* t, sstables::compaction_descriptor descriptor)
+        : task(mgr, t, sstables::compaction_type::Compaction, "Major compaction of a sub-range")
+        , _descriptor(std::move(descriptor))
+    {}
+
+    sstables::compaction_result& result() noexcept {
+        return _result;
+    }
+protected:
+    virtual future<compaction_stats_opt> do_run() override {
+        compaction::table_state& t = *_compacting_table;
+        _descriptor.enable_garbage_collection(t.main_sstable_set());
+        _descriptor.creator = [&t] (shard_id dummy) {
+            return t.make_sstable();
+        };
+        _descriptor.replacer = [] (sstables::compaction_completion_desc) {};
+
+        setup_new_compaction(_descriptor.run_identifier);
+        std::exception_ptr ex;
+        try {
+            _result = co_await sstables::compact_sstables(std::move(_descriptor), _compaction_data, t);
+        } catch (...) {
+            ex = std::current_exception();
+        }
+        finish_compaction(ex ? state::failed : state::done);
+        if (ex) {
+            co_return coroutine::exception(std::move(ex));
+        }
+        co_return _result.stats;
+    }
+};
+
 class compaction_manager::major_compaction_task : public compaction_manager::task {
 public:
     major_compaction_task(compaction_manager& mgr, compaction::table_state* t)
@@ -380,7 +452,10 @@ class compaction_manager::major_compaction_task : public compaction_manager::tas
         auto release_exhausted = [&compacting] (const std::vector<sstables::shared_sstable>& exhausted_sstables) {
             compacting.release_compacting(exhausted_sstables);
         };
-        setup_new_compaction(descriptor.run_identifier);
+        auto sub_descriptors = descriptor.sstables.empty() ? std::vector<sstables::compaction_descriptor>{} : split_into_sub_jobs(cs, descriptor);
+        if (sub_descriptors.size() <= 1) {
+            setup_new_compaction(descriptor.run_identifier);
+        }
 
         cmlog.info0("User initiated compaction started on behalf of {}.{}", t->schema()->ks_name(), t->schema()->cf_name());
         compaction_backlog_tracker bt(std::make_unique<user_initiated_backlog_tracker>(_cm._compaction_controller.backlog_of_shares(200), _cm.available_memory()));
@@ -391,12 +466,112 @@ class compaction_manager::major_compaction_task : public compaction_manager::tas
         // the exclusive lock can be freed to let regular compaction run in parallel to major
         lock_holder.return_all();
 
-        co_await compact_sstables_and_update_history(std::move(descriptor), _compaction_data, std::move(release_exhausted));
+        if (sub_descriptors.size() <= 1) {
+            co_await compact_sstables_and_update_history(std::move(descriptor), _compaction_data, std::move(release_exhausted));
+        } else {
+            co_await compact_sub_jobs(std::move(descriptor), std::move(sub_descriptors), std::move(release_exhausted));
+        }
 
         finish_compaction();
 
         co_return std::nullopt;
     }
+private:
+    // With a major compaction parallelism above one, splits the job into the
+    // groups of sstables the strategy can compact independently, like the
+    // windows of TWCS, or else into sub-ranges of the token range.
+    std::vector<sstables::compaction_descriptor> split_into_sub_jobs(const sstables::compaction_strategy& cs, const sstables::compaction_descriptor& descriptor) const {
+        auto parallelism = _cm.major_compaction_parallelism();
+        if (parallelism <= 1) {
+            return {};
+        }
+        auto make_sub_descriptor = [&descriptor] (std::vector<sstables::shared_sstable> sstables, dht::partition_range range) {
+            auto sub_descriptor = sstables::compaction_descriptor(std::move(sstables), descriptor.io_priority, descriptor.level,
+                    descriptor.max_sstable_bytes, descriptor.run_identifier, descriptor.options);
+            sub_descriptor.can_split_large_partition = descriptor.can_split_large_partition;
+            // Keeps the sub-jobs from releasing their input early, see compaction_descriptor::sub_range.
+            sub_descriptor.sub_range = std::move(range);
+            return sub_descriptor;
+        };
+        std::vector<sstables::compaction_descriptor> sub_descriptors;
+        auto groups = cs.split_major_compaction_input(descriptor.sstables);
+        if (groups.size() > 1) {
+            for (auto& group : groups) {
+                sub_descriptors.push_back(make_sub_descriptor(std::move(group), query::full_partition_range));
+            }
+            return sub_descriptors;
+        }
+        for (auto& range : split_into_sub_ranges(descriptor.sstables, parallelism)) {
+            sub_descriptors.push_back(make_sub_descriptor(descriptor.sstables, std::move(range)));
+        }
+        return sub_descriptors;
+    }
+
+    // Runs a sub_range_compaction_task per sub-job, at most parallelism at a
+    // time, all writing into the output run of the descriptor, and replaces
+    // the input sstables by their output at once. This task stays inactive
+    // meanwhile, the sub-job tasks are the ones listed and stopped as running
+    // compactions.
+    future<> compact_sub_jobs(sstables::compaction_descriptor descriptor, std::vector<sstables::compaction_descriptor> sub_descriptors, release_exhausted_func_t release_exhausted) {
+        compaction::table_state& t = *_compacting_table;
+        switch_state(state::none);
+        _compaction_data = _cm.create_compaction_data();
+        cmlog.debug("{}: splitting into {} sub-jobs", *this, sub_descriptors.size());
+
+        std::vector<shared_ptr<sub_range_compaction_task>> sub_tasks;
+        sub_tasks.reserve(sub_descriptors.size());
+        for (auto& sub_descriptor : sub_descriptors) {
+            sub_tasks.push_back(make_shared<sub_range_compaction_task>(_cm, &t, std::move(sub_descriptor)));
+        }
+        auto stop_sub_tasks = _compaction_data.abort.subscribe([this, &sub_tasks] () noexcept {
+            for (auto& sub_task : sub_tasks) {
+                sub_task->stop(_compaction_data.stop_requested);
+            }
+        });
+
+        std::exception_ptr ex;
+        try {
+            co_await max_concurrent_for_each(sub_tasks, _cm.major_compaction_parallelism(), [this] (shared_ptr<sub_range_compaction_task> sub_task) -> future<> {
+                if (_compaction_data.is_stop_requested()) {
+                    throw make_compaction_stopped_exception();
+                }
+                _cm._tasks.push_back(sub_task);
+                auto unregister_task = defer([this, sub_task] {
+                    _cm._tasks.remove(sub_task);
+                });
+                co_await sub_task->run();
+            });
+        } catch (...) {
+            ex = std::current_exception();
+        }
+
+        sstables::compaction_result res;
+        for (auto& sub_task : sub_tasks) {
+            auto& sub_res = sub_task->result();
+            res.new_sstables.insert(res.new_sstables.end(), sub_res.new_sstables.begin(), sub_res.new_sstables.end());
+            res.stats += sub_res.stats;
+        }
+        if (ex) {
+            // The output of the sub-ranges which completed was never added to the table.
+            for (auto& sst : res.new_sstables) {
+                sst->mark_for_deletion();
+            }
+            co_return coroutine::exception(std::move(ex));
+        }
+        // The sub-jobs either all read all the input sstables, or split them.
+        res.stats.start_size = boost::accumulate(descriptor.sstables | boost::adaptors::transformed(std::mem_fn(&sstables::sstable::bytes_on_disk)), uint64_t(0));
+
+        auto old_sstables = descriptor.sstables;
+        t.get_compaction_strategy().notify_completion(old_sstables, res.new_sstables);
+        _cm.propagate_replacement(t, old_sstables, res.new_sstables);
+        co_await t.on_compaction_completion(sstables::compaction_completion_desc{
+            .old_sstables = old_sstables,
+            .new_sstables = res.new_sstables,
+        }, sstables::offstrategy::no);
+        release_exhausted(old_sstables);
+
+        co_await update_history(t, res, _compaction_data);
+    }
 };
 
 future<> compaction_manager::perform_major_compaction(compaction::table_state& t) {
@@ -406,6 +581,105 @@ future<> compaction_manager::perform_major_compaction(compaction::table_state& t
     return perform_task(make_shared<major_compaction_task>(*this, &t)).discard_result();;
 }
 
+// An sstable's droppable tombstones can be purged by compacting it alone only if
+// they cannot shadow data elsewhere, i.e. if all the data of the memtables and
+// of the other sstables it overlaps with is newer than everything it holds.
+static bool overlaps_only_newer_data(compaction::table_state& t, const sstables::shared_sstable& sst) {
+    auto max_timestamp = sst->get_stats_metadata().max_timestamp;
+    if (t.min_memtable_timestamp() <= max_timestamp) {
+        return false;
+    }
+    auto range = dht::partition_range::make({sst->get_first_decorated_key(), true}, {sst->get_last_decorated_key(), true});
+    auto overlapping = t.main_sstable_set().select(range);
+    return std::none_of(overlapping.begin(), overlapping.end(), [&] (const sstables::shared_sstable& other) {
+        return other != sst && other->get_stats_metadata().min_timestamp <= max_timestamp;
+    }) && std::none_of(t.compacted_undeleted_sstables().begin(), t.compacted_undeleted_sstables().end(), [&] (const sstables::shared_sstable& other) {
+        return other->get_stats_metadata().min_timestamp <= max_timestamp;
+    });
+}
+
+sstables::shared_sstable compaction_manager::get_tombstone_gc_candidate(compaction::table_state& t) {
+    auto& cs = t.get_compaction_strategy();
+    auto& gc_state = t.get_tombstone_gc_state();
+    auto compaction_time = gc_clock::now();
+    sstables::shared_sstable candidate;
+    double max_ratio = 0;
+    for (auto& sst : get_candidates(t)) {
+        if (!cs.worth_dropping_tombstones(sst, compaction_time, gc_state) || !overlaps_only_newer_data(t, sst)) {
+            continue;
+        }
+        auto ratio = sst->estimate_droppable_tombstone_ratio(sst->get_gc_before_for_drop_estimation(compaction_time, gc_state));
+        if (!candidate || ratio > max_ratio) {
+            candidate = sst;
+            max_ratio = ratio;
+        }
+    }
+    return candidate;
+}
+
+class compaction_manager::tombstone_gc_compaction_task : public compaction_manager::task {
+public:
+    tombstone_gc_compaction_task(compaction_manager& mgr, compaction::table_state& t)
+        : task(mgr, &t, sstables::compaction_type::Compaction, "Tombstone GC compaction")
+    {}
+
+protected:
+    virtual future<compaction_stats_opt> do_run() override {
+        co_await coroutine::switch_to(_cm.maintenance_sg().cpu);
+
+        switch_state(state::pending);
+        auto units = co_await acquire_semaphore(_cm._tombstone_gc_sem);
+        // take read lock for table, so major and tombstone gc compaction can't proceed in parallel.
+        auto lock_holder = co_await _compaction_state.lock.hold_read_lock();
+        if (!can_proceed()) {
+            co_return std::nullopt;
+        }
+
+        compaction::table_state& t = *_compacting_table;
+        auto sst = _cm.get_tombstone_gc_candidate(t);
+        if (!sst) {
+            co_return std::nullopt;
+        }
+        auto gc_before = sst->get_gc_before_for_drop_estimation(gc_clock::now(), t.get_tombstone_gc_state());
+        auto droppable_tombstones = [gc_before] (const sstables::shared_sstable& sst) {
+            return uint64_t(sst->get_stats_metadata().estimated_tombstone_drop_time.sum(gc_before.time_since_epoch().count()));
+        };
+        auto droppable_before = droppable_tombstones(sst);
+        auto bytes = sst->data_size();
+
+        // The output replaces the sstable in its run and level.
+        auto descriptor = sstables::compaction_descriptor({ sst }, _cm.maintenance_sg().io, sst->get_sstable_level(),
+                sstables::compaction_descriptor::default_max_sstable_bytes, sst->run_identifier());
+        auto compacting = compacting_sstable_registration(_cm, descriptor.sstables);
+        auto release_exhausted = [&compacting] (const std::vector<sstables::shared_sstable>& exhausted_sstables) {
+            compacting.release_compacting(exhausted_sstables);
+        };
+        cmlog.debug("{}: compacting {} of {}.{}, with {} droppable tombstones", *this, sst->get_filename(),
+                t.schema()->ks_name(), t.schema()->cf_name(), droppable_before);
+        setup_new_compaction(descriptor.run_identifier);
+
+        auto res = co_await compact_sstables_and_update_history(std::move(descriptor), _compaction_data, std::move(release_exhausted));
+
+        uint64_t droppable_after = 0;
+        for (auto& new_sst : res.new_sstables) {
+            droppable_after += droppable_tombstones(new_sst);
+        }
+        _cm._stats.tombstone_gc_compactions++;
+        _cm._stats.tombstone_gc_bytes_rewritten += bytes;
+        _cm._stats.tombstone_gc_tombstones_purged += droppable_before - std::min(droppable_before, droppable_after);
+        finish_compaction();
+
+        co_return res.stats;
+    }
+};
+
+future<> compaction_manager::perform_tombstone_gc_compaction(compaction::table_state& t) {
+    if (_state != state::enabled) {
+        return make_ready_future<>();
+    }
+    return perform_task(make_shared<tombstone_gc_compaction_task>(*this, t)).discard_result();
+}
+
 class compaction_manager::custom_compaction_task : public compaction_manager::task {
     noncopyable_function<future<>(sstables::compaction_data&)> _job;
 
@@ -517,8 +791,9 @@ std::ostream& operator<<(std::ostream& os, const compaction_manager::task& task)
     return os << task.describe();
 }
 
-inline compaction_controller make_compaction_controller(const compaction_manager::scheduling_group& csg, uint64_t static_shares, std::function<double()> fn) {
-    return compaction_controller(csg, static_shares, 250ms, std::move(fn));
+inline compaction_controller make_compaction_controller(const compaction_manager::scheduling_group& csg, uint64_t static_shares, std::function<double()> fn,
+        std::chrono::milliseconds lookahead = 0ms) {
+    return compaction_controller(csg, static_shares, 250ms, std::move(fn), lookahead);
 }
 
 compaction_manager::compaction_state::~compaction_state() {
@@ -648,7 +923,7 @@ compaction_manager::compaction_manager(config cfg, abort_source& as)
             return compaction_controller::normalization_factor;
         }
         return b;
-    }))
+    }, controller_lookahead()))
     , _backlog_manager(_compaction_controller)
     , _early_abort_subscription(as.subscribe([this] () noexcept {
         do_stop();
@@ -656,6 +931,9 @@ compaction_manager::compaction_manager(config cfg, abort_source& as)
     , _throughput_updater(serialized_action([this] { return update_throughput(throughput_mbs()); }))
     , _update_compaction_static_shares_action([this] { return update_static_shares(static_shares()); })
     , _compaction_static_shares_observer(_cfg.static_shares.observe(_update_compaction_static_shares_action.make_observer()))
+    , _compaction_controller_lookahead_observer(_cfg.controller_lookahead_in_ms.observe([this] (const uint32_t&) {
+        _compaction_controller.set_lookahead(controller_lookahead());
+    }))
     , _strategy_control(std::make_unique<strategy_control>(*this))
     , _tombstone_gc_state(&_repair_history_maps)
 {
@@ -676,6 +954,7 @@ compaction_manager::compaction_manager()
     , _throughput_updater(serialized_action([this] { return update_throughput(throughput_mbs()); }))
     , _update_compaction_static_shares_action([] { return make_ready_future<>(); })
     , _compaction_static_shares_observer(_cfg.static_shares.observe(_update_compaction_static_shares_action.make_observer()))
+    , _compaction_controller_lookahead_observer(_cfg.controller_lookahead_in_ms.observe([] (const uint32_t&) {}))
     , _strategy_control(std::make_unique<strategy_control>(*this))
     , _tombstone_gc_state(&_repair_history_maps)
 {
@@ -720,8 +999,24 @@ void compaction_manager::register_metrics() {
                        sm::description("Holds the sum of compaction backlog for all tables in the system.")),
         sm::make_gauge("normalized_backlog", [this] { return _last_backlog / available_memory(); },
                        sm::description("Holds the sum of normalized compaction backlog for all tables in the system. Backlog is normalized by dividing backlog by shard's available memory.")),
+        sm::make_gauge("controller_backlog_trend", [this] { return _compaction_controller.last_decision().trend; },
+                       sm::description("Holds the smoothed derivative of the normalized backlog per second, as last seen by the compaction controller.")),
+        sm::make_gauge("controller_predicted_backlog", [this] { return _compaction_controller.last_decision().predicted_backlog; },
+                       sm::description("Holds the normalized backlog the compaction controller last set the shares for, predicted from the backlog trend if compaction_controller_lookahead_in_ms is set.")),
+        sm::make_gauge("controller_shares", [this] { return _compaction_controller.last_decision().shares; },
+                       sm::description("Holds the shares last set by the compaction controller.")),
         sm::make_counter("validation_errors", [this] { return _validation_errors; },
                        sm::description("Holds the number of encountered validation errors.")),
+        sm::make_counter("tombstone_gc_compactions", [this] { return _stats.tombstone_gc_compactions; },
+                       sm::description("Holds the number of completed garbage-collection compactions of sstables dense with droppable tombstones.")),
+        sm::make_counter("tombstone_gc_bytes_rewritten", [this] { return _stats.tombstone_gc_bytes_rewritten; },
+                       sm::description("Holds the number of bytes of sstables rewritten by tombstone garbage-collection compactions.")),
+        sm::make_counter("tombstone_gc_tombstones_purged", [this] { return _stats.tombstone_gc_tombstones_purged; },
+                       sm::description("Holds the estimated number of tombstones purged by tombstone garbage-collection compactions.")),
+        sm::make_gauge("tombstone_gc_tombstones_purged_per_byte", [this] {
+                           return _stats.tombstone_gc_bytes_rewritten ? double(_stats.tombstone_gc_tombstones_purged) / _stats.tombstone_gc_bytes_rewritten : 0;
+                       },
+                       sm::description("Holds the estimated number of tombstones purged per byte rewritten by tombstone garbage-collection compactions.")),
     });
 }
 
@@ -734,8 +1029,22 @@ void compaction_manager::enable() {
 
 std::function<void()> compaction_manager::compaction_submission_callback() {
     return [this] () mutable {
-        for (auto& e: _compaction_state) {
-            submit(*e.first);
+        std::vector<std::pair<compaction::table_state*, double>> tables;
+        tables.reserve(_compaction_state.size());
+        for (auto& [t, cs] : _compaction_state) {
+            update_read_amplification(*t, cs);
+            tables.emplace_back(t, cs.read_amplification.reads_per_second * cs.read_amplification.sstables_per_read);
+        }
+        // Tables whose reads touch the most sstables first.
+        std::stable_sort(tables.begin(), tables.end(), [] (const auto& a, const auto& b) {
+            return a.second > b.second;
+        });
+        for (auto& [t, _] : tables) {
+            submit(*t);
+            if (!t->is_auto_compaction_disabled_by_user()) {
+                // OK to drop future, failures were logged by perform_task().
+                (void)perform_tombstone_gc_compaction(*t).handle_exception([] (std::exception_ptr) {});
+            }
         }
     };
 }
@@ -749,7 +1058,12 @@ void compaction_manager::postponed_compactions_reevaluation() {
             }
             auto postponed = std::move(_postponed);
             try {
-                for (auto& t : postponed) {
+                // Resume the compactions which improve reads the most first.
+                auto by_gain = boost::copy_range<std::vector<compaction::table_state*>>(postponed);
+                std::stable_sort(by_gain.begin(), by_gain.end(), [this] (compaction::table_state* a, compaction::table_state* b) {
+                    return _compaction_state.at(a).postponed_gain > _compaction_state.at(b).postponed_gain;
+                });
+                for (auto& t : by_gain) {
                     auto s = t->schema();
                     cmlog.debug("resubmitting postponed compaction for table {}.{} [{}]", s->ks_name(), s->cf_name(), fmt::ptr(t));
                     submit(*t);
@@ -770,6 +1084,43 @@ void compaction_manager::postpone_compaction_for_table(compaction::table_state*
     _postponed.insert(t);
 }
 
+void compaction_manager::update_read_amplification(compaction::table_state& t, compaction_state& cs) {
+    // Long enough for the order of the tables not to follow bursts of reads.
+    static constexpr auto smoothing_period = std::chrono::duration<double>(std::chrono::minutes(1));
+
+    auto& ra = cs.read_amplification;
+    auto now = lowres_clock::now();
+    auto elapsed = std::chrono::duration<double>(now - ra.updated_at);
+    if (elapsed.count() <= 0) {
+        return;
+    }
+    auto& histogram = t.get_sstables_per_read_histogram();
+    auto reads = histogram._count - ra.reads;
+    auto sstables_read = histogram._sample_sum - ra.sstables_read;
+    auto alpha = elapsed / (elapsed + smoothing_period);
+    ra.reads_per_second += alpha * (reads / elapsed.count() - ra.reads_per_second);
+    if (reads > 0) {
+        auto sstables_per_read = double(sstables_read) / reads;
+        ra.sstables_per_read = ra.sstables_per_read ? ra.sstables_per_read + alpha * (sstables_per_read - ra.sstables_per_read) : sstables_per_read;
+    }
+    ra.reads = histogram._count;
+    ra.sstables_read = histogram._sample_sum;
+    ra.updated_at = now;
+}
+
+double compaction_manager::read_amplification_gain(compaction::table_state& t, const sstables::compaction_descriptor& descriptor) {
+    auto& cs = get_compaction_state(&t);
+    update_read_amplification(t, cs);
+    auto bytes = descriptor.sstables_size();
+    auto fan_in = descriptor.fan_in();
+    if (!bytes || fan_in < 2) {
+        return 0;
+    }
+    // Reads keep touching at least one sstable.
+    auto saved_per_read = std::clamp(cs.read_amplification.sstables_per_read - 1, 0.0, double(fan_in - 1));
+    return cs.read_amplification.reads_per_second * saved_per_read / bytes;
+}
+
 future<> compaction_manager::stop_tasks(std::vector<shared_ptr<task>> tasks, sstring reason) {
     // To prevent compaction from being postponed while tasks are being stopped,
     // let's stop all tasks before the deferring point below.
@@ -959,6 +1310,7 @@ class compaction_manager::regular_compaction_task : public compaction_manager::t
                 cmlog.debug("Refused compaction job ({} sstable(s)) of weight {} for {}.{}, postponing it...",
                     descriptor.sstables.size(), weight, t.schema()->ks_name(), t.schema()->cf_name());
                 switch_state(state::postponed);
+                _compaction_state.postponed_gain = _cm.read_amplification_gain(t, descriptor);
                 _cm.postpone_compaction_for_table(&t);
                 co_return std::nullopt;
             }
@@ -28,6 +28,7 @@
 #include <vector>
 #include <list>
 #include <functional>
+#include <optional>
 #include <algorithm>
 #include "compaction.hh"
 #include "compaction_weight_registration.hh"
@@ -42,7 +43,31 @@ class compacting_sstable_registration;
 
 class repair_history_map {
 public:
-    boost::icl::interval_map<dht::token, gc_clock::time_point, boost::icl::partial_absorber, std::less, boost::icl::inplace_max> map;
+    using map_type = boost::icl::interval_map<dht::token, gc_clock::time_point, boost::icl::partial_absorber, std::less, boost::icl::inplace_max>;
+    // Adjacent ranges repaired at the same time are joined into one segment.
+    map_type map;
+private:
+    // The segment found by the last find(). Compaction and reads look up
+    // the tokens of a table in order, so consecutive keys mostly fall into
+    // the same segment.
+    mutable std::optional<map_type::value_type> _last_found;
+public:
+    std::optional<gc_clock::time_point> find(const dht::token& t) const {
+        if (_last_found && boost::icl::contains(_last_found->first, t)) {
+            return _last_found->second;
+        }
+        auto it = map.find(t);
+        if (it == map.end()) {
+            return std::nullopt;
+        }
+        _last_found.emplace(*it);
+        return it->second;
+    }
+
+    void update(const map_type::interval_type& interval, gc_clock::time_point repair_time) {
+        _last_found.reset();
+        map += std::make_pair(interval, repair_time);
+    }
 };
 
 // Compaction manager provides facilities to submit and track compaction jobs on
@@ -55,6 +80,10 @@ class compaction_manager {
         int64_t completed_tasks = 0;
         uint64_t active_tasks = 0; // Number of compaction going on.
         int64_t errors = 0;
+        // Of the garbage-collection compactions of sstables dense with droppable tombstones.
+        int64_t tombstone_gc_compactions = 0;
+        uint64_t tombstone_gc_bytes_rewritten = 0;
+        uint64_t tombstone_gc_tombstones_purged = 0;
     };
     using scheduling_group = backlog_controller::scheduling_group;
     struct config {
@@ -62,7 +91,9 @@ class compaction_manager {
         scheduling_group maintenance_sched_group;
         size_t available_memory = 0;
         utils::updateable_value<float> static_shares = utils::updateable_value<float>(0);
+        utils::updateable_value<uint32_t> controller_lookahead_in_ms = utils::updateable_value<uint32_t>(0);
         utils::updateable_value<uint32_t> throughput_mb_per_sec = utils::updateable_value<uint32_t>(0);
+        utils::updateable_value<uint32_t> major_compaction_parallelism = utils::updateable_value<uint32_t>(1);
     };
 private:
     struct compaction_state {
@@ -79,6 +110,19 @@ class compaction_manager {
         // Signaled whenever a compaction task completes.
         condition_variable compaction_done;
 
+        // Smoothed rate of single-partition reads of the table, and of the
+        // sstables each of them touched, see update_read_amplification().
+        struct read_amplification {
+            int64_t reads = 0;
+            int64_t sstables_read = 0;
+            lowres_clock::time_point updated_at = lowres_clock::now();
+            double reads_per_second = 0;
+            double sstables_per_read = 0;
+        } read_amplification;
+
+        // Read amplification gain of the last compaction postponed for the table.
+        double postponed_gain = 0;
+
         compaction_state() = default;
         compaction_state(compaction_state&&) = default;
         ~compaction_state();
@@ -229,6 +273,8 @@ class compaction_manager {
     };
 
     class major_compaction_task;
+    class sub_range_compaction_task;
+    class tombstone_gc_compaction_task;
     class custom_compaction_task;
     class regular_compaction_task;
     class offstrategy_compaction_task;
@@ -285,6 +331,10 @@ class compaction_manager {
     // being picked more than once.
     seastar::named_semaphore _off_strategy_sem = {1, named_semaphore_exception_factory{"off-strategy compaction"}};
 
+    // Serializes the tombstone garbage-collection compactions of all tables,
+    // which run under the maintenance scheduling group, apart from regular compaction.
+    seastar::named_semaphore _tombstone_gc_sem = {1, named_semaphore_exception_factory{"tombstone gc compaction"}};
+
     std::function<void()> compaction_submission_callback();
     // all registered tables are reevaluated at a constant interval.
     // Submission is a NO-OP when there's nothing to do, so it's fine to call it regularly.
@@ -299,6 +349,7 @@ class compaction_manager {
     std::optional<utils::observer<uint32_t>> _throughput_option_observer;
     serialized_action _update_compaction_static_shares_action;
     utils::observer<float> _compaction_static_shares_observer;
+    utils::observer<uint32_t> _compaction_controller_lookahead_observer;
     uint64_t _validation_errors = 0;
 
     class strategy_control;
@@ -326,6 +377,10 @@ class compaction_manager {
     // Get candidates for compaction strategy, which are all sstables but the ones being compacted.
     std::vector<sstables::shared_sstable> get_candidates(compaction::table_state& t);
 
+    // Get the candidate with the highest ratio of droppable tombstones, among those
+    // worth dropping tombstones from, which don't overlap any older data, or null.
+    sstables::shared_sstable get_tombstone_gc_candidate(compaction::table_state& t);
+
     template <typename Iterator, typename Sentinel>
     requires std::same_as<Sentinel, Iterator> || std::sentinel_for<Sentinel, Iterator>
     void register_compacting_sstables(Iterator first, Sentinel last);
@@ -348,6 +403,10 @@ class compaction_manager {
     // similar-sized compaction.
     void postpone_compaction_for_table(compaction::table_state* t);
 
+    // Folds the reads of the table since the last update into its smoothed
+    // read rate and sstables per read.
+    void update_read_amplification(compaction::table_state& t, compaction_state& cs);
+
     future<compaction_stats_opt> perform_sstable_scrub_validate_mode(compaction::table_state& t);
     future<> update_static_shares(float shares);
 
@@ -394,10 +453,18 @@ class compaction_manager {
         return _cfg.static_shares.get();
     }
 
+    std::chrono::milliseconds controller_lookahead() const noexcept {
+        return std::chrono::milliseconds(_cfg.controller_lookahead_in_ms.get());
+    }
+
     uint32_t throughput_mbs() const noexcept {
         return _cfg.throughput_mb_per_sec.get();
     }
 
+    uint32_t major_compaction_parallelism() const noexcept {
+        return _cfg.major_compaction_parallelism.get();
+    }
+
     void register_metrics();
 
     // enable the compaction manager.
@@ -444,6 +511,24 @@ class compaction_manager {
     // Submit a table for major compaction.
     future<> perform_major_compaction(compaction::table_state& t);
 
+    // Submit a table for a garbage-collection compaction of an sstable dense with
+    // droppable tombstones, if any, and wait for its termination.
+    //
+    // Strategies rarely pick such an sstable alone, as it's usually part of a
+    // tier or level with pending work. Only sstables that all the data which
+    // overlaps with is newer than are considered, so that their droppable
+    // tombstones can actually be purged. All tables are submitted periodically.
+    future<> perform_tombstone_gc_compaction(compaction::table_state& t);
+
+    // Expected reduction of the sstables touched per second by the reads of
+    // the table, per byte compacted by the job described by the descriptor.
+    //
+    // A job merging N runs saves every read which touched them up to N-1
+    // sstables. Postponed regular compactions are resumed in decreasing order
+    // of their gain, and tables are submitted periodically in decreasing
+    // order of their read amplification, so that competing tables get the
+    // compaction bandwidth where it improves reads the most.
+    double read_amplification_gain(compaction::table_state& t, const sstables::compaction_descriptor& descriptor);
 
     // Run a custom job for a given table, defined by a function
     // it completes when future returned by job is ready or returns immediately
@@ -23,6 +23,7 @@
 #include <boost/range/adaptors.hpp>
 #include <boost/algorithm/cxx11/any_of.hpp>
 #include "size_tiered_compaction_strategy.hh"
+#include "incremental_compaction_strategy.hh"
 #include "date_tiered_compaction_strategy.hh"
 #include "leveled_compaction_strategy.hh"
 #include "time_window_compaction_strategy.hh"
@@ -494,7 +495,6 @@ time_window_compaction_strategy::time_window_compaction_strategy(const std::map<
     } else {
         clogger.debug("Enabling tombstone compactions for TWCS");
     }
-    _use_clustering_key_filter = true;
 }
 
 } // namespace sstables
@@ -656,8 +656,6 @@ date_tiered_compaction_strategy::date_tiered_compaction_strategy(const std::map<
     } else {
         date_tiered_manifest::logger.debug("Enabling tombstone compactions for DTCS");
     }
-
-    _use_clustering_key_filter = true;
 }
 
 compaction_descriptor date_tiered_compaction_strategy::get_sstables_for_compaction(table_state& table_s, strategy_control& control, std::vector<sstables::shared_sstable> candidates) {
@@ -716,6 +714,10 @@ compaction_descriptor compaction_strategy::get_major_compaction_job(table_state&
     return _compaction_strategy_impl->get_major_compaction_job(table_s, std::move(candidates));
 }
 
+std::vector<std::vector<shared_sstable>> compaction_strategy::split_major_compaction_input(std::vector<shared_sstable> input) const {
+    return _compaction_strategy_impl->split_major_compaction_input(std::move(input));
+}
+
 std::vector<compaction_descriptor> compaction_strategy::get_cleanup_compaction_jobs(table_state& table_s, std::vector<shared_sstable> candidates) const {
     return _compaction_strategy_impl->get_cleanup_compaction_jobs(table_s, std::move(candidates));
 }
@@ -732,8 +734,8 @@ int64_t compaction_strategy::estimated_pending_compactions(table_state& table_s)
     return _compaction_strategy_impl->estimated_pending_compactions(table_s);
 }
 
-bool compaction_strategy::use_clustering_key_filter() const {
-    return _compaction_strategy_impl->use_clustering_key_filter();
+bool compaction_strategy::worth_dropping_tombstones(const shared_sstable& sst, gc_clock::time_point compaction_time, const tombstone_gc_state& gc_state) {
+    return _compaction_strategy_impl->worth_dropping_tombstones(sst, compaction_time, gc_state);
 }
 
 compaction_backlog_tracker& compaction_strategy::get_backlog_tracker() {
@@ -757,6 +759,10 @@ bool compaction_strategy::use_interposer_consumer() const {
     return _compaction_strategy_impl->use_interposer_consumer();
 }
 
+std::optional<uint64_t> compaction_strategy::max_sstable_size() const {
+    return _compaction_strategy_impl->max_sstable_size();
+}
+
 compaction_strategy make_compaction_strategy(compaction_strategy_type strategy, const std::map<sstring, sstring>& options) {
     ::shared_ptr<compaction_strategy_impl> impl;
 
@@ -776,6 +782,9 @@ compaction_strategy make_compaction_strategy(compaction_strategy_type strategy,
     case compaction_strategy_type::time_window:
         impl = ::make_shared<time_window_compaction_strategy>(options);
         break;
+    case compaction_strategy_type::incremental:
+        impl = ::make_shared<incremental_compaction_strategy>(options);
+        break;
     default:
         throw std::runtime_error("strategy not supported");
     }
@@ -48,6 +48,11 @@ class compaction_strategy {
 
     compaction_descriptor get_major_compaction_job(table_state& table_s, std::vector<shared_sstable> candidates);
 
+    // Split the input of a major compaction into groups which can be compacted
+    // concurrently, independently of each other. Returns a single group if the
+    // strategy has no such groups.
+    std::vector<std::vector<shared_sstable>> split_major_compaction_input(std::vector<shared_sstable> input) const;
+
     std::vector<compaction_descriptor> get_cleanup_compaction_jobs(table_state& table_s, std::vector<shared_sstable> candidates) const;
 
     // Some strategies may look at the compacted and resulting sstables to
@@ -57,8 +62,9 @@ class compaction_strategy {
     // Return if parallel compaction is allowed by strategy.
     bool parallel_compaction() const;
 
-    // Return if optimization to rule out sstables based on clustering key filter should be applied.
-    bool use_clustering_key_filter() const;
+    // Return if an sstable is worth a compaction of its own, to drop its tombstones,
+    // according to the tombstone_threshold and tombstone_compaction_interval options.
+    bool worth_dropping_tombstones(const shared_sstable& sst, gc_clock::time_point compaction_time, const tombstone_gc_state& gc_state);
 
     // An estimation of number of compaction for strategy to be satisfied.
     int64_t estimated_pending_compactions(table_state& table_s) const;
@@ -75,6 +81,8 @@ class compaction_strategy {
             return "DateTieredCompactionStrategy";
         case compaction_strategy_type::time_window:
             return "TimeWindowCompactionStrategy";
+        case compaction_strategy_type::incremental:
+            return "IncrementalCompactionStrategy";
         default:
             throw std::runtime_error("Invalid Compaction Strategy");
         }
@@ -93,6 +101,8 @@ class compaction_strategy {
             return compaction_strategy_type::date_tiered;
         } else if (short_name == "TimeWindowCompactionStrategy") {
             return compaction_strategy_type::time_window;
+        } else if (short_name == "IncrementalCompactionStrategy") {
+            return compaction_strategy_type::incremental;
         } else {
             throw exceptions::configuration_exception(format("Unable to find compaction strategy class '{}'", name));
         }
@@ -115,6 +125,11 @@ class compaction_strategy {
     // Returns whether or not interposer consumer is used by a given strategy.
     bool use_interposer_consumer() const;
 
+    // Returns the size of the sstables the strategy keeps in its levels or runs,
+    // if it has one. Data ingested off-strategy is split into sstables of at most
+    // that size, so that reshape can move them into place without rewriting them.
+    std::optional<uint64_t> max_sstable_size() const;
+
     // Informs the caller (usually the compaction manager) about what would it take for this set of
     // SSTables closer to becoming in-strategy. If this returns an empty compaction descriptor, this
     // means that the sstable set is already in-strategy.
@@ -35,7 +35,6 @@ class compaction_strategy_impl {
     const sstring TOMBSTONE_THRESHOLD_OPTION = "tombstone_threshold";
     const sstring TOMBSTONE_COMPACTION_INTERVAL_OPTION = "tombstone_compaction_interval";
 
-    bool _use_clustering_key_filter = false;
     bool _disable_tombstone_compaction = false;
     float _tombstone_threshold = DEFAULT_TOMBSTONE_THRESHOLD;
     db_clock::duration _tombstone_compaction_interval = DEFAULT_TOMBSTONE_COMPACTION_INTERVAL();
@@ -53,6 +52,9 @@ class compaction_strategy_impl {
     virtual compaction_descriptor get_major_compaction_job(table_state& table_s, std::vector<sstables::shared_sstable> candidates) {
         return make_major_compaction_job(std::move(candidates));
     }
+    virtual std::vector<std::vector<shared_sstable>> split_major_compaction_input(std::vector<shared_sstable> input) const {
+        return { std::move(input) };
+    }
     virtual std::vector<compaction_descriptor> get_cleanup_compaction_jobs(table_state& table_s, std::vector<shared_sstable> candidates) const;
     virtual void notify_completion(const std::vector<shared_sstable>& removed, const std::vector<shared_sstable>& added) { }
     virtual compaction_strategy_type type() const = 0;
@@ -62,10 +64,6 @@ class compaction_strategy_impl {
     virtual int64_t estimated_pending_compactions(table_state& table_s) const = 0;
     virtual std::unique_ptr<sstable_set_impl> make_sstable_set(schema_ptr schema) const;
 
-    bool use_clustering_key_filter() const {
-        return _use_clustering_key_filter;
-    }
-
     // Check if a given sstable is entitled for tombstone compaction based on its
     // droppable tombstone histogram and gc_before.
     bool worth_dropping_tombstones(const shared_sstable& sst, gc_clock::time_point compaction_time, const tombstone_gc_state& gc_state);
@@ -80,6 +78,10 @@ class compaction_strategy_impl {
         return false;
     }
 
+    virtual std::optional<uint64_t> max_sstable_size() const {
+        return std::nullopt;
+    }
+
     virtual compaction_descriptor get_reshaping_job(std::vector<shared_sstable> input, schema_ptr schema, const ::io_priority_class& iop, reshape_mode mode);
 };
 }
@@ -0,0 +1,233 @@
+/*
+ * Copyright (C) 2022-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include "incremental_compaction_strategy.hh"
+#include "table_state.hh"
+#include "exceptions/exceptions.hh"
+#include "service/priority_manager.hh"
+
+#include <boost/range/adaptor/map.hpp>
+#include <boost/range/adaptor/reversed.hpp>
+#include <boost/range/adaptor/transformed.hpp>
+
+#include <cmath>
+
+// The backlog of STCS (see size_tiered_backlog_tracker.hh), with the runs in
+// place of the sstables: each run of a tier which is worth compacting
+// contributes (Si - Ci) * log4(T / Si), where Si is the size of the run and
+// Ci is what was compacted of it so far.
+class incremental_backlog_tracker final : public compaction_backlog_tracker::impl {
+    sstables::size_tiered_compaction_strategy_options _stcs_options;
+    std::unordered_map<sstables::run_id, sstables::sstable_run> _runs;
+    uint64_t _total_bytes = 0;
+    // Runs of interesting buckets, with their sizes.
+    std::unordered_map<sstables::run_id, uint64_t> _contributing_runs;
+
+    static double log4(double x) {
+        return std::log(x) / std::log(4);
+    }
+
+    void refresh_contributing_runs() {
+        _contributing_runs.clear();
+        if (_runs.empty()) {
+            return;
+        }
+        auto runs = boost::copy_range<std::vector<sstables::sstable_run>>(_runs | boost::adaptors::map_values);
+        // Deduce the threshold from any sstable, like size_tiered_backlog_tracker.
+        auto threshold = (*runs.front().all().begin())->get_schema()->min_compaction_threshold();
+        for (auto& bucket : sstables::incremental_compaction_strategy::get_buckets(std::move(runs), _stcs_options)) {
+            if (bucket.size() < size_t(threshold)) {
+                continue;
+            }
+            for (auto& run : bucket) {
+                _contributing_runs.emplace((*run.all().begin())->run_identifier(), run.data_size());
+            }
+        }
+    }
+public:
+    explicit incremental_backlog_tracker(sstables::size_tiered_compaction_strategy_options stcs_options)
+        : _stcs_options(std::move(stcs_options))
+    { }
+
+    virtual double backlog(const compaction_backlog_tracker::ongoing_writes& ow, const compaction_backlog_tracker::ongoing_compactions& oc) const override {
+        if (_contributing_runs.empty()) {
+            return 0;
+        }
+        std::unordered_map<sstables::run_id, uint64_t> compacted;
+        for (auto& [sst, progress] : oc) {
+            compacted[sst->run_identifier()] += progress->compacted();
+        }
+        double b = 0;
+        for (auto& [id, size] : _contributing_runs) {
+            auto it = compacted.find(id);
+            uint64_t c = it != compacted.end() ? std::min(it->second, size) : 0;
+            b += (size - c) * log4(double(_total_bytes) / size);
+        }
+        return b > 0 ? b : 0;
+    }
+
+    virtual void replace_sstables(std::vector<sstables::shared_sstable> old_ssts, std::vector<sstables::shared_sstable> new_ssts) override {
+        for (auto& sst : old_ssts) {
+            auto it = _runs.find(sst->run_identifier());
+            if (sst->data_size() > 0 && it != _runs.end()) {
+                _total_bytes -= sst->data_size();
+                it->second.erase(sst);
+                if (it->second.all().empty()) {
+                    _runs.erase(it);
+                }
+            }
+        }
+        for (auto& sst : new_ssts) {
+            if (sst->data_size() > 0) {
+                _total_bytes += sst->data_size();
+                // Fragments of a run never overlap, the result can be ignored.
+                (void)_runs[sst->run_identifier()].insert(sst);
+            }
+        }
+        refresh_contributing_runs();
+    }
+};
+
+namespace sstables {
+
+extern logging::logger clogger;
+
+incremental_compaction_strategy::incremental_compaction_strategy(const std::map<sstring, sstring>& options)
+    : compaction_strategy_impl(options)
+    , _fragment_size(cql3::statements::property_definitions::to_long(SSTABLE_SIZE_OPTION, get_value(options, SSTABLE_SIZE_OPTION), DEFAULT_MAX_SSTABLE_SIZE_IN_MB) * 1024 * 1024)
+    , _stcs_options(options)
+    , _backlog_tracker(std::make_unique<incremental_backlog_tracker>(_stcs_options))
+{
+    if (_fragment_size == 0) {
+        throw exceptions::configuration_exception(format("{} must be greater than 0", SSTABLE_SIZE_OPTION));
+    }
+}
+
+std::vector<sstable_run> incremental_compaction_strategy::get_runs(const std::vector<shared_sstable>& sstables) {
+    std::unordered_map<run_id, sstable_run> runs;
+    for (auto& sst : sstables) {
+        // Fragments of a run never overlap, the result can be ignored.
+        (void)runs[sst->run_identifier()].insert(sst);
+    }
+    return boost::copy_range<std::vector<sstable_run>>(runs | boost::adaptors::map_values);
+}
+
+std::vector<std::vector<sstable_run>>
+incremental_compaction_strategy::get_buckets(std::vector<sstable_run> runs, const size_tiered_compaction_strategy_options& options) {
+    auto run_and_length_pairs = boost::copy_range<std::vector<std::pair<sstable_run, uint64_t>>>(runs | boost::adaptors::transformed([] (sstable_run& run) {
+        auto size = run.data_size();
+        return std::make_pair(std::move(run), size);
+    }));
+    return size_tiered_compaction_strategy::get_buckets(std::move(run_and_length_pairs), options);
+}
+
+std::vector<sstable_run>
+incremental_compaction_strategy::most_interesting_bucket(std::vector<std::vector<sstable_run>> buckets, size_t min_threshold, size_t max_threshold) {
+    std::vector<sstable_run>* max = nullptr;
+    for (auto& bucket : buckets) {
+        if (!is_bucket_interesting(bucket, min_threshold)) {
+            continue;
+        }
+        bucket.resize(std::min(bucket.size(), max_threshold));
+        if (!max || bucket.size() > max->size()) {
+            max = &bucket;
+        }
+    }
+    return max ? std::move(*max) : std::vector<sstable_run>();
+}
+
+compaction_descriptor incremental_compaction_strategy::make_descriptor(const std::vector<sstable_run>& runs, const ::io_priority_class& iop) const {
+    std::vector<shared_sstable> sstables;
+    for (auto& run : runs) {
+        sstables.insert(sstables.end(), run.all().begin(), run.all().end());
+    }
+    return compaction_descriptor(std::move(sstables), iop, compaction_descriptor::default_level, _fragment_size);
+}
+
+compaction_descriptor
+incremental_compaction_strategy::get_sstables_for_compaction(table_state& table_s, strategy_control& control, std::vector<sstables::shared_sstable> candidates) {
+    size_t min_threshold = table_s.min_compaction_threshold();
+    size_t max_threshold = table_s.schema()->max_compaction_threshold();
+    auto compaction_time = gc_clock::now();
+
+    auto buckets = get_buckets(get_runs(candidates), _stcs_options);
+
+    auto bucket = most_interesting_bucket(buckets, min_threshold, max_threshold);
+    if (bucket.empty() && !table_s.compaction_enforce_min_threshold()) {
+        bucket = most_interesting_bucket(buckets, 2, max_threshold);
+    }
+    if (!bucket.empty()) {
+        clogger.debug("incremental: Compacting {} runs of {}.{}", bucket.size(), table_s.schema()->ks_name(), table_s.schema()->cf_name());
+        return make_descriptor(bucket, service::get_local_compaction_priority());
+    }
+
+    // Like STCS, try the oldest fragment worth dropping tombstones from,
+    // starting with the largest tiers. The output stays in the fragment's
+    // run, which it doesn't overlap with.
+    for (auto& bucket : buckets | boost::adaptors::reversed) {
+        std::vector<shared_sstable> fragments;
+        for (auto& run : bucket) {
+            for (auto& sst : run.all()) {
+                if (worth_dropping_tombstones(sst, compaction_time, table_s.get_tombstone_gc_state())) {
+                    fragments.push_back(sst);
+                }
+            }
+        }
+        if (fragments.empty()) {
+            continue;
+        }
+        auto& sst = *std::min_element(fragments.begin(), fragments.end(), [] (auto& i, auto& j) {
+            return i->get_stats_metadata().min_timestamp < j->get_stats_metadata().min_timestamp;
+        });
+        return compaction_descriptor({ sst }, service::get_local_compaction_priority(), compaction_descriptor::default_level,
+                _fragment_size, sst->run_identifier());
+    }
+    return compaction_descriptor();
+}
+
+compaction_descriptor
+incremental_compaction_strategy::get_major_compaction_job(table_state& table_s, std::vector<sstables::shared_sstable> candidates) {
+    return make_major_compaction_job(std::move(candidates), compaction_descriptor::default_level, _fragment_size);
+}
+
+int64_t incremental_compaction_strategy::estimated_pending_compactions(table_state& table_s) const {
+    size_t min_threshold = table_s.min_compaction_threshold();
+    size_t max_threshold = table_s.schema()->max_compaction_threshold();
+    auto all_sstables = table_s.main_sstable_set().all();
+
+    int64_t n = 0;
+    for (auto& bucket : get_buckets(get_runs(boost::copy_range<std::vector<shared_sstable>>(*all_sstables)), _stcs_options)) {
+        if (bucket.size() >= min_threshold) {
+            n += std::ceil(double(bucket.size()) / max_threshold);
+        }
+    }
+    return n;
+}
+
+compaction_descriptor
+incremental_compaction_strategy::get_reshaping_job(std::vector<shared_sstable> input, schema_ptr schema, const ::io_priority_class& iop, reshape_mode mode) {
+    size_t offstrategy_threshold = std::max(schema->min_compaction_threshold(), 4);
+    size_t max_runs = std::max(schema->max_compaction_threshold(), int(offstrategy_threshold));
+
+    if (mode == reshape_mode::relaxed) {
+        offstrategy_threshold = max_runs;
+    }
+
+    for (auto& bucket : get_buckets(get_runs(input), _stcs_options)) {
+        if (bucket.size() >= offstrategy_threshold) {
+            bucket.resize(std::min(bucket.size(), max_runs));
+            auto desc = make_descriptor(bucket, iop);
+            desc.options = compaction_type_options::make_reshape();
+            return desc;
+        }
+    }
+
+    return compaction_descriptor();
+}
+
+}
@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2022-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include "compaction_strategy_impl.hh"
+#include "size_tiered_compaction_strategy.hh"
+#include "sstables/sstable_set.hh"
+
+class incremental_backlog_tracker;
+
+namespace sstables {
+
+// Size-tiered compaction of sstable runs.
+//
+// Every compaction writes its output as a run of fragments of at most
+// sstable_size_in_mb, and the runs, rather than the sstables, are grouped
+// into tiers of similar size like in STCS. Since all input runs are disjoint
+// fragments, compaction releases each input fragment as soon as it was
+// exhausted (see compaction::maybe_replace_exhausted_sstables_by_sst()), so
+// the temporary space a job needs is bounded by a few fragments per input
+// run, instead of the size of its whole output.
+class incremental_compaction_strategy : public compaction_strategy_impl {
+    static constexpr uint64_t DEFAULT_MAX_SSTABLE_SIZE_IN_MB = 1000;
+    const sstring SSTABLE_SIZE_OPTION = "sstable_size_in_mb";
+
+    uint64_t _fragment_size;
+    size_tiered_compaction_strategy_options _stcs_options;
+    compaction_backlog_tracker _backlog_tracker;
+private:
+    static bool is_bucket_interesting(const std::vector<sstable_run>& bucket, size_t min_threshold) {
+        return bucket.size() >= min_threshold;
+    }
+
+    // Maybe return the runs of a bucket to compact, picks the bucket with the most runs.
+    static std::vector<sstable_run> most_interesting_bucket(std::vector<std::vector<sstable_run>> buckets, size_t min_threshold, size_t max_threshold);
+
+    compaction_descriptor make_descriptor(const std::vector<sstable_run>& runs, const ::io_priority_class& iop) const;
+public:
+    // Group the sstables into runs, by their run identifiers.
+    static std::vector<sstable_run> get_runs(const std::vector<shared_sstable>& sstables);
+
+    // Group runs of similar size into buckets, like STCS groups sstables.
+    static std::vector<std::vector<sstable_run>> get_buckets(std::vector<sstable_run> runs, const size_tiered_compaction_strategy_options& options);
+
+    incremental_compaction_strategy(const std::map<sstring, sstring>& options);
+
+    virtual compaction_descriptor get_sstables_for_compaction(table_state& table_s, strategy_control& control, std::vector<sstables::shared_sstable> candidates) override;
+
+    virtual compaction_descriptor get_major_compaction_job(table_state& table_s, std::vector<sstables::shared_sstable> candidates) override;
+
+    virtual int64_t estimated_pending_compactions(table_state& table_s) const override;
+
+    virtual compaction_strategy_type type() const override {
+        return compaction_strategy_type::incremental;
+    }
+
+    virtual compaction_backlog_tracker& get_backlog_tracker() override {
+        return _backlog_tracker;
+    }
+
+    virtual std::optional<uint64_t> max_sstable_size() const override {
+        return _fragment_size;
+    }
+
+    virtual compaction_descriptor get_reshaping_job(std::vector<shared_sstable> input, schema_ptr schema, const ::io_priority_class& iop, reshape_mode mode) override;
+
+    friend class ::incremental_backlog_tracker;
+};
+
+}
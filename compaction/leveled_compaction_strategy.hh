@@ -68,6 +68,10 @@ class leveled_compaction_strategy : public compaction_strategy_impl {
         return _backlog_tracker;
     }
 
+    virtual std::optional<uint64_t> max_sstable_size() const override {
+        return uint64_t(_max_sstable_size_in_mb) * 1024 * 1024;
+    }
+
     virtual compaction_descriptor get_reshaping_job(std::vector<shared_sstable> input, schema_ptr schema, const ::io_priority_class& iop, reshape_mode mode) override;
 };
 
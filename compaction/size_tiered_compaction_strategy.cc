@@ -7,6 +7,7 @@
  */
 
 #include "size_tiered_compaction_strategy.hh"
+#include "sstables/hyperloglog.hh"
 
 #include <boost/range/adaptor/transformed.hpp>
 #include <boost/range/adaptors.hpp>
@@ -55,52 +56,7 @@ size_tiered_compaction_strategy::create_sstable_and_length_pairs(const std::vect
 
 std::vector<std::vector<sstables::shared_sstable>>
 size_tiered_compaction_strategy::get_buckets(const std::vector<sstables::shared_sstable>& sstables, size_tiered_compaction_strategy_options options) {
-    // sstables sorted by size of its data file.
-    auto sorted_sstables = create_sstable_and_length_pairs(sstables);
-
-    std::sort(sorted_sstables.begin(), sorted_sstables.end(), [] (auto& i, auto& j) {
-        return i.second < j.second;
-    });
-
-    using bucket_type = std::vector<sstables::shared_sstable>;
-    std::vector<bucket_type> bucket_list;
-    std::vector<double> bucket_average_size_list;
-
-    for (auto& pair : sorted_sstables) {
-        size_t size = pair.second;
-
-        // look for a bucket containing similar-sized files:
-        // group in the same bucket if it's w/in (bucket_low, bucket_high) of the average for this bucket,
-        // or this file and the bucket are all considered "small" (less than `minSSTableSize`)
-        if (!bucket_list.empty()) {
-            auto& bucket_average_size = bucket_average_size_list.back();
-
-            if ((size > (bucket_average_size * options.bucket_low) && size < (bucket_average_size * options.bucket_high)) ||
-                    (size < options.min_sstable_size && bucket_average_size < options.min_sstable_size)) {
-                auto& bucket = bucket_list.back();
-                auto total_size = bucket.size() * bucket_average_size;
-                auto new_average_size = (total_size + size) / (bucket.size() + 1);
-                auto smallest_sstable_in_bucket = bucket[0]->data_size();
-
-                // SSTables are added in increasing size order so the bucket's
-                // average might drift upwards.
-                // Don't let it drift too high, to a point where the smallest
-                // SSTable might fall out of range.
-                if (size < options.min_sstable_size || smallest_sstable_in_bucket > new_average_size * options.bucket_low) {
-                    bucket.push_back(pair.first);
-                    bucket_average_size = new_average_size;
-                    continue;
-                }
-            }
-        }
-
-        // no similar bucket found; put it in a new one
-        bucket_type new_bucket = {pair.first};
-        bucket_list.push_back(std::move(new_bucket));
-        bucket_average_size_list.push_back(size);
-    }
-
-    return bucket_list;
+    return get_buckets(create_sstable_and_length_pairs(sstables), options);
 }
 
 std::vector<std::vector<sstables::shared_sstable>>
@@ -134,11 +90,53 @@ size_tiered_compaction_strategy::most_interesting_bucket(std::vector<std::vector
     }
 
     // Pick the bucket with more elements, as efficiency of same-tier compactions increases with number of files.
-    auto& max = *std::max_element(pruned_buckets.begin(), pruned_buckets.end(), [] (const bucket_t& i, const bucket_t& j) {
+    // Among those, pick the one which removes the most duplicate keys per byte written.
+    auto scored_buckets = boost::copy_range<std::vector<std::pair<bucket_t, double>>>(pruned_buckets | boost::adaptors::transformed([] (bucket_t& bucket) {
+        auto score = duplicate_keys_per_byte(bucket);
+        return std::make_pair(std::move(bucket), score);
+    }));
+    auto& max = *std::max_element(scored_buckets.begin(), scored_buckets.end(), [] (const auto& i, const auto& j) {
         // FIXME: ignoring hotness by the time being.
-        return i.size() < j.size();
+        return std::make_pair(i.first.size(), i.second) < std::make_pair(j.first.size(), j.second);
     });
-    return std::move(max);
+    return std::move(max.first);
+}
+
+double size_tiered_compaction_strategy::duplicate_keys_per_byte(const std::vector<sstables::shared_sstable>& sstables) {
+    if (sstables.size() < 2) {
+        return 0;
+    }
+    std::optional<hll::HyperLogLog> merged;
+    double sum_of_estimates = 0;
+    uint64_t keys = 0;
+    uint64_t bytes = 0;
+    try {
+        for (auto& sst : sstables) {
+            auto& cardinality = sst->get_compaction_metadata().cardinality.elements;
+            temporary_buffer<uint8_t> buf(cardinality.size());
+            std::copy(cardinality.begin(), cardinality.end(), buf.get_write());
+            auto hll = hll::HyperLogLog::from_bytes(std::move(buf));
+            sum_of_estimates += hll.estimate();
+            if (merged) {
+                merged->merge(hll);
+            } else {
+                merged = std::move(hll);
+            }
+            keys += sst->get_estimated_key_count();
+            bytes += sst->data_size();
+        }
+    } catch (...) {
+        // Sstables written by other tools may lack the sketch.
+        return 0;
+    }
+    if (sum_of_estimates == 0 || bytes == 0) {
+        return 0;
+    }
+    // The sketches are coarse, so only their ratio is used, applied to the
+    // key counts from the summaries.
+    auto unique_ratio = std::clamp(merged->estimate() / sum_of_estimates, 0.0, 1.0);
+    auto written = bytes * unique_ratio;
+    return written > 0 ? keys * (1 - unique_ratio) / written : 0;
 }
 
 compaction_descriptor
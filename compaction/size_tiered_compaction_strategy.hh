@@ -106,6 +106,11 @@ class size_tiered_compaction_strategy : public compaction_strategy_impl {
         });
     }
 public:
+    // Group items of similar size into buckets. Takes pairs of an item and its
+    // size, e.g. sstables and their data sizes.
+    template <typename T>
+    static std::vector<std::vector<T>> get_buckets(std::vector<std::pair<T, uint64_t>> items, const size_tiered_compaction_strategy_options& options);
+
     size_tiered_compaction_strategy() = default;
 
     size_tiered_compaction_strategy(const std::map<sstring, sstring>& options);
@@ -123,6 +128,11 @@ class size_tiered_compaction_strategy : public compaction_strategy_impl {
         return compaction_strategy_type::size_tiered;
     }
 
+    // Estimate, from the cardinality sketches of the sstables, the number of
+    // duplicate partition keys that compacting them together would remove,
+    // per byte of output. Returns 0 when a sketch is missing.
+    static double duplicate_keys_per_byte(const std::vector<sstables::shared_sstable>& sstables);
+
     // Return the most interesting bucket for a set of sstables
     static std::vector<sstables::shared_sstable>
     most_interesting_bucket(const std::vector<sstables::shared_sstable>& candidates, int min_threshold, int max_threshold,
@@ -137,4 +147,53 @@ class size_tiered_compaction_strategy : public compaction_strategy_impl {
     friend class ::size_tiered_backlog_tracker;
 };
 
+template <typename T>
+std::vector<std::vector<T>>
+size_tiered_compaction_strategy::get_buckets(std::vector<std::pair<T, uint64_t>> items, const size_tiered_compaction_strategy_options& options) {
+    std::sort(items.begin(), items.end(), [] (auto& i, auto& j) {
+        return i.second < j.second;
+    });
+
+    using bucket_type = std::vector<T>;
+    std::vector<bucket_type> bucket_list;
+    std::vector<double> bucket_average_size_list;
+    std::vector<uint64_t> bucket_smallest_size_list;
+
+    for (auto& pair : items) {
+        size_t size = pair.second;
+
+        // look for a bucket containing similar-sized files:
+        // group in the same bucket if it's w/in (bucket_low, bucket_high) of the average for this bucket,
+        // or this file and the bucket are all considered "small" (less than `minSSTableSize`)
+        if (!bucket_list.empty()) {
+            auto& bucket_average_size = bucket_average_size_list.back();
+
+            if ((size > (bucket_average_size * options.bucket_low) && size < (bucket_average_size * options.bucket_high)) ||
+                    (size < options.min_sstable_size && bucket_average_size < options.min_sstable_size)) {
+                auto& bucket = bucket_list.back();
+                auto total_size = bucket.size() * bucket_average_size;
+                auto new_average_size = (total_size + size) / (bucket.size() + 1);
+                auto smallest_sstable_in_bucket = bucket_smallest_size_list.back();
+
+                // SSTables are added in increasing size order so the bucket's
+                // average might drift upwards.
+                // Don't let it drift too high, to a point where the smallest
+                // SSTable might fall out of range.
+                if (size < options.min_sstable_size || smallest_sstable_in_bucket > new_average_size * options.bucket_low) {
+                    bucket.push_back(std::move(pair.first));
+                    bucket_average_size = new_average_size;
+                    continue;
+                }
+            }
+        }
+
+        // no similar bucket found; put it in a new one
+        bucket_list.emplace_back().push_back(std::move(pair.first));
+        bucket_average_size_list.push_back(size);
+        bucket_smallest_size_list.push_back(size);
+    }
+
+    return bucket_list;
+}
+
 }
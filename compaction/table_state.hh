@@ -13,6 +13,7 @@
 #include "sstables/sstable_set.hh"
 #include "sstables/sstables_manager.hh"
 #include "compaction_descriptor.hh"
+#include "utils/estimated_histogram.hh"
 
 class reader_permit;
 
@@ -44,6 +45,8 @@ class table_state {
     virtual future<> on_compaction_completion(sstables::compaction_completion_desc desc, sstables::offstrategy offstrategy) = 0;
     virtual bool is_auto_compaction_disabled_by_user() const noexcept = 0;
     virtual const tombstone_gc_state& get_tombstone_gc_state() const noexcept = 0;
+    // Number of sstables touched by each single-partition read of the table, since it was created.
+    virtual const utils::estimated_histogram& get_sstables_per_read_histogram() const noexcept = 0;
 };
 
 }
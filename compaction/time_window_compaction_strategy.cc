@@ -16,6 +16,7 @@
 #include <boost/range/algorithm/min_element.hpp>
 #include <boost/range/algorithm/partial_sort.hpp>
 #include <boost/range/adaptor/reversed.hpp>
+#include <boost/range/adaptor/map.hpp>
 
 namespace sstables {
 
@@ -75,11 +76,19 @@ time_window_compaction_strategy_options::time_window_compaction_strategy_options
 class classify_by_timestamp {
     time_window_compaction_strategy_options _options;
     std::vector<int64_t> _known_windows;
+    // If engaged, the data of older windows all goes to time_window_compaction_strategy::overflow_window.
+    std::optional<int64_t> _oldest_regular_window;
 
 public:
-    explicit classify_by_timestamp(time_window_compaction_strategy_options options) : _options(std::move(options)) { }
+    explicit classify_by_timestamp(time_window_compaction_strategy_options options, std::optional<int64_t> oldest_regular_window = std::nullopt)
+        : _options(std::move(options))
+        , _oldest_regular_window(oldest_regular_window)
+    { }
     int64_t operator()(api::timestamp_type ts) {
         const auto window = time_window_compaction_strategy::get_window_for(_options, ts);
+        if (_oldest_regular_window && window < *_oldest_regular_window) {
+            return time_window_compaction_strategy::overflow_window;
+        }
         if (const auto it = boost::range::find(_known_windows, window); it != _known_windows.end()) {
             std::swap(*it, _known_windows.front());
             return window;
@@ -119,14 +128,31 @@ reader_consumer_v2 time_window_compaction_strategy::make_interposer_consumer(con
             && get_window_for(_options, *ms_meta.min_timestamp) == get_window_for(_options, *ms_meta.max_timestamp)) {
         return end_consumer;
     }
-    return [options = _options, end_consumer = std::move(end_consumer)] (flat_mutation_reader_v2 rd) mutable -> future<> {
+    // Late writes to windows older than the previous one are flushed into a
+    // single overflow sstable, rather than into one small sstable per window,
+    // see get_compaction_candidates().
+    std::optional<int64_t> oldest_regular_window;
+    if (ms_meta.from_memtable && ms_meta.max_timestamp) {
+        oldest_regular_window = get_window_for(_options, *ms_meta.max_timestamp) - get_window_size(_options);
+    }
+    return [options = _options, oldest_regular_window, end_consumer = std::move(end_consumer)] (flat_mutation_reader_v2 rd) mutable -> future<> {
         return mutation_writer::segregate_by_timestamp(
                 std::move(rd),
-                classify_by_timestamp(std::move(options)),
+                classify_by_timestamp(std::move(options), oldest_regular_window),
                 std::move(end_consumer));
     };
 }
 
+bool time_window_compaction_strategy::spans_several_windows(const shared_sstable& sst) const {
+    auto& stats = sst->get_stats_metadata();
+    return get_window_for(_options, stats.min_timestamp) != get_window_for(_options, stats.max_timestamp);
+}
+
+std::vector<std::vector<shared_sstable>>
+time_window_compaction_strategy::split_major_compaction_input(std::vector<shared_sstable> input) const {
+    return boost::copy_range<std::vector<std::vector<shared_sstable>>>(get_buckets(std::move(input), _options).first | boost::adaptors::map_values);
+}
+
 compaction_descriptor
 time_window_compaction_strategy::get_reshaping_job(std::vector<shared_sstable> input, schema_ptr schema, const ::io_priority_class& iop, reshape_mode mode) {
     std::vector<shared_sstable> single_window;
@@ -146,9 +172,7 @@ time_window_compaction_strategy::get_reshaping_job(std::vector<shared_sstable> i
     });
 
     for (auto& sst : input) {
-        auto min = sst->get_stats_metadata().min_timestamp;
-        auto max = sst->get_stats_metadata().max_timestamp;
-        if (get_window_for(_options, min) != get_window_for(_options, max)) {
+        if (spans_several_windows(sst)) {
             multi_window.push_back(sst);
         } else {
             single_window.push_back(sst);
@@ -289,14 +313,32 @@ time_window_compaction_strategy::get_next_non_expired_sstables(table_state& tabl
 
 std::vector<shared_sstable>
 time_window_compaction_strategy::get_compaction_candidates(table_state& table_s, strategy_control& control, std::vector<shared_sstable> candidate_sstables) {
+    auto min_threshold = table_s.min_compaction_threshold();
+    auto max_threshold = table_s.schema()->max_compaction_threshold();
+
+    // Sstables spanning several windows, like the overflow sstables of late
+    // writes, are kept out of the windows, so that they don't trigger the
+    // compaction of a whole window each.
+    auto it = std::partition(candidate_sstables.begin(), candidate_sstables.end(), [this] (const shared_sstable& sst) {
+        return !spans_several_windows(sst);
+    });
+    std::vector<shared_sstable> overflow(std::make_move_iterator(it), std::make_move_iterator(candidate_sstables.end()));
+    candidate_sstables.erase(it, candidate_sstables.end());
+
     auto p = get_buckets(std::move(candidate_sstables), _options);
     // Update the highest window seen, if necessary
     _highest_window_seen = std::max(_highest_window_seen, p.second);
 
-    update_estimated_compaction_by_tasks(p.first, table_s.min_compaction_threshold(), table_s.schema()->max_compaction_threshold());
+    update_estimated_compaction_by_tasks(p.first, min_threshold, max_threshold);
+    _estimated_remaining_tasks += size_tiered_compaction_strategy::estimated_pending_compactions(overflow, min_threshold, max_threshold, _stcs_options);
 
-    return newest_bucket(table_s, control, std::move(p.first), table_s.min_compaction_threshold(), table_s.schema()->max_compaction_threshold(),
-        _highest_window_seen);
+    auto most_interesting = newest_bucket(table_s, control, std::move(p.first), min_threshold, max_threshold, _highest_window_seen);
+    if (!most_interesting.empty()) {
+        return most_interesting;
+    }
+    // Merge the overflow sstables lazily, once there are enough of a similar size.
+    // The output of their compaction is segregated into the windows.
+    return size_tiered_compaction_strategy::most_interesting_bucket(overflow, min_threshold, max_threshold, _stcs_options);
 }
 
 timestamp_type
@@ -80,6 +80,10 @@ class time_window_compaction_strategy : public compaction_strategy_impl {
     // Better co-locate some windows into the same sstables than OOM.
     static constexpr uint64_t max_data_segregation_window_count = 100;
 
+    // The key of the stream into which a flush segregates the data of the
+    // windows older than the previous one.
+    static constexpr int64_t overflow_window = std::numeric_limits<int64_t>::min();
+
     using bucket_t = std::vector<shared_sstable>;
     enum class bucket_compaction_mode { none, size_tiered, major };
 public:
@@ -113,6 +117,8 @@ class time_window_compaction_strategy : public compaction_strategy_impl {
     get_next_non_expired_sstables(table_state& table_s, strategy_control& control, std::vector<shared_sstable> non_expiring_sstables, gc_clock::time_point compaction_time);
 
     std::vector<shared_sstable> get_compaction_candidates(table_state& table_s, strategy_control& control, std::vector<shared_sstable> candidate_sstables);
+
+    bool spans_several_windows(const shared_sstable& sst) const;
 public:
     // Find the lowest timestamp for window of given size
     static timestamp_type
@@ -168,6 +174,9 @@ class time_window_compaction_strategy : public compaction_strategy_impl {
         return true;
     }
 
+    // Windows are compacted independently of each other.
+    virtual std::vector<std::vector<shared_sstable>> split_major_compaction_input(std::vector<shared_sstable> input) const override;
+
     virtual compaction_descriptor get_reshaping_job(std::vector<shared_sstable> input, schema_ptr schema, const ::io_priority_class& iop, reshape_mode mode) override;
 };
 
@@ -24,6 +24,8 @@ template<allow_prefixes AllowPrefixes = allow_prefixes::no>
 class compound_type final {
 private:
     const std::vector<data_type> _types;
+    // Per-component comparators, selected once for the types.
+    const std::vector<value_tri_comparator> _comparators;
     const bool _byte_order_equal;
     const bool _byte_order_comparable;
     const bool _is_reversed;
@@ -35,6 +37,9 @@ class compound_type final {
 
     compound_type(std::vector<data_type> types)
         : _types(std::move(types))
+        , _comparators(boost::copy_range<std::vector<value_tri_comparator>>(_types | boost::adaptors::transformed([] (const data_type& t) {
+                return value_tri_comparator(*t);
+            })))
         , _byte_order_equal(std::all_of(_types.begin(), _types.end(), [] (const auto& t) {
                 return t->is_byte_order_equal();
             }))
@@ -48,6 +53,10 @@ class compound_type final {
         return _types;
     }
 
+    auto const& comparators() const {
+        return _comparators;
+    }
+
     bool is_singular() const {
         return _types.size() == 1;
     }
@@ -250,9 +259,9 @@ class compound_type final {
                 return compare_unsigned(b1, b2);
             }
         }
-        return lexicographical_tri_compare(_types.begin(), _types.end(),
-            begin(b1), end(b1), begin(b2), end(b2), [] (auto&& type, auto&& v1, auto&& v2) {
-                return type->compare(v1, v2);
+        return lexicographical_tri_compare(_comparators.begin(), _comparators.end(),
+            begin(b1), end(b1), begin(b2), end(b2), [] (const value_tri_comparator& cmp, auto&& v1, auto&& v2) {
+                return cmp(v1, v2);
             });
     }
     // Retruns true iff given prefix has no missing components
@@ -60,6 +60,14 @@ std::map<sstring, sstring> compressor::options() const {
     return {};
 }
 
+size_t compressor::dictionary_training_size() const {
+    return 0;
+}
+
+future<compressor::ptr_type> compressor::train_dictionary(const std::vector<temporary_buffer<char>>&) const {
+    return make_ready_future<ptr_type>();
+}
+
 compressor::ptr_type compressor::create(const sstring& name, const opt_getter& opts) {
     if (name.empty()) {
         return {};
@@ -10,10 +10,12 @@
 
 #include <map>
 #include <set>
+#include <vector>
 
 #include <seastar/core/future.hh>
 #include <seastar/core/shared_ptr.hh>
 #include <seastar/core/sstring.hh>
+#include <seastar/core/temporary_buffer.hh>
 
 #include "exceptions/exceptions.hh"
 
@@ -51,6 +53,24 @@ class compressor {
      */
     virtual std::map<sstring, sstring> options() const;
 
+    /**
+     * Returns the amount of uncompressed data the compressor wants to be
+     * trained on before compressing anything. Zero (the default) means the
+     * compressor doesn't use a trained dictionary.
+     */
+    virtual size_t dictionary_training_size() const;
+    /**
+     * Trains a dictionary on the given samples and returns a compressor
+     * using it. The returned compressor reports the dictionary in options(),
+     * so that it can be recreated from them for decompression.
+     * Returns a null pointer if no dictionary could be trained, in which
+     * case this compressor should be used as is.
+     * The training doesn't run on the reactor. The samples must be kept
+     * alive until the returned future resolves.
+     */
+    using ptr_type = shared_ptr<compressor>;
+    virtual future<ptr_type> train_dictionary(const std::vector<temporary_buffer<char>>& samples) const;
+
     /**
      * Compressor class name.
      */
@@ -61,7 +81,6 @@ class compressor {
     // to cheaply bridge sstable compression options / maps
     using opt_string = std::optional<sstring>;
     using opt_getter = std::function<opt_string(const sstring&)>;
-    using ptr_type = shared_ptr<compressor>;
 
     static ptr_type create(const sstring& name, const opt_getter&);
     static ptr_type create(const std::map<sstring, sstring>&);
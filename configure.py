@@ -354,6 +354,7 @@ scylla_tests = set([
     'test/boost/auth_test',
     'test/boost/batchlog_manager_test',
     'test/boost/big_decimal_test',
+    'test/boost/bloom_filter_test',
     'test/boost/broken_sstable_test',
     'test/boost/bytes_ostream_test',
     'test/boost/cache_flat_mutation_reader_test',
@@ -397,6 +398,7 @@ scylla_tests = set([
     'test/boost/flat_mutation_reader_test',
     'test/boost/flush_queue_test',
     'test/boost/fragmented_temporary_buffer_test',
+    'test/boost/frequency_sketch_test',
     'test/boost/frozen_mutation_test',
     'test/boost/gossiping_property_file_snitch_test',
     'test/boost/hash_test',
@@ -417,6 +419,7 @@ scylla_tests = set([
     'test/boost/summary_test',
     'test/boost/logalloc_test',
     'test/boost/logalloc_standard_allocator_segment_pool_backend_test',
+    'test/boost/maintenance_controller_test',
     'test/boost/managed_vector_test',
     'test/boost/managed_bytes_test',
     'test/boost/intrusive_array_test',
@@ -435,6 +438,7 @@ scylla_tests = set([
     'test/boost/nonwrapping_range_test',
     'test/boost/observable_test',
     'test/boost/partitioner_test',
+    'test/boost/paxos_state_test',
     'test/boost/querier_cache_test',
     'test/boost/query_processor_test',
     'test/boost/range_test',
@@ -468,6 +472,7 @@ scylla_tests = set([
     'test/boost/statement_restrictions_test',
     'test/boost/storage_proxy_test',
     'test/boost/top_k_test',
+    'test/boost/tournament_tree_test',
     'test/boost/transport_test',
     'test/boost/types_test',
     'test/boost/user_function_test',
@@ -726,6 +731,7 @@ scylla_core = (['message/messaging_service.cc',
                 'sstables/sstable_mutation_reader.cc',
                 'compaction/compaction.cc',
                 'compaction/compaction_strategy.cc',
+                'compaction/incremental_compaction_strategy.cc',
                 'compaction/size_tiered_compaction_strategy.cc',
                 'compaction/leveled_compaction_strategy.cc',
                 'compaction/time_window_compaction_strategy.cc',
@@ -763,6 +769,7 @@ scylla_core = (['message/messaging_service.cc',
                 'cql3/expr/expression.cc',
                 'cql3/expr/restrictions.cc',
                 'cql3/expr/prepare_expr.cc',
+                'cql3/expr/compiled_restriction.cc',
                 'cql3/functions/user_function.cc',
                 'cql3/functions/functions.cc',
                 'cql3/functions/aggregate_fcts.cc',
@@ -840,6 +847,8 @@ scylla_core = (['message/messaging_service.cc',
                 'validation.cc',
                 'service/priority_manager.cc',
                 'service/migration_manager.cc',
+                'service/read_coalescing.cc',
+                'service/row_level_read_repair.cc',
                 'service/storage_proxy.cc',
                 'query_ranges_to_vnodes.cc',
                 'service/forward_service.cc',
@@ -886,6 +895,7 @@ scylla_core = (['message/messaging_service.cc',
                 'db/large_data_handler.cc',
                 'db/marshal/type_parser.cc',
                 'db/batchlog_manager.cc',
+                'db/cache_warmup.cc',
                 'db/tags/utils.cc',
                 'db/view/view.cc',
                 'db/view/view_update_generator.cc',
@@ -899,6 +909,7 @@ scylla_core = (['message/messaging_service.cc',
                 'utils/UUID_gen.cc',
                 'utils/i_filter.cc',
                 'utils/bloom_filter.cc',
+                'utils/secondary_page_cache.cc',
                 'utils/bloom_calculations.cc',
                 'utils/rate_limiter.cc',
                 'utils/file_lock.cc',
@@ -1017,6 +1028,7 @@ scylla_core = (['message/messaging_service.cc',
                 'mutation_writer/timestamp_based_splitting_writer.cc',
                 'mutation_writer/shard_based_splitting_writer.cc',
                 'mutation_writer/partition_based_splitting_writer.cc',
+                'mutation_writer/size_based_splitting_writer.cc',
                 'mutation_writer/feed_writers.cc',
                 'lang/lua.cc',
                 'lang/wasm.cc',
@@ -1141,6 +1153,7 @@ idls = ['idl/gossip_digest.idl.hh',
         'idl/raft_storage.idl.hh',
         'idl/group0.idl.hh',
         'idl/hinted_handoff.idl.hh',
+        'idl/batched_mutation.idl.hh',
         'idl/storage_proxy.idl.hh',
         'idl/group0_state_machine.idl.hh',
         'idl/forward_request.idl.hh',
@@ -1192,7 +1205,6 @@ pure_boost_tests = set([
     'test/boost/cartesian_product_test',
     'test/boost/checksum_utils_test',
     'test/boost/chunked_vector_test',
-    'test/boost/compress_test',
     'test/boost/cql_auth_syntax_test',
     'test/boost/crc_test',
     'test/boost/duration_test',
@@ -1204,6 +1216,8 @@ pure_boost_tests = set([
     'test/boost/keys_test',
     'test/boost/like_matcher_test',
     'test/boost/linearizing_input_stream_test',
+    'test/boost/frequency_sketch_test',
+    'test/boost/maintenance_controller_test',
     'test/boost/map_difference_test',
     'test/boost/nonwrapping_range_test',
     'test/boost/observable_test',
@@ -1212,6 +1226,7 @@ pure_boost_tests = set([
     'test/boost/serialization_test',
     'test/boost/small_vector_test',
     'test/boost/top_k_test',
+    'test/boost/tournament_tree_test',
     'test/boost/vint_serialization_test',
     'test/boost/bptree_test',
     'test/boost/utf8_test',
@@ -851,6 +851,7 @@ typeColumns[create_type_statement& expr]
 
 /**
  * CREATE INDEX [IF NOT EXISTS] [indexName] ON <columnFamily> (<columnName>);
+ * CREATE INDEX [IF NOT EXISTS] [indexName] ON <columnFamily> (<columnName>) INCLUDE (<columnName>, ...);
  * CREATE CUSTOM INDEX [IF NOT EXISTS] [indexName] ON <columnFamily> (<columnName>) USING <indexClass>;
  */
 createIndexStatement returns [std::unique_ptr<create_index_statement> expr]
@@ -862,6 +863,7 @@ createIndexStatement returns [std::unique_ptr<create_index_statement> expr]
     }
     : K_CREATE (K_CUSTOM { props->is_custom = true; })? K_INDEX (K_IF K_NOT K_EXISTS { if_not_exists = true; } )?
         (idxName[*name])? K_ON cf=columnFamilyName '(' (target1=indexIdent { targets.emplace_back(target1); } (',' target2=indexIdent { targets.emplace_back(target2); } )*)? ')'
+        (K_INCLUDE '(' c1=cident { props->included_columns.push_back(c1); } (',' cn=cident { props->included_columns.push_back(cn); } )* ')')?
         (K_USING cls=STRING_LITERAL { props->custom_class = sstring{$cls.text}; })?
         (K_WITH properties[*props])?
       { $expr = std::make_unique<create_index_statement>(cf, name, targets, props, if_not_exists); }
@@ -1956,6 +1958,7 @@ basic_unreserved_keyword returns [sstring str]
         | K_LEVEL
         | K_LEVELS
         | K_PRUNE
+        | K_INCLUDE
         ) { $str = $k.text; }
     ;
 
@@ -2021,6 +2024,7 @@ K_COLUMNFAMILY:( C O L U M N F A M I L Y
 K_MATERIALIZED:M A T E R I A L I Z E D;
 K_VIEW:        V I E W;
 K_INDEX:       I N D E X;
+K_INCLUDE:     I N C L U D E;
 K_CUSTOM:      C U S T O M;
 K_ON:          O N;
 K_TO:          T O;
@@ -90,16 +90,26 @@ class authorized_prepared_statements_cache {
         return _stats;
     }
 
+    // Changes whenever an entry stops being valid, so that what was copied
+    // from the cache can be validated by the generation it was copied in,
+    // see service::client_state::has_authorized_prepared().
+    static uint64_t& shard_generation() {
+        static thread_local uint64_t _generation = 0;
+        return _generation;
+    }
+
     struct authorized_prepared_statements_cache_stats_updater {
         static void inc_hits() noexcept {}
         static void inc_misses() noexcept {}
         static void inc_blocks() noexcept {}
         static void inc_evictions() noexcept {
             ++shard_stats().authorized_prepared_statements_cache_evictions;
+            ++shard_generation();
         }
 
         static void inc_unprivileged_on_cache_size_eviction() noexcept {
             ++shard_stats().authorized_prepared_statements_unprivileged_entries_evictions_on_size;
+            ++shard_generation();
         }
     };
 
@@ -132,6 +142,7 @@ class authorized_prepared_statements_cache {
     authorized_prepared_statements_cache(utils::loading_cache_config c, logging::logger& logger)
         : _cache(std::move(c), logger, [this] (const key_type& k) {
             _cache.remove(k);
+            ++shard_generation();
             return make_ready_future<value_type>();
         })
     {}
@@ -148,6 +159,7 @@ class authorized_prepared_statements_cache {
 
     void remove(const auth::authenticated_user& user, const cql3::prepared_cache_key_type& prep_cache_key) {
         _cache.remove(key_view_type{user, prep_cache_key}, key_view_hasher(), key_view_equal());
+        ++shard_generation();
     }
 
     size_t size() const {
@@ -159,11 +171,13 @@ class authorized_prepared_statements_cache {
     }
 
     bool update_config(utils::loading_cache_config c) {
+        ++shard_generation();
         return _cache.update_config(std::move(c));
     }
 
     void reset() {
         _cache.reset();
+        ++shard_generation();
     }
 
     future<> stop() {
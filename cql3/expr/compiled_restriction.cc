@@ -0,0 +1,245 @@
+/*
+ * Copyright (C) 2022-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <algorithm>
+
+#include "compiled_restriction.hh"
+#include "cql3/selection/selection.hh"
+
+namespace cql3 {
+namespace expr {
+
+namespace {
+
+bool depends_on_row(const expression& e) {
+    return find_in_expression<column_value>(e, [] (const column_value&) { return true; })
+            || find_in_expression<subscript>(e, [] (const subscript&) { return true; })
+            || contains_nonpure_function(e);
+}
+
+bool is_compiled_op(oper_t op) {
+    return op == oper_t::EQ || op == oper_t::NEQ || is_slice(op) || op == oper_t::IN;
+}
+
+bool bytes_less(const managed_bytes& a, const managed_bytes& b) {
+    return compare_unsigned(managed_bytes_view(a), managed_bytes_view(b)) < 0;
+}
+
+struct fixed_width_type {
+    uint8_t width = 0;
+    bool is_signed = false;
+};
+
+fixed_width_type fixed_width_of(const abstract_type& t) {
+    switch (t.get_kind()) {
+    case abstract_type::kind::byte:
+        return {1, true};
+    case abstract_type::kind::short_kind:
+        return {2, true};
+    case abstract_type::kind::int32:
+        return {4, true};
+    case abstract_type::kind::simple_date:
+        return {4, false};
+    case abstract_type::kind::long_kind:
+    case abstract_type::kind::time:
+    case abstract_type::kind::timestamp:
+        return {8, true};
+    default:
+        return {};
+    }
+}
+
+}
+
+std::optional<uint64_t> compiled_restriction::fixed_width_key(managed_bytes_view v, uint8_t width, bool is_signed) {
+    if (v.size_bytes() != width) {
+        return std::nullopt;
+    }
+    uint64_t key = 0;
+    for (bytes_view frag : fragment_range(v)) {
+        for (auto b : frag) {
+            key = (key << 8) | uint8_t(b);
+        }
+    }
+    if (is_signed) {
+        // Flipping the sign bit orders negative values before positive ones.
+        key ^= uint64_t(1) << (width * 8 - 1);
+    }
+    return key;
+}
+
+compiled_restriction::compiled_restriction(const expression& restriction, const cql3::selection::selection& sel, const query_options& options) {
+    for_each_boolean_factor(restriction, [&] (const expression& factor) {
+        compile_factor(factor, sel, options);
+    });
+}
+
+void compiled_restriction::compile_factor(const expression& factor, const cql3::selection::selection& sel, const query_options& options) {
+    const auto* opr = as_if<binary_operator>(&factor);
+    const auto* col = opr ? as_if<column_value>(&opr->lhs) : nullptr;
+    if (!col || !is_compiled_op(opr->op) || depends_on_row(opr->rhs)) {
+        _checks.push_back(check{.factor = &factor});
+        return;
+    }
+    const column_definition& cdef = *col->col;
+    const auto fixed_width = fixed_width_of(cdef.type->without_reversed());
+    check c{
+        .op = opr->op,
+        .byte_order_equal = cdef.type->is_byte_order_equal(),
+        .type = &cdef.type->without_reversed(),
+        .fixed_width = fixed_width.width,
+        .fixed_width_signed = fixed_width.is_signed,
+    };
+    switch (cdef.kind) {
+    case column_kind::partition_key:
+        c.source = column_source::partition_key;
+        c.index = cdef.id;
+        break;
+    case column_kind::clustering_key:
+        c.source = column_source::clustering_key;
+        c.index = cdef.id;
+        break;
+    case column_kind::static_column:
+    case column_kind::regular_column: {
+        const auto index = sel.index_of(cdef);
+        if (index == -1) {
+            // Not in the selection, is_satisfied_by() reports the error.
+            _checks.push_back(check{.factor = &factor});
+            return;
+        }
+        c.source = column_source::static_and_regular_columns;
+        c.index = index;
+        break;
+    }
+    default:
+        _checks.push_back(check{.factor = &factor});
+        return;
+    }
+
+    auto rhs = evaluate(opr->rhs, options);
+    if (rhs.is_unset_value() || (opr->op == oper_t::IN && rhs.is_null())) {
+        // Invalid, is_satisfied_by() reports the error.
+        _checks.push_back(check{.factor = &factor});
+        return;
+    }
+    if (opr->op == oper_t::IN) {
+        auto elements = get_list_elements(rhs);
+        c.values.assign(std::make_move_iterator(elements.begin()), std::make_move_iterator(elements.end()));
+        if (c.byte_order_equal) {
+            std::sort(c.values.begin(), c.values.end(), bytes_less);
+        }
+        if (c.fixed_width) {
+            for (const auto& v : c.values) {
+                auto key = fixed_width_key(v, c.fixed_width, c.fixed_width_signed);
+                if (!key) {
+                    c.keys.clear();
+                    break;
+                }
+                c.keys.push_back(*key);
+            }
+            std::sort(c.keys.begin(), c.keys.end());
+        }
+    } else {
+        c.value = std::move(rhs).to_managed_bytes_opt();
+        if (c.fixed_width && c.value) {
+            c.key = fixed_width_key(*c.value, c.fixed_width, c.fixed_width_signed);
+        }
+    }
+    _checks.push_back(std::move(c));
+}
+
+size_t compiled_restriction::uncompiled_factors() const {
+    return std::count_if(_checks.begin(), _checks.end(), [] (const check& c) { return c.factor; });
+}
+
+bool compiled_restriction::is_satisfied_by(const check& c, const evaluation_inputs& inputs) {
+    if (c.factor) {
+        return expr::is_satisfied_by(*c.factor, inputs);
+    }
+
+    std::optional<managed_bytes_view> lhs;
+    switch (c.source) {
+    case column_source::partition_key:
+        lhs.emplace(bytes_view((*inputs.partition_key)[c.index]));
+        break;
+    case column_source::clustering_key:
+        lhs.emplace(bytes_view((*inputs.clustering_key)[c.index]));
+        break;
+    case column_source::static_and_regular_columns:
+        if (const auto& v = (*inputs.static_and_regular_columns)[c.index]) {
+            lhs.emplace(*v);
+        }
+        break;
+    }
+
+    if (lhs && (c.key || !c.keys.empty())) {
+        if (auto key = fixed_width_key(*lhs, c.fixed_width, c.fixed_width_signed)) {
+            switch (c.op) {
+            case oper_t::EQ:
+                return *key == *c.key;
+            case oper_t::NEQ:
+                return *key != *c.key;
+            case oper_t::IN:
+                return std::binary_search(c.keys.begin(), c.keys.end(), *key);
+            case oper_t::LT:
+                return *key < *c.key;
+            case oper_t::LTE:
+                return *key <= *c.key;
+            case oper_t::GT:
+                return *key > *c.key;
+            default:
+                return *key >= *c.key;
+            }
+        }
+    }
+
+    auto equal = [&] (managed_bytes_view rhs) {
+        return c.byte_order_equal ? compare_unsigned(*lhs, rhs) == 0 : c.type->equal(*lhs, rhs);
+    };
+    switch (c.op) {
+    case oper_t::EQ:
+        return lhs && c.value && equal(*c.value);
+    case oper_t::NEQ:
+        return !(lhs && c.value && equal(*c.value));
+    case oper_t::IN:
+        if (!lhs) {
+            return false;
+        }
+        if (c.byte_order_equal) {
+            return std::binary_search(c.values.begin(), c.values.end(), *lhs, [] (const auto& a, const auto& b) {
+                return compare_unsigned(managed_bytes_view(a), managed_bytes_view(b)) < 0;
+            });
+        }
+        return std::any_of(c.values.begin(), c.values.end(), [&] (const managed_bytes& v) { return equal(v); });
+    default: {
+        if (!lhs || !c.value) {
+            return false;
+        }
+        const auto cmp = c.type->compare(*lhs, *c.value);
+        switch (c.op) {
+        case oper_t::LT:
+            return cmp < 0;
+        case oper_t::LTE:
+            return cmp <= 0;
+        case oper_t::GT:
+            return cmp > 0;
+        default:
+            return cmp >= 0;
+        }
+    }
+    }
+}
+
+bool compiled_restriction::is_satisfied_by(const evaluation_inputs& inputs) const {
+    return std::all_of(_checks.begin(), _checks.end(), [&] (const check& c) {
+        return is_satisfied_by(c, inputs);
+    });
+}
+
+} // namespace expr
+} // namespace cql3
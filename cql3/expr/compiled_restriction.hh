@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2022-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "expression.hh"
+
+namespace cql3 {
+namespace expr {
+
+/// A restriction lowered for evaluating on every row an execution of a
+/// statement filters.
+///
+/// is_satisfied_by() visits the expression tree of a restriction and
+/// evaluates its right-hand sides again for every row, copying the values of
+/// the columns and of the bind variables on the way. A compiled restriction
+/// is instead a flat list of checks, one for every factor of the conjunction,
+/// each with the column it reads resolved to its position in the row, and the
+/// right-hand side evaluated once, when the restriction is compiled.
+/// Columns of fixed-width integer types (tinyint, smallint, int, bigint,
+/// time, timestamp, date) are compared as unsigned integers, rather than by
+/// the comparator of their type.
+///
+/// Comparisons of a column with a value (=, !=, <, <=, >, >=, IN) whose value
+/// doesn't depend on the row are compiled. Other factors, like CONTAINS, LIKE
+/// or multi-column restrictions, are evaluated by is_satisfied_by(), so a
+/// compiled restriction is satisfied by exactly the rows the restriction is.
+class compiled_restriction {
+public:
+    enum class column_source : uint8_t {
+        partition_key,
+        clustering_key,
+        static_and_regular_columns,
+    };
+private:
+    struct check {
+        oper_t op;
+        column_source source;
+        // Values of the type are equal only if their bytes are, so they
+        // can be compared without deserializing them.
+        bool byte_order_equal;
+        uint32_t index;
+        const abstract_type* type;
+        // The width of the values of a fixed-width integer type, which
+        // are compared by their keys, or 0.
+        uint8_t fixed_width;
+        bool fixed_width_signed;
+        // The right-hand side of a comparison.
+        managed_bytes_opt value;
+        std::optional<uint64_t> key;
+        // The right-hand side of IN, sorted by bytes if byte_order_equal.
+        std::vector<managed_bytes> values;
+        // The keys of the right-hand side of IN, sorted, if all values have
+        // one.
+        std::vector<uint64_t> keys;
+        // The factor, if it isn't compiled.
+        const expression* factor = nullptr;
+    };
+    std::vector<check> _checks;
+private:
+    void compile_factor(const expression& factor, const cql3::selection::selection& sel, const query_options& options);
+    static bool is_satisfied_by(const check& c, const evaluation_inputs& inputs);
+public:
+    /// Maps a value of a fixed-width integer type to an unsigned integer,
+    /// which compares to the keys of other values like the value compares
+    /// to them. Values which aren't of the width, like empty ones, have no
+    /// key.
+    static std::optional<uint64_t> fixed_width_key(managed_bytes_view v, uint8_t width, bool is_signed);
+public:
+    /// Compiles the restriction, for evaluating on rows of a query of the
+    /// selection, with these options.
+    ///
+    /// The restriction has to outlive the compiled restriction.
+    compiled_restriction(const expression& restriction, const cql3::selection::selection& sel, const query_options& options);
+
+    /// The number of the factors of the restriction which aren't compiled.
+    size_t uncompiled_factors() const;
+
+    /// True iff the restriction is satisfied by the row of the inputs, which
+    /// have to be of the selection and options the restriction was compiled
+    /// for.
+    bool is_satisfied_by(const evaluation_inputs& inputs) const;
+};
+
+} // namespace expr
+} // namespace cql3
@@ -28,6 +28,7 @@
 #include "types/list.hh"
 #include "types/map.hh"
 #include "types/set.hh"
+#include "types/listlike_partial_deserializing_iterator.hh"
 #include "utils/like_matcher.hh"
 #include "query-result-reader.hh"
 #include "types/user.hh"
@@ -166,7 +167,6 @@ get_value(const subscript& s, const evaluation_inputs& inputs) {
         // For null[i] we return null.
         return std::nullopt;
     }
-    const auto deserialized = cdef->type->deserialize(managed_bytes_view(*serialized));
     const auto key = evaluate(s.sub, inputs);
     auto&& key_type = col_type->is_map() ? col_type->name_comparator() : int32_type;
     if (key.is_null()) {
@@ -192,25 +192,35 @@ get_value(const subscript& s, const evaluation_inputs& inputs) {
             format("Unsupported unset map key for column {}",
                 cdef->name_as_text()));
     }
+    // Walk the serialized collection rather than deserializing it, so that
+    // only the element looked up is copied out.
+    auto sf = cql_serialization_format::internal();
+    managed_bytes_view in(*serialized);
     if (col_type->is_map()) {
-        const auto& data_map = value_cast<map_type_impl::native_type>(deserialized);
-        const auto found = key.view().with_linearized([&] (bytes_view key_bv) {
-            using entry = std::pair<data_value, data_value>;
-            return std::find_if(data_map.cbegin(), data_map.cend(), [&] (const entry& element) {
-                return key_type->compare(element.first.serialize_nonnull(), key_bv) == 0;
-            });
+        return key.view().with_linearized([&] (bytes_view key_bv) -> managed_bytes_opt {
+            auto size = read_collection_size(in, sf);
+            for (int i = 0; i < size; ++i) {
+                auto kv = read_collection_value(in, sf);
+                auto vv = read_collection_value(in, sf);
+                if (key_type->compare(kv, managed_bytes_view(key_bv)) == 0) {
+                    return managed_bytes(vv);
+                }
+            }
+            return std::nullopt;
         });
-        return found == data_map.cend() ? std::nullopt : managed_bytes_opt(found->second.serialize_nonnull());
     } else if (col_type->is_list()) {
-        const auto& data_list = value_cast<list_type_impl::native_type>(deserialized);
         auto key_deserialized = key.view().with_linearized([&] (bytes_view key_bv) {
             return key_type->deserialize(key_bv);
         });
         auto key_int = value_cast<int32_t>(key_deserialized);
-        if (key_int < 0 || size_t(key_int) >= data_list.size()) {
+        auto size = read_collection_size(in, sf);
+        if (key_int < 0 || key_int >= size) {
             return std::nullopt;
         }
-        return managed_bytes_opt(data_list[key_int].serialize_nonnull());
+        for (int i = 0; i < key_int; ++i) {
+            read_collection_value(in, sf);
+        }
+        return managed_bytes(read_collection_value(in, sf));
     } else {
         throw exceptions::invalid_request_exception(format("subscripting non-map, non-list column {}", cdef->name_as_text()));
     }
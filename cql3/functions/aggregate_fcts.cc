@@ -16,10 +16,15 @@
 #include "utils/big_decimal.hh"
 #include "aggregate_fcts.hh"
 #include "user_aggregate.hh"
+#include "user_function.hh"
 #include "functions.hh"
 #include "native_aggregate_function.hh"
 #include "exceptions/exceptions.hh"
 #include "utils/multiprecision_int.hh"
+#include "utils/murmur_hash.hh"
+#include "utils/tdigest.hh"
+#include "sstables/hyperloglog.hh"
+#include <cmath>
 #include <cstddef>
 #include <cstdint>
 #include <optional>
@@ -128,6 +133,16 @@ struct int128_accumulator_for {
         return cast_to_accumulator(varint_type->deserialize(*acc));
     }
 
+    // Reads an input value directly, without going through data_value,
+    // which would allocate for every row.
+    static T deserialize_input(bytes_view v) {
+        if (v.size() == sizeof(T)) {
+            return net::ntoh(read_unaligned<T>(v.begin()));
+        }
+        // Let the type report empty or malformed values.
+        return value_cast<T>(data_type_for<T>()->deserialize(v));
+    }
+
     static shared_ptr<const abstract_type> data_type() {
         return varint_type;
     }
@@ -161,6 +176,10 @@ struct same_type_accumulator_for {
         return cast_to_accumulator(data_type_for<type>()->deserialize(*acc));
     }
 
+    static T deserialize_input(bytes_view v) {
+        return value_cast<T>(data_type_for<T>()->deserialize(v));
+    }
+
     static shared_ptr<const abstract_type> data_type() {
         return data_type_for<T>();
     }
@@ -173,11 +192,37 @@ struct accumulator_for : public std::conditional_t<std::is_integral_v<T>,
 { };
 
 class impl_user_aggregate : public aggregate_function::aggregate {
+    // The number of inputs buffered before they are folded into the
+    // accumulator, so that a WebAssembly state function is called on one
+    // instance for all of them, rather than taking one from the cache for
+    // every row.
+    static constexpr size_t max_pending_inputs = 128;
+
     ::shared_ptr<scalar_function> _sfunc;
     ::shared_ptr<scalar_function> _rfunc;
     ::shared_ptr<scalar_function> _finalfunc;
     const bytes_opt _initcond;
-    bytes_opt _acc;
+    // The accumulator is mutable, since get_accumulator() folds the pending
+    // inputs into it.
+    mutable bytes_opt _acc;
+    mutable std::vector<std::vector<bytes_opt>> _pending;
+    cql_serialization_format _sf = cql_serialization_format::internal();
+private:
+    void flush() const {
+        if (_pending.empty()) {
+            return;
+        }
+        if (auto sfunc = dynamic_pointer_cast<user_function>(_sfunc)) {
+            _acc = sfunc->fold(_sf, std::move(_acc), _pending);
+        } else {
+            for (const auto& values : _pending) {
+                std::vector<bytes_opt> args{_acc};
+                args.insert(args.end(), values.begin(), values.end());
+                _acc = _sfunc->execute(_sf, args);
+            }
+        }
+        _pending.clear();
+    }
 public:
     impl_user_aggregate(bytes_opt initcond, ::shared_ptr<scalar_function> sfunc, ::shared_ptr<scalar_function> rfunc, ::shared_ptr<scalar_function> finalfunc)
             : _sfunc(std::move(sfunc))
@@ -187,23 +232,30 @@ class impl_user_aggregate : public aggregate_function::aggregate {
             , _acc(_initcond)
         {}
     virtual void reset() override {
+        _pending.clear();
         _acc = _initcond;
     }
     virtual opt_bytes compute(cql_serialization_format sf) override {
+        flush();
         return _finalfunc ? _finalfunc->execute(sf, std::vector<bytes_opt>{_acc}) : _acc;
     }
     virtual void add_input(cql_serialization_format sf, const std::vector<opt_bytes>& values) override {
-        std::vector<bytes_opt> args{_acc};
-        args.insert(args.end(), values.begin(), values.end());
-        _acc = _sfunc->execute(sf, args);
+        _sf = sf;
+        _pending.push_back(values);
+        if (_pending.size() >= max_pending_inputs) {
+            flush();
+        }
     }
     virtual void set_accumulator(const opt_bytes& acc) override {
+        _pending.clear();
         _acc = acc;
     }
     virtual opt_bytes get_accumulator() const override {
+        flush();
         return _acc;
     }
     virtual void reduce(cql_serialization_format sf, const opt_bytes& acc) override {
+        flush();
         std::vector<bytes_opt> args{_acc, acc};
         _acc = _rfunc->execute(sf, args);
     }
@@ -225,7 +277,7 @@ class impl_sum_function_for : public aggregate_function::aggregate {
         if (!values[0]) {
             return;
         }
-        _sum += value_cast<Type>(data_type_for<Type>()->deserialize(*values[0]));
+        _sum += accumulator_for<Type>::deserialize_input(*values[0]);
     }
     virtual void set_accumulator(const opt_bytes& acc) override {
         if (acc) {
@@ -328,7 +380,7 @@ class impl_avg_function_for : public aggregate_function::aggregate {
             return;
         }
         ++_count;
-        _sum += value_cast<Type>(data_type_for<Type>()->deserialize(*values[0]));
+        _sum += accumulator_for<Type>::deserialize_input(*values[0]);
     }
     virtual void set_accumulator(const opt_bytes& acc) override {
         if (acc) {
@@ -772,6 +824,193 @@ template <typename Type>
 static shared_ptr<aggregate_function> make_count_function() {
     return make_shared<count_function_for<Type>>();
 }
+
+// The estimates of approx_count_distinct() have a standard error of
+// 1.04 / sqrt(2^12), about 1.6%, and its accumulator takes about 4KB.
+static constexpr uint8_t approx_count_distinct_precision = 12;
+
+class impl_approx_count_distinct_function : public aggregate_function::aggregate {
+protected:
+    hll::HyperLogLog _hll{approx_count_distinct_precision};
+
+    static hll::HyperLogLog deserialize(const bytes& acc) {
+        try {
+            return hll::HyperLogLog::from_bytes(temporary_buffer<uint8_t>(reinterpret_cast<const uint8_t*>(acc.data()), acc.size()));
+        } catch (std::invalid_argument& e) {
+            throw exceptions::invalid_request_exception(format("Invalid approx_count_distinct() accumulator: {}", e.what()));
+        }
+    }
+public:
+    virtual void reset() override {
+        _hll.clear();
+    }
+    virtual opt_bytes compute(cql_serialization_format sf) override {
+        return long_type->decompose(int64_t(std::llround(_hll.estimate())));
+    }
+    virtual void add_input(cql_serialization_format sf, const std::vector<opt_bytes>& values) override {
+        if (!values[0]) {
+            return;
+        }
+        std::array<uint64_t, 2> hash;
+        utils::murmur_hash::hash3_x64_128(*values[0], 0, hash);
+        _hll.offer_hashed(hash[0]);
+    }
+    virtual void set_accumulator(const opt_bytes& acc) override {
+        if (acc) {
+            _hll = deserialize(*acc);
+        } else {
+            reset();
+        }
+    }
+    virtual opt_bytes get_accumulator() const override {
+        auto buf = _hll.get_bytes();
+        return bytes(reinterpret_cast<const int8_t*>(buf.get()), buf.size());
+    }
+    virtual void reduce(cql_serialization_format sf, const opt_bytes& acc) override {
+        if (acc) {
+            _hll.merge(deserialize(*acc));
+        }
+    }
+};
+
+class impl_reducible_approx_count_distinct_function final : public impl_approx_count_distinct_function {
+public:
+    virtual opt_bytes compute(cql_serialization_format sf) override {
+        return get_accumulator();
+    }
+};
+
+/// Estimates the number of distinct non-null values of a column, with a
+/// HyperLogLog sketch of their hashes. Values are distinct if their
+/// serialized forms are.
+class approx_count_distinct_function final : public native_aggregate_function {
+    data_type _input_type;
+public:
+    approx_count_distinct_function(data_type input_type, data_type return_type = long_type)
+            : native_aggregate_function("approx_count_distinct", std::move(return_type), { input_type })
+            , _input_type(std::move(input_type)) {}
+    virtual bool is_reducible() const override {
+        return true;
+    }
+    virtual std::unique_ptr<aggregate> new_aggregate() override {
+        return std::make_unique<impl_approx_count_distinct_function>();
+    }
+    virtual ::shared_ptr<aggregate_function> reducible_aggregate_function() override {
+        class reducible_approx_count_distinct_function : public approx_count_distinct_function {
+        public:
+            reducible_approx_count_distinct_function(data_type input_type)
+                    : approx_count_distinct_function(std::move(input_type), bytes_type) {}
+            virtual std::unique_ptr<aggregate> new_aggregate() override {
+                return std::make_unique<impl_reducible_approx_count_distinct_function>();
+            }
+        };
+        return ::make_shared<reducible_approx_count_distinct_function>(_input_type);
+    }
+};
+
+template <typename Type>
+class impl_approx_percentile_function_for : public aggregate_function::aggregate {
+protected:
+    double _quantile;
+    utils::tdigest _digest;
+
+    static utils::tdigest deserialize(const bytes& acc) {
+        try {
+            return utils::tdigest::deserialize(acc);
+        } catch (std::invalid_argument& e) {
+            throw exceptions::invalid_request_exception(format("Invalid approximate percentile accumulator: {}", e.what()));
+        }
+    }
+public:
+    explicit impl_approx_percentile_function_for(double quantile) : _quantile(quantile) {}
+
+    virtual void reset() override {
+        _digest = utils::tdigest();
+    }
+    virtual opt_bytes compute(cql_serialization_format sf) override {
+        auto q = _digest.quantile(_quantile);
+        if (!q) {
+            return std::nullopt;
+        }
+        return double_type->decompose(*q);
+    }
+    virtual void add_input(cql_serialization_format sf, const std::vector<opt_bytes>& values) override {
+        if (!values[0] || values[0]->empty()) {
+            return;
+        }
+        _digest.add(double(value_cast<Type>(data_type_for<Type>()->deserialize(*values[0]))));
+    }
+    virtual void set_accumulator(const opt_bytes& acc) override {
+        if (acc) {
+            _digest = deserialize(*acc);
+        } else {
+            reset();
+        }
+    }
+    virtual opt_bytes get_accumulator() const override {
+        return _digest.serialize();
+    }
+    virtual void reduce(cql_serialization_format sf, const opt_bytes& acc) override {
+        if (acc) {
+            _digest.merge(deserialize(*acc));
+        }
+    }
+};
+
+template <typename Type>
+class impl_reducible_approx_percentile_function_for final : public impl_approx_percentile_function_for<Type> {
+public:
+    using impl_approx_percentile_function_for<Type>::impl_approx_percentile_function_for;
+    virtual opt_bytes compute(cql_serialization_format sf) override {
+        return this->get_accumulator();
+    }
+};
+
+/// Estimates a percentile of the non-null values of a numeric column, with
+/// a t-digest of them. The percentile is part of the name of the function,
+/// as the selectors of aggregates can't have constant arguments.
+template <typename Type>
+class approx_percentile_function_for : public native_aggregate_function {
+protected:
+    double _quantile;
+public:
+    approx_percentile_function_for(sstring name, double quantile, data_type return_type = double_type)
+            : native_aggregate_function(std::move(name), std::move(return_type), { data_type_for<Type>() })
+            , _quantile(quantile) {}
+    virtual bool is_reducible() const override {
+        return true;
+    }
+    virtual std::unique_ptr<aggregate> new_aggregate() override {
+        return std::make_unique<impl_approx_percentile_function_for<Type>>(_quantile);
+    }
+    virtual ::shared_ptr<aggregate_function> reducible_aggregate_function() override {
+        class reducible_approx_percentile_function : public approx_percentile_function_for<Type> {
+        public:
+            reducible_approx_percentile_function(sstring name, double quantile)
+                    : approx_percentile_function_for<Type>(std::move(name), quantile, bytes_type) {}
+            virtual std::unique_ptr<aggregate_function::aggregate> new_aggregate() override {
+                return std::make_unique<impl_reducible_approx_percentile_function_for<Type>>(this->_quantile);
+            }
+        };
+        return ::make_shared<reducible_approx_percentile_function>(name().name, _quantile);
+    }
+};
+
+static const std::pair<sstring, double> approx_percentiles[] = {
+    {"approx_median", 0.5},
+    {"approx_percentile_90", 0.9},
+    {"approx_percentile_95", 0.95},
+    {"approx_percentile_99", 0.99},
+};
+
+template <typename Type>
+static std::vector<shared_ptr<aggregate_function>> make_approx_percentile_functions() {
+    std::vector<shared_ptr<aggregate_function>> functions;
+    for (const auto& [name, quantile] : approx_percentiles) {
+        functions.push_back(make_shared<approx_percentile_function_for<Type>>(name, quantile));
+    }
+    return functions;
+}
 }
 
 // Drops the first arg type from the types declaration (which denotes the accumulator)
@@ -906,6 +1145,30 @@ void cql3::functions::add_agg_functions(declared_t& funcs) {
 
     // FIXME: more count/min/max
 
+    for (auto type : {byte_type, short_type, int32_type, long_type, varint_type, decimal_type, float_type, double_type,
+            utf8_type, ascii_type, simple_date_type, timestamp_type, timeuuid_type, time_type, uuid_type, bytes_type,
+            boolean_type, inet_addr_type}) {
+        declare(make_shared<approx_count_distinct_function>(type));
+    }
+    for (auto&& f : make_approx_percentile_functions<int8_t>()) {
+        declare(f);
+    }
+    for (auto&& f : make_approx_percentile_functions<int16_t>()) {
+        declare(f);
+    }
+    for (auto&& f : make_approx_percentile_functions<int32_t>()) {
+        declare(f);
+    }
+    for (auto&& f : make_approx_percentile_functions<int64_t>()) {
+        declare(f);
+    }
+    for (auto&& f : make_approx_percentile_functions<float>()) {
+        declare(f);
+    }
+    for (auto&& f : make_approx_percentile_functions<double>()) {
+        declare(f);
+    }
+
     declare(make_sum_function<int8_t>());
     declare(make_sum_function<int16_t>());
     declare(make_sum_function<int32_t>());
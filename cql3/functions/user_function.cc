@@ -66,5 +66,34 @@ bytes_opt user_function::execute(cql_serialization_format sf, const std::vector<
         });
 }
 
+bytes_opt user_function::fold(cql_serialization_format sf, bytes_opt acc, const std::vector<std::vector<bytes_opt>>& inputs) {
+    if (!seastar::thread::running_in_thread()) {
+        on_internal_error(log, "User function cannot be executed in this context");
+    }
+    return seastar::visit(_ctx,
+        [&] (lua_context& ctx) -> bytes_opt {
+            std::vector<bytes_opt> parameters;
+            for (const auto& input : inputs) {
+                parameters.clear();
+                parameters.push_back(std::move(acc));
+                parameters.insert(parameters.end(), input.begin(), input.end());
+                acc = execute(sf, parameters);
+            }
+            return acc;
+        },
+        [&] (wasm::context& ctx) -> bytes_opt {
+            for (const auto& input : inputs) {
+                if (input.size() + 1 != arg_types().size()) {
+                    throw std::logic_error("Wrong number of parameters");
+                }
+            }
+            try {
+                return wasm::run_script_fold(name(), ctx, arg_types(), std::move(acc), inputs, return_type(), _called_on_null_input).get0();
+            } catch (const wasm::exception& e) {
+                throw exceptions::invalid_request_exception(format("UDF error: {}", e.what()));
+            }
+        });
+}
+
 }
 }
@@ -59,6 +59,14 @@ class user_function final : public abstract_function, public scalar_function {
     virtual bool is_aggregate() const override;
     virtual bool requires_thread() const override;
     virtual bytes_opt execute(cql_serialization_format sf, const std::vector<bytes_opt>& parameters) override;
+
+    // Folds the inputs with the function, as the state function of an
+    // aggregate: calls it once for every input, in order, with the result of
+    // the previous call (acc, for the first one), followed by the input, as
+    // its parameters. Returns the result of the last call.
+    //
+    // A WebAssembly function runs on the same instance for all inputs.
+    bytes_opt fold(cql_serialization_format sf, bytes_opt acc, const std::vector<std::vector<bytes_opt>>& inputs);
 };
 
 }
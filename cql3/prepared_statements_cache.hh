@@ -160,6 +160,98 @@ class prepared_statements_cache {
         return _cache.stop();
     }
 };
+
+/// \brief The cache of the statements prepared for executing the statements of QUERY requests
+///
+/// Keyed like the prepared statements cache, by the ID a PREPARE of the query string in the keyspace of the client
+/// would get, but kept apart from it, so that queries which are executed only once don't evict the statements clients
+/// prepared.
+class unprepared_statements_cache {
+public:
+    struct stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+    };
+
+    static stats& shard_stats() {
+        static thread_local stats _stats;
+        return _stats;
+    }
+
+    struct unprepared_cache_stats_updater {
+        static void inc_hits() noexcept {}
+        static void inc_misses() noexcept {}
+        static void inc_blocks() noexcept {}
+        static void inc_evictions() noexcept {
+            ++shard_stats().evictions;
+        }
+        static void inc_unprivileged_on_cache_size_eviction() noexcept {}
+    };
+
+private:
+    using cache_key_type = typename prepared_cache_key_type::cache_key_type;
+    // Keep the entry in the "unprivileged" cache section till it is hit once, so that a query executed only once
+    // doesn't evict the ones executed over and over.
+    using cache_type = utils::loading_cache<cache_key_type, prepared_cache_entry, 1, utils::loading_cache_reload_enabled::no, prepared_cache_entry_size, utils::tuple_hash, std::equal_to<cache_key_type>, unprepared_cache_stats_updater, unprepared_cache_stats_updater>;
+    using cache_value_ptr = typename cache_type::value_ptr;
+    using checked_weak_ptr = typename statements::prepared_statement::checked_weak_ptr;
+
+public:
+    using key_type = prepared_cache_key_type;
+    using value_type = checked_weak_ptr;
+
+private:
+    cache_type _cache;
+    bool _enabled;
+
+public:
+    // A size of 0 disables the cache.
+    unprepared_statements_cache(logging::logger& logger, size_t size)
+        : _cache(size, size ? prepared_statements_cache::entry_expiry : lowres_clock::duration(0), logger)
+        , _enabled(size != 0)
+    {}
+
+    bool enabled() const {
+        return _enabled;
+    }
+
+    value_type find(const key_type& key) {
+        cache_value_ptr vp = _cache.find(key.key());
+        if (vp) {
+            ++shard_stats().hits;
+            return (*vp)->checked_weak_from_this();
+        }
+        ++shard_stats().misses;
+        return value_type();
+    }
+
+    future<> insert(const key_type& key, prepared_cache_entry prepared) {
+        return _cache.get_ptr(key.key(), [prepared = std::move(prepared)] (const cache_key_type&) mutable {
+            return make_ready_future<prepared_cache_entry>(std::move(prepared));
+        }).discard_result();
+    }
+
+    template <typename Pred>
+    requires std::is_invocable_r_v<bool, Pred, ::shared_ptr<cql_statement>>
+    void remove_if(Pred&& pred) {
+        _cache.remove_if([&pred] (const prepared_cache_entry& e) {
+            return pred(e->statement);
+        });
+    }
+
+    void reset() noexcept {
+        _cache.reset();
+    }
+
+    size_t size() const {
+        return _cache.size();
+    }
+
+    future<> stop() {
+        return _cache.stop();
+    }
+};
 }
 
 namespace std { // for prepared_statements_cache log printouts
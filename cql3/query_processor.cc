@@ -17,6 +17,7 @@
 #include "cql3/error_collector.hh"
 #include "cql3/statements/batch_statement.hh"
 #include "cql3/statements/modification_statement.hh"
+#include "cql3/statements/select_statement.hh"
 #include "cql3/util.hh"
 #include "cql3/untyped_result_set.hh"
 #include "db/config.hh"
@@ -31,6 +32,7 @@ using namespace cql_transport::messages;
 logging::logger log("query_processor");
 logging::logger prep_cache_log("prepared_statements_cache");
 logging::logger authorized_prepared_statements_cache_log("authorized_prepared_statements_cache");
+logging::logger unprepared_statements_cache_log("unprepared_statements_cache");
 
 const sstring query_processor::CQL_VERSION = "3.3.1";
 
@@ -68,6 +70,7 @@ query_processor::query_processor(service::storage_proxy& proxy, service::forward
         , _internal_state(new internal_state())
         , _prepared_cache(prep_cache_log, _mcfg.prepared_statment_cache_size)
         , _authorized_prepared_cache(std::move(auth_prep_cache_cfg), authorized_prepared_statements_cache_log)
+        , _unprepared_cache(unprepared_statements_cache_log, _mcfg.unprepared_statement_cache_size)
         , _auth_prepared_cache_cfg_cb([this] (uint32_t) { (void) _authorized_prepared_cache_config_action.trigger_later(); })
         , _authorized_prepared_cache_config_action([this] { update_authorized_prepared_cache_config(); return make_ready_future<>(); })
         , _authorized_prepared_cache_update_interval_in_ms_observer(_db.get_config().permissions_update_interval_in_ms.observe(_auth_prepared_cache_cfg_cb))
@@ -294,6 +297,20 @@ query_processor::query_processor(service::storage_proxy& proxy, service::forward
                             sm::description("Counts the total number of sub-statements in CQL BATCH requests with conditions."),
                             {cas_label_instance}),
 
+                    sm::make_counter(
+                            "mutations_in_batches",
+                            _cql_stats.mutations_in_batches,
+                            sm::description("Counts the total number of partition mutations generated by the sub-statements of CQL BATCH requests without conditions, "
+                                            "before the ones of the same partition are merged."),
+                            {non_cas_label_instance}),
+
+                    sm::make_counter(
+                            "partitions_in_batches",
+                            _cql_stats.partitions_in_batches,
+                            sm::description("Counts the total number of partitions written by CQL BATCH requests without conditions. "
+                                            "The ratio of mutations_in_batches to this is how many mutations of the same partition were merged into one write."),
+                            {non_cas_label_instance}),
+
                     sm::make_counter(
                             "batches_pure_logged",
                             _cql_stats.batches_pure_logged,
@@ -338,6 +355,26 @@ query_processor::query_processor(service::storage_proxy& proxy, service::forward
                             [this] { return _prepared_cache.memory_footprint(); },
                             sm::description("Size (in bytes) of the prepared statements cache.")),
 
+                    sm::make_counter(
+                            "unprepared_cache_hits",
+                            [] { return unprepared_statements_cache::shard_stats().hits; },
+                            sm::description("Counts the number of statements of QUERY requests which were found prepared in the unprepared statements cache.")),
+
+                    sm::make_counter(
+                            "unprepared_cache_misses",
+                            [] { return unprepared_statements_cache::shard_stats().misses; },
+                            sm::description("Counts the number of statements of QUERY requests which had to be parsed and prepared, as they weren't in the unprepared statements cache.")),
+
+                    sm::make_counter(
+                            "unprepared_cache_evictions",
+                            [] { return unprepared_statements_cache::shard_stats().evictions; },
+                            sm::description("Counts the number of unprepared statements cache entries evictions.")),
+
+                    sm::make_gauge(
+                            "unprepared_cache_size",
+                            [this] { return _unprepared_cache.size(); },
+                            sm::description("A number of entries in the unprepared statements cache.")),
+
                     sm::make_counter(
                             "secondary_index_creates",
                             _cql_stats.secondary_index_creates,
@@ -360,6 +397,12 @@ query_processor::query_processor(service::storage_proxy& proxy, service::forward
                             _cql_stats.secondary_index_rows_read,
                             sm::description("Counts the total number of rows read during CQL requests performed using secondary indexes.")),
 
+                    // secondary_index_covered_reads total count is also included in secondary_index_reads
+                    sm::make_counter(
+                            "secondary_index_covered_reads",
+                            _cql_stats.secondary_index_covered_reads,
+                            sm::description("Counts the total number of CQL read requests performed using secondary indexes, which were served from the index alone.")),
+
                     // read requests that required ALLOW FILTERING
                     sm::make_counter(
                             "filtered_read_requests",
@@ -458,43 +501,81 @@ query_processor::~query_processor() {
 
 future<> query_processor::stop() {
     return _mnotifier.unregister_listener(_migration_subscriber.get()).then([this] {
-        return _authorized_prepared_cache.stop().finally([this] { return _prepared_cache.stop(); });
+        return _authorized_prepared_cache.stop().finally([this] {
+            return _unprepared_cache.stop();
+        }).finally([this] {
+            return _prepared_cache.stop();
+        });
     });
 }
 
 future<::shared_ptr<result_message>>
 query_processor::execute_direct_without_checking_exception_message(const sstring_view& query_string, service::query_state& query_state, query_options& options) {
     log.trace("execute_direct: \"{}\"", query_string);
-    tracing::trace(query_state.get_trace_state(), "Parsing a statement");
-    auto p = get_statement(query_string, query_state.get_client_state());
-    auto cql_statement = p->statement;
-    const auto warnings = std::move(p->warnings);
+    auto& client_state = query_state.get_client_state();
+    const bool use_cache = _unprepared_cache.enabled() && _db.get_config().enable_unprepared_statement_cache();
+    prepared_cache_key_type cache_key;
+    statements::prepared_statement::checked_weak_ptr cached;
+    std::unique_ptr<statements::prepared_statement> prepared;
+    if (use_cache) {
+        cache_key = compute_id(query_string, client_state.get_raw_keyspace());
+        cached = _unprepared_cache.find(cache_key);
+    }
+    if (!cached) {
+        tracing::trace(query_state.get_trace_state(), "Parsing a statement");
+        prepared = get_statement(query_string, client_state);
+    } else {
+        tracing::trace(query_state.get_trace_state(), "Found the statement prepared in the unprepared statements cache");
+    }
+    // The cached entry may be evicted once this yields, so everything needed
+    // is taken from it now.
+    const statements::prepared_statement& p = cached ? *cached : *prepared;
+    auto cql_statement = p.statement;
+    auto warnings = p.warnings;
     if (cql_statement->get_bound_terms() != options.get_values_count()) {
         const auto msg = format("Invalid amount of bind variables: expected {:d} received {:d}",
                 cql_statement->get_bound_terms(),
                 options.get_values_count());
         throw exceptions::invalid_request_exception(msg);
     }
-    options.prepare(p->bound_names);
+    options.prepare(p.bound_names);
+
+    future<> fut = make_ready_future<>();
+    if (use_cache && prepared && is_cacheable_unprepared(*cql_statement)) {
+        fut = _unprepared_cache.insert(cache_key, std::move(prepared)).handle_exception([] (auto eptr) {
+            log.debug("failed to cache the unprepared statement: {}", eptr);
+        });
+    }
 
     warn(unimplemented::cause::METRICS);
 #if 0
         if (!queryState.getClientState().isInternal)
             metrics.regularStatementsExecuted.inc();
 #endif
-    tracing::trace(query_state.get_trace_state(), "Processing a statement");
-    return cql_statement->check_access(*this, query_state.get_client_state()).then(
-            [this, cql_statement, &query_state, &options, warnings = std::move(warnings)] () mutable {
-        return process_authorized_statement(std::move(cql_statement), query_state, options).then(
-                [warnings = std::move(warnings)] (::shared_ptr<result_message> m) {
-                    for (const auto& w : warnings) {
-                        m->add_warning(w);
-                    }
-                    return make_ready_future<::shared_ptr<result_message>>(m);
-                });
+    return fut.then([this, cql_statement = std::move(cql_statement), &query_state, &options, warnings = std::move(warnings)] () mutable {
+        tracing::trace(query_state.get_trace_state(), "Processing a statement");
+        return cql_statement->check_access(*this, query_state.get_client_state()).then(
+                [this, cql_statement, &query_state, &options, warnings = std::move(warnings)] () mutable {
+            return process_authorized_statement(std::move(cql_statement), query_state, options).then(
+                    [warnings = std::move(warnings)] (::shared_ptr<result_message> m) {
+                        for (const auto& w : warnings) {
+                            m->add_warning(w);
+                        }
+                        return make_ready_future<::shared_ptr<result_message>>(m);
+                    });
+        });
     });
 }
 
+bool query_processor::is_cacheable_unprepared(const cql_statement& statement) {
+    // Only the statements which are executed over and over, and which read or
+    // write data, rather than the schema or the auth state, the preparing of
+    // which may depend on more than the schema, are cached.
+    return dynamic_cast<const statements::select_statement*>(&statement)
+            || dynamic_cast<const statements::modification_statement*>(&statement)
+            || dynamic_cast<const statements::batch_statement*>(&statement);
+}
+
 future<::shared_ptr<result_message>>
 query_processor::execute_prepared_without_checking_exception_message(
         statements::prepared_statement::checked_weak_ptr prepared,
@@ -889,10 +970,12 @@ void query_processor::migration_subscriber::on_create_user_type(const sstring& k
 }
 
 void query_processor::migration_subscriber::on_create_function(const sstring& ks_name, const sstring& function_name) {
+    remove_unprepared_statements();
     log.warn("{} event ignored", __func__);
 }
 
 void query_processor::migration_subscriber::on_create_aggregate(const sstring& ks_name, const sstring& aggregate_name) {
+    remove_unprepared_statements();
     log.warn("{} event ignored", __func__);
 }
 
@@ -912,12 +995,15 @@ void query_processor::migration_subscriber::on_update_column_family(
 }
 
 void query_processor::migration_subscriber::on_update_user_type(const sstring& ks_name, const sstring& type_name) {
+    remove_unprepared_statements();
 }
 
 void query_processor::migration_subscriber::on_update_function(const sstring& ks_name, const sstring& function_name) {
+    remove_unprepared_statements();
 }
 
 void query_processor::migration_subscriber::on_update_aggregate(const sstring& ks_name, const sstring& aggregate_name) {
+    remove_unprepared_statements();
 }
 
 void query_processor::migration_subscriber::on_update_view(
@@ -934,13 +1020,16 @@ void query_processor::migration_subscriber::on_drop_column_family(const sstring&
 }
 
 void query_processor::migration_subscriber::on_drop_user_type(const sstring& ks_name, const sstring& type_name) {
+    remove_unprepared_statements();
 }
 
 void query_processor::migration_subscriber::on_drop_function(const sstring& ks_name, const sstring& function_name) {
+    remove_unprepared_statements();
     log.warn("{} event ignored", __func__);
 }
 
 void query_processor::migration_subscriber::on_drop_aggregate(const sstring& ks_name, const sstring& aggregate_name) {
+    remove_unprepared_statements();
     log.warn("{} event ignored", __func__);
 }
 
@@ -954,6 +1043,16 @@ void query_processor::migration_subscriber::remove_invalid_prepared_statements(
     _qp->_prepared_cache.remove_if([&] (::shared_ptr<cql_statement> stmt) {
         return this->should_invalidate(ks_name, cf_name, stmt);
     });
+    _qp->_unprepared_cache.remove_if([&] (::shared_ptr<cql_statement> stmt) {
+        return this->should_invalidate(ks_name, cf_name, stmt);
+    });
+}
+
+void query_processor::migration_subscriber::remove_unprepared_statements() {
+    // Statements aren't tracked by the functions or types they use, and,
+    // unlike the clients which prepared them, the ones of QUERY requests
+    // expect the new definitions to be used right away.
+    _qp->_unprepared_cache.reset();
 }
 
 bool query_processor::migration_subscriber::should_invalidate(
@@ -88,6 +88,7 @@ class query_processor : public seastar::peering_sharded_service<query_processor>
     struct memory_config {
         size_t prepared_statment_cache_size = 0;
         size_t authorized_prepared_cache_size = 0;
+        size_t unprepared_statement_cache_size = 0;
     };
 
 private:
@@ -115,6 +116,7 @@ class query_processor : public seastar::peering_sharded_service<query_processor>
 
     prepared_statements_cache _prepared_cache;
     authorized_prepared_statements_cache _authorized_prepared_cache;
+    unprepared_statements_cache _unprepared_cache;
 
     std::function<void(uint32_t)> _auth_prepared_cache_cfg_cb;
     serialized_action _authorized_prepared_cache_config_action;
@@ -204,6 +206,23 @@ class query_processor : public seastar::peering_sharded_service<query_processor>
         return _prepared_cache.find(key);
     }
 
+    // Like get_prepared(user, key), but looks up the statements already
+    // authorized on the connection first, which spares hashing the user.
+    statements::prepared_statement::checked_weak_ptr get_prepared(service::client_state& client_state, const prepared_cache_key_type& key) {
+        const auto& id = prepared_cache_key_type::cql_id(key);
+        const auto generation = authorized_prepared_statements_cache::shard_generation();
+        if (!id.empty() && client_state.has_authorized_prepared(id, generation)) {
+            if (auto p = _prepared_cache.find(key)) {
+                return p;
+            }
+        }
+        auto p = get_prepared(client_state.user(), key);
+        if (p && !id.empty()) {
+            client_state.add_authorized_prepared(id, generation);
+        }
+        return p;
+    }
+
     service::raft_group0_client& get_group0_client() {
         return _group0_client;
     }
@@ -409,6 +428,9 @@ class query_processor : public seastar::peering_sharded_service<query_processor>
     future<::shared_ptr<cql_transport::messages::result_message>>
     process_authorized_statement(const ::shared_ptr<cql_statement> statement, service::query_state& query_state, const query_options& options);
 
+    // True if the statement of a QUERY request can be kept in the unprepared statements cache.
+    static bool is_cacheable_unprepared(const cql_statement& statement);
+
     /*!
      * \brief created a state object for paging
      *
@@ -525,6 +547,7 @@ class query_processor::migration_subscriber : public service::migration_listener
 
 private:
     void remove_invalid_prepared_statements(sstring ks_name, std::optional<sstring> cf_name);
+    void remove_unprepared_statements();
 
     bool should_invalidate(
             sstring ks_name,
@@ -26,7 +26,11 @@ class result_generator {
     class query_result_visitor {
         const schema& _schema;
         std::vector<bytes> _partition_key;
-        std::vector<bytes> _clustering_key;
+        // Views of the components of the clustering key of the row being
+        // visited. They point into the key, unless it is fragmented, in
+        // which case its components are copied to _linearized_clustering_key.
+        std::vector<bytes_view> _clustering_key;
+        std::vector<bytes> _linearized_clustering_key;
         uint64_t _partition_row_count = 0;
         uint64_t _total_row_count = 0;
         Visitor& _visitor;
@@ -55,7 +59,16 @@ class result_generator {
 
         void accept_new_row(const clustering_key& key, query::result_row_view static_row,
                             query::result_row_view row) {
-            _clustering_key = key.explode(_schema);
+            _clustering_key.clear();
+            managed_bytes_view representation(key.representation());
+            if (representation.is_linearized()) {
+                for (managed_bytes_view component : key.components()) {
+                    _clustering_key.push_back(component.current_fragment());
+                }
+            } else {
+                _linearized_clustering_key = key.explode(_schema);
+                _clustering_key.assign(_linearized_clustering_key.begin(), _linearized_clustering_key.end());
+            }
             accept_new_row(static_row, row);
         }
         void accept_new_row(query::result_row_view static_row, query::result_row_view row) {
@@ -69,7 +82,7 @@ class result_generator {
                     break;
                 case column_kind::clustering_key:
                     if (_clustering_key.size() > def->component_index()) {
-                        _visitor.accept_value(query::result_bytes_view(bytes_view(_clustering_key[def->component_index()])));
+                        _visitor.accept_value(query::result_bytes_view(_clustering_key[def->component_index()]));
                     } else {
                         _visitor.accept_value(std::nullopt);
                     }
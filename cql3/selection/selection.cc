@@ -185,8 +185,12 @@ class selection_with_processing : public selection {
         return _factories->does_reduction();
     }
 
+    virtual bool is_reducible_by_partition() const override {
+        return _factories->does_reduction_by_partition(*_schema);
+    }
+
     virtual query::forward_request::reductions_info get_reductions() const override {
-        return _factories->get_reductions();
+        return _factories->get_reductions(*_schema);
     }
 
 protected:
@@ -392,6 +396,10 @@ void result_set_builder::new_row() {
     current.emplace();
 }
 
+size_t result_set_builder::result_set_size() const {
+    return _result_set->size();
+}
+
 std::unique_ptr<result_set> result_set_builder::build() {
     process_current_row(/*more_rows_coming=*/false);
     if (_result_set->empty() && _selectors->is_aggregate()) {
@@ -446,30 +454,26 @@ bool result_set_builder::restrictions_filter::do_filter(const selection& selecti
                 });
     }
 
-    auto static_row_iterator = static_row.iterator();
-    auto row_iterator = row ? std::optional<query::result_row_view::iterator_type>(row->iterator()) : std::nullopt;
-    const expr::single_column_restrictions_map& non_pk_restrictions_map = _restrictions->get_non_pk_restriction();
-    for (auto&& cdef : selection.get_columns()) {
+    if (!_column_filters) {
+        _column_filters = compile_column_filters(selection);
+    }
+    std::optional<std::vector<managed_bytes_opt>> static_and_regular_columns;
+    for (const auto& [cdef, restriction] : *_column_filters) {
         switch (cdef->kind) {
         case column_kind::static_column:
             // fallthrough
         case column_kind::regular_column: {
-            if (cdef->kind == column_kind::regular_column && !row_iterator) {
+            if (cdef->kind == column_kind::regular_column && !row) {
                 continue;
             }
-            auto restr_it = non_pk_restrictions_map.find(cdef);
-            if (restr_it == non_pk_restrictions_map.end()) {
-                continue;
+            if (!static_and_regular_columns) {
+                static_and_regular_columns = expr::get_non_pk_values(selection, static_row, row);
             }
-            const expr::expression& single_col_restriction = restr_it->second;
-            // FIXME: push to upper layer so it happens once per row
-            auto static_and_regular_columns = expr::get_non_pk_values(selection, static_row, row);
-            bool regular_restriction_matches = expr::is_satisfied_by(
-                    single_col_restriction,
+            bool regular_restriction_matches = restriction.is_satisfied_by(
                     expr::evaluation_inputs{
                         .partition_key = &partition_key,
                         .clustering_key = &clustering_key,
-                        .static_and_regular_columns = &static_and_regular_columns,
+                        .static_and_regular_columns = &*static_and_regular_columns,
                         .selection = &selection,
                         .options = &_options,
                     });
@@ -480,17 +484,7 @@ bool result_set_builder::restrictions_filter::do_filter(const selection& selecti
             }
             break;
         case column_kind::partition_key: {
-            if (_skip_pk_restrictions) {
-                continue;
-            }
-            auto partition_key_restrictions_map = _restrictions->get_single_column_partition_key_restrictions();
-            auto restr_it = partition_key_restrictions_map.find(cdef);
-            if (restr_it == partition_key_restrictions_map.end()) {
-                continue;
-            }
-            const expr::expression& single_col_restriction = restr_it->second;
-            if (!expr::is_satisfied_by(
-                        single_col_restriction,
+            if (!restriction.is_satisfied_by(
                         expr::evaluation_inputs{
                             .partition_key = &partition_key,
                             .clustering_key = &clustering_key,
@@ -504,21 +498,10 @@ bool result_set_builder::restrictions_filter::do_filter(const selection& selecti
             }
             break;
         case column_kind::clustering_key: {
-            if (_skip_ck_restrictions) {
-                continue;
-            }
-            const expr::single_column_restrictions_map& clustering_key_restrictions_map =
-                _restrictions->get_single_column_clustering_key_restrictions();
-            auto restr_it = clustering_key_restrictions_map.find(cdef);
-            if (restr_it == clustering_key_restrictions_map.end()) {
-                continue;
-            }
             if (clustering_key.empty()) {
                 return false;
             }
-            const expr::expression& single_col_restriction = restr_it->second;
-            if (!expr::is_satisfied_by(
-                        single_col_restriction,
+            if (!restriction.is_satisfied_by(
                         expr::evaluation_inputs{
                             .partition_key = &partition_key,
                             .clustering_key = &clustering_key,
@@ -537,6 +520,47 @@ bool result_set_builder::restrictions_filter::do_filter(const selection& selecti
     return true;
 }
 
+std::vector<result_set_builder::restrictions_filter::column_filter>
+result_set_builder::restrictions_filter::compile_column_filters(const selection& selection) const {
+    const expr::single_column_restrictions_map& non_pk_restrictions_map = _restrictions->get_non_pk_restriction();
+    const expr::single_column_restrictions_map& partition_key_restrictions_map =
+        _restrictions->get_single_column_partition_key_restrictions();
+    const expr::single_column_restrictions_map& clustering_key_restrictions_map =
+        _restrictions->get_single_column_clustering_key_restrictions();
+    auto find = [] (const expr::single_column_restrictions_map& map, const column_definition* cdef) -> const expr::expression* {
+        auto it = map.find(cdef);
+        return it == map.end() ? nullptr : &it->second;
+    };
+
+    std::vector<column_filter> filters;
+    for (auto&& cdef : selection.get_columns()) {
+        const expr::expression* restriction = nullptr;
+        switch (cdef->kind) {
+        case column_kind::static_column:
+            // fallthrough
+        case column_kind::regular_column:
+            restriction = find(non_pk_restrictions_map, cdef);
+            break;
+        case column_kind::partition_key:
+            if (!_skip_pk_restrictions) {
+                restriction = find(partition_key_restrictions_map, cdef);
+            }
+            break;
+        case column_kind::clustering_key:
+            if (!_skip_ck_restrictions) {
+                restriction = find(clustering_key_restrictions_map, cdef);
+            }
+            break;
+        default:
+            break;
+        }
+        if (restriction) {
+            filters.push_back(column_filter{cdef, expr::compiled_restriction(*restriction, selection, _options)});
+        }
+    }
+    return filters;
+}
+
 bool result_set_builder::restrictions_filter::operator()(const selection& selection,
                                                          const std::vector<bytes>& partition_key,
                                                          const std::vector<bytes>& clustering_key,
@@ -15,6 +15,7 @@
 #include "query-result-reader.hh"
 #include "cql3/column_specification.hh"
 #include "cql3/selection/selector.hh"
+#include "cql3/expr/compiled_restriction.hh"
 #include "exceptions/exceptions.hh"
 #include "unimplemented.hh"
 #include <seastar/core/thread.hh>
@@ -145,6 +146,9 @@ class selection {
     virtual bool is_count() const {return false;}
 
     virtual bool is_reducible() const {return false;}
+    // Like is_reducible(), but the selection may also select partition key
+    // columns, when grouped by partition.
+    virtual bool is_reducible_by_partition() const {return false;}
 
     virtual query::forward_request::reductions_info get_reductions() const {return {{}, {}};}
 
@@ -229,6 +233,13 @@ class result_set_builder {
         mutable uint64_t _rows_fetched_for_last_partition;
         mutable std::optional<partition_key> _last_pkey;
         mutable bool _is_first_partition_on_page = true;
+        struct column_filter {
+            const column_definition* column;
+            expr::compiled_restriction restriction;
+        };
+        // The single-column restrictions to check, in the order of the
+        // columns of the selection, compiled when the first row is filtered.
+        mutable std::optional<std::vector<column_filter>> _column_filters;
     public:
         explicit restrictions_filter(::shared_ptr<const restrictions::statement_restrictions> restrictions,
                 const query_options& options,
@@ -244,6 +255,7 @@ class result_set_builder {
         }
     private:
         bool do_filter(const selection& selection, const std::vector<bytes>& pk, const std::vector<bytes>& ck, const query::result_row_view& static_row, const query::result_row_view* row) const;
+        std::vector<column_filter> compile_column_filters(const selection& selection) const;
     };
 
     result_set_builder(const selection& s, gc_clock::time_point now, cql_serialization_format sf,
@@ -254,6 +266,9 @@ class result_set_builder {
     void add_collection(const column_definition& def, bytes_view c);
     void new_row();
     std::unique_ptr<result_set> build();
+    /// The number of rows built so far, not counting the one of the group
+    /// being formed.
+    size_t result_set_size() const;
     api::timestamp_type timestamp_of(size_t idx);
     int32_t ttl_of(size_t idx);
 
@@ -130,10 +130,32 @@ class selector_factories {
         });
     }
 
-    query::forward_request::reductions_info get_reductions() const {
+    /**
+     * Checks if the selectors are reducible aggregates, or select partition key columns, the values of which
+     * are the same for all rows of a group by partition.
+     */
+    bool does_reduction_by_partition(const schema& s) const {
+        return does_aggregation() && std::all_of(_factories.cbegin(), _factories.cend(), [&s] (const ::shared_ptr<selector::factory>& factory) {
+            if (factory->is_simple_selector_factory()) {
+                auto def = s.get_column_definition(to_bytes(factory->column_name()));
+                return def && def->is_partition_key();
+            }
+            return factory->is_reducible_selector_factory() && factory->contains_only_simple_arguments();
+        });
+    }
+
+    query::forward_request::reductions_info get_reductions(const schema& s) const {
         std::vector<query::forward_request::reduction_type> types;
         std::vector<query::forward_request::aggregation_info> infos;
+        std::vector<std::optional<uint32_t>> partition_key_components;
         for (const auto& factory: _factories) {
+            if (factory->is_simple_selector_factory()) {
+                auto def = s.get_column_definition(to_bytes(factory->column_name()));
+                if (def && def->is_partition_key()) {
+                    partition_key_components.push_back(def->component_index());
+                    continue;
+                }
+            }
             auto r = factory->get_reduction();
             if (!r) {
                 throw std::runtime_error(format("Column {} doesn't have reduction type", factory->column_name()));
@@ -141,8 +163,9 @@ class selector_factories {
 
             types.push_back(r->first);
             infos.push_back(r->second);
+            partition_key_components.push_back(std::nullopt);
         }
-        return {types, infos};
+        return {types, infos, partition_key_components};
     }
 
     /**
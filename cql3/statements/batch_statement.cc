@@ -170,7 +170,8 @@ future<std::vector<mutation>> batch_statement::get_mutations(query_processor& qp
             statement->inc_cql_stats(query_state.get_client_state().is_internal());
             auto&& statement_options = options.for_statement(i);
             auto timestamp = _attrs->get_timestamp(now, statement_options);
-            return statement->get_mutations(qp, statement_options, timeout, local, timestamp, query_state).then([&result] (auto&& more) {
+            return statement->get_mutations(qp, statement_options, timeout, local, timestamp, query_state).then([this, &result] (auto&& more) {
+                _stats.mutations_in_batches += more.size();
                 for (auto&& m : more) {
                     // We want unordered_set::try_emplace(), but we don't have it
                     auto pos = result.find(m);
@@ -273,6 +274,7 @@ future<shared_ptr<cql_transport::messages::result_message>> batch_statement::do_
     auto timeout = db::timeout_clock::now() + get_timeout(query_state.get_client_state(), options);
     return get_mutations(qp, options, timeout, local, now, query_state).then([this, &qp, &options, timeout, tr_state = query_state.get_trace_state(),
                                                                                                                                permit = query_state.get_permit()] (std::vector<mutation> ms) mutable {
+        _stats.partitions_in_batches += ms.size();
         return execute_without_conditions(qp, std::move(ms), options.get_consistency(), timeout, std::move(tr_state), std::move(permit));
     }).then([] (coordinator_result<> res) {
         if (!res) {
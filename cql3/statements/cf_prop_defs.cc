@@ -108,6 +108,9 @@ void cf_prop_defs::validate(const data_dictionary::database db, sstring ks_name,
         }
         _compaction_strategy_class = sstables::compaction_strategy::type(strategy->second);
         remove_from_map_if_exists(KW_COMPACTION, COMPACTION_STRATEGY_CLASS_KEY);
+        if (_compaction_strategy_class == sstables::compaction_strategy_type::incremental && !db.features().incremental_compaction_strategy) {
+            throw exceptions::configuration_exception("IncrementalCompactionStrategy not supported by the cluster");
+        }
 
 #if 0
        CFMetaData.validateCompactionOptions(compactionStrategyClass, compactionOptions);
@@ -127,6 +130,12 @@ void cf_prop_defs::validate(const data_dictionary::database db, sstring ks_name,
     if (auto caching_options = get_caching_options(); caching_options && !caching_options->enabled() && !db.features().per_table_caching) {
         throw exceptions::configuration_exception(KW_CACHING + " can't contain \"'enabled':false\" unless whole cluster supports it");
     }
+    if (auto caching_options = get_caching_options(); caching_options && caching_options->coalesce_reads() && !db.features().coalesced_reads) {
+        throw exceptions::configuration_exception(KW_CACHING + " can't contain \"'coalesce_reads':true\" unless whole cluster supports it");
+    }
+    if (auto caching_options = get_caching_options(); caching_options && caching_options->max_share() != 1 && !db.features().caching_max_share) {
+        throw exceptions::configuration_exception(KW_CACHING + " can't contain \"'max_share'\" unless whole cluster supports it");
+    }
 
     auto cdc_options = get_cdc_options(schema_extensions);
     if (cdc_options && cdc_options->enabled() && !db.features().cdc) {
@@ -137,6 +146,11 @@ void cf_prop_defs::validate(const data_dictionary::database db, sstring ks_name,
     if (per_partition_rate_limit_options && !db.features().typed_errors_in_read_rpc) {
         throw exceptions::configuration_exception("Per-partition rate limit is not supported yet by the whole cluster");
     }
+    if (per_partition_rate_limit_options
+            && per_partition_rate_limit_options->get_algorithm() != db::per_partition_rate_limit_options::algorithm::hash_table
+            && !db.features().count_min_rate_limiter) {
+        throw exceptions::configuration_exception("Per-partition rate limit algorithm is not supported yet by the whole cluster");
+    }
 
     auto tombstone_gc_options = get_tombstone_gc_options(schema_extensions);
     validate_tombstone_gc_options(tombstone_gc_options, db, ks_name);
@@ -177,6 +177,47 @@ std::vector<::shared_ptr<index_target>> create_index_statement::validate_while_e
     return targets;
 }
 
+std::vector<::shared_ptr<column_identifier>> create_index_statement::validate_included_columns(data_dictionary::database db, const schema& schema,
+        const std::vector<::shared_ptr<index_target>>& targets) const {
+    std::vector<::shared_ptr<column_identifier>> columns;
+    if (_properties->included_columns.empty()) {
+        return columns;
+    }
+    if (!db.features().covering_indexes) {
+        throw exceptions::invalid_request_exception(
+            "Including columns in an index is not supported by some older nodes in this cluster. Please upgrade them.");
+    }
+    std::unordered_set<sstring> target_columns;
+    for (auto& target : targets) {
+        if (auto* ident = std::get_if<index_target::single_column>(&target->value)) {
+            target_columns.emplace((*ident)->text());
+        }
+    }
+    std::unordered_set<sstring> names;
+    for (auto& raw_column : _properties->included_columns) {
+        auto column = raw_column->prepare_column_identifier(schema);
+        auto cd = schema.get_column_definition(column->name());
+        if (cd == nullptr) {
+            throw exceptions::invalid_request_exception(format("No column definition found for included column {}", *column));
+        }
+        if (cd->is_primary_key()) {
+            throw exceptions::invalid_request_exception(
+                    format("Cannot include PRIMARY KEY column {}, every index includes the primary key", *column));
+        }
+        if (cd->is_static()) {
+            throw exceptions::invalid_request_exception(format("Cannot include static column {} in an index", *column));
+        }
+        if (target_columns.contains(column->text())) {
+            throw exceptions::invalid_request_exception(format("Cannot include the indexed column {}", *column));
+        }
+        if (!names.emplace(column->text()).second) {
+            throw exceptions::invalid_request_exception(format("Duplicate column {} in included column list", *column));
+        }
+        columns.push_back(std::move(column));
+    }
+    return columns;
+}
+
 void create_index_statement::validate_for_local_index(const schema& schema) const {
     if (!_raw_targets.empty()) {
             if (const auto* index_pk = std::get_if<std::vector<::shared_ptr<column_identifier::raw>>>(&_raw_targets.front()->value)) {
@@ -349,6 +390,10 @@ schema_ptr create_index_statement::build_index_schema(query_processor& qp) const
     } else {
         kind = schema->is_compound() ? index_metadata_kind::composites : index_metadata_kind::keys;
     }
+    auto included_columns = validate_included_columns(db, *schema, targets);
+    if (!included_columns.empty()) {
+        index_options.emplace(index_target::included_columns_option_name, secondary_index::target_parser::serialize_included_columns(included_columns));
+    }
     auto index = make_index_metadata(targets, accepted_name, kind, index_options);
     auto existing_index = schema->find_index_noname(index);
     if (existing_index) {
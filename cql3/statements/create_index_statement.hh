@@ -66,6 +66,8 @@ class create_index_statement : public schema_altering_statement {
                                               index_metadata_kind kind,
                                               const index_options_map& options);
     std::vector<::shared_ptr<index_target>> validate_while_executing(query_processor& qp) const;
+    std::vector<::shared_ptr<column_identifier>> validate_included_columns(data_dictionary::database db, const schema& schema,
+                                                                           const std::vector<::shared_ptr<index_target>>& targets) const;
     schema_ptr build_index_schema(query_processor& qp) const;
 };
 
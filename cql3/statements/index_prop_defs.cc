@@ -29,6 +29,9 @@ void cql3::statements::index_prop_defs::validate() {
     if (!is_custom && !_properties.empty()) {
         throw exceptions::invalid_request_exception("Cannot specify options for a non-CUSTOM index");
     }
+    if (is_custom && !included_columns.empty()) {
+        throw exceptions::invalid_request_exception("Cannot include columns in a CUSTOM index");
+    }
     if (get_raw_options().count(
             db::index::secondary_index::custom_index_option_name)) {
         throw exceptions::invalid_request_exception(
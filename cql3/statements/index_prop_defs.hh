@@ -11,10 +11,12 @@
 #pragma once
 
 #include "property_definitions.hh"
+#include "cql3/column_identifier.hh"
 #include <seastar/core/sstring.hh>
 
 #include <unordered_map>
 #include <optional>
+#include <vector>
 
 typedef std::unordered_map<sstring, sstring> index_options_map;
 
@@ -28,6 +30,8 @@ class index_prop_defs : public property_definitions {
 
     bool is_custom = false;
     std::optional<sstring> custom_class;
+    // Columns the index stores besides the primary key, given by INCLUDE.
+    std::vector<::shared_ptr<column_identifier::raw>> included_columns;
 
     void validate();
     index_options_map get_raw_options();
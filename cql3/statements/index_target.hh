@@ -22,6 +22,9 @@ namespace statements {
 struct index_target {
     static const sstring target_option_name;
     static const sstring custom_index_option_name;
+    // The option holding the columns an index includes besides the primary
+    // key, see target_parser::parse_included_columns().
+    static const sstring included_columns_option_name;
     static const std::regex target_regex;
 
     enum class target_type {
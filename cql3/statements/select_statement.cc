@@ -41,6 +41,8 @@
 #include "data_dictionary/data_dictionary.hh"
 #include "test/lib/select_statement_utils.hh"
 #include <boost/algorithm/cxx11/any_of.hpp>
+#include <boost/range/adaptor/transformed.hpp>
+#include <seastar/core/coroutine.hh>
 #include "gms/feature_service.hh"
 #include "utils/result.hh"
 #include "utils/result_combinators.hh"
@@ -226,7 +228,7 @@ const sstring& select_statement::column_family() const {
 }
 
 query::partition_slice
-select_statement::make_partition_slice(const query_options& options) const
+select_statement::make_partition_slice(const query_options& options, bool with_row_filter) const
 {
     query::column_id_vector static_columns;
     query::column_id_vector regular_columns;
@@ -263,7 +265,52 @@ select_statement::make_partition_slice(const query_options& options) const
         ++_stats.reverse_queries;
     }
     return query::partition_slice(std::move(bounds),
-        std::move(static_columns), std::move(regular_columns), _opts, nullptr, options.get_cql_serialization_format(), get_per_partition_limit(options));
+        std::move(static_columns), std::move(regular_columns), _opts, nullptr, options.get_cql_serialization_format(), get_per_partition_limit(options),
+        with_row_filter ? make_row_filter(options) : std::nullopt);
+}
+
+std::optional<query::clustering_row_filter>
+select_statement::make_row_filter(const query_options& options) const {
+    const auto& ck_restrictions = _restrictions->get_clustering_columns_restrictions();
+    if (!_restrictions->need_filtering() || !_restrictions->ck_restrictions_need_filtering()
+            || expr::contains_multi_column_restriction(ck_restrictions)) {
+        return std::nullopt;
+    }
+    std::vector<query::clustering_column_restriction> restrictions;
+    for (auto&& [def, restriction] : _restrictions->get_single_column_clustering_key_restrictions()) {
+        auto unsupported = expr::find_binop(restriction, [] (const expr::binary_operator& op) {
+            return op.op == expr::oper_t::NEQ || (!expr::is_compare(op.op) && op.op != expr::oper_t::IN);
+        });
+        if (unsupported) {
+            continue;
+        }
+        auto values = expr::possible_lhs_values(def, restriction, options);
+        if (auto list = std::get_if<expr::value_list>(&values)) {
+            // An empty list matches no rows, which the coordinator takes care of.
+            if (list->empty()) {
+                continue;
+            }
+            restrictions.push_back({
+                .column = uint32_t(def->component_index()),
+                .values = boost::copy_range<std::vector<bytes>>(*list | boost::adaptors::transformed([] (const managed_bytes& v) { return to_bytes(v); })),
+                .range = nonwrapping_range<bytes>::make_open_ended_both_sides(),
+            });
+        } else {
+            auto& range = std::get<nonwrapping_range<managed_bytes>>(values);
+            if (range.is_full()) {
+                continue;
+            }
+            restrictions.push_back({
+                .column = uint32_t(def->component_index()),
+                .values = {},
+                .range = range.transform([] (const managed_bytes& v) { return to_bytes(v); }),
+            });
+        }
+    }
+    if (restrictions.empty()) {
+        return std::nullopt;
+    }
+    return query::clustering_row_filter(std::move(restrictions));
 }
 
 uint64_t select_statement::do_get_limit(const query_options& options,
@@ -349,7 +396,7 @@ select_statement::do_execute(query_processor& qp,
     _stats.select_partition_range_scan += _range_scan;
     _stats.select_partition_range_scan_no_bypass_cache += _range_scan_no_bypass_cache;
 
-    auto slice = make_partition_slice(options);
+    auto slice = make_partition_slice(options, bool(qp.proxy().features().clustering_row_filter));
     auto max_result_size = qp.proxy().get_max_result_size(slice);
     auto command = ::make_lw_shared<query::read_command>(
             _schema->id(),
@@ -515,7 +562,7 @@ generate_base_key_from_index_pk(const partition_key& index_pk, const std::option
 lw_shared_ptr<query::read_command>
 indexed_table_select_statement::prepare_command_for_base_query(query_processor& qp, const query_options& options,
         service::query_state& state, gc_clock::time_point now, bool use_paging) const {
-    auto slice = make_partition_slice(options);
+    auto slice = make_partition_slice(options, bool(qp.proxy().features().clustering_row_filter));
     if (use_paging) {
         slice.options.set<query::partition_slice::option::allow_short_read>();
         slice.options.set<query::partition_slice::option::send_partition_key>();
@@ -655,13 +702,19 @@ indexed_table_select_statement::do_execute_base_query(
     auto cmd = prepare_command_for_base_query(qp, options, state, now, bool(paging_state));
     auto timeout = db::timeout_clock::now() + get_timeout(state.get_client_state(), options);
 
+    // The rows of a base partition read by a single query.
+    struct partition_rows {
+        dht::decorated_key partition;
+        std::vector<query::clustering_range> row_ranges;
+    };
+
     struct base_query_state {
         query::result_merger merger;
-        std::vector<primary_key> primary_keys;
-        std::vector<primary_key>::iterator current_primary_key;
+        std::vector<partition_rows> primary_keys;
+        std::vector<partition_rows>::iterator current_primary_key;
         size_t previous_result_size = 0;
         size_t next_iteration_size = 0;
-        base_query_state(uint64_t row_limit, std::vector<primary_key>&& keys)
+        base_query_state(uint64_t row_limit, std::vector<partition_rows>&& keys)
                 : merger(row_limit, query::max_partitions)
                 , primary_keys(std::move(keys))
                 , current_primary_key(primary_keys.begin())
@@ -670,7 +723,26 @@ indexed_table_select_statement::do_execute_base_query(
         base_query_state(const base_query_state&) = delete;
     };
 
-    base_query_state query_state{cmd->get_row_limit(), std::move(primary_keys)};
+    // Consecutive keys of rows of the same partition, in clustering order,
+    // are read by one query of all these rows.
+    std::vector<partition_rows> partitions;
+    partitions.reserve(primary_keys.size());
+    clustering_key_prefix::prefix_equal_tri_compare ck_cmp(*_schema);
+    for (auto& key : primary_keys) {
+        if (key.clustering && !cmd->slice.is_reversed() && !partitions.empty() && !partitions.back().row_ranges.empty()
+                && partitions.back().partition.equal(*_schema, key.partition)
+                && ck_cmp(partitions.back().row_ranges.back().start()->value(), key.clustering) < 0) {
+            partitions.back().row_ranges.push_back(query::clustering_range::make_singular(std::move(key.clustering)));
+            continue;
+        }
+        std::vector<query::clustering_range> row_ranges;
+        if (key.clustering) {
+            row_ranges.push_back(query::clustering_range::make_singular(std::move(key.clustering)));
+        }
+        partitions.push_back(partition_rows{std::move(key.partition), std::move(row_ranges)});
+    }
+
+    base_query_state query_state{cmd->get_row_limit(), std::move(partitions)};
     const bool is_paged = bool(paging_state);
     return do_with(std::move(query_state), [this, is_paged, &qp, &state, &options, cmd, timeout] (auto&& query_state) {
         auto &merger = query_state.merger;
@@ -694,12 +766,7 @@ indexed_table_select_statement::do_execute_base_query(
             query::result_merger oneshot_merger(cmd->get_row_limit(), query::max_partitions);
             return utils::result_map_reduce(key_it, key_it_end, [this, &qp, &state, &options, cmd, timeout] (auto& key) {
                 auto command = ::make_lw_shared<query::read_command>(*cmd);
-                // for each partition, read just one clustering row (TODO: can
-                // get all needed rows of one partition at once.)
-                command->slice._row_ranges.clear();
-                if (key.clustering) {
-                    command->slice._row_ranges.push_back(query::clustering_range::make_singular(key.clustering));
-                }
+                command->slice._row_ranges = key.row_ranges;
                 return qp.proxy().query_result(_schema, command, {dht::partition_range::make_singular(key.partition)}, options.get_consistency(), {timeout, state.get_permit(), state.get_client_state(), state.get_trace_state()})
                 .then(utils::result_wrap([] (service::storage_proxy::coordinator_query_result qr) -> coordinator_result<foreign_ptr<lw_shared_ptr<query::result>>> {
                     return std::move(qr.query_result);
@@ -759,7 +826,23 @@ select_statement::execute_without_checking_exception_message(query_processor& qp
     // is no way to tell which of these rows belong to the query result before
     // doing post-query ordering.
     auto timeout = db::timeout_clock::now() + get_timeout(state.get_client_state(), options);
-    if (needs_post_query_ordering() && _limit) {
+    if (needs_post_query_ordering() && _limit && !_restrictions_need_filtering) {
+        // The replicas can limit the rows of every partition instead, so that
+        // all partitions are read by a single read, which storage_proxy
+        // spreads over the replicas with a bounded concurrency.
+        // Ordering the rows of all partitions, and limiting them, is still up
+        // to process_results(), with the original command.
+        assert(cmd->partition_limit == query::max_partitions);
+        const uint64_t limit = cmd->get_row_limit();
+        auto command = ::make_lw_shared<query::read_command>(*cmd);
+        command->slice.set_partition_row_limit(std::min(command->slice.partition_row_limit(), limit));
+        const uint64_t partitions = std::max<uint64_t>(partition_ranges.size(), 1);
+        command->set_row_limit(limit > query::max_rows / partitions ? query::max_rows : limit * partitions);
+        return qp.proxy().query_result(_schema, std::move(command), std::move(partition_ranges), options.get_consistency(), {timeout, state.get_permit(), state.get_client_state(), state.get_trace_state()})
+            .then(wrap_result_to_error_message([this, &options, now, cmd] (service::storage_proxy::coordinator_query_result qr) {
+                return this->process_results(std::move(qr.query_result), cmd, options, now);
+            }));
+    } else if (needs_post_query_ordering() && _limit) {
         return do_with(std::forward<dht::partition_range_vector>(partition_ranges), [this, &qp, &state, &options, cmd, timeout](auto& prs) {
             assert(cmd->partition_limit == query::max_partitions);
             query::result_merger merger(cmd->get_row_limit() * prs.size(), query::max_partitions);
@@ -951,6 +1034,50 @@ indexed_table_select_statement::indexed_table_select_statement(schema_ptr schema
         _get_partition_ranges_for_posting_list = [this] (const query_options& options) { return get_partition_ranges_for_global_index_posting_list(options); };
         _get_partition_slice_for_posting_list = [this] (const query_options& options) { return get_partition_slice_for_global_index_posting_list(options); };
     }
+    _covering_selection = make_covering_selection();
+}
+
+::shared_ptr<const selection::selection> indexed_table_select_statement::make_covering_selection() const {
+    const column_definition* target = _schema->get_column_definition(to_bytes(_index.target_column()));
+    // The posting list of an index on a collection may hold a row more than
+    // once, and the one of an index on a partition key column has no rows
+    // for partitions with only a static row.
+    if (!target || target->is_partition_key() || _index.target_type() != index_target::target_type::regular_values) {
+        return nullptr;
+    }
+    if (_selection->is_aggregate() || has_group_by() || _restrictions_need_filtering || _per_partition_limit
+            || _is_reversed || _parameters->is_distinct() || !_parameters->orderings().empty()) {
+        return nullptr;
+    }
+
+    // The base query applies all restrictions, but the posting list only the
+    // one of the indexed column and, for a local index, of the partition key.
+    if (_restrictions->has_token_restrictions() || (_index.metadata().local()
+            ? !_restrictions->partition_key_restrictions_is_all_eq() : !_restrictions->partition_key_restrictions_is_empty())) {
+        return nullptr;
+    }
+    const auto& target_restrictions = target->is_clustering_key()
+            ? _restrictions->get_single_column_clustering_key_restrictions() : _restrictions->get_non_pk_restriction();
+    const size_t other_restrictions = target->is_clustering_key()
+            ? _restrictions->get_non_pk_restriction().size() : _restrictions->clustering_columns_restrictions_size();
+    if (other_restrictions != 0 || target_restrictions.size() != 1 || !target_restrictions.contains(target)) {
+        return nullptr;
+    }
+    const auto* eq = expr::as_if<expr::binary_operator>(&target_restrictions.begin()->second);
+    if (!eq || eq->op != expr::oper_t::EQ) {
+        return nullptr;
+    }
+
+    std::vector<const column_definition*> columns;
+    columns.reserve(_selection->get_column_count());
+    for (const column_definition* cdef : _selection->get_columns()) {
+        const column_definition* view_cdef = _view_schema->get_column_definition(cdef->name());
+        if (cdef->is_static() || !view_cdef || view_cdef->is_view_virtual() || view_cdef->is_computed()) {
+            return nullptr;
+        }
+        columns.push_back(view_cdef);
+    }
+    return selection::selection::for_columns(_view_schema, std::move(columns));
 }
 
 template<typename KeyType>
@@ -1059,6 +1186,12 @@ indexed_table_select_statement::do_execute(query_processor& qp,
 
     _stats.unpaged_select_queries(_ks_sel) += options.get_page_size() <= 0;
 
+    if (_covering_selection) {
+        ++_stats.secondary_index_covered_reads;
+        tracing::trace(state.get_trace_state(), "Reading the selected columns from index {}", _index.metadata().name());
+        return execute_covered_query(qp, state, options, now);
+    }
+
     // Secondary index search has two steps: 1. use the index table to find a
     // list of primary keys matching the query. 2. read the rows matching
     // these primary keys from the base table and return the selected columns.
@@ -1170,6 +1303,78 @@ indexed_table_select_statement::do_execute(query_processor& qp,
     }
 }
 
+// Reads the posting list like read_posting_list(), but together with the
+// selected columns, which the index view holds, and builds the result of the
+// statement from it. The paging state is the one of the index view, like the
+// one the statement returns when it reads the base table.
+future<::shared_ptr<cql_transport::messages::result_message>>
+indexed_table_select_statement::execute_covered_query(query_processor& qp,
+                                                      service::query_state& state,
+                                                      const query_options& options,
+                                                      gc_clock::time_point now) const
+{
+    auto timeout = db::timeout_clock::now() + get_timeout(state.get_client_state(), options);
+    dht::partition_range_vector partition_ranges = _get_partition_ranges_for_posting_list(options);
+    query::column_id_vector regular_columns;
+    for (const column_definition* cdef : _covering_selection->get_columns()) {
+        if (cdef->is_regular()) {
+            regular_columns.push_back(cdef->id);
+        }
+    }
+    auto partition_slice = query::partition_slice(_get_partition_slice_for_posting_list(options).default_row_ranges(),
+            {}, std::move(regular_columns), _opts, nullptr, options.get_cql_serialization_format());
+
+    auto cmd = ::make_lw_shared<query::read_command>(
+            _view_schema->id(),
+            _view_schema->version(),
+            partition_slice,
+            qp.proxy().get_max_result_size(partition_slice),
+            query::tombstone_limit(qp.proxy().get_tombstone_limit()),
+            query::row_limit(get_limit(options)),
+            query::partition_limit(query::max_partitions),
+            now,
+            tracing::make_trace_info(state.get_trace_state()),
+            query_id::create_null_id(),
+            query::is_first_page::no,
+            options.get_timestamp(state));
+
+    // The rows are built by the selectors of the statement, from the columns
+    // of the index view, which the covering selection lists in the order of
+    // the columns of the statement's selection.
+    int32_t page_size = options.get_page_size();
+    if (page_size <= 0 || !service::pager::query_pagers::may_need_paging(*_view_schema, page_size, *cmd, partition_ranges)) {
+        return qp.proxy().query_result(_view_schema, cmd, std::move(partition_ranges), options.get_consistency(), {timeout, state.get_permit(), state.get_client_state(), state.get_trace_state()})
+        .then(wrap_result_to_error_message([this, now, &options, cmd] (service::storage_proxy::coordinator_query_result qr) {
+            cql3::selection::result_set_builder builder(*_selection, now, options.get_cql_serialization_format());
+            query::result_view::consume(*qr.query_result, cmd->slice,
+                    cql3::selection::result_set_builder::visitor(builder, *_view_schema, *_covering_selection));
+            auto rs = builder.build();
+            update_stats_rows_read(rs->size());
+            auto msg = ::make_shared<cql_transport::messages::result_message::rows>(result(std::move(rs)));
+            return make_ready_future<shared_ptr<cql_transport::messages::result_message>>(std::move(msg));
+        }));
+    }
+
+    cmd->slice.options.set<query::partition_slice::option::allow_short_read>();
+    auto p = service::pager::query_pagers::pager(qp.proxy(), _view_schema, _covering_selection,
+            state, options, cmd, std::move(partition_ranges), nullptr);
+    return do_with(
+            cql3::selection::result_set_builder(*_selection, now, options.get_cql_serialization_format()), std::move(p),
+            [this, page_size, now, timeout] (cql3::selection::result_set_builder& builder, std::unique_ptr<service::pager::query_pager>& p) {
+        return p->fetch_page_result(builder, page_size, now, timeout).then(wrap_result_to_error_message([this, &p, &builder] {
+            return builder.with_thread_if_needed([this, &p, &builder] {
+                auto rs = builder.build();
+                if (!p->is_exhausted()) {
+                    rs->get_metadata().set_paging_state(p->state());
+                }
+                update_stats_rows_read(rs->size());
+                auto msg = ::make_shared<cql_transport::messages::result_message::rows>(result(std::move(rs)));
+                return shared_ptr<cql_transport::messages::result_message>(std::move(msg));
+            });
+        }));
+    });
+}
+
 dht::partition_range_vector indexed_table_select_statement::get_partition_ranges_for_local_index_posting_list(const query_options& options) const {
     return _restrictions->get_partition_key_ranges(options);
 }
@@ -1437,6 +1642,13 @@ class parallelized_select_statement : public select_statement {
         service::query_state& state,
         const query_options& options
     ) const override;
+
+    future<::shared_ptr<cql_transport::messages::result_message>> execute_grouped_by_partition(
+        query_processor& qp,
+        service::query_state& state,
+        const query_options& options,
+        query::forward_request req
+    ) const;
 };
 
 ::shared_ptr<cql3::statements::select_statement> parallelized_select_statement::prepare(
@@ -1521,7 +1733,7 @@ parallelized_select_statement::do_execute(
     _stats.select_partition_range_scan_no_bypass_cache += _range_scan_no_bypass_cache;
     _stats.select_parallelized += 1;
 
-    auto slice = make_partition_slice(options);
+    auto slice = make_partition_slice(options, bool(qp.proxy().features().clustering_row_filter));
     auto command = ::make_lw_shared<query::read_command>(
         _schema->id(),
         _schema->version(),
@@ -1558,6 +1770,10 @@ parallelized_select_statement::do_execute(
         .aggregation_infos = reductions.infos,
     };
 
+    if (has_group_by()) {
+        return execute_grouped_by_partition(qp, state, options, std::move(req));
+    }
+
     // dispatch execution of this statement to other nodes
     return qp.forwarder().dispatch(req, state.get_trace_state()).then([this] (query::forward_result res) {
         auto meta = make_shared<metadata>(*_selection->get_result_metadata());
@@ -1570,6 +1786,83 @@ parallelized_select_statement::do_execute(
     });
 }
 
+// The parts of the ranges after the partition.
+static dht::partition_range_vector ranges_after(const schema& s, const dht::partition_range_vector& ranges, const partition_key& pk) {
+    const dht::ring_position pos(dht::decorate_key(s, pk));
+    dht::partition_range_vector after;
+    for (auto& r : ranges) {
+        if (auto rest = r.split_after(pos, dht::ring_position_comparator(s))) {
+            after.push_back(std::move(*rest));
+        }
+    }
+    return after;
+}
+
+// Queries grouped by partition are paged by groups: every page is a forward
+// request for the first groups, in ring order, of the ranges after the last
+// partition of the previous page, which is what the paging state holds.
+// Unpaged queries are executed in pages of internal_paging_size groups, which
+// bounds the memory of the nodes and shards executing them.
+future<::shared_ptr<cql_transport::messages::result_message>>
+parallelized_select_statement::execute_grouped_by_partition(
+    query_processor& qp,
+    service::query_state& state,
+    const query_options& options,
+    query::forward_request req
+) const {
+    const auto reductions = _selection->get_reductions();
+    const auto pk_size = _schema->partition_key_size();
+    const int32_t page_size = options.get_page_size();
+
+    uint64_t remaining = get_limit(options);
+    if (auto paging_state = options.get_paging_state()) {
+        remaining = paging_state->get_remaining();
+        req.pr = ranges_after(*_schema, req.pr, paging_state->get_partition_key());
+    }
+
+    auto rs = std::make_unique<result_set>(make_shared<metadata>(*_selection->get_result_metadata()));
+    std::optional<partition_key> last_key;
+    bool exhausted = false;
+    while (!exhausted) {
+        const auto limit = std::min(uint64_t(page_size > 0 ? page_size : internal_paging_size), remaining);
+        if (!limit || req.pr.empty()) {
+            exhausted = true;
+            break;
+        }
+        req.group_by_partition_limit = limit;
+
+        auto res = co_await qp.forwarder().dispatch(req, state.get_trace_state());
+        auto& groups = res.grouped_query_results;
+        for (auto& group : groups) {
+            std::vector<bytes_opt> row;
+            row.reserve(reductions.partition_key_components.size());
+            size_t aggregate = 0;
+            for (auto& component : reductions.partition_key_components) {
+                row.push_back(component ? group[*component] : std::move(group[pk_size + aggregate++]));
+            }
+            rs->add_row(std::move(row));
+        }
+        remaining -= groups.size();
+        exhausted = groups.size() < limit || !remaining;
+        if (!groups.empty()) {
+            auto components = boost::copy_range<std::vector<bytes>>(boost::make_iterator_range(groups.back().begin(), groups.back().begin() + pk_size)
+                    | boost::adaptors::transformed([] (const bytes_opt& b) { return b.value_or(bytes()); }));
+            last_key = partition_key::from_exploded(*_schema, components);
+            req.pr = ranges_after(*_schema, req.pr, *last_key);
+        }
+        if (page_size > 0) {
+            break;
+        }
+    }
+
+    if (!exhausted && last_key) {
+        rs->get_metadata().set_paging_state(make_lw_shared<service::pager::paging_state>(*last_key, position_in_partition_view::for_partition_end(),
+                remaining, query_id::create_null_id(), service::pager::paging_state::replicas_per_token_range{}, std::nullopt, 0));
+    }
+    update_stats_rows_read(rs->size());
+    co_return ::make_shared<cql_transport::messages::result_message::rows>(result(std::move(rs)));
+}
+
 namespace raw {
 
 static void validate_attrs(const cql3::attributes::raw& attrs) {
@@ -1677,14 +1970,34 @@ std::unique_ptr<prepared_statement> select_statement::prepare(data_dictionary::d
     // Used to determine if an execution of this statement can be parallelized
     // using `forward_service`.
     auto can_be_forwarded = [&] {
+        // GROUP BY the partition key only, so that no group spans partitions.
+        auto groups_by_partition = [&] {
+            return std::all_of(_group_by_columns.begin(), _group_by_columns.end(), [&] (const ::shared_ptr<column_identifier::raw>& col) {
+                return schema->get_column_definition(col->prepare_column_identifier(*schema)->name())->is_partition_key();
+            });
+        };
+        // Intermediate coordinators which don't know the approximate aggregates
+        // can't reduce them.
+        auto can_reduce_on_all_nodes = [&] {
+            if (db.features().approximate_aggregates) {
+                return true;
+            }
+            auto infos = selection->get_reductions().infos;
+            return std::none_of(infos.begin(), infos.end(), [] (const query::forward_request::aggregation_info& info) {
+                return std::string_view(info.name.name).starts_with("approx_");
+            });
+        };
         return selection->is_aggregate()        // Aggregation only
-            && ( // SUPPORTED PARALLELIZATION
-                 // All potential intermediate coordinators must support forwarding
-                (db.features().parallelized_aggregation && selection->is_count())
-                || (db.features().uda_native_parallelized_aggregation && selection->is_reducible())
+            && (group_by_cell_indices->empty()
+                ? ( // SUPPORTED PARALLELIZATION
+                     // All potential intermediate coordinators must support forwarding
+                    (db.features().parallelized_aggregation && selection->is_count())
+                    || (db.features().uda_native_parallelized_aggregation && selection->is_reducible() && can_reduce_on_all_nodes())
+                )
+                : (db.features().parallelized_aggregation_group_by && groups_by_partition() && selection->is_reducible_by_partition()
+                    && can_reduce_on_all_nodes())
             )
             && !restrictions->need_filtering()  // No filtering
-            && group_by_cell_indices->empty()   // No GROUP BY
             && db.get_config().enable_parallelized_aggregation();
     };
 
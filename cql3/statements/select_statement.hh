@@ -129,7 +129,12 @@ protected :
 
     const sstring& column_family() const;
 
-    query::partition_slice make_partition_slice(const query_options& options) const;
+    // The row filter is only set with with_row_filter, for replicas which
+    // all support it.
+    query::partition_slice make_partition_slice(const query_options& options, bool with_row_filter = false) const;
+
+    // The clustering key restrictions the replicas can filter rows on, if any.
+    std::optional<query::clustering_row_filter> make_row_filter(const query_options& options) const;
 
     const ::shared_ptr<const restrictions::statement_restrictions> get_restrictions() const;
 
@@ -173,6 +178,9 @@ class indexed_table_select_statement : public select_statement {
     schema_ptr _view_schema;
     noncopyable_function<dht::partition_range_vector(const query_options&)> _get_partition_ranges_for_posting_list;
     noncopyable_function<query::partition_slice(const query_options&)> _get_partition_slice_for_posting_list;
+    // The columns of the index view holding the columns the statement
+    // selects, if the index covers the statement, or null.
+    ::shared_ptr<const selection::selection> _covering_selection;
 public:
     static constexpr size_t max_base_table_query_concurrency = 4096;
 
@@ -210,6 +218,15 @@ class indexed_table_select_statement : public select_statement {
     virtual future<::shared_ptr<cql_transport::messages::result_message>> do_execute(query_processor& qp,
             service::query_state& state, const query_options& options) const override;
 
+    // An index covers the statement if the rows of its posting list are
+    // exactly the rows the statement selects, and the index view holds all
+    // the columns the statement selects. Then the statement is served from
+    // the index view alone, without reading the base table.
+    ::shared_ptr<const selection::selection> make_covering_selection() const;
+
+    future<::shared_ptr<cql_transport::messages::result_message>> execute_covered_query(query_processor& qp,
+            service::query_state& state, const query_options& options, gc_clock::time_point now) const;
+
     lw_shared_ptr<const service::pager::paging_state> generate_view_paging_state_from_base_query_results(lw_shared_ptr<const service::pager::paging_state> paging_state,
             const foreign_ptr<lw_shared_ptr<query::result>>& results, service::query_state& state, const query_options& options) const;
 
@@ -57,6 +57,10 @@ struct cql_stats {
     uint64_t cas_batches = 0;
     uint64_t statements_in_batches = 0;
     uint64_t statements_in_cas_batches = 0;
+    // The mutations of the statements of batches without conditions, and the
+    // ones left after merging the mutations of the same partition.
+    uint64_t mutations_in_batches = 0;
+    uint64_t partitions_in_batches = 0;
     uint64_t batches_pure_logged = 0;
     uint64_t batches_pure_unlogged = 0;
     uint64_t batches_unlogged_from_logged = 0;
@@ -67,6 +71,7 @@ struct cql_stats {
     int64_t secondary_index_drops = 0;
     int64_t secondary_index_reads = 0;
     int64_t secondary_index_rows_read = 0;
+    int64_t secondary_index_covered_reads = 0;
 
     int64_t filtered_reads = 0;
     int64_t filtered_rows_matched_total = 0;
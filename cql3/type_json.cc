@@ -342,8 +342,16 @@ template <typename T> static T compose_value(const integer_type_impl<T>& t, byte
     return read_be<T>(reinterpret_cast<const char*>(bv.data()));
 }
 
-static sstring to_json_string_aux(const map_type_impl& t, bytes_view bv) {
-    std::ostringstream out;
+// Collections and user types are written element by element into the
+// stream of the outermost value, rather than building a string for every
+// nested value and concatenating them.
+static void write_json(std::ostream& out, const abstract_type& t, bytes_view bv);
+
+static void write_json(std::ostream& out, const abstract_type& t, const managed_bytes_view& mbv) {
+    write_json(out, t, linearized(mbv));
+}
+
+static void write_json_aux(std::ostream& out, const map_type_impl& t, bytes_view bv) {
     auto sf = cql_serialization_format::internal();
 
     out << '{';
@@ -367,15 +375,13 @@ static sstring to_json_string_aux(const map_type_impl& t, bytes_view bv) {
             out << '"';
         }
         out << ": ";
-        out << to_json_string(*t.get_values_type(), vb);
+        write_json(out, *t.get_values_type(), vb);
     }
     out << '}';
-    return out.str();
 }
 
-static sstring to_json_string_aux(const set_type_impl& t, bytes_view bv) {
+static void write_json_aux(std::ostream& out, const set_type_impl& t, bytes_view bv) {
     using llpdi = listlike_partial_deserializing_iterator;
-    std::ostringstream out;
     bool first = true;
     auto sf = cql_serialization_format::internal();
     out << '[';
@@ -386,15 +392,13 @@ static sstring to_json_string_aux(const set_type_impl& t, bytes_view bv) {
         } else {
             out << ", ";
         }
-        out << to_json_string(*t.get_elements_type(), e);
+        write_json(out, *t.get_elements_type(), e);
     });
     out << ']';
-    return out.str();
 }
 
-static sstring to_json_string_aux(const list_type_impl& t, bytes_view bv) {
+static void write_json_aux(std::ostream& out, const list_type_impl& t, bytes_view bv) {
     using llpdi = listlike_partial_deserializing_iterator;
-    std::ostringstream out;
     bool first = true;
     auto sf = cql_serialization_format::internal();
     out << '[';
@@ -405,14 +409,12 @@ static sstring to_json_string_aux(const list_type_impl& t, bytes_view bv) {
         } else {
             out << ", ";
         }
-        out << to_json_string(*t.get_elements_type(), e);
+        write_json(out, *t.get_elements_type(), e);
     });
     out << ']';
-    return out.str();
 }
 
-static sstring to_json_string_aux(const tuple_type_impl& t, bytes_view bv) {
-    std::ostringstream out;
+static void write_json_aux(std::ostream& out, const tuple_type_impl& t, bytes_view bv) {
     out << '[';
 
     auto ti = t.all_types().begin();
@@ -422,8 +424,7 @@ static sstring to_json_string_aux(const tuple_type_impl& t, bytes_view bv) {
             out << ", ";
         }
         if (*vi) {
-            // TODO(sarna): We can avoid copying if to_json_string accepted bytes_view
-            out << to_json_string(**ti, **vi);
+            write_json(out, **ti, **vi);
         } else {
             out << "null";
         }
@@ -432,11 +433,9 @@ static sstring to_json_string_aux(const tuple_type_impl& t, bytes_view bv) {
     }
 
     out << ']';
-    return out.str();
 }
 
-static sstring to_json_string_aux(const user_type_impl& t, bytes_view bv) {
-    std::ostringstream out;
+static void write_json_aux(std::ostream& out, const user_type_impl& t, bytes_view bv) {
     out << '{';
 
     auto ti = t.all_types().begin();
@@ -448,8 +447,7 @@ static sstring to_json_string_aux(const user_type_impl& t, bytes_view bv) {
         }
         out << quote_json_string(t.field_name_as_string(i)) << ": ";
         if (*vi) {
-            //TODO(sarna): We can avoid copying if to_json_string accepted bytes_view
-            out << to_json_string(**ti, **vi);
+            write_json(out, **ti, **vi);
         } else {
             out << "null";
         }
@@ -459,7 +457,6 @@ static sstring to_json_string_aux(const user_type_impl& t, bytes_view bv) {
     }
 
     out << '}';
-    return out.str();
 }
 
 namespace {
@@ -485,11 +482,11 @@ struct to_json_string_visitor {
     sstring operator()(const boolean_type_impl& t) { return t.to_string(bv); }
     sstring operator()(const timestamp_date_base_class& t) { return quote_json_string(t.to_string(bv)); }
     sstring operator()(const timeuuid_type_impl& t) { return quote_json_string(t.to_string(bv)); }
-    sstring operator()(const map_type_impl& t) { return to_json_string_aux(t, bv); }
-    sstring operator()(const set_type_impl& t) { return to_json_string_aux(t, bv); }
-    sstring operator()(const list_type_impl& t) { return to_json_string_aux(t, bv); }
-    sstring operator()(const tuple_type_impl& t) { return to_json_string_aux(t, bv); }
-    sstring operator()(const user_type_impl& t) { return to_json_string_aux(t, bv); }
+    sstring operator()(const map_type_impl& t) { return write_json_to_string(t); }
+    sstring operator()(const set_type_impl& t) { return write_json_to_string(t); }
+    sstring operator()(const list_type_impl& t) { return write_json_to_string(t); }
+    sstring operator()(const tuple_type_impl& t) { return write_json_to_string(t); }
+    sstring operator()(const user_type_impl& t) { return write_json_to_string(t); }
     sstring operator()(const simple_date_type_impl& t) { return quote_json_string(t.to_string(bv)); }
     sstring operator()(const time_type_impl& t) { return t.to_string(bv); }
     sstring operator()(const empty_type_impl& t) { return "null"; }
@@ -518,7 +515,31 @@ struct to_json_string_visitor {
         auto v = t.deserialize(bv);
         return value_cast<utils::multiprecision_int>(v).str();
     }
+private:
+    sstring write_json_to_string(const abstract_type& t) {
+        std::ostringstream out;
+        write_json(out, t, bv);
+        return out.str();
+    }
 };
+
+// Writes nested collections and user types into the enclosing stream, and
+// every other value through to_json_string_visitor.
+struct write_json_visitor {
+    std::ostream& out;
+    bytes_view bv;
+    void operator()(const reversed_type_impl& t) { write_json(out, *t.underlying_type(), bv); }
+    void operator()(const map_type_impl& t) { write_json_aux(out, t, bv); }
+    void operator()(const set_type_impl& t) { write_json_aux(out, t, bv); }
+    void operator()(const list_type_impl& t) { write_json_aux(out, t, bv); }
+    void operator()(const user_type_impl& t) { write_json_aux(out, t, bv); }
+    void operator()(const tuple_type_impl& t) { write_json_aux(out, t, bv); }
+    void operator()(const abstract_type& t) { out << to_json_string(t, bv); }
+};
+}
+
+static void write_json(std::ostream& out, const abstract_type& t, bytes_view bv) {
+    visit(t, write_json_visitor{out, bv});
 }
 
 sstring to_json_string(const abstract_type& t, bytes_view bv) {
@@ -42,6 +42,7 @@ static logging::logger blogger("batchlog_manager");
 
 const uint32_t db::batchlog_manager::replay_interval;
 const uint32_t db::batchlog_manager::page_size;
+const size_t db::batchlog_manager::replay_concurrency;
 
 db::batchlog_manager::batchlog_manager(cql3::query_processor& qp, batchlog_manager_config config)
         : _qp(qp)
@@ -154,8 +155,10 @@ future<> db::batchlog_manager::replay_all_failed_batches() {
     // max rate is scaled by the number of nodes in the cluster (same as for HHOM - see CASSANDRA-5272).
     auto throttle = _replay_rate / _qp.proxy().get_token_metadata_ptr()->count_normal_token_owners();
     auto limiter = make_lw_shared<utils::rate_limiter>(throttle);
+    // Batches of the current page which were replayed, or can be dropped.
+    auto done = make_lw_shared<std::vector<utils::UUID>>();
 
-    auto batch = [this, limiter](const cql3::untyped_result_set::row& row) {
+    auto batch = [this, limiter, done](const cql3::untyped_result_set::row& row) {
         auto written_at = row.get_as<db_clock::time_point>("written_at");
         auto id = row.get_as<utils::UUID>("id");
         // enough time for the actual write + batchlog entry mutation delivery (two separate requests).
@@ -242,7 +245,7 @@ future<> db::batchlog_manager::replay_all_failed_batches() {
                 // See below, we use retry on write failure.
                 return _qp.proxy().mutate(mutations, db::consistency_level::ALL, db::no_timeout, nullptr, empty_service_permit(), db::allow_per_partition_rate_limit::no);
             });
-        }).then_wrapped([this, id](future<> batch_result) {
+        }).then_wrapped([this, id, done](future<> batch_result) {
             try {
                 batch_result.get();
             } catch (data_dictionary::no_such_keyspace& ex) {
@@ -255,29 +258,48 @@ future<> db::batchlog_manager::replay_all_failed_batches() {
                 // we have to resort to keeping this batch to next lap.
                 return make_ready_future<>();
             }
-            // delete batch
-            auto schema = _qp.db().find_schema(system_keyspace::NAME, system_keyspace::BATCHLOG);
-            auto key = partition_key::from_singular(*schema, id);
-            mutation m(schema, key);
-            auto now = service::client_state(service::client_state::internal_tag()).get_timestamp();
-            m.partition().apply_delete(*schema, clustering_key_prefix::make_empty(), tombstone(now, gc_clock::now()));
-            return _qp.proxy().mutate_locally(m, tracing::trace_state_ptr(), db::commitlog::force_sync::no);
+            // The batch is deleted together with the others of the page, see remove_batches().
+            done->push_back(id);
+            return make_ready_future<>();
         });
     };
 
-    return seastar::with_gate(_gate, [this, batch = std::move(batch)] {
+    // Each batch is a partition of its own, so it is deleted with a partition
+    // tombstone. The deletions of a page are applied in one go, which saves
+    // a write per batch.
+    auto remove_batches = [this, done] {
+        if (done->empty()) {
+            return make_ready_future<>();
+        }
+        auto schema = _qp.db().find_schema(system_keyspace::NAME, system_keyspace::BATCHLOG);
+        auto now = service::client_state(service::client_state::internal_tag()).get_timestamp();
+        std::vector<mutation> mutations;
+        mutations.reserve(done->size());
+        for (auto& id : *done) {
+            mutation m(schema, partition_key::from_singular(*schema, id));
+            m.partition().apply(tombstone(now, gc_clock::now()));
+            mutations.emplace_back(std::move(m));
+        }
+        _total_batches_replayed += done->size();
+        done->clear();
+        return _qp.proxy().mutate_locally(std::move(mutations), tracing::trace_state_ptr());
+    };
+
+    return seastar::with_gate(_gate, [this, batch = std::move(batch), remove_batches = std::move(remove_batches)] {
         blogger.debug("Started replayAllFailedBatches (cpu {})", this_shard_id());
 
         typedef ::shared_ptr<cql3::untyped_result_set> page_ptr;
         sstring query = format("SELECT id, data, written_at, version FROM {}.{} LIMIT {:d}", system_keyspace::NAME, system_keyspace::BATCHLOG, page_size);
-        return _qp.execute_internal(query, cql3::query_processor::cache_internal::yes).then([this, batch = std::move(batch)](page_ptr page) {
-            return do_with(std::move(page), [this, batch = std::move(batch)](page_ptr & page) mutable {
-                return repeat([this, &page, batch = std::move(batch)]() mutable {
+        return _qp.execute_internal(query, cql3::query_processor::cache_internal::yes).then([this, batch = std::move(batch), remove_batches = std::move(remove_batches)](page_ptr page) {
+            return do_with(std::move(page), [this, batch = std::move(batch), remove_batches = std::move(remove_batches)](page_ptr & page) mutable {
+                return repeat([this, &page, batch = std::move(batch), remove_batches = std::move(remove_batches)]() mutable {
                     if (page->empty()) {
                         return make_ready_future<stop_iteration>(stop_iteration::yes);
                     }
                     auto id = page->back().get_as<utils::UUID>("id");
-                    return parallel_for_each(*page, batch).then([this, &page, id]() {
+                    // Only one page is held at a time, and at most replay_concurrency
+                    // of its batches are deserialized and in flight.
+                    return max_concurrent_for_each(*page, replay_concurrency, batch).then(remove_batches).then([this, &page, id]() {
                         if (page->size() < page_size) {
                             return make_ready_future<stop_iteration>(stop_iteration::yes); // we've exhausted the batchlog, next query would be empty.
                         }
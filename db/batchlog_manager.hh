@@ -45,6 +45,9 @@ class batchlog_manager : public peering_sharded_service<batchlog_manager> {
 private:
     static constexpr uint32_t replay_interval = 60 * 1000; // milliseconds
     static constexpr uint32_t page_size = 128; // same as HHOM, for now, w/out using any heuristics. TODO: set based on avg batch size.
+    // Batches replayed concurrently. They are written with CL=ALL, so this
+    // also bounds the number of replayed batches in flight to any endpoint.
+    static constexpr size_t replay_concurrency = 16;
 
     using clock_type = lowres_clock;
 
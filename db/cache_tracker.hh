@@ -12,9 +12,13 @@
 #include "utils/logalloc.hh"
 #include "partition_version.hh"
 #include "mutation_cleaner.hh"
+#include "utils/frequency_sketch.hh"
+#include "schema_fwd.hh"
 
 #include <seastar/core/metrics_registration.hh>
 
+#include <optional>
+#include <unordered_map>
 #include <stdint.h>
 
 class cache_entry;
@@ -39,6 +43,7 @@ class cache_tracker final {
     struct stats {
         uint64_t partition_hits;
         uint64_t partition_misses;
+        uint64_t partition_absent_hits;
         uint64_t row_hits;
         uint64_t dummy_row_hits;
         uint64_t row_misses;
@@ -66,11 +71,35 @@ class cache_tracker final {
         uint64_t pinned_dirty_memory_overload;
         uint64_t range_tombstone_reads;
         uint64_t row_tombstone_reads;
+        uint64_t admission_accepts;
+        uint64_t admission_rejections;
 
         uint64_t active_reads() const {
             return reads - reads_done;
         }
     };
+
+    // Partitions of a table in cache, shared by all row_cache instances of the table.
+    struct table_occupancy {
+        uint64_t partitions = 0;
+        // The largest part of all cached partitions which the table may hold
+        // while the cache is evicting, 1 means no limit.
+        double max_share = 1;
+        unsigned caches = 0;
+    };
+
+    // Keeps a table registered with the tracker while alive.
+    class table_registration {
+        cache_tracker* _tracker;
+        table_id _id;
+        table_occupancy* _occupancy;
+    public:
+        table_registration(cache_tracker&, table_id);
+        table_registration(table_registration&&) noexcept;
+        table_registration& operator=(table_registration&&) = delete;
+        ~table_registration();
+        table_occupancy& occupancy() const noexcept { return *_occupancy; }
+    };
 private:
     stats _stats{};
     seastar::metrics::metric_groups _metrics;
@@ -79,8 +108,21 @@ class cache_tracker final {
     mutation_cleaner _garbage;
     mutation_cleaner _memtable_cleaner;
     mutation_application_stats& _app_stats;
+    // Engaged when the admission filter is enabled.
+    std::optional<utils::frequency_sketch> _admission_sketch;
+    // Moving average of the estimated access frequency of evicted partitions.
+    double _victim_frequency = 0;
+    uint64_t _victim_frequency_resets = 0;
+    std::unordered_map<table_id, table_occupancy> _table_occupancy;
+    // Whether partitions were evicted during the last window of partition insertions.
+    bool _evicting = false;
+    uint64_t _insertions_in_window = 0;
+    uint64_t _evictions_at_window_start = 0;
+    static constexpr uint64_t eviction_window = 1024;
 private:
     void setup_metrics();
+    void age_victim_frequency() noexcept;
+    table_occupancy* find_occupancy(const schema&) noexcept;
 public:
     using register_metrics = bool_class<class register_metrics_tag>;
     cache_tracker(mutation_application_stats&, register_metrics);
@@ -94,11 +136,12 @@ class cache_tracker final {
     void insert(rows_entry&) noexcept;
     void on_remove() noexcept;
     void clear_continuity(cache_entry& ce) noexcept;
-    void on_partition_erase() noexcept;
+    void on_partition_erase(const cache_entry&) noexcept;
     void on_partition_merge() noexcept;
     void on_partition_hit() noexcept;
     void on_partition_miss() noexcept;
-    void on_partition_eviction() noexcept;
+    void on_partition_absent_hit() noexcept;
+    void on_partition_eviction(const cache_entry&) noexcept;
     void on_row_eviction() noexcept;
     void on_row_hit() noexcept;
     void on_dummy_row_hit() noexcept;
@@ -119,6 +162,22 @@ class cache_tracker final {
     uint64_t partitions() const noexcept { return _stats.partitions; }
     const stats& get_stats() const noexcept { return _stats; }
     void set_compaction_scheduling_group(seastar::scheduling_group);
+
+    // Enables the admission filter for partitions populated by scans,
+    // sized for tracking about the given number of partitions.
+    void enable_admission_filter(size_t capacity);
+    bool admission_filter_enabled() const noexcept { return bool(_admission_sketch); }
+    // Records an access to the partition for the admission filter.
+    void on_partition_access(uint64_t key_hash) noexcept;
+    // Returns true if a partition read by a scan should be inserted into
+    // the cache. It is, when it is estimated to be accessed more often than
+    // the partitions currently being evicted. Always true when the filter
+    // is disabled.
+    bool admit(uint64_t key_hash) noexcept;
+    // Returns false if the table already holds more than its maximum share
+    // of cached partitions, and the cache is evicting. Partitions missing
+    // in cache should then be read without inserting them.
+    bool has_room_for(const table_occupancy&) const noexcept;
     lru& get_lru() { return _lru; }
 };
 
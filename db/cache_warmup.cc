@@ -0,0 +1,301 @@
+/*
+ * Copyright (C) 2022-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/fstream.hh>
+#include <seastar/core/seastar.hh>
+#include <seastar/core/sleep.hh>
+#include <seastar/coroutine/maybe_yield.hh>
+
+#include "db/cache_warmup.hh"
+#include "db/system_keyspace.hh"
+#include "replica/database.hh"
+#include "service/priority_manager.hh"
+#include "utils/chunked_vector.hh"
+#include "utils/crc.hh"
+#include "utils/hash.hh"
+#include "utils/serialization.hh"
+#include "log.hh"
+
+namespace db {
+
+static logging::logger cwlog("cache_warmup");
+
+// File layout, integers are big-endian:
+//   header:  magic (4), format version (4), schema version (16), tokens hash (8)
+//   keys:    length (4), partition key (length), repeated
+//   trailer: zero (4), number of keys (4), crc32 of the keys section (4)
+static constexpr uint32_t file_magic = 0x53434b57; // "SCKW"
+static constexpr uint32_t file_format_version = 1;
+static constexpr size_t header_size = 4 + 4 + 16 + 8;
+
+// Partitions of a table written per batch, between preemption points.
+static constexpr size_t save_batch_size = 1024;
+
+cache_warmup::cache_warmup(sharded<replica::database>& db, config cfg)
+    : _db(db)
+    , _cfg(std::move(cfg))
+{ }
+
+future<> cache_warmup::start() {
+    if (_cfg.save_period.count() == 0) {
+        co_return;
+    }
+    _done = with_scheduling_group(_db.local().get_streaming_scheduling_group(), [this] {
+        return run();
+    });
+}
+
+future<> cache_warmup::stop() {
+    _as.request_abort();
+    return std::exchange(_done, make_ready_future<>());
+}
+
+future<> cache_warmup::run() {
+    try {
+        co_await warm_up();
+    } catch (...) {
+        cwlog.warn("Failed to warm up the row cache: {}", std::current_exception());
+    }
+    while (!_as.abort_requested()) {
+        try {
+            co_await sleep_abortable(_cfg.save_period, _as);
+        } catch (const sleep_aborted&) {
+            co_return;
+        }
+        try {
+            co_await save();
+        } catch (...) {
+            cwlog.warn("Failed to save the row cache keys: {}", std::current_exception());
+        }
+    }
+}
+
+sstring cache_warmup::file_name(const schema& s) const {
+    return format("{}/{}-{}-{}-{}.keys", _cfg.directory, s.ks_name(), s.cf_name(), s.id(), this_shard_id());
+}
+
+future<uint64_t> cache_warmup::local_tokens_hash() {
+    auto tokens = co_await smp::submit_to(0, [] {
+        return db::system_keyspace::get_saved_tokens();
+    });
+    std::vector<int64_t> raw;
+    raw.reserve(tokens.size());
+    for (auto& t : tokens) {
+        raw.push_back(t.raw());
+    }
+    std::sort(raw.begin(), raw.end());
+    uint64_t h = 0;
+    for (auto t : raw) {
+        h = utils::hash_combine(h, t);
+    }
+    co_return h;
+}
+
+future<> cache_warmup::warm_up() {
+    auto tokens_hash = co_await local_tokens_hash();
+    for (auto& t : _db.local().get_non_system_column_families()) {
+        if (_as.abort_requested()) {
+            break;
+        }
+        if (!t->schema()->caching_options().enabled()) {
+            continue;
+        }
+        try {
+            auto holder = t->async_gate().hold();
+            co_await warm_up(*t, tokens_hash);
+        } catch (const gate_closed_exception&) {
+            // The table was dropped.
+        } catch (...) {
+            cwlog.warn("Failed to warm up the row cache of {}.{}: {}", t->schema()->ks_name(), t->schema()->cf_name(), std::current_exception());
+        }
+    }
+}
+
+static future<uint32_t> read_uint32(input_stream<char>& in) {
+    auto buf = co_await in.read_exactly(4);
+    if (buf.size() != 4) {
+        throw std::runtime_error("unexpected end of file");
+    }
+    bytes_view v(reinterpret_cast<const int8_t*>(buf.get()), buf.size());
+    co_return read_simple<uint32_t>(v);
+}
+
+future<> cache_warmup::warm_up(replica::table& t, uint64_t tokens_hash) {
+    auto s = t.schema();
+    auto name = file_name(*s);
+    if (!co_await file_exists(name)) {
+        co_return;
+    }
+
+    utils::chunked_vector<partition_key> keys;
+    {
+        auto f = co_await open_file_dma(name, open_flags::ro);
+        auto in = make_file_input_stream(std::move(f));
+        std::exception_ptr ex;
+        try {
+            auto header = co_await in.read_exactly(header_size);
+            if (header.size() != header_size) {
+                throw std::runtime_error("unexpected end of file");
+            }
+            bytes_view v(reinterpret_cast<const int8_t*>(header.get()), header.size());
+            auto magic = read_simple<uint32_t>(v);
+            auto version = read_simple<uint32_t>(v);
+            if (magic != file_magic || version != file_format_version) {
+                throw std::runtime_error(format("unsupported format {:#x}/{}", magic, version));
+            }
+            auto msb = read_simple<int64_t>(v);
+            auto lsb = read_simple<int64_t>(v);
+            auto saved_tokens_hash = read_simple<uint64_t>(v);
+            if (table_schema_version(utils::UUID(msb, lsb)) != s->version() || saved_tokens_hash != tokens_hash) {
+                cwlog.info("Not warming up the row cache of {}.{}, the schema or the tokens changed", s->ks_name(), s->cf_name());
+                co_await in.close();
+                co_return;
+            }
+            utils::crc32 crc;
+            while (auto len = co_await read_uint32(in)) {
+                auto key = co_await in.read_exactly(len);
+                if (key.size() != len) {
+                    throw std::runtime_error("unexpected end of file");
+                }
+                crc.process_be(len);
+                crc.process(reinterpret_cast<const uint8_t*>(key.get()), key.size());
+                keys.push_back(partition_key::from_bytes(bytes_view(reinterpret_cast<const int8_t*>(key.get()), key.size())));
+            }
+            auto count = co_await read_uint32(in);
+            auto checksum = co_await read_uint32(in);
+            if (count != keys.size() || checksum != crc.get()) {
+                throw std::runtime_error("checksum mismatch");
+            }
+        } catch (...) {
+            ex = std::current_exception();
+        }
+        co_await in.close();
+        if (ex) {
+            cwlog.warn("Ignoring {}: {}", name, ex);
+            co_return;
+        }
+    }
+
+    cwlog.info("Warming up the row cache of {}.{} with {} partitions", s->ks_name(), s->cf_name(), keys.size());
+    auto& db = _db.local();
+    size_t warmed_up = 0;
+    for (auto& key : keys) {
+        if (_as.abort_requested()) {
+            break;
+        }
+        auto dk = dht::decorate_key(*s, std::move(key));
+        if (dht::shard_of(*s, dk.token()) != this_shard_id()) {
+            continue;
+        }
+        // Partitions are read one at a time, to keep the I/O of the warm-up low.
+        auto permit = co_await db.obtain_reader_permit(t, "cache-warmup", db::no_timeout);
+        auto range = dht::partition_range::make_singular(dk);
+        auto rd = t.make_reader_v2(s, std::move(permit), range, s->full_slice(), service::get_local_streaming_priority());
+        std::exception_ptr ex;
+        try {
+            co_await rd.consume_pausable([] (mutation_fragment_v2) { return stop_iteration::no; });
+        } catch (...) {
+            ex = std::current_exception();
+        }
+        co_await rd.close();
+        if (ex) {
+            std::rethrow_exception(std::move(ex));
+        }
+        ++warmed_up;
+    }
+    cwlog.info("Warmed up the row cache of {}.{} with {} partitions", s->ks_name(), s->cf_name(), warmed_up);
+}
+
+future<> cache_warmup::save() {
+    auto tokens_hash = co_await local_tokens_hash();
+    for (auto& t : _db.local().get_non_system_column_families()) {
+        if (_as.abort_requested()) {
+            break;
+        }
+        try {
+            auto holder = t->async_gate().hold();
+            co_await save(*t, tokens_hash);
+        } catch (const gate_closed_exception&) {
+            // The table was dropped.
+        } catch (...) {
+            cwlog.warn("Failed to save the row cache keys of {}.{}: {}", t->schema()->ks_name(), t->schema()->cf_name(), std::current_exception());
+        }
+    }
+}
+
+future<> cache_warmup::save(replica::table& t, uint64_t tokens_hash) {
+    auto s = t.schema();
+    auto name = file_name(*s);
+    auto tmp_name = name + ".tmp";
+    auto& cache = t.get_row_cache();
+    if (!s->caching_options().enabled() || cache.partitions() == 0) {
+        if (co_await file_exists(name)) {
+            co_await remove_file(name);
+        }
+        co_return;
+    }
+    auto max_keys = _cfg.keys_to_save ? _cfg.keys_to_save : std::numeric_limits<uint32_t>::max();
+
+    auto f = co_await open_file_dma(tmp_name, open_flags::wo | open_flags::create | open_flags::truncate);
+    auto out = co_await make_file_output_stream(std::move(f));
+    std::exception_ptr ex;
+    try {
+        std::string buf;
+        auto it = std::back_inserter(buf);
+        serialize_int32(it, file_magic);
+        serialize_int32(it, file_format_version);
+        serialize_int64(it, s->version().uuid().get_most_significant_bits());
+        serialize_int64(it, s->version().uuid().get_least_significant_bits());
+        serialize_int64(it, tokens_hash);
+        co_await out.write(buf.data(), buf.size());
+
+        utils::crc32 crc;
+        uint32_t count = 0;
+        std::optional<dht::decorated_key> last;
+        while (count < max_keys) {
+            auto pos = last ? dht::ring_position_view(*last) : dht::ring_position_view::min();
+            auto keys = cache.cached_keys(pos, std::min<size_t>(save_batch_size, max_keys - count));
+            if (keys.empty()) {
+                break;
+            }
+            buf.clear();
+            it = std::back_inserter(buf);
+            for (auto& dk : keys) {
+                auto key = to_bytes(dk.key().representation());
+                serialize_int32(it, key.size());
+                crc.process_be(uint32_t(key.size()));
+                crc.process(reinterpret_cast<const uint8_t*>(key.data()), key.size());
+                it = std::copy(key.begin(), key.end(), it);
+            }
+            count += keys.size();
+            last = std::move(keys.back());
+            co_await out.write(buf.data(), buf.size());
+            co_await coroutine::maybe_yield();
+        }
+
+        buf.clear();
+        it = std::back_inserter(buf);
+        serialize_int32(it, 0);
+        serialize_int32(it, count);
+        serialize_int32(it, crc.get());
+        co_await out.write(buf.data(), buf.size());
+        co_await out.flush();
+        cwlog.debug("Saved {} row cache keys of {}.{}", count, s->ks_name(), s->cf_name());
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    co_await out.close();
+    if (ex) {
+        co_await remove_file(tmp_name).handle_exception([] (auto) {});
+        std::rethrow_exception(std::move(ex));
+    }
+    co_await rename_file(tmp_name, name);
+}
+
+}
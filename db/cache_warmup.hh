@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2022-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <seastar/core/abort_source.hh>
+#include <seastar/core/future.hh>
+#include <seastar/core/sharded.hh>
+#include <seastar/core/sstring.hh>
+
+#include "replica/database_fwd.hh"
+#include "schema_fwd.hh"
+
+using namespace seastar;
+
+namespace db {
+
+/// \brief Saves the keys of partitions present in the row cache and reads
+/// them back into the cache after a restart.
+///
+/// Every shard periodically writes, for each non-system table, the keys of
+/// the partitions in its cache to a file in saved_caches_directory. On start,
+/// the partitions from these files are read, which populates the cache,
+/// under the streaming scheduling group and I/O priority class.
+///
+/// A file is ignored if the schema version of the table, or the tokens of the
+/// node, have changed since it was written. Keys which now belong to another
+/// shard are skipped.
+class cache_warmup : public peering_sharded_service<cache_warmup> {
+public:
+    struct config {
+        sstring directory;
+        // Zero disables saving and loading.
+        std::chrono::seconds save_period;
+        // Maximum number of keys saved per table and shard, zero means all.
+        uint32_t keys_to_save;
+    };
+private:
+    sharded<replica::database>& _db;
+    config _cfg;
+    abort_source _as;
+    future<> _done = make_ready_future<>();
+private:
+    future<> run();
+    future<> warm_up();
+    future<> warm_up(replica::table& t, uint64_t tokens_hash);
+    future<> save();
+    future<> save(replica::table& t, uint64_t tokens_hash);
+    sstring file_name(const schema& s) const;
+    static future<uint64_t> local_tokens_hash();
+public:
+    cache_warmup(sharded<replica::database>& db, config cfg);
+
+    /// \brief Reads the saved partitions and starts saving periodically, in the background.
+    future<> start();
+    future<> stop();
+};
+
+}
@@ -107,7 +107,9 @@ db::commitlog::config db::commitlog::config::from_db_config(const db::config& cf
     c.mode = cfg.commitlog_sync() == "batch" ? sync_mode::BATCH : sync_mode::PERIODIC;
     c.extensions = &cfg.extensions();
     c.use_o_dsync = cfg.commitlog_use_o_dsync();
+    c.compress_entries = cfg.commitlog_compression();
     c.allow_going_over_size_limit = !cfg.commitlog_use_hard_size_limit();
+    c.batch_max_delay = std::chrono::microseconds(cfg.commitlog_sync_batch_max_delay_in_us());
 
     if (cfg.commitlog_flush_threshold_in_mb() >= 0) {
         c.commitlog_flush_threshold_in_mb = cfg.commitlog_flush_threshold_in_mb();
@@ -220,6 +222,8 @@ struct db::commitlog::entry_writer {
 const std::string db::commitlog::descriptor::SEPARATOR("-");
 const std::string db::commitlog::descriptor::FILENAME_PREFIX(
         "CommitLog" + SEPARATOR);
+const std::string db::commitlog::descriptor::SEGREGATED_FILENAME_PREFIX(
+        "SegregatedLog" + SEPARATOR);
 const std::string db::commitlog::descriptor::FILENAME_EXTENSION(".log");
 
 class db::commitlog::segment_manager : public ::enable_shared_from_this<segment_manager> {
@@ -364,6 +368,8 @@ class db::commitlog::segment_manager : public ::enable_shared_from_this<segment_
     struct stats : public byte_flow<uint64_t> {
         uint64_t cycle_count = 0;
         uint64_t flush_count = 0;
+        // Flushes of O_DSYNC segments, which don't need to sync the file.
+        uint64_t flushes_skipped = 0;
         uint64_t allocation_count = 0;
         uint64_t bytes_slack = 0;
         uint64_t segments_created = 0;
@@ -379,6 +385,9 @@ class db::commitlog::segment_manager : public ::enable_shared_from_this<segment_
         uint64_t requests_blocked_memory = 0;
         uint64_t blocked_on_new_segment = 0;
         uint64_t active_allocations = 0;
+        uint64_t group_commits = 0;
+        uint64_t group_commit_writes = 0;
+        uint64_t group_commit_delay_us = 0;
     };
 
     class scope_increment_counter {
@@ -400,6 +409,29 @@ class db::commitlog::segment_manager : public ::enable_shared_from_this<segment_
 
     typename std::chrono::high_resolution_clock::time_point last_time;
 
+    // Moving average of the latency of syncing a segment, and the number of
+    // writes coalesced into the last group commit. See segment::batch_cycle().
+    std::chrono::microseconds sync_latency{0};
+    uint64_t last_group_size = 0;
+
+    void on_sync(std::chrono::steady_clock::duration latency) noexcept {
+        auto us = std::chrono::duration_cast<std::chrono::microseconds>(latency);
+        sync_latency = sync_latency.count() ? (sync_latency * 7 + us) / 8 : us;
+    }
+
+    // How long a batch mode writer which is about to sync waits for
+    // concurrent writers to join it.
+    //
+    // Worth it only when writes are concurrent, in which case waiting for a
+    // fraction of the sync latency lets the next sync cover the writes which
+    // would otherwise queue up behind this one.
+    std::chrono::microseconds group_commit_delay() const noexcept {
+        if (cfg.batch_max_delay.count() == 0 || (last_group_size <= 1 && totals.active_allocations <= 1)) {
+            return std::chrono::microseconds(0);
+        }
+        return std::min(cfg.batch_max_delay, sync_latency / 2);
+    }
+
     size_t pending_allocations() const {
         return _request_controller.waiters();
     }
@@ -678,6 +710,8 @@ class db::commitlog::segment : public enable_shared_from_this<segment>, public c
     uint64_t _waste = 0;
 
     size_t _alignment;
+    // Written with O_DSYNC, so writes are durable once they complete.
+    bool _dsync;
 
     bool _closed = false;
     bool _terminated = false;
@@ -695,6 +729,11 @@ class db::commitlog::segment : public enable_shared_from_this<segment>, public c
 
     uint64_t _num_allocs = 0;
 
+    // Set while a batch mode writer waits for others to join its sync,
+    // resolved when the sync was initiated.
+    std::optional<shared_future<>> _group_commit;
+    uint64_t _group_size = 0;
+
     std::unordered_set<table_schema_version> _known_schema_versions;
 
     friend std::ostream& operator<<(std::ostream&, const segment&);
@@ -738,9 +777,9 @@ class db::commitlog::segment : public enable_shared_from_this<segment>, public c
     // TODO : tune initial / default size
     static constexpr size_t default_size = 128 * 1024;
 
-    segment(::shared_ptr<segment_manager> m, descriptor&& d, named_file&& f, size_t alignment)
+    segment(::shared_ptr<segment_manager> m, descriptor&& d, named_file&& f, size_t alignment, bool dsync)
             : _segment_manager(std::move(m)), _desc(std::move(d)), _file(std::move(f)),
-        _alignment(alignment),
+        _alignment(alignment), _dsync(dsync),
         _sync_time(clock_type::now()), _pending_ops(true) // want exception propagation
     {
         ++_segment_manager->totals.segments_created;
@@ -908,7 +947,15 @@ class db::commitlog::segment : public enable_shared_from_this<segment>, public c
         }
 
         try {
-            co_await _file.flush();
+            // Flushes wait for all writes below pos. With O_DSYNC these are
+            // durable already, together with the metadata needed to read them.
+            if (_dsync) {
+                ++_segment_manager->totals.flushes_skipped;
+            } else {
+                auto start = std::chrono::steady_clock::now();
+                co_await _file.flush();
+                _segment_manager->on_sync(std::chrono::steady_clock::now() - start);
+            }
             // TODO: retry/ignore/fail/stop - optional behaviour in origin.
             // we fast-fail the whole commit.
             _flush_pos = std::max(pos, _flush_pos);
@@ -1075,11 +1122,41 @@ class db::commitlog::segment : public enable_shared_from_this<segment>, public c
          *
          * This has the benefit of allowing several allocations to
          * queue up in a single buffer.
+         *
+         * With a group commit delay configured, the first writer of the
+         * buffer also waits for concurrent writers to add to it, and the
+         * others wait for its sync.
          */
         auto me = shared_from_this();
         auto fp = _file_pos;
         try {
             co_await _pending_ops.wait_for_pending(timeout);
+            if (fp == _file_pos) {
+                if (_group_commit) {
+                    ++_group_size;
+                    co_await with_timeout(timeout, _group_commit->get_future());
+                } else if (auto delay = _segment_manager->group_commit_delay(); delay.count()) {
+                    promise<> pr;
+                    _group_commit.emplace(pr.get_future());
+                    _group_size = 1;
+                    auto start = std::chrono::steady_clock::now();
+                    co_await sleep(std::min<std::chrono::microseconds>(delay,
+                            std::chrono::duration_cast<std::chrono::microseconds>(timeout - timeout_clock::now())));
+                    auto& totals = _segment_manager->totals;
+                    ++totals.group_commits;
+                    totals.group_commit_writes += _group_size;
+                    totals.group_commit_delay_us += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+                    _segment_manager->last_group_size = _group_size;
+                    _group_commit.reset();
+                    // Followers see the buffer written, once the sync below starts.
+                    auto sync_done = sync();
+                    pr.set_value();
+                    co_await with_timeout(timeout, std::move(sync_done));
+                    co_return me;
+                } else {
+                    _segment_manager->last_group_size = 1;
+                }
+            }
             if (fp != _file_pos) {
                 // some other request already wrote this buffer.
                 // If so, wait for the operation at our intended file offset
@@ -1534,6 +1611,9 @@ void db::commitlog::segment_manager::create_counters(const sstring& metrics_cate
         sm::make_counter("flush", totals.flush_count,
                        sm::description("Counts number of times the flush() method was called for a file.")),
 
+        sm::make_counter("flush_skipped", totals.flushes_skipped,
+                       sm::description("Counts number of flushes which didn't sync the file, because it is written with O_DSYNC.")),
+
         sm::make_counter("bytes_written", totals.bytes_written,
                        sm::description("Counts number of bytes written to the disk. "
                                        "Divide this value by \"alloc\" to get the average number of bytes per mutation written to the disk.")),
@@ -1584,6 +1664,15 @@ void db::commitlog::segment_manager::create_counters(const sstring& metrics_cate
 
         sm::make_gauge("active_allocations", totals.active_allocations,
                        sm::description("Current number of active allocations.")),
+
+        sm::make_counter("group_commits", totals.group_commits,
+                       sm::description("Counts number of batch mode syncs which waited for concurrent writes to join them.")),
+
+        sm::make_counter("group_commit_writes", totals.group_commit_writes,
+                       sm::description("Counts number of writes covered by group commits. Divide by group_commits for the average group size.")),
+
+        sm::make_counter("group_commit_delay_us", totals.group_commit_delay_us,
+                       sm::description("Counts total time in microseconds which group commits waited for concurrent writes before syncing.")),
     });
 }
 
@@ -1768,12 +1857,12 @@ future<db::commitlog::segment_manager::sseg_ptr> db::commitlog::segment_manager:
         co_return coroutine::exception(std::move(ep));
     }
 
-    co_return make_shared<segment>(shared_from_this(), std::move(d), std::move(f), align);
+    co_return make_shared<segment>(shared_from_this(), std::move(d), std::move(f), align, (flags & open_flags::dsync) != open_flags{});
 }
 
 future<db::commitlog::segment_manager::sseg_ptr> db::commitlog::segment_manager::allocate_segment() {
     for (;;) {
-        descriptor d(next_id(), cfg.fname_prefix);
+        descriptor d(next_id(), cfg.fname_prefix, cfg.compress_entries ? descriptor::segment_version_3 : descriptor::segment_version_2);
         auto dst = filename(d);
         auto flags = open_flags::wo;
         if (cfg.use_o_dsync) {
@@ -2358,9 +2447,11 @@ future<db::rp_handle> db::commitlog::add_entry(const cf_id_type& id, const commi
         commitlog_entry_writer _writer;
     public:
         rp_handle res;
-        cl_entry_writer(const commitlog_entry_writer& wr) 
-            : entry_writer(wr.sync()), _writer(wr) 
-        {}
+        cl_entry_writer(const commitlog_entry_writer& wr, bool compress)
+            : entry_writer(wr.sync()), _writer(wr)
+        {
+            _writer.set_compression(compress);
+        }
         const cf_id_type& id(size_t) const override {
             return _writer.schema()->id();
         }
@@ -2390,7 +2481,7 @@ future<db::rp_handle> db::commitlog::add_entry(const cf_id_type& id, const commi
             return std::move(res);
         }
     };
-    return _segment_manager->allocate_when_possible(cl_entry_writer(cew), timeout);
+    return _segment_manager->allocate_when_possible(cl_entry_writer(cew, _segment_manager->cfg.compress_entries), timeout);
 }
 
 future<std::vector<db::rp_handle>> 
@@ -2452,6 +2543,9 @@ db::commitlog::add_entries(std::vector<commitlog_entry_writer> entry_writers, db
     };
 
     force_sync sync(std::any_of(entry_writers.begin(), entry_writers.end(), [](auto& w) { return bool(w.sync()); }));
+    for (auto& w : entry_writers) {
+        w.set_compression(_segment_manager->cfg.compress_entries);
+    }
     return _segment_manager->allocate_when_possible(cl_entries_writer(sync, std::move(entry_writers)), timeout);
 }
 
@@ -104,9 +104,13 @@ class commitlog {
         uint64_t max_active_flushes = 0;
 
         sync_mode mode = sync_mode::PERIODIC;
+        // Maximum time a write waits in batch mode for concurrent writes to
+        // share its sync. Zero disables group commit.
+        std::chrono::microseconds batch_max_delay{0};
         std::string fname_prefix = descriptor::FILENAME_PREFIX;
 
         bool use_o_dsync = false;
+        bool compress_entries = false;
         bool warn_about_segments_left_on_disk_after_shutdown = true;
         bool allow_going_over_size_limit = true;
 
@@ -129,10 +133,14 @@ class commitlog {
     public:
         static const std::string SEPARATOR;
         static const std::string FILENAME_PREFIX;
+        // Of the commitlog of commitlog_segregated_keyspaces.
+        static const std::string SEGREGATED_FILENAME_PREFIX;
         static const std::string FILENAME_EXTENSION;
 
         static inline constexpr uint32_t segment_version_1 = 1u;
         static inline constexpr uint32_t segment_version_2 = 2u;
+        // Entries may be compressed, see commitlog_entry_writer.
+        static inline constexpr uint32_t segment_version_3 = 3u;
 
         descriptor(descriptor&&) noexcept = default;
         descriptor(const descriptor&) = default;
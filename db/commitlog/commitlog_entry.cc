@@ -6,12 +6,30 @@
  * SPDX-License-Identifier: AGPL-3.0-or-later
  */
 
+#include "bytes_ostream.hh"
+#include "utils/reusable_buffer.hh"
 #include "counters.hh"
 #include "commitlog_entry.hh"
 #include "idl/commitlog.dist.hh"
 #include "idl/commitlog.dist.impl.hh"
 
 #include <seastar/core/simple-stream.hh>
+#include <seastar/core/byteorder.hh>
+
+#include <lz4.h>
+
+// Compressed entries start with this instead of the size of the serialized
+// commitlog_entry, which is never this large. Followed by the size of the
+// uncompressed entry, and the entry compressed with LZ4. Only written to
+// segments of version segment_version_3.
+static constexpr uint32_t compressed_entry_magic = 0xc1c1c1c1;
+static constexpr size_t compressed_entry_header_size = 2 * sizeof(uint32_t);
+// Smaller mutations are not worth compressing.
+static constexpr size_t min_compressible_size = 256;
+
+// LZ4 works on contiguous buffers, these linearize the fragmented ones.
+static thread_local utils::reusable_buffer input_buffer;
+static thread_local utils::reusable_buffer output_buffer;
 
 template<typename Output>
 void commitlog_entry_writer::serialize(Output& out) const {
@@ -25,18 +43,66 @@ void commitlog_entry_writer::serialize(Output& out) const {
 }
 
 void commitlog_entry_writer::compute_size() {
+    _compressed = {};
     seastar::measuring_output_stream ms;
     serialize(ms);
     _size = ms.size();
+    if (_compress && mutation_size() >= min_compressible_size) {
+        bytes_ostream serialized;
+        serialize(serialized);
+        auto in = input_buffer.get_linearized_view(serialized);
+        auto bound = LZ4_compressBound(in.size());
+        auto compressed = output_buffer.make_buffer(compressed_entry_header_size + bound, [&] (bytes_mutable_view out) -> size_t {
+            auto p = reinterpret_cast<char*>(out.data());
+            auto len = LZ4_compress_default(reinterpret_cast<const char*>(in.data()), p + compressed_entry_header_size, in.size(), bound);
+            if (len <= 0 || compressed_entry_header_size + len >= in.size()) {
+                return 0;
+            }
+            write_le<uint32_t>(p, compressed_entry_magic);
+            write_le<uint32_t>(p + sizeof(uint32_t), in.size());
+            return compressed_entry_header_size + len;
+        });
+        if (!compressed.empty()) {
+            _compressed = std::move(compressed);
+            _size = _compressed.size();
+        }
+    }
 }
 
 void commitlog_entry_writer::write(typename seastar::memory_output_stream<std::vector<temporary_buffer<char>>::iterator>& out) const {
+    if (!_compressed.empty()) {
+        for (bytes_view fragment : _compressed) {
+            out.write(reinterpret_cast<const char*>(fragment.data()), fragment.size());
+        }
+        return;
+    }
     serialize(out);
 }
 
+static commitlog_entry decompress_entry(const fragmented_temporary_buffer& buffer) {
+    auto in = input_buffer.get_linearized_view(fragmented_temporary_buffer::view(buffer));
+    auto raw_size = read_le<uint32_t>(reinterpret_cast<const char*>(in.data()) + sizeof(uint32_t));
+    in.remove_prefix(compressed_entry_header_size);
+    auto raw = output_buffer.make_fragmented_temporary_buffer(raw_size, fragmented_temporary_buffer::default_fragment_size, [&] (bytes_mutable_view out) {
+        auto ret = LZ4_decompress_safe(reinterpret_cast<const char*>(in.data()), reinterpret_cast<char*>(out.data()), in.size(), raw_size);
+        if (ret < 0 || size_t(ret) != raw_size) {
+            throw std::runtime_error(format("commitlog entry decompression failure: expected {} bytes, got {}", raw_size, ret));
+        }
+        return size_t(ret);
+    });
+    auto raw_in = seastar::fragmented_memory_input_stream(fragmented_temporary_buffer::view(raw).begin(), raw.size_bytes());
+    return ser::deserialize(raw_in, boost::type<commitlog_entry>());
+}
+
 commitlog_entry_reader::commitlog_entry_reader(const fragmented_temporary_buffer& buffer)
     : _ce([&] {
     auto in = seastar::fragmented_memory_input_stream(fragmented_temporary_buffer::view(buffer).begin(), buffer.size_bytes());
+    if (buffer.size_bytes() >= compressed_entry_header_size) {
+        auto peek = in;
+        if (ser::deserialize(peek, boost::type<uint32_t>()) == compressed_entry_magic) {
+            return decompress_entry(buffer);
+        }
+    }
     return ser::deserialize(in, boost::type<commitlog_entry>());
 }())
 {
@@ -10,6 +10,7 @@
 
 #include <optional>
 
+#include "bytes_ostream.hh"
 #include "commitlog_types.hh"
 #include "frozen_mutation.hh"
 #include "schema_fwd.hh"
@@ -34,6 +35,9 @@ class commitlog_entry_writer {
     bool _with_schema = true;
     size_t _size = std::numeric_limits<size_t>::max();
     force_sync _sync;
+    bool _compress = false;
+    // The entry as written, when compressed.
+    bytes_ostream _compressed;
 private:
     template<typename Output>
     void serialize(Output&) const;
@@ -43,13 +47,25 @@ class commitlog_entry_writer {
         : _schema(std::move(s)), _mutation(fm), _sync(sync)
     {}
 
+    // Computes the size, unless already computed for the same value. The
+    // commitlog calls this on every attempt to place the entry in a segment.
     void set_with_schema(bool value) {
-        _with_schema = value;
-        compute_size();
+        if (value != _with_schema || _size == std::numeric_limits<size_t>::max()) {
+            _with_schema = value;
+            compute_size();
+        }
     }
     bool with_schema() const {
         return _with_schema;
     }
+    // Compresses the entry if it makes it smaller. Takes effect on the next
+    // set_with_schema(), which computes the size.
+    void set_compression(bool value) {
+        if (value != _compress) {
+            _compress = value;
+            _size = std::numeric_limits<size_t>::max();
+        }
+    }
     schema_ptr schema() const {
         return _schema;
     }
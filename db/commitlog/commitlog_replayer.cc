@@ -14,6 +14,8 @@
 #include <boost/range/adaptor/map.hpp>
 
 #include <seastar/core/future.hh>
+#include <seastar/core/loop.hh>
+#include <seastar/core/semaphore.hh>
 #include <seastar/core/sharded.hh>
 
 #include "commitlog.hh"
@@ -52,6 +54,11 @@ class db::commitlog_replayer::impl {
 
     future<> init();
 
+    // Entries of a segment being applied at a time.
+    static constexpr size_t max_concurrent_entries = 64;
+    // Segments replayed at a time per shard.
+    static constexpr size_t max_concurrent_files = 2;
+
     struct stats {
         uint64_t invalid_mutations = 0;
         uint64_t skipped_mutations = 0;
@@ -194,18 +201,28 @@ db::commitlog_replayer::impl::recover(sstring file, const sstring& fname_prefix)
 
     auto s = make_lw_shared<stats>();
     auto& exts = _db.local().extensions();
+    // Entries are applied in the background, so that reading the file goes on
+    // while the mutations are being applied on their shards. The number in
+    // flight is bounded, and applying waits for dirty memory as usual.
+    auto sem = make_lw_shared<semaphore>(max_concurrent_entries);
 
     return db::commitlog::read_log_file(file, fname_prefix, service::get_local_commitlog_priority(),
-            std::bind(&impl::process, this, s.get(), std::placeholders::_1),
-            p, &exts).then_wrapped([s](future<> f) {
-        try {
-            f.get();
-        } catch (commitlog::segment_data_corruption_error& e) {
-            s->corrupt_bytes += e.bytes();
-        } catch (...) {
-            throw;
-        }
-        return make_ready_future<stats>(*s);
+            [this, s, sem] (commitlog::buffer_and_replay_position buf_rp) {
+        return get_units(*sem, 1).then([this, s, buf_rp = std::move(buf_rp)] (auto units) mutable {
+            // process() handles its errors.
+            (void)process(s.get(), std::move(buf_rp)).finally([s, units = std::move(units)] {});
+        });
+    }, p, &exts).then_wrapped([s, sem](future<> f) {
+        return sem->wait(max_concurrent_entries).then([s, f = std::move(f)] () mutable {
+            try {
+                f.get();
+            } catch (commitlog::segment_data_corruption_error& e) {
+                s->corrupt_bytes += e.bytes();
+            } catch (...) {
+                throw;
+            }
+            return make_ready_future<stats>(*s);
+        });
     });
 }
 
@@ -340,11 +357,11 @@ future<> db::commitlog_replayer::recover(std::vector<sstring> files, sstring fna
             return map_reduce(smp::all_cpus(), [this, map, &fname_prefix] (unsigned id) {
                 return smp::submit_to(id, [this, id, map, &fname_prefix] () {
                     auto total = ::make_lw_shared<impl::stats>();
-                    // TODO: or something. For now, we do this serialized per shard,
-                    // to reduce mutation congestion. We could probably (says avi)
-                    // do 2 segments in parallel or something, but lets use this first.
+                    // A few segments at a time per shard, so that reading one
+                    // overlaps with the decoding and applying of another,
+                    // without too much mutation congestion.
                     auto range = map->equal_range(id);
-                    return do_for_each(range.first, range.second, [this, total, &fname_prefix] (const std::pair<unsigned, sstring>& p) {
+                    return max_concurrent_for_each(range.first, range.second, impl::max_concurrent_files, [this, total, &fname_prefix] (const std::pair<unsigned, sstring>& p) {
                         auto&f = p.second;
                         rlogger.debug("Replaying {}", f);
                         return _impl->recover(f, fname_prefix).then([f, total](impl::stats stats) {
@@ -281,8 +281,22 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "If set to higher than 0, ignore the controller's output and set the memtable shares statically. Do not set this unless you know what you are doing and suspect a problem in the controller. This option will be retired when the controller reaches more maturity")
     , compaction_static_shares(this, "compaction_static_shares", liveness::LiveUpdate, value_status::Used, 0,
         "If set to higher than 0, ignore the controller's output and set the compaction shares statically. Do not set this unless you know what you are doing and suspect a problem in the controller. This option will be retired when the controller reaches more maturity")
+    , compaction_controller_lookahead_in_ms(this, "compaction_controller_lookahead_in_ms", liveness::LiveUpdate, value_status::Used, 0,
+        "If set to higher than 0, the compaction controller sets the shares according to the backlog it predicts this far ahead from the smoothed trend of the backlog, rather than to the current backlog only, so that the shares ramp up ahead of ingest bursts. 0 disables the prediction.")
+    , maintenance_latency_target_in_ms(this, "maintenance_latency_target_in_ms", liveness::LiveUpdate, value_status::Used, 0,
+        "If set to higher than 0, the shares of maintenance work (streaming, repair and hint replay) are lowered towards maintenance_min_shares while the 99th percentile of the latency of the user reads and writes on a shard is above this many milliseconds, and raised back towards maintenance_max_shares while it is below. 0 keeps the maintenance shares at maintenance_max_shares.")
+    , maintenance_min_shares(this, "maintenance_min_shares", liveness::LiveUpdate, value_status::Used, 50,
+        "The shares maintenance work is lowered to at most when maintenance_latency_target_in_ms is missed.")
+    , maintenance_max_shares(this, "maintenance_max_shares", liveness::LiveUpdate, value_status::Used, 200,
+        "The shares of maintenance work while maintenance_latency_target_in_ms is met, or when it is 0.")
+    , counter_update_coalescing_window_in_us(this, "counter_update_coalescing_window_in_us", liveness::LiveUpdate, value_status::Used, 0,
+        "If set to higher than 0, a counter update waits this many microseconds on the leader replica before taking the counter locks and reading the current value, and the updates to the same partition that arrive meanwhile have their deltas summed into it, so that they share a single read-before-write and counter shard update. This increases the latency of counter updates, but raises the rate that a contended counter can be updated with. 0 applies every counter update on its own.")
+    , coordinator_counter_update_coalescing_window_in_us(this, "coordinator_counter_update_coalescing_window_in_us", liveness::LiveUpdate, value_status::Used, 0,
+        "If set to higher than 0, a counter update statement to a single partition waits this many microseconds on the coordinator before it is sent to its counter leader, and the updates of the same partition and consistency level that arrive meanwhile have their deltas summed into it, so that they share a single leader round trip. They are all acknowledged once it completes. 0 sends every counter update on its own.")
     , compaction_enforce_min_threshold(this, "compaction_enforce_min_threshold", liveness::LiveUpdate, value_status::Used, false,
         "If set to true, enforce the min_threshold option for compactions strictly. If false (default), Scylla may decide to compact even if below min_threshold")
+    , major_compaction_parallelism(this, "major_compaction_parallelism", liveness::LiveUpdate, value_status::Used, 1,
+        "Number of concurrent jobs a major compaction is split into on every shard, each compacting a disjoint token sub-range of the input sstables into the same output run, or, with TimeWindowCompactionStrategy, a time window at a time. The input sstables are replaced once all the jobs complete, so the temporary disk space needed is the same as with a single job.")
     /* Initialization properties */
     /* The minimal properties needed for configuring a cluster. */
     , cluster_name(this, "cluster_name", value_status::Used, "",
@@ -309,7 +323,7 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "The directory where hints files are stored if hinted handoff is enabled.")
     , view_hints_directory(this, "view_hints_directory", value_status::Used, "",
         "The directory where materialized-view updates are stored while a view replica is unreachable.")
-    , saved_caches_directory(this, "saved_caches_directory", value_status::Unused, "",
+    , saved_caches_directory(this, "saved_caches_directory", value_status::Used, "",
         "The directory location where table key and row caches are stored.")
     /* Commonly used properties */
     /* Properties most frequently used when configuring Scylla. */
@@ -422,6 +436,8 @@ db::config::config(std::shared_ptr<db::extensions> exts)
     /* Note: does not exist on the listing page other than in above comment, wtf? */
     , commitlog_sync_batch_window_in_ms(this, "commitlog_sync_batch_window_in_ms", value_status::Used, 10000,
         "Controls how long the system waits for other writes before performing a sync in \"batch\" mode.")
+    , commitlog_sync_batch_max_delay_in_us(this, "commitlog_sync_batch_max_delay_in_us", value_status::Used, 0,
+        "Maximum time a write waits in \"batch\" mode for concurrent writes to share its sync (group commit). The actual wait adapts to the measured sync latency of the commitlog device, and writes don't wait when there are no concurrent ones. 0 disables group commit.")
     , commitlog_total_space_in_mb(this, "commitlog_total_space_in_mb", value_status::Used, -1,
         "Total space used for commitlogs. If the used space goes above this value, Scylla rounds up to the next nearest segment multiple and flushes memtables to disk for the oldest commitlog segments, removing those log segments. This reduces the amount of data to replay on startup, and prevents infrequently-updated tables from indefinitely keeping commitlog segments. A small total commitlog space tends to cause more flush activity on less-active tables.\n"
         "Related information: Configuring memtable throughput")
@@ -434,6 +450,14 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "Whether or not to use O_DSYNC mode for commitlog segments IO. Can improve commitlog latency on some file systems.\n")
     , commitlog_use_hard_size_limit(this, "commitlog_use_hard_size_limit", value_status::Used, false,
         "Whether or not to use a hard size limit for commitlog disk usage. Default is false. Enabling this can cause latency spikes, whereas the default can lead to occasional disk usage peaks.\n")
+    , commitlog_segregated_keyspaces(this, "commitlog_segregated_keyspaces", value_status::Used, { },
+        "Keyspaces whose tables are logged to a separate commitlog, with its own segments, next to the main one in commitlog_directory. "
+        "Segments of a commitlog are held until all the tables written to them are flushed, so separating tables which are flushed rarely from busy ones "
+        "lets the segments of the busy ones be freed early. The separate commitlog has the same size limits as the main one.")
+    , commitlog_segregated_sync(this, "commitlog_segregated_sync", value_status::Used, "",
+        "The commitlog_sync method of the commitlog of commitlog_segregated_keyspaces, \"periodic\" or \"batch\". Defaults to commitlog_sync.")
+    , commitlog_compression(this, "commitlog_compression", value_status::Used, false,
+        "Whether or not to compress commitlog entries with LZ4. Reduces the amount of data written to the commitlog, at the cost of CPU. Segments written with compression cannot be replayed by versions which don't support it.\n")
     /* Compaction settings */
     /* Related information: Configuring compaction */
     , compaction_preheat_key_cache(this, "compaction_preheat_key_cache", value_status::Unused, true,
@@ -533,12 +557,13 @@ db::config::config(std::shared_ptr<db::extensions> exts)
     , key_cache_size_in_mb(this, "key_cache_size_in_mb", value_status::Unused, 100,
         "A global cache setting for tables. It is the maximum size of the key cache in memory. To disable set to 0.\n"
         "Related information: nodetool setcachecapacity.")
-    , row_cache_keys_to_save(this, "row_cache_keys_to_save", value_status::Unused, 0,
-        "Number of keys from the row cache to save.")
+    , row_cache_keys_to_save(this, "row_cache_keys_to_save", value_status::Used, 0,
+        "Number of keys from the row cache to save, per table and shard. (0: all)")
     , row_cache_size_in_mb(this, "row_cache_size_in_mb", value_status::Unused, 0,
         "Maximum size of the row cache in memory. Row cache can save more time than key_cache_size_in_mb, but is space-intensive because it contains the entire row. Use the row cache only for hot rows or static rows. If you reduce the size, you may not get you hottest keys loaded on start up.")
-    , row_cache_save_period(this, "row_cache_save_period", value_status::Unused, 0,
-        "Duration in seconds that rows are saved in cache. Caches are saved to saved_caches_directory.")
+    , row_cache_save_period(this, "row_cache_save_period", value_status::Used, 0,
+        "Duration in seconds after which the keys of the partitions in the row cache are saved to saved_caches_directory. "
+        "The saved partitions are read back into the cache on startup. (0: disabled)")
     , memory_allocator(this, "memory_allocator", value_status::Invalid, "NativeAllocator",
         "The off-heap memory allocator. In addition to caches, this property affects storage engine meta data. Supported values:\n"
         "\tNativeAllocator\n"
@@ -580,6 +605,29 @@ db::config::config(std::shared_ptr<db::extensions> exts)
     , request_timeout_in_ms(this, "request_timeout_in_ms", value_status::Used, 10000,
         "The default timeout for other, miscellaneous operations.\n"
         "Related information: About hinted handoff writes")
+    , speculative_retry_per_replica_latency(this, "speculative_retry_per_replica_latency", liveness::LiveUpdate, value_status::Used, false,
+        "Make the 'XXpercentile' speculative_retry of a table wait for the XXth percentile of the recent read latencies of the replicas the read was sent to, "
+        "which this node measures for each replica, rather than for the one of the table as a whole. A slow replica is then waited for longer than a fast one, "
+        "and the extra request is sent only once every contacted replica which didn't reply yet is slower than usual for itself.")
+    , speculative_retry_max_ratio(this, "speculative_retry_max_ratio", liveness::LiveUpdate, value_status::Used, 1.0,
+        "The maximum ratio, between 0 and 1, of the reads which may speculate, that is of the reads of tables with an 'XXpercentile' or 'XXms' speculative_retry, "
+        "which send the extra request. Speculation beyond the ratio is skipped, so that when all replicas are slow, speculative reads don't add too much load. "
+        "1 doesn't limit speculation.")
+    , batch_replica_writes(this, "batch_replica_writes", liveness::LiveUpdate, value_status::Used, true,
+        "Send a replica the mutations of a single write request, such as an unlogged batch, which it is a replica of, in one message rather than in a message each. "
+        "The replica still acknowledges every mutation on its own, so consistency levels are met exactly as without it.")
+    , row_level_read_repair_threshold_in_kb(this, "row_level_read_repair_threshold_in_kb", liveness::LiveUpdate, value_status::Used, 1024,
+        "When the replicas of a single-partition read with a result at least this large disagree, compare the digests of blocks of its rows first, "
+        "and fetch from all but one replica only the blocks which differ, rather than the whole result from every replica. "
+        "This costs an extra round trip to the replicas, but saves most of the traffic when only a few rows of a wide partition differ. 0 disables it.")
+    , multi_partition_read_concurrency(this, "multi_partition_read_concurrency", liveness::LiveUpdate, value_status::Used, 128,
+        "The maximum number of partitions a read of several partitions, like a SELECT with IN on the partition key, reads at a time. "
+        "The results are merged in the order of the partitions, and no more partitions are read once they hold the rows the read is limited to. 0 doesn't limit it.")
+    , paxos_state_cache_size_in_kb(this, "paxos_state_cache_size_in_kb", liveness::LiveUpdate, value_status::Used, 4096,
+        "The memory per shard for caching the paxos states of keys, so that the LWT prepare and accept rounds don't have to read them from system.paxos. 0 disables the cache.")
+    , per_partition_rate_limiter_sketch_size_in_kb(this, "per_partition_rate_limiter_sketch_size_in_kb", value_status::Used, 1024,
+        "The memory per shard for the counters of the count-min sketch per-partition rate limiter, used by the tables whose per_partition_rate_limit algorithm is 'count_min_sketch'. "
+        "The estimated operation rates of partitions exceed their true rates by less for a bigger sketch.")
     /* Inter-node settings */
     , cross_node_timeout(this, "cross_node_timeout", value_status::Unused, false,
         "Enable or disable operation timeout information exchange between nodes (to accurately measure request timeouts). If disabled Cassandra assumes the request was forwarded to the replica instantly by the coordinator.\n"
@@ -600,9 +648,15 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "\n"
         "\tall: All traffic is compressed.\n"
         "\tdc : Traffic between data centers is compressed.\n"
-        "\tnone : No compression.")
+        "\tnone : No compression.\n"
+        "\n"
+        "Acknowledgements of writes, which are too small for compression to pay off, are never compressed.")
     , inter_dc_tcp_nodelay(this, "inter_dc_tcp_nodelay", value_status::Used, false,
         "Enable or disable tcp_nodelay for inter-data center communication. When disabled larger, but fewer, network packets are sent. This reduces overhead from the TCP protocol itself. However, if cross data-center responses are blocked, it will increase latency.")
+    , internode_shard_affine_connections(this, "internode_shard_affine_connections", value_status::Used, false,
+        "Connect to other nodes from source ports which make the connections of a shard land on the shard with the same id on nodes with as many shards. "
+        "In a cluster whose nodes have the same number of shards, a token is owned by the same shard on all nodes, so a request sent from the shard owning its token "
+        "is received by the shard owning it, and isn't forwarded to another shard. The ports are taken from 49152-65535, so they can collide with other connections of the host.")
     , streaming_socket_timeout_in_ms(this, "streaming_socket_timeout_in_ms", value_status::Unused, 0,
         "Enable or disable socket timeout for streaming operations. When a timeout occurs during streaming, streaming is retried from the start of the current file. Avoid setting this value too low, as it can result in a significant amount of data re-streaming.")
     /* Native transport (CQL Binary Protocol) */
@@ -627,6 +681,16 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "Idle threads are stopped after 30 seconds.\n")
     , native_transport_max_frame_size_in_mb(this, "native_transport_max_frame_size_in_mb", value_status::Unused, 256,
         "The maximum size of allowed frame. Frame (requests) larger than this are rejected as invalid.")
+    , native_transport_zstd_compression_level(this, "native_transport_zstd_compression_level", liveness::LiveUpdate, value_status::Used, 1,
+        "The level of the compression of responses to clients which negotiated zstd compression, from -7 (fastest) to 22 (strongest).")
+    , native_transport_compression_min_size(this, "native_transport_compression_min_size", liveness::LiveUpdate, value_status::Used, 256,
+        "Responses to clients which negotiated compression are only compressed if their body is at least this many bytes, since smaller ones gain little from it.")
+    , native_transport_compression_max_ratio(this, "native_transport_compression_max_ratio", liveness::LiveUpdate, value_status::Used, 0.9,
+        "The maximum ratio of the compressed size of the responses on a connection to their uncompressed size. When the responses compressed on a connection exceed it, the next responses on it are sent uncompressed for a while, since what the client reads doesn't compress well.")
+    , native_transport_max_connection_memory_fraction(this, "native_transport_max_connection_memory_fraction", liveness::LiveUpdate, value_status::Used, 0.5,
+        "The fraction of the memory a shard reserves for CQL requests which the in-flight requests of a single connection can hold. "
+        "A connection which reaches it isn't read from until some of its requests complete, so a client flooding large requests doesn't stall the other connections of the shard. "
+        "Applies to connections established after it is changed. 1 disables the limit.")
     /* RPC (remote procedure call) settings */
     /* Settings for configuring and tuning client connections. */
     , broadcast_rpc_address(this, "broadcast_rpc_address", value_status::Used, {/* unset */},
@@ -654,6 +718,9 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "\tYour own RPC server: You must provide a fully-qualified class name of an o.a.c.t.TServerFactory that can create a server instance.")
     , cache_hit_rate_read_balancing(this, "cache_hit_rate_read_balancing", value_status::Used, true,
         "This boolean controls whether the replicas for read query will be choosen based on cache hit ratio")
+    , load_aware_read_balancing(this, "load_aware_read_balancing", liveness::LiveUpdate, value_status::Used, false,
+        "For LOCAL_ONE and LOCAL_QUORUM reads, also take the recent latency of the replicas and the reads in flight to them into account: "
+        "of the replicas chosen for the read and the next one in line, the most loaded one is left out when it is clearly more loaded than the other.")
     /* Advanced fault detection settings */
     /* Settings to handle poorly performing or failing nodes. */
     , dynamic_snitch_badness_threshold(this, "dynamic_snitch_badness_threshold", value_status::Unused, 0,
@@ -672,6 +739,10 @@ db::config::config(std::shared_ptr<db::extensions> exts)
     , max_hint_window_in_ms(this, "max_hint_window_in_ms", value_status::Used, 10800000,
         "Maximum amount of time that hints are generates hints for an unresponsive node. After this interval, new hints are no longer generated until the node is back up and responsive. If the node goes down again, a new interval begins. This setting can prevent a sudden demand for resources when a node is brought back online and the rest of the cluster attempts to replay a large volume of hinted writes.\n"
         "Related information: Failure detection and recovery")
+    , hints_coalescing_window_in_ms(this, "hints_coalescing_window_in_ms", value_status::Used, 0,
+        "Time for which hints are kept in memory before being written, during which hints to the same node for the same partition are merged into one. "
+        "Reduces the size of hints, and the amount of hints to replay, for frequently overwritten partitions. Up to 1MB of hints per node and shard is kept. "
+        "Hints kept in memory are lost on a crash, and are not covered by hint sync points. 0 disables coalescing.")
     , max_hints_delivery_threads(this, "max_hints_delivery_threads", value_status::Invalid, 2,
         "Number of threads with which to deliver hints. In multiple data-center deployments, consider increasing this number because cross data-center handoff is generally slower.")
     , batchlog_replay_throttle_in_kb(this, "batchlog_replay_throttle_in_kb", value_status::Unused, 1024,
@@ -723,6 +794,8 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "The role-management backend, used to maintain grantts and memberships between roles.\n"
         "The available role-managers are:\n"
         "\tCassandraRoleManager : Stores role data in the system_auth keyspace.")
+    , credentials_validity_in_ms(this, "credentials_validity_in_ms", liveness::LiveUpdate, value_status::Used, 2000,
+        "How long a successful password check of PasswordAuthenticator is remembered, so that clients logging in again with the same credentials within it skip the expensive password hashing. Changing the password of a role invalidates its remembered credentials. The remembered credentials are disabled when this property is set to 0.")
     , permissions_validity_in_ms(this, "permissions_validity_in_ms", liveness::LiveUpdate, value_status::Used, 10000,
         "How long permissions in cache remain valid. Depending on the authorizer, such as CassandraAuthorizer, fetching permissions can be resource intensive. Permissions caching is disabled when this property is set to 0 or when AllowAllAuthorizer is used. The cached value is considered valid as long as both its value is not older than the permissions_validity_in_ms "
         "and the cached value has been read at least once during the permissions_validity_in_ms time frame. If any of these two conditions doesn't hold the cached value is going to be evicted from the cache.\n"
@@ -776,6 +849,11 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "The SSL port for encrypted communication. Unused unless enabled in encryption_options.")
     , enable_in_memory_data_store(this, "enable_in_memory_data_store", value_status::Used, false, "Enable in memory mode (system tables are always persisted)")
     , enable_cache(this, "enable_cache", value_status::Used, true, "Enable cache")
+    , enable_cache_admission_filter(this, "enable_cache_admission_filter", value_status::Used, false, "Keep partitions read by range scans out of the cache,"
+        " unless they are estimated to be accessed more often than the partitions being evicted. Protects the cached working set from large scans.")
+    , continuous_toppartitions_capacity(this, "continuous_toppartitions_capacity", value_status::Used, 0, "The number of partitions tracked, per shard, by an always-on"
+        " toppartitions sketch of the partitions read and written, in all tables. The results are available through the REST API and the hottest partition's"
+        " count is exported as a metric. 0 disables the tracking.")
     , enable_commitlog(this, "enable_commitlog", value_status::Used, true, "Enable commitlog")
     , volatile_system_keyspace_for_testing(this, "volatile_system_keyspace_for_testing", value_status::Used, false, "Don't persist system keyspace - testing only!")
     , api_port(this, "api_port", value_status::Used, 10000, "Http Rest API port")
@@ -811,6 +889,10 @@ db::config::config(std::shared_ptr<db::extensions> exts)
     , virtual_dirty_soft_limit(this, "virtual_dirty_soft_limit", value_status::Used, 0.6, "Soft limit of virtual dirty memory expressed as a portion of the hard limit")
     , sstable_summary_ratio(this, "sstable_summary_ratio", value_status::Used, 0.0005, "Enforces that 1 byte of summary is written for every N (2000 by default) "
         "bytes written to data file. Value must be between 0 and 1.")
+    , sstable_summary_sampling_level(this, "sstable_summary_sampling_level", liveness::LiveUpdate, value_status::Used, 128,
+        "Downsample the summaries of the sstables loaded to this sampling level, out of 128, so that they keep about level/128 of their entries. "
+        "Lower levels cap the summary memory on nodes with many sstables, at the cost of reading larger index pages per lookup. "
+        "Applies to the sstables loaded after it is changed. (128: keep summaries at full density)")
     , large_memory_allocation_warning_threshold(this, "large_memory_allocation_warning_threshold", value_status::Used, size_t(1) << 20, "Warn about memory allocations above this size; set to zero to disable")
     , enable_deprecated_partitioners(this, "enable_deprecated_partitioners", value_status::Used, false, "Enable the byteordered and random partitioners. These partitioners are deprecated and will be removed in a future version.")
     , enable_keyspace_column_family_metrics(this, "enable_keyspace_column_family_metrics", value_status::Used, false, "Enable per keyspace and per column family metrics reporting")
@@ -818,8 +900,16 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         " Performance is affected to some extent as a result. Useful to help debugging problems that may arise at another layers.")
     , enable_sstable_key_validation(this, "enable_sstable_key_validation", value_status::Used, ENABLE_SSTABLE_KEY_VALIDATION, "Enable validation of partition and clustering keys monotonicity"
         " Performance is affected to some extent as a result. Useful to help debugging problems that may arise at another layers.")
+    , sstable_key_validation_sampling_ratio(this, "sstable_key_validation_sampling_ratio", value_status::Used, 0.01, "The fraction of partitions, in [0, 1], of which"
+        " the partition and clustering keys monotonicity is validated when writing sstables, when enable_sstable_key_validation is disabled."
+        " The tokens of all partitions are validated regardless.")
+    , enable_split_block_bloom_filter(this, "enable_split_block_bloom_filter", value_status::Used, false, "Write sstable bloom filters which keep all bits of a key in a single cache line, making lookups cheaper"
+        " at the cost of slightly larger filters. Such filters are not understood by older versions, which treat them as matching every key.")
+    , enable_sstable_row_bloom_filter(this, "enable_sstable_row_bloom_filter", value_status::Used, false, "Write a bloom filter on (partition key, clustering key) with sstables, allowing single row reads to skip"
+        " sstables which don't have the row. Not written for sstables with more than a million rows.")
     , cpu_scheduler(this, "cpu_scheduler", value_status::Used, true, "Enable cpu scheduling")
     , view_building(this, "view_building", value_status::Used, true, "Enable view building; should only be set to false when the node is experience issues due to view building")
+    , view_building_concurrency(this, "view_building_concurrency", liveness::LiveUpdate, value_status::Used, 1, "The number of batches of base rows a shard may propagate to the views being built concurrently. Raising it makes view building faster, at the expense of more I/O and CPU taken from other work.")
     , enable_sstables_mc_format(this, "enable_sstables_mc_format", value_status::Unused, true, "Enable SSTables 'mc' format to be used as the default file format.  Deprecated, please use \"sstable_format\" instead.")
     , enable_sstables_md_format(this, "enable_sstables_md_format", value_status::Unused, true, "Enable SSTables 'md' format to be used as the default file format.  Deprecated, please use \"sstable_format\" instead.")
     , sstable_format(this, "sstable_format", value_status::Used, "me", "Default sstable file format", {"mc", "md", "me"})
@@ -856,17 +946,30 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "Time period in seconds after which unused schema versions will be evicted from the local schema registry cache. Default is 1 second.")
     , max_concurrent_requests_per_shard(this, "max_concurrent_requests_per_shard",liveness::LiveUpdate, value_status::Used, std::numeric_limits<uint32_t>::max(),
         "Maximum number of concurrent requests a single shard can handle before it starts shedding extra load. By default, no requests will be shed.")
+    , forward_execute_to_owner_shard(this, "forward_execute_to_owner_shard", liveness::LiveUpdate, value_status::Used, true,
+        "Forward EXECUTE requests received on a shard which doesn't own their partition to the owning shard before processing them, so that drivers which aren't shard-aware don't make every request cross shards while it is executed.")
     , cdc_dont_rewrite_streams(this, "cdc_dont_rewrite_streams", value_status::Used, false,
             "Disable rewriting streams from cdc_streams_descriptions to cdc_streams_descriptions_v2. Should not be necessary, but the procedure is expensive and prone to failures; this config option is left as a backdoor in case some user requires manual intervention.")
+    , cdc_best_effort_preimage_timeout_in_ms(this, "cdc_best_effort_preimage_timeout_in_ms", liveness::LiveUpdate, value_status::Used, 0,
+            "If not 0, the timeout of the reads of the preimages of writes to tables with CDC preimages or postimages, in milliseconds. A write whose preimage read fails, like when it times out under load, succeeds, and its CDC log rows don't have the preimage and postimage. If 0, the preimage read has the timeout of the write, and the write fails if it fails.")
     , strict_allow_filtering(this, "strict_allow_filtering", liveness::LiveUpdate, value_status::Used, strict_allow_filtering_default(), "Match Cassandra in requiring ALLOW FILTERING on slow queries. Can be true, false, or warn. When false, Scylla accepts some slow queries even without ALLOW FILTERING that Cassandra rejects. Warn is same as false, but with warning.")
     , reversed_reads_auto_bypass_cache(this, "reversed_reads_auto_bypass_cache", liveness::LiveUpdate, value_status::Used, false,
             "Bypass in-memory data cache (the row cache) when performing reversed queries.")
     , enable_optimized_reversed_reads(this, "enable_optimized_reversed_reads", liveness::LiveUpdate, value_status::Used, true,
             "Use a new optimized algorithm for performing reversed reads.")
+    , memtable_flush_split_size_in_mb(this, "memtable_flush_split_size_in_mb", liveness::LiveUpdate, value_status::Used, 0,
+            "Flush memtables into sstables of about this size, each covering a distinct token range. "
+            "The sstables are written and sealed in a pipeline. (0: flush each memtable into a single sstable)")
+    , cache_update_min_reads_per_write(this, "cache_update_min_reads_per_write", liveness::LiveUpdate, value_status::Used, 0,
+            "Merge a flushed memtable into the row cache only if the table was read at least this many times per write since the previous flush, "
+            "and otherwise invalidate the flushed ranges in the cache, sparing write-mostly tables the merge. (0: always merge)")
     , enable_cql_config_updates(this, "enable_cql_config_updates", liveness::LiveUpdate, value_status::Used, true,
             "Make the system.config table UPDATEable")
     , enable_parallelized_aggregation(this, "enable_parallelized_aggregation", liveness::LiveUpdate, value_status::Used, true,
             "Use on a new, parallel algorithm for performing aggregate queries.")
+    , enable_unprepared_statement_cache(this, "enable_unprepared_statement_cache", liveness::LiveUpdate, value_status::Used, true,
+            "Keep the statements of QUERY requests which read or write data prepared, in a cache apart from the one of the prepared statements, "
+            "so that clients sending the same unprepared query strings over and over don't have them parsed and prepared every time.")
     , alternator_port(this, "alternator_port", value_status::Used, 0, "Alternator API port")
     , alternator_https_port(this, "alternator_https_port", value_status::Used, 0, "Alternator API HTTPS port")
     , alternator_address(this, "alternator_address", value_status::Used, "0.0.0.0", "Alternator API listening address")
@@ -878,6 +981,8 @@ db::config::config(std::shared_ptr<db::extensions> exts)
     , alternator_ttl_period_in_seconds(this, "alternator_ttl_period_in_seconds", value_status::Used,
         60*60*24,
         "The default period for Alternator's expiration scan. Alternator attempts to scan every table within that period.")
+    , alternator_ttl_max_deletions_per_second(this, "alternator_ttl_max_deletions_per_second", liveness::LiveUpdate, value_status::Used, 0,
+        "The maximum number of expired items Alternator's expiration scan deletes per second on each shard, or 0 for no limit. The deletions not done at that rate are delayed, not skipped.")
     , abort_on_ebadf(this, "abort_on_ebadf", value_status::Used, true, "Abort the server on incorrect file descriptor access. Throws exception when disabled.")
     , redis_port(this, "redis_port", value_status::Used, 0, "Port on which the REDIS transport listens for clients.")
     , redis_ssl_port(this, "redis_ssl_port", value_status::Used, 0, "Port on which the REDIS TLS native transport listens for clients.")
@@ -907,6 +1012,11 @@ db::config::config(std::shared_ptr<db::extensions> exts)
     , task_ttl_seconds(this, "task_ttl_in_seconds", liveness::LiveUpdate, value_status::Used, 10, "Time for which information about finished task stays in memory.")
     , cache_index_pages(this, "cache_index_pages", liveness::LiveUpdate, value_status::Used, true,
         "Keep SSTable index pages in the global cache after a SSTable read. Expected to improve performance for workloads with big partitions, but may degrade performance for workloads with small partitions.")
+    , secondary_page_cache_directory(this, "secondary_page_cache_directory", value_status::Used, "",
+        "A directory on a fast local device (e.g. ephemeral NVMe) where SSTable index pages evicted from memory are kept, and read from"
+        " before going to the data disks. Contents are discarded on restart. Disabled if empty.")
+    , secondary_page_cache_size_in_mb(this, "secondary_page_cache_size_in_mb", value_status::Used, 1024,
+        "The size of the secondary page cache, split evenly between shards.")
     , default_log_level(this, "default_log_level", value_status::Used)
     , logger_log_level(this, "logger_log_level", value_status::Used)
     , log_to_stdout(this, "log_to_stdout", value_status::Used)
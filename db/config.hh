@@ -140,7 +140,14 @@ class config : public utils::config_file {
     named_value<bool> auto_adjust_flush_quota;
     named_value<float> memtable_flush_static_shares;
     named_value<float> compaction_static_shares;
+    named_value<uint32_t> compaction_controller_lookahead_in_ms;
+    named_value<uint32_t> maintenance_latency_target_in_ms;
+    named_value<float> maintenance_min_shares;
+    named_value<float> maintenance_max_shares;
+    named_value<uint32_t> counter_update_coalescing_window_in_us;
+    named_value<uint32_t> coordinator_counter_update_coalescing_window_in_us;
     named_value<bool> compaction_enforce_min_threshold;
+    named_value<uint32_t> major_compaction_parallelism;
     named_value<sstring> cluster_name;
     named_value<sstring> listen_address;
     named_value<sstring> listen_interface;
@@ -175,11 +182,15 @@ class config : public utils::config_file {
     named_value<uint32_t> commitlog_segment_size_in_mb;
     named_value<uint32_t> commitlog_sync_period_in_ms;
     named_value<uint32_t> commitlog_sync_batch_window_in_ms;
+    named_value<uint32_t> commitlog_sync_batch_max_delay_in_us;
     named_value<int64_t> commitlog_total_space_in_mb;
     named_value<bool> commitlog_reuse_segments; // unused. retained for upgrade compat
     named_value<int64_t> commitlog_flush_threshold_in_mb;
     named_value<bool> commitlog_use_o_dsync;
     named_value<bool> commitlog_use_hard_size_limit;
+    named_value<bool> commitlog_compression;
+    named_value<string_list> commitlog_segregated_keyspaces;
+    named_value<sstring> commitlog_segregated_sync;
     named_value<bool> compaction_preheat_key_cache;
     named_value<uint32_t> concurrent_compactors;
     named_value<uint32_t> in_memory_compaction_limit_in_mb;
@@ -234,11 +245,19 @@ class config : public utils::config_file {
     named_value<uint32_t> truncate_request_timeout_in_ms;
     named_value<uint32_t> write_request_timeout_in_ms;
     named_value<uint32_t> request_timeout_in_ms;
+    named_value<bool> speculative_retry_per_replica_latency;
+    named_value<double> speculative_retry_max_ratio;
+    named_value<bool> batch_replica_writes;
+    named_value<uint32_t> row_level_read_repair_threshold_in_kb;
+    named_value<uint32_t> multi_partition_read_concurrency;
+    named_value<uint32_t> paxos_state_cache_size_in_kb;
+    named_value<uint32_t> per_partition_rate_limiter_sketch_size_in_kb;
     named_value<bool> cross_node_timeout;
     named_value<uint32_t> internode_send_buff_size_in_bytes;
     named_value<uint32_t> internode_recv_buff_size_in_bytes;
     named_value<sstring> internode_compression;
     named_value<bool> inter_dc_tcp_nodelay;
+    named_value<bool> internode_shard_affine_connections;
     named_value<uint32_t> streaming_socket_timeout_in_ms;
     named_value<bool> start_native_transport;
     named_value<uint16_t> native_transport_port;
@@ -247,6 +266,10 @@ class config : public utils::config_file {
     named_value<uint16_t> native_shard_aware_transport_port_ssl;
     named_value<uint32_t> native_transport_max_threads;
     named_value<uint32_t> native_transport_max_frame_size_in_mb;
+    named_value<int> native_transport_zstd_compression_level;
+    named_value<uint32_t> native_transport_compression_min_size;
+    named_value<double> native_transport_compression_max_ratio;
+    named_value<double> native_transport_max_connection_memory_fraction;
     named_value<sstring> broadcast_rpc_address;
     named_value<uint16_t> rpc_port;
     named_value<bool> start_rpc;
@@ -257,6 +280,7 @@ class config : public utils::config_file {
     named_value<uint32_t> rpc_send_buff_size_in_bytes;
     named_value<sstring> rpc_server_type;
     named_value<bool> cache_hit_rate_read_balancing;
+    named_value<bool> load_aware_read_balancing;
     named_value<double> dynamic_snitch_badness_threshold;
     named_value<uint32_t> dynamic_snitch_reset_interval_in_ms;
     named_value<uint32_t> dynamic_snitch_update_interval_in_ms;
@@ -264,6 +288,7 @@ class config : public utils::config_file {
     named_value<uint32_t> max_hinted_handoff_concurrency;
     named_value<uint32_t> hinted_handoff_throttle_in_kb;
     named_value<uint32_t> max_hint_window_in_ms;
+    named_value<uint32_t> hints_coalescing_window_in_ms;
     named_value<uint32_t> max_hints_delivery_threads;
     named_value<uint32_t> batchlog_replay_throttle_in_kb;
     named_value<sstring> request_scheduler;
@@ -275,6 +300,7 @@ class config : public utils::config_file {
     named_value<sstring> internode_authenticator;
     named_value<sstring> authorizer;
     named_value<sstring> role_manager;
+    named_value<uint32_t> credentials_validity_in_ms;
     named_value<uint32_t> permissions_validity_in_ms;
     named_value<uint32_t> permissions_update_interval_in_ms;
     named_value<uint32_t> permissions_cache_max_entries;
@@ -284,6 +310,8 @@ class config : public utils::config_file {
     named_value<uint32_t> ssl_storage_port;
     named_value<bool> enable_in_memory_data_store;
     named_value<bool> enable_cache;
+    named_value<bool> enable_cache_admission_filter;
+    named_value<uint32_t> continuous_toppartitions_capacity;
     named_value<bool> enable_commitlog;
     named_value<bool> volatile_system_keyspace_for_testing;
     named_value<uint16_t> api_port;
@@ -318,13 +346,18 @@ class config : public utils::config_file {
     named_value<unsigned> murmur3_partitioner_ignore_msb_bits;
     named_value<double> virtual_dirty_soft_limit;
     named_value<double> sstable_summary_ratio;
+    named_value<uint32_t> sstable_summary_sampling_level;
     named_value<size_t> large_memory_allocation_warning_threshold;
     named_value<bool> enable_deprecated_partitioners;
     named_value<bool> enable_keyspace_column_family_metrics;
     named_value<bool> enable_sstable_data_integrity_check;
     named_value<bool> enable_sstable_key_validation;
+    named_value<double> sstable_key_validation_sampling_ratio;
+    named_value<bool> enable_split_block_bloom_filter;
+    named_value<bool> enable_sstable_row_bloom_filter;
     named_value<bool> cpu_scheduler;
     named_value<bool> view_building;
+    named_value<uint32_t> view_building_concurrency;
     named_value<bool> enable_sstables_mc_format;
     named_value<bool> enable_sstables_md_format;
     named_value<sstring> sstable_format;
@@ -345,12 +378,17 @@ class config : public utils::config_file {
     named_value<unsigned> user_defined_function_contiguous_allocation_limit_bytes;
     named_value<uint32_t> schema_registry_grace_period;
     named_value<uint32_t> max_concurrent_requests_per_shard;
+    named_value<bool> forward_execute_to_owner_shard;
     named_value<bool> cdc_dont_rewrite_streams;
+    named_value<uint32_t> cdc_best_effort_preimage_timeout_in_ms;
     named_value<tri_mode_restriction> strict_allow_filtering;
     named_value<bool> reversed_reads_auto_bypass_cache;
     named_value<bool> enable_optimized_reversed_reads;
+    named_value<uint32_t> memtable_flush_split_size_in_mb;
+    named_value<double> cache_update_min_reads_per_write;
     named_value<bool> enable_cql_config_updates;
     named_value<bool> enable_parallelized_aggregation;
+    named_value<bool> enable_unprepared_statement_cache;
 
     named_value<uint16_t> alternator_port;
     named_value<uint16_t> alternator_https_port;
@@ -360,6 +398,7 @@ class config : public utils::config_file {
     named_value<uint32_t> alternator_streams_time_window_s;
     named_value<uint32_t> alternator_timeout_in_ms;
     named_value<double> alternator_ttl_period_in_seconds;
+    named_value<uint32_t> alternator_ttl_max_deletions_per_second;
 
     named_value<bool> abort_on_ebadf;
 
@@ -386,6 +425,8 @@ class config : public utils::config_file {
     named_value<uint32_t> task_ttl_seconds;
 
     named_value<bool> cache_index_pages;
+    named_value<sstring> secondary_page_cache_directory;
+    named_value<uint64_t> secondary_page_cache_size_in_mb;
 
     seastar::logging_settings logging_settings(const log_cli::options&) const;
 
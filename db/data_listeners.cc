@@ -52,7 +52,8 @@ toppartitions_item_key::operator sstring() const {
 }
 
 toppartitions_data_listener::toppartitions_data_listener(replica::database& db, std::unordered_set<std::tuple<sstring, sstring>, utils::tuple_hash> table_filters,
-        std::unordered_set<sstring> keyspace_filters) : _db(db), _table_filters(std::move(table_filters)), _keyspace_filters(std::move(keyspace_filters)) {
+        std::unordered_set<sstring> keyspace_filters, size_t capacity)
+        : _db(db), _table_filters(std::move(table_filters)), _keyspace_filters(std::move(keyspace_filters)), _top_k_read(capacity), _top_k_write(capacity) {
     dblog.debug("toppartitions_data_listener: installing {}", fmt::ptr(this));
     _db.data_listeners().install(this);
 }
@@ -128,21 +129,28 @@ future<> toppartitions_query::scatter() {
 
 using top_t = toppartitions_data_listener::global_top_k::results;
 
+static foreign_ptr<std::unique_ptr<std::tuple<top_t, top_t>>> globalize_top(toppartitions_data_listener& listener, unsigned res_size) {
+    top_t rd = toppartitions_data_listener::globalize(listener.top_reads().top(res_size));
+    top_t wr = toppartitions_data_listener::globalize(listener.top_writes().top(res_size));
+    return make_foreign(std::make_unique<std::tuple<top_t, top_t>>(std::move(rd), std::move(wr)));
+}
+
+static toppartitions_query::results reduce_top(toppartitions_query::results res, foreign_ptr<std::unique_ptr<std::tuple<top_t, top_t>>> rd_wr) {
+    if (rd_wr) {
+        res.read.append(toppartitions_data_listener::localize(std::get<0>(*rd_wr)));
+        res.write.append(toppartitions_data_listener::localize(std::get<1>(*rd_wr)));
+    }
+    return res;
+}
+
 future<toppartitions_query::results> toppartitions_query::gather(unsigned res_size) {
     dblog.debug("toppartitions_query::gather");
 
-    auto map = [res_size, this] (toppartitions_data_listener& listener) {
+    auto map = [res_size] (toppartitions_data_listener& listener) {
         dblog.trace("toppartitions_query::map_reduce with listener {}", fmt::ptr(&listener));
-        top_t rd = toppartitions_data_listener::globalize(listener._top_k_read.top(res_size));
-        top_t wr = toppartitions_data_listener::globalize(listener._top_k_write.top(res_size));
-        return make_foreign(std::make_unique<std::tuple<top_t, top_t>>(std::move(rd), std::move(wr)));
+        return globalize_top(listener, res_size);
     };
-    auto reduce = [this] (results res, foreign_ptr<std::unique_ptr<std::tuple<top_t, top_t>>> rd_wr) {
-        res.read.append(toppartitions_data_listener::localize(std::get<0>(*rd_wr)));
-        res.write.append(toppartitions_data_listener::localize(std::get<1>(*rd_wr)));
-        return res;
-    };
-    return _query->map_reduce0(map, results{res_size}, reduce)
+    return _query->map_reduce0(map, results{res_size}, reduce_top)
         .handle_exception([] (auto ep) {
             dblog.error("toppartitions_query::gather: {}", ep);
             return make_exception_future<results>(ep);
@@ -154,4 +162,12 @@ future<toppartitions_query::results> toppartitions_query::gather(unsigned res_si
         });
 }
 
+future<toppartitions_query::results> toppartitions_query::gather_continuous(distributed<replica::database>& xdb, unsigned res_size) {
+    auto map = [res_size] (replica::database& db) {
+        auto* listener = db.continuous_toppartitions();
+        return listener ? globalize_top(*listener, res_size) : foreign_ptr<std::unique_ptr<std::tuple<top_t, top_t>>>();
+    };
+    return xdb.map_reduce0(map, results{res_size}, reduce_top);
+}
+
 } // namespace db
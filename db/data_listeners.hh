@@ -127,9 +127,13 @@ class toppartitions_data_listener : public data_listener, public weakly_referenc
     top_k _top_k_write;
 
 public:
-    toppartitions_data_listener(replica::database& db, std::unordered_set<std::tuple<sstring, sstring>, utils::tuple_hash> table_filters, std::unordered_set<sstring> keyspace_filters);
+    toppartitions_data_listener(replica::database& db, std::unordered_set<std::tuple<sstring, sstring>, utils::tuple_hash> table_filters, std::unordered_set<sstring> keyspace_filters,
+            size_t capacity = 256);
     ~toppartitions_data_listener();
 
+    top_k& top_reads() { return _top_k_read; }
+    top_k& top_writes() { return _top_k_write; }
+
     virtual flat_mutation_reader_v2 on_read(const schema_ptr& s, const dht::partition_range& range,
             const query::partition_slice& slice, flat_mutation_reader_v2&& rd) override;
 
@@ -164,6 +168,9 @@ class toppartitions_query {
 
     future<> scatter();
     future<results> gather(unsigned results_size = 256);
+
+    // Merges the sketches of the always-on tracking, see replica::database::continuous_toppartitions().
+    static future<results> gather_continuous(distributed<replica::database>& xdb, unsigned results_size = 256);
 };
 
 } // namespace db
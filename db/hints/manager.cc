@@ -83,6 +83,9 @@ void manager::register_metrics(const sstring& group_name) {
         sm::make_counter("corrupted_files", _stats.corrupted_files,
                         sm::description("Number of hints files that were discarded during sending because the file was corrupted.")),
 
+        sm::make_counter("coalesced", _stats.coalesced,
+                        sm::description("Number of hints that were merged into a hint for the same partition before being written.")),
+
         sm::make_gauge("pending_drains", 
                         sm::description("Number of tasks waiting in the queue for draining hints"),
                         [this] { return _drain_lock.waiters(); }),
@@ -216,6 +219,63 @@ future<> manager::wait_for_sync_point(abort_source& as, const sync_point::shard_
 }
 
 bool manager::end_point_hints_manager::store_hint(schema_ptr s, lw_shared_ptr<const frozen_mutation> fm, tracing::trace_state_ptr tr_state) noexcept {
+    auto window = std::chrono::milliseconds(_shard_manager.local_db().get_config().hints_coalescing_window_in_ms());
+    if (window.count() == 0 || stopping()) {
+        return write_hint(std::move(s), std::move(fm), std::move(tr_state));
+    }
+    try {
+        coalesce_hint(s, *fm, tr_state, window);
+    } catch (...) {
+        manager_logger.trace("Failed to store a hint to {}: {}", end_point_key(), std::current_exception());
+        tracing::trace(tr_state, "Failed to store a hint to {}: {}", end_point_key(), std::current_exception());
+
+        ++shard_stats().dropped;
+        return false;
+    }
+    return true;
+}
+
+void manager::end_point_hints_manager::coalesce_hint(schema_ptr s, const frozen_mutation& fm, tracing::trace_state_ptr tr_state, std::chrono::milliseconds window) {
+    auto size = fm.representation().size();
+    if (_coalesced_hints_size + size > max_coalesced_hints_size) {
+        write_coalesced_hints();
+    }
+    auto key = std::make_pair(s->version(), to_bytes(fm.key().representation()));
+    auto it = _coalesced_hints.find(key);
+    if (it != _coalesced_hints.end()) {
+        it->second.m.apply(fm.unfreeze(s));
+        ++shard_stats().coalesced;
+        tracing::trace(tr_state, "Hint to {} was merged with a pending one", end_point_key());
+    } else {
+        _coalesced_hints.emplace(std::move(key), coalesced_hint{s, fm.unfreeze(s), std::move(tr_state)});
+    }
+    // The sizes of the merged hints bound the size of the merged one.
+    _coalesced_hints_size += size;
+    shard_stats().size_of_hints_in_progress += size;
+    if (!_coalescing_timer.armed()) {
+        _coalescing_timer.arm(window);
+    }
+}
+
+void manager::end_point_hints_manager::write_coalesced_hints() noexcept {
+    _coalescing_timer.cancel();
+    shard_stats().size_of_hints_in_progress -= _coalesced_hints_size;
+    _coalesced_hints_size = 0;
+    auto hints = std::exchange(_coalesced_hints, {});
+    for (auto& [key, h] : hints) {
+        lw_shared_ptr<const frozen_mutation> fm;
+        try {
+            fm = make_lw_shared<const frozen_mutation>(freeze(h.m));
+        } catch (...) {
+            manager_logger.trace("Failed to store a hint to {}: {}", end_point_key(), std::current_exception());
+            ++shard_stats().dropped;
+            continue;
+        }
+        write_hint(std::move(h.s), std::move(fm), std::move(h.tr_state));
+    }
+}
+
+bool manager::end_point_hints_manager::write_hint(schema_ptr s, lw_shared_ptr<const frozen_mutation> fm, tracing::trace_state_ptr tr_state) noexcept {
     try {
         // Future is waited on indirectly in `stop()` (via `_store_gate`).
         (void)with_gate(_store_gate, [this, s = std::move(s), fm = std::move(fm), tr_state] () mutable {
@@ -281,6 +341,7 @@ future<> manager::end_point_hints_manager::stop(drain should_drain) noexcept {
         // This is going to prevent further storing of new hints and will break all sending in progress.
         set_stopping();
 
+        write_coalesced_hints();
         _store_gate.close().handle_exception([&eptr] (auto e) { eptr = std::move(e); }).get();
         _sender.stop(should_drain).handle_exception([&eptr] (auto e) { eptr = std::move(e); }).get();
 
@@ -313,6 +374,7 @@ manager::end_point_hints_manager::end_point_hints_manager(const key_type& key, m
     // TODO: Should this logic be deduplicated with what is in the commitlog?
     , _last_written_rp(this_shard_id(), std::chrono::duration_cast<std::chrono::milliseconds>(runtime::get_boot_time().time_since_epoch()).count())
     , _sender(*this, _shard_manager.local_storage_proxy(), _shard_manager.local_db(), _shard_manager.local_gossiper())
+    , _coalescing_timer([this] { write_coalesced_hints(); })
 {}
 
 manager::end_point_hints_manager::end_point_hints_manager(end_point_hints_manager&& other)
@@ -324,7 +386,10 @@ manager::end_point_hints_manager::end_point_hints_manager(end_point_hints_manage
     , _hints_dir(std::move(other._hints_dir))
     , _last_written_rp(other._last_written_rp)
     , _sender(other._sender, *this)
-{}
+    , _coalescing_timer([this] { write_coalesced_hints(); })
+{
+    assert(other._coalesced_hints.empty());
+}
 
 manager::end_point_hints_manager::~end_point_hints_manager() {
     assert(stopped());
@@ -855,8 +920,35 @@ future<> manager::end_point_hints_manager::sender::send_one_mutation(frozen_muta
     return do_send_one_mutation(std::move(m), natural_endpoints);
 }
 
+void manager::end_point_hints_manager::sender::on_send_window_success() noexcept {
+    if (_send_window < max_send_window && ++_send_window_successes >= _send_window) {
+        _send_window_successes = 0;
+        ++_send_window;
+        _send_window_sem.signal();
+    }
+}
+
+void manager::end_point_hints_manager::sender::on_send_window_failure() noexcept {
+    // The hints in flight when the receiver got overloaded tend to fail together,
+    // count them as one failure.
+    auto now = clock::now();
+    if (now < _send_window_shrink_tp + std::chrono::seconds(1)) {
+        return;
+    }
+    _send_window_shrink_tp = now;
+    auto shrink = _send_window / 2;
+    _send_window -= shrink;
+    _send_window_successes = 0;
+    _send_window_sem.consume(shrink);
+    manager_logger.trace("send window of {} shrunk to {}", end_point_key(), _send_window);
+}
+
 future<> manager::end_point_hints_manager::sender::send_one_hint(lw_shared_ptr<send_one_file_ctx> ctx_ptr, fragmented_temporary_buffer buf, db::replay_position rp, gc_clock::duration secs_since_file_mod, const sstring& fname) {
-    return _resource_manager.get_send_units_for(buf.size_bytes()).then([this, secs_since_file_mod, &fname, buf = std::move(buf), rp, ctx_ptr] (auto units) mutable {
+    return get_units(_send_window_sem, 1).then([this, size = buf.size_bytes()] (semaphore_units<> window_units) {
+        return _resource_manager.get_send_units_for(size).then([window_units = std::move(window_units)] (auto units) mutable {
+            return std::make_tuple(std::move(window_units), std::move(units));
+        });
+    }).then_unpack([this, secs_since_file_mod, &fname, buf = std::move(buf), rp, ctx_ptr] (auto window_units, auto units) mutable {
         ctx_ptr->mark_hint_as_in_progress(rp);
 
         // Future is waited on indirectly in `send_one_file()` (via `ctx_ptr->file_send_gate`).
@@ -896,10 +988,11 @@ future<> manager::end_point_hints_manager::sender::send_one_hint(lw_shared_ptr<s
                 return make_exception_future<>(std::move(eptr));
             }
             return make_ready_future<>();
-        }).then_wrapped([this, units = std::move(units), rp, ctx_ptr] (future<>&& f) {
+        }).then_wrapped([this, window_units = std::move(window_units), units = std::move(units), rp, ctx_ptr] (future<>&& f) {
             // Information about the error was already printed somewhere higher.
             // We just need to account in the ctx that sending of this hint has failed.
             if (!f.failed()) {
+                on_send_window_success();
                 ctx_ptr->on_hint_send_success(rp);
                 auto new_bound = ctx_ptr->get_replayed_bound();
                 // Segments from other shards are replayed first and are considered to be "before" replay position 0.
@@ -909,6 +1002,7 @@ future<> manager::end_point_hints_manager::sender::send_one_hint(lw_shared_ptr<s
                     notify_replay_waiters();
                 }
             } else {
+                on_send_window_failure();
                 ctx_ptr->on_hint_send_failure(rp);
             }
             f.ignore_ready_future();
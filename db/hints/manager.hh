@@ -22,6 +22,8 @@
 #include <seastar/core/shared_mutex.hh>
 #include <seastar/core/abort_source.hh>
 #include "inet_address_vectors.hh"
+#include "mutation.hh"
+#include "utils/hash.hh"
 #include "db/commitlog/commitlog.hh"
 #include "utils/loading_shared_values.hh"
 #include "db/hints/resource_manager.hh"
@@ -75,6 +77,7 @@ class manager {
         uint64_t sent = 0;
         uint64_t discarded = 0;
         uint64_t corrupted_files = 0;
+        uint64_t coalesced = 0;
     };
 
     // map: shard -> segments
@@ -151,6 +154,20 @@ class manager {
 
             std::multimap<db::replay_position, lw_shared_ptr<std::optional<promise<>>>> _replay_waiters;
 
+            // Limits the hints being sent at a time to the end point, on top of
+            // the memory limit of the resource manager. Grows by one after a
+            // window's worth of hints were sent successfully, and is halved on a
+            // failure, so that an overloaded receiver sees fewer hints in flight.
+            static constexpr size_t initial_send_window = 64;
+            static constexpr size_t max_send_window = 1024;
+            size_t _send_window = initial_send_window;
+            size_t _send_window_successes = 0;
+            clock::time_point _send_window_shrink_tp = clock::time_point::min();
+            seastar::semaphore _send_window_sem{initial_send_window};
+
+            void on_send_window_success() noexcept;
+            void on_send_window_failure() noexcept;
+
         public:
             sender(end_point_hints_manager& parent, service::storage_proxy& local_storage_proxy, replica::database& local_db, gms::gossiper& local_gossiper) noexcept;
             ~sender();
@@ -338,6 +355,23 @@ class manager {
         db::replay_position _last_written_rp;
         sender _sender;
 
+        // Hints kept for hints_coalescing_window_in_ms before being written,
+        // merged per schema version and partition.
+        struct coalesced_hint {
+            schema_ptr s;
+            mutation m;
+            tracing::trace_state_ptr tr_state;
+        };
+        static constexpr size_t max_coalesced_hints_size = 1024 * 1024;
+        std::unordered_map<std::pair<table_schema_version, bytes>, coalesced_hint, utils::tuple_hash> _coalesced_hints;
+        // Sum of the sizes of the hints merged into _coalesced_hints.
+        size_t _coalesced_hints_size = 0;
+        timer<lowres_clock> _coalescing_timer;
+
+        bool write_hint(schema_ptr s, lw_shared_ptr<const frozen_mutation> fm, tracing::trace_state_ptr tr_state) noexcept;
+        void coalesce_hint(schema_ptr s, const frozen_mutation& fm, tracing::trace_state_ptr tr_state, std::chrono::milliseconds window);
+        void write_coalesced_hints() noexcept;
+
     public:
         end_point_hints_manager(const key_type& key, manager& shard_manager);
         end_point_hints_manager(end_point_hints_manager&&);
@@ -17,6 +17,10 @@ namespace db {
 
 const char* per_partition_rate_limit_options::max_writes_per_second_key = "max_writes_per_second";
 const char* per_partition_rate_limit_options::max_reads_per_second_key = "max_reads_per_second";
+const char* per_partition_rate_limit_options::algorithm_key = "algorithm";
+
+static const char* hash_table_algorithm_name = "hash_table";
+static const char* count_min_sketch_algorithm_name = "count_min_sketch";
 
 per_partition_rate_limit_options::per_partition_rate_limit_options(std::map<sstring, sstring> map) {
     auto handle_uint32_arg = [&] (const char* key) -> std::optional<uint32_t> {
@@ -42,6 +46,19 @@ per_partition_rate_limit_options::per_partition_rate_limit_options(std::map<sstr
     _max_writes_per_second = handle_uint32_arg(max_writes_per_second_key);
     _max_reads_per_second = handle_uint32_arg(max_reads_per_second_key);
 
+    if (auto it = map.find(algorithm_key); it != map.end()) {
+        if (it->second == hash_table_algorithm_name) {
+            _algorithm = algorithm::hash_table;
+        } else if (it->second == count_min_sketch_algorithm_name) {
+            _algorithm = algorithm::count_min_sketch;
+        } else {
+            throw exceptions::configuration_exception(format(
+                    "Invalid value for {} option: expected {} or {}",
+                    algorithm_key, hash_table_algorithm_name, count_min_sketch_algorithm_name));
+        }
+        map.erase(it);
+    }
+
     if (!map.empty()) {
         throw exceptions::configuration_exception(format(
                 "Unknown keys in map for per_partition_rate_limit extension: {}",
@@ -57,6 +74,11 @@ std::map<sstring, sstring> per_partition_rate_limit_options::to_map() const {
     if (_max_reads_per_second) {
         ret.insert_or_assign(max_reads_per_second_key, std::to_string(*_max_reads_per_second));
     }
+    // The default is left out, so the options stay readable by nodes which
+    // don't know the key.
+    if (_algorithm == algorithm::count_min_sketch) {
+        ret.insert_or_assign(algorithm_key, count_min_sketch_algorithm_name);
+    }
     return ret;
 }
 
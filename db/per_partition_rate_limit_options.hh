@@ -20,13 +20,24 @@ using namespace seastar;
 namespace db {
 
 class per_partition_rate_limit_options final {
+public:
+    // The data structure the operations are counted in.
+    enum class algorithm {
+        // A hash table of exact counters, with lossy counting.
+        hash_table,
+        // A count-min sketch of approximate counters.
+        count_min_sketch,
+    };
+
 private:
     static const char* max_writes_per_second_key;
     static const char* max_reads_per_second_key;
+    static const char* algorithm_key;
 
 private:
     std::optional<uint32_t> _max_writes_per_second;
     std::optional<uint32_t> _max_reads_per_second;
+    algorithm _algorithm = algorithm::hash_table;
 
 public:
     per_partition_rate_limit_options() = default;
@@ -58,6 +69,14 @@ class per_partition_rate_limit_options final {
     inline std::optional<uint32_t> get_max_reads_per_second() const {
         return _max_reads_per_second;
     }
+
+    inline void set_algorithm(algorithm v) {
+        _algorithm = v;
+    }
+
+    inline algorithm get_algorithm() const {
+        return _algorithm;
+    }
 };
 
 }
@@ -6,6 +6,7 @@
  * SPDX-License-Identifier: AGPL-3.0-or-later
  */
 
+#include <algorithm>
 #include <cmath>
 #include <numbers>
 #include <array>
@@ -230,13 +231,18 @@ rate_limiter_base::rate_limiter_base()
     register_metrics();
 }
 
-uint64_t rate_limiter_base::increase_and_get_counter(label& l, uint64_t token) noexcept {
+uint32_t rate_limiter_base::label::get() noexcept {
+    static thread_local uint32_t next_label = 1;
+
     // Assign a label if not done yet
-    if (l._label == 0) {
-        l._label = _next_label++;
+    if (_label == 0) {
+        _label = next_label++;
     }
+    return _label;
+}
 
-    entry* b = get_entry(l._label, token);
+uint64_t rate_limiter_base::increase_and_get_counter(label& l, uint64_t token) noexcept {
+    entry* b = get_entry(l.get(), token);
     if (!b) {
         // We failed to allocate a entry for this partition. This means that
         // we won't track hit count for this partition during this time window.
@@ -269,7 +275,11 @@ rate_limiter_base::can_proceed rate_limiter_base::account_operation(
     }
 
     const uint64_t count = increase_and_get_counter(l, token);
+    return admit(count, limit, rate_limit_info);
+}
 
+rate_limiter_base::can_proceed rate_limiter_base::admit(uint64_t count, uint64_t limit,
+        const db::per_partition_rate_limit::info& rate_limit_info) noexcept {
     if (auto* info = std::get_if<db::per_partition_rate_limit::account_and_enforce>(&rate_limit_info)) {
         // On each time window change we halve the entry counts, therefore
         // a partition with X ops/s will stabilize at 2X hits at the end
@@ -300,6 +310,116 @@ rate_limiter_base::can_proceed rate_limiter_base::account_operation(
     }
 }
 
+// The count-min sketch keeps `depth` rows of counters, and every (label, token)
+// is hashed to one counter in each row. An operation's count is estimated by
+// the minimum of its counters, which collisions can only make too high.
+// With conservative update, an operation only increases the counters which
+// are below the new estimate, which makes the overestimates much smaller
+// than the worst-case bound of e * N / width, where N is the sum of all
+// counts.
+//
+// Like in the hash table, the counters are halved on every time window
+// change, so the estimates converge in the same way and the same admission
+// rule applies. There is no lossy counting, as the sketch cannot overflow.
+
+void count_min_rate_limiter_base::on_timer() noexcept {
+    ++_current_time_window;
+    _total /= 2;
+}
+
+count_min_rate_limiter_base::block& count_min_rate_limiter_base::block_refresh(block& b) noexcept {
+    const uint32_t window_delta = _current_time_window - b.time_window;
+    if (window_delta == 0) {
+        return b;
+    }
+    for (auto& c : b.counters) {
+        c = window_delta < 32 ? c >> window_delta : 0;
+    }
+    b.time_window = _current_time_window;
+    return b;
+}
+
+void count_min_rate_limiter_base::register_metrics() {
+    namespace sm = seastar::metrics;
+
+    _metric_group.add_group("per_partition_rate_limiter", {
+        sm::make_counter("sketch_operations", _metrics.operations,
+                sm::description("Number of operations counted by the count-min sketch rate limiter.")),
+
+        sm::make_gauge("sketch_memory_usage", [this] { return memory_usage(); },
+                sm::description("Memory used by the counters of the count-min sketch rate limiter, in bytes.")),
+
+        sm::make_gauge("sketch_error_bound", [this] { return error_bound(); },
+                sm::description("Bound on the overestimate of per-partition operation counts by the count-min sketch rate limiter, "
+                        "which holds with probability 1 - e^-depth.")),
+    });
+}
+
+count_min_rate_limiter_base::count_min_rate_limiter_base(size_t memory_budget)
+        : _salt(std::random_device{}())
+        , _blocks_per_row(std::max<size_t>(memory_budget / (sizeof(block) * depth), 1))
+        , _blocks(_blocks_per_row * depth) {
+
+    register_metrics();
+}
+
+double count_min_rate_limiter_base::error_bound() const noexcept {
+    return std::numbers::e * double(_total) / double(width());
+}
+
+uint64_t count_min_rate_limiter_base::increase_and_get_counter(label& l, uint64_t token) noexcept {
+    const uint32_t label = l.get();
+
+    static constexpr size_t key_length = sizeof(token) + sizeof(label) + sizeof(_salt);
+
+    std::array<uint8_t, key_length> key;
+    uint8_t* ptr = key.data();
+    memcpy(ptr, &token, sizeof(token));
+    ptr += sizeof(token);
+    memcpy(ptr, &label, sizeof(label));
+    ptr += sizeof(label);
+    memcpy(ptr, &_salt, sizeof(_salt));
+
+    std::array<uint64_t, 2> hash;
+    utils::murmur_hash::hash3_x64_128(key.data(), key_length, 0, hash);
+
+    // Derive the index in each row from two hashes (Kirsch-Mitzenmacher),
+    // so a single murmur hash is computed per operation.
+    std::array<uint32_t*, depth> counters;
+    uint32_t min = std::numeric_limits<uint32_t>::max();
+    for (size_t i = 0; i < depth; i++) {
+        const size_t index = (hash[0] + i * hash[1]) % width();
+        block& b = block_refresh(_blocks[i * _blocks_per_row + index / counters_per_block]);
+        counters[i] = &b.counters[index % counters_per_block];
+        min = std::min(min, *counters[i]);
+    }
+
+    // Conservative update: only raise the counters to the new estimate.
+    // Protect from wrap-around.
+    const uint32_t count = min == std::numeric_limits<uint32_t>::max() ? min : min + 1;
+    for (uint32_t* c : counters) {
+        *c = std::max(*c, count);
+    }
+
+    ++_total;
+    ++_metrics.operations;
+    return count;
+}
+
+count_min_rate_limiter_base::can_proceed count_min_rate_limiter_base::account_operation(
+        label& l, uint64_t token, uint64_t limit,
+        const db::per_partition_rate_limit::info& rate_limit_info) noexcept {
+
+    if (std::holds_alternative<std::monostate>(rate_limit_info)) {
+        // Rate limiting turned off
+        return can_proceed::yes;
+    }
+
+    const uint64_t count = increase_and_get_counter(l, token);
+    return rate_limiter_base::admit(count, limit, rate_limit_info);
+}
+
 template class generic_rate_limiter<seastar::lowres_clock>;
+template class generic_rate_limiter<seastar::lowres_clock, count_min_rate_limiter_base>;
 
 }
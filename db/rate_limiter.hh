@@ -14,6 +14,7 @@
 #include <limits>
 #include <concepts>
 #include <vector>
+#include <array>
 #include <optional>
 #include <random>
 
@@ -87,10 +88,14 @@ class rate_limiter_base {
     struct label {
     private:
         // The current ID used to identify the label in the rate limiter.
-        // It is assigned on first use.
+        // It is assigned on first use and is unique within the shard,
+        // so a label can be used with any of the rate limiters.
         uint32_t _label = 0;
 
+        uint32_t get() noexcept;
+
         friend class rate_limiter_base;
+        friend class count_min_rate_limiter_base;
     };
 
 private:
@@ -98,7 +103,6 @@ class rate_limiter_base {
     uint32_t _current_ops_in_bucket = 0;
     uint32_t _current_entries_in_time_window = 0;
 
-    uint32_t _next_label = 1;
     uint32_t _current_time_window = 0;
 
     const uint32_t _salt;
@@ -147,16 +151,106 @@ class rate_limiter_base {
     // only `limit` operations per second are admitted.
     can_proceed account_operation(label& l, uint64_t token, uint64_t limit,
             const db::per_partition_rate_limit::info& rate_limit_info) noexcept;
+
+    // Decides whether an operation may proceed, given the number of operations
+    // counted for its partition, including itself.
+    static can_proceed admit(uint64_t count, uint64_t limit,
+            const db::per_partition_rate_limit::info& rate_limit_info) noexcept;
+};
+
+// A rate limiter which counts the operations in a count-min sketch instead
+// of a hash table. It is sized from a memory budget rather than by the number
+// of partitions it can track: the sketch never runs out of entries, and a
+// lookup touches exactly `depth` cache lines, but a partition's count may be
+// overestimated by the operations of the partitions it collides with.
+// The overestimate is below `error_bound()` with probability 1 - e^-depth.
+class count_min_rate_limiter_base {
+public:
+    using label = rate_limiter_base::label;
+    using can_proceed = rate_limiter_base::can_proceed;
+
+    static constexpr size_t depth = 4;
+    static constexpr size_t counters_per_block = 15;
+
+private:
+    struct metrics {
+        uint64_t operations = 0;
+    };
+
+    // A cache line worth of counters. The counters are halved on every time
+    // window change, lazily: a block remembers the time window it was last
+    // refreshed in and applies the missed halvings when it is touched.
+    struct block {
+        uint32_t time_window = 0;
+        std::array<uint32_t, counters_per_block> counters = {};
+    };
+
+    static_assert(sizeof(block) == 64);
+
+    uint32_t _current_time_window = 0;
+
+    // The number of operations counted, halved on every time window change
+    // like the counters.
+    uint64_t _total = 0;
+
+    const uint32_t _salt;
+
+    // `depth` rows of `_blocks_per_row` blocks each.
+    const size_t _blocks_per_row;
+    utils::chunked_vector<block> _blocks;
+
+    metrics _metrics;
+    seastar::metrics::metric_groups _metric_group;
+
+private:
+    block& block_refresh(block& b) noexcept;
+
+    void register_metrics();
+
+protected:
+    void on_timer() noexcept;
+
+public:
+    // Allocates as many counters as fit in `memory_budget` bytes.
+    explicit count_min_rate_limiter_base(size_t memory_budget);
+
+    count_min_rate_limiter_base(const count_min_rate_limiter_base&) = delete;
+    count_min_rate_limiter_base(count_min_rate_limiter_base&&) = delete;
+
+    count_min_rate_limiter_base& operator=(const count_min_rate_limiter_base&) = delete;
+    count_min_rate_limiter_base& operator=(count_min_rate_limiter_base&&) = delete;
+
+    // The number of counters in each row of the sketch.
+    size_t width() const noexcept {
+        return _blocks_per_row * counters_per_block;
+    }
+
+    size_t memory_usage() const noexcept {
+        return _blocks.size() * sizeof(block);
+    }
+
+    // The bound on the overestimate of a partition's count.
+    double error_bound() const noexcept;
+
+    // (For testing purposes only)
+    // Increments the counter for given (label, token) and returns
+    // the new value of the counter.
+    uint64_t increase_and_get_counter(label& l, uint64_t token) noexcept;
+
+    // Like rate_limiter_base::account_operation().
+    can_proceed account_operation(label& l, uint64_t token, uint64_t limit,
+            const db::per_partition_rate_limit::info& rate_limit_info) noexcept;
 };
 
-template<typename ClockType>
-class generic_rate_limiter : public rate_limiter_base {
+template<typename ClockType, typename Base = rate_limiter_base>
+class generic_rate_limiter : public Base {
 private:
     seastar::timer<ClockType> _timer;
 
 public:
-    generic_rate_limiter()
-            : rate_limiter_base() {
+    template<typename... Args>
+    explicit generic_rate_limiter(Args&&... args)
+            : Base(std::forward<Args>(args)...) {
 
         // Rate limiting is more accurate when the rate limiter timers
         // on all nodes are synchronized. Assume that the nodes' clocks
@@ -167,7 +261,7 @@ class generic_rate_limiter : public rate_limiter_base {
         const auto now = std::chrono::system_clock::now();
         const auto initial_delay = period - now.time_since_epoch() % period;
 
-        _timer.set_callback([this] { on_timer(); });
+        _timer.set_callback([this] { this->on_timer(); });
         _timer.arm(ClockType::now() + initial_delay, period);
     }
 };
@@ -175,4 +269,7 @@ class generic_rate_limiter : public rate_limiter_base {
 extern template class generic_rate_limiter<seastar::lowres_clock>;
 using rate_limiter = generic_rate_limiter<seastar::lowres_clock>;
 
+extern template class generic_rate_limiter<seastar::lowres_clock, count_min_rate_limiter_base>;
+using count_min_rate_limiter = generic_rate_limiter<seastar::lowres_clock, count_min_rate_limiter_base>;
+
 }
@@ -2539,7 +2539,10 @@ class clients_table : public streaming_virtual_table {
             .with_column("ssl_enabled", boolean_type)
             .with_column("ssl_protocol", utf8_type)
             .with_column("username", utf8_type)
-            .with_version(system_keyspace::generate_schema_version(id))
+            .with_column("compression", utf8_type)
+            .with_column("compression_bytes_saved", long_type)
+            // Offset for the compression columns.
+            .with_version(system_keyspace::generate_schema_version(id, 1))
             .build();
     }
 
@@ -2645,6 +2648,12 @@ class clients_table : public streaming_virtual_table {
                     set_cell(cr.cells(), "ssl_protocol", *cd.ssl_protocol);
                 }
                 set_cell(cr.cells(), "username", cd.username ? *cd.username : sstring("anonymous"));
+                if (cd.compression) {
+                    set_cell(cr.cells(), "compression", *cd.compression);
+                }
+                if (cd.compression_bytes_saved) {
+                    set_cell(cr.cells(), "compression_bytes_saved", *cd.compression_bytes_saved);
+                }
                 co_await result.emit_row(std::move(cr));
             }
             co_await result.emit_partition_end();
@@ -8,6 +8,10 @@
 #include "replica/database_fwd.hh"
 #include "db/timeout_clock.hh"
 
+#include <seastar/core/gate.hh>
+#include <seastar/core/semaphore.hh>
+#include <seastar/core/shared_ptr.hh>
+
 namespace service {
 class storage_proxy;
 class query_state;
@@ -16,6 +20,17 @@ class query_state;
 namespace db::view {
 
 class delete_ghost_rows_visitor {
+public:
+    // The number of view rows of a page whose base row is looked up, and
+    // which are deleted if it's missing, concurrently.
+    static constexpr size_t max_concurrent_checks = 32;
+private:
+    struct pending_checks {
+        seastar::semaphore concurrency{max_concurrent_checks};
+        seastar::gate gate;
+        std::exception_ptr error;
+    };
+
     service::storage_proxy& _proxy;
     service::query_state& _state;
     db::timeout_clock::duration _timeout_duration;
@@ -23,6 +38,8 @@ class delete_ghost_rows_visitor {
     replica::table& _view_table;
     schema_ptr _base_schema;
     std::optional<partition_key> _view_pk;
+    // Shared by the copies of the visitor.
+    seastar::lw_shared_ptr<pending_checks> _pending;
 public:
     delete_ghost_rows_visitor(service::storage_proxy& proxy, service::query_state& state, view_ptr view, db::timeout_clock::duration timeout_duration);
 
@@ -43,6 +60,14 @@ class delete_ghost_rows_visitor {
     uint32_t accept_partition_end(const query::result_row_view& static_row) {
         return 0;
     }
+
+    // Waits for the checks of the rows accepted so far, and throws the
+    // error of the first one which failed, if any.
+    // Assumes running in seastar::thread
+    void wait_for_pending_checks();
+private:
+    static future<> delete_ghost_row(service::storage_proxy& proxy, service::query_state& state, db::timeout_clock::duration timeout_duration,
+            view_ptr view, schema_ptr base_schema, partition_key view_pk, clustering_key ck, partition_key base_pk, clustering_key base_ck);
 };
 
 } //namespace db::view
@@ -32,6 +32,7 @@
 #include "cql3/statements/select_statement.hh"
 #include "cql3/util.hh"
 #include "cql3/restrictions/statement_restrictions.hh"
+#include "db/config.hh"
 #include "db/view/view.hh"
 #include "db/view/view_builder.hh"
 #include "db/view/view_updating_consumer.hh"
@@ -447,7 +448,7 @@ mutation_partition& view_updates::partition_for(partition_key&& key) {
 }
 
 size_t view_updates::op_count() const {
-    return _op_count++;;
+    return _op_count;
 }
 
 row_marker view_updates::compute_row_marker(const clustering_row& base_row) const {
@@ -1188,6 +1189,8 @@ void view_update_builder::generate_update(clustering_row&& update, std::optional
 }
 
 future<stop_iteration> view_update_builder::on_results() {
+    // The view rows of a batch are coalesced into one mutation per view
+    // partition, so a larger batch sends fewer and larger mutations.
     constexpr size_t max_rows_for_view_updates = 100;
     size_t rows_for_view_updates = std::accumulate(_view_updates.begin(), _view_updates.end(), 0, [] (size_t acc, const view_updates& vu) {
         return acc + vu.op_count();
@@ -2096,6 +2099,12 @@ class view_builder::consumer {
     };
 
 private:
+    // The view updates of a flush of _fragments, still being propagated.
+    struct pending_flush {
+        dht::decorated_key key;
+        future<> done;
+    };
+
     view_builder& _builder;
     build_step& _step;
     built_views _built_views;
@@ -2112,6 +2121,11 @@ class view_builder::consumer {
     // used to build it, and we cannot allow its serialized size to grow
     // beyond our limit on mutation size (by default 32 MB).
     size_t _fragments_memory_usage = 0;
+    // Up to view_building_concurrency flushes, in token order, propagate
+    // their view updates concurrently with the reading of the next ones.
+    std::deque<pending_flush> _pending_flushes;
+    std::exception_ptr _failure;
+    std::optional<dht::decorated_key> _failed_key;
 public:
     consumer(view_builder& builder, build_step& step, gc_clock::time_point now)
             : _builder(builder)
@@ -2123,6 +2137,60 @@ class view_builder::consumer {
         }
     }
 
+    consumer(consumer&&) = default;
+
+    ~consumer() {
+        while (!_pending_flushes.empty()) {
+            wait_for_pending_flush();
+        }
+        if (_failure) {
+            rewind_to_failed_key();
+        }
+    }
+
+    void wait_for_pending_flush() {
+        auto flush = std::move(_pending_flushes.front());
+        _pending_flushes.pop_front();
+        try {
+            flush.done.get();
+        } catch (...) {
+            if (!_failure) {
+                _failure = std::current_exception();
+                _failed_key = std::move(flush.key);
+            }
+        }
+    }
+
+    // Rewinds the build step to the partition of the first failed flush, so
+    // that the step is retried from there, as if it failed at that partition.
+    void rewind_to_failed_key() {
+        const auto& failed_token = _failed_key->token();
+        for (auto&& vs : _built_views.views) {
+            _step.build_status.push_back(std::move(vs));
+        }
+        _built_views.release();
+        for (auto&& vs : _step.build_status) {
+            if (vs.next_token && *vs.next_token > failed_token) {
+                vs.next_token = failed_token;
+            }
+        }
+        std::stable_sort(_step.build_status.begin(), _step.build_status.end(), [] (const view_build_status& s1, const view_build_status& s2) {
+            return s1.next_token < s2.next_token;
+        });
+        _step.current_key = std::move(*_failed_key);
+        _failed_key.reset();
+    }
+
+    void wait_for_pending_flushes() {
+        while (!_pending_flushes.empty()) {
+            wait_for_pending_flush();
+        }
+        if (_failure) {
+            rewind_to_failed_key();
+            std::rethrow_exception(std::exchange(_failure, nullptr));
+        }
+    }
+
     void load_views_to_build() {
         inject_failure("view_builder_load_views");
         for (auto&& vs : _step.build_status) {
@@ -2211,14 +2279,22 @@ class view_builder::consumer {
             auto reader = make_flat_mutation_reader_from_fragments(_step.reader.schema(), _builder._permit, std::move(_fragments));
             auto close_reader = defer([&reader] { reader.close().get(); });
             reader.upgrade_schema(base_schema);
-            _step.base->populate_views(
-                    std::move(views),
-                    _step.current_token(),
-                    std::move(reader),
-                    _now).get();
             close_reader.cancel();
+            auto done = do_with(std::move(reader), [base = _step.base, views = std::move(views), token = _step.current_token(), now = _now] (flat_mutation_reader_v2& reader) mutable {
+                return base->populate_views(std::move(views), token, std::move(reader), now).finally([&reader] {
+                    return reader.close();
+                });
+            });
+            _pending_flushes.push_back(pending_flush{_step.current_key, std::move(done)});
             _fragments.clear();
             _fragments_memory_usage = 0;
+            const size_t concurrency = std::max(_builder._db.get_config().view_building_concurrency(), 1u);
+            while (_pending_flushes.size() >= concurrency) {
+                wait_for_pending_flush();
+            }
+            if (_failure) {
+                wait_for_pending_flushes();
+            }
         }
     }
 
@@ -2231,6 +2307,7 @@ class view_builder::consumer {
     // Must be called in a seastar thread.
     built_views consume_end_of_stream() {
         inject_failure("view_builder_consume_end_of_stream");
+        wait_for_pending_flushes();
         if (vlogger.is_enabled(log_level::debug)) {
             auto view_names = boost::copy_range<std::vector<sstring>>(
                     _views_to_build | boost::adaptors::transformed([](auto v) {
@@ -2374,6 +2451,7 @@ future<bool> check_needs_view_update_path(db::system_distributed_keyspace& sys_d
 
 const size_t view_updating_consumer::buffer_size_soft_limit{1 * 1024 * 1024};
 const size_t view_updating_consumer::buffer_size_hard_limit{2 * 1024 * 1024};
+const size_t view_updating_consumer::push_concurrency{16};
 
 void view_updating_consumer::do_flush_buffer() {
     _staging_reader_handle.pause();
@@ -2384,14 +2462,25 @@ void view_updating_consumer::do_flush_buffer() {
         _buffer.pop_front();
     }
 
+    // The mutations are of distinct partitions (or of distinct rows of the
+    // same partition), so their read-before-write and the propagation of
+    // their view updates can proceed concurrently.
+    semaphore concurrency(push_concurrency);
+    std::vector<future<>> pushes;
+    pushes.reserve(_buffer.size());
     while (!_buffer.empty()) {
-        try {
-            auto lock_holder = _view_update_pusher(std::move(_buffer.front())).get();
-        } catch (...) {
-            vlogger.warn("Failed to push replica updates for table {}.{}: {}", _schema->ks_name(), _schema->cf_name(), std::current_exception());
-        }
+        auto units = get_units(concurrency, 1).get0();
+        pushes.push_back(futurize_invoke(_view_update_pusher, std::move(_buffer.front())).then_wrapped(
+                [this, units = std::move(units)] (future<row_locker::lock_holder> f) {
+            if (f.failed()) {
+                vlogger.warn("Failed to push replica updates for table {}.{}: {}", _schema->ks_name(), _schema->cf_name(), f.get_exception());
+            } else {
+                f.ignore_ready_future();
+            }
+        }));
         _buffer.pop_front();
     }
+    when_all(pushes.begin(), pushes.end()).get();
 
     _buffer_size = 0;
 }
@@ -2436,6 +2525,7 @@ delete_ghost_rows_visitor::delete_ghost_rows_visitor(service::storage_proxy& pro
         , _view_table(_proxy.get_db().local().find_column_family(view))
         , _base_schema(_proxy.get_db().local().find_schema(_view->view_info()->base_id()))
         , _view_pk()
+        , _pending(make_lw_shared<pending_checks>())
 {}
 
 void delete_ghost_rows_visitor::accept_new_partition(const partition_key& key, uint32_t row_count) {
@@ -2445,6 +2535,9 @@ void delete_ghost_rows_visitor::accept_new_partition(const partition_key& key, u
 
 // Assumes running in seastar::thread
 void delete_ghost_rows_visitor::accept_new_row(const clustering_key& ck, const query::result_row_view& static_row, const query::result_row_view& row) {
+    if (_pending->error) {
+        return;
+    }
     auto view_exploded_pk = _view_pk->explode();
     auto view_exploded_ck = ck.explode();
     std::vector<bytes> base_exploded_pk(_base_schema->partition_key_size());
@@ -2463,23 +2556,48 @@ void delete_ghost_rows_visitor::accept_new_row(const clustering_key& ck, const q
     partition_key base_pk = partition_key::from_exploded(base_exploded_pk);
     clustering_key base_ck = clustering_key::from_exploded(base_exploded_ck);
 
-    dht::partition_range_vector partition_ranges({dht::partition_range::make_singular(dht::decorate_key(*_base_schema, base_pk))});
-    auto selection = cql3::selection::selection::for_columns(_base_schema, std::vector<const column_definition*>({&_base_schema->partition_key_columns().front()}));
+    auto units = get_units(_pending->concurrency, 1).get0();
+    // Waited for by wait_for_pending_checks()
+    (void)with_gate(_pending->gate, [&proxy = _proxy, &state = _state, timeout_duration = _timeout_duration, view = _view, base_schema = _base_schema,
+            view_pk = *_view_pk, ck, base_pk = std::move(base_pk), base_ck = std::move(base_ck)] () mutable {
+        return delete_ghost_row(proxy, state, timeout_duration, std::move(view), std::move(base_schema),
+                std::move(view_pk), std::move(ck), std::move(base_pk), std::move(base_ck));
+    }).then_wrapped([pending = _pending, units = std::move(units)] (future<> f) mutable {
+        if (f.failed() && !pending->error) {
+            pending->error = f.get_exception();
+        } else {
+            f.ignore_ready_future();
+        }
+        units.return_all();
+    });
+}
+
+void delete_ghost_rows_visitor::wait_for_pending_checks() {
+    _pending->gate.close().get();
+    if (_pending->error) {
+        std::rethrow_exception(_pending->error);
+    }
+}
+
+future<> delete_ghost_rows_visitor::delete_ghost_row(service::storage_proxy& proxy, service::query_state& state, db::timeout_clock::duration timeout_duration,
+        view_ptr view, schema_ptr base_schema, partition_key view_pk, clustering_key ck, partition_key base_pk, clustering_key base_ck) {
+    dht::partition_range_vector partition_ranges({dht::partition_range::make_singular(dht::decorate_key(*base_schema, base_pk))});
+    auto selection = cql3::selection::selection::for_columns(base_schema, std::vector<const column_definition*>({&base_schema->partition_key_columns().front()}));
 
     std::vector<query::clustering_range> bounds{query::clustering_range::make_singular(base_ck)};
     query::partition_slice partition_slice(std::move(bounds), {},  {}, selection->get_query_options());
-    auto command = ::make_lw_shared<query::read_command>(_base_schema->id(), _base_schema->version(), partition_slice,
-            _proxy.get_max_result_size(partition_slice), query::tombstone_limit(_proxy.get_tombstone_limit()));
-    auto timeout = db::timeout_clock::now() + _timeout_duration;
-    service::storage_proxy::coordinator_query_options opts{timeout, _state.get_permit(), _state.get_client_state(), _state.get_trace_state()};
-    auto base_qr = _proxy.query(_base_schema, command, std::move(partition_ranges), db::consistency_level::ALL, opts).get0();
+    auto command = ::make_lw_shared<query::read_command>(base_schema->id(), base_schema->version(), partition_slice,
+            proxy.get_max_result_size(partition_slice), query::tombstone_limit(proxy.get_tombstone_limit()));
+    auto timeout = db::timeout_clock::now() + timeout_duration;
+    service::storage_proxy::coordinator_query_options opts{timeout, state.get_permit(), state.get_client_state(), state.get_trace_state()};
+    auto base_qr = co_await proxy.query(base_schema, command, std::move(partition_ranges), db::consistency_level::ALL, opts);
     query::result& result = *base_qr.query_result;
     if (result.row_count().value_or(0) == 0) {
-        mutation m(_view, *_view_pk);
-        auto& row = m.partition().clustered_row(*_view, ck);
+        mutation m(view, std::move(view_pk));
+        auto& row = m.partition().clustered_row(*view, ck);
         row.apply(tombstone(api::new_timestamp(), gc_clock::now()));
-        timeout = db::timeout_clock::now() + _timeout_duration;
-        _proxy.mutate({m}, db::consistency_level::ALL, timeout, _state.get_trace_state(), empty_service_permit(), db::allow_per_partition_rate_limit::no).get();
+        timeout = db::timeout_clock::now() + timeout_duration;
+        co_await proxy.mutate({m}, db::consistency_level::ALL, timeout, state.get_trace_state(), empty_service_permit(), db::allow_per_partition_rate_limit::no);
     }
 }
 
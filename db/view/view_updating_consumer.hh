@@ -35,6 +35,9 @@ class view_updating_consumer {
     // data. We flush mid-partition if we reach the hard limit.
     static const size_t buffer_size_soft_limit;
     static const size_t buffer_size_hard_limit;
+    // The number of buffered mutations whose view updates are pushed
+    // concurrently when flushing the buffer.
+    static const size_t push_concurrency;
 
 private:
     schema_ptr _schema;
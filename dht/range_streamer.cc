@@ -36,6 +36,7 @@ range_streamer::get_range_fetch_map(const std::unordered_map<dht::token_range, s
         const dht::token_range& range_ = x.first;
         const std::vector<inet_address>& addresses = x.second;
         bool found_source = false;
+        std::vector<inet_address> candidates;
         for (auto address : addresses) {
             if (address == utils::fb_utilities::get_broadcast_address()) {
                 // If localhost is a source, we have found one, but we don't add it to the map to avoid streaming locally
@@ -56,9 +57,30 @@ range_streamer::get_range_fetch_map(const std::unordered_map<dht::token_range, s
                 continue;
             }
 
-            range_fetch_map_map[address].push_back(range_);
+            candidates.push_back(address);
+        }
+
+        // We only stream from one other node for each range. The sources are
+        // sorted by proximity, and among the nearest ones, we pick the one
+        // with the fewest ranges so far, so that all of them stream in
+        // parallel rather than the first one streaming everything.
+        if (!candidates.empty()) {
+            const auto& topology = get_token_metadata().get_topology();
+            auto nr_ranges_of = [&range_fetch_map_map] (inet_address address) {
+                auto it = range_fetch_map_map.find(address);
+                return it == range_fetch_map_map.end() ? 0 : it->second.size();
+            };
+            auto source = candidates.front();
+            for (auto address : candidates) {
+                if (topology.compare_endpoints(_address, candidates.front(), address) != 0) {
+                    break;
+                }
+                if (nr_ranges_of(address) < nr_ranges_of(source)) {
+                    source = address;
+                }
+            }
+            range_fetch_map_map[source].push_back(range_);
             found_source = true;
-            break; // ensure we only stream from one other node for each range
         }
 
         if (!found_source) {
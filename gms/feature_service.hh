@@ -109,8 +109,18 @@ class feature_service final {
     gms::feature typed_errors_in_read_rpc { *this, "TYPED_ERRORS_IN_READ_RPC"sv };
     gms::feature schema_commitlog { *this, "SCHEMA_COMMITLOG"sv };
     gms::feature uda_native_parallelized_aggregation { *this, "UDA_NATIVE_PARALLELIZED_AGGREGATION"sv };
+    gms::feature parallelized_aggregation_group_by { *this, "PARALLELIZED_AGGREGATION_GROUP_BY"sv };
     gms::feature aggregate_storage_options { *this, "AGGREGATE_STORAGE_OPTIONS"sv };
     gms::feature collection_indexing { *this, "COLLECTION_INDEXING"sv };
+    gms::feature covering_indexes { *this, "COVERING_INDEXES"sv };
+    gms::feature mutation_batch_verb { *this, "MUTATION_BATCH_VERB"sv };
+    gms::feature row_level_read_repair { *this, "ROW_LEVEL_READ_REPAIR"sv };
+    gms::feature count_min_rate_limiter { *this, "COUNT_MIN_RATE_LIMITER"sv };
+    gms::feature coalesced_reads { *this, "COALESCED_READS"sv };
+    gms::feature caching_max_share { *this, "CACHING_MAX_SHARE"sv };
+    gms::feature incremental_compaction_strategy { *this, "INCREMENTAL_COMPACTION_STRATEGY"sv };
+    gms::feature approximate_aggregates { *this, "APPROXIMATE_AGGREGATES"sv };
+    gms::feature clustering_row_filter { *this, "CLUSTERING_ROW_FILTER"sv };
 
 public:
 
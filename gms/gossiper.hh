@@ -281,7 +281,7 @@ class gossiper : public seastar::async_sharded_service<gossiper>, public seastar
      * @param ep_state
      * @return
      */
-    int get_max_endpoint_state_version(endpoint_state state) const noexcept;
+    int get_max_endpoint_state_version(const endpoint_state& state) const noexcept;
 
 
 private:
@@ -0,0 +1,22 @@
+/*
+ * Copyright 2022-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include "service/batched_mutation.hh"
+
+#include "idl/frozen_mutation.idl.hh"
+#include "idl/per_partition_rate_limit_info.idl.hh"
+
+namespace service {
+
+struct batched_mutation {
+    lw_shared_ptr<const frozen_mutation> fm;
+    uint64_t response_id;
+    db::per_partition_rate_limit::info rate_limit_info;
+};
+
+}
@@ -23,6 +23,16 @@ class specific_ranges {
     std::vector<nonwrapping_range<clustering_key_prefix>> ranges();
 };
 
+struct clustering_column_restriction {
+    uint32_t column;
+    std::vector<bytes> values;
+    nonwrapping_range<bytes> range;
+};
+
+class clustering_row_filter {
+    std::vector<query::clustering_column_restriction> restrictions();
+};
+
 // COMPATIBILITY NOTE: the partition-slice for reverse queries has two different
 // format:
 // * legacy format
@@ -38,6 +48,7 @@ class partition_slice {
     cql_serialization_format cql_format();
     uint32_t partition_row_limit_low_bits() [[version 1.3]] = std::numeric_limits<uint32_t>::max();
     uint32_t partition_row_limit_high_bits() [[version 4.3]] = 0;
+    std::optional<query::clustering_row_filter> get_row_filter() [[version 5.2]];
 };
 
 struct max_result_size {
@@ -268,8 +268,19 @@ view_ptr secondary_index_manager::create_view_for_index(const index_metadata& im
         }
     }
 
+    // A covering index stores the included columns, so that queries which
+    // select only them can be served from the index, without reading the
+    // base table.
+    auto included_columns = target_parser::parse_included_columns(schema, im);
+    for (const column_definition* cdef : included_columns) {
+        builder.with_column(cdef->name(), cdef->type, column_kind::regular_column);
+    }
+
     if (index_target->is_primary_key()) {
         for (auto& def : schema->regular_columns()) {
+            if (std::find(included_columns.begin(), included_columns.end(), &def) != included_columns.end()) {
+                continue;
+            }
             db::view::create_virtual_column(builder, def.name(), def.type);
         }
     }
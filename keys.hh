@@ -535,17 +535,17 @@ class prefixable_full_compound : public compound_wrapper<TopLevel, TopLevelView>
         { }
 
         bool operator()(const TopLevel& k1, const PrefixTopLevel& k2) const {
-            return prefix_equality_tri_compare(prefix_type->types().begin(),
+            return prefix_equality_tri_compare(prefix_type->comparators().begin(),
                 full_type->begin(k1), full_type->end(k1),
                 prefix_type->begin(k2), prefix_type->end(k2),
-                tri_compare) < 0;
+                value_tri_comparator::component_tri_compare{}) < 0;
         }
 
         bool operator()(const PrefixTopLevel& k1, const TopLevel& k2) const {
-            return prefix_equality_tri_compare(prefix_type->types().begin(),
+            return prefix_equality_tri_compare(prefix_type->comparators().begin(),
                 prefix_type->begin(k1), prefix_type->end(k1),
                 full_type->begin(k2), full_type->end(k2),
-                tri_compare) < 0;
+                value_tri_comparator::component_tri_compare{}) < 0;
         }
     };
 
@@ -609,10 +609,10 @@ class prefix_compound_wrapper : public compound_wrapper<TopLevel, TopLevelView>
         { }
 
         bool operator()(const TopLevel& k1, const TopLevel& k2) const {
-            return prefix_equality_tri_compare(prefix_type->types().begin(),
+            return prefix_equality_tri_compare(prefix_type->comparators().begin(),
                 prefix_type->begin(k1.representation()), prefix_type->end(k1.representation()),
                 prefix_type->begin(k2.representation()), prefix_type->end(k2.representation()),
-                tri_compare) < 0;
+                value_tri_comparator::component_tri_compare{}) < 0;
         }
     };
 
@@ -625,10 +625,10 @@ class prefix_compound_wrapper : public compound_wrapper<TopLevel, TopLevelView>
         { }
 
         std::strong_ordering operator()(const TopLevel& k1, const TopLevel& k2) const {
-            return prefix_equality_tri_compare(prefix_type->types().begin(),
+            return prefix_equality_tri_compare(prefix_type->comparators().begin(),
                 prefix_type->begin(k1.representation()), prefix_type->end(k1.representation()),
                 prefix_type->begin(k2.representation()), prefix_type->end(k2.representation()),
-                tri_compare);
+                value_tri_comparator::component_tri_compare{});
         }
     };
 };
@@ -383,6 +383,38 @@ seastar::future<bytes_opt> run_script(const db::functions::function_name& name,
     }
     return make_ready_future<bytes_opt>(ret);
 }
+
+seastar::future<bytes_opt> run_script_fold(const db::functions::function_name& name, context& ctx, const std::vector<data_type>& arg_types, bytes_opt acc, const std::vector<std::vector<bytes_opt>>& inputs, data_type return_type, bool allow_null_input) {
+    wasm::instance_cache::value_type func_inst;
+    std::exception_ptr ex;
+    try {
+        func_inst = ctx.cache->get(name, arg_types, ctx).get0();
+        std::vector<bytes_opt> params;
+        params.reserve(arg_types.size());
+        for (const auto& input : inputs) {
+            params.clear();
+            params.push_back(std::move(acc));
+            params.insert(params.end(), input.begin(), input.end());
+            // Like a single call of a function which isn't called on null
+            // input, which returns null without running the function.
+            if (!allow_null_input && std::any_of(params.begin(), params.end(), [] (const bytes_opt& p) { return !p; })) {
+                acc = std::nullopt;
+                continue;
+            }
+            acc = wasm::run_script(ctx, func_inst->instance->store, func_inst->instance->instance, func_inst->instance->func, arg_types, params, return_type, allow_null_input).get0();
+        }
+    } catch (const wasm::instance_corrupting_exception& e) {
+        func_inst->instance = std::nullopt;
+        ex = std::current_exception();
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    ctx.cache->recycle(func_inst);
+    if (ex) {
+        std::rethrow_exception(std::move(ex));
+    }
+    return make_ready_future<bytes_opt>(std::move(acc));
+}
 }
 
 #endif
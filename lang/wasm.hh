@@ -47,6 +47,12 @@ seastar::future<bytes_opt> run_script(context& ctx, const std::vector<data_type>
 
 seastar::future<bytes_opt> run_script(const db::functions::function_name& name, context& ctx, const std::vector<data_type>& arg_types, const std::vector<bytes_opt>& params, data_type return_type, bool allow_null_input);
 
+// Calls the function once for every input, in order, with the result of the
+// previous call (acc, for the first one), followed by the input, as its
+// parameters, and returns the result of the last call. All calls run on the
+// same instance, which is taken from the cache only once.
+seastar::future<bytes_opt> run_script_fold(const db::functions::function_name& name, context& ctx, const std::vector<data_type>& arg_types, bytes_opt acc, const std::vector<std::vector<bytes_opt>>& inputs, data_type return_type, bool allow_null_input);
+
 #else
 
 struct context {
@@ -66,6 +72,10 @@ inline seastar::future<bytes_opt> run_script(context&, const std::vector<data_ty
 inline seastar::future<bytes_opt> run_script(const db::functions::function_name& name, context& ctx, const std::vector<data_type>& arg_types, const std::vector<bytes_opt>& params, data_type return_type, bool allow_null_input) {
     throw wasm::exception("WASM support was not enabled during compilation!");
 }
+
+inline seastar::future<bytes_opt> run_script_fold(const db::functions::function_name& name, context& ctx, const std::vector<data_type>& arg_types, bytes_opt acc, const std::vector<std::vector<bytes_opt>>& inputs, data_type return_type, bool allow_null_input) {
+    throw wasm::exception("WASM support was not enabled during compilation!");
+}
 #endif
 
 }
@@ -61,9 +61,7 @@ sstring abstract_replication_strategy::to_qualified_class_name(std::string_view
 }
 
 inet_address_vector_replica_set abstract_replication_strategy::get_natural_endpoints(const token& search_token, const effective_replication_map& erm) const {
-    const token& key_token = erm.get_token_metadata_ptr()->first_token(search_token);
-    auto res = erm.get_replication_map().find(key_token);
-    return res->second;
+    return erm.do_get_natural_endpoints(search_token);
 }
 
 inet_address_vector_replica_set effective_replication_map::get_natural_endpoints_without_node_being_replaced(const token& search_token) const {
@@ -336,11 +334,40 @@ future<replication_map> effective_replication_map::clone_endpoints_gently() cons
     co_return cloned_endpoints;
 }
 
+effective_replication_map::effective_replication_map(abstract_replication_strategy::ptr_type rs, token_metadata_ptr tmptr, replication_map replication_map, size_t replication_factor)
+    : _rs(std::move(rs))
+    , _tmptr(std::move(tmptr))
+    , _replication_map(std::move(replication_map))
+    , _replication_factor(replication_factor)
+{
+    // The nodes of _replication_map are never moved, until clear_gently()
+    // or the destructor, so pointing at its values is safe.
+    const auto& sorted_tokens = _tmptr->sorted_tokens();
+    _replicas_by_token_index.reserve(sorted_tokens.size());
+    for (const auto& t : sorted_tokens) {
+        auto it = _replication_map.find(t);
+        if (it == _replication_map.end()) {
+            _replicas_by_token_index.clear();
+            break;
+        }
+        _replicas_by_token_index.push_back(&it->second);
+    }
+}
+
+const inet_address_vector_replica_set& effective_replication_map::do_get_natural_endpoints(const token& search_token) const {
+    auto idx = _tmptr->first_token_index(search_token);
+    if (_replicas_by_token_index.empty()) {
+        return _replication_map.find(_tmptr->sorted_tokens()[idx])->second;
+    }
+    return *_replicas_by_token_index[idx];
+}
+
 inet_address_vector_replica_set effective_replication_map::get_natural_endpoints(const token& search_token) const {
     return _rs->get_natural_endpoints(search_token, *this);
 }
 
 future<> effective_replication_map::clear_gently() noexcept {
+    _replicas_by_token_index.clear();
     co_await utils::clear_gently(_replication_map);
     co_await utils::clear_gently(_tmptr);
 }
@@ -155,6 +155,10 @@ class effective_replication_map : public enable_lw_shared_from_this<effective_re
     abstract_replication_strategy::ptr_type _rs;
     token_metadata_ptr _tmptr;
     replication_map _replication_map;
+    // The replicas of _tmptr->sorted_tokens()[i] are *_replicas_by_token_index[i],
+    // so get_natural_endpoints() needs no lookup into _replication_map.
+    // Empty when _replication_map does not cover all the sorted tokens.
+    std::vector<const inet_address_vector_replica_set*> _replicas_by_token_index;
     size_t _replication_factor;
     std::optional<factory_key> _factory_key = std::nullopt;
     effective_replication_map_factory* _factory = nullptr;
@@ -162,12 +166,7 @@ class effective_replication_map : public enable_lw_shared_from_this<effective_re
     friend class abstract_replication_strategy;
     friend class effective_replication_map_factory;
 public:
-    explicit effective_replication_map(abstract_replication_strategy::ptr_type rs, token_metadata_ptr tmptr, replication_map replication_map, size_t replication_factor) noexcept
-        : _rs(std::move(rs))
-        , _tmptr(std::move(tmptr))
-        , _replication_map(std::move(replication_map))
-        , _replication_factor(replication_factor)
-    { }
+    explicit effective_replication_map(abstract_replication_strategy::ptr_type rs, token_metadata_ptr tmptr, replication_map replication_map, size_t replication_factor);
     effective_replication_map() = delete;
     effective_replication_map(effective_replication_map&&) = default;
     ~effective_replication_map();
@@ -228,6 +227,7 @@ class effective_replication_map : public enable_lw_shared_from_this<effective_re
     get_range_addresses() const;
 
 private:
+    const inet_address_vector_replica_set& do_get_natural_endpoints(const token& search_token) const;
     dht::token_range_vector do_get_ranges(noncopyable_function<bool(inet_address_vector_replica_set)> should_add_range) const;
 
 public:
@@ -31,6 +31,7 @@
 #include "db/system_keyspace.hh"
 #include "db/system_distributed_keyspace.hh"
 #include "db/batchlog_manager.hh"
+#include "db/cache_warmup.hh"
 #include "db/commitlog/commitlog.hh"
 #include "db/hints/manager.hh"
 #include "db/commitlog/commitlog_replayer.hh"
@@ -814,6 +815,7 @@ To start the scylla server proper, simply invoke as: scylla server (or just scyl
             if (!cfg->inter_dc_tcp_nodelay()) {
                 mscfg.tcp_nodelay = netw::messaging_service::tcp_nodelay_what::local;
             }
+            mscfg.shard_affine_connections = cfg->internode_shard_affine_connections();
 
             static sharded<auth::service> auth_service;
             static sharded<qos::service_level_controller> sl_controller;
@@ -963,6 +965,9 @@ To start the scylla server proper, simply invoke as: scylla server (or just scyl
             utils::directories::set dir_set;
             dir_set.add(cfg->data_file_directories());
             dir_set.add(cfg->commitlog_directory());
+            if (cfg->row_cache_save_period()) {
+                dir_set.add(cfg->saved_caches_directory());
+            }
             dirs.emplace(cfg->developer_mode());
             dirs->create_and_verify(std::move(dir_set)).get();
 
@@ -1003,7 +1008,9 @@ To start the scylla server proper, simply invoke as: scylla server (or just scyl
                     .maintenance_sched_group = compaction_manager::scheduling_group{dbcfg.streaming_scheduling_group, service::get_local_streaming_priority()},
                     .available_memory = dbcfg.available_memory,
                     .static_shares = cfg->compaction_static_shares,
+                    .controller_lookahead_in_ms = cfg->compaction_controller_lookahead_in_ms,
                     .throughput_mb_per_sec = cfg->compaction_throughput_mb_per_sec,
+                    .major_compaction_parallelism = cfg->major_compaction_parallelism,
                 };
             });
             cm.start(std::move(get_cm_cfg), std::ref(stop_signal.as_sharded_abort_source())).get();
@@ -1106,7 +1113,7 @@ To start the scylla server proper, simply invoke as: scylla server (or just scyl
             raft_gr.invoke_on_all(&service::raft_group_registry::start).get();
 
             supervisor::notify("starting query processor");
-            cql3::query_processor::memory_config qp_mcfg = {memory::stats().total_memory() / 256, memory::stats().total_memory() / 2560};
+            cql3::query_processor::memory_config qp_mcfg = {memory::stats().total_memory() / 256, memory::stats().total_memory() / 2560, memory::stats().total_memory() / 512};
             debug::the_query_processor = &qp;
             auto local_data_dict = seastar::sharded_parameter([] (const replica::database& db) { return db.as_data_dictionary(); }, std::ref(db));
 
@@ -1223,22 +1230,25 @@ To start the scylla server proper, simply invoke as: scylla server (or just scyl
             view_update_generator.start(std::ref(db)).get();
 
             supervisor::notify("starting commit log");
-            auto cl = db.local().commitlog();
-            if (cl != nullptr) {
-                auto paths = cl->get_segments_to_replay().get();
-                if (!paths.empty()) {
-                    supervisor::notify("replaying commit log");
-                    auto rp = db::commitlog_replayer::create_replayer(db).get0();
-                    rp.recover(paths, db::commitlog::descriptor::FILENAME_PREFIX).get();
-                    supervisor::notify("replaying commit log - flushing memtables");
-                    db.invoke_on_all([] (replica::database& db) {
-                        return db.flush_all_memtables();
-                    }).get();
-                    supervisor::notify("replaying commit log - removing old commitlog segments");
-                    //FIXME: discarded future
-                    (void)cl->delete_segments(std::move(paths));
+            auto replay_commitlog = [&db] (db::commitlog* cl, const std::string& fname_prefix) {
+                if (cl != nullptr) {
+                    auto paths = cl->get_segments_to_replay().get();
+                    if (!paths.empty()) {
+                        supervisor::notify("replaying commit log");
+                        auto rp = db::commitlog_replayer::create_replayer(db).get0();
+                        rp.recover(paths, fname_prefix).get();
+                        supervisor::notify("replaying commit log - flushing memtables");
+                        db.invoke_on_all([] (replica::database& db) {
+                            return db.flush_all_memtables();
+                        }).get();
+                        supervisor::notify("replaying commit log - removing old commitlog segments");
+                        //FIXME: discarded future
+                        (void)cl->delete_segments(std::move(paths));
+                    }
                 }
-            }
+            };
+            replay_commitlog(db.local().commitlog(), db::commitlog::descriptor::FILENAME_PREFIX);
+            replay_commitlog(db.local().segregated_commitlog(), db::commitlog::descriptor::SEGREGATED_FILENAME_PREFIX);
 
             db.invoke_on_all([] (replica::database& db) {
                 for (auto& x : db.get_column_families()) {
@@ -1264,6 +1274,18 @@ To start the scylla server proper, simply invoke as: scylla server (or just scyl
                     cf.trigger_compaction();
                 }
             }).get();
+
+            supervisor::notify("starting row cache warm-up");
+            static sharded<db::cache_warmup> cache_warmup;
+            cache_warmup.start(std::ref(db), db::cache_warmup::config{
+                .directory = cfg->saved_caches_directory(),
+                .save_period = std::chrono::seconds(cfg->row_cache_save_period()),
+                .keys_to_save = cfg->row_cache_keys_to_save(),
+            }).get();
+            auto stop_cache_warmup = defer_verbose_shutdown("row cache warm-up", [] {
+                cache_warmup.stop().get();
+            });
+            cache_warmup.invoke_on_all(&db::cache_warmup::start).get();
             api::set_server_gossip(ctx, gossiper).get();
             api::set_server_snitch(ctx).get();
             api::set_server_storage_proxy(ctx, ss).get();
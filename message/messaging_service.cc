@@ -73,6 +73,7 @@
 #include "idl/group0.dist.hh"
 #include "idl/replica_exception.dist.hh"
 #include "idl/per_partition_rate_limit_info.dist.hh"
+#include "idl/batched_mutation.dist.hh"
 #include "idl/storage_proxy.dist.hh"
 #include "message/rpc_protocol_impl.hh"
 #include "idl/consistency_level.dist.impl.hh"
@@ -101,6 +102,7 @@
 #include "idl/view.dist.impl.hh"
 #include "idl/replica_exception.dist.impl.hh"
 #include "idl/per_partition_rate_limit_info.dist.impl.hh"
+#include "idl/batched_mutation.dist.impl.hh"
 #include "idl/storage_proxy.dist.impl.hh"
 #include <seastar/rpc/lz4_compressor.hh>
 #include <seastar/rpc/lz4_fragmented_compressor.hh>
@@ -108,6 +110,7 @@
 #include "partition_range_compat.hh"
 #include <boost/range/adaptor/filtered.hpp>
 #include <boost/range/adaptor/indirected.hpp>
+#include <random>
 #include "frozen_mutation.hh"
 #include "streaming/stream_manager.hh"
 #include "streaming/stream_mutation_fragments_cmd.hh"
@@ -523,9 +526,11 @@ static constexpr unsigned do_get_rpc_client_idx(messaging_verb verb) {
         return 1;
     case messaging_verb::CLIENT_ID:
     case messaging_verb::MUTATION:
+    case messaging_verb::MUTATION_BATCH:
     case messaging_verb::READ_DATA:
     case messaging_verb::READ_MUTATION_DATA:
     case messaging_verb::READ_DIGEST:
+    case messaging_verb::READ_BLOCK_DIGESTS:
     case messaging_verb::DEFINITIONS_UPDATE:
     case messaging_verb::TRUNCATE:
     case messaging_verb::MIGRATION_REQUEST:
@@ -573,6 +578,15 @@ static constexpr std::array<uint8_t, static_cast<size_t>(messaging_verb::LAST)>
 
 static std::array<uint8_t, static_cast<size_t>(messaging_verb::LAST)> s_rpc_client_idx_table = make_rpc_client_idx_table();
 
+// Whether the connection of the index do_get_rpc_client_idx() returns is
+// compressed when internode_compression asks for it. Compression is
+// negotiated per connection, so the verbs sharing a connection share the
+// choice. The acknowledgements of mutations are a few bytes each, which
+// don't compress, so compressing them only adds to the latency of writes.
+static constexpr bool do_is_compressible_rpc_client_idx(unsigned idx) {
+    return idx != 3;
+}
+
 unsigned
 messaging_service::get_rpc_client_idx(messaging_verb verb) const {
     auto idx = s_rpc_client_idx_table[static_cast<size_t>(verb)];
@@ -687,6 +701,20 @@ gms::inet_address messaging_service::get_public_endpoint_for(const gms::inet_add
     return i != _preferred_to_endpoint.end() ? i->second : ip;
 }
 
+// The next local port for a connection which lands on the shard with the id
+// of this one on a node with as many shards, which puts connections on the
+// shard of their source port modulo its number of shards. The ports rotate
+// over the dynamic port range, so that a port which is in use is only tried
+// again after all others.
+static uint16_t next_shard_affine_port() {
+    static constexpr unsigned first_port = 49152;
+    static constexpr unsigned last_port = 65535;
+    static thread_local unsigned cursor = std::random_device{}();
+    const unsigned base = first_port + (smp::count - first_port % smp::count + this_shard_id()) % smp::count;
+    const unsigned ports = (last_port - base) / smp::count + 1;
+    return base + (cursor++ % ports) * smp::count;
+}
+
 shared_ptr<messaging_service::rpc_protocol_client_wrapper> messaging_service::get_rpc_client(messaging_verb verb, msg_addr id) {
     assert(!_shutting_down);
     auto idx = get_rpc_client_idx(verb);
@@ -749,7 +777,7 @@ shared_ptr<messaging_service::rpc_protocol_client_wrapper> messaging_service::ge
     }();
 
     auto must_compress = [&] {
-        if (_cfg.compress == compress_what::none) {
+        if (_cfg.compress == compress_what::none || !do_is_compressible_rpc_client_idx(s_rpc_client_idx_table[static_cast<size_t>(verb)])) {
             return false;
         }
 
@@ -773,6 +801,8 @@ shared_ptr<messaging_service::rpc_protocol_client_wrapper> messaging_service::ge
 
     auto addr = get_preferred_ip(id.addr);
     auto remote_addr = socket_address(addr, must_encrypt ? _cfg.ssl_port : _cfg.port);
+    // The gossip connection has nothing to gain from affinity.
+    auto bind_addr = _cfg.shard_affine_connections && idx != 0 ? socket_address(laddr.addr(), next_shard_affine_port()) : laddr;
 
     rpc::client_options opts;
     // send keepalive messages each minute if connection is idle, drop connection after 10 failures
@@ -786,9 +816,9 @@ shared_ptr<messaging_service::rpc_protocol_client_wrapper> messaging_service::ge
 
     auto client = must_encrypt ?
                     ::make_shared<rpc_protocol_client_wrapper>(_rpc->protocol(), std::move(opts),
-                                    remote_addr, laddr, _credentials) :
+                                    remote_addr, bind_addr, _credentials) :
                     ::make_shared<rpc_protocol_client_wrapper>(_rpc->protocol(), std::move(opts),
-                                    remote_addr, laddr);
+                                    remote_addr, bind_addr);
 
     bool topology_ignored = topology_status.has_value() ? *topology_status == false : false;
     auto res = _clients[idx].emplace(id, shard_info(std::move(client), topology_ignored));
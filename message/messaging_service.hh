@@ -179,7 +179,9 @@ enum class messaging_verb : int32_t {
     REPAIR_FLUSH_HINTS_BATCHLOG = 60,
     FORWARD_REQUEST = 61,
     GET_GROUP0_UPGRADE_STATE = 62,
-    LAST = 63,
+    MUTATION_BATCH = 63,
+    READ_BLOCK_DIGESTS = 64,
+    LAST = 65,
 };
 
 } // namespace netw
@@ -267,6 +269,9 @@ class messaging_service : public seastar::async_sharded_service<messaging_servic
         tcp_nodelay_what tcp_nodelay = tcp_nodelay_what::all;
         bool listen_on_broadcast_address = false;
         size_t rpc_memory_limit = 1'000'000;
+        // Connect from source ports which make the remote node's port based
+        // load balancing put the connection on the shard with our id.
+        bool shard_affine_connections = false;
     };
 
     struct scheduling_config {
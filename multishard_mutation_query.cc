@@ -702,7 +702,7 @@ future<page_consume_result<ResultBuilder>> read_page(
             cmd.partition_limit);
 
     auto reader = make_multishard_combining_reader_v2(ctx, s, ctx->permit(), ranges.front(), cmd.slice,
-            service::get_local_sstable_query_read_priority(), trace_state, mutation_reader::forwarding(ranges.size() > 1));
+            service::get_local_sstable_query_read_priority(), trace_state, mutation_reader::forwarding(ranges.size() > 1), cmd.get_row_limit());
     if (ranges.size() > 1) {
         reader = make_flat_mutation_reader_v2<multi_range_reader>(s, ctx->permit(), std::move(reader), ranges);
     }
@@ -879,8 +879,15 @@ future<std::tuple<foreign_ptr<lw_shared_ptr<query::result>>, cache_temperature>>
         db::timeout_clock::time_point timeout) {
     schema_ptr query_schema = cmd.slice.is_reversed() ? table_schema->make_reversed() : table_schema;
 
-    return do_query_on_all_shards<data_query_result_builder>(db, query_schema, cmd, ranges, std::move(trace_state), timeout,
-            [table_schema, &cmd, opts] (query::result_memory_accounter&& accounter, const compact_for_query_state_v2& compaction_state) {
-        return data_query_result_builder(*table_schema, cmd.slice, opts, std::move(accounter), compaction_state, cmd.tombstone_limit);
+    std::optional<query::read_command> data_cmd;
+    if (query::can_omit_unselected_cell_values(*table_schema, cmd.slice)) {
+        data_cmd.emplace(cmd);
+        data_cmd->slice.options.set<query::partition_slice::option::omit_unselected_cell_values>();
+    }
+    const auto& query_cmd = data_cmd ? *data_cmd : cmd;
+
+    co_return co_await do_query_on_all_shards<data_query_result_builder>(db, query_schema, query_cmd, ranges, std::move(trace_state), timeout,
+            [table_schema, &query_cmd, opts] (query::result_memory_accounter&& accounter, const compact_for_query_state_v2& compaction_state) {
+        return data_query_result_builder(*table_schema, query_cmd.slice, opts, std::move(accounter), compaction_state, query_cmd.tombstone_limit);
     });
 }
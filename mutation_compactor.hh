@@ -372,6 +372,12 @@ class compact_mutation_state {
     stop_iteration consume(clustering_row&& cr, Consumer& consumer, GCConsumer& gc_consumer) {
         if (!sstable_compaction()) {
             _last_pos = cr.position();
+            // Some sources drop the rows rejected by the filter early, the
+            // others have theirs dropped here, so that all replicas return
+            // the same rows.
+            if (auto& filter = _slice.get_row_filter(); filter && !(*filter)(_schema, cr.key())) {
+                return stop_iteration::no;
+            }
         }
         auto current_tombstone = std::max(_partition_tombstone, _effective_tombstone);
         auto t = cr.tomb();
@@ -163,18 +163,45 @@ struct invalid_mutation_fragment_stream : public std::runtime_error {
 /// If the `abort_on_internal_error` configuration option is set, it will
 /// abort instead.
 /// Implements the FlattenedConsumerFilter concept.
+///
+/// When constructed with a non-zero sampling ratio and a `token` or
+/// `partition_key` level, that fraction of the partitions is validated at the
+/// `clustering_key` level, the others at the given level. The partitions to
+/// validate fully are picked at regular intervals, starting with the first.
+/// Sampling is decided when the partition key is validated, so the key must be
+/// passed to `operator()(const dht::decorated_key&)` before the partition's
+/// fragments.
 class mutation_fragment_stream_validating_filter {
     mutation_fragment_stream_validator _validator;
     sstring _name;
     mutation_fragment_stream_validation_level _validation_level;
+    double _sampling_ratio;
+    // Accumulates _sampling_ratio per partition, a partition is sampled
+    // whenever it reaches 1.
+    double _sampling_credit = 1;
+    // The current partition is validated at the clustering_key level.
+    bool _sampled = false;
+    uint64_t _fragments_validated = 0;
+    uint64_t _fragments_fully_validated = 0;
+    uint64_t _partitions_sampled = 0;
+
+private:
+    mutation_fragment_stream_validation_level current_level() const {
+        return _sampled ? mutation_fragment_stream_validation_level::clustering_key : _validation_level;
+    }
+    void maybe_sample_partition();
 
 public:
     /// Constructor.
     ///
     /// \arg name is used in log messages to identify the validator, the
     ///     schema identity is added automatically
-    /// \arg compare_keys enable validating clustering key monotonicity
-    mutation_fragment_stream_validating_filter(sstring_view name, const schema& s, mutation_fragment_stream_validation_level level);
+    /// \arg level the validation level of all fragments
+    /// \arg sampling_ratio the fraction of partitions, in [0, 1], validated at
+    ///     the `clustering_key` level when \p level is `token` or
+    ///     `partition_key`
+    mutation_fragment_stream_validating_filter(sstring_view name, const schema& s, mutation_fragment_stream_validation_level level,
+            double sampling_ratio = 0);
 
     bool operator()(const dht::decorated_key& dk);
     bool operator()(mutation_fragment_v2::kind kind, position_in_partition_view pos, std::optional<tombstone> new_current_tombstone);
@@ -187,4 +214,18 @@ class mutation_fragment_stream_validating_filter {
     /// Equivalent to `operator()(partition_end{})`
     bool on_end_of_partition();
     void on_end_of_stream();
+
+    /// The number of fragments validated so far, at any level.
+    uint64_t fragments_validated() const {
+        return _fragments_validated;
+    }
+    /// The number of fragments validated so far at the `clustering_key` level.
+    uint64_t fragments_fully_validated() const {
+        return _fragments_fully_validated;
+    }
+    /// The number of partitions picked for validation at the `clustering_key`
+    /// level so far, by sampling.
+    uint64_t partitions_sampled() const {
+        return _partitions_sampled;
+    }
 };
@@ -1039,12 +1039,19 @@ struct mutation_application_stats {
     uint64_t row_writes = 0;
     uint64_t rows_compacted_with_tombstones = 0;
     uint64_t rows_dropped_by_tombstones = 0;
+    // Writes of a partition_entry merged into its latest version, and the
+    // ones which were added as a new version, because a snapshot pinned the
+    // latest one or the merge was preempted.
+    uint64_t partition_writes_in_place = 0;
+    uint64_t partition_versions_created = 0;
 
     mutation_application_stats& operator+=(const mutation_application_stats& other) {
         row_hits += other.row_hits;
         row_writes += other.row_writes;
         rows_compacted_with_tombstones += other.rows_compacted_with_tombstones;
         rows_dropped_by_tombstones += other.rows_dropped_by_tombstones;
+        partition_writes_in_place += other.partition_writes_in_place;
+        partition_versions_created += other.partition_versions_created;
         return *this;
     }
 };
@@ -15,4 +15,6 @@
 struct mutation_source_metadata {
     std::optional<api::timestamp_type> min_timestamp;
     std::optional<api::timestamp_type> max_timestamp;
+    // The source is a memtable being flushed.
+    bool from_memtable = false;
 };
\ No newline at end of file
@@ -105,8 +105,14 @@ multishard_writer::multishard_writer(
     _shard_writers.resize(_s->get_sharder().shard_count());
 }
 
+// The fragments for a shard are queued here, and moved to it a buffer at a
+// time by the foreign reader, so the buffer size is the batch of a cross-shard
+// call. Pushing to the queue waits while its buffer is full.
+static constexpr size_t shard_writer_buffer_size = 128 * 1024;
+
 future<> multishard_writer::make_shard_writer(unsigned shard) {
     auto [reader, handle] = make_queue_reader_v2(_s, _producer.permit());
+    reader.set_max_buffer_size(shard_writer_buffer_size);
     _queue_reader_handles[shard] = std::move(handle);
     return smp::submit_to(shard, [gs = global_schema_ptr(_s),
             consumer = _consumer,
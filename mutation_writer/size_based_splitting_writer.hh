@@ -0,0 +1,24 @@
+/*
+ * Copyright (C) 2022-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <seastar/util/noncopyable_function.hh>
+
+#include "feed_writers.hh"
+
+namespace mutation_writer {
+
+// Split the stream of the producer at partition boundaries into streams holding
+// about max_size bytes of fragments each, so each output stream covers a disjoint
+// token range. A stream is ended as soon as the next one starts, so its consumer
+// can finish (e.g. seal its sstable) while the following ones are written.
+// This is useful for flushing large memtables into several sstables.
+future<> segregate_by_size(flat_mutation_reader_v2 producer, size_t max_size, reader_consumer_v2 consumer);
+
+} // namespace mutation_writer
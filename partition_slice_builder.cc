@@ -19,6 +19,7 @@ partition_slice_builder::partition_slice_builder(const schema& schema, query::pa
     , _specific_ranges(std::move(slice._specific_ranges))
     , _schema(schema)
     , _options(std::move(slice.options))
+    , _row_filter(std::move(slice._row_filter))
 {
 }
 
@@ -64,6 +65,7 @@ partition_slice_builder::build() {
         std::move(_specific_ranges),
         cql_serialization_format::internal(),
         _partition_row_limit,
+        std::move(_row_filter),
     };
 }
 
@@ -172,3 +174,8 @@ partition_slice_builder& partition_slice_builder::with_partition_row_limit(uint6
     _partition_row_limit = limit;
     return *this;
 }
+
+partition_slice_builder& partition_slice_builder::with_row_filter(query::clustering_row_filter filter) {
+    _row_filter = std::move(filter);
+    return *this;
+}
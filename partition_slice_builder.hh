@@ -31,6 +31,7 @@ class partition_slice_builder {
     const schema& _schema;
     query::partition_slice::option_set _options;
     uint64_t _partition_row_limit = query::partition_max_rows;
+    std::optional<query::clustering_row_filter> _row_filter;
 public:
     partition_slice_builder(const schema& schema);
     partition_slice_builder(const schema& schema, query::partition_slice slice);
@@ -60,6 +61,7 @@ class partition_slice_builder {
     }
 
     partition_slice_builder& with_partition_row_limit(uint64_t limit);
+    partition_slice_builder& with_row_filter(query::clustering_row_filter filter);
 
     query::partition_slice build();
 };
@@ -361,6 +361,7 @@ void partition_entry::apply(logalloc::region& r, mutation_cleaner& cleaner, cons
                       is_preemptible::yes,
                       res) == stop_iteration::yes) {
                 current_allocator().destroy(new_version);
+                ++app_stats.partition_writes_in_place;
                 return;
             } else {
                 // Apply was preempted. Let the cleaner finish the job when snapshot dies
@@ -374,6 +375,7 @@ void partition_entry::apply(logalloc::region& r, mutation_cleaner& cleaner, cons
     new_version->insert_before(*_version);
     set_version(new_version);
     app_stats.row_writes += new_version->partition().row_count();
+    ++app_stats.partition_versions_created;
 }
 
 utils::coroutine partition_entry::apply_to_incomplete(const schema& s,
@@ -24,7 +24,8 @@ enum class can_use {
     yes,
     no_schema_version_mismatch,
     no_ring_pos_mismatch,
-    no_clustering_pos_mismatch
+    no_clustering_pos_mismatch,
+    no_cell_values_mismatch
 };
 
 static sstring cannot_use_reason(can_use cu)
@@ -39,6 +40,8 @@ static sstring cannot_use_reason(can_use cu)
             return "ring pos mismatch";
         case can_use::no_clustering_pos_mismatch:
             return "clustering pos mismatch";
+        case can_use::no_cell_values_mismatch:
+            return "cell values mismatch";
     }
     return "unknown reason";
 }
@@ -157,6 +160,13 @@ static can_use can_be_used_for_page(const Querier& q, const schema& s, const dht
         return can_use::no_schema_version_mismatch;
     }
 
+    // Data and mutation range scans share queriers, but the readers of the
+    // former may omit cell values the latter need.
+    constexpr auto omit_values = query::partition_slice::option::omit_unselected_cell_values;
+    if (q.slice().options.contains(omit_values) != slice.options.contains(omit_values)) {
+        return can_use::no_cell_values_mismatch;
+    }
+
     const auto pos_opt = q.current_position();
     if (!pos_opt) {
         // There was nothing read so far so we assume we are ok.
@@ -242,7 +252,11 @@ void querier_cache::insert_querier(
 
     auto& sem = q.permit().semaphore();
 
-    auto irh = sem.register_inactive_read(querier_utils::get_reader(q));
+    auto pos = q.current_position();
+    auto cost = pos && pos->position.region() == partition_region::clustered
+            ? reader_concurrency_semaphore::resume_cost::high
+            : reader_concurrency_semaphore::resume_cost::low;
+    auto irh = sem.register_inactive_read(querier_utils::get_reader(q), cost);
     if (!irh) {
         ++stats.resource_based_evictions;
         return;
@@ -106,6 +106,10 @@ class querier_base {
         return _permit;
     }
 
+    const query::partition_slice& slice() const {
+        return *_slice;
+    }
+
     bool is_reversed() const {
         return _slice->options.contains(query::partition_slice::option::reversed);
     }
@@ -133,6 +133,43 @@ class specific_ranges {
     clustering_row_ranges _ranges;
 };
 
+// A restriction of a clustering key column to a set or a range of values,
+// serialized as per the column's type, ignoring its ordering.
+struct clustering_column_restriction {
+    // The position of the column in the clustering key.
+    uint32_t column;
+    // The accepted values, if not empty, the accepted range otherwise.
+    std::vector<bytes> values;
+    nonwrapping_range<bytes> range;
+};
+
+// A conjunction of restrictions on single clustering key columns.
+//
+// Carried by the slice of a filtering query, so that replicas can drop the rows
+// whose clustering key doesn't satisfy the query's restrictions, which the
+// coordinator would filter out anyway, reading paths which support it before
+// the row is even deserialized. Only the clustering key is restricted: a row
+// has the same key in all mutation sources, while the value of a regular column
+// in one source can be overwritten by another, so rows can't be dropped on it
+// before the sources are merged.
+class clustering_row_filter {
+    std::vector<clustering_column_restriction> _restrictions;
+public:
+    explicit clustering_row_filter(std::vector<clustering_column_restriction> restrictions)
+        : _restrictions(std::move(restrictions))
+    { }
+
+    const std::vector<clustering_column_restriction>& restrictions() const {
+        return _restrictions;
+    }
+
+    // Whether a row with the given key can satisfy the restrictions. Columns
+    // missing from a prefix key are not checked.
+    bool operator()(const schema&, const clustering_key_prefix&) const;
+
+    friend std::ostream& operator<<(std::ostream& out, const clustering_row_filter& f);
+};
+
 constexpr auto max_rows = std::numeric_limits<uint64_t>::max();
 constexpr auto partition_max_rows = std::numeric_limits<uint64_t>::max();
 constexpr auto max_rows_if_set = std::numeric_limits<uint32_t>::max();
@@ -170,6 +207,13 @@ class partition_slice {
         // directly, bypassing the intermediate reconcilable_result format used
         // in pre 4.5 range scans.
         range_scan_data_variant,
+        // Readers may return the cells of the columns the slice doesn't
+        // select without their values, which only saves reading them when
+        // the result doesn't include them, like query::result does. The
+        // cells are still there, for the liveness of their rows. Set by the
+        // replica on its own copy of the slice of data queries, see
+        // can_omit_unselected_cell_values(), never sent over the wire.
+        omit_unselected_cell_values,
     };
     using option_set = enum_set<super_enum<option,
         option::send_clustering_key,
@@ -184,7 +228,8 @@ class partition_slice {
         option::with_digest,
         option::bypass_cache,
         option::always_return_static_content,
-        option::range_scan_data_variant>>;
+        option::range_scan_data_variant,
+        option::omit_unselected_cell_values>>;
     clustering_row_ranges _row_ranges;
 public:
     column_id_vector static_columns; // TODO: consider using bitmap
@@ -195,18 +240,21 @@ class partition_slice {
     cql_serialization_format _cql_format;
     uint32_t _partition_row_limit_low_bits;
     uint32_t _partition_row_limit_high_bits;
+    std::optional<clustering_row_filter> _row_filter;
 public:
     partition_slice(clustering_row_ranges row_ranges, column_id_vector static_columns,
         column_id_vector regular_columns, option_set options,
         std::unique_ptr<specific_ranges> specific_ranges,
         cql_serialization_format,
         uint32_t partition_row_limit_low_bits,
-        uint32_t partition_row_limit_high_bits);
+        uint32_t partition_row_limit_high_bits,
+        std::optional<clustering_row_filter> row_filter);
     partition_slice(clustering_row_ranges row_ranges, column_id_vector static_columns,
         column_id_vector regular_columns, option_set options,
         std::unique_ptr<specific_ranges> specific_ranges = nullptr,
         cql_serialization_format = cql_serialization_format::internal(),
-        uint64_t partition_row_limit = partition_max_rows);
+        uint64_t partition_row_limit = partition_max_rows,
+        std::optional<clustering_row_filter> row_filter = {});
     partition_slice(clustering_row_ranges ranges, const schema& schema, const column_set& mask, option_set options);
     partition_slice(const partition_slice&);
     partition_slice(partition_slice&&);
@@ -245,6 +293,11 @@ class partition_slice {
         _partition_row_limit_low_bits = static_cast<uint64_t>(limit);
         _partition_row_limit_high_bits = static_cast<uint64_t>(limit >> 32);
     }
+    // Rows rejected by the filter may be dropped by the replicas, see
+    // clustering_row_filter.
+    const std::optional<clustering_row_filter>& get_row_filter() const {
+        return _row_filter;
+    }
 
     [[nodiscard]]
     bool is_reversed() const {
@@ -255,6 +308,12 @@ class partition_slice {
     friend std::ostream& operator<<(std::ostream& out, const specific_ranges& ps);
 };
 
+// Whether data queries with the slice can read with
+// partition_slice::option::omit_unselected_cell_values. Only readers of reads
+// bypassing the cache omit values, the cache would be populated with the cells
+// without them.
+bool can_omit_unselected_cell_values(const schema& s, const partition_slice& slice);
+
 // See docs/dev/reverse-reads.md
 // In the following functions, `schema` may be reversed or not (both work).
 partition_slice legacy_reverse_slice_to_native_reverse_slice(const schema& schema, partition_slice slice);
@@ -393,6 +452,10 @@ struct forward_request {
         // Used by selector_factries to prepare reductions information
         std::vector<reduction_type> types;
         std::vector<aggregation_info> infos;
+        // For every selector, the partition key component it selects, or
+        // nullopt if it is a reduction. Only queries grouped by partition
+        // select partition key columns.
+        std::vector<std::optional<uint32_t>> partition_key_components;
     };
 
     std::vector<reduction_type> reduction_types;
@@ -403,6 +466,10 @@ struct forward_request {
     db::consistency_level cl;
     lowres_clock::time_point timeout;
     std::optional<std::vector<aggregation_info>> aggregation_infos;
+    // When set, the aggregates are computed for every partition, rather than
+    // for all of them, and the result has up to this many groups: the first
+    // ones in ring order (see forward_result::grouped_query_results).
+    std::optional<uint32_t> group_by_partition_limit;
 };
 
 std::ostream& operator<<(std::ostream& out, const forward_request& r);
@@ -412,6 +479,10 @@ std::ostream& operator<<(std::ostream& out, const forward_request::aggregation_i
 struct forward_result {
     // vector storing query result for each selected column
     std::vector<bytes_opt> query_results;
+    // The groups of a query grouped by partition, in ring order. Each has the
+    // partition key components, followed by a query result for each selected
+    // column.
+    std::vector<std::vector<bytes_opt>> grouped_query_results;
 
     struct printer {
         const std::vector<::shared_ptr<db::functions::aggregate_function>>& functions;
@@ -51,6 +51,9 @@ std::ostream& operator<<(std::ostream& out, const partition_slice& ps) {
     out << ", options=" << format("{:x}", ps.options.mask()); // FIXME: pretty print options
     out << ", cql_format=" << ps.cql_format();
     out << ", partition_row_limit=" << ps.partition_row_limit();
+    if (ps._row_filter) {
+        out << ", row_filter=" << *ps._row_filter;
+    }
     return out << "}";
 }
 
@@ -96,6 +99,9 @@ std::ostream& operator<<(std::ostream& out, const forward_request& r) {
     if(r.aggregation_infos) {
         out << ", aggregation_infos=[" << join(",", r.aggregation_infos.value()) << "]";
     }
+    if (r.group_by_partition_limit) {
+        out << ", group_by_partition_limit=" << *r.group_by_partition_limit;
+    }
     return out << ", cmd=" << r.cmd
         << ", pr=" << r.pr
         << ", cl=" << r.cl
@@ -107,6 +113,53 @@ std::ostream& operator<<(std::ostream& out, const specific_ranges& s) {
     return out << "{" << s._pk << " : " << join(", ", s._ranges) << "}";
 }
 
+bool clustering_row_filter::operator()(const schema& s, const clustering_key_prefix& key) const {
+    const auto key_size = key.size(s);
+    for (auto& r : _restrictions) {
+        if (r.column >= key_size) {
+            continue;
+        }
+        auto& type = s.clustering_column_at(r.column).type->without_reversed();
+        auto value = key.get_component(s, r.column);
+        if (!r.values.empty()) {
+            // The values are sorted as per the type.
+            auto it = std::lower_bound(r.values.begin(), r.values.end(), value, [&type] (const bytes& v, managed_bytes_view k) {
+                return type.compare(managed_bytes_view(bytes_view(v)), k) < 0;
+            });
+            if (it == r.values.end() || type.compare(managed_bytes_view(bytes_view(*it)), value) != 0) {
+                return false;
+            }
+            continue;
+        }
+        if (auto& start = r.range.start()) {
+            auto c = type.compare(managed_bytes_view(bytes_view(start->value())), value);
+            if (c > 0 || (c == 0 && !start->is_inclusive())) {
+                return false;
+            }
+        }
+        if (auto& end = r.range.end()) {
+            auto c = type.compare(value, managed_bytes_view(bytes_view(end->value())));
+            if (c > 0 || (c == 0 && !end->is_inclusive())) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+std::ostream& operator<<(std::ostream& out, const clustering_row_filter& f) {
+    out << "{";
+    for (auto& r : f._restrictions) {
+        out << (&r == &f._restrictions.front() ? "" : ", ") << r.column << ": ";
+        if (!r.values.empty()) {
+            out << "[" << join(", ", r.values) << "]";
+        } else {
+            out << r.range;
+        }
+    }
+    return out << "}";
+}
+
 void trim_clustering_row_ranges_to(const schema& s, clustering_row_ranges& ranges, position_in_partition_view pos, bool reversed) {
     auto cmp = [reversed, cmp = position_in_partition::composite_tri_compare(s)] (const auto& a, const auto& b) {
         return reversed ? cmp(b, a) : cmp(a, b);
@@ -160,6 +213,11 @@ static void reverse_clustering_ranges_bounds(clustering_row_ranges& ranges) {
     }
 }
 
+bool can_omit_unselected_cell_values(const schema& s, const partition_slice& slice) {
+    return slice.options.contains<partition_slice::option::bypass_cache>()
+            && (slice.regular_columns.size() < s.regular_columns_count() || slice.static_columns.size() < s.static_columns_count());
+}
+
 partition_slice legacy_reverse_slice_to_native_reverse_slice(const schema& schema, partition_slice slice) {
     return partition_slice_builder(schema, std::move(slice))
         .mutate_ranges([] (clustering_row_ranges& ranges) { reverse_clustering_ranges_bounds(ranges); })
@@ -207,7 +265,8 @@ partition_slice::partition_slice(clustering_row_ranges row_ranges,
     std::unique_ptr<specific_ranges> specific_ranges,
     cql_serialization_format cql_format,
     uint32_t partition_row_limit_low_bits,
-    uint32_t partition_row_limit_high_bits)
+    uint32_t partition_row_limit_high_bits,
+    std::optional<clustering_row_filter> row_filter)
     : _row_ranges(std::move(row_ranges))
     , static_columns(std::move(static_columns))
     , regular_columns(std::move(regular_columns))
@@ -216,6 +275,7 @@ partition_slice::partition_slice(clustering_row_ranges row_ranges,
     , _cql_format(std::move(cql_format))
     , _partition_row_limit_low_bits(partition_row_limit_low_bits)
     , _partition_row_limit_high_bits(partition_row_limit_high_bits)
+    , _row_filter(std::move(row_filter))
 {}
 
 partition_slice::partition_slice(clustering_row_ranges row_ranges,
@@ -224,10 +284,11 @@ partition_slice::partition_slice(clustering_row_ranges row_ranges,
     option_set options,
     std::unique_ptr<specific_ranges> specific_ranges,
     cql_serialization_format cql_format,
-    uint64_t partition_row_limit)
+    uint64_t partition_row_limit,
+    std::optional<clustering_row_filter> row_filter)
     : partition_slice(std::move(row_ranges), std::move(static_columns), std::move(regular_columns), options,
             std::move(specific_ranges), std::move(cql_format), static_cast<uint32_t>(partition_row_limit),
-            static_cast<uint32_t>(partition_row_limit >> 32))
+            static_cast<uint32_t>(partition_row_limit >> 32), std::move(row_filter))
 {}
 
 partition_slice::partition_slice(clustering_row_ranges ranges, const schema& s, const column_set& columns, option_set options)
@@ -259,6 +320,7 @@ partition_slice::partition_slice(const partition_slice& s)
     , _cql_format(s._cql_format)
     , _partition_row_limit_low_bits(s._partition_row_limit_low_bits)
     , _partition_row_limit_high_bits(s._partition_row_limit_high_bits)
+    , _row_filter(s._row_filter)
 {}
 
 partition_slice::~partition_slice()
@@ -422,6 +484,9 @@ foreign_ptr<lw_shared_ptr<query::result>> result_merger::get() {
 }
 
 std::ostream& operator<<(std::ostream& out, const query::forward_result::printer& p) {
+    if (!p.res.grouped_query_results.empty()) {
+        return out << "[" << p.res.grouped_query_results.size() << " groups]";
+    }
     if (p.functions.size() != p.res.query_results.size()) {
         return out << "[malformed forward_result (" << p.res.query_results.size()
             << " results, " << p.functions.size() << " aggregates)]";
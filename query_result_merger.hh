@@ -19,6 +19,9 @@ class result_merger {
     std::vector<foreign_ptr<lw_shared_ptr<query::result>>> _partial;
     const uint64_t _max_rows;
     const uint32_t _max_partitions;
+    // Of the partial results kept, when their counts are known.
+    uint64_t _row_count = 0;
+    uint64_t _partition_count = 0;
 public:
     explicit result_merger(uint64_t max_rows, uint32_t max_partitions)
             : _max_rows(max_rows)
@@ -29,10 +32,19 @@ class result_merger {
         _partial.reserve(size);
     }
 
+    // Results following a short one, or arriving once the limits are reached,
+    // would be dropped by get(), so they are released right away.
     void operator()(foreign_ptr<lw_shared_ptr<query::result>> r) {
         if (!_partial.empty() && _partial.back()->is_short_read()) {
             return;
         }
+        if (!_partial.empty() && (_row_count >= _max_rows || _partition_count >= _max_partitions)) {
+            return;
+        }
+        if (r->row_count() && r->partition_count()) {
+            _row_count += *r->row_count();
+            _partition_count += *r->partition_count();
+        }
         _partial.emplace_back(std::move(r));
     }
 
@@ -82,6 +82,7 @@ class reader_permit::impl
     bool _marked_as_blocked = false;
     db::timeout_clock::time_point _timeout;
     query::max_result_size _max_result_size{query::result_memory_limiter::unlimited_result_size};
+    reader_permit::read_stats _stats;
 
 private:
     void on_permit_used() {
@@ -326,6 +327,10 @@ class reader_permit::impl
     void set_max_result_size(query::max_result_size s) {
         _max_result_size = std::move(s);
     }
+
+    reader_permit::read_stats& stats() noexcept {
+        return _stats;
+    }
 };
 
 static_assert(std::is_nothrow_copy_constructible_v<reader_permit>);
@@ -434,6 +439,22 @@ void reader_permit::set_max_result_size(query::max_result_size s) {
     _impl->set_max_result_size(std::move(s));
 }
 
+reader_permit::read_stats& reader_permit::stats() noexcept {
+    return _impl->stats();
+}
+
+const reader_permit::read_stats& reader_permit::stats() const noexcept {
+    return _impl->stats();
+}
+
+std::ostream& operator<<(std::ostream& os, const reader_permit::read_stats& s) {
+    fmt::print(os, "sstables: {}, disk bytes: {}, cached file pages: {} hits / {} misses,"
+            " cache partitions: {} hits / {} misses, cache rows: {} hits / {} misses",
+            s.sstables_read, s.disk_bytes_read, s.cached_file_page_hits, s.cached_file_page_misses,
+            s.cache_partition_hits, s.cache_partition_misses, s.cache_row_hits, s.cache_row_misses);
+    return os;
+}
+
 std::ostream& operator<<(std::ostream& os, reader_permit::state s) {
     switch (s) {
         case reader_permit::state::waiting:
@@ -617,7 +638,13 @@ future<> reader_concurrency_semaphore::execution_loop() noexcept {
             auto e = _ready_list.pop();
 
             try {
-                e.func(std::move(e.permit)).forward_to(std::move(e.pr));
+                // The copy of the permit keeps the semaphore alive until the continuation runs.
+                auto permit = e.permit;
+                e.func(std::move(e.permit)).then_wrapped([this, permit = std::move(permit), start = std::chrono::steady_clock::now()] (future<> f) {
+                    auto d = std::chrono::steady_clock::now() - start;
+                    _avg_read_time = _avg_read_time.count() ? (_avg_read_time * 7 + d) / 8 : d;
+                    return f;
+                }).forward_to(std::move(e.pr));
             } catch (...) {
                 e.pr.set_exception(std::current_exception());
             }
@@ -659,15 +686,15 @@ reader_concurrency_semaphore::~reader_concurrency_semaphore() {
         on_internal_error_noexcept(rcslog, format("~reader_concurrency_semaphore(): semaphore {} not stopped before destruction", _name));
         // With the below conditions, we can get away with the semaphore being
         // unstopped. In this case don't force an abort.
-        assert(_inactive_reads.empty() && !_close_readers_gate.get_count() && !_permit_gate.get_count() && !_execution_loop_future);
+        assert(!has_inactive_reads() && !_close_readers_gate.get_count() && !_permit_gate.get_count() && !_execution_loop_future);
         broken();
     }
 }
 
-reader_concurrency_semaphore::inactive_read_handle reader_concurrency_semaphore::register_inactive_read(flat_mutation_reader_v2 reader) noexcept {
+reader_concurrency_semaphore::inactive_read_handle reader_concurrency_semaphore::register_inactive_read(flat_mutation_reader_v2 reader, resume_cost cost) noexcept {
     auto& permit_impl = *reader.permit()._impl;
     permit_impl.on_register_as_inactive();
-    // Implies _inactive_reads.empty(), we don't queue new readers before
+    // Implies !has_inactive_reads(), we don't queue new readers before
     // evicting all inactive reads.
     // Checking the _wait_list covers the count resources only, so check memory
     // separately.
@@ -675,7 +702,7 @@ reader_concurrency_semaphore::inactive_read_handle reader_concurrency_semaphore:
       try {
         auto irp = std::make_unique<inactive_read>(std::move(reader));
         auto& ir = *irp;
-        _inactive_reads.push_back(ir);
+        (cost == resume_cost::high ? _costly_inactive_reads : _inactive_reads).push_back(ir);
         ++_stats.inactive_reads;
         return inactive_read_handle(*this, *irp.release());
       } catch (...) {
@@ -732,34 +759,44 @@ flat_mutation_reader_v2_opt reader_concurrency_semaphore::unregister_inactive_re
     return std::move(irp->reader);
 }
 
+bool reader_concurrency_semaphore::has_inactive_reads() const noexcept {
+    return !_inactive_reads.empty() || !_costly_inactive_reads.empty();
+}
+
+reader_concurrency_semaphore::inactive_read& reader_concurrency_semaphore::next_inactive_read_to_evict() noexcept {
+    return _inactive_reads.empty() ? _costly_inactive_reads.front() : _inactive_reads.front();
+}
+
 bool reader_concurrency_semaphore::try_evict_one_inactive_read(evict_reason reason) {
-    if (_inactive_reads.empty()) {
+    if (!has_inactive_reads()) {
         return false;
     }
-    evict(_inactive_reads.front(), reason);
+    evict(next_inactive_read_to_evict(), reason);
     return true;
 }
 
 void reader_concurrency_semaphore::clear_inactive_reads() {
-    while (!_inactive_reads.empty()) {
-        auto& ir = _inactive_reads.front();
+    while (has_inactive_reads()) {
+        auto& ir = next_inactive_read_to_evict();
         close_reader(std::move(ir.reader));
         // Destroying the read unlinks it too.
-        std::unique_ptr<inactive_read> _(&*_inactive_reads.begin());
+        std::unique_ptr<inactive_read> _(&ir);
     }
 }
 
 future<> reader_concurrency_semaphore::evict_inactive_reads_for_table(table_id id) noexcept {
     inactive_reads_type evicted_readers;
-    auto it = _inactive_reads.begin();
-    while (it != _inactive_reads.end()) {
-        auto& ir = *it;
-        ++it;
-        if (ir.reader.schema()->id() == id) {
-            do_detach_inactive_reader(ir, evict_reason::manual);
-            ir.ttl_timer.cancel();
-            ir.unlink();
-            evicted_readers.push_back(ir);
+    for (auto* list : {&_inactive_reads, &_costly_inactive_reads}) {
+        auto it = list->begin();
+        while (it != list->end()) {
+            auto& ir = *it;
+            ++it;
+            if (ir.reader.schema()->id() == id) {
+                do_detach_inactive_reader(ir, evict_reason::manual);
+                ir.ttl_timer.cancel();
+                ir.unlink();
+                evicted_readers.push_back(ir);
+            }
         }
     }
     while (!evicted_readers.empty()) {
@@ -867,8 +904,8 @@ void reader_concurrency_semaphore::evict_readers_in_background() {
     // Evict inactive readers in the background while wait list isn't empty
     // This is safe since stop() closes _gate;
     (void)with_gate(_close_readers_gate, [this] {
-        return do_until([this] { return _wait_list.empty() || _inactive_reads.empty(); }, [this] {
-            return detach_inactive_reader(_inactive_reads.front(), evict_reason::permit).close();
+        return do_until([this] { return _wait_list.empty() || !has_inactive_reads(); }, [this] {
+            return detach_inactive_reader(next_inactive_read_to_evict(), evict_reason::permit).close();
         });
     });
  }
@@ -883,7 +920,7 @@ future<> reader_concurrency_semaphore::do_wait_admission(reader_permit permit, r
 
     if (!has_available_units(permit.base_resources())) {
         auto fut = enqueue_waiter(std::move(permit), std::move(func));
-        if (!_inactive_reads.empty()) {
+        if (has_inactive_reads()) {
             evict_readers_in_background();
         }
         return fut;
@@ -904,6 +941,15 @@ future<> reader_concurrency_semaphore::do_wait_admission(reader_permit permit, r
 void reader_concurrency_semaphore::maybe_admit_waiters() noexcept {
     while (!_wait_list.empty() && _ready_list.empty() && has_available_units(_wait_list.front().permit.base_resources()) && all_used_permits_are_stalled()) {
         auto& x = _wait_list.front();
+        // Admitting a read which is expected to time out anyway would only
+        // waste resources the reads behind it could use.
+        if (x.func && _avg_read_time.count() && x.permit.timeout() != db::no_timeout
+                && x.permit.timeout() - db::timeout_clock::now() < _avg_read_time) {
+            ++_stats.total_reads_shed_due_to_deadline;
+            x.pr.set_exception(named_semaphore_timed_out(_name));
+            _wait_list.pop_front();
+            continue;
+        }
         try {
             x.permit.on_admission();
             ++_stats.reads_admitted;
@@ -1036,11 +1082,17 @@ class tracking_file_impl : public file_impl {
     }
 
     virtual future<size_t> read_dma(uint64_t pos, void* buffer, size_t len, const io_priority_class& pc) override {
-        return get_file_impl(_tracked_file)->read_dma(pos, buffer, len, pc);
+        return get_file_impl(_tracked_file)->read_dma(pos, buffer, len, pc).then([this] (size_t n) {
+            _permit.stats().disk_bytes_read += n;
+            return n;
+        });
     }
 
     virtual future<size_t> read_dma(uint64_t pos, std::vector<iovec> iov, const io_priority_class& pc) override {
-        return get_file_impl(_tracked_file)->read_dma(pos, iov, pc);
+        return get_file_impl(_tracked_file)->read_dma(pos, iov, pc).then([this] (size_t n) {
+            _permit.stats().disk_bytes_read += n;
+            return n;
+        });
     }
 
     virtual future<> flush(void) override {
@@ -1081,6 +1133,7 @@ class tracking_file_impl : public file_impl {
 
     virtual future<temporary_buffer<uint8_t>> dma_read_bulk(uint64_t offset, size_t range_size, const io_priority_class& pc) override {
         return get_file_impl(_tracked_file)->dma_read_bulk(offset, range_size, pc).then([this, units = _permit.consume_memory(range_size)] (temporary_buffer<uint8_t> buf) {
+            _permit.stats().disk_bytes_read += buf.size();
             return make_ready_future<temporary_buffer<uint8_t>>(make_tracked_temporary_buffer(std::move(buf), _permit));
         });
     }
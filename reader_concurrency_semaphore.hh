@@ -58,6 +58,17 @@ class reader_concurrency_semaphore {
 
     using eviction_notify_handler = noncopyable_function<void(evict_reason)>;
 
+    /// How costly it is to recreate an inactive read after it was evicted.
+    ///
+    /// Reads paused inside a partition have to find their clustering position
+    /// in the promoted index of every sstable again on resumption, which for a
+    /// paged scan of a wide partition is repeated on every page. Such reads
+    /// are evicted only after all reads paused at a partition boundary.
+    enum class resume_cost {
+        low,
+        high,
+    };
+
     struct stats {
         // The number of inactive reads evicted to free up permits.
         uint64_t permit_based_evictions = 0;
@@ -71,6 +82,9 @@ class reader_concurrency_semaphore {
         uint64_t total_failed_reads = 0;
         // Total number of reads rejected because the admission queue reached its max capacity
         uint64_t total_reads_shed_due_to_overload = 0;
+        // Total number of waiting reads failed with a timeout instead of being
+        // admitted, because they had less time left than reads usually take.
+        uint64_t total_reads_shed_due_to_deadline = 0;
         // Total number of reads admitted, via all admission paths.
         uint64_t reads_admitted = 0;
         // Total number of reads enqueued to wait for admission.
@@ -175,10 +189,14 @@ class reader_concurrency_semaphore {
 
     expiring_fifo<entry, expiry_handler, db::timeout_clock> _wait_list;
     queue<entry> _ready_list;
+    // Moving average of the time reads executed via the ready list take.
+    std::chrono::steady_clock::duration _avg_read_time{0};
 
     sstring _name;
     size_t _max_queue_length = std::numeric_limits<size_t>::max();
+    // Inactive reads, in the order of their registration, per resume_cost.
     inactive_reads_type _inactive_reads;
+    inactive_reads_type _costly_inactive_reads;
     stats _stats;
     permit_list_type _permit_list;
     bool _stopped = false;
@@ -190,6 +208,9 @@ class reader_concurrency_semaphore {
     void do_detach_inactive_reader(inactive_read&, evict_reason reason) noexcept;
     [[nodiscard]] flat_mutation_reader_v2 detach_inactive_reader(inactive_read&, evict_reason reason) noexcept;
     void evict(inactive_read&, evict_reason reason) noexcept;
+    bool has_inactive_reads() const noexcept;
+    // The inactive read to evict first. There must be at least one.
+    inactive_read& next_inactive_read_to_evict() noexcept;
 
     bool has_available_units(const resources& r) const;
 
@@ -273,7 +294,8 @@ class reader_concurrency_semaphore {
     ///
     /// The semaphore takes ownership of the passed in reader for the duration
     /// of its inactivity and it may evict it to free up resources if necessary.
-    inactive_read_handle register_inactive_read(flat_mutation_reader_v2 ir) noexcept;
+    /// Reads with a high resume cost are evicted after all the others.
+    inactive_read_handle register_inactive_read(flat_mutation_reader_v2 ir, resume_cost cost = resume_cost::low) noexcept;
 
     /// Set the inactive read eviction notification handler and optionally eviction ttl.
     ///
@@ -424,4 +446,16 @@ class reader_concurrency_semaphore {
     void set_max_queue_length(size_t size) {
         _max_queue_length = size;
     }
+
+    /// The moving average of the time reads executed via the ready list take.
+    ///
+    /// Waiting reads with less time left than this are failed instead of
+    /// being admitted.
+    std::chrono::steady_clock::duration average_read_time() const {
+        return _avg_read_time;
+    }
+
+    void set_average_read_time_for_tests(std::chrono::steady_clock::duration d) {
+        _avg_read_time = d;
+    }
 };
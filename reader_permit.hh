@@ -93,6 +93,18 @@ class reader_permit {
 
     class impl;
 
+    /// What the read cost, accumulated by the readers using the permit.
+    struct read_stats {
+        uint64_t sstables_read = 0;
+        uint64_t disk_bytes_read = 0;
+        uint64_t cached_file_page_hits = 0;
+        uint64_t cached_file_page_misses = 0;
+        uint64_t cache_partition_hits = 0;
+        uint64_t cache_partition_misses = 0;
+        uint64_t cache_row_hits = 0;
+        uint64_t cache_row_misses = 0;
+    };
+
 private:
     shared_ptr<impl> _impl;
 
@@ -161,8 +173,13 @@ class reader_permit {
 
     query::max_result_size max_result_size() const;
     void set_max_result_size(query::max_result_size);
+
+    read_stats& stats() noexcept;
+    const read_stats& stats() const noexcept;
 };
 
+std::ostream& operator<<(std::ostream& os, const reader_permit::read_stats& s);
+
 using reader_permit_opt = optimized_optional<reader_permit>;
 
 class reader_permit::resource_units {
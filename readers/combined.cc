@@ -12,6 +12,7 @@
 #include "readers/empty_v2.hh"
 #include "readers/clustering_combined.hh"
 #include "readers/combined.hh"
+#include "utils/tournament_tree.hh"
 
 extern logging::logger mrlog;
 
@@ -252,8 +253,29 @@ class mutation_reader_merger {
     // reader in order to enter gallop mode. Must be greater than one.
     static constexpr int gallop_mode_entering_threshold = 3;
 private:
-    struct reader_heap_compare;
-    struct fragment_heap_compare;
+    struct reader_tree_compare {
+        const schema& s;
+
+        explicit reader_tree_compare(const schema& s)
+            : s(s) {
+        }
+
+        bool operator()(const reader_and_fragment& a, const reader_and_fragment& b) const {
+            return a.fragment.as_partition_start().key().less_compare(s, b.fragment.as_partition_start().key());
+        }
+    };
+
+    struct fragment_tree_compare {
+        position_in_partition::less_compare cmp;
+
+        explicit fragment_tree_compare(const schema& s)
+            : cmp(s) {
+        }
+
+        bool operator()(const reader_and_fragment& a, const reader_and_fragment& b) const {
+            return cmp(a.fragment.position(), b.fragment.position());
+        }
+    };
 
     struct needs_merge_tag { };
     using needs_merge = bool_class<needs_merge_tag>;
@@ -274,10 +296,10 @@ class mutation_reader_merger {
     // Readers positioned at a partition, different from the one we are
     // reading from now. For these readers the attached fragment is
     // always partition_start. Used to pick the next partition.
-    merger_vector<reader_and_fragment> _reader_heap;
+    utils::tournament_tree<reader_and_fragment, reader_tree_compare, merger_small_vector_size> _reader_tree;
     // Readers and their current fragments, belonging to the current
     // partition.
-    merger_vector<reader_and_fragment> _fragment_heap;
+    utils::tournament_tree<reader_and_fragment, fragment_tree_compare, merger_small_vector_size> _fragment_tree;
     merger_vector<reader_and_last_fragment_kind> _next;
     // Readers that reached EOS.
     merger_vector<reader_and_last_fragment_kind> _halted_readers;
@@ -309,7 +331,7 @@ class mutation_reader_merger {
     future<needs_merge> advance_galloping_reader();
     future<> prepare_next();
     // Collect all forwardable readers into _next, and remove them from
-    // their previous containers (_halted_readers and _fragment_heap).
+    // their previous containers (_halted_readers and _fragment_tree).
     void prepare_forwardable_readers();
 public:
     mutation_reader_merger(schema_ptr schema,
@@ -393,32 +415,6 @@ void mutation_reader_merger::add_readers(std::vector<flat_mutation_reader_v2> ne
     }
 }
 
-struct mutation_reader_merger::reader_heap_compare {
-    const schema& s;
-
-    explicit reader_heap_compare(const schema& s)
-        : s(s) {
-    }
-
-    bool operator()(const mutation_reader_merger::reader_and_fragment& a, const mutation_reader_merger::reader_and_fragment& b) {
-        // Invert comparison as this is a max-heap.
-        return b.fragment.as_partition_start().key().less_compare(s, a.fragment.as_partition_start().key());
-    }
-};
-
-struct mutation_reader_merger::fragment_heap_compare {
-    position_in_partition::less_compare cmp;
-
-    explicit fragment_heap_compare(const schema& s)
-        : cmp(s) {
-    }
-
-    bool operator()(const mutation_reader_merger::reader_and_fragment& a, const mutation_reader_merger::reader_and_fragment& b) {
-        // Invert comparison as this is a max-heap.
-        return cmp(b.fragment.position(), a.fragment.position());
-    }
-};
-
 bool mutation_reader_merger::in_gallop_mode() const {
     return _gallop_mode_hits >= gallop_mode_entering_threshold;
 }
@@ -427,11 +423,11 @@ void mutation_reader_merger::maybe_add_readers_at_partition_boundary() {
     // We are either crossing partition boundary or ran out of
     // readers. If there are halted readers then we are just
     // waiting for a fast-forward so there is nothing to do.
-    if (_fragment_heap.empty() && _halted_readers.empty()) {
-        if (_reader_heap.empty()) {
+    if (_fragment_tree.empty() && _halted_readers.empty()) {
+        if (_reader_tree.empty()) {
             maybe_add_readers(std::nullopt);
         } else {
-            maybe_add_readers(_reader_heap.front().fragment.as_partition_start().key());
+            maybe_add_readers(_reader_tree.front().fragment.as_partition_start().key());
         }
     }
 }
@@ -457,13 +453,12 @@ future<mutation_reader_merger::needs_merge> mutation_reader_merger::prepare_one(
     return (*rk.reader)().then([this, rk, reader_galloping] (mutation_fragment_v2_opt mfo) {
         if (mfo) {
             if (mfo->is_partition_start()) {
-                _reader_heap.emplace_back(rk.reader, std::move(*mfo));
-                boost::push_heap(_reader_heap, reader_heap_compare(*_schema));
+                _reader_tree.push(reader_and_fragment(rk.reader, std::move(*mfo)));
             } else {
                 if (reader_galloping) {
-                    // Optimization: assume that galloping reader will keep winning, and compare directly with the heap front.
-                    // If this assumption is correct, we do one key comparison instead of pushing to/popping from the heap.
-                    if (_fragment_heap.empty() || position_in_partition::less_compare(*_schema)(mfo->position(), _fragment_heap.front().fragment.position())) {
+                    // Optimization: assume that galloping reader will keep winning, and compare directly with the tree front.
+                    // If this assumption is correct, we do one key comparison instead of pushing to/popping from the tree.
+                    if (_fragment_tree.empty() || position_in_partition::less_compare(*_schema)(mfo->position(), _fragment_tree.front().fragment.position())) {
                         _current.clear();
                         _current.emplace_back(std::move(*mfo), &*_galloping_reader.reader);
                         _galloping_reader.last_kind = _current.back().fragment.mutation_fragment_kind();
@@ -473,8 +468,7 @@ future<mutation_reader_merger::needs_merge> mutation_reader_merger::prepare_one(
                     _gallop_mode_hits = 0;
                 }
 
-                _fragment_heap.emplace_back(rk.reader, std::move(*mfo));
-                boost::range::push_heap(_fragment_heap, fragment_heap_compare(*_schema));
+                _fragment_tree.push(reader_and_fragment(rk.reader, std::move(*mfo)));
             }
         } else if (_fwd_sm == streamed_mutation::forwarding::yes && rk.last_kind != mutation_fragment_v2::kind::partition_end) {
             // When in streamed_mutation::forwarding mode we need
@@ -514,7 +508,7 @@ future<mutation_reader_merger::needs_merge> mutation_reader_merger::prepare_one(
 }
 
 void mutation_reader_merger::prepare_forwardable_readers() {
-    _next.reserve(_halted_readers.size() + _fragment_heap.size() + _next.size());
+    _next.reserve(_halted_readers.size() + _fragment_tree.size() + _next.size());
 
     std::move(_halted_readers.begin(), _halted_readers.end(), std::back_inserter(_next));
     if (_single_reader.reader != reader_iterator{}) {
@@ -524,12 +518,12 @@ void mutation_reader_merger::prepare_forwardable_readers() {
         _next.emplace_back(_galloping_reader);
         _gallop_mode_hits = 0;
     }
-    for (auto& df : _fragment_heap) {
+    _fragment_tree.for_each([this] (const reader_and_fragment& df) {
         _next.emplace_back(df.reader, df.fragment.mutation_fragment_kind());
-    }
+    });
 
     _halted_readers.clear();
-    _fragment_heap.clear();
+    _fragment_tree.clear();
 }
 
 mutation_reader_merger::mutation_reader_merger(schema_ptr schema,
@@ -537,6 +531,8 @@ mutation_reader_merger::mutation_reader_merger(schema_ptr schema,
         streamed_mutation::forwarding fwd_sm,
         mutation_reader::forwarding fwd_mr)
     : _selector(std::move(selector))
+    , _reader_tree(reader_tree_compare(*schema))
+    , _fragment_tree(fragment_tree_compare(*schema))
     , _schema(std::move(schema))
     , _fwd_sm(fwd_sm)
     , _fwd_mr(fwd_mr) {
@@ -582,42 +578,39 @@ future<mutation_fragment_batch> mutation_reader_merger::operator()() {
 
     // If we ran out of fragments for the current partition, select the
     // readers for the next one.
-    if (_fragment_heap.empty()) {
-        if (!_halted_readers.empty() || _reader_heap.empty()) {
+    if (_fragment_tree.empty()) {
+        if (!_halted_readers.empty() || _reader_tree.empty()) {
             return make_ready_future<mutation_fragment_batch>(_current);
         }
 
-        auto key = [] (const merger_vector<reader_and_fragment>& heap) -> const dht::decorated_key& {
-            return heap.front().fragment.as_partition_start().key();
+        auto same_partition = [this] (const reader_and_fragment& a, const reader_and_fragment& b) {
+            return a.fragment.as_partition_start().key().equal(*_schema, b.fragment.as_partition_start().key());
         };
 
-        do {
-            boost::range::pop_heap(_reader_heap, reader_heap_compare(*_schema));
-            // All fragments here are partition_start so no need to
-            // heap-sort them.
-            _fragment_heap.emplace_back(std::move(_reader_heap.back()));
-            _reader_heap.pop_back();
-        }
-        while (!_reader_heap.empty() && key(_fragment_heap).equal(*_schema, key(_reader_heap)));
-        if (_fragment_heap.size() == 1) {
-            _single_reader = { _fragment_heap.back().reader, mutation_fragment_v2::kind::partition_start };
-            _current.emplace_back(std::move(_fragment_heap.back().fragment), &*_single_reader.reader);
-            _fragment_heap.clear();
+        auto first = _reader_tree.pop();
+        if (_reader_tree.empty() || !same_partition(first, _reader_tree.front())) {
+            _single_reader = { first.reader, mutation_fragment_v2::kind::partition_start };
+            _current.emplace_back(std::move(first.fragment), &*_single_reader.reader);
             _gallop_mode_hits = 0;
             return make_ready_future<mutation_fragment_batch>(_current);
         }
+        // All fragments here are partition_start, they are all popped
+        // together below.
+        do {
+            _fragment_tree.push(_reader_tree.pop());
+        }
+        while (!_reader_tree.empty() && same_partition(first, _reader_tree.front()));
+        _fragment_tree.push(std::move(first));
     }
 
     const auto equal = position_in_partition::equal_compare(*_schema);
     do {
-        boost::range::pop_heap(_fragment_heap, fragment_heap_compare(*_schema));
-        auto& n = _fragment_heap.back();
+        auto n = _fragment_tree.pop();
         const auto kind = n.fragment.mutation_fragment_kind();
         _current.emplace_back(std::move(n.fragment), &*n.reader);
         _next.emplace_back(n.reader, kind);
-        _fragment_heap.pop_back();
     }
-    while (!_fragment_heap.empty() && equal(_current.back().fragment.position(), _fragment_heap.front().fragment.position()));
+    while (!_fragment_tree.empty() && equal(_current.back().fragment.position(), _fragment_tree.front().fragment.position()));
 
     if (_next.size() == 1 && _next.front().reader == _galloping_reader.reader) {
         ++_gallop_mode_hits;
@@ -640,11 +633,11 @@ future<> mutation_reader_merger::next_partition() {
     //
     // The readers in _next are those which returned the last batch of fragments, thus they are
     // currently positioned either inside P or at the end of P, hence we need to forward them.
-    // Readers in _fragment_heap (or the _galloping_reader, if we're currently galloping) are obviously still in P,
+    // Readers in _fragment_tree (or the _galloping_reader, if we're currently galloping) are obviously still in P,
     // so we also need to forward those. Finally, _halted_readers must have been halted after returning
     // a fragment from P, hence must be forwarded.
     //
-    // The only readers that we must not forward are those in _reader_heap, since they already are positioned
+    // The only readers that we must not forward are those in _reader_tree, since they already are positioned
     // at the start of the next partition.
     prepare_forwardable_readers();
     for (auto& rk : _next) {
@@ -658,8 +651,8 @@ future<> mutation_reader_merger::fast_forward_to(const dht::partition_range& pr)
     _gallop_mode_hits = 0;
     _next.clear();
     _halted_readers.clear();
-    _fragment_heap.clear();
-    _reader_heap.clear();
+    _fragment_tree.clear();
+    _reader_tree.clear();
 
     for (auto it = _all_readers.begin(); it != _all_readers.end(); ++it) {
         _next.emplace_back(it, mutation_fragment_v2::kind::partition_end);
@@ -24,19 +24,17 @@ class filtering_reader : public flat_mutation_reader_v2::impl {
     virtual future<> fill_buffer() override {
         return do_until([this] { return is_buffer_full() || is_end_of_stream(); }, [this] {
             return _rd.fill_buffer().then([this] {
-                return do_until([this] { return _rd.is_buffer_empty(); }, [this] {
+                // Fragments are moved over in a plain loop, a continuation
+                // is only needed to skip a partition.
+                while (!_rd.is_buffer_empty()) {
                     auto mf = _rd.pop_mutation_fragment();
-                    if (mf.is_partition_start()) {
-                        auto& dk = mf.as_partition_start().key();
-                        if (!_filter(dk)) {
-                            return _rd.next_partition();
-                        }
+                    if (mf.is_partition_start() && !_filter(mf.as_partition_start().key())) {
+                        return _rd.next_partition();
                     }
                     push_mutation_fragment(std::move(mf));
-                    return make_ready_future<>();
-                }).then([this] {
-                    _end_of_stream = _rd.is_end_of_stream();
-                });
+                }
+                _end_of_stream = _rd.is_end_of_stream();
+                return make_ready_future<>();
             });
         });
     }
@@ -28,11 +28,14 @@ namespace {
 struct remote_fill_buffer_result_v2 {
     foreign_ptr<std::unique_ptr<const flat_mutation_reader_v2::tracked_buffer>> buffer;
     bool end_of_stream = false;
+    // The number of reads queued on the semaphore of the remote reader.
+    size_t semaphore_waiters = 0;
 
     remote_fill_buffer_result_v2() = default;
-    remote_fill_buffer_result_v2(flat_mutation_reader_v2::tracked_buffer&& buffer, bool end_of_stream)
+    remote_fill_buffer_result_v2(flat_mutation_reader_v2::tracked_buffer&& buffer, bool end_of_stream, size_t semaphore_waiters = 0)
         : buffer(make_foreign(std::make_unique<const flat_mutation_reader_v2::tracked_buffer>(std::move(buffer))))
-        , end_of_stream(end_of_stream) {
+        , end_of_stream(end_of_stream)
+        , semaphore_waiters(semaphore_waiters) {
     }
 };
 
@@ -283,7 +286,11 @@ class evictable_reader_v2 : public flat_mutation_reader_v2::impl {
 
 void evictable_reader_v2::do_pause(flat_mutation_reader_v2 reader) {
     assert(!_irh);
-    _irh = _permit.semaphore().register_inactive_read(std::move(reader));
+    // Resuming inside a partition is more costly, see reader_concurrency_semaphore::resume_cost.
+    auto cost = _next_position_in_partition.region() == partition_region::clustered
+            ? reader_concurrency_semaphore::resume_cost::high
+            : reader_concurrency_semaphore::resume_cost::low;
+    _irh = _permit.semaphore().register_inactive_read(std::move(reader), cost);
 }
 
 void evictable_reader_v2::maybe_pause(flat_mutation_reader_v2 reader) {
@@ -710,6 +717,8 @@ class shard_reader_v2 : public flat_mutation_reader_v2::impl {
     const mutation_reader::forwarding _fwd_mr;
     std::optional<future<>> _read_ahead;
     foreign_ptr<std::unique_ptr<evictable_reader_v2>> _reader;
+    // As of the last buffer fill.
+    size_t _remote_semaphore_waiters = 0;
 
 private:
     future<> do_fill_buffer();
@@ -756,6 +765,14 @@ class shard_reader_v2 : public flat_mutation_reader_v2::impl {
     bool is_read_ahead_in_progress() const {
         return _read_ahead.has_value();
     }
+    /// The number of reads which were queued on the semaphore of the shard
+    /// when the buffer was last filled.
+    size_t remote_semaphore_waiters() const {
+        return _remote_semaphore_waiters;
+    }
+    unsigned shard() const {
+        return _shard;
+    }
 };
 
 future<> shard_reader_v2::close() noexcept {
@@ -825,7 +842,7 @@ future<> shard_reader_v2::do_fill_buffer() {
                     tracing::trace(_trace_state, "Creating shard reader on shard: {}", this_shard_id());
                     reader_permit::used_guard ug{rreader->permit()};
                     co_await rreader->fill_buffer();
-                    auto res = remote_fill_buffer_result_v2(rreader->detach_buffer(), rreader->is_end_of_stream());
+                    auto res = remote_fill_buffer_result_v2(rreader->detach_buffer(), rreader->is_end_of_stream(), rreader->permit().semaphore().waiters());
                     co_return reader_and_buffer_fill_result{std::move(rreader), std::move(res)};
                 } catch (...) {
                     ex = std::current_exception();
@@ -839,7 +856,7 @@ future<> shard_reader_v2::do_fill_buffer() {
             co_return co_await smp::submit_to(_shard, coroutine::lambda([this] () -> future<remote_fill_buffer_result_v2>  {
                 reader_permit::used_guard ug{_reader->permit()};
                 co_await _reader->fill_buffer();
-                co_return remote_fill_buffer_result_v2(_reader->detach_buffer(), _reader->is_end_of_stream());
+                co_return remote_fill_buffer_result_v2(_reader->detach_buffer(), _reader->is_end_of_stream(), _reader->permit().semaphore().waiters());
             }));
         }
     });
@@ -850,6 +867,7 @@ future<> shard_reader_v2::do_fill_buffer() {
         co_await coroutine::maybe_yield();
     }
     _end_of_stream = res.end_of_stream;
+    _remote_semaphore_waiters = res.semaphore_waiters;
 }
 
 future<> shard_reader_v2::fill_buffer() {
@@ -923,6 +941,63 @@ void shard_reader_v2::read_ahead() {
 
 } // anonymous namespace
 
+multishard_read_ahead_concurrency::multishard_read_ahead_concurrency(unsigned shard_count, uint64_t row_limit, tracing::trace_state_ptr trace_state)
+    : _shard_count(shard_count)
+    , _row_limit(row_limit)
+    , _trace_state(std::move(trace_state)) {
+}
+
+template <typename... Args>
+void multishard_read_ahead_concurrency::set(unsigned concurrency, const char* reason_fmt, Args&&... reason_args) {
+    concurrency = std::max(concurrency, 1u);
+    if (concurrency == _concurrency) {
+        return;
+    }
+    if (_trace_state || mrlog.is_enabled(log_level::debug)) {
+        const auto reason = format(reason_fmt, std::forward<Args>(reason_args)...);
+        tracing::trace(_trace_state, "Multishard reader: read-ahead concurrency {} -> {}, {}", _concurrency, concurrency, reason);
+        mrlog.debug("multishard reader: read-ahead concurrency {} -> {}, {}", _concurrency, concurrency, reason);
+    }
+    _concurrency = concurrency;
+    _read_ahead_hits = 0;
+}
+
+void multishard_read_ahead_concurrency::on_shard_reached(bool buffer_filled, bool read_ahead_in_progress) {
+    // A filled buffer on arrival means the read-ahead kept up with the
+    // consumer. Once a whole round of read-aheads did, one less is enough.
+    if (buffer_filled) {
+        if (++_read_ahead_hits >= _concurrency && _concurrency > 1) {
+            set(_concurrency - 1, "read-ahead is ahead of the consumer");
+        }
+    } else if (!read_ahead_in_progress) {
+        _read_ahead_hits = 0;
+    }
+}
+
+void multishard_read_ahead_concurrency::on_empty_buffer_after_crossing_shards(unsigned shard, size_t semaphore_waiters) {
+    // Double the concurrency, so the next time we cross shards we will have
+    // more chances of hitting the reader's buffer. The concurrency is capped
+    // by what the row limit can still use, and halved when the shard we are
+    // on has reads queued, as reading ahead would compete with them.
+    const auto max_concurrency = max_useful_concurrency();
+    if (semaphore_waiters) {
+        set(std::min(_concurrency / 2, max_concurrency), "{} reads queued on shard {}", semaphore_waiters, shard);
+    } else if (_concurrency > max_concurrency) {
+        set(max_concurrency, "limited by the row limit");
+    } else {
+        set(std::min(_concurrency * 2, max_concurrency), "buffer of the next shard was empty");
+    }
+}
+
+unsigned multishard_read_ahead_concurrency::max_useful_concurrency() const {
+    // Reading ahead more shards than the rows missing until the limit
+    // would need, at the rows per buffer seen so far, is wasted.
+    const auto rows_per_fill = std::max(_buffer_fills ? _rows_emitted / _buffer_fills : 1, uint64_t(1));
+    const auto rows_missing = _row_limit > _rows_emitted ? _row_limit - _rows_emitted : 1;
+    const auto fills_missing = (rows_missing + rows_per_fill - 1) / rows_per_fill;
+    return std::min(fills_missing, uint64_t(_shard_count));
+}
+
 // See make_multishard_combining_reader() for description.
 class multishard_combining_reader_v2 : public flat_mutation_reader_v2::impl {
     struct shard_and_token {
@@ -943,11 +1018,13 @@ class multishard_combining_reader_v2 : public flat_mutation_reader_v2::impl {
     std::vector<shard_and_token> _shard_selection_min_heap;
     unsigned _current_shard;
     bool _crossed_shards;
-    unsigned _concurrency = 1;
+    tracing::trace_state_ptr _trace_state;
+    multishard_read_ahead_concurrency _concurrency;
 
     void on_partition_range_change(const dht::partition_range& pr);
     bool maybe_move_to_next_shard(const dht::token* const t = nullptr);
     future<> handle_empty_reader_buffer();
+    void read_ahead_on_next_shards();
 
 public:
     multishard_combining_reader_v2(
@@ -959,7 +1036,8 @@ class multishard_combining_reader_v2 : public flat_mutation_reader_v2::impl {
             const query::partition_slice& ps,
             const io_priority_class& pc,
             tracing::trace_state_ptr trace_state,
-            mutation_reader::forwarding fwd_mr);
+            mutation_reader::forwarding fwd_mr,
+            uint64_t row_limit);
 
     // this is captured.
     multishard_combining_reader_v2(const multishard_combining_reader_v2&) = delete;
@@ -1010,9 +1088,34 @@ bool multishard_combining_reader_v2::maybe_move_to_next_shard(const dht::token*
 
     _crossed_shards = true;
     _current_shard = next_shard;
+
+    auto& reader = *_shard_readers[_current_shard];
+    _concurrency.on_shard_reached(!reader.is_buffer_empty(), reader.is_read_ahead_in_progress());
     return true;
 }
 
+void multishard_combining_reader_v2::read_ahead_on_next_shards() {
+    // Read ahead shouldn't change the min selection heap so we work on a local copy.
+    auto shard_selection_min_heap_copy = _shard_selection_min_heap;
+
+    // We kick-off concurrency-1 read-aheads in the background. They will be
+    // brought to the foreground when we move to their respective shard.
+    // Shards which had reads queued on their semaphore when last read are
+    // skipped, the read-ahead would add to their queue and to the latency of
+    // their foreground reads.
+    for (unsigned i = 1; i < _concurrency.get() && !shard_selection_min_heap_copy.empty(); ++i) {
+        boost::pop_heap(shard_selection_min_heap_copy);
+        const auto next_shard = shard_selection_min_heap_copy.back().shard;
+        shard_selection_min_heap_copy.pop_back();
+        auto& reader = *_shard_readers[next_shard];
+        if (auto waiters = reader.remote_semaphore_waiters()) {
+            tracing::trace(_trace_state, "Multishard reader: not reading ahead on shard {}, {} reads queued there", next_shard, waiters);
+            continue;
+        }
+        reader.read_ahead();
+    }
+}
+
 future<> multishard_combining_reader_v2::handle_empty_reader_buffer() {
     auto& reader = *_shard_readers[_current_shard];
 
@@ -1023,30 +1126,18 @@ future<> multishard_combining_reader_v2::handle_empty_reader_buffer() {
             maybe_move_to_next_shard();
         }
         return make_ready_future<>();
-    } else if (reader.is_read_ahead_in_progress()) {
-        return reader.fill_buffer();
-    } else {
-        // If we crossed shards and the next reader has an empty buffer we
-        // double concurrency so the next time we cross shards we will have
-        // more chances of hitting the reader's buffer.
-        if (_crossed_shards) {
-            _concurrency = std::min(_concurrency * 2, _sharder.shard_count());
-
-            // Read ahead shouldn't change the min selection heap so we work on a local copy.
-            auto shard_selection_min_heap_copy = _shard_selection_min_heap;
-
-            // If concurrency > 1 we kick-off concurrency-1 read-aheads in the
-            // background. They will be brought to the foreground when we move
-            // to their respective shard.
-            for (unsigned i = 1; i < _concurrency && !shard_selection_min_heap_copy.empty(); ++i) {
-                boost::pop_heap(shard_selection_min_heap_copy);
-                const auto next_shard = shard_selection_min_heap_copy.back().shard;
-                shard_selection_min_heap_copy.pop_back();
-                _shard_readers[next_shard]->read_ahead();
-            }
-        }
+    }
+
+    _concurrency.on_buffer_fill();
+    if (reader.is_read_ahead_in_progress()) {
         return reader.fill_buffer();
     }
+
+    if (_crossed_shards) {
+        _concurrency.on_empty_buffer_after_crossing_shards(reader.shard(), reader.remote_semaphore_waiters());
+        read_ahead_on_next_shards();
+    }
+    return reader.fill_buffer();
 }
 
 multishard_combining_reader_v2::multishard_combining_reader_v2(
@@ -1058,8 +1149,9 @@ multishard_combining_reader_v2::multishard_combining_reader_v2(
         const query::partition_slice& ps,
         const io_priority_class& pc,
         tracing::trace_state_ptr trace_state,
-        mutation_reader::forwarding fwd_mr)
-    : impl(std::move(s), std::move(permit)), _sharder(sharder) {
+        mutation_reader::forwarding fwd_mr,
+        uint64_t row_limit)
+    : impl(std::move(s), std::move(permit)), _sharder(sharder), _trace_state(trace_state), _concurrency(sharder.shard_count(), row_limit, trace_state) {
 
     on_partition_range_change(pr);
 
@@ -1082,6 +1174,9 @@ future<> multishard_combining_reader_v2::fill_buffer() {
             if (const auto& mf = reader.peek_buffer(); mf.is_partition_start() && maybe_move_to_next_shard(&mf.as_partition_start().key().token())) {
                 return make_ready_future<>();
             }
+            if (const auto& mf = reader.peek_buffer(); mf.is_clustering_row() || mf.is_static_row()) {
+                _concurrency.on_row_emitted();
+            }
             push_mutation_fragment(reader.pop_mutation_fragment());
         }
         return make_ready_future<>();
@@ -1123,10 +1218,11 @@ flat_mutation_reader_v2 make_multishard_combining_reader_v2(
         const query::partition_slice& ps,
         const io_priority_class& pc,
         tracing::trace_state_ptr trace_state,
-        mutation_reader::forwarding fwd_mr) {
+        mutation_reader::forwarding fwd_mr,
+        uint64_t row_limit) {
     const dht::sharder& sharder = schema->get_sharder();
     return make_flat_mutation_reader_v2<multishard_combining_reader_v2>(sharder, std::move(lifecycle_policy), std::move(schema), std::move(permit), pr, ps, pc,
-            std::move(trace_state), fwd_mr);
+            std::move(trace_state), fwd_mr, row_limit);
 }
 
 flat_mutation_reader_v2 make_multishard_combining_reader_v2_for_tests(
@@ -1138,7 +1234,8 @@ flat_mutation_reader_v2 make_multishard_combining_reader_v2_for_tests(
         const query::partition_slice& ps,
         const io_priority_class& pc,
         tracing::trace_state_ptr trace_state,
-        mutation_reader::forwarding fwd_mr) {
+        mutation_reader::forwarding fwd_mr,
+        uint64_t row_limit) {
     return make_flat_mutation_reader_v2<multishard_combining_reader_v2>(sharder, std::move(lifecycle_policy), std::move(schema), std::move(permit), pr, ps, pc,
-            std::move(trace_state), fwd_mr);
+            std::move(trace_state), fwd_mr, row_limit);
 }
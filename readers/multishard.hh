@@ -116,6 +116,17 @@ class reader_lifecycle_policy_v2 {
 /// For dense tables (where we rarely cross shards) we rely on the
 /// foreign_reader to issue sufficient read-aheads on its own to avoid blocking.
 ///
+/// The concurrency is adjusted to the conditions of the read:
+/// * it is decreased by one when a whole round of read-aheads found the buffers
+///   filled by the time the reader moved to them, as the consumer is the
+///   bottleneck;
+/// * it is halved when the shard moved to has reads queued on its semaphore,
+///   and no read-ahead is issued on shards which had reads queued when they
+///   were last read, to keep the impact on the foreground reads bounded;
+/// * it is capped by the number of buffers needed to reach `row_limit`, at the
+///   rows per buffer seen so far.
+/// The adjustments are traced.
+///
 /// The readers' life-cycles are managed through the supplied lifecycle policy.
 flat_mutation_reader_v2 make_multishard_combining_reader_v2(
         shared_ptr<reader_lifecycle_policy_v2> lifecycle_policy,
@@ -125,7 +136,50 @@ flat_mutation_reader_v2 make_multishard_combining_reader_v2(
         const query::partition_slice& ps,
         const io_priority_class& pc,
         tracing::trace_state_ptr trace_state = nullptr,
-        mutation_reader::forwarding fwd_mr = mutation_reader::forwarding::no);
+        mutation_reader::forwarding fwd_mr = mutation_reader::forwarding::no,
+        uint64_t row_limit = std::numeric_limits<uint64_t>::max());
+
+/// The read-ahead concurrency of the multishard reader.
+///
+/// Implements the adjustments described at make_multishard_combining_reader_v2().
+/// Separate from the reader so it can be tested on its own.
+class multishard_read_ahead_concurrency {
+    const unsigned _shard_count;
+    const uint64_t _row_limit;
+    tracing::trace_state_ptr _trace_state;
+    unsigned _concurrency = 1;
+    // Consecutive moves to a shard which found its buffer filled.
+    unsigned _read_ahead_hits = 0;
+    uint64_t _rows_emitted = 0;
+    uint64_t _buffer_fills = 0;
+
+private:
+    // The reason is only formatted if the change is traced or logged.
+    template <typename... Args>
+    void set(unsigned concurrency, const char* reason_fmt, Args&&... reason_args);
+
+public:
+    multishard_read_ahead_concurrency(unsigned shard_count, uint64_t row_limit, tracing::trace_state_ptr trace_state = nullptr);
+
+    unsigned get() const {
+        return _concurrency;
+    }
+    void on_row_emitted() {
+        ++_rows_emitted;
+    }
+    /// A shard reader's buffer has to be filled, in the foreground.
+    void on_buffer_fill() {
+        ++_buffer_fills;
+    }
+    /// The reader moved to a shard, whose reader's buffer is filled or not.
+    void on_shard_reached(bool buffer_filled, bool read_ahead_in_progress);
+    /// The reader moved to a shard within a single fill_buffer() and found
+    /// its buffer empty. This shard had semaphore_waiters reads queued on
+    /// its semaphore as of the last buffer fill.
+    void on_empty_buffer_after_crossing_shards(unsigned shard, size_t semaphore_waiters);
+    /// The number of shards worth reading, until the row limit is reached.
+    unsigned max_useful_concurrency() const;
+};
 
 flat_mutation_reader_v2 make_multishard_combining_reader_v2_for_tests(
         const dht::sharder& sharder,
@@ -136,5 +190,6 @@ flat_mutation_reader_v2 make_multishard_combining_reader_v2_for_tests(
         const query::partition_slice& ps,
         const io_priority_class& pc,
         tracing::trace_state_ptr trace_state = nullptr,
-        mutation_reader::forwarding fwd_mr = mutation_reader::forwarding::no);
+        mutation_reader::forwarding fwd_mr = mutation_reader::forwarding::no,
+        uint64_t row_limit = std::numeric_limits<uint64_t>::max());
 
@@ -6,6 +6,8 @@
  * SPDX-License-Identifier: AGPL-3.0-or-later
  */
 
+#include <algorithm>
+
 #include <seastar/util/lazy.hh>
 
 #include "readers/flat_mutation_reader_v2.hh"
@@ -201,11 +203,25 @@ namespace {
 
 }
 
+void mutation_fragment_stream_validating_filter::maybe_sample_partition() {
+    if (!_sampling_ratio) {
+        return;
+    }
+    _sampled = _sampling_credit >= 1;
+    if (_sampled) {
+        _sampling_credit -= 1;
+        ++_partitions_sampled;
+    }
+    _sampling_credit += _sampling_ratio;
+}
+
 bool mutation_fragment_stream_validating_filter::operator()(const dht::decorated_key& dk) {
-    if (_validation_level < mutation_fragment_stream_validation_level::token) {
+    maybe_sample_partition();
+    const auto level = current_level();
+    if (level < mutation_fragment_stream_validation_level::token) {
         return true;
     }
-    if (_validation_level == mutation_fragment_stream_validation_level::token) {
+    if (level == mutation_fragment_stream_validation_level::token) {
         if (_validator(dk.token())) {
             return true;
         }
@@ -221,10 +237,14 @@ bool mutation_fragment_stream_validating_filter::operator()(const dht::decorated
 }
 
 mutation_fragment_stream_validating_filter::mutation_fragment_stream_validating_filter(sstring_view name, const schema& s,
-        mutation_fragment_stream_validation_level level)
+        mutation_fragment_stream_validation_level level, double sampling_ratio)
     : _validator(s)
     , _name(format("{} ({}.{} {})", name, s.ks_name(), s.cf_name(), s.id()))
     , _validation_level(level)
+    // Sampling only adds the key checks to the token checks, the
+    // partition_region level is used by streams which don't have ordered keys.
+    , _sampling_ratio(level >= mutation_fragment_stream_validation_level::token && level < mutation_fragment_stream_validation_level::clustering_key
+            ? std::clamp(sampling_ratio, 0.0, 1.0) : 0.0)
 {
     if (mrlog.is_enabled(log_level::debug)) {
         std::string_view what;
@@ -242,27 +262,35 @@ mutation_fragment_stream_validating_filter::mutation_fragment_stream_validating_
                 what = "partition region, partition key and clustering key";
                 break;
         }
-        mrlog.debug("[validator {} for {}] Will validate {} monotonicity.", static_cast<void*>(this), _name, what);
+        if (_sampling_ratio) {
+            mrlog.debug("[validator {} for {}] Will validate {} monotonicity, and clustering key monotonicity in {}% of the partitions.",
+                    static_cast<void*>(this), _name, what, _sampling_ratio * 100);
+        } else {
+            mrlog.debug("[validator {} for {}] Will validate {} monotonicity.", static_cast<void*>(this), _name, what);
+        }
     }
 }
 
 bool mutation_fragment_stream_validating_filter::operator()(mutation_fragment_v2::kind kind, position_in_partition_view pos,
         std::optional<tombstone> new_current_tombstone) {
     bool valid = false;
+    const auto level = current_level();
 
     mrlog.debug("[validator {}] {}:{} new_current_tombstone: {}", static_cast<void*>(this), kind, pos, new_current_tombstone);
 
-    if (_validation_level >= mutation_fragment_stream_validation_level::clustering_key) {
+    ++_fragments_validated;
+    if (level >= mutation_fragment_stream_validation_level::clustering_key) {
+        ++_fragments_fully_validated;
         valid = _validator(kind, pos, new_current_tombstone);
     } else {
         valid = _validator(kind, new_current_tombstone);
     }
 
     if (__builtin_expect(!valid, false)) {
-        if (_validation_level >= mutation_fragment_stream_validation_level::clustering_key) {
+        if (level >= mutation_fragment_stream_validation_level::clustering_key) {
             on_validation_error(mrlog, format("[validator {} for {}] Unexpected mutation fragment: partition key {}: previous {}:{}, current {}:{}",
                     static_cast<void*>(this), _name, _validator.previous_partition_key(), _validator.previous_mutation_fragment_kind(), _validator.previous_position(), kind, pos));
-        } else if (_validation_level >= mutation_fragment_stream_validation_level::partition_key) {
+        } else if (level >= mutation_fragment_stream_validation_level::partition_key) {
             on_validation_error(mrlog, format("[validator {} for {}] Unexpected mutation fragment: partition key {}: previous {}, current {}",
                     static_cast<void*>(this), _name, _validator.previous_partition_key(), _validator.previous_mutation_fragment_kind(), kind));
         } else if (kind == mutation_fragment_v2::kind::partition_end && _validator.current_tombstone()) {
@@ -314,7 +342,8 @@ bool mutation_fragment_stream_validating_filter::on_end_of_partition() {
 }
 
 void mutation_fragment_stream_validating_filter::on_end_of_stream() {
-    mrlog.debug("[validator {}] EOS", static_cast<const void*>(this));
+    mrlog.debug("[validator {}] EOS, validated {} fragments, {} of them fully, in {} sampled partitions", static_cast<const void*>(this),
+            _fragments_validated, _fragments_fully_validated, _partitions_sampled);
     if (!_validator.on_end_of_stream()) {
         on_validation_error(mrlog, format("[validator {} for {}] Stream ended with unclosed partition: {}", static_cast<const void*>(this), _name,
                 _validator.previous_mutation_fragment_kind()));
@@ -379,8 +408,14 @@ future<bool> flat_mutation_reader_v2::impl::fill_buffer_from(Source& source) {
             return fill_buffer_from(source);
         });
     } else {
-        while (!source.is_buffer_empty() && !is_buffer_full()) {
-            push_mutation_fragment(source.pop_mutation_fragment());
+        if (is_buffer_empty()) {
+            // Take over the source buffer as a whole, rather than moving the
+            // fragments over one by one.
+            source.move_buffer_content_to(*this);
+        } else {
+            while (!source.is_buffer_empty() && !is_buffer_full()) {
+                push_mutation_fragment(source.pop_mutation_fragment());
+            }
         }
         return make_ready_future<bool>(source.is_end_of_stream() && source.is_buffer_empty());
     }
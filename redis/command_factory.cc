@@ -10,6 +10,7 @@
 #include "service/storage_proxy.hh"
 #include "redis/commands.hh"
 #include "log.hh"
+#include <unordered_set>
 
 namespace redis {
 
@@ -22,11 +23,13 @@ future<redis_message> command_factory::create_execute(service::storage_proxy& pr
         { "ping", commands::ping },
         { "select", commands::select },
         { "get", commands::get },
+        { "mget", commands::mget },
         { "exists", commands::exists },
         { "ttl", commands::ttl },
         { "strlen", commands::strlen },
         { "set", commands::set },
         { "setex", commands::setex },
+        { "mset", commands::mset },
         { "del", commands::del },
         { "echo", commands::echo },
         { "lolwut", commands::lolwut },
@@ -35,6 +38,14 @@ future<redis_message> command_factory::create_execute(service::storage_proxy& pr
         { "hgetall", commands::hgetall },
         { "hdel", commands::hdel },
         { "hexists", commands::hexists },
+        { "lpush", commands::lpush },
+        { "rpush", commands::rpush },
+        { "lrange", commands::lrange },
+        { "llen", commands::llen },
+        { "sadd", commands::sadd },
+        { "smembers", commands::smembers },
+        { "scard", commands::scard },
+        { "sismember", commands::sismember },
     };
     auto&& command = _commands.find(req._command);
     if (command != _commands.end()) {
@@ -45,4 +56,12 @@ future<redis_message> command_factory::create_execute(service::storage_proxy& pr
     return commands::unknown(proxy, req, options, permit);
 }
 
+bool command_factory::is_read_only(const bytes& command) {
+    static thread_local const std::unordered_set<bytes> read_only_commands = {
+        "ping", "get", "mget", "exists", "ttl", "strlen", "echo", "lolwut", "hget", "hgetall", "hexists",
+        "lrange", "llen", "smembers", "scard", "sismember",
+    };
+    return read_only_commands.contains(command);
+}
+
 }
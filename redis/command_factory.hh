@@ -22,5 +22,9 @@ class command_factory {
     command_factory() {}
     ~command_factory() {}
     static seastar::future<redis_message> create_execute(service::storage_proxy&, request&, redis::redis_options&, service_permit);
+    // True if the command neither writes nor changes the options of the
+    // connection, so it can run concurrently with the other such commands
+    // of the connection.
+    static bool is_read_only(const bytes& command);
 };
 }
@@ -8,6 +8,8 @@
 
 #include "redis/commands.hh"
 #include <seastar/core/shared_ptr.hh>
+#include <boost/range/irange.hpp>
+#include <unordered_set>
 #include "redis/request.hh"
 #include "redis/reply.hh"
 #include "types.hh"
@@ -36,12 +38,31 @@ future<redis_message> get(service::storage_proxy& proxy, request& req, redis::re
     });
 }
 
+future<redis_message> mget(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit) {
+    if (req.arguments_size() < 1) {
+        throw wrong_number_of_arguments_exception(req._command);
+    }
+    // The keys are read in parallel, and the values are replied in the
+    // order of the keys.
+    return do_with(std::vector<bytes_opt>(req.arguments_size()), [&proxy, &options, permit, &req] (std::vector<bytes_opt>& values) {
+        return seastar::parallel_for_each(boost::irange<size_t>(0, req.arguments_size()), [&proxy, &options, permit, &req, &values] (size_t i) {
+            return redis::read_strings(proxy, options, req._args[i], permit).then([&values, i] (lw_shared_ptr<strings_result> result) {
+                if (result->has_result()) {
+                    values[i] = std::move(result->result());
+                }
+            });
+        }).then([&values] () {
+            return redis_message::make_strings_list_result(values);
+        });
+    });
+}
+
 future<redis_message> exists(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit) {
     if (req.arguments_size() < 1) {
         throw wrong_arguments_exception(1, req.arguments_size(), req._command);
     }
     return do_with(size_t(0), [&proxy, &options, permit, &req] (size_t& count) {
-        return seastar::do_for_each(req._args, [&proxy, &options, permit, &count] (auto& key) {
+        return seastar::parallel_for_each(req._args, [&proxy, &options, permit, &count] (auto& key) {
             return redis::read_strings(proxy, options, key, permit).then([&count] (lw_shared_ptr<strings_result> result) {
                 if (result->has_result()) {
                     count++;
@@ -172,6 +193,22 @@ future<redis_message> setex(service::storage_proxy& proxy, request& req, redis::
     });
 }
 
+future<redis_message> mset(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit) {
+    if (req.arguments_size() == 0 || req.arguments_size() % 2 != 0) {
+        throw wrong_number_of_arguments_exception(req._command);
+    }
+    // All the keys are written by one storage_proxy::mutate(), which sends
+    // the writes of the different keys in parallel.
+    std::vector<std::pair<bytes, bytes>> entries;
+    entries.reserve(req.arguments_size() / 2);
+    for (size_t i = 0; i < req.arguments_size(); i += 2) {
+        entries.emplace_back(std::move(req._args[i]), std::move(req._args[i + 1]));
+    }
+    return redis::write_strings(proxy, options, std::move(entries), permit).then([] {
+        return redis_message::ok();
+    });
+}
+
 future<redis_message> del(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit) {
     if (req.arguments_size() == 0) {
         throw wrong_number_of_arguments_exception(req._command);
@@ -184,6 +221,117 @@ future<redis_message> del(service::storage_proxy& proxy, request& req, redis::re
     });
 }
 
+static long parse_long(const bytes& b, const bytes& command) {
+    try {
+        return std::stol(std::string(reinterpret_cast<const char*>(b.data()), b.size()));
+    } catch (...) {
+        throw invalid_arguments_exception(command);
+    }
+}
+
+static future<redis_message> push(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit, bool head) {
+    if (req.arguments_size() < 2) {
+        throw wrong_number_of_arguments_exception(req._command);
+    }
+    auto values = std::vector<bytes>(std::make_move_iterator(req._args.begin() + 1), std::make_move_iterator(req._args.end()));
+    // The length of the list is counted after the push, so it includes the
+    // values pushed concurrently by other clients.
+    return redis::write_list(proxy, options, bytes(req._args[0]), std::move(values), head, permit).then([&proxy, &options, &req, permit] {
+        return redis::count_list(proxy, options, req._args[0], permit).then([] (uint64_t count) {
+            return redis_message::number(count);
+        });
+    });
+}
+
+future<redis_message> lpush(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit) {
+    return push(proxy, req, options, std::move(permit), true);
+}
+
+future<redis_message> rpush(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit) {
+    return push(proxy, req, options, std::move(permit), false);
+}
+
+future<redis_message> lrange(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit) {
+    if (req.arguments_size() != 3) {
+        throw wrong_arguments_exception(3, req.arguments_size(), req._command);
+    }
+    long start = parse_long(req._args[1], req._command);
+    long stop = parse_long(req._args[2], req._command);
+    // Counting from the head, only the values until stop are read, but
+    // counting from the tail needs the length of the list.
+    uint64_t limit = start >= 0 && stop >= 0 ? uint64_t(stop) + 1 : query::max_rows;
+    return redis::read_list(proxy, options, req._args[0], limit, permit).then([start, stop] (auto result) mutable {
+        long size = result->size();
+        if (start < 0) {
+            start = std::max(start + size, 0L);
+        }
+        if (stop < 0) {
+            stop += size;
+        }
+        stop = std::min(stop, size - 1);
+        std::vector<bytes> values;
+        if (start <= stop) {
+            values.assign(std::make_move_iterator(result->begin() + start), std::make_move_iterator(result->begin() + stop + 1));
+        }
+        return redis_message::make_strings_list_result(values);
+    });
+}
+
+future<redis_message> llen(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit) {
+    if (req.arguments_size() != 1) {
+        throw wrong_arguments_exception(1, req.arguments_size(), req._command);
+    }
+    return redis::count_list(proxy, options, req._args[0], permit).then([] (uint64_t count) {
+        return redis_message::number(count);
+    });
+}
+
+future<redis_message> sadd(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit) {
+    if (req.arguments_size() < 2) {
+        throw wrong_number_of_arguments_exception(req._command);
+    }
+    // The reply is the number of the members which weren't in the set, so
+    // it's read before the write.
+    return redis::read_set(proxy, options, req._args[0], permit).then([&proxy, &options, &req, permit] (auto result) {
+        std::unordered_set<bytes> existing(std::make_move_iterator(result->begin()), std::make_move_iterator(result->end()));
+        std::unordered_set<bytes> members(std::make_move_iterator(req._args.begin() + 1), std::make_move_iterator(req._args.end()));
+        size_t added = 0;
+        for (const auto& member : members) {
+            added += !existing.contains(member);
+        }
+        return redis::write_set(proxy, options, bytes(req._args[0]), std::vector<bytes>(members.begin(), members.end()), permit).then([added] {
+            return redis_message::number(added);
+        });
+    });
+}
+
+future<redis_message> smembers(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit) {
+    if (req.arguments_size() != 1) {
+        throw wrong_arguments_exception(1, req.arguments_size(), req._command);
+    }
+    return redis::read_set(proxy, options, req._args[0], permit).then([] (auto result) {
+        return redis_message::make_strings_list_result(*result);
+    });
+}
+
+future<redis_message> scard(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit) {
+    if (req.arguments_size() != 1) {
+        throw wrong_arguments_exception(1, req.arguments_size(), req._command);
+    }
+    return redis::count_set(proxy, options, req._args[0], permit).then([] (uint64_t count) {
+        return redis_message::number(count);
+    });
+}
+
+future<redis_message> sismember(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit) {
+    if (req.arguments_size() != 2) {
+        throw wrong_arguments_exception(2, req.arguments_size(), req._command);
+    }
+    return redis::read_set(proxy, options, req._args[0], req._args[1], permit).then([] (auto result) {
+        return redis_message::number(result->empty() ? 0 : 1);
+    });
+}
+
 future<redis_message> select(service::storage_proxy&, request& req, redis::redis_options& options, service_permit) {
     if (req.arguments_size() != 1) {
         throw wrong_arguments_exception(1, req.arguments_size(), req._command);
@@ -17,6 +17,7 @@ namespace commands {
 
 // request& instead of request&& to make sure ownership is managed by the caller
 future<redis_message> get(service::storage_proxy&, request&, redis_options&, service_permit);
+future<redis_message> mget(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit);
 future<redis_message> exists(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit);
 future<redis_message> ttl(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit);
 future<redis_message> strlen(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit);
@@ -27,6 +28,15 @@ future<redis_message> hdel(service::storage_proxy& proxy, request& req, redis::r
 future<redis_message> hexists(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit);
 future<redis_message> set(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit);
 future<redis_message> setex(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit);
+future<redis_message> mset(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit);
+future<redis_message> lpush(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit);
+future<redis_message> rpush(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit);
+future<redis_message> lrange(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit);
+future<redis_message> llen(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit);
+future<redis_message> sadd(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit);
+future<redis_message> smembers(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit);
+future<redis_message> scard(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit);
+future<redis_message> sismember(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit);
 future<redis_message> del(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit);
 future<redis_message> unknown(service::storage_proxy&, request&, redis_options&, service_permit);
 future<redis_message> select(service::storage_proxy&, request& req, redis::redis_options& options, service_permit);
@@ -15,6 +15,8 @@
 #include "redis/options.hh"
 #include "mutation.hh"
 #include "service_permit.hh"
+#include "utils/UUID_gen.hh"
+#include <seastar/core/byteorder.hh>
 
 using namespace seastar;
 
@@ -71,6 +73,67 @@ future<> write_strings(service::storage_proxy& proxy, redis::redis_options& opti
     return proxy.mutate(std::vector<mutation> {std::move(m)}, write_consistency_level, timeout, nullptr, permit, db::allow_per_partition_rate_limit::yes);
 }
 
+future<> write_strings(service::storage_proxy& proxy, redis::redis_options& options, std::vector<std::pair<bytes, bytes>>&& entries, service_permit permit) {
+    db::timeout_clock::time_point timeout = db::timeout_clock::now() + options.get_write_timeout();
+    std::vector<mutation> mutations;
+    mutations.reserve(entries.size());
+    for (auto& [key, data] : entries) {
+        mutations.push_back(make_mutation(proxy, options, std::move(key), std::move(data), 0));
+    }
+    auto write_consistency_level = options.get_write_consistency_level();
+    return proxy.mutate(std::move(mutations), write_consistency_level, timeout, nullptr, permit, db::allow_per_partition_rate_limit::yes);
+}
+
+// The clustering key of a value pushed to a list orders it before all the
+// values of the list, if pushed to its head, or after all of them. This
+// doesn't need to read the list: the key is a byte for the end of the list,
+// 0 for the head and 1 for the tail, then the big-endian timestamp of a new
+// time UUID, complemented for the head, so later pushes come first, and then
+// the UUID and the shard, which make the key unique.
+static bytes list_position(bool head) {
+    auto uuid = utils::UUID_gen::get_time_UUID();
+    uint64_t ts = uuid.timestamp();
+    bytes position(bytes::initialized_later(), 1 + sizeof(uint64_t) + 16 + sizeof(uint16_t));
+    auto p = reinterpret_cast<char*>(position.begin());
+    *p++ = head ? 0 : 1;
+    write_be<uint64_t>(p, head ? ~ts : ts);
+    p += sizeof(uint64_t);
+    auto serialized_uuid = uuid.serialize();
+    std::copy(serialized_uuid.begin(), serialized_uuid.end(), reinterpret_cast<int8_t*>(p));
+    p += serialized_uuid.size();
+    write_be<uint16_t>(p, this_shard_id());
+    return position;
+}
+
+future<> write_list(service::storage_proxy& proxy, redis::redis_options& options, bytes&& key, std::vector<bytes>&& values, bool head, service_permit permit) {
+    db::timeout_clock::time_point timeout = db::timeout_clock::now() + options.get_write_timeout();
+    auto schema = get_schema(proxy, options.get_keyspace_name(), redis::LISTs);
+    const column_definition& column = *schema->get_column_definition(redis::DATA_COLUMN_NAME);
+    auto m = mutation(schema, partition_key::from_single_value(*schema, key));
+    // The values get increasing time UUIDs, so each is pushed after the
+    // ones before it, like LPUSH and RPUSH of several values do.
+    for (auto& value : values) {
+        auto ckey = clustering_key::from_single_value(*schema, list_position(head));
+        m.set_clustered_cell(ckey, column, make_cell(schema, *(column.type.get()), value));
+    }
+    auto write_consistency_level = options.get_write_consistency_level();
+    return proxy.mutate(std::vector<mutation> {std::move(m)}, write_consistency_level, timeout, nullptr, permit, db::allow_per_partition_rate_limit::yes);
+}
+
+future<> write_set(service::storage_proxy& proxy, redis::redis_options& options, bytes&& key, std::vector<bytes>&& members, service_permit permit) {
+    db::timeout_clock::time_point timeout = db::timeout_clock::now() + options.get_write_timeout();
+    auto schema = get_schema(proxy, options.get_keyspace_name(), redis::SETs);
+    // The members are the clustering keys, and the only regular column is
+    // the empty value of the compact table.
+    const column_definition& column = schema->regular_column_at(0);
+    auto m = mutation(schema, partition_key::from_single_value(*schema, key));
+    for (auto& member : members) {
+        auto ckey = clustering_key::from_single_value(*schema, member);
+        m.set_clustered_cell(ckey, column, make_cell(schema, *(column.type.get()), bytes_view()));
+    }
+    auto write_consistency_level = options.get_write_consistency_level();
+    return proxy.mutate(std::vector<mutation> {std::move(m)}, write_consistency_level, timeout, nullptr, permit, db::allow_per_partition_rate_limit::yes);
+}
 
 mutation make_tombstone(service::storage_proxy& proxy, const redis_options& options, const sstring& cf_name, const bytes& key) {
     auto schema = get_schema(proxy, options.get_keyspace_name(), cf_name);
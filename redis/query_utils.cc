@@ -145,6 +145,133 @@ future<lw_shared_ptr<std::map<bytes, bytes>>> read_hashes(service::storage_proxy
     return query_hashes(proxy, options, key, permit, schema, ps);
 }
 
+// Collects the single clustering key column of the live rows of a
+// partition, or the single regular column.
+class rows_result_builder {
+    lw_shared_ptr<std::vector<bytes>> _data;
+    const query::partition_slice& _partition_slice;
+    const schema_ptr _schema;
+    const bool _keys;
+public:
+    rows_result_builder(lw_shared_ptr<std::vector<bytes>> data, const schema_ptr schema, const query::partition_slice& ps, bool keys)
+        : _data(data)
+        , _partition_slice(ps)
+        , _schema(schema)
+        , _keys(keys)
+    {
+    }
+    void accept_new_partition(const partition_key& key, uint32_t row_count) {}
+    void accept_new_partition(uint32_t row_count) {}
+    void accept_new_row(const clustering_key& key, const query::result_row_view& static_row, const query::result_row_view& row)
+    {
+        auto row_iterator = row.iterator();
+        auto cell = row_iterator.next_atomic_cell();
+        if (!cell) {
+            return;
+        }
+        if (_keys) {
+            _data->push_back(std::move(key.explode().front()));
+            return;
+        }
+        const column_definition& col = _schema->regular_column_at(_partition_slice.regular_columns.front());
+        cell->value().with_linearized([this, &col] (bytes_view cell_view) {
+            _data->push_back(col.type->deserialize_value(cell_view).serialize_nonnull());
+        });
+    }
+    void accept_new_row(const query::result_row_view& static_row, const query::result_row_view& row) {}
+    void accept_partition_end(const query::result_row_view& static_row) {}
+};
+
+static future<lw_shared_ptr<std::vector<bytes>>> query_rows(service::storage_proxy& proxy, const redis_options& options, const bytes& key, service_permit permit, schema_ptr schema, query::partition_slice ps, uint64_t limit, bool keys) {
+    const auto max_result_size = proxy.get_max_result_size(ps);
+    const auto max_tombstones = proxy.get_tombstone_limit();
+    query::read_command cmd(schema->id(), schema->version(), ps, max_result_size, max_tombstones, query::row_limit(limit), query::partition_limit(1), gc_clock::now(), std::nullopt, query_id::create_null_id(), query::is_first_page::no);
+    auto pkey = partition_key::from_single_value(*schema, key);
+    auto partition_range = dht::partition_range::make_singular(dht::decorate_key(*schema, std::move(pkey)));
+    dht::partition_range_vector partition_ranges;
+    partition_ranges.emplace_back(std::move(partition_range));
+    auto read_consistency_level = options.get_read_consistency_level();
+    db::timeout_clock::time_point timeout = db::timeout_clock::now() + options.get_read_timeout();
+    return proxy.query(schema, make_lw_shared<query::read_command>(std::move(cmd)), std::move(partition_ranges), read_consistency_level, {timeout, permit, service::client_state::for_internal_calls()}).then([ps, schema, keys] (auto qr) {
+        return query::result_view::do_with(*qr.query_result, [&] (query::result_view v) {
+            auto pd = make_lw_shared<std::vector<bytes>>();
+            v.consume(ps, rows_result_builder(pd, schema, ps, keys));
+            return pd;
+        });
+    });
+}
+
+// Counts the live rows of a partition.
+class row_count_builder {
+    uint64_t& _count;
+public:
+    explicit row_count_builder(uint64_t& count) : _count(count) {}
+    void accept_new_partition(const partition_key& key, uint32_t row_count) {}
+    void accept_new_partition(uint32_t row_count) {}
+    void accept_new_row(const clustering_key& key, const query::result_row_view& static_row, const query::result_row_view& row) {
+        ++_count;
+    }
+    void accept_new_row(const query::result_row_view& static_row, const query::result_row_view& row) {
+        ++_count;
+    }
+    void accept_partition_end(const query::result_row_view& static_row) {}
+};
+
+// The slice selects neither the clustering key nor any regular column, so
+// the replicas send back only empty rows. A row still counts if any of its
+// cells is live, since rows are compacted before their columns are sliced.
+static future<uint64_t> count_rows(service::storage_proxy& proxy, const redis_options& options, const bytes& key, service_permit permit, schema_ptr schema) {
+    auto ps = partition_slice_builder(*schema)
+        .with_no_regular_columns()
+        .without_clustering_key_columns()
+        .build();
+    const auto max_result_size = proxy.get_max_result_size(ps);
+    const auto max_tombstones = proxy.get_tombstone_limit();
+    query::read_command cmd(schema->id(), schema->version(), ps, max_result_size, max_tombstones, query::row_limit::max, query::partition_limit(1), gc_clock::now(), std::nullopt, query_id::create_null_id(), query::is_first_page::no);
+    auto pkey = partition_key::from_single_value(*schema, key);
+    auto partition_range = dht::partition_range::make_singular(dht::decorate_key(*schema, std::move(pkey)));
+    dht::partition_range_vector partition_ranges;
+    partition_ranges.emplace_back(std::move(partition_range));
+    auto read_consistency_level = options.get_read_consistency_level();
+    db::timeout_clock::time_point timeout = db::timeout_clock::now() + options.get_read_timeout();
+    return proxy.query(schema, make_lw_shared<query::read_command>(std::move(cmd)), std::move(partition_ranges), read_consistency_level, {timeout, permit, service::client_state::for_internal_calls()}).then([ps] (auto qr) {
+        return query::result_view::do_with(*qr.query_result, [&] (query::result_view v) {
+            uint64_t count = 0;
+            v.consume(ps, row_count_builder(count));
+            return count;
+        });
+    });
+}
+
+future<lw_shared_ptr<std::vector<bytes>>> read_list(service::storage_proxy& proxy, const redis_options& options, const bytes& key, uint64_t limit, service_permit permit) {
+    auto schema = get_schema(proxy, options.get_keyspace_name(), redis::LISTs);
+    auto ps = partition_slice_builder(*schema).build();
+    return query_rows(proxy, options, key, permit, schema, std::move(ps), limit, false);
+}
+
+future<uint64_t> count_list(service::storage_proxy& proxy, const redis_options& options, const bytes& key, service_permit permit) {
+    return count_rows(proxy, options, key, permit, get_schema(proxy, options.get_keyspace_name(), redis::LISTs));
+}
+
+future<lw_shared_ptr<std::vector<bytes>>> read_set(service::storage_proxy& proxy, const redis_options& options, const bytes& key, service_permit permit) {
+    auto schema = get_schema(proxy, options.get_keyspace_name(), redis::SETs);
+    auto ps = partition_slice_builder(*schema).build();
+    return query_rows(proxy, options, key, permit, schema, std::move(ps), query::max_rows, true);
+}
+
+future<lw_shared_ptr<std::vector<bytes>>> read_set(service::storage_proxy& proxy, const redis_options& options, const bytes& key, const bytes& member, service_permit permit) {
+    auto schema = get_schema(proxy, options.get_keyspace_name(), redis::SETs);
+    auto ckey = clustering_key::from_single_value(*schema, member);
+    auto ps = partition_slice_builder(*schema)
+        .with_range(query::clustering_range::make_singular(ckey))
+        .build();
+    return query_rows(proxy, options, key, permit, schema, std::move(ps), 1, true);
+}
+
+future<uint64_t> count_set(service::storage_proxy& proxy, const redis_options& options, const bytes& key, service_permit permit) {
+    return count_rows(proxy, options, key, permit, get_schema(proxy, options.get_keyspace_name(), redis::SETs));
+}
+
 future<lw_shared_ptr<std::map<bytes, bytes>>> query_hashes(service::storage_proxy& proxy, const redis_options& options, const bytes& key, service_permit permit, schema_ptr schema, query::partition_slice ps) {
     const auto max_result_size = proxy.get_max_result_size(ps);
     const auto max_tombstones = proxy.get_tombstone_limit();
@@ -40,6 +40,17 @@ seastar::future<seastar::lw_shared_ptr<strings_result>> query_strings(service::s
 
 seastar::future<seastar::lw_shared_ptr<std::map<bytes, bytes>>> read_hashes(service::storage_proxy&, const redis_options&, const bytes&, service_permit);
 seastar::future<seastar::lw_shared_ptr<std::map<bytes, bytes>>> read_hashes(service::storage_proxy&, const redis_options&, const bytes&, const bytes&, service_permit);
+// The values of a list, in order, up to limit of them.
+seastar::future<seastar::lw_shared_ptr<std::vector<bytes>>> read_list(service::storage_proxy&, const redis_options&, const bytes&, uint64_t limit, service_permit);
+// The length of a list, counted without reading its values.
+seastar::future<uint64_t> count_list(service::storage_proxy&, const redis_options&, const bytes&, service_permit);
+
+// The members of a set, or the given one if it's a member.
+seastar::future<seastar::lw_shared_ptr<std::vector<bytes>>> read_set(service::storage_proxy&, const redis_options&, const bytes&, service_permit);
+seastar::future<seastar::lw_shared_ptr<std::vector<bytes>>> read_set(service::storage_proxy&, const redis_options&, const bytes&, const bytes&, service_permit);
+// The number of members of a set, counted without reading them.
+seastar::future<uint64_t> count_set(service::storage_proxy&, const redis_options&, const bytes&, service_permit);
+
 seastar::future<seastar::lw_shared_ptr<std::map<bytes, bytes>>> query_hashes(service::storage_proxy&, const redis_options&, const bytes&, service_permit, schema_ptr, query::partition_slice);
 
 }
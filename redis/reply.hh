@@ -13,6 +13,7 @@
 #include <seastar/core/shared_ptr.hh>
 #include <seastar/core/print.hh>
 #include <seastar/core/scattered_message.hh>
+#include <vector>
 #include "redis/exceptions.hh"
 #include "utils/fmt-compat.hh"
 
@@ -68,6 +69,26 @@ class redis_message final {
         }
         return make_ready_future<redis_message>(m);
     }
+    static seastar::future<redis_message> make_strings_list_result(const std::vector<bytes_opt>& results) {
+        auto m = make_lw_shared<scattered_message<char>> ();
+        m->append(fmt::format("*{}\r\n", results.size()));
+        for (auto& r : results) {
+            if (r) {
+                write_bytes(m, (bytes&)*r);
+            } else {
+                m->append_static("$-1\r\n");
+            }
+        }
+        return make_ready_future<redis_message>(m);
+    }
+    static seastar::future<redis_message> make_strings_list_result(std::vector<bytes>& results) {
+        auto m = make_lw_shared<scattered_message<char>> ();
+        m->append(fmt::format("*{}\r\n", results.size()));
+        for (auto& r : results) {
+            write_bytes(m, r);
+        }
+        return make_ready_future<redis_message>(m);
+    }
     static seastar::future<redis_message> make_strings_result(bytes result) {
         auto m = make_lw_shared<scattered_message<char>> ();
         write_bytes(m, result);
@@ -10,6 +10,7 @@
 
 #include "redis/request.hh"
 #include "redis/reply.hh"
+#include "redis/command_factory.hh"
 
 #include "auth/authenticator.hh"
 #include "db/config.hh"
@@ -78,8 +79,8 @@ redis_server::connection::~connection() {
 
 thread_local redis_server::connection::execution_stage_type redis_server::connection::_process_request_stage {"redis_transport", &connection::process_request_one};
 
-future<redis_server::result> redis_server::connection::process_request_internal() {
-    return _process_request_stage(this, _parser.get_request(), seastar::ref(_options), empty_service_permit());
+future<redis_server::result> redis_server::connection::process_request_internal(redis::request&& request) {
+    return _process_request_stage(this, std::move(request), seastar::ref(_options), empty_service_permit());
 }
 
 void redis_server::connection::write_reply(const redis_exception& e)
@@ -104,33 +105,68 @@ void redis_server::connection::write_reply(redis_server::result result)
     });
 }
 
+// Writes the reply of a request, after the replies of the requests before
+// it, once it's ready. A failure of the request is replied as an error.
+// The units of the request are released once its reply is written.
+void redis_server::connection::write_reply(future<redis_server::result>&& f, semaphore_units<> units)
+{
+    _ready_to_respond = _ready_to_respond.then([this, f = std::move(f)] () mutable {
+        return std::move(f).then_wrapped([this] (future<redis_server::result> f) {
+            if (!f.failed()) {
+                auto m = f.get0().make_message();
+                return _write_buf.write(std::move(*m)).then([this] {
+                    return _write_buf.flush();
+                });
+            }
+            sstring message;
+            try {
+                f.get();
+            } catch (redis_exception& e) {
+                message = e.what_message();
+            } catch (std::exception& e) {
+                message = e.what();
+            } catch (...) {
+                message = "Unknown exception";
+            }
+            return redis_message::exception(message).then([this] (auto&& result) {
+                auto m = result.message();
+                return _write_buf.write(std::move(*m)).then([this] {
+                    return _write_buf.flush();
+                });
+            });
+        });
+    }).finally([units = std::move(units)] {});
+}
+
 future<> redis_server::connection::process_request() {
     _parser.init();
     return _read_buf.consume(_parser).then([this] {
         if (_parser.eof()) {
             return make_ready_future<>();
         }
-        ++_server._stats._requests_serving;
-        _pending_requests_gate.enter();
-        utils::latency_counter lc;
-        lc.start();
-        auto leave = defer([this] () noexcept { _pending_requests_gate.leave(); });
-        return process_request_internal().then([this, leave = std::move(leave), lc = std::move(lc)] (auto&& result) mutable {
-            --_server._stats._requests_serving;
-            try {
-                if (_parser.failed()) {
-                    logging.error("request parse failed");
-                    const auto e = redis_exception("unknown command ''");
-                    write_reply(std::move(e));
-                }else{
-                    write_reply(std::move(result));
-                }
+        if (_parser.failed()) {
+            logging.error("request parse failed");
+            write_reply(redis_exception("unknown command ''"));
+            return make_ready_future<>();
+        }
+        redis::request request = std::move(_parser.get_request());
+        const bool read_only = redis::command_factory::is_read_only(request._command);
+        return get_units(_pipeline_units, 1).then([this, request = std::move(request), read_only] (semaphore_units<> units) mutable {
+            ++_server._stats._requests_serving;
+            _pending_requests_gate.enter();
+            utils::latency_counter lc;
+            lc.start();
+            auto leave = defer([this] () noexcept { _pending_requests_gate.leave(); });
+            auto lock = read_only ? _pipeline_lock.hold_read_lock() : _pipeline_lock.hold_write_lock();
+            auto f = lock.then([this, request = std::move(request)] (rwlock::holder holder) mutable {
+                return process_request_internal(std::move(request)).finally([holder = std::move(holder)] {});
+            }).finally([this, leave = std::move(leave), lc = std::move(lc)] () mutable {
+                --_server._stats._requests_serving;
                 ++_server._stats._requests_served;
                 _server._stats._requests.mark(lc.stop().latency());
                 _server._stats._estimated_requests_latency.add(lc.latency(), _server._stats._requests.hist.count);
-            } catch (...) {
-                logging.error("request processing failed: {}", std::current_exception());
-            }
+            });
+            write_reply(std::move(f), std::move(units));
         });
     });
 }
@@ -27,6 +27,7 @@
 
 #include <seastar/core/seastar.hh>
 #include <seastar/core/semaphore.hh>
+#include <seastar/core/rwlock.hh>
 #include <seastar/core/sharded.hh>
 #include <seastar/core/execution_stage.hh>
 #include <seastar/net/tls.hh>
@@ -80,6 +81,15 @@ class redis_server : public generic_server::server {
         socket_address _server_addr;
         redis_protocol_parser _parser;
         redis::redis_options _options;
+        // The requests of a pipeline are read and started without waiting
+        // for the requests before them, up to max_pipelined_requests of
+        // them, and replied in order. A read-only request may run
+        // concurrently with the other read-only ones, while any other
+        // request runs alone, so it sees the effects of the requests before
+        // it and the requests after it see its effects.
+        static constexpr size_t max_pipelined_requests = 32;
+        rwlock _pipeline_lock;
+        semaphore _pipeline_units{max_pipelined_requests};
 
         using execution_stage_type = inheriting_concrete_execution_stage<
                 future<redis_server::result>,
@@ -99,7 +109,8 @@ class redis_server : public generic_server::server {
     private:
         const ::timeout_config& timeout_config() { return _server.timeout_config(); }
         future<result> process_request_one(redis::request&& request, redis::redis_options&, service_permit permit);
-        future<result> process_request_internal();
+        future<result> process_request_internal(redis::request&& request);
+        void write_reply(future<result>&& f, semaphore_units<> units);
     };
 
     virtual shared_ptr<generic_server::connection> make_connection(socket_address server_addr, connected_socket&& fd, socket_address addr) override;
@@ -25,6 +25,7 @@
 #include <seastar/core/metrics_registration.hh>
 #include <seastar/core/coroutine.hh>
 #include <seastar/coroutine/parallel_for_each.hh>
+#include <seastar/coroutine/exception.hh>
 #include <list>
 #include <vector>
 #include <algorithm>
@@ -721,6 +722,11 @@ class repair_meta {
     std::list<repair_row> _working_row_buf;
     // Combines all the repair_hash in _working_row_buf
     repair_hash _working_row_buf_combined_hash;
+    // Contains rows read from disk, following the ones in _row_buf, while
+    // the rows in _row_buf are being synced
+    std::list<repair_row> _read_ahead_rows;
+    size_t _read_ahead_size = 0;
+    std::optional<future<>> _read_ahead;
     // Tracks the last sync boundary
     std::optional<repair_sync_boundary> _last_sync_boundary;
     // Tracks current sync boundary
@@ -934,7 +940,9 @@ class repair_meta {
     }
 
     future<> close() noexcept {
-        return _repair_reader.close();
+        return wait_for_read_ahead().handle_exception([] (std::exception_ptr) {}).then([this] {
+            return _repair_reader.close();
+        });
     }
 
 private:
@@ -1043,36 +1051,72 @@ class repair_meta {
         return stop_iteration::no;
     }
 
+    // Read rows from sstable into rows until their size, starting from cur_size,
+    // reaches limit, and return the size of the rows read.
+    // This reads rows from where the reader left last time.
+    future<size_t> do_read_rows_from_disk(size_t& cur_size, size_t limit, std::list<repair_row>& rows) {
+        size_t new_rows_size = 0;
+        std::exception_ptr ex;
+        try {
+            while (cur_size < limit) {
+                _gate.check();
+                mutation_fragment_opt mfopt = co_await _repair_reader.read_mutation_fragment();
+                if (!mfopt) {
+                    co_await _repair_reader.on_end_of_stream();
+                    co_return new_rows_size;
+                }
+                handle_mutation_fragment(*mfopt, cur_size, new_rows_size, rows);
+            }
+        } catch (...) {
+            ex = std::current_exception();
+        }
+        if (ex) {
+            co_await _repair_reader.on_end_of_stream();
+            co_return coroutine::exception(std::move(ex));
+        }
+        _repair_reader.pause();
+        co_return new_rows_size;
+    }
+
+    future<> wait_for_read_ahead() {
+        if (!_read_ahead) {
+            return make_ready_future<>();
+        }
+        auto f = std::move(*_read_ahead);
+        _read_ahead.reset();
+        return f;
+    }
+
+    // Read up to half of _max_row_buf_size of the rows following _row_buf in
+    // the background, so that the next get_sync_boundary() finds them in
+    // memory. The read-ahead is bounded to limit the memory used by a range
+    // in addition to _row_buf and _working_row_buf.
+    void start_read_ahead() {
+        if (_read_ahead || _gate.is_closed()) {
+            return;
+        }
+        _read_ahead = with_gate(_gate, [this] {
+            return do_read_rows_from_disk(_read_ahead_size, _max_row_buf_size / 2, _read_ahead_rows).discard_result();
+        });
+    }
+
     // Read rows from sstable until the size of rows exceeds _max_row_buf_size  - current_size
     // This reads rows from where the reader left last time into _row_buf
     // _current_sync_boundary or _last_sync_boundary have no effect on the reader neither.
     future<std::tuple<std::list<repair_row>, size_t>>
     read_rows_from_disk(size_t cur_size) {
-        using value_type = std::tuple<std::list<repair_row>, size_t>;
-        return do_with(cur_size, size_t(0), std::list<repair_row>(), [this] (size_t& cur_size, size_t& new_rows_size, std::list<repair_row>& cur_rows) {
-            return repeat([this, &cur_size, &cur_rows, &new_rows_size] () mutable {
-                if (cur_size >= _max_row_buf_size) {
-                    return make_ready_future<stop_iteration>(stop_iteration::yes);
-                }
-                _gate.check();
-                return _repair_reader.read_mutation_fragment().then([this, &cur_size, &new_rows_size, &cur_rows] (mutation_fragment_opt mfopt) mutable {
-                    if (!mfopt) {
-                      return _repair_reader.on_end_of_stream().then([] {
-                        return stop_iteration::yes;
-                      });
-                    }
-                    return make_ready_future<stop_iteration>(handle_mutation_fragment(*mfopt, cur_size, new_rows_size, cur_rows));
-                });
-            }).then_wrapped([this, &cur_rows, &new_rows_size] (future<> fut) mutable {
-                if (fut.failed()) {
-                    return make_exception_future<value_type>(fut.get_exception()).finally([this] {
-                        return _repair_reader.on_end_of_stream();
-                    });
-                }
-                _repair_reader.pause();
-                return make_ready_future<value_type>(value_type(std::move(cur_rows), new_rows_size));
-            });
-        });
+        co_await wait_for_read_ahead();
+        std::list<repair_row> cur_rows;
+        size_t new_rows_size = 0;
+        while (!_read_ahead_rows.empty() && cur_size < _max_row_buf_size) {
+            const auto size = _read_ahead_rows.front().size();
+            cur_size += size;
+            new_rows_size += size;
+            _read_ahead_size -= size;
+            cur_rows.splice(cur_rows.end(), _read_ahead_rows, _read_ahead_rows.begin());
+        }
+        new_rows_size += co_await do_read_rows_from_disk(cur_size, _max_row_buf_size, cur_rows);
+        co_return std::tuple(std::move(cur_rows), new_rows_size);
     }
 
     future<> clear_row_buf() {
@@ -1112,6 +1156,9 @@ class repair_meta {
                         }
                         rlogger.debug("get_sync_boundary: Got nr={} rows, sb_max={}, row_buf_size={}, repair_hash={}, skipped_sync_boundary={}",
                                 new_rows_nr, sb_max, row_buf_bytes, row_buf_combined_hash, sb);
+                        if (row_buf_bytes >= _max_row_buf_size) {
+                            start_read_ahead();
+                        }
                         return get_sync_boundary_response{sb_max, row_buf_combined_hash, row_buf_bytes, new_rows_size, new_rows_nr};
                     });
                 });
@@ -3001,23 +3048,45 @@ future<> repair_service::load_history() {
         }
         rlogger.info("Loading repair history for keyspace={}, table={}, table_uuid={}",
                 table->schema()->ks_name(), table->schema()->cf_name(), table_uuid);
-        co_await _sys_ks.local().get_repair_history(table_uuid, [this] (const auto& entry) -> future<> {
+        // The history is merged locally and handed to the shards in batches,
+        // instead of one cross-shard update per system.repair_history row.
+        repair_history_map batch;
+        size_t batched = 0;
+        auto flush = [&] () -> future<> {
+            std::vector<std::pair<dht::token_range, gc_clock::time_point>> ranges;
+            ranges.reserve(batch.map.iterative_size());
+            for (const auto& [interval, repair_time] : batch.map) {
+                ranges.emplace_back(locator::token_metadata::interval_to_range(interval), repair_time);
+            }
+            batch.map.clear();
+            batched = 0;
+            try {
+                co_await get_db().invoke_on_all([table_uuid, &ranges] (replica::database& local_db) {
+                    auto& gc_state = local_db.get_compaction_manager().get_tombstone_gc_state();
+                    for (const auto& [range, repair_time] : ranges) {
+                        gc_state.update_repair_time(table_uuid, range, repair_time);
+                    }
+                });
+            } catch (...) {
+                rlogger.warn("Failed to update repair history time for keyspace={}, table={}, ranges={}: {}",
+                        table->schema()->ks_name(), table->schema()->cf_name(), ranges.size(), std::current_exception());
+            }
+        };
+        co_await _sys_ks.local().get_repair_history(table_uuid, [&] (const auto& entry) -> future<> {
             auto start = entry.range_start == std::numeric_limits<int64_t>::min() ? dht::minimum_token() : dht::token::from_int64(entry.range_start);
             auto end = entry.range_end == std::numeric_limits<int64_t>::min() ? dht::maximum_token() : dht::token::from_int64(entry.range_end);
             auto range = dht::token_range(dht::token_range::bound(start, false), dht::token_range::bound(end, true));
             auto repair_time = to_gc_clock(entry.ts);
             rlogger.debug("Loading repair history for keyspace={}, table={}, table_uuid={}, repair_time={}, range={}",
                     entry.ks, entry.cf, entry.table_uuid, entry.ts, range);
-            try {
-                co_await get_db().invoke_on_all([table_uuid = entry.table_uuid, range, repair_time] (replica::database& local_db) {
-                    auto& gc_state = local_db.get_compaction_manager().get_tombstone_gc_state();
-                    gc_state.update_repair_time(table_uuid, range, repair_time);
-                });
-            } catch (...) {
-                rlogger.warn("Failed to update repair history time for keyspace={}, table={}, range={}, repair_time={}",
-                        entry.ks, entry.cf, range, repair_time);
+            batch.update(locator::token_metadata::range_to_interval(range), repair_time);
+            if (++batched >= 1000) {
+                co_await flush();
             }
         });
+        if (batched) {
+            co_await flush();
+        }
     }
     co_return;
 }
@@ -47,6 +47,7 @@
 #include "db/operation_type.hh"
 
 #include "utils/human_readable.hh"
+#include "utils/secondary_page_cache.hh"
 #include "utils/fb_utilities.hh"
 #include "utils/stall_free.hh"
 #include "utils/fmt-compat.hh"
@@ -306,6 +307,14 @@ class db_user_types_storage : public data_dictionary::dummy_user_types_storage {
     }
 };
 
+static std::unique_ptr<utils::secondary_page_cache> make_secondary_page_cache(const db::config& cfg) {
+    if (cfg.secondary_page_cache_directory().empty()) {
+        return nullptr;
+    }
+    auto path = std::filesystem::path(cfg.secondary_page_cache_directory()) / format("shard-{}.cache", this_shard_id());
+    return std::make_unique<utils::secondary_page_cache>(std::move(path), cfg.secondary_page_cache_size_in_mb() * 1024 * 1024 / smp::count);
+}
+
 database::database(const db::config& cfg, database_config dbcfg, service::migration_notifier& mn, gms::feature_service& feat, const locator::shared_token_metadata& stm,
         compaction_manager& cm, sharded<semaphore>& sst_dir_sem, utils::cross_shard_barrier barrier)
     : _stats(make_lw_shared<db_stats>())
@@ -324,6 +333,13 @@ database::database(const db::config& cfg, database_config dbcfg, service::migrat
         }
         return backlog;
     }))
+    , _maintenance_controller(backlog_controller::scheduling_group{dbcfg.streaming_scheduling_group, service::get_local_streaming_priority()}, 1s,
+        maintenance_controller::config{
+            .target = [&cfg] { return std::chrono::microseconds(std::chrono::milliseconds(cfg.maintenance_latency_target_in_ms())); },
+            .min_shares = [&cfg] { return cfg.maintenance_min_shares(); },
+            .max_shares = [&cfg] { return cfg.maintenance_max_shares(); },
+        },
+        [this] { return get_foreground_latency_percentile(0.99); })
     , _read_concurrency_sem(max_count_concurrent_reads,
         max_memory_concurrent_reads(),
         "_read_concurrency_sem",
@@ -353,7 +369,9 @@ database::database(const db::config& cfg, database_config dbcfg, service::migrat
               _cfg.compaction_large_cell_warning_threshold_mb()*1024*1024,
               _cfg.compaction_rows_count_warning_threshold()))
     , _nop_large_data_handler(std::make_unique<db::nop_large_data_handler>())
-    , _user_sstables_manager(std::make_unique<sstables::sstables_manager>(*_large_data_handler, _cfg, feat, _row_cache_tracker, dbcfg.available_memory))
+    , _secondary_page_cache(make_secondary_page_cache(_cfg))
+    , _user_sstables_manager(std::make_unique<sstables::sstables_manager>(*_large_data_handler, _cfg, feat, _row_cache_tracker, dbcfg.available_memory,
+            _secondary_page_cache.get()))
     , _system_sstables_manager(std::make_unique<sstables::sstables_manager>(*_nop_large_data_handler, _cfg, feat, _row_cache_tracker, dbcfg.available_memory))
     , _result_memory_limiter(dbcfg.available_memory / 10)
     , _data_listeners(std::make_unique<db::data_listeners>())
@@ -363,15 +381,23 @@ database::database(const db::config& cfg, database_config dbcfg, service::migrat
     , _sst_dir_semaphore(sst_dir_sem)
     , _wasm_engine(std::make_unique<wasm::engine>())
     , _stop_barrier(std::move(barrier))
+    , _count_min_rate_limiter(size_t(cfg.per_partition_rate_limiter_sketch_size_in_kb()) * 1024)
     , _update_memtable_flush_static_shares_action([this, &cfg] { return _memtable_controller.update_static_shares(cfg.memtable_flush_static_shares()); })
     , _memtable_flush_static_shares_observer(cfg.memtable_flush_static_shares.observe(_update_memtable_flush_static_shares_action.make_observer()))
 {
     assert(dbcfg.available_memory != 0); // Detect misconfigured unit tests, see #7544
 
     local_schema_registry().init(*this); // TODO: we're never unbound.
+    if (_cfg.continuous_toppartitions_capacity()) {
+        reset_continuous_toppartitions();
+    }
     setup_metrics();
 
     _row_cache_tracker.set_compaction_scheduling_group(dbcfg.memory_compaction_scheduling_group);
+    if (_cfg.enable_cache_admission_filter()) {
+        // Track about as many partitions as fit in memory at 4KiB each.
+        _row_cache_tracker.enable_admission_filter(std::clamp<size_t>(dbcfg.available_memory / 4096, 1 << 16, 1 << 24));
+    }
 
     setup_scylla_memory_diagnostics_producer();
     if (_dbcfg.sstables_format) {
@@ -535,6 +561,9 @@ database::setup_metrics() {
                        sm::description("Counts sstables that survived the clustering key filtering. "
                                        "High value indicates that bloom filter is not very efficient and still have to access a lot of sstables to get data.")),
 
+        sm::make_counter("row_bloom_filter_skipped_sstables", _cf_stats.sstables_skipped_by_row_bloom_filter,
+                       sm::description("Counts sstables skipped by single row reads because their row bloom filter doesn't contain the requested rows.")),
+
         sm::make_counter("dropped_view_updates", _cf_stats.dropped_view_updates,
                        sm::description("Counts the number of view updates that have been dropped due to cluster overload. ")),
 
@@ -634,6 +663,11 @@ database::setup_metrics() {
                                        " When the queue is full, excessive reads are shed to avoid overload."),
                        {user_label_instance}),
 
+        sm::make_counter("reads_shed_due_to_deadline", _read_concurrency_sem.get_stats().total_reads_shed_due_to_deadline,
+                       sm::description("The number of queued reads failed with a timeout instead of being admitted, because they had less time"
+                                       " left than reads usually take. Each of them is a read which would likely have timed out after doing its IO."),
+                       {user_label_instance}),
+
         sm::make_gauge("active_reads", [this] { return max_count_streaming_concurrent_reads - _streaming_concurrency_sem.available_resources().count; },
                        sm::description("Holds the number of currently active read operations issued on behalf of streaming "),
                        {streaming_label_instance}),
@@ -702,6 +736,9 @@ database::setup_metrics() {
         sm::make_counter("short_mutation_queries", _stats->short_mutation_queries,
                        sm::description("The rate of mutation queries that returned less rows than requested due to result size limiting.")),
 
+        sm::make_counter("coalesced_counter_updates", _stats->coalesced_counter_updates,
+                       sm::description("The number of counter updates that were applied together with a pending update to the same partition, see counter_update_coalescing_window_in_us.")),
+
         sm::make_counter("multishard_query_unpopped_fragments", _stats->multishard_query_unpopped_fragments,
                        sm::description("The total number of fragments that were extracted from the shard reader but were unconsumed by the query and moved back into the reader.")),
 
@@ -735,6 +772,9 @@ database::setup_metrics() {
 
         sm::make_total_operations("total_view_updates_failed_remote", _cf_stats.total_view_updates_failed_remote,
                 sm::description("Total number of view updates generated for tables and failed to be sent to remote replicas.")),
+
+        sm::make_gauge("maintenance_shares", [this] { return _maintenance_controller.shares(); },
+                sm::description("The shares of maintenance work (streaming, repair and hint replay), as set by the maintenance controller against maintenance_latency_target_in_ms.")),
     });
     if (this_shard_id() == 0) {
         _metrics.add_group("database", {
@@ -742,6 +782,23 @@ database::setup_metrics() {
                         sm::description("The number of times the schema changed")),
         });
     }
+    if (_continuous_toppartitions) {
+        auto hottest = [] (db::toppartitions_data_listener::top_k& top_k) -> uint64_t {
+            auto top = top_k.top(1);
+            return top.empty() ? 0 : top.front().count;
+        };
+        _metrics.add_group("database", {
+                sm::make_gauge("toppartitions_hottest_read_count", [this, hottest] { return hottest(_continuous_toppartitions->top_reads()); },
+                        sm::description("The number of reads of the most read partition, in all tables, since the always-on toppartitions tracking was last reset.")),
+                sm::make_gauge("toppartitions_hottest_write_count", [this, hottest] { return hottest(_continuous_toppartitions->top_writes()); },
+                        sm::description("The number of writes to the most written partition, in all tables, since the always-on toppartitions tracking was last reset.")),
+        });
+    }
+}
+
+void database::reset_continuous_toppartitions() {
+    _continuous_toppartitions = std::make_unique<db::toppartitions_data_listener>(*this, std::unordered_set<std::tuple<sstring, sstring>, utils::tuple_hash>{},
+            std::unordered_set<sstring>{}, _cfg.continuous_toppartitions_capacity());
 }
 
 void database::set_format(sstables::sstable_version_types format) noexcept {
@@ -845,21 +902,34 @@ future<> database::parse_system_tables(distributed<service::storage_proxy>& prox
 future<>
 database::init_commitlog() {
     if (_commitlog) {
-        return make_ready_future<>();
+        co_return;
     }
 
-    return db::commitlog::create_commitlog(db::commitlog::config::from_db_config(_cfg, _dbcfg.available_memory)).then([this](db::commitlog&& log) {
-        _commitlog = std::make_unique<db::commitlog>(std::move(log));
-        _commitlog->add_flush_handler([this](db::cf_id_type id, db::replay_position pos) {
+    auto add_flush_handler = [this] (db::commitlog& cl) {
+        cl.add_flush_handler([this, &cl](db::cf_id_type id, db::replay_position pos) {
             if (!_column_families.contains(id)) {
                 // the CF has been removed.
-                _commitlog->discard_completed_segments(id);
+                cl.discard_completed_segments(id);
                 return;
             }
             // Initiate a background flush. Waited upon in `stop()`.
             (void)_column_families[id]->flush(pos);
         }).release(); // we have longer life time than CL. Ignore reg anchor
-    });
+    };
+
+    _commitlog = std::make_unique<db::commitlog>(co_await db::commitlog::create_commitlog(db::commitlog::config::from_db_config(_cfg, _dbcfg.available_memory)));
+    add_flush_handler(*_commitlog);
+
+    if (!_cfg.commitlog_segregated_keyspaces().empty()) {
+        auto c = db::commitlog::config::from_db_config(_cfg, _dbcfg.available_memory);
+        c.fname_prefix = db::commitlog::descriptor::SEGREGATED_FILENAME_PREFIX;
+        c.metrics_category_name = "segregated-commitlog";
+        if (!_cfg.commitlog_segregated_sync().empty()) {
+            c.mode = _cfg.commitlog_segregated_sync() == "batch" ? db::commitlog::sync_mode::BATCH : db::commitlog::sync_mode::PERIODIC;
+        }
+        _segregated_commitlog = std::make_unique<db::commitlog>(co_await db::commitlog::create_commitlog(std::move(c)));
+        add_flush_handler(*_segregated_commitlog);
+    }
 }
 
 future<> database::update_keyspace(sharded<service::storage_proxy>& proxy, const sstring& name) {
@@ -939,8 +1009,11 @@ void database::add_column_family(keyspace& ks, schema_ptr schema, column_family:
     auto& sst_manager = is_system_table(*schema) ? get_system_sstables_manager() : get_user_sstables_manager();
     lw_shared_ptr<column_family> cf;
     if (cfg.enable_commitlog && _commitlog) {
+        auto& segregated = _cfg.commitlog_segregated_keyspaces();
         db::commitlog& cl = schema->ks_name() == db::schema_tables::NAME && _uses_schema_commitlog
                 ? *_schema_commitlog
+                : _segregated_commitlog && std::find(segregated.begin(), segregated.end(), schema->ks_name()) != segregated.end()
+                ? *_segregated_commitlog
                 : *_commitlog;
         cf = make_lw_shared<column_family>(schema, std::move(cfg), cl, _compaction_manager, sst_manager, *_cl_stats, _row_cache_tracker);
     } else {
@@ -1254,6 +1327,8 @@ keyspace::make_column_family_config(const schema& s, const database& db) const {
     cfg.enable_metrics_reporting = db_config.enable_keyspace_column_family_metrics();
     cfg.reversed_reads_auto_bypass_cache = db_config.reversed_reads_auto_bypass_cache;
     cfg.enable_optimized_reversed_reads = db_config.enable_optimized_reversed_reads;
+    cfg.memtable_flush_split_size_in_mb = db_config.memtable_flush_split_size_in_mb;
+    cfg.cache_update_min_reads_per_write = db_config.cache_update_min_reads_per_write;
     cfg.tombstone_warn_threshold = db_config.tombstone_warn_threshold();
     cfg.view_update_concurrency_semaphore = _config.view_update_concurrency_semaphore;
     cfg.view_update_concurrency_semaphore_limit = _config.view_update_concurrency_semaphore_limit;
@@ -1455,11 +1530,24 @@ std::optional<db::rate_limiter::can_proceed> database::account_coordinator_opera
 
     std::optional<uint32_t> table_limit = tbl.schema()->per_partition_rate_limit_options().get_max_ops_per_second(op_type);
     db::rate_limiter::label& lbl = tbl.get_rate_limiter_label_for_op_type(op_type);
-    return _rate_limiter.account_operation(lbl, dht::token::to_int64(token), *table_limit, account_and_enforce_info);
+    return account_operation_to_rate_limit(*tbl.schema(), lbl, dht::token::to_int64(token), *table_limit, account_and_enforce_info);
+}
+
+db::rate_limiter::can_proceed database::account_operation_to_rate_limit(const schema& s, db::rate_limiter::label& lbl, uint64_t token, uint64_t limit,
+        const db::per_partition_rate_limit::info& rate_limit_info) noexcept {
+    switch (s.per_partition_rate_limit_options().get_algorithm()) {
+    case db::per_partition_rate_limit_options::algorithm::hash_table:
+        return _rate_limiter.account_operation(lbl, token, limit, rate_limit_info);
+    case db::per_partition_rate_limit_options::algorithm::count_min_sketch:
+        return _count_min_rate_limiter.account_operation(lbl, token, limit, rate_limit_info);
+    }
+    return db::rate_limiter::can_proceed::yes;
 }
 
+template <typename AccountOperation>
+requires std::invocable<AccountOperation, db::rate_limiter::label&, uint64_t, uint64_t, const db::per_partition_rate_limit::info&>
 static db::rate_limiter::can_proceed account_singular_ranges_to_rate_limit(
-        db::rate_limiter& limiter, column_family& cf,
+        AccountOperation&& account_operation, column_family& cf,
         const dht::partition_range_vector& ranges,
         const database_config& dbcfg,
         db::per_partition_rate_limit::info rate_limit_info) {
@@ -1479,7 +1567,7 @@ static db::rate_limiter::can_proceed account_singular_ranges_to_rate_limit(
             continue;
         }
         auto token = dht::token::to_int64(ranges.front().start()->value().token());
-        if (limiter.account_operation(read_label, token, table_limit, rate_limit_info) == db::rate_limiter::can_proceed::no) {
+        if (account_operation(read_label, token, table_limit, rate_limit_info) == db::rate_limiter::can_proceed::no) {
             // Don't return immediately - account all ranges first
             ret = can_proceed::no;
         }
@@ -1489,8 +1577,15 @@ static db::rate_limiter::can_proceed account_singular_ranges_to_rate_limit(
 }
 
 future<std::tuple<lw_shared_ptr<query::result>, cache_temperature>>
-database::query(schema_ptr s, const query::read_command& cmd, query::result_options opts, const dht::partition_range_vector& ranges,
+database::query(schema_ptr s, const query::read_command& original_cmd, query::result_options opts, const dht::partition_range_vector& ranges,
                 tracing::trace_state_ptr trace_state, db::timeout_clock::time_point timeout, db::per_partition_rate_limit::info rate_limit_info) {
+    std::optional<query::read_command> data_cmd;
+    if (query::can_omit_unselected_cell_values(*s, original_cmd.slice)) {
+        data_cmd.emplace(original_cmd);
+        data_cmd->slice.options.set<query::partition_slice::option::omit_unselected_cell_values>();
+    }
+    const auto& cmd = data_cmd ? *data_cmd : original_cmd;
+
     const auto reversed = cmd.slice.is_reversed();
     if (reversed) {
         s = s->make_reversed();
@@ -1498,7 +1593,11 @@ database::query(schema_ptr s, const query::read_command& cmd, query::result_opti
 
     column_family& cf = find_column_family(cmd.cf_id);
 
-    if (account_singular_ranges_to_rate_limit(_rate_limiter, cf, ranges, _dbcfg, rate_limit_info) == db::rate_limiter::can_proceed::no) {
+    auto account_operation = [this, &s = *cf.schema()] (db::rate_limiter::label& lbl, uint64_t token, uint64_t limit,
+            const db::per_partition_rate_limit::info& rate_limit_info) {
+        return account_operation_to_rate_limit(s, lbl, token, limit, rate_limit_info);
+    };
+    if (account_singular_ranges_to_rate_limit(account_operation, cf, ranges, _dbcfg, rate_limit_info) == db::rate_limiter::can_proceed::no) {
         ++_stats->total_reads_rate_limited;
         co_await coroutine::return_exception(replica::rate_limit_exception());
     }
@@ -1514,11 +1613,17 @@ database::query(schema_ptr s, const query::read_command& cmd, query::result_opti
         querier_opt = _querier_cache.lookup_data_querier(cmd.query_uuid, *s, ranges.front(), cmd.slice, trace_state, timeout);
     }
 
+    const auto start = std::chrono::steady_clock::now();
+    tracing::stage_timer admission_timer(trace_state, "replica_admission");
     auto read_func = [&, this] (reader_permit permit) {
+        admission_timer.stop();
         reader_permit::used_guard ug{permit};
         permit.set_max_result_size(max_result_size);
-        return cf.query(std::move(s), std::move(permit), cmd, opts, ranges, trace_state, get_result_memory_limiter(),
-                timeout, &querier_opt).then([&result, ug = std::move(ug)] (lw_shared_ptr<query::result> res) {
+        tracing::stage_timer read_timer(trace_state, "replica_read");
+        return cf.query(std::move(s), permit, cmd, opts, ranges, trace_state, get_result_memory_limiter(),
+                timeout, &querier_opt).then([&, permit, ug = std::move(ug), read_timer = std::move(read_timer)] (lw_shared_ptr<query::result> res) mutable {
+            read_timer.stop();
+            tracing::trace(trace_state, "Read cost: {}", permit.stats());
             result = std::move(res);
         });
     };
@@ -1543,6 +1648,9 @@ database::query(schema_ptr s, const query::read_command& cmd, query::result_opti
     } catch (...) {
         ex = std::current_exception();
     }
+    if (!is_internal_query()) {
+        add_foreground_latency(std::chrono::steady_clock::now() - start);
+    }
 
     if (querier_opt) {
         co_await querier_opt->close();
@@ -1580,11 +1688,16 @@ database::query_mutations(schema_ptr s, const query::read_command& cmd, const dh
         querier_opt = _querier_cache.lookup_mutation_querier(cmd.query_uuid, *s, range, cmd.slice, trace_state, timeout);
     }
 
+    tracing::stage_timer admission_timer(trace_state, "replica_admission");
     auto read_func = [&, this] (reader_permit permit) {
+        admission_timer.stop();
         reader_permit::used_guard ug{permit};
         permit.set_max_result_size(max_result_size);
-        return cf.mutation_query(std::move(s), std::move(permit), cmd, range,
-                std::move(trace_state), std::move(accounter), timeout, &querier_opt).then([&result, ug = std::move(ug)] (reconcilable_result res) {
+        tracing::stage_timer read_timer(trace_state, "replica_read");
+        return cf.mutation_query(std::move(s), permit, cmd, range,
+                trace_state, std::move(accounter), timeout, &querier_opt).then([&, permit, ug = std::move(ug), read_timer = std::move(read_timer)] (reconcilable_result res) mutable {
+            read_timer.stop();
+            tracing::trace(trace_state, "Read cost: {}", permit.stats());
             result = std::move(res);
         });
     };
@@ -1673,6 +1786,46 @@ future<mutation> database::do_apply_counter_update(column_family& cf, const froz
     auto m = fm.unfreeze(m_schema);
     m.upgrade(cf.schema());
 
+    const auto window = std::chrono::microseconds(_cfg.counter_update_coalescing_window_in_us());
+    if (window.count() == 0) {
+        co_return co_await apply_counter_update(cf, std::move(m), timeout, std::move(trace_state));
+    }
+
+    // Merging the deltas sums them, so an update can ride along a pending
+    // one to the same partition, unless it has to complete sooner.
+    const auto token = m.token();
+    auto [first, last] = _pending_counter_updates.equal_range(token);
+    for (auto it = first; it != last; ++it) {
+        auto& pending = *it->second;
+        if (pending.m.schema() == m.schema() && pending.timeout <= timeout && pending.m.decorated_key().equal(*m.schema(), m.decorated_key())) {
+            tracing::trace(trace_state, "Coalescing counter update with a pending one");
+            pending.m.apply(m);
+            ++_stats->coalesced_counter_updates;
+            co_return co_await pending.done.get_shared_future();
+        }
+    }
+
+    auto op = cf.write_in_progress();
+    auto pending = make_lw_shared<pending_counter_update>(pending_counter_update{std::move(m), timeout});
+    _pending_counter_updates.emplace(token, pending);
+    tracing::trace(trace_state, "Waiting {} for counter updates to coalesce with", window);
+    co_await sleep(window);
+    // Erase by value, the iterators don't survive a rehash.
+    auto range = _pending_counter_updates.equal_range(token);
+    _pending_counter_updates.erase(std::find_if(range.first, range.second, [&] (const auto& e) { return e.second == pending; }));
+
+    auto f = co_await coroutine::as_future(apply_counter_update(cf, std::move(pending->m), timeout, std::move(trace_state)));
+    if (f.failed()) {
+        auto ex = f.get_exception();
+        pending->done.set_exception(ex);
+        co_await coroutine::return_exception_ptr(std::move(ex));
+    }
+    auto result = f.get();
+    pending->done.set_value(result);
+    co_return result;
+}
+
+future<mutation> database::apply_counter_update(column_family& cf, mutation m, db::timeout_clock::time_point timeout, tracing::trace_state_ptr trace_state) {
     // prepare partition slice
     query::column_id_vector static_columns;
     static_columns.reserve(m.partition().static_row().size());
@@ -2011,7 +2164,7 @@ future<> database::do_apply(schema_ptr s, const frozen_mutation& m, tracing::tra
         auto table_limit = *s->per_partition_rate_limit_options().get_max_writes_per_second();
         auto& write_label = cf.get_rate_limiter_label_for_writes();
         auto token = dht::token::to_int64(dht::get_token(*s, m.key()));
-        if (_rate_limiter.account_operation(write_label, token, table_limit, rate_limit_info) == db::rate_limiter::can_proceed::no) {
+        if (account_operation_to_rate_limit(*s, write_label, token, table_limit, rate_limit_info) == db::rate_limiter::can_proceed::no) {
             co_await coroutine::return_exception(replica::rate_limit_exception());
         }
     }
@@ -2079,6 +2232,19 @@ Future database::update_write_metrics(Future&& f) {
     });
 }
 
+void database::add_foreground_latency(std::chrono::steady_clock::duration latency) {
+    _foreground_latency.add(std::chrono::duration_cast<std::chrono::microseconds>(latency).count());
+}
+
+std::optional<std::chrono::microseconds> database::get_foreground_latency_percentile(double percentile) {
+    if (_foreground_latency.count() == 0) {
+        return std::nullopt;
+    }
+    auto latency = std::chrono::microseconds(_foreground_latency.percentile(percentile));
+    _foreground_latency *= 0.5; // decay fast, the controller reacts to the latency of the last few intervals
+    return latency;
+}
+
 void database::update_write_metrics_for_timed_out_write() {
     ++_stats->total_writes;
     ++_stats->total_writes_failed;
@@ -2096,7 +2262,13 @@ future<> database::apply(schema_ptr s, const frozen_mutation& m, tracing::trace_
     if (!s->is_synced()) {
         on_internal_error(dblog, format("attempted to apply mutation using not synced schema of {}.{}, version={}", s->ks_name(), s->cf_name(), s->version()));
     }
-    return update_write_metrics(_apply_stage(this, std::move(s), seastar::cref(m), std::move(tr_state), timeout, sync, rate_limit_info));
+    if (is_internal_query()) {
+        return update_write_metrics(_apply_stage(this, std::move(s), seastar::cref(m), std::move(tr_state), timeout, sync, rate_limit_info));
+    }
+    return update_write_metrics(_apply_stage(this, std::move(s), seastar::cref(m), std::move(tr_state), timeout, sync, rate_limit_info)).finally(
+            [this, start = std::chrono::steady_clock::now()] {
+        add_foreground_latency(std::chrono::steady_clock::now() - start);
+    });
 }
 
 future<> database::apply_hint(schema_ptr s, const frozen_mutation& m, tracing::trace_state_ptr tr_state, db::timeout_clock::time_point timeout) {
@@ -2293,6 +2465,11 @@ future<> database::stop() {
         co_await _schema_commitlog->shutdown();
         dblog.info("Shutting down schema commitlog complete");
     }
+    if (_segregated_commitlog) {
+        dblog.info("Shutting down segregated commitlog");
+        co_await _segregated_commitlog->shutdown();
+        dblog.info("Shutting down segregated commitlog complete");
+    }
     co_await _view_update_concurrency_sem.wait(max_memory_pending_view_updates());
     if (_commitlog) {
         co_await _commitlog->release();
@@ -2300,11 +2477,18 @@ future<> database::stop() {
     if (_schema_commitlog) {
         co_await _schema_commitlog->release();
     }
+    if (_segregated_commitlog) {
+        co_await _segregated_commitlog->release();
+    }
     co_await _system_dirty_memory_manager.shutdown();
     co_await _dirty_memory_manager.shutdown();
     co_await _memtable_controller.shutdown();
+    co_await _maintenance_controller.shutdown();
     co_await _user_sstables_manager->close();
     co_await _system_sstables_manager->close();
+    if (_secondary_page_cache) {
+        co_await _secondary_page_cache->stop();
+    }
     co_await _querier_cache.stop();
     co_await _read_concurrency_sem.stop();
     co_await _streaming_concurrency_sem.stop();
@@ -2754,6 +2938,9 @@ future<> database::drain() {
     if (_schema_commitlog) {
         co_await _schema_commitlog->shutdown();
     }
+    if (_segregated_commitlog) {
+        co_await _segregated_commitlog->shutdown();
+    }
     b.cancel();
 }
 
@@ -98,6 +98,10 @@ namespace compaction {
 class table_state;
 }
 
+namespace utils {
+class secondary_page_cache;
+}
+
 namespace ser {
 template<typename T>
 class serializer;
@@ -113,6 +117,7 @@ class config;
 class extensions;
 class rp_handle;
 class data_listeners;
+class toppartitions_data_listener;
 class large_data_handler;
 class system_keyspace;
 class table_selector;
@@ -293,6 +298,8 @@ struct cf_stats {
     int64_t clustering_filter_fast_path_count = 0;
     // how many sstables survived the clustering key checks
     int64_t surviving_sstables_after_clustering_filter = 0;
+    // sstables skipped because their row bloom filter doesn't have the requested rows
+    int64_t sstables_skipped_by_row_bloom_filter = 0;
 
     // How many view updates were dropped due to overload.
     int64_t dropped_view_updates = 0;
@@ -333,6 +340,10 @@ struct table_stats {
     int64_t memtable_partition_hits = 0;
     int64_t memtable_range_tombstone_reads = 0;
     int64_t memtable_row_tombstone_reads = 0;
+    // Of the flushed memtables merged into the cache, and the ones
+    // invalidated in it instead.
+    int64_t cache_updates_merged = 0;
+    int64_t cache_updates_invalidated = 0;
     mutation_application_stats memtable_app_stats;
     utils::timed_rate_moving_average_summary_and_histogram reads{256};
     utils::timed_rate_moving_average_summary_and_histogram writes{256};
@@ -375,6 +386,8 @@ class table : public enable_lw_shared_from_this<table> {
         // for easy access from `table` member functions:
         utils::updateable_value<bool> reversed_reads_auto_bypass_cache{false};
         utils::updateable_value<bool> enable_optimized_reversed_reads{true};
+        utils::updateable_value<uint32_t> memtable_flush_split_size_in_mb{0};
+        utils::updateable_value<double> cache_update_min_reads_per_write{0};
         // Can be updated by a schema change:
         bool enable_optimized_twcs_queries{true};
         uint32_t tombstone_warn_threshold{0};
@@ -452,6 +465,11 @@ class table : public enable_lw_shared_from_this<table> {
     // recalculated periodically
     cache_temperature _global_cache_hit_rate = cache_temperature(0.0f);
 
+    // The read and write counts at the previous flush, see
+    // should_merge_flush_into_cache().
+    int64_t _reads_at_last_flush = 0;
+    int64_t _writes_at_last_flush = 0;
+
     // holds cache hit rates per each node in a cluster
     // may not have information for some node, since it fills
     // in dynamically
@@ -469,6 +487,16 @@ class table : public enable_lw_shared_from_this<table> {
     lowres_clock::time_point _percentile_cache_timestamp;
     std::chrono::milliseconds _percentile_cache_value;
 
+    // Read latencies of each replica, as seen by this coordinator. Only kept
+    // when speculative_retry_per_replica_latency is enabled.
+    struct replica_read_latency {
+        utils::estimated_histogram histogram;
+        double cached_percentile = -1;
+        lowres_clock::time_point percentile_cache_timestamp;
+        std::optional<std::chrono::milliseconds> percentile_cache_value;
+    };
+    std::unordered_map<gms::inet_address, replica_read_latency> _replica_read_latencies;
+
     // Phaser used to synchronize with in-progress writes. This is useful for code that,
     // after some modification, needs to ensure that news writes will see it before
     // it can proceed, such as the view building code.
@@ -561,6 +589,7 @@ class table : public enable_lw_shared_from_this<table> {
     future<> try_flush_memtable_to_sstable(compaction_group& cg, lw_shared_ptr<memtable> memt, sstable_write_permit&& permit);
     // Caller must keep m alive.
     future<> update_cache(compaction_group& cg, lw_shared_ptr<memtable> m, std::vector<sstables::shared_sstable> ssts);
+    bool should_merge_flush_into_cache();
     struct merge_comparator;
 
     // update the sstable generation, making sure that new new sstables don't overwrite this one.
@@ -1018,6 +1047,13 @@ class table : public enable_lw_shared_from_this<table> {
     void add_coordinator_read_latency(utils::estimated_histogram::duration latency);
     std::chrono::milliseconds get_coordinator_read_latency_percentile(double percentile);
 
+    void add_replica_read_latency(gms::inet_address addr, utils::estimated_histogram::duration latency);
+    // The percentile of the recent read latencies of the replica, or nullopt
+    // if there are too few of them. Like the coordinator read latency, the
+    // histogram decays on every refresh of the cached percentile.
+    std::optional<std::chrono::milliseconds> get_replica_read_latency_percentile(gms::inet_address addr, double percentile);
+    void drop_replica_read_latency(gms::inet_address addr);
+
     secondary_index::secondary_index_manager& get_index_manager() {
         return _index_manager;
     }
@@ -1283,6 +1319,8 @@ class database : public peering_sharded_service<database> {
         uint64_t multishard_query_unpopped_bytes = 0;
         uint64_t multishard_query_failed_reader_stops = 0;
         uint64_t multishard_query_failed_reader_saves = 0;
+
+        uint64_t coalesced_counter_updates = 0;
     };
 
     lw_shared_ptr<db_stats> _stats;
@@ -1297,6 +1335,19 @@ class database : public peering_sharded_service<database> {
     database_config _dbcfg;
     backlog_controller::scheduling_group _flush_sg;
     flush_controller _memtable_controller;
+    // Latencies of the user reads and writes on this shard, in microseconds.
+    utils::estimated_histogram _foreground_latency;
+    maintenance_controller _maintenance_controller;
+
+    // Counter updates waiting for counter_update_coalescing_window_in_us
+    // to be applied, together with the ones to the same partition that
+    // arrive meanwhile.
+    struct pending_counter_update {
+        mutation m;
+        db::timeout_clock::time_point timeout;
+        shared_promise<mutation> done;
+    };
+    std::unordered_multimap<dht::token, lw_shared_ptr<pending_counter_update>> _pending_counter_updates;
     drain_progress _drain_progress {};
 
     reader_concurrency_semaphore _read_concurrency_sem;
@@ -1325,6 +1376,8 @@ class database : public peering_sharded_service<database> {
     ks_cf_to_uuid_t _ks_cf_to_uuid;
     std::unique_ptr<db::commitlog> _commitlog;
     std::unique_ptr<db::commitlog> _schema_commitlog;
+    // For the keyspaces in commitlog_segregated_keyspaces.
+    std::unique_ptr<db::commitlog> _segregated_commitlog;
     utils::updateable_value_source<table_schema_version> _version;
     uint32_t _schema_change_count = 0;
     // compaction_manager object is referenced by all column families of a database.
@@ -1339,6 +1392,8 @@ class database : public peering_sharded_service<database> {
     std::unique_ptr<db::large_data_handler> _large_data_handler;
     std::unique_ptr<db::large_data_handler> _nop_large_data_handler;
 
+    // See db::config::secondary_page_cache_directory.
+    std::unique_ptr<utils::secondary_page_cache> _secondary_page_cache;
     std::unique_ptr<sstables::sstables_manager> _user_sstables_manager;
     std::unique_ptr<sstables::sstables_manager> _system_sstables_manager;
 
@@ -1346,6 +1401,8 @@ class database : public peering_sharded_service<database> {
 
     friend db::data_listeners;
     std::unique_ptr<db::data_listeners> _data_listeners;
+    // The always-on toppartitions tracking, if enabled.
+    std::unique_ptr<db::toppartitions_data_listener> _continuous_toppartitions;
 
     service::migration_notifier& _mnotifier;
     gms::feature_service& _feat;
@@ -1358,6 +1415,7 @@ class database : public peering_sharded_service<database> {
     utils::cross_shard_barrier _stop_barrier;
 
     db::rate_limiter _rate_limiter;
+    db::count_min_rate_limiter _count_min_rate_limiter;
 
     serialized_action _update_memtable_flush_static_shares_action;
     utils::observer<float> _memtable_flush_static_shares_observer;
@@ -1397,10 +1455,15 @@ class database : public peering_sharded_service<database> {
 
     future<mutation> do_apply_counter_update(column_family& cf, const frozen_mutation& fm, schema_ptr m_schema, db::timeout_clock::time_point timeout,
                                              tracing::trace_state_ptr trace_state);
+    future<mutation> apply_counter_update(column_family& cf, mutation m, db::timeout_clock::time_point timeout, tracing::trace_state_ptr trace_state);
 
     template<typename Future>
     Future update_write_metrics(Future&& f);
     void update_write_metrics_for_timed_out_write();
+    // Feed the 99th percentile the maintenance controller is driven by.
+    void add_foreground_latency(std::chrono::steady_clock::duration latency);
+    // Decays the recorded latencies, so it is meant to be called only once per controller interval.
+    std::optional<std::chrono::microseconds> get_foreground_latency_percentile(double percentile);
     future<> create_keyspace(const lw_shared_ptr<keyspace_metadata>&, locator::effective_replication_map_factory& erm_factory, bool is_bootstrap, system_keyspace system);
     void remove(const table&) noexcept;
 public:
@@ -1451,6 +1514,9 @@ class database : public peering_sharded_service<database> {
     db::commitlog* schema_commitlog() const {
         return _schema_commitlog.get();
     }
+    db::commitlog* segregated_commitlog() const {
+        return _segregated_commitlog.get();
+    }
     replica::cf_stats* cf_stats() {
         return &_cf_stats;
     }
@@ -1537,6 +1603,11 @@ class database : public peering_sharded_service<database> {
             db::per_partition_rate_limit::account_and_enforce account_and_enforce_info,
             db::operation_type op_type);
 
+    /// Accounts the operation to the rate limiter chosen by the table's
+    /// per_partition_rate_limit options.
+    db::rate_limiter::can_proceed account_operation_to_rate_limit(const schema& s, db::rate_limiter::label& lbl, uint64_t token, uint64_t limit,
+            const db::per_partition_rate_limit::info& rate_limit_info) noexcept;
+
     future<std::tuple<lw_shared_ptr<query::result>, cache_temperature>> query(schema_ptr, const query::read_command& cmd, query::result_options opts,
                                                                   const dht::partition_range_vector& ranges, tracing::trace_state_ptr trace_state,
                                                                   db::timeout_clock::time_point timeout, db::per_partition_rate_limit::info rate_limit_info = std::monostate{});
@@ -1692,6 +1763,13 @@ class database : public peering_sharded_service<database> {
         return *_data_listeners;
     }
 
+    db::toppartitions_data_listener* continuous_toppartitions() noexcept {
+        return _continuous_toppartitions.get();
+    }
+
+    // Drops the partitions tracked so far by the always-on toppartitions tracking.
+    void reset_continuous_toppartitions();
+
     // Get the maximum result size for an unlimited query, appropriate for the
     // query class, which is deduced from the current scheduling group.
     query::max_result_size get_unlimited_query_max_result_size() const;
@@ -28,6 +28,7 @@
 #include "view_info.hh"
 #include "db/data_listeners.hh"
 #include "memtable-sstable.hh"
+#include "mutation_writer/size_based_splitting_writer.hh"
 #include "compaction/compaction_manager.hh"
 #include "compaction/table_state.hh"
 #include "sstables/sstable_directory.hh"
@@ -548,13 +549,30 @@ table::update_cache(compaction_group& cg, lw_shared_ptr<memtable> m, std::vector
         m->mark_flushed(std::move(new_ssts_ms));
         try_trigger_compaction();
     });
-    if (cache_enabled()) {
+    if (!cache_enabled()) {
+        co_return co_await _cache.invalidate(std::move(adder)).then([m] { return m->clear_gently(); });
+    } else if (should_merge_flush_into_cache()) {
+        ++_stats.cache_updates_merged;
         co_return co_await _cache.update(std::move(adder), *m);
     } else {
-        co_return co_await _cache.invalidate(std::move(adder)).then([m] { return m->clear_gently(); });
+        ++_stats.cache_updates_invalidated;
+        co_return co_await _cache.update_invalidating(std::move(adder), *m);
     }
 }
 
+// Merging a flushed memtable into the cache pays off for the reads which
+// find the merged partitions there. Tables written to much more than they
+// are read only invalidate the flushed ranges instead. The hit rate of the
+// cache isn't used, as invalidating lowers it.
+bool table::should_merge_flush_into_cache() {
+    const auto reads = _stats.reads.hist.count;
+    const auto writes = _stats.writes.hist.count;
+    const auto new_reads = reads - std::exchange(_reads_at_last_flush, reads);
+    const auto new_writes = writes - std::exchange(_writes_at_last_flush, writes);
+    const auto min_reads_per_write = _config.cache_update_min_reads_per_write();
+    return min_reads_per_write <= 0 || new_reads >= new_writes * min_reads_per_write;
+}
+
 // Handles permit management only, used for situations where we don't want to inform
 // the compaction manager about backlogs (i.e., tests)
 class permit_monitor : public sstables::write_monitor {
@@ -782,7 +800,10 @@ table::try_flush_memtable_to_sstable(compaction_group& cg, lw_shared_ptr<memtabl
         auto metadata = mutation_source_metadata{};
         metadata.min_timestamp = old->get_min_timestamp();
         metadata.max_timestamp = old->get_max_timestamp();
-        auto estimated_partitions = _compaction_strategy.adjust_partition_estimate(metadata, old->partition_count());
+        metadata.from_memtable = true;
+        const size_t split_size = size_t(_config.memtable_flush_split_size_in_mb()) << 20;
+        const uint64_t pieces = split_size ? std::max<uint64_t>(old->occupancy().used_space() / split_size, 1) : 1;
+        auto estimated_partitions = _compaction_strategy.adjust_partition_estimate(metadata, (old->partition_count() + pieces - 1) / pieces);
 
         if (!_async_gate.is_closed()) {
             co_await _compaction_manager.maybe_wait_for_sstable_count_reduction(as_table_state());
@@ -810,6 +831,14 @@ table::try_flush_memtable_to_sstable(compaction_group& cg, lw_shared_ptr<memtabl
           co_await coroutine::return_exception_ptr(std::move(ex));
         });
 
+        if (pieces > 1) {
+            // Split large memtables into sstables covering consecutive token ranges, so that
+            // each is sealed while the following ones are written.
+            consumer = [split_size, consumer = std::move(consumer)] (flat_mutation_reader_v2 reader) mutable {
+                return mutation_writer::segregate_by_size(std::move(reader), split_size, std::move(consumer));
+            };
+        }
+
         auto f = consumer(old->make_flush_reader(
             old->schema(),
             compaction_concurrency_semaphore().make_tracking_only_permit(old->schema().get(), "try_flush_memtable_to_sstable()", db::no_timeout),
@@ -884,9 +913,13 @@ void table::set_metrics() {
                 ms::make_counter("memtable_row_writes", _stats.memtable_app_stats.row_writes, ms::description("Number of row writes performed in memtables"))(cf)(ks).set_skip_when_empty(),
                 ms::make_counter("memtable_row_hits", _stats.memtable_app_stats.row_hits, ms::description("Number of rows overwritten by write operations in memtables"))(cf)(ks).set_skip_when_empty().set_skip_when_empty(),
                 ms::make_counter("memtable_rows_dropped_by_tombstones", _stats.memtable_app_stats.rows_dropped_by_tombstones, ms::description("Number of rows dropped in memtables by a tombstone write"))(cf)(ks).set_skip_when_empty(),
+                ms::make_counter("memtable_partition_writes_in_place", _stats.memtable_app_stats.partition_writes_in_place, ms::description("Number of writes to memtable partitions which were merged into their latest version"))(cf)(ks).set_skip_when_empty(),
+                ms::make_counter("memtable_partition_versions_created", _stats.memtable_app_stats.partition_versions_created, ms::description("Number of writes to memtable partitions which were added as a new version, because a reader held a snapshot of the latest one or the merge was preempted"))(cf)(ks).set_skip_when_empty(),
                 ms::make_counter("memtable_rows_compacted_with_tombstones", _stats.memtable_app_stats.rows_compacted_with_tombstones, ms::description("Number of rows scanned during write of a tombstone for the purpose of compaction in memtables"))(cf)(ks).set_skip_when_empty(),
                 ms::make_counter("memtable_range_tombstone_reads", _stats.memtable_range_tombstone_reads, ms::description("Number of range tombstones read from memtables"))(cf)(ks).set_skip_when_empty(),
                 ms::make_counter("memtable_row_tombstone_reads", _stats.memtable_row_tombstone_reads, ms::description("Number of row tombstones read from memtables"))(cf)(ks),
+                ms::make_counter("cache_updates_merged", _stats.cache_updates_merged, ms::description("Number of flushed memtables merged into the cache"))(cf)(ks).set_skip_when_empty(),
+                ms::make_counter("cache_updates_invalidated", _stats.cache_updates_invalidated, ms::description("Number of flushed memtables whose ranges were invalidated in the cache instead of merged into it, as the table was read too little"))(cf)(ks).set_skip_when_empty(),
                 ms::make_gauge("pending_tasks", ms::description("Estimated number of tasks pending for this column family"), _stats.pending_flushes)(cf)(ks),
                 ms::make_gauge("live_disk_space", ms::description("Live disk space used"), _stats.live_disk_space_used)(cf)(ks),
                 ms::make_gauge("total_disk_space", ms::description("Total disk space used"), _stats.total_disk_space_used)(cf)(ks),
@@ -1481,7 +1514,7 @@ future<table::snapshot_file_set> table::take_snapshot(database& db, sstring json
     co_await max_concurrent_for_each(tables, db.get_config().initial_sstable_loading_concurrency(), [&db, &jsondir] (sstables::shared_sstable sstable) {
         return with_semaphore(db.get_sharded_sst_dir_semaphore().local(), 1, [&jsondir, sstable] {
             return io_check([sstable, &dir = jsondir] {
-                return sstable->create_links(dir);
+                return sstable->snapshot(dir);
             });
         });
     });
@@ -2279,6 +2312,33 @@ std::chrono::milliseconds table::get_coordinator_read_latency_percentile(double
     return _percentile_cache_value;
 }
 
+void table::add_replica_read_latency(gms::inet_address addr, utils::estimated_histogram::duration latency) {
+    _replica_read_latencies[addr].histogram.add(std::chrono::duration_cast<std::chrono::microseconds>(latency).count());
+}
+
+std::optional<std::chrono::milliseconds> table::get_replica_read_latency_percentile(gms::inet_address addr, double percentile) {
+    auto it = _replica_read_latencies.find(addr);
+    if (it == _replica_read_latencies.end()) {
+        return std::nullopt;
+    }
+    auto& l = it->second;
+    if (l.cached_percentile != percentile || lowres_clock::now() - l.percentile_cache_timestamp > 1s) {
+        l.percentile_cache_timestamp = lowres_clock::now();
+        l.cached_percentile = percentile;
+        if (l.histogram.count()) {
+            l.percentile_cache_value = std::max(l.histogram.percentile(percentile) / 1000, int64_t(1)) * 1ms;
+        } else {
+            l.percentile_cache_value = std::nullopt;
+        }
+        l.histogram *= 0.9;
+    }
+    return l.percentile_cache_value;
+}
+
+void table::drop_replica_read_latency(gms::inet_address addr) {
+    _replica_read_latencies.erase(addr);
+}
+
 void
 table::enable_auto_compaction() {
     // FIXME: unmute backlog. turn table backlog back on.
@@ -2558,6 +2618,9 @@ class compaction_group::table_state : public compaction::table_state {
     const tombstone_gc_state& get_tombstone_gc_state() const noexcept override {
         return _t.get_compaction_manager().get_tombstone_gc_state();
     }
+    const utils::estimated_histogram& get_sstables_per_read_histogram() const noexcept override {
+        return _t.get_stats().estimated_sstable_per_read;
+    }
 };
 
 compaction::table_state& compaction_group::as_table_state() const noexcept {
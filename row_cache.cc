@@ -108,6 +108,7 @@ cache_tracker::setup_metrics() {
         sm::make_gauge("bytes_total", sm::description("total size of memory for the cache"), [this] { return _region.occupancy().total_space(); }),
         sm::make_counter("partition_hits", sm::description("number of partitions needed by reads and found in cache"), _stats.partition_hits),
         sm::make_counter("partition_misses", sm::description("number of partitions needed by reads and missing in cache"), _stats.partition_misses),
+        sm::make_counter("partition_absent_hits", sm::description("number of partitions needed by reads which cache continuity shows not to exist"), _stats.partition_absent_hits),
         sm::make_counter("partition_insertions", sm::description("total number of partitions added to cache"), _stats.partition_insertions),
         sm::make_counter("row_hits", sm::description("total number of rows needed by reads and found in cache"), _stats.row_hits),
         sm::make_counter("dummy_row_hits", sm::description("total number of dummy rows touched by reads in cache"), _stats.dummy_row_hits),
@@ -142,6 +143,12 @@ cache_tracker::setup_metrics() {
             sm::description("total amount of range tombstones processed during read")),
         sm::make_counter("row_tombstone_reads", _stats.row_tombstone_reads,
             sm::description("total amount of row tombstones processed during read")),
+        sm::make_counter("admission_accepts", _stats.admission_accepts,
+            sm::description("total number of partitions read by scans which the admission filter let into the cache")),
+        sm::make_counter("admission_rejections", _stats.admission_rejections,
+            sm::description("total number of partitions read by scans which the admission filter kept out of the cache, because they were estimated to be accessed less often than evicted partitions")),
+        sm::make_gauge("admission_victim_frequency", sm::description("moving average of the estimated access frequency of evicted partitions, which partitions read by scans have to exceed to be admitted"),
+            [this] { return _victim_frequency; }),
     });
 }
 
@@ -175,12 +182,23 @@ void cache_tracker::insert(cache_entry& entry) {
     insert(entry.partition());
     ++_stats.partition_insertions;
     ++_stats.partitions;
+    if (auto o = find_occupancy(*entry.schema())) {
+        ++o->partitions;
+    }
+    if (++_insertions_in_window == eviction_window) {
+        _evicting = _stats.partition_evictions != _evictions_at_window_start;
+        _evictions_at_window_start = _stats.partition_evictions;
+        _insertions_in_window = 0;
+    }
     // partition_range_cursor depends on this to detect invalidation of _end
     _region.allocator().invalidate_references();
 }
 
-void cache_tracker::on_partition_erase() noexcept {
+void cache_tracker::on_partition_erase(const cache_entry& entry) noexcept {
     --_stats.partitions;
+    if (auto o = find_occupancy(*entry.schema())) {
+        --o->partitions;
+    }
     ++_stats.partition_removals;
     allocator().invalidate_references();
 }
@@ -197,9 +215,84 @@ void cache_tracker::on_partition_miss() noexcept {
     ++_stats.partition_misses;
 }
 
-void cache_tracker::on_partition_eviction() noexcept {
+void cache_tracker::on_partition_absent_hit() noexcept {
+    ++_stats.partition_absent_hits;
+}
+
+void cache_tracker::on_partition_eviction(const cache_entry& entry) noexcept {
     --_stats.partitions;
     ++_stats.partition_evictions;
+    if (auto o = find_occupancy(*entry.schema())) {
+        --o->partitions;
+    }
+    if (_admission_sketch) {
+        age_victim_frequency();
+        auto key_hash = row_cache::admission_hash(*entry.schema(), entry.key().token());
+        _victim_frequency += (_admission_sketch->estimate(key_hash) - _victim_frequency) / 16;
+    }
+}
+
+cache_tracker::table_occupancy* cache_tracker::find_occupancy(const schema& s) noexcept {
+    auto it = _table_occupancy.find(s.id());
+    return it == _table_occupancy.end() ? nullptr : &it->second;
+}
+
+bool cache_tracker::has_room_for(const table_occupancy& o) const noexcept {
+    return !_evicting || o.max_share >= 1 || o.partitions < o.max_share * _stats.partitions;
+}
+
+cache_tracker::table_registration::table_registration(cache_tracker& tracker, table_id id)
+    : _tracker(&tracker)
+    , _id(id)
+    , _occupancy(&tracker._table_occupancy[id])
+{
+    ++_occupancy->caches;
+}
+
+cache_tracker::table_registration::table_registration(table_registration&& o) noexcept
+    : _tracker(std::exchange(o._tracker, nullptr))
+    , _id(o._id)
+    , _occupancy(o._occupancy)
+{
+}
+
+cache_tracker::table_registration::~table_registration() {
+    if (_tracker && --_occupancy->caches == 0) {
+        _tracker->_table_occupancy.erase(_id);
+    }
+}
+
+void cache_tracker::enable_admission_filter(size_t capacity) {
+    _admission_sketch.emplace(capacity);
+    _victim_frequency = 0;
+    _victim_frequency_resets = 0;
+}
+
+void cache_tracker::age_victim_frequency() noexcept {
+    // Keep the victim frequency on the same scale as the sketch estimates.
+    while (_victim_frequency_resets < _admission_sketch->resets()) {
+        _victim_frequency /= 2;
+        ++_victim_frequency_resets;
+    }
+}
+
+void cache_tracker::on_partition_access(uint64_t key_hash) noexcept {
+    if (_admission_sketch) {
+        _admission_sketch->record(key_hash);
+    }
+}
+
+bool cache_tracker::admit(uint64_t key_hash) noexcept {
+    if (!_admission_sketch) {
+        return true;
+    }
+    age_victim_frequency();
+    if (_admission_sketch->estimate(key_hash) > _victim_frequency) {
+        ++_stats.admission_accepts;
+        return true;
+    }
+    ++_stats.admission_rejections;
+    return false;
 }
 
 void cache_tracker::on_row_eviction() noexcept {
@@ -382,6 +475,9 @@ class single_partition_populating_reader final : public flat_mutation_reader_v2:
                     _cache._tracker.on_mispopulate();
                 }
                 _end_of_stream = true;
+            } else if (!_cache.has_room()) {
+                _reader = read_directly_from_underlying(*_read_context);
+                this->push_mutation_fragment(std::move(*mfopt));
             } else if (phase == _cache.phase_of(_read_context->range().start()->value())) {
                 _reader = _cache._read_section(_cache._tracker.region(), [&] {
                     cache_entry& e = _cache.find_or_create_incomplete(mfopt->as_partition_start(), phase);
@@ -527,8 +623,18 @@ class range_populating_reader {
                     });
                 }
                 _cache.on_partition_miss();
+                ++_read_context.permit().stats().cache_partition_misses;
                 const partition_start& ps = mfopt->as_partition_start();
                 const dht::decorated_key& key = ps.key();
+                const auto key_hash = row_cache::admission_hash(*_cache._schema, key.token());
+                _cache._tracker.on_partition_access(key_hash);
+                if (!_cache.has_room() || !_cache._tracker.admit(key_hash)) {
+                    // Continuity is not set across a partition which is not in cache,
+                    // since find_or_create_incomplete() checks the previous entry.
+                    _last_key = row_cache::previous_entry_pointer(key);
+                    return make_ready_future<read_result>(
+                            read_result(read_directly_from_underlying(_read_context), std::move(mfopt)));
+                }
                 if (_reader.creation_phase() == _cache.phase_of(key)) {
                     return _cache._read_section(_cache._tracker.region(), [&] {
                         cache_entry& e = _cache.find_or_create_incomplete(ps, _reader.creation_phase(),
@@ -580,6 +686,8 @@ class scanning_and_populating_reader final : public flat_mutation_reader_v2::imp
     flat_mutation_reader_v2 read_from_entry(cache_entry& ce) {
         _cache.upgrade_entry(ce);
         _cache.on_partition_hit();
+        ++_read_context->permit().stats().cache_partition_hits;
+        _cache._tracker.on_partition_access(row_cache::admission_hash(*_cache._schema, ce.key().token()));
         return ce.read(_cache, *_read_context);
     }
 
@@ -751,16 +859,21 @@ row_cache::make_reader_opt(schema_ptr s,
             auto&& pos = range.start()->value();
             partitions_type::bound_hint hint;
             auto i = _partitions.lower_bound(pos, cmp, hint);
+            _tracker.on_partition_access(admission_hash(*_schema, pos.token()));
             if (hint.match) {
                 cache_entry& e = *i;
                 upgrade_entry(e);
                 on_partition_hit();
+                ++permit.stats().cache_partition_hits;
                 return e.read(*this, make_context());
             } else if (i->continuous()) {
+                tracing::trace(trace_state, "Range {} known to be empty in cache", range);
+                _tracker.on_partition_absent_hit();
                 return {};
             } else {
                 tracing::trace(trace_state, "Range {} not found in cache", range);
                 on_partition_miss();
+                ++permit.stats().cache_partition_misses;
                 return make_flat_mutation_reader_v2<single_partition_populating_reader>(*this, make_context());
             }
         });
@@ -786,7 +899,7 @@ row_cache::~row_cache() {
     with_allocator(_tracker.allocator(), [this] {
         _partitions.clear_and_dispose([this] (cache_entry* p) mutable noexcept {
             if (!p->is_dummy_entry()) {
-                _tracker.on_partition_erase();
+                _tracker.on_partition_erase(*p);
             }
             p->evict(_tracker);
         });
@@ -796,7 +909,7 @@ row_cache::~row_cache() {
 void row_cache::clear_now() noexcept {
     with_allocator(_tracker.allocator(), [this] {
         auto it = _partitions.erase_and_dispose(_partitions.begin(), partitions_end(), [this] (cache_entry* p) noexcept {
-            _tracker.on_partition_erase();
+            _tracker.on_partition_erase(*p);
             p->evict(_tracker);
         });
         _tracker.clear_continuity(*it);
@@ -1110,7 +1223,7 @@ void row_cache::invalidate_locked(const dht::decorated_key& dk) {
     } else {
         auto it = pos.erase_and_dispose(dht::raw_token_less_comparator{},
             [this](cache_entry* p) mutable noexcept {
-                _tracker.on_partition_erase();
+                _tracker.on_partition_erase(*p);
                 p->evict(_tracker);
             });
         _tracker.clear_continuity(*it);
@@ -1147,7 +1260,7 @@ future<> row_cache::invalidate(external_updater eu, dht::partition_range_vector&
                             while (it != end) {
                                 it = it.erase_and_dispose(dht::raw_token_less_comparator{},
                                     [&] (cache_entry* p) mutable noexcept {
-                                        _tracker.on_partition_erase();
+                                        _tracker.on_partition_erase(*p);
                                         p->evict(_tracker);
                                     });
                                 // it != end is necessary for correctness. We cannot set _prev_snapshot_pos to end->position()
@@ -1185,10 +1298,12 @@ void row_cache::evict() {
 row_cache::row_cache(schema_ptr s, snapshot_source src, cache_tracker& tracker, is_continuous cont)
     : _tracker(tracker)
     , _schema(std::move(s))
+    , _table_registration(_tracker, _schema->id())
     , _partitions(dht::raw_token_less_comparator{})
     , _underlying(src())
     , _snapshot_source(std::move(src))
 {
+    _table_registration.occupancy().max_share = _schema->caching_options().max_share();
     with_allocator(_tracker.allocator(), [this, cont] {
         cache_entry entry(cache_entry::dummy_entry_tag{});
         entry.set_continuous(bool(cont));
@@ -1211,15 +1326,29 @@ void cache_entry::evict(cache_tracker& tracker) noexcept {
     _pe.evict(tracker.cleaner());
 }
 
+std::vector<dht::decorated_key> row_cache::cached_keys(dht::ring_position_view pos, size_t max_keys) const {
+    std::vector<dht::decorated_key> keys;
+    dht::ring_position_comparator cmp(*_schema);
+    auto i = _partitions.lower_bound(pos, cmp);
+    if (!i->is_dummy_entry() && cmp(i->position(), pos) == 0) {
+        ++i;
+    }
+    for (; !i->is_dummy_entry() && keys.size() < max_keys; ++i) {
+        keys.push_back(i->key());
+    }
+    return keys;
+}
+
 void row_cache::set_schema(schema_ptr new_schema) noexcept {
     _schema = std::move(new_schema);
+    _table_registration.occupancy().max_share = _schema->caching_options().max_share();
 }
 
 void cache_entry::on_evicted(cache_tracker& tracker) noexcept {
     row_cache::partitions_type::iterator it(this);
     std::next(it)->set_continuous(false);
     evict(tracker);
-    tracker.on_partition_eviction();
+    tracker.on_partition_eviction(*this);
     it.erase(dht::raw_token_less_comparator{});
 }
 
@@ -23,6 +23,7 @@
 #include <seastar/core/metrics_registration.hh>
 #include "mutation_cleaner.hh"
 #include "utils/double-decker.hh"
+#include "utils/hash.hh"
 #include "db/cache_tracker.hh"
 #include "readers/empty_v2.hh"
 #include "readers/mutation_source.hh"
@@ -214,6 +215,7 @@ class row_cache final {
     cache_tracker& _tracker;
     stats _stats{};
     schema_ptr _schema;
+    cache_tracker::table_registration _table_registration;
     partitions_type _partitions; // Cached partitions are complete.
 
     // The snapshots used by cache are versioned. The version number of a snapshot is
@@ -265,6 +267,8 @@ class row_cache final {
     void on_row_miss();
     void on_static_row_insert();
     void on_mispopulate();
+    // Whether reads may insert missing partitions, see cache_tracker::has_room_for().
+    bool has_room() const noexcept { return _tracker.has_room_for(_table_registration.occupancy()); }
     void upgrade_entry(cache_entry&);
     void invalidate_locked(const dht::decorated_key&);
     void clear_now() noexcept;
@@ -392,6 +396,18 @@ class row_cache final {
     }
 
     const stats& stats() const { return _stats; }
+
+    // Number of cached partitions of the table.
+    uint64_t partitions() const noexcept { return _table_registration.occupancy().partitions; }
+
+    // Returns the keys of up to max_keys partitions present in cache,
+    // which are positioned after pos, in ring order.
+    std::vector<dht::decorated_key> cached_keys(dht::ring_position_view pos, size_t max_keys) const;
+
+    // Identifies a partition of the table to the cache_tracker admission filter.
+    static uint64_t admission_hash(const schema& s, dht::token t) noexcept {
+        return utils::hash_combine(t.raw(), s.id().uuid().get_least_significant_bits());
+    }
 public:
     // Populate cache from given mutation, which must be fully continuous.
     // Intended to be used only in tests.
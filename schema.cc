@@ -789,7 +789,20 @@ std::ostream& schema::describe(replica::database& db, std::ostream& os) const {
                     os << ", " << clustering_key_columns().front().name_as_cql_string();
                 }
             }
-            os <<");\n";
+            os << ")";
+            // The regular columns of an index, which aren't virtual, are
+            // the columns it includes.
+            n = 0;
+            for (auto& cdef : regular_columns()) {
+                if (cdef.is_view_virtual()) {
+                    continue;
+                }
+                os << (n++ == 0 ? " INCLUDE (" : ", ") << cdef.name_as_cql_string();
+            }
+            if (n != 0) {
+                os << ")";
+            }
+            os << ";\n";
             return os;
         } else {
             os << "MATERIALIZED VIEW " << cql3::util::maybe_quote(ks_name()) << "." << cql3::util::maybe_quote(cf_name()) << " AS\n";
@@ -0,0 +1,24 @@
+/*
+ * Copyright (C) 2022-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include "frozen_mutation.hh"
+#include "db/per_partition_rate_limit_info.hh"
+
+namespace service {
+
+// A mutation sent to a replica in a MUTATION_BATCH message, with what would
+// accompany it in a MUTATION message of its own.
+struct batched_mutation {
+    lw_shared_ptr<const frozen_mutation> fm;
+    uint64_t response_id;
+    db::per_partition_rate_limit::info rate_limit_info;
+};
+
+}
@@ -28,6 +28,7 @@ thread_local api::timestamp_type service::client_state::_last_timestamp_micros =
 
 void service::client_state::set_login(auth::authenticated_user user) {
     _user = std::move(user);
+    _authorized_prepared_ids.clear();
 }
 
 future<> service::client_state::check_user_can_login() {
@@ -10,7 +10,10 @@
 
 #pragma once
 
+#include <unordered_set>
+
 #include "auth/service.hh"
+#include "bytes.hh"
 #include "exceptions/exceptions.hh"
 #include "unimplemented.hh"
 #include "timeout_config.hh"
@@ -126,6 +129,13 @@ class client_state {
 
     workload_type _workload_type = workload_type::unspecified;
 
+    // Ids of the prepared statements authorized for _user, as long as the
+    // generation of the shard's authorized prepared statements cache stays
+    // what it was when they were added.
+    std::unordered_set<bytes> _authorized_prepared_ids;
+    uint64_t _authorized_prepared_generation = 0;
+    static constexpr size_t max_authorized_prepared_ids = 1024;
+
 public:
     struct internal_tag {};
     struct external_tag {};
@@ -316,6 +326,26 @@ class client_state {
      */
     void set_login(auth::authenticated_user);
 
+    /// Whether the prepared statement of the id was authorized for the user
+    /// of this connection while the authorized prepared statements cache of
+    /// the shard had the generation, see cql3::query_processor::get_prepared().
+    bool has_authorized_prepared(const bytes& id, uint64_t generation) {
+        if (generation != _authorized_prepared_generation) {
+            _authorized_prepared_ids.clear();
+            _authorized_prepared_generation = generation;
+            return false;
+        }
+        return _authorized_prepared_ids.contains(id);
+    }
+
+    void add_authorized_prepared(const bytes& id, uint64_t generation) {
+        if (generation != _authorized_prepared_generation || _authorized_prepared_ids.size() >= max_authorized_prepared_ids) {
+            _authorized_prepared_ids.clear();
+            _authorized_prepared_generation = generation;
+        }
+        _authorized_prepared_ids.insert(id);
+    }
+
     /// \brief A user can login if it's anonymous, or if it exists and the `LOGIN` option for the user is `true`.
     future<> check_user_can_login();
 
@@ -9,6 +9,7 @@
 #include "service/forward_service.hh"
 
 #include <boost/range/algorithm/remove_if.hpp>
+#include <numeric>
 #include <seastar/core/coroutine.hh>
 #include <seastar/core/future-util.hh>
 #include <seastar/core/smp.hh>
@@ -59,9 +60,15 @@ static std::vector<::shared_ptr<db::functions::aggregate_function>> get_function
 
 class forward_aggregates {
 private:
+    schema_ptr _schema;
+    std::optional<uint32_t> _group_by_partition_limit;
     std::vector<::shared_ptr<db::functions::aggregate_function>> _funcs;
     std::vector<std::unique_ptr<db::functions::aggregate_function::aggregate>> _aggrs;
 
+private:
+    void reduce(std::vector<bytes_opt>& accumulators, size_t offset, std::vector<bytes_opt>&& other);
+    void merge_grouped(query::forward_result& result, query::forward_result&& other);
+
 public:
     forward_aggregates(const query::forward_request& request);
     void merge(query::forward_result& result, query::forward_result&& other);
@@ -83,7 +90,10 @@ class forward_aggregates {
     }
 };
 
-forward_aggregates::forward_aggregates(const query::forward_request& request) {
+forward_aggregates::forward_aggregates(const query::forward_request& request)
+    : _schema(local_schema_registry().get(request.cmd.schema_version))
+    , _group_by_partition_limit(request.group_by_partition_limit)
+{
     _funcs = get_functions(request);
     std::vector<std::unique_ptr<db::functions::aggregate_function::aggregate>> aggrs;
 
@@ -93,7 +103,63 @@ forward_aggregates::forward_aggregates(const query::forward_request& request) {
     _aggrs = std::move(aggrs);
 }
 
+void forward_aggregates::reduce(std::vector<bytes_opt>& accumulators, size_t offset, std::vector<bytes_opt>&& other) {
+    for (size_t i = 0; i < _aggrs.size(); i++) {
+        _aggrs[i]->set_accumulator(accumulators[offset + i]);
+        _aggrs[i]->reduce(cql_serialization_format::internal(), std::move(other[offset + i]));
+        accumulators[offset + i] = _aggrs[i]->get_accumulator();
+    }
+}
+
+// Both results have the first groups, in ring order, of disjoint sets of
+// ranges. The first groups of the union are among them, so the merged result
+// keeps only the first _group_by_partition_limit ones. Groups are partitions,
+// so the same group is only found in both results if the two sets of ranges
+// had the partition in common, like when a request was retried.
+void forward_aggregates::merge_grouped(query::forward_result& result, query::forward_result&& other) {
+    const auto pk_size = _schema->partition_key_size();
+    std::vector<std::pair<dht::decorated_key, std::vector<bytes_opt>>> groups;
+    groups.reserve(result.grouped_query_results.size() + other.grouped_query_results.size());
+    auto add_groups = [&] (std::vector<std::vector<bytes_opt>>& from) {
+        for (auto& group : from) {
+            if (group.size() != pk_size + _aggrs.size()) {
+                on_internal_error(flogger, format("forward_aggregates::merge_grouped(): group has {} columns, expected {} partition key columns and {} aggregates",
+                        group.size(), pk_size, _aggrs.size()));
+            }
+            auto components = boost::copy_range<std::vector<bytes>>(boost::make_iterator_range(group.begin(), group.begin() + pk_size)
+                    | boost::adaptors::transformed([] (const bytes_opt& b) { return b.value_or(bytes()); }));
+            auto pk = partition_key::from_exploded(*_schema, components);
+            groups.emplace_back(dht::decorate_key(*_schema, std::move(pk)), std::move(group));
+        }
+    };
+    add_groups(result.grouped_query_results);
+    add_groups(other.grouped_query_results);
+
+    std::stable_sort(groups.begin(), groups.end(), [less = dht::decorated_key::less_comparator(_schema)] (const auto& a, const auto& b) {
+        return less(a.first, b.first);
+    });
+
+    result.grouped_query_results.clear();
+    const dht::decorated_key* last = nullptr;
+    for (auto& [dk, group] : groups) {
+        if (last && last->equal(*_schema, dk)) {
+            reduce(result.grouped_query_results.back(), pk_size, std::move(group));
+            continue;
+        }
+        if (result.grouped_query_results.size() == *_group_by_partition_limit) {
+            break;
+        }
+        result.grouped_query_results.push_back(std::move(group));
+        last = &dk;
+    }
+}
+
 void forward_aggregates::merge(query::forward_result &result, query::forward_result&& other) {
+    if (_group_by_partition_limit) {
+        merge_grouped(result, std::move(other));
+        return;
+    }
+
     if (result.query_results.empty()) {
         result.query_results = std::move(other.query_results);
         return;
@@ -112,14 +178,21 @@ void forward_aggregates::merge(query::forward_result &result, query::forward_res
         );
     }
 
-    for (size_t i = 0; i < _aggrs.size(); i++) {
-        _aggrs[i]->set_accumulator(result.query_results[i]);
-        _aggrs[i]->reduce(cql_serialization_format::internal(), std::move(other.query_results[i]));
-        result.query_results[i] = _aggrs[i]->get_accumulator();
-    }
+    reduce(result.query_results, 0, std::move(other.query_results));
 }
 
 void forward_aggregates::finalize(query::forward_result &result) {
+    if (_group_by_partition_limit) {
+        const auto pk_size = _schema->partition_key_size();
+        for (auto& group : result.grouped_query_results) {
+            for (size_t i = 0; i < _aggrs.size(); i++) {
+                _aggrs[i]->set_accumulator(group[pk_size + i]);
+                group[pk_size + i] = _aggrs[i]->compute(cql_serialization_format::internal());
+            }
+        }
+        return;
+    }
+
     if (result.query_results.size() != _aggrs.size()) {
         on_internal_error(
             flogger,
@@ -320,6 +393,14 @@ static shared_ptr<cql3::selection::selection> mock_selection(
         return make_shared<cql3::selection::raw_selector>(fc_expr, column_identifier);
     };
 
+    // Groups start with the partition key, see forward_result::grouped_query_results.
+    if (request.group_by_partition_limit) {
+        for (auto& def : schema->partition_key_columns()) {
+            auto column = cql3::expr::unresolved_identifier{make_shared<cql3::column_identifier_raw>(def.name_as_text(), true)};
+            raw_selectors.emplace_back(make_shared<cql3::selection::raw_selector>(std::move(column), nullptr));
+        }
+    }
+
     for (size_t i = 0; i < request.reduction_types.size(); i++) {
         auto info = (request.aggregation_infos) ? std::optional(request.aggregation_infos->at(i)) : std::nullopt;
         raw_selectors.emplace_back(mock_singular_selection(functions[i], request.reduction_types[i], info));
@@ -394,12 +475,24 @@ future<query::forward_result> forward_service::execute_on_this_shard(
         cql_serialization_format::latest()
     );
 
+    const auto group_by_partition_limit = req.group_by_partition_limit;
+    std::vector<size_t> group_by_cell_indices;
+    if (group_by_partition_limit) {
+        group_by_cell_indices.resize(schema->partition_key_size());
+        std::iota(group_by_cell_indices.begin(), group_by_cell_indices.end(), 0);
+    }
     auto rs_builder = cql3::selection::result_set_builder(
         *selection,
         now,
         cql_serialization_format::latest(),
-        std::vector<size_t>() // Represents empty GROUP BY indices.
+        std::move(group_by_cell_indices)
     );
+    // The groups are partitions, which are read in ring order, so once the
+    // builder has enough groups, the first of them are all this shard has to
+    // return. The last group may be incomplete, it's dropped.
+    auto has_enough_groups = [&] {
+        return group_by_partition_limit && rs_builder.result_set_size() >= *group_by_partition_limit;
+    };
 
     // We serve up to 256 ranges at a time to avoid allocating a huge vector for ranges
     static constexpr size_t max_ranges = 256;
@@ -432,16 +525,35 @@ future<query::forward_result> forward_service::execute_on_this_shard(
         );
 
         // Execute query.
-        while (!pager->is_exhausted()) {
+        while (!pager->is_exhausted() && !has_enough_groups()) {
             co_await pager->fetch_page(rs_builder, DEFAULT_INTERNAL_PAGING_SIZE, now, timeout);
         }
 
         ranges_owned_by_this_shard.clear();
-    } while (current_range);
+    } while (current_range && !has_enough_groups());
 
-    co_return co_await rs_builder.with_thread_if_needed([&req, &rs_builder, reductions = req.reduction_types, tr_state = std::move(tr_state)] {
+    co_return co_await rs_builder.with_thread_if_needed([&req, &rs_builder, &schema, group_by_partition_limit, reductions = req.reduction_types, tr_state = std::move(tr_state)] {
         auto rs = rs_builder.build();
         auto& rows = rs->rows();
+        if (group_by_partition_limit) {
+            query::forward_result res;
+            const auto n = std::min(rows.size(), size_t(*group_by_partition_limit));
+            res.grouped_query_results.reserve(n);
+            for (size_t i = 0; i < n; i++) {
+                if (rows[i].size() != schema->partition_key_size() + reductions.size()) {
+                    flogger.error("aggregation result column count does not match requested column count");
+                    throw std::runtime_error("aggregation result column count does not match requested column count");
+                }
+                // Without any rows, the builder still makes a row of the
+                // aggregates, with no partition key.
+                if (!rows[i][0]) {
+                    continue;
+                }
+                res.grouped_query_results.push_back(rows[i]);
+            }
+            tracing::trace(tr_state, "On shard execution result has {} groups", res.grouped_query_results.size());
+            return res;
+        }
         if (rows.size() != 1) {
             flogger.error("aggregation result row count != 1");
             throw std::runtime_error("aggregation result row count != 1");
@@ -41,6 +41,14 @@ class storage_proxy;
 //   5. `dispatch` merges results from all coordinators and returns merged
 //      result.
 //
+// Queries with GROUP BY the partition key are executed the same way, with
+// the aggregates computed for every partition instead. As a partition is
+// owned by one shard, the shards return disjoint groups, so a request asks
+// for the first `group_by_partition_limit` groups in ring order only: every
+// shard stops reading once it has that many, and every merge keeps the first
+// that many of the groups it merges. The caller pages the groups, by asking
+// for the next ones after the last partition it got.
+//
 // Splitting query into sub-queries in is implemented as:
 //   a. Partition ranges of the original query are split into a sequence of
 //      vnodes.
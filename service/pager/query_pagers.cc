@@ -305,8 +305,9 @@ class ghost_row_deleting_query_pager : public service::pager::query_pager {
             _query_read_repair_decision = qr.read_repair_decision;
             qr.query_result->ensure_counts();
             return seastar::async([this, query_result = std::move(qr.query_result), page_size, now] () mutable -> result<> {
-                handle_result(db::view::delete_ghost_rows_visitor{_proxy, _state, view_ptr(_schema), _timeout_duration},
-                        std::move(query_result), page_size, now);
+                db::view::delete_ghost_rows_visitor visitor{_proxy, _state, view_ptr(_schema), _timeout_duration};
+                handle_result(db::view::delete_ghost_rows_visitor(visitor), std::move(query_result), page_size, now);
+                visitor.wait_for_pending_checks();
                 return bo::success();
             });
         }));
@@ -14,6 +14,8 @@
 #include "db/system_keyspace.hh"
 #include "schema_registry.hh"
 #include "replica/database.hh"
+#include "mutation.hh"
+#include "db/config.hh"
 
 #include "utils/error_injection.hh"
 
@@ -25,6 +27,7 @@ namespace service::paxos {
 logging::logger paxos_state::logger("paxos");
 thread_local paxos_state::key_lock_map paxos_state::_paxos_table_lock;
 thread_local paxos_state::key_lock_map paxos_state::_coordinator_lock;
+thread_local paxos_state::state_cache paxos_state::_state_cache;
 
 paxos_state::key_lock_map::semaphore& paxos_state::key_lock_map::get_semaphore_for_key(const dht::token& key) {
     return _locks.try_emplace(key, 1).first->second;
@@ -37,6 +40,252 @@ void paxos_state::key_lock_map::release_semaphore_for_key(const dht::token& key)
     }
 }
 
+paxos_state::state_cache::entry* paxos_state::state_cache::find(const schema& s, partition_key_view key) {
+    auto it = _entries.find(key_type(s.id(), dht::get_token(s, key)));
+    if (it == _entries.end() || !it->second->key.equal(s, key)) {
+        return nullptr;
+    }
+    return &*it->second;
+}
+
+void paxos_state::state_cache::write_failed(const schema& s, partition_key_view key) {
+    ++_generation;
+    invalidate(s, key);
+}
+
+void paxos_state::state_cache::invalidate(const schema& s, partition_key_view key) {
+    auto it = _entries.find(key_type(s.id(), dht::get_token(s, key)));
+    if (it != _entries.end()) {
+        _memory_usage -= it->second->memory_usage;
+        _lru.erase(it->second);
+        _entries.erase(it);
+    }
+}
+
+template <typename Func>
+bool paxos_state::state_cache::apply(timestamp& current, api::timestamp_type ts, bool is_live, bool current_is_live, bool same_value, Func&& assign) {
+    if (!current.exact) {
+        if (ts <= current.ts) {
+            return false;
+        }
+    } else if (ts < current.ts) {
+        return true;
+    } else if (ts == current.ts) {
+        // Of the same timestamp, a deletion wins, and of two live values the
+        // larger one, which we don't compare.
+        if (!current_is_live || (is_live && same_value)) {
+            return true;
+        }
+        if (is_live) {
+            return false;
+        }
+    }
+    assign();
+    current = timestamp{ts, true};
+    return true;
+}
+
+void paxos_state::state_cache::update_expiry(const schema& s, entry& e, const utils::UUID& ballot) {
+    // The values expire paxos_grace_seconds after they were written, which
+    // is about when their ballot was created, unless the clocks are skewed.
+    if (s.paxos_grace_seconds().count()) {
+        e.expiry = std::min(e.expiry, gc_clock::time_point(utils::UUID_gen::unix_timestamp_in_sec(ballot)) + s.paxos_grace_seconds() / 2);
+    }
+}
+
+void paxos_state::state_cache::update_memory_usage(entry& e) {
+    _memory_usage -= e.memory_usage;
+    e.memory_usage = sizeof(entry) + sizeof(key_type) + e.key.external_memory_usage()
+            + (e.accepted_proposal ? e.accepted_proposal->update.representation().size() : 0)
+            + (e.most_recent_commit ? e.most_recent_commit->update.representation().size() : 0);
+    _memory_usage += e.memory_usage;
+}
+
+void paxos_state::state_cache::evict(size_t max_memory) {
+    while (_memory_usage > max_memory) {
+        auto& e = _lru.back();
+        _memory_usage -= e.memory_usage;
+        _entries.erase(key_type(e.table, e.token));
+        _lru.pop_back();
+    }
+}
+
+std::optional<paxos_state> paxos_state::state_cache::get(const schema& s, partition_key_view key) {
+    auto* e = find(s, key);
+    if (!e) {
+        return std::nullopt;
+    }
+    auto it = _entries.at(key_type(e->table, e->token));
+    if (gc_clock::now() >= e->expiry) {
+        invalidate(s, key);
+        return std::nullopt;
+    }
+    _lru.splice(_lru.begin(), _lru, it);
+    return paxos_state(e->promised_ballot, e->accepted_proposal, e->most_recent_commit);
+}
+
+void paxos_state::state_cache::insert(const schema& s, partition_key_view key, const paxos_state& state, uint64_t generation,
+        size_t max_memory) {
+    evict(max_memory);
+    if (generation != _generation) {
+        return;
+    }
+    auto too_large = [] (const std::optional<proposal>& p) {
+        return p && p->update.representation().size() > max_mutation_size;
+    };
+    if (too_large(state._accepted_proposal) || too_large(state._most_recent_commit)) {
+        return;
+    }
+    invalidate(s, key);
+
+    auto ts_of = [] (const utils::UUID& ballot) {
+        return utils::UUID_gen::micros_timestamp(ballot);
+    };
+    const bool has_promise = state._promised_ballot != utils::UUID_gen::min_time_UUID();
+    // The values missing from the state aren't newer than the newest value present.
+    api::timestamp_type newest = api::missing_timestamp;
+    if (has_promise) {
+        newest = std::max(newest, ts_of(state._promised_ballot));
+    }
+    if (state._accepted_proposal) {
+        newest = std::max(newest, ts_of(state._accepted_proposal->ballot));
+    }
+    if (state._most_recent_commit) {
+        newest = std::max(newest, ts_of(state._most_recent_commit->ballot));
+    }
+    auto ts_of_value = [&] (bool present, const utils::UUID& ballot) {
+        return present ? timestamp{ts_of(ballot), true} : timestamp{newest, false};
+    };
+
+    const auto token = dht::get_token(s, key);
+    auto& e = _lru.emplace_front(entry{
+        .table = s.id(),
+        .token = token,
+        .key = partition_key(key),
+        .promised_ballot = state._promised_ballot,
+        .promised_ts = ts_of_value(has_promise, state._promised_ballot),
+        .accepted_proposal = state._accepted_proposal,
+        .accepted_ts = ts_of_value(bool(state._accepted_proposal), state._accepted_proposal ? state._accepted_proposal->ballot : utils::UUID()),
+        .most_recent_commit = state._most_recent_commit,
+        .commit_ts = ts_of_value(bool(state._most_recent_commit), state._most_recent_commit ? state._most_recent_commit->ballot : utils::UUID()),
+        .expiry = gc_clock::time_point::max(),
+        .memory_usage = 0,
+    });
+    _entries.emplace(key_type(e.table, e.token), _lru.begin());
+    if (has_promise) {
+        update_expiry(s, e, state._promised_ballot);
+    }
+    if (state._accepted_proposal) {
+        update_expiry(s, e, state._accepted_proposal->ballot);
+    }
+    if (state._most_recent_commit) {
+        update_expiry(s, e, state._most_recent_commit->ballot);
+    }
+    update_memory_usage(e);
+    evict(max_memory);
+}
+
+void paxos_state::state_cache::apply_promise(const schema& s, partition_key_view key, const utils::UUID& ballot) {
+    auto* e = find(s, key);
+    if (!e) {
+        ++_generation;
+        return;
+    }
+    bool applied = apply(e->promised_ts, utils::UUID_gen::micros_timestamp(ballot), true, true, e->promised_ballot == ballot, [&] {
+        e->promised_ballot = ballot;
+        update_expiry(s, *e, ballot);
+    });
+    if (!applied) {
+        invalidate(s, key);
+    }
+}
+
+void paxos_state::state_cache::apply_proposal(const schema& s, const proposal& proposal) {
+    auto key = proposal.update.key();
+    auto* e = find(s, key);
+    if (!e) {
+        ++_generation;
+        return;
+    }
+    if (proposal.update.representation().size() > max_mutation_size) {
+        invalidate(s, key);
+        return;
+    }
+    const auto ts = utils::UUID_gen::micros_timestamp(proposal.ballot);
+    bool applied = apply(e->promised_ts, ts, true, true, e->promised_ballot == proposal.ballot, [&] {
+        e->promised_ballot = proposal.ballot;
+        update_expiry(s, *e, proposal.ballot);
+    });
+    applied = applied && apply(e->accepted_ts, ts, true, bool(e->accepted_proposal),
+            e->accepted_proposal && e->accepted_proposal->ballot == proposal.ballot, [&] {
+        e->accepted_proposal = proposal;
+        update_expiry(s, *e, proposal.ballot);
+    });
+    if (!applied) {
+        invalidate(s, key);
+        return;
+    }
+    update_memory_usage(*e);
+}
+
+void paxos_state::state_cache::apply_decision(const schema& s, const proposal& decision) {
+    auto key = decision.update.key();
+    auto* e = find(s, key);
+    if (!e) {
+        ++_generation;
+        return;
+    }
+    if (decision.update.representation().size() > max_mutation_size) {
+        invalidate(s, key);
+        return;
+    }
+    const auto ts = utils::UUID_gen::micros_timestamp(decision.ballot);
+    // Saving a decision deletes the accepted proposal.
+    bool applied = apply(e->accepted_ts, ts, false, bool(e->accepted_proposal), false, [&] {
+        e->accepted_proposal.reset();
+    });
+    applied = applied && apply(e->commit_ts, ts, true, bool(e->most_recent_commit),
+            e->most_recent_commit && e->most_recent_commit->ballot == decision.ballot, [&] {
+        e->most_recent_commit = decision;
+        update_expiry(s, *e, decision.ballot);
+    });
+    if (!applied) {
+        invalidate(s, key);
+        return;
+    }
+    update_memory_usage(*e);
+}
+
+void paxos_state::state_cache::apply_prune(const schema& s, partition_key_view key, const utils::UUID& ballot) {
+    auto* e = find(s, key);
+    if (!e) {
+        ++_generation;
+        return;
+    }
+    // Pruning deletes only the mutation of the decision, which the table
+    // then loads as an empty one.
+    if (e->most_recent_commit && (!e->commit_ts.exact || utils::UUID_gen::micros_timestamp(ballot) >= e->commit_ts.ts)) {
+        e->most_recent_commit->update = freeze(mutation(s.shared_from_this(), key));
+        update_memory_usage(*e);
+    }
+}
+
+future<paxos_state> paxos_state::load(storage_proxy& sp, partition_key_view key, schema_ptr schema, gc_clock::time_point now,
+        clock_type::time_point timeout) {
+    const size_t max_memory = size_t(sp.get_db().local().get_config().paxos_state_cache_size_in_kb()) * 1024;
+    if (max_memory) {
+        if (auto state = _state_cache.get(*schema, key)) {
+            sp.get_stats().cas_replica_state_cache_hits++;
+            co_return std::move(*state);
+        }
+        sp.get_stats().cas_replica_state_cache_misses++;
+    }
+    const auto generation = _state_cache.generation();
+    auto state = co_await db::system_keyspace::load_paxos_state(key, schema, now, timeout);
+    _state_cache.insert(*schema, key, state, generation, max_memory);
+    co_return state;
+}
+
 future<paxos_state::guard> paxos_state::get_cas_lock(const dht::token& key, clock_type::time_point timeout) {
     guard m(_coordinator_lock, key, timeout);
     co_await m.lock();
@@ -58,7 +307,7 @@ future<prepare_response> paxos_state::prepare(storage_proxy& sp, tracing::trace_
             // tombstone that hides any re-submit). See CASSANDRA-12043 for details.
             auto now_in_sec = utils::UUID_gen::unix_timestamp_in_sec(ballot);
 
-            auto f = db::system_keyspace::load_paxos_state(key, schema, gc_clock::time_point(now_in_sec), timeout);
+            auto f = load(sp, key, schema, gc_clock::time_point(now_in_sec), timeout);
             return f.then([&sp, &cmd, token = std::move(token), &key, ballot, tr_state, schema, only_digest, da, timeout] (paxos_state state) {
                 // If received ballot is newer that the one we already accepted it has to be accepted as well,
                 // but we will return the previously accepted proposal so that the new coordinator will use it instead of
@@ -69,7 +318,14 @@ future<prepare_response> paxos_state::prepare(storage_proxy& sp, tracing::trace_
                     if (utils::get_local_injector().enter("paxos_error_before_save_promise")) {
                         return make_exception_future<prepare_response>(utils::injected_error("injected_error_before_save_promise"));
                     }
-                    auto f1 = futurize_invoke(db::system_keyspace::save_paxos_promise, *schema, std::ref(key), ballot, timeout);
+                    auto f1 = futurize_invoke(db::system_keyspace::save_paxos_promise, *schema, std::ref(key), ballot, timeout).then_wrapped([schema, &key, ballot] (future<> f) {
+                        if (f.failed()) {
+                            _state_cache.write_failed(*schema, key);
+                        } else {
+                            _state_cache.apply_promise(*schema, key, ballot);
+                        }
+                        return f;
+                    });
                     auto f2 = futurize_invoke([&] {
                         return do_with(dht::partition_range_vector({dht::partition_range::make_singular({token, key})}),
                                 [&sp, tr_state, schema, &cmd, only_digest, da, timeout] (const dht::partition_range_vector& prv) {
@@ -128,9 +384,9 @@ future<bool> paxos_state::accept(storage_proxy& sp, tracing::trace_state_ptr tr_
             [&sp, token = std::move(token), &proposal, schema, tr_state, timeout] {
         utils::latency_counter lc;
         lc.start();
-        return with_locked_key(token, timeout, [&proposal, schema, tr_state, timeout] () mutable {
+        return with_locked_key(token, timeout, [&sp, &proposal, schema, tr_state, timeout] () mutable {
             auto now_in_sec = utils::UUID_gen::unix_timestamp_in_sec(proposal.ballot);
-            auto f = db::system_keyspace::load_paxos_state(proposal.update.key(), schema, gc_clock::time_point(now_in_sec), timeout);
+            auto f = load(sp, proposal.update.key(), schema, gc_clock::time_point(now_in_sec), timeout);
             return f.then([&proposal, tr_state, schema, timeout] (paxos_state state) {
                 // Accept the proposal if we promised to accept it or the proposal is newer than the one we promised.
                 // Otherwise the proposal was cutoff by another Paxos proposer and has to be rejected.
@@ -142,7 +398,14 @@ future<bool> paxos_state::accept(storage_proxy& sp, tracing::trace_state_ptr tr_
                         return make_exception_future<bool>(utils::injected_error("injected_error_before_save_proposal"));
                     }
 
-                    return db::system_keyspace::save_paxos_proposal(*schema, proposal, timeout).then([] {
+                    return db::system_keyspace::save_paxos_proposal(*schema, proposal, timeout).then_wrapped([schema, &proposal] (future<> f) {
+                        if (f.failed()) {
+                            _state_cache.write_failed(*schema, proposal.update.key());
+                        } else {
+                            _state_cache.apply_proposal(*schema, proposal);
+                        }
+                        return f;
+                    }).then([] {
                         if (utils::get_local_injector().enter("paxos_error_after_save_proposal")) {
                             return make_exception_future<bool>(utils::injected_error("injected_error_after_save_proposal"));
                         }
@@ -217,7 +480,22 @@ future<> paxos_state::learn(storage_proxy& sp, schema_ptr schema, proposal decis
             // We don't need to lock the partition key if there is no gap between loading paxos
             // state and saving it, and here we're just blindly updating.
             return utils::get_local_injector().inject("paxos_timeout_after_save_decision", timeout, [&decision, schema, timeout] {
-                return db::system_keyspace::save_paxos_decision(*schema, decision, timeout);
+                return db::system_keyspace::save_paxos_decision(*schema, decision, timeout).then_wrapped([&decision, schema] (future<> f) {
+                    // Unlike prepare and accept, learn may run on any shard,
+                    // so update the cache of the shard owning the key.
+                    const bool failed = f.failed();
+                    const auto shard = dht::shard_of(*schema, dht::get_token(*schema, decision.update.key()));
+                    return smp::submit_to(shard, [gs = global_schema_ptr(schema), &decision, failed] {
+                        schema_ptr s = gs;
+                        if (failed) {
+                            _state_cache.write_failed(*s, decision.update.key());
+                        } else {
+                            _state_cache.apply_decision(*s, decision);
+                        }
+                    }).then([f = std::move(f)] () mutable {
+                        return std::move(f);
+                    });
+                });
             });
         });
     }).finally([&sp, schema, lc] () mutable {
@@ -230,7 +508,14 @@ future<> paxos_state::prune(schema_ptr schema, const partition_key& key, utils::
         tracing::trace_state_ptr tr_state) {
     logger.debug("Delete paxos state for ballot {}", ballot);
     tracing::trace(tr_state, "Delete paxos state for ballot {}", ballot);
-    return db::system_keyspace::delete_paxos_decision(*schema, key, ballot, timeout);
+    return db::system_keyspace::delete_paxos_decision(*schema, key, ballot, timeout).then_wrapped([schema, key, ballot] (future<> f) {
+        if (f.failed()) {
+            _state_cache.write_failed(*schema, key);
+        } else {
+            _state_cache.apply_prune(*schema, key, ballot);
+        }
+        return f;
+    });
 }
 
 } // end of namespace "service::paxos"
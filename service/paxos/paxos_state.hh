@@ -11,8 +11,10 @@
 #include "log.hh"
 #include "digest_algorithm.hh"
 #include "db/timeout_clock.hh"
+#include <list>
 #include <unordered_map>
 #include "utils/UUID_gen.hh"
+#include "utils/hash.hh"
 #include "service/paxos/prepare_response.hh"
 
 namespace service {
@@ -71,6 +73,87 @@ class paxos_state {
         return _paxos_table_lock.with_locked_key(key, timeout, std::move(func));
     }
 
+public:
+    // Caches the states of the keys of this shard in system.paxos, so that
+    // the prepare and accept rounds, which follow each other on the same key,
+    // don't have to read it from the table every time.
+    //
+    // The cache is written through: every write of the table is applied to
+    // the cached state of its key by the same last-write-wins rules the table
+    // uses, with the timestamps of the ballots. The timestamps of the values
+    // missing from a state loaded from the table are not known, only that
+    // they are not newer than the newest value present, so a write which may
+    // lose to them drops the key from the cache instead. Learn and prune don't
+    // lock the key, so a state loaded while one of them wrote a key which is
+    // not cached may miss the write, and is not cached.
+    class state_cache {
+        // The timestamp of a value, or if not exact, a timestamp the value
+        // is not newer than.
+        struct timestamp {
+            api::timestamp_type ts = api::missing_timestamp;
+            bool exact = false;
+        };
+        struct entry {
+            table_id table;
+            dht::token token;
+            partition_key key;
+            utils::UUID promised_ballot;
+            timestamp promised_ts;
+            std::optional<proposal> accepted_proposal;
+            timestamp accepted_ts;
+            std::optional<proposal> most_recent_commit;
+            timestamp commit_ts;
+            // When the first value of the state may expire, by its TTL.
+            gc_clock::time_point expiry;
+            size_t memory_usage;
+        };
+        using key_type = std::pair<table_id, dht::token>;
+        using lru_type = std::list<entry>;
+
+        // The most recently used first.
+        lru_type _lru;
+        std::unordered_map<key_type, lru_type::iterator, utils::tuple_hash> _entries;
+        size_t _memory_usage = 0;
+        // Changes whenever a key which is not cached is written, or a write fails.
+        uint64_t _generation = 0;
+    private:
+        entry* find(const schema& s, partition_key_view key);
+        // Applies a write of a value with the timestamp `ts`. Returns false
+        // if the write may lose to the cached value, but it isn't certain.
+        template <typename Func>
+        static bool apply(timestamp& current, api::timestamp_type ts, bool is_live, bool current_is_live, bool same_value, Func&& assign);
+        void update_expiry(const schema& s, entry& e, const utils::UUID& ballot);
+        void update_memory_usage(entry& e);
+        void evict(size_t max_memory);
+    public:
+        // Keys holding a proposal or a decision larger than this are not cached.
+        static constexpr size_t max_mutation_size = 128 * 1024;
+
+        uint64_t generation() const noexcept {
+            return _generation;
+        }
+        std::optional<paxos_state> get(const schema& s, partition_key_view key);
+        // Caches a state loaded from the table, unless a key which is not
+        // cached was written since `generation()` returned `generation`.
+        void insert(const schema& s, partition_key_view key, const paxos_state& state, uint64_t generation, size_t max_memory);
+        void apply_promise(const schema& s, partition_key_view key, const utils::UUID& ballot);
+        void apply_proposal(const schema& s, const proposal& proposal);
+        void apply_decision(const schema& s, const proposal& decision);
+        void apply_prune(const schema& s, partition_key_view key, const utils::UUID& ballot);
+        // A write of the key failed or timed out, so it may or may not have
+        // been applied. Drops the key, and keeps the states being loaded from
+        // the table meanwhile, which may or may not see it, from being cached.
+        void write_failed(const schema& s, partition_key_view key);
+        // Drops the key.
+        void invalidate(const schema& s, partition_key_view key);
+    };
+private:
+    static thread_local state_cache _state_cache;
+
+    // Loads the state of the key from the cache, or from the table.
+    static future<paxos_state> load(storage_proxy& sp, partition_key_view key, schema_ptr schema, gc_clock::time_point now,
+            clock_type::time_point timeout);
+
     utils::UUID _promised_ballot = utils::UUID_gen::min_time_UUID();
     std::optional<proposal> _accepted_proposal;
     std::optional<proposal> _most_recent_commit;
@@ -110,6 +193,16 @@ class paxos_state {
         : _promised_ballot(std::move(promised))
         , _accepted_proposal(std::move(accepted))
         , _most_recent_commit(std::move(commit)) {}
+
+    const utils::UUID& promised_ballot() const {
+        return _promised_ballot;
+    }
+    const std::optional<proposal>& accepted_proposal() const {
+        return _accepted_proposal;
+    }
+    const std::optional<proposal>& most_recent_commit() const {
+        return _most_recent_commit;
+    }
     // Replica RPC endpoint for Paxos "prepare" phase.
     static future<prepare_response> prepare(storage_proxy& sp, tracing::trace_state_ptr tr_state, schema_ptr schema,
             const query::read_command& cmd, const partition_key& key, utils::UUID ballot,
@@ -57,6 +57,29 @@ static mutation convert_history_mutation(canonical_mutation m, const data_dictio
 
 future<> group0_state_machine::apply(std::vector<raft::command_cref> command) {
     slogger.trace("apply() is called");
+
+    // The schema changes of consecutive commands are merged with a single merge_schema_from() call,
+    // so a batch of them costs one schema merge, digest recalculation and notification round instead of
+    // one per command. Each merge covers the commands of a single creator, as it's given its address.
+    // The group 0 history is appended after the changes it covers, as for a single command.
+    auto read_apply_mutex_holder = co_await get_units(_client._read_apply_mutex, 1);
+
+    std::optional<utils::UUID> last_group0_state_id;
+    std::optional<gms::inet_address> schema_creator_addr;
+    std::vector<canonical_mutation> schema_mutations;
+    std::vector<mutation> history_mutations;
+
+    auto flush = [&] () -> future<> {
+        if (schema_creator_addr) {
+            co_await _mm.merge_schema_from(netw::messaging_service::msg_addr(*schema_creator_addr), schema_mutations);
+            schema_creator_addr.reset();
+            schema_mutations.clear();
+        }
+        if (!history_mutations.empty()) {
+            co_await _sp.mutate_locally(std::exchange(history_mutations, {}), nullptr);
+        }
+    };
+
     for (auto&& c : command) {
         auto is = ser::as_input_stream(c);
         auto cmd = ser::deserialize(is, boost::type<group0_command>{});
@@ -65,11 +88,12 @@ future<> group0_state_machine::apply(std::vector<raft::command_cref> command) {
                 cmd.prev_state_id, cmd.new_state_id, cmd.creator_addr, cmd.creator_id);
         slogger.trace("cmd.history_append: {}", cmd.history_append);
 
-        auto read_apply_mutex_holder = co_await get_units(_client._read_apply_mutex, 1);
+        if (!last_group0_state_id) {
+            last_group0_state_id = co_await db::system_keyspace::get_last_group0_state_id();
+        }
 
         if (cmd.prev_state_id) {
-            auto last_group0_state_id = co_await db::system_keyspace::get_last_group0_state_id();
-            if (*cmd.prev_state_id != last_group0_state_id) {
+            if (*cmd.prev_state_id != *last_group0_state_id) {
                 // This command used obsolete state. Make it a no-op.
                 // BTW. on restart, all commands after last snapshot descriptor become no-ops even when they originally weren't no-ops.
                 // This is because we don't restart from snapshot descriptor, but using current state of the tables so the last state ID
@@ -77,7 +101,7 @@ future<> group0_state_machine::apply(std::vector<raft::command_cref> command) {
                 // Similar thing may happen when we pull group0 state in transfer_snapshot - we pull the latest state of remote tables,
                 // not state at the snapshot descriptor.
                 slogger.trace("cmd.prev_state_id ({}) different than last group 0 state ID in history table ({})",
-                        cmd.prev_state_id, last_group0_state_id);
+                        cmd.prev_state_id, *last_group0_state_id);
                 continue;
             }
         } else {
@@ -98,16 +122,32 @@ future<> group0_state_machine::apply(std::vector<raft::command_cref> command) {
 
         co_await std::visit(make_visitor(
         [&] (schema_change& chng) -> future<> {
-            return _mm.merge_schema_from(netw::messaging_service::msg_addr(std::move(cmd.creator_addr)), std::move(chng.mutations));
+            if (schema_creator_addr && *schema_creator_addr != cmd.creator_addr) {
+                co_await flush();
+            }
+            if (!schema_creator_addr) {
+                schema_creator_addr = cmd.creator_addr;
+            }
+            std::move(chng.mutations.begin(), chng.mutations.end(), std::back_inserter(schema_mutations));
+            co_return;
         },
         [&] (broadcast_table_query& query) -> future<> {
+            co_await flush();
             auto result = co_await service::broadcast_tables::execute_broadcast_table_query(_sp, query.query, cmd.new_state_id);
             _client.set_query_result(cmd.new_state_id, std::move(result));
         }
         ), cmd.change);
 
-        co_await _sp.mutate_locally({convert_history_mutation(std::move(cmd.history_append), _sp.data_dictionary())}, nullptr);
+        history_mutations.push_back(convert_history_mutation(std::move(cmd.history_append), _sp.data_dictionary()));
+
+        // The history table is ordered by descending state ID, and the last state ID is the first one in it.
+        if (last_group0_state_id->is_null()
+                || timeuuid_type->compare(timeuuid_type->decompose(cmd.new_state_id), timeuuid_type->decompose(*last_group0_state_id)) > 0) {
+            last_group0_state_id = cmd.new_state_id;
+        }
     }
+
+    co_await flush();
 }
 
 future<raft::snapshot_id> group0_state_machine::take_snapshot() {
@@ -0,0 +1,182 @@
+/*
+ * Copyright (C) 2022-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <list>
+#include <optional>
+#include <unordered_map>
+
+#include <seastar/core/lowres_clock.hh>
+
+#include "db/timeout_clock.hh"
+#include "query-request.hh"
+#include "seastarx.hh"
+
+namespace service {
+
+/// Chooses how many vnode ranges each round of a range scan reads
+/// concurrently.
+///
+/// Once a round found some rows, the density of the ranges read so far tells
+/// how many ranges the rest of the limit needs, so a scan with a small limit
+/// doesn't go through many rounds on a sparse table, and one with a large
+/// limit doesn't read many more ranges than it needs. The concurrency is
+/// then bounded by the expected size of the results of a round, so the
+/// coordinator doesn't have to hold much more than a page, which also keeps
+/// unlimited scans from flooding the replicas. The concurrency grows by at
+/// most max_growth a round, in case the ranges read so far were denser than
+/// the rest, and is halved when another round as slow as the last one would
+/// risk timing out.
+class range_scan_concurrency_controller {
+public:
+    using duration = db::timeout_clock::duration;
+
+    static constexpr int max_growth = 4;
+    static constexpr int max_concurrency = 1 << 20;
+    // Margin for the ranges yet to read being less dense than those read.
+    static constexpr double density_margin = 0.10;
+private:
+    uint64_t _memory_budget;
+    int _concurrency = 1;
+    uint64_t _ranges = 0;
+    uint64_t _rows = 0;
+    uint64_t _partitions = 0;
+    uint64_t _bytes = 0;
+private:
+    int ranges_for(uint64_t remaining, uint64_t read) const {
+        const auto per_range = double(read) / _ranges;
+        return std::min(std::ceil(remaining / per_range * (1 + density_margin)), double(max_concurrency));
+    }
+public:
+    /// \arg memory_budget the size the results of a round are expected to fit in
+    explicit range_scan_concurrency_controller(uint64_t memory_budget) noexcept
+        : _memory_budget(std::max(memory_budget, uint64_t(1)))
+    { }
+
+    int concurrency() const noexcept {
+        return _concurrency;
+    }
+
+    /// Accounts for the results of a round and chooses the concurrency of the
+    /// next one.
+    ///
+    /// \arg ranges the number of vnode ranges the round read
+    /// \arg rows, partitions, bytes the amount of results the round returned
+    /// \arg remaining_rows, remaining_partitions the limits left to read
+    /// \arg round_latency how long the round took
+    /// \arg time_left the time left until the timeout of the scan
+    void on_round_completed(size_t ranges, uint64_t rows, uint64_t partitions, uint64_t bytes,
+            uint64_t remaining_rows, uint64_t remaining_partitions, duration round_latency, duration time_left) noexcept {
+        _ranges += ranges;
+        _rows += rows;
+        _partitions += partitions;
+        _bytes += bytes;
+        // The last round may have read less ranges than its concurrency, when
+        // there were no more.
+        const int current = std::max(int(ranges), 1);
+
+        if (round_latency * 2 > time_left) {
+            _concurrency = std::max(current / 2, 1);
+            return;
+        }
+
+        int next = max_concurrency;
+        if (_rows) {
+            next = std::min(next, ranges_for(remaining_rows, _rows));
+        }
+        if (_partitions) {
+            next = std::min(next, ranges_for(remaining_partitions, _partitions));
+        }
+        if (_bytes) {
+            next = std::min(next, int(std::min(std::floor(_memory_budget / (double(_bytes) / _ranges)), double(max_concurrency))));
+        }
+        next = std::min(next, current * max_growth);
+        _concurrency = std::clamp(next, 1, max_concurrency);
+    }
+};
+
+/// The concurrency controllers of paged range scans, kept between pages.
+///
+/// Every page of a range scan is a new query_partition_key_range(), which
+/// would start reading one vnode range at a time again, and take several
+/// rounds to learn how dense the ranges are. When a page ends with the scan
+/// not done, its controller is kept here, by the id the pages of the scan
+/// share, so the next page, if served by the same coordinator shard,
+/// resumes with the concurrency which the previous one ended with.
+///
+/// Controllers of scans which don't come back in time, or which are more
+/// than max_entries, are dropped, oldest first.
+class range_scan_context_cache {
+public:
+    using clock_type = lowres_clock;
+
+    static constexpr size_t max_entries = 10000;
+    static constexpr std::chrono::seconds ttl{10};
+private:
+    struct entry {
+        range_scan_concurrency_controller concurrency;
+        clock_type::time_point expiry;
+        std::list<query_id>::iterator lru_it;
+    };
+    std::unordered_map<query_id, entry> _entries;
+    // Oldest first.
+    std::list<query_id> _lru;
+private:
+    void erase(std::unordered_map<query_id, entry>::iterator it) noexcept {
+        _lru.erase(it->second.lru_it);
+        _entries.erase(it);
+    }
+    void evict(clock_type::time_point now) noexcept {
+        while (!_lru.empty()) {
+            auto it = _entries.find(_lru.front());
+            if (_entries.size() <= max_entries && it->second.expiry > now) {
+                break;
+            }
+            erase(it);
+        }
+    }
+public:
+    /// Keeps the controller of the scan until its next page.
+    void put(query_id id, range_scan_concurrency_controller concurrency, clock_type::time_point now = clock_type::now()) {
+        if (auto it = _entries.find(id); it != _entries.end()) {
+            erase(it);
+        }
+        _lru.push_back(id);
+        try {
+            _entries.emplace(id, entry{std::move(concurrency), now + ttl, std::prev(_lru.end())});
+        } catch (...) {
+            _lru.pop_back();
+            throw;
+        }
+        evict(now);
+    }
+
+    /// Takes the controller of the scan, if it was kept and didn't expire.
+    std::optional<range_scan_concurrency_controller> take(query_id id, clock_type::time_point now = clock_type::now()) noexcept {
+        auto it = _entries.find(id);
+        if (it == _entries.end()) {
+            return std::nullopt;
+        }
+        std::optional<range_scan_concurrency_controller> concurrency;
+        if (it->second.expiry > now) {
+            concurrency.emplace(std::move(it->second.concurrency));
+        }
+        erase(it);
+        return concurrency;
+    }
+
+    size_t size() const noexcept {
+        return _entries.size();
+    }
+};
+
+}
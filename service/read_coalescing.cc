@@ -0,0 +1,65 @@
+/*
+ * Copyright (C) 2022-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <bit>
+
+#include "service/read_coalescing.hh"
+#include "utils/hash.hh"
+
+namespace service {
+
+bool can_coalesce_read(const query::read_command& cmd, const dht::partition_range_vector& ranges) {
+    // Reads with specific ranges or a row filter are paged or filtering
+    // reads, which are not worth comparing.
+    return ranges.size() == 1 && query::is_single_partition(ranges.front())
+            && !cmd.slice.get_specific_ranges() && !cmd.slice.get_row_filter();
+}
+
+unsigned coalesced_read_timeout_class(lowres_clock::duration time_left) {
+    const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(time_left).count();
+    return ms > 0 ? std::bit_width(uint64_t(ms)) : 0;
+}
+
+size_t coalesced_read_hash(const query::read_command& cmd, const dht::partition_range& range, db::consistency_level cl, unsigned timeout_class) {
+    size_t h = std::hash<table_schema_version>()(cmd.schema_version);
+    h = utils::hash_combine(h, std::hash<int64_t>()(dht::token::to_int64(range.start()->value().token())));
+    h = utils::hash_combine(h, std::hash<unsigned>()(unsigned(cl)));
+    return utils::hash_combine(h, std::hash<unsigned>()(timeout_class));
+}
+
+static bool same_bound(const schema& s, const std::optional<query::clustering_range::bound>& a,
+        const std::optional<query::clustering_range::bound>& b) {
+    return a ? b && a->is_inclusive() == b->is_inclusive() && a->value().equal(s, b->value()) : !b;
+}
+
+static bool same_ranges(const schema& s, const query::clustering_row_ranges& a, const query::clustering_row_ranges& b) {
+    return std::equal(a.begin(), a.end(), b.begin(), b.end(), [&] (const query::clustering_range& x, const query::clustering_range& y) {
+        return x.is_singular() == y.is_singular() && same_bound(s, x.start(), y.start()) && same_bound(s, x.end(), y.end());
+    });
+}
+
+bool are_identical_reads(const schema& s, const query::read_command& a, const dht::partition_range& a_range,
+        const query::read_command& b, const dht::partition_range& b_range) {
+    // The query time and timestamp of the reads are not compared, the reads
+    // are in flight at the same time.
+    return a.schema_version == b.schema_version
+            && a.get_row_limit() == b.get_row_limit()
+            && a.partition_limit == b.partition_limit
+            && a.tombstone_limit == b.tombstone_limit
+            && a.max_result_size == b.max_result_size
+            && a.allow_limit == b.allow_limit
+            && a_range.start()->value().as_decorated_key().equal(s, b_range.start()->value().as_decorated_key())
+            && a.slice.options.mask() == b.slice.options.mask()
+            && a.slice.static_columns == b.slice.static_columns
+            && a.slice.regular_columns == b.slice.regular_columns
+            && a.slice.cql_format() == b.slice.cql_format()
+            && a.slice.partition_row_limit() == b.slice.partition_row_limit()
+            && same_ranges(s, a.slice.default_row_ranges(), b.slice.default_row_ranges());
+}
+
+}
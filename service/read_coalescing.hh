@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) 2022-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <seastar/core/lowres_clock.hh>
+
+#include "db/consistency_level_type.hh"
+#include "dht/i_partitioner.hh"
+#include "query-request.hh"
+#include "seastarx.hh"
+
+namespace service {
+
+/// Read coalescing.
+///
+/// When many clients read the same partition at the same time, like when a
+/// popular key just got evicted from the cache, every read fans out to the
+/// replicas separately, although they would all get the same result. With
+/// the coalesce_reads caching option of a table, the coordinator serves
+/// identical single-partition reads which are in flight at the same time
+/// with a single read: the first one reads from the replicas, and the ones
+/// which arrive before it completes wait for its result.
+///
+/// Reads are identical if they read the same rows and columns of the same
+/// partition with the same schema, limits and consistency level, in the same
+/// timeout class. A read which joins another one still fails at its own
+/// timeout, but the one it joined may time out before it, so only reads with
+/// similar timeouts are coalesced.
+
+/// Whether the read is a single-partition read which can be coalesced.
+bool can_coalesce_read(const query::read_command& cmd, const dht::partition_range_vector& ranges);
+
+/// The timeout class of a read with the given time left: the power of two
+/// of its milliseconds.
+unsigned coalesced_read_timeout_class(lowres_clock::duration time_left);
+
+/// The hash of a coalescable read, equal for identical reads.
+size_t coalesced_read_hash(const query::read_command& cmd, const dht::partition_range& range, db::consistency_level cl, unsigned timeout_class);
+
+/// Whether two coalescable reads, with the same consistency level and
+/// timeout class, are identical.
+bool are_identical_reads(const schema& s, const query::read_command& a, const dht::partition_range& a_range,
+        const query::read_command& b, const dht::partition_range& b_range);
+
+}
@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2022-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cmath>
+#include <optional>
+#include <unordered_map>
+
+#include <seastar/core/lowres_clock.hh>
+
+#include "gms/inet_address.hh"
+#include "seastarx.hh"
+
+namespace service {
+
+/// The load of the replicas, as seen by the reads of one coordinator shard.
+///
+/// For every replica, it tracks the read requests in flight to it and an
+/// exponentially decayed average of the latencies of its replies. The cost
+/// of sending another read to a replica is its latency times the number of
+/// requests in flight to it, plus one, so a replica which is slow because it
+/// is busy with compaction, or which has a queue of requests, gets less
+/// reads, and the in-flight count reacts to the reads sent before their
+/// replies, and their latencies, come back.
+///
+/// It is used to choose between two replicas picked by the cache hit rate
+/// based load balancing (the power of two choices), which already spreads the
+/// reads, so they don't all turn to the least loaded replica at once. To
+/// keep the load from oscillating further, a replica is only preferred when
+/// it is cheaper by a margin, and replicas without recent replies have no
+/// known cost, so they are not avoided until they get reads again.
+class replica_load_tracker {
+public:
+    using clock_type = lowres_clock;
+
+    /// The time constant of the decay of the average latency.
+    static constexpr std::chrono::milliseconds latency_decay{500};
+    /// Replies older than this no longer tell the cost of the replica.
+    static constexpr std::chrono::seconds max_age{2};
+    /// How much cheaper a replica must be to be preferred.
+    static constexpr double margin = 0.5;
+
+private:
+    struct load {
+        double latency_us = 0;
+        clock_type::time_point last_reply;
+        bool has_replies = false;
+        uint32_t in_flight = 0;
+    };
+    std::unordered_map<gms::inet_address, load> _loads;
+
+public:
+    void on_request(gms::inet_address ep) {
+        ++_loads[ep].in_flight;
+    }
+
+    /// A request completed, with the latency of the replica if it replied.
+    void on_completion(gms::inet_address ep, std::optional<std::chrono::microseconds> latency, clock_type::time_point now = clock_type::now()) {
+        auto it = _loads.find(ep);
+        if (it == _loads.end()) {
+            // Dropped since the request was sent.
+            return;
+        }
+        auto& l = it->second;
+        l.in_flight -= l.in_flight > 0;
+        if (!latency) {
+            return;
+        }
+        if (!l.has_replies) {
+            l.latency_us = latency->count();
+        } else {
+            const double dt = std::chrono::duration<double>(now - l.last_reply).count();
+            const double w = 1 - std::exp(-dt / std::chrono::duration<double>(latency_decay).count());
+            l.latency_us += (latency->count() - l.latency_us) * w;
+        }
+        l.last_reply = std::max(l.last_reply, now);
+        l.has_replies = true;
+    }
+
+    /// The cost of sending another read to the replica, or nullopt if it
+    /// isn't known.
+    std::optional<double> cost(gms::inet_address ep, clock_type::time_point now = clock_type::now()) const {
+        auto it = _loads.find(ep);
+        if (it == _loads.end() || !it->second.has_replies || now - it->second.last_reply > max_age) {
+            return std::nullopt;
+        }
+        return it->second.latency_us * (it->second.in_flight + 1);
+    }
+
+    /// Whether the candidate replica should be read from instead of the
+    /// chosen one.
+    bool prefer(gms::inet_address candidate, gms::inet_address chosen, clock_type::time_point now = clock_type::now()) const {
+        auto candidate_cost = cost(candidate, now);
+        auto chosen_cost = cost(chosen, now);
+        return candidate_cost && chosen_cost && *candidate_cost * (1 + margin) < *chosen_cost;
+    }
+
+    void drop(gms::inet_address ep) {
+        _loads.erase(ep);
+    }
+};
+
+}
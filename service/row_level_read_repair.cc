@@ -0,0 +1,193 @@
+/*
+ * Copyright (C) 2022-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <algorithm>
+#include <map>
+
+#include <seastar/core/coroutine.hh>
+#include <seastar/coroutine/maybe_yield.hh>
+
+#include "service/row_level_read_repair.hh"
+#include "hashing_partition_visitor.hh"
+#include "mutation_query.hh"
+#include "xx_hasher.hh"
+
+namespace service {
+
+namespace {
+
+// Hashes like the hashes of repair rows, and counts the bytes hashed, which
+// approximate the size of the data.
+class block_hasher {
+    xx_hasher _h;
+    uint64_t _size = 0;
+public:
+    void update(const char* ptr, size_t length) noexcept {
+        _h.update(ptr, length);
+        _size += length;
+    }
+    uint64_t finalize() {
+        return _h.finalize_uint64();
+    }
+    uint64_t size() const {
+        return _size;
+    }
+};
+
+static_assert(Hasher<block_hasher>);
+
+bool ends_block(const schema& s, const clustering_key& key, uint32_t block_rows) {
+    xx_hasher h;
+    feed_hash(h, key, s);
+    return h.finalize_uint64() % block_rows == 0;
+}
+
+}
+
+future<partition_block_digests> compute_block_digests(const schema& s, const query::read_command& cmd, const reconcilable_result& result,
+        uint32_t block_rows) {
+    partition_block_digests digests;
+    const auto& partitions = result.partitions();
+    if (partitions.size() > 1) {
+        // Not a single-partition read, leave the digests incomplete.
+        co_return digests;
+    }
+    digests.complete = !result.is_short_read() && result.row_count() < cmd.get_row_limit()
+            && (partitions.empty() || partitions.front().row_count() < cmd.slice.partition_row_limit());
+
+    std::optional<mutation> mut;
+    if (!partitions.empty()) {
+        mut = co_await partitions.front().mut().unfreeze_gently(s.shared_from_this());
+    }
+    // A missing partition is the same as an empty one.
+    const mutation_partition empty(s.shared_from_this());
+    const mutation_partition& m = mut ? mut->partition() : empty;
+
+    block_hasher header;
+    {
+        hashing_partition_visitor<block_hasher> v(header, s);
+        v.accept_partition_tombstone(m.partition_tombstone());
+        m.static_row().for_each_cell([&] (column_id id, const atomic_cell_or_collection& cell) {
+            const column_definition& def = s.static_column_at(id);
+            if (def.is_atomic()) {
+                v.accept_static_cell(id, cell.as_atomic_cell(def));
+            } else {
+                v.accept_static_cell(id, cell.as_collection_mutation());
+            }
+        });
+        for (const auto& rt : m.row_tombstones()) {
+            v.accept_row_tombstone(rt.tombstone());
+        }
+    }
+    digests.header_hash = header.finalize();
+
+    block_hasher block;
+    const clustering_key* last = nullptr;
+    for (const rows_entry& e : m.clustered_rows()) {
+        if (e.dummy()) {
+            continue;
+        }
+        hashing_partition_visitor<block_hasher> v(block, s);
+        const deletable_row& dr = e.row();
+        v.accept_row(e.position(), dr.deleted_at(), dr.marker(), e.dummy(), e.continuous());
+        dr.cells().for_each_cell([&] (column_id id, const atomic_cell_or_collection& cell) {
+            const column_definition& def = s.regular_column_at(id);
+            if (def.is_atomic()) {
+                v.accept_row_cell(id, cell.as_atomic_cell(def));
+            } else {
+                v.accept_row_cell(id, cell.as_collection_mutation());
+            }
+        });
+        last = &e.key();
+        if (ends_block(s, e.key(), block_rows)) {
+            digests.blocks.push_back(clustering_block_digest{e.key(), block.finalize(), block.size()});
+            block = block_hasher();
+            last = nullptr;
+        }
+        co_await coroutine::maybe_yield();
+    }
+    if (last) {
+        digests.blocks.push_back(clustering_block_digest{*last, block.finalize(), block.size()});
+    }
+    co_return digests;
+}
+
+std::optional<differing_ranges> find_differing_ranges(const schema& s, const query::clustering_row_ranges& ranges,
+        const std::vector<partition_block_digests>& digests) {
+    if (digests.size() < 2) {
+        return std::nullopt;
+    }
+    for (const auto& d : digests) {
+        if (!d.complete || d.header_hash != digests.front().header_hash) {
+            return std::nullopt;
+        }
+    }
+
+    const clustering_key::equality eq(s);
+    struct block_info {
+        const clustering_key* start;
+        uint64_t hash;
+    };
+    // The blocks of every replica but the first, by their last row.
+    std::vector<std::map<clustering_key, block_info, clustering_key::less_compare>> others;
+    others.reserve(digests.size() - 1);
+    for (auto it = digests.begin() + 1; it != digests.end(); ++it) {
+        auto& blocks = others.emplace_back(clustering_key::less_compare(s));
+        const clustering_key* start = nullptr;
+        for (const auto& b : it->blocks) {
+            blocks.emplace(b.last, block_info{start, b.hash});
+            start = &b.last;
+        }
+    }
+    auto same_start = [&] (const clustering_key* a, const clustering_key* b) {
+        return a ? b && eq(*a, *b) : !b;
+    };
+
+    differing_ranges result;
+    auto add_gap = [&] (const clustering_key* after, const clustering_key* upto) {
+        auto gap = ranges;
+        if (after) {
+            query::trim_clustering_row_ranges_to(s, gap, position_in_partition_view::after_key(*after));
+        }
+        if (upto) {
+            query::trim_clustering_row_ranges_to(s, gap, position_in_partition_view::after_key(*upto), true);
+        }
+        std::move(gap.begin(), gap.end(), std::back_inserter(result.ranges));
+    };
+
+    // The rows between the blocks which are the same on all replicas differ.
+    size_t same_blocks = 0;
+    const clustering_key* start = nullptr;
+    const clustering_key* differing_from = nullptr;
+    for (const auto& b : digests.front().blocks) {
+        bool same = std::all_of(others.begin(), others.end(), [&] (const auto& blocks) {
+            auto it = blocks.find(b.last);
+            return it != blocks.end() && it->second.hash == b.hash && same_start(it->second.start, start);
+        });
+        if (same) {
+            if (!same_start(start, differing_from)) {
+                add_gap(differing_from, start);
+            }
+            differing_from = &b.last;
+            result.same_size += b.size;
+            ++same_blocks;
+        }
+        start = &b.last;
+    }
+    if (!same_blocks) {
+        return std::nullopt;
+    }
+    if (std::all_of(digests.begin(), digests.end(), [&] (const auto& d) { return d.blocks.size() == same_blocks; })) {
+        // The digests of the results differed, but their blocks don't.
+        return std::nullopt;
+    }
+    add_gap(differing_from, nullptr);
+    return result;
+}
+
+}
@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2022-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <optional>
+#include <vector>
+
+#include <seastar/core/future.hh>
+
+#include "keys.hh"
+#include "query-request.hh"
+#include "seastarx.hh"
+
+class reconcilable_result;
+
+namespace service {
+
+/// Row-level read repair.
+///
+/// When the digests of a single-partition read mismatch, the coordinator has
+/// to reconcile the results of the replicas, which for a wide partition with
+/// a single differing row means fetching the whole result from every replica.
+/// Instead, it can first ask every replica for the digests of its result by
+/// blocks of rows, and then fetch the whole result from one replica only, and
+/// from the others only the rows of the blocks which differ between them.
+///
+/// The rows are split to blocks by their keys, so that the blocks of all
+/// replicas which have the same rows end at the same rows: a block ends at
+/// every row whose key hashes to a multiple of the block size. A row missing
+/// on one replica therefore changes only the blocks around it, rather than
+/// shifting all blocks after it.
+
+/// The average number of rows of a block.
+constexpr uint32_t read_repair_block_rows = 128;
+
+/// The digest of a block of rows.
+struct clustering_block_digest {
+    /// The last row of the block. The block starts after the last row of the
+    /// previous block, or at the start of the partition.
+    clustering_key last;
+    uint64_t hash;
+    /// The size of the data of the rows of the block.
+    uint64_t size;
+};
+
+/// The digests of a replica's result of a single-partition read.
+struct partition_block_digests {
+    /// The digest of everything but the rows: the partition tombstone, the
+    /// static row and the range tombstones.
+    uint64_t header_hash = 0;
+    std::vector<clustering_block_digest> blocks;
+    /// Whether the result holds all rows of the read, which is the case
+    /// unless it was cut short by a limit. Only the blocks of complete
+    /// results can be reconciled separately.
+    bool complete = false;
+};
+
+/// Computes the block digests of the result of a single-partition mutation
+/// read.
+future<partition_block_digests> compute_block_digests(const schema& s, const query::read_command& cmd, const reconcilable_result& result,
+        uint32_t block_rows);
+
+struct differing_ranges {
+    /// The clustering ranges of the read which hold the blocks which differ
+    /// between the replicas.
+    query::clustering_row_ranges ranges;
+    /// The size of the data of the blocks which are the same on all replicas.
+    uint64_t same_size = 0;
+};
+
+/// Compares the block digests of the results of the replicas.
+///
+/// Returns the parts of the clustering ranges of the read which are not
+/// known to be the same on all replicas, or nothing if all of them, or
+/// none, would have to be reconciled anyway.
+std::optional<differing_ranges> find_differing_ranges(const schema& s, const query::clustering_row_ranges& ranges,
+        const std::vector<partition_block_digests>& digests);
+
+}
@@ -10,6 +10,7 @@
 
 #include <random>
 #include <seastar/core/sleep.hh>
+#include <seastar/core/shared_future.hh>
 #include <seastar/util/defer.hh>
 #include "partition_range_compat.hh"
 #include "db/consistency_level.hh"
@@ -18,6 +19,7 @@
 #include "unimplemented.hh"
 #include "mutation.hh"
 #include "frozen_mutation.hh"
+#include "service/batched_mutation.hh"
 #include "supervisor.hh"
 #include "query_result_merger.hh"
 #include <seastar/core/do_with.hh>
@@ -74,10 +76,12 @@
 #include "locator/token_metadata.hh"
 #include <seastar/core/coroutine.hh>
 #include <seastar/coroutine/parallel_for_each.hh>
+#include <seastar/coroutine/as_future.hh>
 #include "locator/abstract_replication_strategy.hh"
 #include "service/paxos/cas_request.hh"
 #include "mutation_partition_view.hh"
 #include "service/paxos/paxos_state.hh"
+#include "service/read_coalescing.hh"
 #include "gms/feature_service.hh"
 #include "db/virtual_table.hh"
 #include "canonical_mutation.hh"
@@ -168,6 +172,7 @@ class storage_proxy::remote {
 
         ser::storage_proxy_rpc_verbs::register_counter_mutation(&_ms, std::bind_front(&remote::handle_counter_mutation, this));
         ser::storage_proxy_rpc_verbs::register_mutation(&_ms, std::bind_front(&remote::receive_mutation_handler, this, sp->_write_smp_service_group));
+        ser::storage_proxy_rpc_verbs::register_mutation_batch(&_ms, std::bind_front(&remote::receive_mutation_batch_handler, this, sp->_write_smp_service_group));
         ser::storage_proxy_rpc_verbs::register_hint_mutation(&_ms, [this, sp] <typename... Args>(Args&&... args) { return receive_mutation_handler(sp->_hints_write_smp_service_group, std::forward<Args>(args)..., std::monostate()); });
         ser::storage_proxy_rpc_verbs::register_paxos_learn(&_ms, std::bind_front(&remote::handle_paxos_learn, this));
         ser::storage_proxy_rpc_verbs::register_mutation_done(&_ms, std::bind_front(&remote::handle_mutation_done, this));
@@ -175,6 +180,7 @@ class storage_proxy::remote {
         ser::storage_proxy_rpc_verbs::register_read_data(&_ms, std::bind_front(&remote::handle_read_data, this));
         ser::storage_proxy_rpc_verbs::register_read_mutation_data(&_ms, std::bind_front(&remote::handle_read_mutation_data, this));
         ser::storage_proxy_rpc_verbs::register_read_digest(&_ms, std::bind_front(&remote::handle_read_digest, this));
+        ser::storage_proxy_rpc_verbs::register_read_block_digests(&_ms, std::bind_front(&remote::handle_read_block_digests, this));
         ser::storage_proxy_rpc_verbs::register_truncate(&_ms, std::bind_front(&remote::handle_truncate, this));
         // Register PAXOS verb handlers
         ser::storage_proxy_rpc_verbs::register_paxos_prepare(&_ms, std::bind_front(&remote::handle_paxos_prepare, this));
@@ -197,14 +203,22 @@ class storage_proxy::remote {
 
     future<> send_mutation(
             netw::msg_addr addr, storage_proxy::clock_type::time_point timeout, std::optional<tracing::trace_info> trace_info,
-            frozen_mutation m, inet_address_vector_replica_set&& forward, gms::inet_address reply_to, unsigned shard,
+            const frozen_mutation& m, inet_address_vector_replica_set&& forward, gms::inet_address reply_to, unsigned shard,
             storage_proxy::response_id_type response_id, db::per_partition_rate_limit::info rate_limit_info) {
         return ser::storage_proxy_rpc_verbs::send_mutation(
                 &_ms, std::move(addr), timeout,
-                std::move(m), std::move(forward), std::move(reply_to), shard,
+                m, std::move(forward), std::move(reply_to), shard,
                 response_id, std::move(trace_info), rate_limit_info);
     }
 
+    future<> send_mutation_batch(
+            netw::msg_addr addr, storage_proxy::clock_type::time_point timeout, std::optional<tracing::trace_info> trace_info,
+            std::vector<batched_mutation> mutations, gms::inet_address reply_to, unsigned shard) {
+        return ser::storage_proxy_rpc_verbs::send_mutation_batch(
+                &_ms, std::move(addr), timeout,
+                std::move(mutations), std::move(reply_to), shard, std::move(trace_info));
+    }
+
     future<> send_hint_mutation(
             netw::msg_addr addr, storage_proxy::clock_type::time_point timeout, tracing::trace_state_ptr tr_state,
             frozen_mutation m, inet_address_vector_replica_set&& forward, gms::inet_address reply_to, unsigned shard,
@@ -257,6 +271,20 @@ class storage_proxy::remote {
         co_return rpc::tuple{make_foreign(::make_lw_shared<reconcilable_result>(std::move(result))), hit_rate.value_or(cache_temperature::invalid())};
     }
 
+    future<rpc::tuple<partition_block_digests, cache_temperature>>
+    send_read_block_digests(
+            netw::msg_addr addr, storage_proxy::clock_type::time_point timeout, tracing::trace_state_ptr tr_state,
+            const query::read_command& cmd, const dht::partition_range& pr, uint32_t block_rows) {
+        tracing::trace(tr_state, "read_block_digests: sending a message to /{}", addr.addr);
+        auto&& [digests, hit_rate, opt_exception] = co_await ser::storage_proxy_rpc_verbs::send_read_block_digests(&_ms, addr, timeout, cmd, pr, block_rows);
+        if (opt_exception) {
+            co_await coroutine::return_exception_ptr(opt_exception.into_exception_ptr());
+        }
+
+        tracing::trace(tr_state, "read_block_digests: got response from /{}", addr.addr);
+        co_return rpc::tuple{std::move(digests), hit_rate};
+    }
+
     future<rpc::tuple<foreign_ptr<lw_shared_ptr<query::result>>, cache_temperature>>
     send_read_data(
             netw::msg_addr addr, storage_proxy::clock_type::time_point timeout, tracing::trace_state_ptr tr_state,
@@ -501,17 +529,50 @@ class storage_proxy::remote {
         auto src_addr = netw::messaging_service::get_source(cinfo);
         auto rate_limit_info = rate_limit_info_opt.value_or(std::monostate());
 
-        auto schema_version = in.schema_version();
-        return handle_write(src_addr, t, schema_version, std::move(in), std::move(forward), reply_to, shard, response_id,
-                trace_info ? *trace_info : std::nullopt,
-                /* apply_fn */ [smp_grp, rate_limit_info] (shared_ptr<storage_proxy>& p, tracing::trace_state_ptr tr_state, schema_ptr s, const frozen_mutation& m,
+        return handle_mutation(smp_grp, std::move(src_addr), t, std::move(in), std::move(forward), reply_to, shard, response_id,
+                trace_info ? *trace_info : std::nullopt, rate_limit_info);
+    }
+
+    future<rpc::no_wait_type> receive_mutation_batch_handler(
+            smp_service_group smp_grp, const rpc::client_info& cinfo, rpc::opt_time_point t,
+            std::vector<batched_mutation> mutations, gms::inet_address reply_to, unsigned shard,
+            std::optional<tracing::trace_info> trace_info) {
+        auto src_addr = netw::messaging_service::get_source(cinfo);
+
+        // Every mutation is handled, and responded to, as if it came in a MUTATION message of its own.
+        return parallel_for_each(std::move(mutations), [this, smp_grp, src_addr, t, reply_to, shard, &trace_info] (batched_mutation& bm) {
+            return handle_mutation(smp_grp, src_addr, t, std::move(bm.fm), {}, reply_to, shard, bm.response_id,
+                    trace_info, bm.rate_limit_info).discard_result();
+        }).then([] {
+            return netw::messaging_service::no_wait();
+        });
+    }
+
+    static const frozen_mutation& get_frozen_mutation(const frozen_mutation& m) {
+        return m;
+    }
+    static const frozen_mutation& get_frozen_mutation(const lw_shared_ptr<const frozen_mutation>& m) {
+        return *m;
+    }
+
+    // The mutation comes either on its own, or as a pointer, from a MUTATION_BATCH message.
+    template <typename FrozenMutation>
+    future<rpc::no_wait_type> handle_mutation(
+            smp_service_group smp_grp, netw::messaging_service::msg_addr src_addr, rpc::opt_time_point t,
+            FrozenMutation in, inet_address_vector_replica_set forward, gms::inet_address reply_to,
+            unsigned shard, storage_proxy::response_id_type response_id,
+            std::optional<tracing::trace_info> trace_info, db::per_partition_rate_limit::info rate_limit_info) {
+        auto schema_version = get_frozen_mutation(in).schema_version();
+        return handle_write(std::move(src_addr), t, schema_version, std::move(in), std::move(forward), reply_to, shard, response_id,
+                std::move(trace_info),
+                /* apply_fn */ [smp_grp, rate_limit_info] (shared_ptr<storage_proxy>& p, tracing::trace_state_ptr tr_state, schema_ptr s, const FrozenMutation& m,
                         clock_type::time_point timeout) {
-                    return p->mutate_locally(std::move(s), m, std::move(tr_state), db::commitlog::force_sync::no, timeout, smp_grp, rate_limit_info);
+                    return p->mutate_locally(std::move(s), get_frozen_mutation(m), std::move(tr_state), db::commitlog::force_sync::no, timeout, smp_grp, rate_limit_info);
                 },
-                /* forward_fn */ [this, rate_limit_info] (shared_ptr<storage_proxy>& p, netw::messaging_service::msg_addr addr, clock_type::time_point timeout, const frozen_mutation& m,
+                /* forward_fn */ [this, rate_limit_info] (shared_ptr<storage_proxy>& p, netw::messaging_service::msg_addr addr, clock_type::time_point timeout, const FrozenMutation& m,
                         gms::inet_address reply_to, unsigned shard, response_id_type response_id,
                         std::optional<tracing::trace_info> trace_info) {
-                    return send_mutation(addr, timeout, std::move(trace_info), m, {}, reply_to, shard, response_id, rate_limit_info);
+                    return send_mutation(addr, timeout, std::move(trace_info), get_frozen_mutation(m), {}, reply_to, shard, response_id, rate_limit_info);
                 });
     }
 
@@ -649,6 +710,42 @@ class storage_proxy::remote {
         });
     }
 
+    future<rpc::tuple<partition_block_digests, cache_temperature, replica::exception_variant>>
+    handle_read_block_digests(
+            const rpc::client_info& cinfo, rpc::opt_time_point t,
+            query::read_command cmd, ::compat::wrapping_partition_range pr, uint32_t block_rows) {
+        tracing::trace_state_ptr trace_state_ptr;
+        auto src_addr = netw::messaging_service::get_source(cinfo);
+        if (cmd.trace_info) {
+            trace_state_ptr = tracing::tracing::get_local_tracing_instance().create_session(*cmd.trace_info);
+            tracing::begin(trace_state_ptr);
+            tracing::trace(trace_state_ptr, "read_block_digests: message received from /{}", src_addr.addr);
+        }
+        if (!cmd.max_result_size) {
+            cmd.max_result_size.emplace(cinfo.retrieve_auxiliary<uint64_t>("max_result_size"));
+        }
+        return do_with(std::move(pr),
+                       _sp.shared_from_this(),
+                       std::move(trace_state_ptr),
+                       ::compat::one_or_two_partition_ranges({}),
+                       [this, cmd = make_lw_shared<query::read_command>(std::move(cmd)), src_addr = std::move(src_addr), block_rows, t] (
+                               ::compat::wrapping_partition_range& pr,
+                               shared_ptr<storage_proxy>& p,
+                               tracing::trace_state_ptr& trace_state_ptr,
+                               ::compat::one_or_two_partition_ranges& unwrapped) mutable {
+            p->get_stats().replica_block_digest_reads++;
+            auto src_ip = src_addr.addr;
+            return get_schema_for_read(cmd->schema_version, std::move(src_addr)).then([cmd, &pr, &p, &trace_state_ptr, &unwrapped, block_rows, t] (schema_ptr s) mutable {
+                unwrapped = ::compat::unwrap(std::move(pr), *s);
+                auto timeout = t ? *t : db::no_timeout;
+                return p->query_block_digests_locally(std::move(s), std::move(cmd), unwrapped, block_rows, timeout, trace_state_ptr);
+            }).then_wrapped([&p, &trace_state_ptr, src_ip] (future<rpc::tuple<partition_block_digests, cache_temperature>> f) mutable {
+                tracing::trace(trace_state_ptr, "read_block_digests handling is done, sending a response to /{}", src_ip);
+                return encode_replica_exception_for_rpc(p->features(), std::move(f), [] { return std::make_tuple(partition_block_digests(), cache_temperature::invalid()); });
+            });
+        });
+    }
+
     future<rpc::tuple<query::result_digest, long, cache_temperature, replica::exception_variant, std::optional<full_position>>>
     handle_read_digest(
             const rpc::client_info& cinfo, rpc::opt_time_point t,
@@ -814,10 +911,12 @@ class storage_proxy::remote {
     }
 
     void connection_dropped(gms::inet_address addr) {
-        slogger.debug("Drop hit rate info for {} because of disconnect", addr);
+        slogger.debug("Drop hit rate and read latency info for {} because of disconnect", addr);
         for (auto&& cf : _sp._db.local().get_non_system_column_families()) {
             cf->drop_hit_rate(addr);
+            cf->drop_replica_read_latency(addr);
         }
+        _sp.replica_load().drop(addr);
     }
 };
 
@@ -910,6 +1009,11 @@ class mutation_holder {
     virtual future<> apply_remotely(storage_proxy& sp, gms::inet_address ep, inet_address_vector_replica_set&& forward,
             storage_proxy::response_id_type response_id, storage_proxy::clock_type::time_point timeout,
             tracing::trace_state_ptr tr_state, db::per_partition_rate_limit::info rate_limit_info) = 0;
+    // The mutation to send to the replica in a MUTATION_BATCH message, if it
+    // can be sent there instead of by apply_remotely().
+    virtual lw_shared_ptr<const frozen_mutation> get_mutation_for_batch(gms::inet_address ep) {
+        return nullptr;
+    }
     virtual bool is_shared() = 0;
     size_t size() const {
         return _size;
@@ -971,6 +1075,11 @@ class per_destination_mutation : public mutation_holder {
         sp.got_response(response_id, ep, std::nullopt);
         return make_ready_future<>();
     }
+    virtual lw_shared_ptr<const frozen_mutation> get_mutation_for_batch(gms::inet_address ep) override {
+        // Without a mutation, apply_remotely() just responds on behalf of the replica.
+        auto it = _mutations.find(ep);
+        return it != _mutations.end() ? it->second : nullptr;
+    }
     virtual bool is_shared() override {
         return false;
     }
@@ -1014,6 +1123,9 @@ class shared_mutation : public mutation_holder {
                 *_mutation, std::move(forward), utils::fb_utilities::get_broadcast_address(), this_shard_id(),
                 response_id, rate_limit_info);
     }
+    virtual lw_shared_ptr<const frozen_mutation> get_mutation_for_batch(gms::inet_address ep) override {
+        return _mutation;
+    }
     virtual bool is_shared() override {
         return true;
     }
@@ -1042,6 +1154,10 @@ class hint_mutation : public shared_mutation {
                 netw::messaging_service::msg_addr{ep, 0}, timeout, tr_state,
                 *_mutation, std::move(forward), utils::fb_utilities::get_broadcast_address(), this_shard_id(), response_id, rate_limit_info);
     }
+    virtual lw_shared_ptr<const frozen_mutation> get_mutation_for_batch(gms::inet_address ep) override {
+        // Hints are sent in HINT_MUTATION messages only.
+        return nullptr;
+    }
 };
 
 class cas_mutation : public mutation_holder {
@@ -1296,7 +1412,20 @@ class abstract_write_response_handler : public seastar::enable_shared_from_this<
         on_timeout();
         _proxy->remove_response_handler(_id);
     }
+    // Only the writes to tables with views add to the view update backlog of
+    // the replicas, so the writes to other tables aren't delayed by it.
+    bool generates_view_updates() const {
+        const auto& s = get_schema();
+        if (!s) {
+            return true;
+        }
+        const auto& db = _proxy->get_db().local();
+        return !db.column_family_exists(s->id()) || !db.find_column_family(s->id()).views().empty();
+    }
     db::view::update_backlog max_backlog() {
+        if (!generates_view_updates()) {
+            return db::view::update_backlog::no_backlog();
+        }
         return boost::accumulate(
                 get_targets() | boost::adaptors::transformed([this] (gms::inet_address ep) {
                     return _proxy->get_backlog_of(ep);
@@ -1363,6 +1492,12 @@ class abstract_write_response_handler : public seastar::enable_shared_from_this<
             tracing::trace_state_ptr tr_state) {
         return _mutation_holder->apply_remotely(*_proxy, ep, std::move(forward), response_id, timeout, std::move(tr_state), _rate_limit_info);
     }
+    lw_shared_ptr<const frozen_mutation> get_mutation_for_batch(gms::inet_address ep) {
+        return _mutation_holder->get_mutation_for_batch(ep);
+    }
+    const db::per_partition_rate_limit::info& rate_limit_info() const {
+        return _rate_limit_info;
+    }
     const schema_ptr& get_schema() const {
         return _mutation_holder->schema();
     }
@@ -2275,6 +2410,14 @@ void storage_proxy_stats::write_stats::register_stats() {
                                       sm::description("number of throttled write requests"),
                                       {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
 
+            sm::make_total_operations("mutation_batches", mutation_batches,
+                                      sm::description("number of MUTATION_BATCH messages sent to replicas"),
+                                      {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
+
+            sm::make_total_operations("batched_mutations", batched_mutations,
+                                      sm::description("number of mutations sent to replicas in MUTATION_BATCH messages"),
+                                      {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
+
             sm::make_total_operations("write_timeouts", [this]{return write_timeouts.count();},
                            sm::description("number of write request failed due to a timeout"),
                            {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
@@ -2303,6 +2446,26 @@ void storage_proxy_stats::write_stats::register_stats() {
                     sm::description("number of CQL read requests which arrived to a non-replica and had to be forwarded to a replica"),
                     {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
 
+            sm::make_total_operations("reads_balanced_by_load", reads_balanced_by_load,
+                    sm::description("number of read requests which were sent to another replica than the one chosen by cache hit rates, because it was less loaded"),
+                    {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
+
+            sm::make_total_operations("coalesced_reads", coalesced_reads,
+                    sm::description("number of single-partition read requests which were served by an identical read request in flight"),
+                    {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
+
+            sm::make_total_operations("coalesced_counter_updates", coalesced_counter_updates,
+                    sm::description("number of counter updates which were merged into a pending counter update to the same partition and sent to its leader with it"),
+                    {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
+
+            sm::make_total_operations("range_scans_resumed", range_scans_resumed,
+                    sm::description("number of pages of range scans which resumed the read concurrency which the previous page ended with"),
+                    {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
+
+            sm::make_total_operations("partition_reads_skipped", partition_reads_skipped,
+                    sm::description("number of partitions of multi-partition read requests which weren't read, because the partitions before them already held the rows the request was limited to"),
+                    {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
+
             sm::make_total_operations("writes_failed_due_to_too_many_in_flight_hints", writes_failed_due_to_too_many_in_flight_hints,
                     sm::description("number of CQL write requests which failed because the hinted handoff mechanism is overloaded "
                     "and cannot store any more in-flight hints"),
@@ -2368,6 +2531,18 @@ void storage_proxy_stats::stats::register_stats() {
                        sm::description("number of background read repairs"),
                        {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
 
+        sm::make_total_operations("row_level_read_repairs", read_repair_row_level,
+                       sm::description("number of read repairs which fetched only the blocks of rows which differ between the replicas"),
+                       {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
+
+        sm::make_total_operations("row_level_read_repair_fallbacks", read_repair_row_level_fallbacks,
+                       sm::description("number of read repairs which compared the blocks of rows of the replicas, but fetched all rows"),
+                       {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
+
+        sm::make_total_operations("row_level_read_repair_bytes_saved", read_repair_row_level_bytes_saved,
+                       sm::description("estimated number of bytes of rows which row-level read repairs didn't fetch from the replicas"),
+                       {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
+
         sm::make_total_operations("read_timeouts", [this]{return read_timeouts.count(); },
                        sm::description("number of read request failed due to a timeout"),
                        {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
@@ -2400,6 +2575,10 @@ void storage_proxy_stats::stats::register_stats() {
                        sm::description("number of speculative data read requests that were sent"),
                        {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
 
+        sm::make_total_operations("speculative_reads_throttled", speculative_reads_throttled,
+                       sm::description("number of speculative read requests that were not sent because of speculative_retry_max_ratio"),
+                       {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
+
         sm::make_summary("cas_read_latency_summary", sm::description("CAS read latency summary"), [this] {return to_metrics_summary(cas_read.summary());})(storage_proxy_stats::current_scheduling_group_label()).set_skip_when_empty(),
         sm::make_summary("cas_write_latency_summary", sm::description("CAS write latency summary"), [this] {return to_metrics_summary(cas_write.summary());})(storage_proxy_stats::current_scheduling_group_label()).set_skip_when_empty(),
 
@@ -2460,6 +2639,10 @@ void storage_proxy_stats::stats::register_stats() {
                        sm::description("how many times paxos prune was done after successful cas operation"),
                        {storage_proxy_stats::current_scheduling_group_label()}),
 
+        sm::make_total_operations("cas_background_learns", cas_background_learns,
+                       sm::description("how many paxos decisions with consistency level ANY were learned after the cas operation returned"),
+                       {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
+
         sm::make_total_operations("cas_dropped_prune", cas_coordinator_dropped_prune,
                        sm::description("how many times a coordinator did not perfom prune after cas"),
                        {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
@@ -2506,6 +2689,10 @@ void storage_proxy_stats::stats::register_stats() {
                        sm::description("number of remote digest read requests this Node received"),
                        {storage_proxy_stats::current_scheduling_group_label(), storage_proxy_stats::op_type_label("digest")}).set_skip_when_empty(),
 
+        sm::make_total_operations("reads", replica_block_digest_reads,
+                       sm::description("number of remote block digest read requests this Node received"),
+                       {storage_proxy_stats::current_scheduling_group_label(), storage_proxy_stats::op_type_label("block_digest")}).set_skip_when_empty(),
+
         sm::make_total_operations("cross_shard_ops", replica_cross_shard_ops,
                        sm::description("number of operations that crossed a shard boundary"),
                        {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
@@ -2513,6 +2700,14 @@ void storage_proxy_stats::stats::register_stats() {
         sm::make_total_operations("cas_dropped_prune", cas_replica_dropped_prune,
                        sm::description("how many times a coordinator did not perfom prune after cas"),
                        {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
+
+        sm::make_total_operations("cas_state_cache_hits", cas_replica_state_cache_hits,
+                       sm::description("how many paxos prepare and accept rounds found the paxos state of their key in the cache"),
+                       {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
+
+        sm::make_total_operations("cas_state_cache_misses", cas_replica_state_cache_misses,
+                       sm::description("how many paxos prepare and accept rounds had to read the paxos state of their key from system.paxos"),
+                       {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
     });
 }
 
@@ -2585,6 +2780,32 @@ inline std::ostream& operator<<(std::ostream& os, const hint_wrapper& h) {
 
 using namespace std::literals::chrono_literals;
 
+struct storage_proxy::coalesced_read {
+    lw_shared_ptr<query::read_command> cmd;
+    dht::partition_range range;
+    db::consistency_level cl;
+    unsigned timeout_class;
+    unsigned joined = 0;
+    shared_promise<> done;
+    // The outcome of the read, set before done is.
+    lw_shared_ptr<query::result> result;
+    replicas_per_token_range last_replicas;
+    db::read_repair_decision read_repair_decision = db::read_repair_decision::NONE;
+    exceptions::coordinator_exception_container error;
+    std::exception_ptr exception;
+
+    coalesced_read(lw_shared_ptr<query::read_command> cmd, dht::partition_range range, db::consistency_level cl, unsigned timeout_class)
+        : cmd(std::move(cmd)), range(std::move(range)), cl(cl), timeout_class(timeout_class)
+    { }
+};
+
+struct storage_proxy::coalesced_counter_update {
+    mutation m;
+    db::consistency_level cl;
+    clock_type::time_point timeout;
+    shared_promise<> done;
+};
+
 storage_proxy::~storage_proxy() {}
 storage_proxy::storage_proxy(distributed<replica::database>& db, gms::gossiper& gossiper, storage_proxy::config cfg, db::view::node_update_backlog& max_view_update_backlog,
         scheduling_group_key stats_key, gms::feature_service& feat, const locator::shared_token_metadata& stm, locator::effective_replication_map_factory& erm_factory, netw::messaging_service& ms)
@@ -2903,9 +3124,78 @@ future<result<storage_proxy::unique_response_handler_vector>> storage_proxy::mut
     });
 }
 
+// Collects the mutations which the write handlers started together by
+// mutate_begin() send to the same replica, without forwarding, so that the
+// replica receives them in a single MUTATION_BATCH message rather than in a
+// MUTATION message each. The replica still handles and responds to each of
+// them on its own, so the handlers count the responses exactly as they do
+// without batching.
+class storage_proxy::mutation_batcher {
+    struct batch {
+        std::vector<batched_mutation> mutations;
+        // Resolved once the batch is sent, like the future of apply_remotely().
+        lw_shared_ptr<shared_promise<>> sent = make_lw_shared<shared_promise<>>();
+    };
+
+    storage_proxy& _sp;
+    tracing::trace_state_ptr _trace_state;
+    // Batches by replica and by timeout, so that no mutation is sent with
+    // the timeout of another write.
+    std::unordered_map<gms::inet_address, std::map<clock_type::time_point, batch>> _batches;
+public:
+    mutation_batcher(storage_proxy& sp, tracing::trace_state_ptr trace_state)
+        : _sp(sp)
+        , _trace_state(std::move(trace_state))
+    { }
+
+    // The mutation is shared with the write handler, not copied, until the batch is sent.
+    future<> add(gms::inet_address ep, lw_shared_ptr<const frozen_mutation> fm, response_id_type response_id,
+            const db::per_partition_rate_limit::info& rate_limit_info, clock_type::time_point timeout) {
+        auto& b = _batches[ep][timeout];
+        b.mutations.push_back(batched_mutation{std::move(fm), response_id, rate_limit_info});
+        return b.sent->get_shared_future();
+    }
+
+    void send() {
+        auto my_address = utils::fb_utilities::get_broadcast_address();
+        for (auto& [ep, batches] : _batches) {
+            for (auto& [timeout, b] : batches) {
+                future<> f = make_ready_future<>();
+                if (b.mutations.size() == 1) {
+                    auto& m = b.mutations.front();
+                    tracing::trace(_trace_state, "Sending a mutation to /{}", ep);
+                    f = _sp.remote().send_mutation(netw::messaging_service::msg_addr{ep, 0}, timeout, tracing::make_trace_info(_trace_state),
+                            *m.fm, {}, my_address, this_shard_id(), m.response_id, m.rate_limit_info);
+                } else {
+                    tracing::trace(_trace_state, "Sending a batch of {} mutations to /{}", b.mutations.size(), ep);
+                    ++_sp.get_stats().mutation_batches;
+                    _sp.get_stats().batched_mutations += b.mutations.size();
+                    f = _sp.remote().send_mutation_batch(netw::messaging_service::msg_addr{ep, 0}, timeout, tracing::make_trace_info(_trace_state),
+                            std::move(b.mutations), my_address, this_shard_id());
+                }
+                // Waited on indirectly, by the futures returned by add().
+                (void)f.then_wrapped([sent = b.sent] (future<> f) {
+                    if (f.failed()) {
+                        sent->set_exception(f.get_exception());
+                    } else {
+                        sent->set_value();
+                    }
+                });
+            }
+        }
+        _batches.clear();
+    }
+};
+
 future<result<>> storage_proxy::mutate_begin(unique_response_handler_vector ids, db::consistency_level cl,
                                      tracing::trace_state_ptr trace_state, std::optional<clock_type::time_point> timeout_opt) {
-    return utils::result_parallel_for_each<result<>>(ids, [this, cl, timeout_opt] (unique_response_handler& protected_response) {
+    std::optional<mutation_batcher> batcher;
+    if (ids.size() > 1 && _features.mutation_batch_verb && _db.local().get_config().batch_replica_writes()) {
+        batcher.emplace(*this, trace_state);
+    }
+    // All handlers are started before the batches are sent, as
+    // result_parallel_for_each() invokes the function for every element right away.
+    auto f = utils::result_parallel_for_each<result<>>(ids, [this, cl, timeout_opt, batcher = batcher ? &*batcher : nullptr] (unique_response_handler& protected_response) {
         auto response_id = protected_response.id;
         // This function, mutate_begin(), is called after a preemption point
         // so it's possible that other code besides our caller just ran. In
@@ -2933,9 +3223,13 @@ future<result<>> storage_proxy::mutate_begin(unique_response_handler_vector ids,
         auto timeout = timeout_opt.value_or(clock_type::now() + std::chrono::milliseconds(_db.local().get_config().write_request_timeout_in_ms()));
         // call before send_to_live_endpoints() for the same reason as above
         auto f = response_wait(response_id, timeout);
-        send_to_live_endpoints(protected_response.release(), timeout); // response is now running and it will either complete or timeout
+        send_to_live_endpoints(protected_response.release(), timeout, batcher); // response is now running and it will either complete or timeout
         return f;
     });
+    if (batcher) {
+        batcher->send();
+    }
+    return f;
 }
 
 // this function should be called with a future that holds result of mutation attempt (usually
@@ -3016,6 +3310,56 @@ gms::inet_address storage_proxy::find_leader_for_counter_update(const mutation&
 
 template<typename Range>
 future<> storage_proxy::mutate_counters(Range&& mutations, db::consistency_level cl, tracing::trace_state_ptr tr_state, service_permit permit, clock_type::time_point timeout) {
+    const auto window = std::chrono::microseconds(_db.local().get_config().coordinator_counter_update_coalescing_window_in_us());
+    if (window.count() && boost::size(mutations) == 1) {
+        return mutate_counter_coalesced(*boost::begin(mutations), cl, std::move(tr_state), std::move(permit), timeout, window);
+    }
+    return do_mutate_counters(std::forward<Range>(mutations), cl, std::move(tr_state), std::move(permit), timeout);
+}
+
+future<> storage_proxy::mutate_counter_coalesced(const mutation& m, db::consistency_level cl, tracing::trace_state_ptr tr_state, service_permit permit,
+        clock_type::time_point timeout, std::chrono::microseconds window) {
+    // keeps sp alive for the co-routine lifetime
+    auto p = shared_from_this();
+
+    // Merging counter updates sums their deltas, so an update can be sent
+    // along with a pending one, unless it has to complete sooner. m is
+    // not used past the first suspension, the caller doesn't keep it.
+    const auto token = m.token();
+    auto [begin, end] = _coalesced_counter_updates.equal_range(token);
+    auto it = std::find_if(begin, end, [&] (const auto& entry) {
+        const coalesced_counter_update& u = *entry.second;
+        return u.cl == cl && u.timeout <= timeout && u.m.schema() == m.schema() && u.m.decorated_key().equal(*m.schema(), m.decorated_key());
+    });
+    if (it != end) {
+        auto update = it->second;
+        update->m.apply(m);
+        ++get_stats().coalesced_counter_updates;
+        tracing::trace(tr_state, "Coalescing counter update with a pending one");
+        co_return co_await update->done.get_shared_future();
+    }
+
+    auto update = make_lw_shared<coalesced_counter_update>(coalesced_counter_update{m, cl, timeout});
+    _coalesced_counter_updates.emplace(token, update);
+    tracing::trace(tr_state, "Waiting {} for counter updates to coalesce with", window);
+    co_await sleep(window);
+
+    std::tie(begin, end) = _coalesced_counter_updates.equal_range(token);
+    _coalesced_counter_updates.erase(std::find_if(begin, end, [&] (const auto& entry) { return entry.second == update; }));
+
+    std::vector<mutation> mutations;
+    mutations.push_back(std::move(update->m));
+    auto f = co_await coroutine::as_future(do_mutate_counters(mutations, cl, std::move(tr_state), std::move(permit), timeout));
+    if (f.failed()) {
+        auto ex = f.get_exception();
+        update->done.set_exception(ex);
+        co_await coroutine::return_exception_ptr(std::move(ex));
+    }
+    update->done.set_value();
+}
+
+template<typename Range>
+future<> storage_proxy::do_mutate_counters(Range&& mutations, db::consistency_level cl, tracing::trace_state_ptr tr_state, service_permit permit, clock_type::time_point timeout) {
     if (boost::empty(mutations)) {
         co_return;
     }
@@ -3606,7 +3950,7 @@ future<> storage_proxy::send_hint_to_all_replicas(frozen_mutation_and_schema fm_
  * @throws OverloadedException if the hints cannot be written/enqueued
  */
  // returned future is ready when sent is complete, not when mutation is executed on all (or any) targets!
-void storage_proxy::send_to_live_endpoints(storage_proxy::response_id_type response_id, clock_type::time_point timeout)
+void storage_proxy::send_to_live_endpoints(storage_proxy::response_id_type response_id, clock_type::time_point timeout, mutation_batcher* batcher)
 {
     // extra-datacenter replicas, grouped by dc
     std::unordered_map<sstring, inet_address_vector_replica_set> dc_groups;
@@ -3644,12 +3988,18 @@ void storage_proxy::send_to_live_endpoints(storage_proxy::response_id_type respo
     };
 
     // lambda for applying mutation remotely
-    auto rmutate = [this, handler_ptr, timeout, response_id, my_address, &global_stats] (gms::inet_address coordinator, inet_address_vector_replica_set&& forward) {
+    auto rmutate = [this, handler_ptr, timeout, response_id, my_address, &global_stats, batcher] (gms::inet_address coordinator, inet_address_vector_replica_set&& forward) {
         auto msize = handler_ptr->get_mutation_size(); // can overestimate for repair writes
         global_stats.queued_write_bytes += msize;
 
-        return handler_ptr->apply_remotely(coordinator, std::move(forward), response_id, timeout, handler_ptr->get_trace_state())
-                .finally([this, p = shared_from_this(), h = std::move(handler_ptr), msize, &global_stats] {
+        future<> f = make_ready_future<>();
+        lw_shared_ptr<const frozen_mutation> fm;
+        if (batcher && forward.empty() && (fm = handler_ptr->get_mutation_for_batch(coordinator))) {
+            f = batcher->add(coordinator, std::move(fm), response_id, handler_ptr->rate_limit_info(), timeout);
+        } else {
+            f = handler_ptr->apply_remotely(coordinator, std::move(forward), response_id, timeout, handler_ptr->get_trace_state());
+        }
+        return f.finally([this, p = shared_from_this(), h = std::move(handler_ptr), msize, &global_stats] {
             global_stats.queued_write_bytes -= msize;
             unthrottle();
         });
@@ -4030,6 +4380,10 @@ class data_read_resolver : public abstract_read_resolver {
     query::short_read _is_short_read;
     std::vector<reply> _data_results;
     std::unordered_map<dht::token, std::unordered_map<gms::inet_address, std::optional<mutation>>> _diffs;
+    // Row-level read repair: only the replica `_full_from` returned the
+    // whole result, the others only the rows of `_narrowed_ranges`.
+    std::optional<gms::inet_address> _full_from;
+    query::clustering_row_ranges _narrowed_ranges;
 private:
     void on_timeout() override {
         fail_request(read_timeout_exception(_schema->ks_name(), _schema->cf_name(), _cl, response_count(), _targets_count, response_count() != 0));
@@ -4278,6 +4632,12 @@ class data_read_resolver : public abstract_read_resolver {
     uint32_t live_partition_count() const {
         return _live_partition_count;
     }
+    // Tells that only `full_from` is queried for the whole result and the
+    // other replicas only for the rows of `ranges`.
+    void narrow_repair(gms::inet_address full_from, query::clustering_row_ranges ranges) {
+        _full_from = full_from;
+        _narrowed_ranges = std::move(ranges);
+    }
     bool all_reached_end() const {
         return _all_reached_end;
     }
@@ -4382,6 +4742,10 @@ class data_read_resolver : public abstract_read_resolver {
                 auto diff = v.par
                           ? m.partition().difference(schema, (co_await v.par->mut().unfreeze_gently(schema)).partition())
                           : mutation_partition(*schema, m.partition());
+                if (_full_from && v.from != *_full_from) {
+                    // The replica has the rows outside of the narrowed ranges.
+                    diff = mutation_partition(std::move(diff), *schema, query::clustering_key_filter_ranges(_narrowed_ranges));
+                }
                 std::optional<mutation> mdiff;
                 if (!diff.empty()) {
                     has_diff = true;
@@ -4474,6 +4838,9 @@ class abstract_read_executor : public enable_shared_from_this<abstract_read_exec
     bool _foreground = true;
     service_permit _permit; // holds admission permit until operation completes
     db::per_partition_rate_limit::info _rate_limit_info;
+    // The size of the data result of the read, which tells whether it is
+    // worth to repair it row by row on digest mismatch.
+    size_t _data_result_size = 0;
 
 private:
     void on_read_resolved() noexcept {
@@ -4544,6 +4911,15 @@ class abstract_read_executor : public enable_shared_from_this<abstract_read_exec
             return _proxy->remote().send_read_digest(netw::messaging_service::msg_addr{ep, 0}, timeout, _trace_state, *_cmd, _partition_range, digest_algorithm(*_proxy), _rate_limit_info);
         }
     }
+    future<rpc::tuple<partition_block_digests, cache_temperature>> make_block_digest_request(gms::inet_address ep, clock_type::time_point timeout) {
+        if (fbu::is_me(ep)) {
+            tracing::trace(_trace_state, "read_block_digests: querying locally");
+            return _proxy->query_block_digests_locally(_schema, _cmd, _partition_range, read_repair_block_rows, timeout, _trace_state);
+        } else {
+            return _proxy->remote().send_read_block_digests(netw::messaging_service::msg_addr{ep, 0}, timeout, _trace_state, *_cmd, _partition_range,
+                    read_repair_block_rows);
+        }
+    }
     void make_mutation_data_requests(lw_shared_ptr<query::read_command> cmd, data_resolver_ptr resolver, targets_iterator begin, targets_iterator end, clock_type::time_point timeout) {
         auto start = latency_clock::now();
         for (const gms::inet_address& ep : boost::make_iterator_range(begin, end)) {
@@ -4574,7 +4950,8 @@ class abstract_read_executor : public enable_shared_from_this<abstract_read_exec
         auto start = latency_clock::now();
         for (const gms::inet_address& ep : boost::make_iterator_range(begin, end)) {
             // Waited on indirectly, shared_from_this keeps `this` alive
-            (void)make_data_request(ep, timeout, want_digest).then_wrapped([this, resolver, ep, start, exec = shared_from_this()] (future<rpc::tuple<foreign_ptr<lw_shared_ptr<query::result>>, cache_temperature>> f) {
+            const bool tracked = track_replica_load(ep);
+            (void)make_data_request(ep, timeout, want_digest).then_wrapped([this, resolver, ep, start, tracked, exec = shared_from_this()] (future<rpc::tuple<foreign_ptr<lw_shared_ptr<query::result>>, cache_temperature>> f) {
                 std::exception_ptr ex;
                 try {
                   if (!f.failed()) {
@@ -4583,7 +4960,7 @@ class abstract_read_executor : public enable_shared_from_this<abstract_read_exec
                     resolver->add_data(ep, std::get<0>(std::move(v)));
                     ++_proxy->get_stats().data_read_completed.get_ep_stat(get_topology(), ep);
                     _used_targets.push_back(ep);
-                    register_request_latency(latency_clock::now() - start);
+                    register_request_latency(ep, latency_clock::now() - start, tracked);
                     return;
                   } else {
                     ex = f.get_exception();
@@ -4593,6 +4970,9 @@ class abstract_read_executor : public enable_shared_from_this<abstract_read_exec
                 }
 
                 ++_proxy->get_stats().data_read_errors.get_ep_stat(get_topology(), ep);
+                if (tracked) {
+                    _proxy->replica_load().on_completion(ep, std::nullopt);
+                }
                 resolver->error(ep, std::move(ex));
             });
         }
@@ -4601,7 +4981,8 @@ class abstract_read_executor : public enable_shared_from_this<abstract_read_exec
         auto start = latency_clock::now();
         for (const gms::inet_address& ep : boost::make_iterator_range(begin, end)) {
             // Waited on indirectly, shared_from_this keeps `this` alive
-            (void)make_digest_request(ep, timeout).then_wrapped([this, resolver, ep, start, exec = shared_from_this()] (future<rpc::tuple<query::result_digest, api::timestamp_type, cache_temperature, std::optional<full_position>>> f) {
+            const bool tracked = track_replica_load(ep);
+            (void)make_digest_request(ep, timeout).then_wrapped([this, resolver, ep, start, tracked, exec = shared_from_this()] (future<rpc::tuple<query::result_digest, api::timestamp_type, cache_temperature, std::optional<full_position>>> f) {
                 std::exception_ptr ex;
                 try {
                   if (!f.failed()) {
@@ -4610,7 +4991,7 @@ class abstract_read_executor : public enable_shared_from_this<abstract_read_exec
                     resolver->add_digest(ep, std::get<0>(v), std::get<1>(v), std::get<3>(std::move(v)));
                     ++_proxy->get_stats().digest_read_completed.get_ep_stat(get_topology(), ep);
                     _used_targets.push_back(ep);
-                    register_request_latency(latency_clock::now() - start);
+                    register_request_latency(ep, latency_clock::now() - start, tracked);
                     return;
                   } else {
                     ex = f.get_exception();
@@ -4620,6 +5001,9 @@ class abstract_read_executor : public enable_shared_from_this<abstract_read_exec
                 }
 
                 ++_proxy->get_stats().digest_read_errors.get_ep_stat(get_topology(), ep);
+                if (tracked) {
+                    _proxy->replica_load().on_completion(ep, std::nullopt);
+                }
                 resolver->error(ep, std::move(ex));
             });
         }
@@ -4641,13 +5025,24 @@ class abstract_read_executor : public enable_shared_from_this<abstract_read_exec
         return _cmd->partition_limit;
     }
     virtual void adjust_targets_for_reconciliation() {}
-    void reconcile(db::consistency_level cl, storage_proxy::clock_type::time_point timeout, lw_shared_ptr<query::read_command> cmd) {
+    // When `narrowed_cmd` is given, only the first target is queried with
+    // `cmd`, and the others with `narrowed_cmd`, which reads only the rows
+    // the results of the targets may differ in.
+    void reconcile(db::consistency_level cl, storage_proxy::clock_type::time_point timeout, lw_shared_ptr<query::read_command> cmd,
+            lw_shared_ptr<query::read_command> narrowed_cmd = {}) {
         adjust_targets_for_reconciliation();
         data_resolver_ptr data_resolver = ::make_shared<data_read_resolver>(_schema, cl, _targets.size(), timeout);
         auto exec = shared_from_this();
 
         // Waited on indirectly.
-        make_mutation_data_requests(cmd, data_resolver, _targets.begin(), _targets.end(), timeout);
+        if (narrowed_cmd) {
+            const auto& key = *_partition_range.start()->value().key();
+            data_resolver->narrow_repair(_targets.front(), narrowed_cmd->slice.row_ranges(*_schema, key));
+            make_mutation_data_requests(cmd, data_resolver, _targets.begin(), _targets.begin() + 1, timeout);
+            make_mutation_data_requests(narrowed_cmd, data_resolver, _targets.begin() + 1, _targets.end(), timeout);
+        } else {
+            make_mutation_data_requests(cmd, data_resolver, _targets.begin(), _targets.end(), timeout);
+        }
 
         // Waited on indirectly.
         (void)data_resolver->done().then_wrapped([this, exec_ = std::move(exec), data_resolver_ = std::move(data_resolver), cmd_ = std::move(cmd), cl_ = cl, timeout_ = timeout] (future<result<>> f) mutable -> future<> {
@@ -4750,6 +5145,79 @@ class abstract_read_executor : public enable_shared_from_this<abstract_read_exec
         reconcile(cl, timeout, _cmd);
     }
 
+    bool can_repair_rows() const {
+        const auto threshold = _proxy->_db.local().get_config().row_level_read_repair_threshold_in_kb();
+        return threshold && _data_result_size >= uint64_t(threshold) * 1024
+                && _proxy->features().row_level_read_repair
+                && _partition_range.is_singular() && _partition_range.start()->value().has_key()
+                && !_cmd->slice.is_reversed() && !_cmd->slice.get_row_filter();
+    }
+
+    // Reconciles the results of the targets after a digest mismatch.
+    //
+    // Large single-partition results are first compared by the digests of
+    // their blocks of rows (see service/row_level_read_repair.hh), so that
+    // only one target has to send the whole result, and the others only the
+    // rows of the blocks which differ. If the block digests don't help, the
+    // results are reconciled whole.
+    void repair(db::consistency_level cl, storage_proxy::clock_type::time_point timeout) {
+        if (!can_repair_rows()) {
+            reconcile(cl, timeout);
+            return;
+        }
+        adjust_targets_for_reconciliation();
+        if (_targets.size() < 2) {
+            reconcile(cl, timeout);
+            return;
+        }
+
+        // Waited on indirectly.
+        (void)[] (shared_ptr<abstract_read_executor> exec, db::consistency_level cl, storage_proxy::clock_type::time_point timeout) -> future<> {
+            auto& stats = exec->_proxy->get_stats();
+            try {
+                std::vector<future<rpc::tuple<partition_block_digests, cache_temperature>>> requests;
+                requests.reserve(exec->_targets.size());
+                for (const gms::inet_address& ep : exec->_targets) {
+                    requests.push_back(exec->make_block_digest_request(ep, timeout));
+                }
+                auto replies = co_await when_all(requests.begin(), requests.end());
+
+                std::vector<partition_block_digests> digests;
+                digests.reserve(replies.size());
+                for (size_t i = 0; i < replies.size(); ++i) {
+                    if (replies[i].failed()) {
+                        slogger.debug("Failed to read block digests from {}: {}", exec->_targets[i], replies[i].get_exception());
+                        continue;
+                    }
+                    auto&& [d, hit_rate] = replies[i].get0();
+                    exec->_cf->set_hit_rate(exec->_targets[i], hit_rate);
+                    digests.push_back(std::move(d));
+                }
+
+                const auto& key = *exec->_partition_range.start()->value().key();
+                std::optional<differing_ranges> differing;
+                if (digests.size() == exec->_targets.size()) {
+                    differing = find_differing_ranges(*exec->_schema, exec->_cmd->slice.row_ranges(*exec->_schema, key), digests);
+                }
+                if (!differing) {
+                    stats.read_repair_row_level_fallbacks++;
+                    exec->reconcile(cl, timeout);
+                    co_return;
+                }
+
+                auto narrowed_cmd = make_lw_shared<query::read_command>(*exec->_cmd);
+                narrowed_cmd->slice.set_range(*exec->_schema, key, std::move(differing->ranges));
+                stats.read_repair_row_level++;
+                stats.read_repair_row_level_bytes_saved += differing->same_size * (exec->_targets.size() - 1);
+                tracing::trace(exec->_trace_state, "Repairing only the differing rows, sparing {} bytes per replica", differing->same_size);
+                exec->reconcile(cl, timeout, exec->_cmd, std::move(narrowed_cmd));
+            } catch (...) {
+                exec->_result_promise.set_exception(std::current_exception());
+                exec->on_read_resolved();
+            }
+        }(shared_from_this(), cl, timeout);
+    }
+
 public:
     future<result<foreign_ptr<lw_shared_ptr<query::result>>>> execute(storage_proxy::clock_type::time_point timeout) {
         if (_targets.empty()) {
@@ -4775,6 +5243,7 @@ class abstract_read_executor : public enable_shared_from_this<abstract_read_exec
                     return std::move(res).as_failure();
                 }
                 auto&& [result, digests_match] = res.value();
+                exec->_data_result_size = result->buf().size();
 
                 if (digests_match) {
                     if (exec->_proxy->features().empty_replica_pages && digest_resolver->response_count() > 1) {
@@ -4804,7 +5273,7 @@ class abstract_read_executor : public enable_shared_from_this<abstract_read_exec
                             exec->_targets.erase(i, exec->_targets.end());
                         }
                     }
-                    exec->reconcile(exec->_cl, timeout);
+                    exec->repair(exec->_cl, timeout);
                     exec->_proxy->get_stats().read_repair_repaired_blocking++;
                 }
                 return bo::success();
@@ -4819,7 +5288,7 @@ class abstract_read_executor : public enable_shared_from_this<abstract_read_exec
                 if (background_repair_check && !digest_resolver->digests_match()) {
                     exec->_proxy->get_stats().read_repair_repaired_background++;
                     exec->_result_promise = promise<result<foreign_ptr<lw_shared_ptr<query::result>>>>();
-                    exec->reconcile(exec->_cl, timeout);
+                    exec->repair(exec->_cl, timeout);
                     return exec->_result_promise.get_future().then(utils::result_discard_value<result<foreign_ptr<lw_shared_ptr<query::result>>>>);
                 } else {
                     return make_ready_future<result<>>(bo::success());
@@ -4850,6 +5319,24 @@ class abstract_read_executor : public enable_shared_from_this<abstract_read_exec
     void register_request_latency(latency_clock::duration d) {
         _max_request_latency = std::max(_max_request_latency, d);
     }
+    void register_request_latency(gms::inet_address ep, latency_clock::duration d, bool tracked) {
+        register_request_latency(d);
+        if (_proxy->get_db().local().get_config().speculative_retry_per_replica_latency()) {
+            _cf->add_replica_read_latency(ep, d);
+        }
+        if (tracked) {
+            _proxy->replica_load().on_completion(ep, std::chrono::duration_cast<std::chrono::microseconds>(d));
+        }
+    }
+    // Accounts a read request to the load of the replica, if the load is
+    // tracked. Its completion has to be accounted too.
+    bool track_replica_load(gms::inet_address ep) {
+        if (!_proxy->get_db().local().get_config().load_aware_read_balancing()) {
+            return false;
+        }
+        _proxy->replica_load().on_request(ep);
+        return true;
+    }
 
     static constexpr latency_clock::duration NO_LATENCY{-1};
     latency_clock::duration _max_request_latency{NO_LATENCY};
@@ -4887,6 +5374,10 @@ class speculating_read_executor : public abstract_read_executor {
     virtual void make_requests(digest_resolver_ptr resolver, storage_proxy::clock_type::time_point timeout) override {
         _speculate_timer.set_callback([this, resolver, timeout] {
             if (!resolver->is_completed()) { // at the time the callback runs request may be completed already
+                if (!_proxy->consume_speculative_read_credit()) {
+                    _proxy->get_stats().speculative_reads_throttled++;
+                    return;
+                }
                 resolver->add_wait_targets(1); // we send one more request so wait for it too
                 // FIXME: consider disabling for CL=*ONE
                 auto send_request = [&] (bool has_data) {
@@ -4903,8 +5394,9 @@ class speculating_read_executor : public abstract_read_executor {
         });
         auto& sr = _schema->speculative_retry();
         auto t = (sr.get_type() == speculative_retry::type::PERCENTILE) ?
-            std::min(_cf->get_coordinator_read_latency_percentile(sr.get_value()), std::chrono::milliseconds(_proxy->get_db().local().get_config().read_request_timeout_in_ms()/2)) :
+            std::min(get_latency_percentile(sr.get_value()), std::chrono::milliseconds(_proxy->get_db().local().get_config().read_request_timeout_in_ms()/2)) :
             std::chrono::milliseconds(unsigned(sr.get_value()));
+        _proxy->add_speculative_read_credit();
         _speculate_timer.arm(t);
 
         // if CL + RR result in covering all replicas, getReadExecutor forces AlwaysSpeculating.  So we know
@@ -4928,11 +5420,40 @@ class speculating_read_executor : public abstract_read_executor {
     virtual void got_cl() override {
         _speculate_timer.cancel();
     }
+private:
+    // All replicas contacted before speculating have to reply, so it is
+    // pointless to speculate before each of them is slower than usual for
+    // itself: wait for the largest of their percentiles. Replicas without
+    // recent latencies of their own are assumed to be as fast as the table.
+    std::chrono::milliseconds get_latency_percentile(double percentile) {
+        if (!_proxy->get_db().local().get_config().speculative_retry_per_replica_latency()) {
+            return _cf->get_coordinator_read_latency_percentile(percentile);
+        }
+        std::chrono::milliseconds t{0};
+        for (auto& ep : boost::make_iterator_range(_targets.begin(), _targets.end() - 1)) {
+            auto l = _cf->get_replica_read_latency_percentile(ep, percentile);
+            t = std::max(t, l ? *l : _cf->get_coordinator_read_latency_percentile(percentile));
+        }
+        return t;
+    }
     virtual void adjust_targets_for_reconciliation() override {
         _targets = used_targets();
     }
 };
 
+void storage_proxy::add_speculative_read_credit() noexcept {
+    auto ratio = std::clamp(_db.local().get_config().speculative_retry_max_ratio(), 0.0, 1.0);
+    _speculative_read_credit = std::min(_speculative_read_credit + ratio, max_speculative_read_credit);
+}
+
+bool storage_proxy::consume_speculative_read_credit() noexcept {
+    if (_speculative_read_credit < 1) {
+        return false;
+    }
+    _speculative_read_credit -= 1;
+    return true;
+}
+
 db::read_repair_decision storage_proxy::new_read_repair_decision(const schema& s) {
     if (s.dc_local_read_repair_chance() > 0 || s.read_repair_chance() > 0) {
         double chance = _read_repair_chance(_urandom);
@@ -4972,11 +5493,32 @@ result<::shared_ptr<abstract_read_executor>> storage_proxy::get_read_executor(lw
 
     auto cf = _db.local().find_column_family(schema).shared_from_this();
     auto& gossiper = _remote->gossiper();
+    // Reads which may be balanced by load choose between the targets and
+    // the extra replica, even if they won't speculate.
+    const bool balance_by_load = _db.local().get_config().load_aware_read_balancing() && preferred_endpoints.empty()
+            && repair_decision == db::read_repair_decision::NONE
+            && (cl == db::consistency_level::LOCAL_ONE || cl == db::consistency_level::LOCAL_QUORUM);
+    const bool has_extra_replica = retry_type != speculative_retry::type::NONE || balance_by_load;
     inet_address_vector_replica_set target_replicas = db::filter_for_query(cl, *erm, all_replicas, preferred_endpoints, repair_decision,
             gossiper,
-            retry_type == speculative_retry::type::NONE ? nullptr : &extra_replica,
+            has_extra_replica ? &extra_replica : nullptr,
             _db.local().get_config().cache_hit_rate_read_balancing() ? &*cf : nullptr);
 
+    if (balance_by_load && target_replicas.size() == db::block_for(*erm, cl) && target_replicas.size() < all_replicas.size() && !target_replicas.empty()) {
+        // The power of two choices: the extra replica takes the place of the
+        // most loaded target if it's clearly less loaded, and the target is
+        // left for speculation.
+        auto now = replica_load_tracker::clock_type::now();
+        auto most_loaded = std::max_element(target_replicas.begin(), target_replicas.end(), [&] (gms::inet_address a, gms::inet_address b) {
+            return _replica_load.cost(a, now).value_or(0) < _replica_load.cost(b, now).value_or(0);
+        });
+        if (_replica_load.prefer(extra_replica, *most_loaded, now)) {
+            tracing::trace(trace_state, "Reading from {} instead of the more loaded {}", extra_replica, *most_loaded);
+            std::swap(extra_replica, *most_loaded);
+            get_stats().reads_balanced_by_load++;
+        }
+    }
+
     slogger.trace("creating read executor for token {} with all: {} targets: {} rp decision: {}", token, all_replicas, target_replicas, repair_decision);
     tracing::trace(trace_state, "Creating read executor for token {} with all: {} targets: {} repair decision: {}", token, all_replicas, target_replicas, repair_decision);
 
@@ -5107,6 +5649,83 @@ void storage_proxy::handle_read_error(std::variant<exceptions::coordinator_excep
     }));
 }
 
+future<result<storage_proxy::coordinator_query_result>>
+storage_proxy::query_singular_coalesced(schema_ptr s,
+        lw_shared_ptr<query::read_command> cmd,
+        dht::partition_range_vector&& partition_ranges,
+        db::consistency_level cl,
+        storage_proxy::coordinator_query_options query_options) {
+    const auto timeout = query_options.timeout(*this);
+    const auto timeout_class = coalesced_read_timeout_class(timeout - clock_type::now());
+    const size_t hash = coalesced_read_hash(*cmd, partition_ranges.front(), cl, timeout_class);
+
+    // keeps sp alive for the co-routine lifetime
+    auto p = shared_from_this();
+
+    auto [begin, end] = _coalesced_reads.equal_range(hash);
+    auto it = std::find_if(begin, end, [&] (const auto& entry) {
+        const coalesced_read& r = *entry.second;
+        return r.cl == cl && r.timeout_class == timeout_class && are_identical_reads(*s, *r.cmd, r.range, *cmd, partition_ranges.front());
+    });
+    if (it != end) {
+        auto read = it->second;
+        ++read->joined;
+        ++get_stats().coalesced_reads;
+        tracing::trace(query_options.trace_state, "Joining an identical read in flight");
+        auto f = co_await coroutine::as_future(read->done.get_shared_future(timeout));
+        if (f.failed()) {
+            // Timed out before the read it joined completed.
+            f.ignore_ready_future();
+            get_stats().read_timeouts.mark();
+            auto erm = _db.local().find_keyspace(s->ks_name()).get_effective_replication_map();
+            co_return read_timeout_exception(s->ks_name(), s->cf_name(), cl, 0, db::block_for(*erm, cl), false);
+        }
+        if (read->exception) {
+            co_await coroutine::return_exception_ptr(read->exception);
+        }
+        if (read->error) {
+            co_return bo::failure(read->error.clone());
+        }
+        tracing::trace(query_options.trace_state, "Got the result of the identical read");
+        co_return coordinator_query_result(make_foreign(read->result), read->last_replicas, read->read_repair_decision);
+    }
+
+    auto read = make_lw_shared<coalesced_read>(cmd, partition_ranges.front(), cl, timeout_class);
+    _coalesced_reads.emplace(hash, read);
+    auto f = co_await coroutine::as_future(query_singular(std::move(cmd), std::move(partition_ranges), cl, std::move(query_options)));
+
+    // Reads which arrive from now on have to read on their own, this one's
+    // result may already be outdated for them.
+    std::tie(begin, end) = _coalesced_reads.equal_range(hash);
+    _coalesced_reads.erase(std::find_if(begin, end, [&] (const auto& entry) { return entry.second == read; }));
+
+    if (f.failed()) {
+        auto ex = f.get_exception();
+        read->exception = ex;
+        read->done.set_value();
+        co_await coroutine::return_exception_ptr(std::move(ex));
+    }
+    auto res = f.get();
+    if (!read->joined) {
+        co_return std::move(res);
+    }
+    if (!res) {
+        read->error = res.error().clone();
+    } else {
+        auto& qr = res.value();
+        if (qr.query_result.get_owner_shard() == this_shard_id()) {
+            read->result = qr.query_result.release();
+            qr.query_result = make_foreign(read->result);
+        } else {
+            read->result = make_lw_shared<query::result>(*qr.query_result);
+        }
+        read->last_replicas = qr.last_replicas;
+        read->read_repair_decision = qr.read_repair_decision;
+    }
+    read->done.set_value();
+    co_return std::move(res);
+}
+
 future<result<storage_proxy::coordinator_query_result>>
 storage_proxy::query_singular(lw_shared_ptr<query::read_command> cmd,
         dht::partition_range_vector&& partition_ranges,
@@ -5187,9 +5806,65 @@ storage_proxy::query_singular(lw_shared_ptr<query::read_command> cmd,
                 }
                 co_return std::move(result);
             };
+            // The results are merged in the order of the partitions, so once
+            // the ones read hold as many rows, or partitions, as the command
+            // is limited to, or one of them is short, the merger drops the
+            // results of the following partitions anyway. Read the partitions
+            // a window at a time, so that these aren't read at all, and a
+            // read of hundreds of partitions doesn't send all the requests at
+            // once.
+            const size_t max_concurrency = _db.local().get_config().multi_partition_read_concurrency();
+            const size_t concurrency = max_concurrency ? std::min(max_concurrency, exec.size()) : exec.size();
             query::result_merger merger(cmd->get_row_limit(), cmd->partition_limit);
             merger.reserve(exec.size());
-            result = co_await utils::result_map_reduce(exec.begin(), exec.end(), std::move(mapper), std::move(merger));
+            std::vector<future<::result<foreign_ptr<lw_shared_ptr<query::result>>>>> reads;
+            reads.reserve(exec.size());
+            auto start_reads = [&] (size_t until) {
+                while (reads.size() < std::min(until, exec.size())) {
+                    reads.push_back(mapper(exec[reads.size()]));
+                }
+            };
+            start_reads(concurrency);
+            std::exception_ptr ex;
+            ::result<foreign_ptr<lw_shared_ptr<query::result>>> merged = nullptr;
+            bool done = false;
+            uint64_t rows = 0;
+            uint64_t partitions = 0;
+            // Every read started is waited for, even after one fails, as
+            // they refer to the executors.
+            for (size_t i = 0; i < reads.size(); ++i) {
+                auto f = co_await coroutine::as_future(std::move(reads[i]));
+                if (ex || !merged) {
+                    f.ignore_ready_future();
+                    continue;
+                }
+                if (f.failed()) {
+                    ex = f.get_exception();
+                    continue;
+                }
+                auto res = f.get();
+                if (!res) {
+                    merged = std::move(res).as_failure();
+                    continue;
+                }
+                if (done) {
+                    continue;
+                }
+                auto& partial = res.value();
+                partial->ensure_counts();
+                rows += *partial->row_count();
+                partitions += *partial->partition_count();
+                done = partial->is_short_read() || rows >= cmd->get_row_limit() || partitions >= cmd->partition_limit;
+                merger(std::move(partial));
+                if (!done) {
+                    start_reads(i + 1 + concurrency);
+                }
+            }
+            if (ex) {
+                std::rethrow_exception(std::move(ex));
+            }
+            get_stats().partition_reads_skipped += exec.size() - reads.size();
+            result = merged ? ::result<foreign_ptr<lw_shared_ptr<query::result>>>(merger.get()) : std::move(merged);
         }
     } catch(...) {
         handle_read_error(std::current_exception(), false);
@@ -5237,7 +5912,7 @@ storage_proxy::query_partition_key_range_concurrent(storage_proxy::clock_type::t
         lw_shared_ptr<query::read_command> cmd,
         db::consistency_level cl,
         query_ranges_to_vnodes_generator&& ranges_to_vnodes,
-        int concurrency_factor,
+        range_scan_concurrency_controller concurrency,
         tracing::trace_state_ptr trace_state,
         uint64_t remaining_row_count,
         uint32_t remaining_partition_count,
@@ -5263,14 +5938,12 @@ storage_proxy::query_partition_key_range_concurrent(storage_proxy::clock_type::t
     };
     const auto to_token_range = [] (const dht::partition_range& r) { return r.transform(std::mem_fn(&dht::ring_position::token)); };
 
-    dht::partition_range_vector ranges = ranges_to_vnodes(concurrency_factor);
+    const auto round_start = clock_type::now();
+    dht::partition_range_vector ranges = ranges_to_vnodes(concurrency.concurrency());
     dht::partition_range_vector::iterator i = ranges.begin();
-
-    // query_ranges_to_vnodes_generator can return less results than requested. If the number of results
-    // is small enough or there are a lot of results - concurrentcy_factor which is increased by shifting left can
-    // eventualy zero out resulting in an infinite recursion. This line makes sure that concurrency factor is never
-    // get stuck on 0 and never increased too much if the number of results remains small.
-    concurrency_factor = std::max(size_t(1), ranges.size());
+    // query_ranges_to_vnodes_generator can return less results than requested.
+    const auto round_ranges = ranges.size();
+    slogger.trace("range scan round of {} vnode ranges, concurrency {}", round_ranges, concurrency.concurrency());
 
     auto& gossiper = _remote->gossiper();
     while (i != ranges.end()) {
@@ -5397,7 +6070,9 @@ storage_proxy::query_partition_key_range_concurrent(storage_proxy::clock_type::t
             ranges_to_vnodes = std::move(ranges_to_vnodes),
             cl,
             cmd,
-            concurrency_factor,
+            concurrency,
+            round_start,
+            round_ranges,
             timeout,
             remaining_row_count,
             remaining_partition_count,
@@ -5408,8 +6083,19 @@ storage_proxy::query_partition_key_range_concurrent(storage_proxy::clock_type::t
         result->ensure_counts();
         remaining_row_count -= result->row_count().value();
         remaining_partition_count -= result->partition_count().value();
+        const auto now = clock_type::now();
+        concurrency.on_round_completed(round_ranges, result->row_count().value(), result->partition_count().value(), result->buf().size(),
+                remaining_row_count, remaining_partition_count, now - round_start, timeout - now);
         results.emplace_back(std::move(result));
         if (ranges_to_vnodes.empty() || !remaining_row_count || !remaining_partition_count) {
+            if (!ranges_to_vnodes.empty() && cmd->query_uuid) {
+                // The page is full, keep the concurrency for the next one.
+                try {
+                    p->_range_scan_contexts.put(cmd->query_uuid, concurrency);
+                } catch (...) {
+                    slogger.debug("Failed to keep the concurrency of range scan {}: {}", cmd->query_uuid, std::current_exception());
+                }
+            }
             auto used_replicas = replicas_per_token_range();
             for (auto& e : exec) {
                 // We add used replicas in separate per-vnode entries even if
@@ -5427,7 +6113,7 @@ storage_proxy::query_partition_key_range_concurrent(storage_proxy::clock_type::t
             cmd->set_row_limit(remaining_row_count);
             cmd->partition_limit = remaining_partition_count;
             return p->query_partition_key_range_concurrent(timeout, std::move(results), cmd, cl, std::move(ranges_to_vnodes),
-                    concurrency_factor * 2, std::move(trace_state), remaining_row_count, remaining_partition_count, std::move(preferred_replicas), std::move(permit));
+                    concurrency, std::move(trace_state), remaining_row_count, remaining_partition_count, std::move(preferred_replicas), std::move(permit));
         }
       }));
     },  utils::result_catch_dots([p] (auto&& handle) {
@@ -5450,13 +6136,21 @@ storage_proxy::query_partition_key_range(lw_shared_ptr<query::read_command> cmd,
 
     query_ranges_to_vnodes_generator ranges_to_vnodes(get_token_metadata_ptr(), schema, std::move(partition_ranges), merge_tokens);
 
-    int result_rows_per_range = 0;
-    int concurrency_factor = 1;
+    // A page of a paged scan resumes with the concurrency of the previous one.
+    auto resumed = !cmd->is_first_page && cmd->query_uuid
+            ? _range_scan_contexts.take(cmd->query_uuid)
+            : std::nullopt;
+    if (resumed) {
+        ++get_stats().range_scans_resumed;
+    }
+    // The results of a round are expected to fit in a page.
+    range_scan_concurrency_controller concurrency = resumed ? std::move(*resumed) : range_scan_concurrency_controller(cmd->max_result_size
+            ? cmd->max_result_size->get_page_size()
+            : query::result_memory_limiter::maximum_result_size);
 
     std::vector<foreign_ptr<lw_shared_ptr<query::result>>> results;
 
-    slogger.debug("Estimated result rows per range: {}; requested rows: {}, concurrent range requests: {}",
-            result_rows_per_range, cmd->get_row_limit(), concurrency_factor);
+    slogger.debug("Requested rows: {}, concurrent range requests: {}", cmd->get_row_limit(), concurrency.concurrency());
 
     // The call to `query_partition_key_range_concurrent()` below
     // updates `cmd` directly when processing the results. Under
@@ -5476,7 +6170,7 @@ storage_proxy::query_partition_key_range(lw_shared_ptr<query::read_command> cmd,
             cmd,
             cl,
             std::move(ranges_to_vnodes),
-            concurrency_factor,
+            concurrency,
             std::move(query_options.trace_state),
             cmd->get_row_limit(),
             cmd->partition_limit,
@@ -5574,6 +6268,14 @@ storage_proxy::do_query(schema_ptr s,
 
         if (query::is_single_partition(partition_ranges[0])) { // do not support mixed partitions (yet?)
             try {
+                if (s->caching_options().coalesce_reads() && can_coalesce_read(*cmd, partition_ranges)) {
+                    return query_singular_coalesced(s, cmd,
+                            std::move(partition_ranges),
+                            cl,
+                            std::move(query_options)).finally([lc, p] () mutable {
+                        p->get_stats().read.mark(lc.stop().latency());
+                    });
+                }
                 return query_singular(cmd,
                         std::move(partition_ranges),
                         cl,
@@ -5799,6 +6501,22 @@ future<bool> storage_proxy::cas(schema_ptr schema, shared_ptr<cas_request> reque
                 // The majority (aka a QUORUM) has promised the coordinator to
                 // accept the action associated with the computed ballot.
                 // Apply the mutation.
+                if (handler->cl_for_learn() == db::consistency_level::ANY) {
+                    // The decision is accepted, which is all ANY asks for, so
+                    // don't wait for it to be learned. Should the learn fail,
+                    // the next round on the key finds the decision accepted
+                    // and learns it.
+                    get_stats().cas_background_learns++;
+                    // Waited on by drain_on_shutdown(), which closes the gate.
+                    (void)try_with_gate(_background_learns, [handler, proposal = std::move(proposal)] () mutable {
+                        return handler->learn_decision(std::move(proposal));
+                    }).handle_exception([handler] (std::exception_ptr ep) {
+                        paxos::paxos_state::logger.debug("CAS[{}] background learn failed: {}", handler->id(), ep);
+                    });
+                    paxos::paxos_state::logger.debug("CAS[{}] successful", handler->id());
+                    tracing::trace(handler->tr_state, "CAS successful, learning in the background");
+                    break;
+                }
                 try {
                   co_await handler->learn_decision(std::move(proposal));
                 } catch (unavailable_exception& e) {
@@ -5941,6 +6659,24 @@ storage_proxy::query_mutations_locally(schema_ptr s, lw_shared_ptr<query::read_c
     }
 }
 
+future<rpc::tuple<partition_block_digests, cache_temperature>>
+storage_proxy::query_block_digests_locally(schema_ptr s, lw_shared_ptr<query::read_command> cmd, const dht::partition_range& pr, uint32_t block_rows,
+                                           storage_proxy::clock_type::time_point timeout,
+                                           tracing::trace_state_ptr trace_state) {
+    auto&& [result, hit_rate] = co_await query_mutations_locally(s, cmd, pr, timeout, std::move(trace_state));
+    auto digests = co_await compute_block_digests(*s, *cmd, *result, block_rows);
+    co_return rpc::tuple(std::move(digests), hit_rate);
+}
+
+future<rpc::tuple<partition_block_digests, cache_temperature>>
+storage_proxy::query_block_digests_locally(schema_ptr s, lw_shared_ptr<query::read_command> cmd, const ::compat::one_or_two_partition_ranges& pr,
+                                           uint32_t block_rows, storage_proxy::clock_type::time_point timeout,
+                                           tracing::trace_state_ptr trace_state) {
+    auto&& [result, hit_rate] = co_await query_mutations_locally(s, cmd, pr, timeout, std::move(trace_state));
+    auto digests = co_await compute_block_digests(*s, *cmd, *result, block_rows);
+    co_return rpc::tuple(std::move(digests), hit_rate);
+}
+
 future<rpc::tuple<foreign_ptr<lw_shared_ptr<reconcilable_result>>, cache_temperature>>
 storage_proxy::query_nonsingular_mutations_locally(schema_ptr s,
                                                    lw_shared_ptr<query::read_command> cmd,
@@ -6135,6 +6871,7 @@ future<> storage_proxy::drain_on_shutdown() {
     // and writing them down with plain futures is error-prone.
     return async([this] {
         retire_view_response_handlers([] (const abstract_write_response_handler&) { return true; });
+        _background_learns.close().get();
         _hints_resource_manager.stop().get();
     });
 }
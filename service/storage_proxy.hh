@@ -30,7 +30,11 @@
 #include "db/hints/host_filter.hh"
 #include "utils/small_vector.hh"
 #include "service/endpoint_lifecycle_subscriber.hh"
+#include "service/range_scan_concurrency.hh"
+#include "service/replica_load.hh"
+#include "service/row_level_read_repair.hh"
 #include <seastar/core/circular_buffer.hh>
+#include <seastar/core/gate.hh>
 #include "exceptions/exceptions.hh"
 #include "exceptions/coordinator_result.hh"
 #include "replica/exceptions.hh"
@@ -216,6 +220,10 @@ class storage_proxy : public seastar::async_sharded_service<storage_proxy>, publ
     locator::token_metadata_ptr get_token_metadata_ptr() const noexcept;
 
     query::max_result_size get_max_result_size(const query::partition_slice& slice) const;
+
+    replica_load_tracker& replica_load() noexcept {
+        return _replica_load;
+    }
     query::tombstone_limit get_tombstone_limit() const;
     inet_address_vector_replica_set get_live_endpoints(const locator::effective_replication_map& erm, const dht::token& token) const;
 
@@ -237,6 +245,8 @@ class storage_proxy : public seastar::async_sharded_service<storage_proxy>, publ
     // not remove request from the buffer), but this is fine since request ids are unique, so we
     // just skip an entry if request no longer exists.
     circular_buffer<response_id_type> _throttled_writes;
+    // Paxos decisions with consistency level ANY, learned after cas() returned.
+    seastar::gate _background_learns;
     db::hints::resource_manager _hints_resource_manager;
     db::hints::manager _hints_manager;
     db::hints::directory_initializer _hints_directory_initializer;
@@ -248,10 +258,26 @@ class storage_proxy : public seastar::async_sharded_service<storage_proxy>, publ
     class remote;
     std::unique_ptr<remote> _remote;
 
+    class mutation_batcher;
+
     static constexpr float CONCURRENT_SUBREQUESTS_MARGIN = 0.10;
     // for read repair chance calculation
     std::default_random_engine _urandom;
     std::uniform_real_distribution<> _read_repair_chance = std::uniform_real_distribution<>(0,1);
+    // Every read which may speculate adds speculative_retry_max_ratio to the
+    // credit, and every speculative request takes 1 off it.
+    static constexpr double max_speculative_read_credit = 100;
+    double _speculative_read_credit = 0;
+    // Single-partition reads of tables with coalesce_reads in flight, by
+    // their coalesced_read_hash().
+    struct coalesced_read;
+    std::unordered_multimap<size_t, lw_shared_ptr<coalesced_read>> _coalesced_reads;
+    // Counter updates waiting for coordinator_counter_update_coalescing_window_in_us
+    // to be sent to their leader, by their token.
+    struct coalesced_counter_update;
+    std::unordered_multimap<dht::token, lw_shared_ptr<coalesced_counter_update>> _coalesced_counter_updates;
+    replica_load_tracker _replica_load;
+    range_scan_context_cache _range_scan_contexts;
     seastar::metrics::metric_groups _metrics;
     uint64_t _background_write_throttle_threahsold;
     inheriting_concrete_execution_stage<
@@ -290,6 +316,12 @@ class storage_proxy : public seastar::async_sharded_service<storage_proxy>, publ
 
     cdc_stats _cdc_stats;
 private:
+    // Like query_singular(), but joins an identical read in flight, if any.
+    future<result<coordinator_query_result>> query_singular_coalesced(schema_ptr s,
+            lw_shared_ptr<query::read_command> cmd,
+            dht::partition_range_vector&& partition_ranges,
+            db::consistency_level cl,
+            coordinator_query_options optional_params);
     future<result<coordinator_query_result>> query_singular(lw_shared_ptr<query::read_command> cmd,
             dht::partition_range_vector&& partition_ranges,
             db::consistency_level cl,
@@ -314,7 +346,7 @@ class storage_proxy : public seastar::async_sharded_service<storage_proxy>, publ
     result<response_id_type> create_write_response_handler(const std::tuple<lw_shared_ptr<paxos::proposal>, schema_ptr, dht::token, inet_address_vector_replica_set>& meta,
             db::consistency_level cl, db::write_type type, tracing::trace_state_ptr tr_state, service_permit permit, db::allow_per_partition_rate_limit allow_limit);
     void register_cdc_operation_result_tracker(const storage_proxy::unique_response_handler_vector& ids, lw_shared_ptr<cdc::operation_result_tracker> tracker);
-    void send_to_live_endpoints(response_id_type response_id, clock_type::time_point timeout);
+    void send_to_live_endpoints(response_id_type response_id, clock_type::time_point timeout, mutation_batcher* batcher = nullptr);
     template<typename Range>
     size_t hint_to_dead_endpoints(std::unique_ptr<mutation_holder>& mh, const Range& targets, db::write_type type, tracing::trace_state_ptr tr_state) noexcept;
     void hint_to_dead_endpoints(response_id_type, db::consistency_level);
@@ -358,7 +390,7 @@ class storage_proxy : public seastar::async_sharded_service<storage_proxy>, publ
             lw_shared_ptr<query::read_command> cmd,
             db::consistency_level cl,
             query_ranges_to_vnodes_generator&& ranges_to_vnodes,
-            int concurrency_factor,
+            range_scan_concurrency_controller concurrency,
             tracing::trace_state_ptr trace_state,
             uint64_t remaining_row_count,
             uint32_t remaining_partition_count,
@@ -420,6 +452,10 @@ class storage_proxy : public seastar::async_sharded_service<storage_proxy>, publ
 
     template<typename Range>
     future<> mutate_counters(Range&& mutations, db::consistency_level cl, tracing::trace_state_ptr tr_state, service_permit permit, clock_type::time_point timeout);
+    template<typename Range>
+    future<> do_mutate_counters(Range&& mutations, db::consistency_level cl, tracing::trace_state_ptr tr_state, service_permit permit, clock_type::time_point timeout);
+    future<> mutate_counter_coalesced(const mutation& m, db::consistency_level cl, tracing::trace_state_ptr tr_state, service_permit permit,
+            clock_type::time_point timeout, std::chrono::microseconds window);
 
     void retire_view_response_handlers(noncopyable_function<bool(const abstract_write_response_handler&)> filter_fun);
 
@@ -620,6 +656,18 @@ class storage_proxy : public seastar::async_sharded_service<storage_proxy>, publ
         clock_type::time_point timeout,
         tracing::trace_state_ptr trace_state = nullptr);
 
+    // Computes the block digests of the result of a single-partition mutation
+    // read, for row-level read repair (see service/row_level_read_repair.hh).
+    future<rpc::tuple<partition_block_digests, cache_temperature>> query_block_digests_locally(
+        schema_ptr, lw_shared_ptr<query::read_command> cmd, const dht::partition_range&, uint32_t block_rows,
+        clock_type::time_point timeout,
+        tracing::trace_state_ptr trace_state = nullptr);
+
+    future<rpc::tuple<partition_block_digests, cache_temperature>> query_block_digests_locally(
+        schema_ptr, lw_shared_ptr<query::read_command> cmd, const ::compat::one_or_two_partition_ranges&, uint32_t block_rows,
+        clock_type::time_point timeout,
+        tracing::trace_state_ptr trace_state = nullptr);
+
     future<bool> cas(schema_ptr schema, shared_ptr<cas_request> request, lw_shared_ptr<query::read_command> cmd,
             dht::partition_range_vector partition_ranges, coordinator_query_options query_options,
             db::consistency_level cl_for_paxos, db::consistency_level cl_for_learn,
@@ -638,6 +686,11 @@ class storage_proxy : public seastar::async_sharded_service<storage_proxy>, publ
     future<db::hints::sync_point> create_hint_sync_point(const std::vector<gms::inet_address> target_hosts) const;
     future<> wait_for_hint_sync_point(const db::hints::sync_point spoint, clock_type::time_point deadline);
 
+    // Accounts for a read which may send a speculative request.
+    void add_speculative_read_credit() noexcept;
+    // Whether a speculative request may be sent, within speculative_retry_max_ratio.
+    bool consume_speculative_read_credit() noexcept;
+
     const stats& get_stats() const {
         return scheduling_group_get_specific<storage_proxy_stats::stats>(_stats_key);
     }
@@ -785,6 +838,9 @@ class paxos_response_handler : public enable_shared_from_this<paxos_response_han
     const partition_key& key() const {
         return _key.key();
     }
+    db::consistency_level cl_for_learn() const {
+        return _cl_for_learn;
+    }
     void set_cl_for_learn(db::consistency_level cl) {
         _cl_for_learn = cl;
     }
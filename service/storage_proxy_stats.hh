@@ -96,11 +96,25 @@ struct write_stats {
     // A CQL read query arrived to a non-replica node and was
     // forwarded by a coordinator to a replica
     uint64_t reads_coordinator_outside_replica_set = 0;
+    // A read was sent to the extra replica instead of a more loaded one
+    uint64_t reads_balanced_by_load = 0;
+    // A single-partition read joined an identical read in flight
+    uint64_t coalesced_reads = 0;
+    // A counter update was merged into a pending one to the same partition
+    uint64_t coalesced_counter_updates = 0;
+    // A page of a range scan resumed the concurrency of the previous page
+    uint64_t range_scans_resumed = 0;
+    // A partition of a multi-partition read wasn't read, because the
+    // partitions before it already held the rows the read is limited to
+    uint64_t partition_reads_skipped = 0;
     uint64_t background_writes = 0; // client no longer waits for the write
     uint64_t throttled_writes = 0; // total number of writes ever delayed due to throttling
     uint64_t throttled_base_writes = 0; // current number of base writes delayed due to view update backlog
     uint64_t background_writes_failed = 0;
     uint64_t writes_failed_due_to_too_many_in_flight_hints = 0;
+    // number of MUTATION_BATCH messages sent, and of the mutations in them
+    uint64_t mutation_batches = 0;
+    uint64_t batched_mutations = 0;
 
     uint64_t cas_write_unfinished_commit = 0;
     uint64_t cas_write_condition_not_met = 0;
@@ -110,6 +124,11 @@ struct write_stats {
     uint64_t cas_prune = 0;
     uint64_t cas_coordinator_dropped_prune = 0;
     uint64_t cas_replica_dropped_prune = 0;
+    // prepare and accept rounds which found the paxos state of their key
+    // cached, and which had to read it from system.paxos
+    uint64_t cas_replica_state_cache_hits = 0;
+    uint64_t cas_replica_state_cache_misses = 0;
+    uint64_t cas_background_learns = 0;
 
 
     std::chrono::microseconds last_mv_flow_control_delay; // delay added for MV flow control in the last request
@@ -140,6 +159,11 @@ struct stats : public write_stats {
     uint64_t read_repair_attempts = 0;
     uint64_t read_repair_repaired_blocking = 0;
     uint64_t read_repair_repaired_background = 0;
+    // read repairs which fetched only the differing blocks of rows, and which
+    // compared the blocks but fetched all rows
+    uint64_t read_repair_row_level = 0;
+    uint64_t read_repair_row_level_fallbacks = 0;
+    uint64_t read_repair_row_level_bytes_saved = 0;
     uint64_t global_read_repairs_canceled_due_to_concurrent_write = 0;
 
     // number of mutations received as a coordinator
@@ -156,6 +180,7 @@ struct stats : public write_stats {
     uint64_t replica_data_reads = 0;
     uint64_t replica_digest_reads = 0;
     uint64_t replica_mutation_data_reads = 0;
+    uint64_t replica_block_digest_reads = 0;
 
     uint64_t replica_cross_shard_ops = 0;
 
@@ -168,6 +193,7 @@ struct stats : public write_stats {
     uint64_t read_retries = 0; // read is retried with new limit
     uint64_t speculative_digest_reads = 0;
     uint64_t speculative_data_reads = 0;
+    uint64_t speculative_reads_throttled = 0;
 
     uint64_t cas_read_unfinished_commit = 0;
     uint64_t cas_foreground = 0;
@@ -480,6 +480,11 @@ class compressed_file_data_sink_impl : public data_sink_impl {
     sstables::local_compression _compression;
     size_t _pos = 0;
     uint32_t _full_checksum;
+    // When the compressor wants to train a dictionary, the first chunks are
+    // held back until _training_size bytes are gathered to train it on.
+    size_t _training_size;
+    size_t _training_buffered = 0;
+    std::vector<temporary_buffer<char>> _training_samples;
 public:
     compressed_file_data_sink_impl(output_stream<char> out, sstables::compression* cm, sstables::local_compression lc)
             : _out(std::move(out))
@@ -487,10 +492,59 @@ class compressed_file_data_sink_impl : public data_sink_impl {
             , _offsets(_compression_metadata->offsets.get_writer())
             , _compression(lc)
             , _full_checksum(ChecksumType::init_checksum())
+            , _training_size(_compression ? _compression.compressor()->dictionary_training_size() : 0)
     {}
 
     virtual future<> put(net::packet data) override { abort(); }
     virtual future<> put(temporary_buffer<char> buf) override {
+        if (_training_size) {
+            _training_buffered += buf.size();
+            _training_samples.push_back(std::move(buf));
+            if (_training_buffered < _training_size) {
+                return make_ready_future<>();
+            }
+            return train_and_flush_samples();
+        }
+        return compress_and_write(std::move(buf));
+    }
+    virtual future<> close() override {
+        if (_training_size) {
+            return train_and_flush_samples().then([this] {
+                return _out.close();
+            });
+        }
+        return _out.close();
+    }
+
+    virtual size_t buffer_size() const noexcept override {
+        return _compression_metadata->uncompressed_chunk_length();
+    }
+private:
+    // Trains the compressor's dictionary on the chunks held back so far,
+    // records it in the compression metadata and writes the chunks out.
+    future<> train_and_flush_samples() {
+        _training_size = 0;
+        return _compression.compressor()->train_dictionary(_training_samples).then([this] (compressor::ptr_type trained) {
+            if (trained) {
+                auto& options = _compression_metadata->options.elements;
+                for (auto& [k, v] : trained->options()) {
+                    auto key = bytes(k.begin(), k.end());
+                    auto it = std::find_if(options.begin(), options.end(), [&key] (const auto& o) { return o.key.value == key; });
+                    if (it == options.end()) {
+                        options.push_back({std::move(key), bytes(v.begin(), v.end())});
+                    }
+                }
+                _compression = sstables::local_compression(std::move(trained));
+            }
+            return do_for_each(_training_samples, [this] (temporary_buffer<char>& buf) {
+                return compress_and_write(std::move(buf));
+            });
+        }).then([this] {
+            _training_samples.clear();
+        });
+    }
+
+    future<> compress_and_write(temporary_buffer<char> buf) {
         auto output_len = _compression.compress_max_size(buf.size());
 
         // account space for checksum that goes after compressed data.
@@ -530,13 +584,6 @@ class compressed_file_data_sink_impl : public data_sink_impl {
         auto f = _out.write(compressed.get(), compressed.size());
         return f.then([compressed = std::move(compressed)] {});
     }
-    virtual future<> close() override {
-        return _out.close();
-    }
-
-    virtual size_t buffer_size() const noexcept override {
-        return _compression_metadata->uncompressed_chunk_length();
-    }
 };
 
 template <typename ChecksumType, compressed_checksum_mode mode>
@@ -126,7 +126,15 @@ class primitive_consumer {
             _prestate = ReadingVint;
             return read_status::waiting;
         } else {
-            const vint_size_type len = VintType::serialized_size_from_first_byte(*data.begin());
+            // Most vints in sstables, like flags, lengths and small deltas, fit in one byte,
+            // so decode those without going out of line.
+            const auto first_byte = static_cast<bytes::value_type>(*data.begin());
+            if (first_byte >= 0) {
+                dest = VintType::deserialize_single_byte(first_byte);
+                data.trim_front(1);
+                return read_status::ready;
+            }
+            const vint_size_type len = VintType::serialized_size_from_first_byte(first_byte);
             if (data.size() >= len) {
                 dest = VintType::deserialize(
                         bytes_view(reinterpret_cast<bytes::value_type*>(data.get_write()), data.size()));
@@ -479,6 +487,9 @@ class continuous_data_consumer : protected primitive_consumer {
     uint64_t _remain;
     std::optional<reader_permit::blocked_guard> _blocked_guard;
     bool _first_invoke = true;
+    // Bytes skipped over by fast_forward_to(), some of which may have been
+    // read ahead already.
+    uint64_t _bytes_skipped = 0;
 public:
     using read_status = data_consumer::read_status;
 
@@ -611,6 +622,7 @@ class continuous_data_consumer : protected primitive_consumer {
         assert(begin >= _stream_position.position);
         auto n = begin - _stream_position.position;
         _stream_position.position = begin;
+        _bytes_skipped += n;
 
         assert(end >= _stream_position.position);
         _remain = end - _stream_position.position;
@@ -639,6 +651,10 @@ class continuous_data_consumer : protected primitive_consumer {
         return _remain == 0;
     }
 
+    uint64_t bytes_skipped() const {
+        return _bytes_skipped;
+    }
+
     future<> close() noexcept {
         return _input.close();
     }
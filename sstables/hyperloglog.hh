@@ -89,6 +89,21 @@ static inline size_t write_unsigned_var_int(unsigned int value, uint8_t* to) {
     return size;
 }
 
+static inline unsigned int read_unsigned_var_int(const uint8_t*& from, const uint8_t* end) {
+    unsigned int value = 0;
+    for (unsigned shift = 0; shift < 32; shift += 7) {
+        if (from == end) {
+            throw std::invalid_argument("truncated unsigned var int");
+        }
+        auto byte = *from++;
+        value |= unsigned(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            return value;
+        }
+    }
+    throw std::invalid_argument("unsigned var int is too long");
+}
+
 /** @class HyperLogLog
  *  @brief Implement of 'HyperLogLog' estimate cardinality algorithm
  */
@@ -128,11 +143,29 @@ class HyperLogLog {
         alphaMM_ = alpha * m_ * m_;
     }
 
+    /**
+     * Creates an estimator from the output of get_bytes(), as stored
+     * in the compaction metadata.
+     *
+     * @exception std::invalid_argument the bytes are not in that format.
+     */
     static HyperLogLog from_bytes(temporary_buffer<uint8_t> bytes) {
-        // FIXME: implement class that creates a HyperLogLog from an array of bytes.
-        // This will useful if we need to work with the cardinality data from the
-        // compaction metadata.
-        abort();
+        const uint8_t* from = bytes.get();
+        const uint8_t* end = from + bytes.size();
+        if (bytes.size() < sizeof(int) || read_be<int32_t>(reinterpret_cast<const char*>(from)) != -2) {
+            throw std::invalid_argument("unsupported cardinality format");
+        }
+        from += sizeof(int);
+        auto b = read_unsigned_var_int(from, end);
+        auto sp = read_unsigned_var_int(from, end);
+        auto type = read_unsigned_var_int(from, end);
+        auto size = read_unsigned_var_int(from, end);
+        if (b < 4 || 16 < b || sp != 0 || type != 0 || size != (1u << b) || size_t(end - from) != size) {
+            throw std::invalid_argument("unsupported cardinality format");
+        }
+        HyperLogLog hll(b);
+        std::copy(from, end, hll.M_.begin());
+        return hll;
     }
 
     /**
@@ -164,7 +197,7 @@ class HyperLogLog {
     /*
      * Calculate the size of buffer returned by get_bytes().
      */
-    size_t get_bytes_size() {
+    size_t get_bytes_size() const {
         size_t size = 0;
         size += sizeof(int); // version
         size += size_unsigned_var_int(b_); // p; register width = b_.
@@ -175,7 +208,7 @@ class HyperLogLog {
         return size;
     }
 
-    temporary_buffer<uint8_t> get_bytes() {
+    temporary_buffer<uint8_t> get_bytes() const {
         // FIXME: add support to SPARSE format.
         static constexpr int version = 2;
 
@@ -638,8 +638,13 @@ class index_reader {
         }
 
         auto& summary = _sstable->get_summary();
+        // Entries outside of the token's bucket are known to compare less or greater
+        // than pos, so narrow the search down using the summary's token index first.
+        auto [bucket_first, bucket_last] = summary.token_index_range(pos.token());
+        auto first = std::max<size_t>(bound.previous_summary_idx, bucket_first);
+        auto last = std::max<size_t>(first, bucket_last);
         bound.previous_summary_idx = std::distance(std::begin(summary.entries),
-            std::lower_bound(summary.entries.begin() + bound.previous_summary_idx, summary.entries.end(), pos, index_comparator(*_sstable->_schema)));
+            std::lower_bound(summary.entries.begin() + first, summary.entries.begin() + last, pos, index_comparator(*_sstable->_schema)));
 
         if (bound.previous_summary_idx == 0) {
             sstlog.trace("index {}: first entry", fmt::ptr(this));
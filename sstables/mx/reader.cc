@@ -51,6 +51,14 @@ class mp_row_consumer_m {
     schema_ptr _schema;
     const query::partition_slice& _slice;
     std::optional<mutation_fragment_filter> _mf_filter;
+    // Rows it rejects are skipped unparsed. It's ignored by reads which go
+    // through the cache: the cache would be populated with the result, and
+    // believe the rows it dropped don't exist.
+    const query::clustering_row_filter* _row_filter;
+    // With query::partition_slice::option::omit_unselected_cell_values, the
+    // cells of the columns which aren't selected are read without values.
+    const bool _omit_unselected_cell_values;
+    column_set _selected_columns;
 
     bool _is_mutation_end = true;
     streamed_mutation::forwarding _fwd;
@@ -211,11 +219,24 @@ class mp_row_consumer_m {
         , _reader(reader)
         , _schema(schema)
         , _slice(slice)
+        , _row_filter(slice.get_row_filter() && slice.options.contains<query::partition_slice::option::bypass_cache>()
+                ? &*slice.get_row_filter() : nullptr)
+        , _omit_unselected_cell_values(slice.options.contains<query::partition_slice::option::omit_unselected_cell_values>()
+                && slice.options.contains<query::partition_slice::option::bypass_cache>())
         , _fwd(fwd)
         , _treat_static_row_as_regular(_schema->is_static_compact_table()
             && (!sst->has_scylla_component() || sst->features().is_enabled(sstable_feature::CorrectStaticCompact))) // See #4139
     {
         _cells.reserve(std::max(_schema->static_columns_count(), _schema->regular_columns_count()));
+        if (_omit_unselected_cell_values) {
+            _selected_columns.resize(_schema->all_columns_count());
+            for (auto id : slice.static_columns) {
+                _selected_columns.set(_schema->static_column_at(id).ordinal_id);
+            }
+            for (auto id : slice.regular_columns) {
+                _selected_columns.set(_schema->regular_column_at(id).ordinal_id);
+            }
+        }
     }
 
     mp_row_consumer_m(mp_row_consumer_reader_mx* reader,
@@ -332,6 +353,12 @@ class mp_row_consumer_m {
 
         switch (res.action) {
         case mutation_fragment_filter::result::emit:
+            if (_row_filter && !(*_row_filter)(*_schema, _in_progress_row->key())) {
+                sstlog.trace("mp_row_consumer_m {}: filtered out", fmt::ptr(this));
+                _sst->get_stats().on_row_filtered();
+                _in_progress_row.reset();
+                return mp_row_consumer_m::row_processing_result::skip_row;
+            }
             sstlog.trace("mp_row_consumer_m {}: emit", fmt::ptr(this));
             return mp_row_consumer_m::row_processing_result::do_proceed;
         case mutation_fragment_filter::result::ignore:
@@ -383,6 +410,22 @@ class mp_row_consumer_m {
         return mp_row_consumer_m::row_processing_result::do_proceed;
     }
 
+    // Returns true if a cell of the column with the given timestamp is going
+    // to be dropped by consume_column(), because the column is missing from
+    // the current schema or was dropped after the cell was written. The value
+    // of such cells doesn't need to be read.
+    bool is_cell_discarded(const column_translation::column_info& column_info, api::timestamp_type timestamp) const {
+        return !column_info.id || timestamp <= get_column_definition(column_info.id).dropped_at();
+    }
+
+    // Returns true if the value of a cell of the column isn't needed by the
+    // read, which gets the cell with an empty value instead. The cell still
+    // counts for the liveness of its row.
+    bool is_cell_value_omitted(const column_translation::column_info& column_info) const {
+        return _omit_unselected_cell_values && column_info.id && !column_info.is_counter
+                && !_selected_columns.test(get_column_definition(column_info.id).ordinal_id);
+    }
+
     proceed consume_column(const column_translation::column_info& column_info,
                                    bytes_view cell_path,
                                    fragmented_temporary_buffer::view value,
@@ -1079,6 +1122,20 @@ class data_consume_rows_context_m : public data_consumer::continuous_data_consum
             }
             if (!_column_flags.has_value()) {
                 _column_value = fragmented_temporary_buffer();
+            } else if (_consumer.is_cell_discarded(get_column_info(), _column_timestamp) || _consumer.is_cell_value_omitted(get_column_info())) {
+                // Skip the value without copying it, the consumer drops the
+                // cell or doesn't need its value anyway.
+                _column_value = fragmented_temporary_buffer();
+                if (auto len = get_column_value_length()) {
+                    _u64 = *len;
+                } else {
+                    co_yield read_unsigned_vint(*_processing_data);
+                }
+                _sst->get_stats().on_cell_value_skip();
+                auto maybe_skip_bytes = skip(*_processing_data, _u64);
+                if (std::holds_alternative<skip_bytes>(maybe_skip_bytes)) {
+                    co_yield maybe_skip_bytes;
+                }
             } else {
                 read_status status = read_status::waiting;
                 if (auto len = get_column_value_length()) {
@@ -1508,6 +1565,12 @@ class mx_sstable_mutation_reader : public mp_row_consumer_reader_mx {
         auto [begin, end] = _index_reader->data_file_positions();
         assert(end);
 
+        _will_likely_slice = will_likely_slice(_slice);
+        // Sliced reads skip within the partition using the promoted index,
+        // wasting what was read ahead of the skipped-to position.
+        auto sparse = sstable::sparse_read(_will_likely_slice && _index_reader->partition_data_ready()
+                && _index_reader->get_promoted_index_size() > 0);
+
         if (_single_partition_read) {
             _read_enabled = (begin != *end);
             if (reversed()) {
@@ -1516,18 +1579,20 @@ class mx_sstable_mutation_reader : public mp_row_consumer_reader_mx {
                 _context = std::move(reversed_context.the_context);
                 _reversed_read_sstable_position = &reversed_context.current_position_in_sstable;
             } else {
-                _context = data_consume_single_partition<DataConsumeRowsContext>(*_schema, _sst, _consumer, { begin, *end });
+                _context = data_consume_single_partition<DataConsumeRowsContext>(*_schema, _sst, _consumer, { begin, *end }, sparse);
             }
         } else {
             sstable::disk_read_range drr{begin, *end};
             auto last_end = _fwd_mr ? _sst->data_size() : drr.end;
             _read_enabled = bool(drr);
-            _context = data_consume_rows<DataConsumeRowsContext>(*_schema, _sst, _consumer, std::move(drr), last_end);
+            // Scans bypassing the cache are mostly exports and analytics,
+            // reading the ranges whole.
+            auto sequential = sstable::sequential_read(!sparse && _slice.options.contains(query::partition_slice::option::bypass_cache));
+            _context = data_consume_rows<DataConsumeRowsContext>(*_schema, _sst, _consumer, std::move(drr), last_end, sparse, sequential);
         }
 
         _monitor.on_read_started(_context->reader_position());
         _index_in_current_partition = true;
-        _will_likely_slice = will_likely_slice(_slice);
     }
     future<> ensure_initialized() {
         if (is_initialized()) {
@@ -1540,6 +1605,7 @@ class mx_sstable_mutation_reader : public mp_row_consumer_reader_mx {
         if (begin <= _context->position()) {
             return make_ready_future<>();
         }
+        _sst->get_stats().on_data_skip(begin - _context->position());
         _context->reset(el);
         return _context->skip_to(begin);
     }
@@ -1659,6 +1725,7 @@ class mx_sstable_mutation_reader : public mp_row_consumer_reader_mx {
     virtual future<> close() noexcept override {
         auto close_context = make_ready_future<>();
         if (_context) {
+            sstlog.trace("sstable_reader: {}: skipped {} bytes of {}", fmt::ptr(_context.get()), _context->bytes_skipped(), _sst->get_filename());
             _monitor.on_read_completed();
             // move _context to prevent double-close from destructor.
             close_context = _context->close().finally([_ = std::move(_context)] {});
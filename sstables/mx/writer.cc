@@ -18,6 +18,7 @@
 #include "atomic_cell.hh"
 #include "utils/exceptions.hh"
 #include "db/large_data_handler.hh"
+#include "utils/bloom_filter.hh"
 
 #include <functional>
 #include <boost/iterator/iterator_facade.hpp>
@@ -594,8 +595,21 @@ class writer : public sstable_writer::writer_impl {
     run_id _run_identifier;
     bool _write_regular_as_static; // See #4139
     scylla_metadata::large_data_stats _large_data_stats;
+    // Keys of the row bloom filter, see sstable_writer_config::row_bloom_filter.
+    // Disengaged if the row bloom filter is disabled, or was given up on.
+    std::optional<utils::chunked_vector<utils::hashed_key>> _row_bloom_filter_keys;
+    bool _row_bloom_filter_has_partition_key = false;
+    // Partition keys not yet added to the filter. They are added in batches
+    // so that the cache misses of a batch overlap.
+    boost::container::static_vector<utils::hashed_key, 32> _pending_filter_keys;
 
     void init_file_writers();
+    // Adds the full clustering key to the row bloom filter, or the partition key
+    // itself if ck is null, meaning that any row may be covered.
+    void add_to_filter(bytes_view key);
+    void flush_filter_keys();
+    void add_to_row_bloom_filter(const clustering_key_prefix* ck);
+    std::optional<filter> seal_row_bloom_filter();
 
     // Returns the closed writer
     std::unique_ptr<file_writer> close_writer(std::unique_ptr<file_writer>& w);
@@ -792,7 +806,12 @@ class writer : public sstable_writer::writer_impl {
         _sst._shards = { shard };
 
         _cfg.monitor->on_write_started(_data_writer->offset_tracker());
-        _sst._components->filter = utils::i_filter::get_filter(estimated_partitions, _schema.bloom_filter_fp_chance(), utils::filter_format::m_format);
+        _sst._components->filter = _cfg.split_block_filter
+                ? utils::i_filter::get_split_block_filter(estimated_partitions, _schema.bloom_filter_fp_chance())
+                : utils::i_filter::get_filter(estimated_partitions, _schema.bloom_filter_fp_chance(), utils::filter_format::m_format);
+        if (_cfg.row_bloom_filter && _schema.clustering_key_size() && !_write_regular_as_static) {
+            _row_bloom_filter_keys.emplace();
+        }
         _pi_write_m.promoted_index_block_size = cfg.promoted_index_block_size;
         _pi_write_m.promoted_index_auto_scale_threshold = cfg.promoted_index_auto_scale_threshold;
         _index_sampling_state.summary_byte_cost = _cfg.summary_byte_cost;
@@ -916,7 +935,7 @@ void writer::consume_new_partition(const dht::decorated_key& dk) {
     _partition_key = key::from_partition_key(_schema, dk.key());
     maybe_add_summary_entry(dk.token(), bytes_view(*_partition_key));
 
-    _sst._components->filter->add(bytes_view(*_partition_key));
+    add_to_filter(bytes_view(*_partition_key));
     _collector.add_key(bytes_view(*_partition_key));
 
     auto p_key = disk_string_view<uint16_t>();
@@ -944,9 +963,66 @@ void writer::consume_new_partition(const dht::decorated_key& dk) {
 
     _tombstone_written = false;
     _static_row_written = false;
+    _row_bloom_filter_has_partition_key = false;
+}
+
+void writer::add_to_filter(bytes_view key) {
+    _pending_filter_keys.push_back(utils::make_hashed_key(key));
+    if (_pending_filter_keys.size() == _pending_filter_keys.capacity()) {
+        flush_filter_keys();
+    }
+}
+
+void writer::flush_filter_keys() {
+    _sst._components->filter->add_hashed(std::span(_pending_filter_keys.data(), _pending_filter_keys.size()));
+    _pending_filter_keys.clear();
+}
+
+// The row bloom filter is kept in memory for the lifetime of the sstable, and its
+// keys while writing, so give up on it beyond this many rows.
+static constexpr size_t max_row_bloom_filter_keys = 1 << 20;
+
+void writer::add_to_row_bloom_filter(const clustering_key_prefix* ck) {
+    if (!_row_bloom_filter_keys) {
+        return;
+    }
+    if (!ck) {
+        if (_row_bloom_filter_has_partition_key) {
+            return;
+        }
+        _row_bloom_filter_has_partition_key = true;
+    }
+    if (_row_bloom_filter_keys->size() == max_row_bloom_filter_keys) {
+        _row_bloom_filter_keys.reset();
+        return;
+    }
+    _row_bloom_filter_keys->push_back(sstable::make_row_bloom_filter_key(*_partition_key, ck));
+}
+
+std::optional<filter> writer::seal_row_bloom_filter() {
+    if (!_row_bloom_filter_keys) {
+        return std::nullopt;
+    }
+    auto f = utils::i_filter::get_split_block_filter(_row_bloom_filter_keys->size(), _schema.bloom_filter_fp_chance());
+    auto* sbf = dynamic_cast<utils::filter::split_block_bloom_filter*>(f.get());
+    if (!sbf) {
+        // Filtering is disabled for the table.
+        return std::nullopt;
+    }
+    for (auto& k : *_row_bloom_filter_keys) {
+        sbf->add(k);
+    }
+    _row_bloom_filter_keys.reset();
+    auto& storage = sbf->bits().get_storage();
+    filter ret(sbf->serialized_hashes(), utils::chunked_vector<uint64_t>(storage.begin(), storage.end()));
+    _sst._components->row_bloom_filter = std::move(f);
+    return ret;
 }
 
 void writer::consume(tombstone t) {
+    if (t) {
+        add_to_row_bloom_filter(nullptr);
+    }
     uint64_t current_pos = _data_writer->offset();
     auto dt = to_deletion_time(t);
     write(_sst.get_version(), *_data_writer, dt);
@@ -1285,6 +1361,7 @@ stop_iteration writer::consume(clustering_row&& cr) {
     ensure_tombstone_is_written();
     ensure_static_row_is_written_if_needed();
     write_clustered(cr);
+    add_to_row_bloom_filter(cr.key().is_full(_schema) ? &cr.key() : nullptr);
 
     auto can_split_partition_at_clustering_boundary = [this] {
         // will allow size limit to be exceeded for 10%, so we won't perform unnecessary split
@@ -1384,6 +1461,7 @@ stop_iteration writer::consume(range_tombstone_change&& rtc) {
     if (!_current_tombstone && !rtc.tombstone()) {
         return stop_iteration::no;
     }
+    add_to_row_bloom_filter(nullptr);
     tombstone prev_tombstone = std::exchange(_current_tombstone, rtc.tombstone());
     if (!prev_tombstone) { // start bound
         auto bv = pos.as_start_bound_view();
@@ -1433,6 +1511,8 @@ stop_iteration writer::consume_end_of_partition() {
 void writer::consume_end_of_stream() {
     _cfg.monitor->on_data_write_completed();
 
+    flush_filter_keys();
+
     seal_summary(_sst._components->summary, std::move(_first_key), std::move(_last_key), _index_sampling_state).get();
 
     if (_sst.has_component(component_type::CompressionInfo)) {
@@ -1454,7 +1534,7 @@ void writer::consume_end_of_stream() {
     auto features = sstable_enabled_features::all();
     run_identifier identifier{_run_identifier};
     std::optional<scylla_metadata::large_data_stats> ld_stats(std::move(_large_data_stats));
-    _sst.write_scylla_metadata(_pc, _shard, std::move(features), std::move(identifier), std::move(ld_stats), _cfg.origin);
+    _sst.write_scylla_metadata(_pc, _shard, std::move(features), std::move(identifier), std::move(ld_stats), _cfg.origin, seal_row_bloom_filter());
     if (!_cfg.leave_unsealed) {
         _sst.seal_sstable(_cfg.backup).get();
     }
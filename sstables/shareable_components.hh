@@ -19,6 +19,9 @@ namespace sstables {
 struct shareable_components {
     sstables::compression compression;
     utils::filter_ptr filter;
+    // Filter on (partition key, clustering key), null if the sstable has none.
+    // See sstable::row_bloom_filter_may_contain().
+    utils::filter_ptr row_bloom_filter;
     sstables::summary summary;
     sstables::statistics statistics;
     std::optional<sstables::scylla_metadata> scylla_metadata;
@@ -408,6 +408,208 @@ class partitioned_sstable_set::incremental_selector : public incremental_selecto
     }
 };
 
+// Returns the index of the first element of a[0, n) which is not less than v.
+// The loop has a fixed trip count for a given n, and the comparison
+// compiles to a conditional move, so the search doesn't suffer from
+// branch mispredictions.
+static size_t branchless_lower_bound(const int64_t* a, size_t n, int64_t v) noexcept {
+    if (n == 0) {
+        return 0;
+    }
+    const int64_t* base = a;
+    while (n > 1) {
+        auto half = n / 2;
+        base += (base[half] < v) * half;
+        n -= half;
+    }
+    return (base - a) + (*base < v);
+}
+
+leveled_sstable_set::leveled_sstable_set(schema_ptr schema)
+        : _schema(std::move(schema))
+        , _all(make_lw_shared<sstable_list>()) {
+}
+
+leveled_sstable_set::leveled_sstable_set(const leveled_sstable_set& o)
+        : _schema(o._schema)
+        , _unleveled_sstables(o._unleveled_sstables)
+        , _levels(o._levels)
+        , _all(make_lw_shared<sstable_list>(*o._all))
+        , _all_runs(o._all_runs) {
+}
+
+std::unique_ptr<sstable_set_impl> leveled_sstable_set::clone() const {
+    return std::make_unique<leveled_sstable_set>(*this);
+}
+
+size_t leveled_sstable_set::lower_bound(const level& l, dht::ring_position_view pos) const {
+    auto& t = pos.token();
+    if (t._kind != dht::token::kind::key) {
+        return t.is_minimum() ? 0 : l.sstables.size();
+    }
+    auto i = branchless_lower_bound(l.last_tokens.data(), l.last_tokens.size(), t.raw());
+    // Sstables ending at the token of pos may still end before it.
+    while (i < l.sstables.size() && dht::ring_position_tri_compare(*_schema, l.sstables[i]->get_last_decorated_key(), pos) < 0) {
+        ++i;
+    }
+    return i;
+}
+
+bool leveled_sstable_set::insert_leveled(const shared_sstable& sst) {
+    auto level_idx = sst->get_sstable_level();
+    if (_levels.size() <= level_idx) {
+        _levels.resize(level_idx + 1);
+    }
+    auto& l = _levels[level_idx];
+    auto i = lower_bound(l, sst->get_first_decorated_key());
+    if (i < l.sstables.size() && dht::ring_position_tri_compare(*_schema, l.sstables[i]->get_first_decorated_key(), sst->get_last_decorated_key()) <= 0) {
+        return false;
+    }
+    // Reserve up front, so that the insertions below don't throw.
+    l.last_tokens.reserve(l.last_tokens.size() + 1);
+    l.sstables.reserve(l.sstables.size() + 1);
+    l.last_tokens.insert(l.last_tokens.begin() + i, sst->get_last_decorated_key().token().raw());
+    l.sstables.insert(l.sstables.begin() + i, sst);
+    return true;
+}
+
+bool leveled_sstable_set::erase_leveled(const shared_sstable& sst) {
+    auto level_idx = sst->get_sstable_level();
+    if (level_idx >= _levels.size()) {
+        return false;
+    }
+    auto& l = _levels[level_idx];
+    auto i = lower_bound(l, sst->get_first_decorated_key());
+    if (i == l.sstables.size() || l.sstables[i] != sst) {
+        return false;
+    }
+    l.last_tokens.erase(l.last_tokens.begin() + i);
+    l.sstables.erase(l.sstables.begin() + i);
+    return true;
+}
+
+std::vector<shared_sstable> leveled_sstable_set::select(const dht::partition_range& range) const {
+    auto start = dht::ring_position_view::for_range_start(range);
+    auto end = dht::ring_position_view::for_range_end(range);
+    auto r = _unleveled_sstables;
+    for (auto& l : _levels) {
+        for (auto i = lower_bound(l, start); i < l.sstables.size(); ++i) {
+            if (dht::ring_position_tri_compare(*_schema, l.sstables[i]->get_first_decorated_key(), end) >= 0) {
+                break;
+            }
+            r.push_back(l.sstables[i]);
+        }
+    }
+    return r;
+}
+
+std::vector<sstable_run>
+leveled_sstable_set::select_sstable_runs(const std::vector<shared_sstable>& sstables) const {
+    auto has_run = [this] (const shared_sstable& sst) { return _all_runs.contains(sst->run_identifier()); };
+    auto run_ids = boost::copy_range<std::unordered_set<sstables::run_id>>(sstables | boost::adaptors::filtered(has_run) | boost::adaptors::transformed(std::mem_fn(&sstable::run_identifier)));
+    return boost::copy_range<std::vector<sstable_run>>(run_ids | boost::adaptors::transformed([this] (sstables::run_id run_id) {
+        return _all_runs.at(run_id);
+    }));
+}
+
+lw_shared_ptr<sstable_list> leveled_sstable_set::all() const {
+    return _all;
+}
+
+void leveled_sstable_set::for_each_sstable(std::function<void(const shared_sstable&)> func) const {
+    for (auto& sst : *_all) {
+        func(sst);
+    }
+}
+
+void leveled_sstable_set::insert(shared_sstable sst) {
+    _all->insert(sst);
+    auto undo_all_insert = defer([&] () { _all->erase(sst); });
+
+    // If sstable doesn't satisfy disjoint invariant, then place it in a new sstable run.
+    while (!_all_runs[sst->run_identifier()].insert(sst)) {
+        sstlog.warn("Generating a new run identifier for SSTable {} as overlapping was detected when inserting it into SSTable run {}",
+                    sst->get_filename(), sst->run_identifier());
+        sst->generate_new_run_identifier();
+    }
+    auto undo_all_runs_insert = defer([&] () { _all_runs[sst->run_identifier()].erase(sst); });
+
+    if (sst->get_sstable_level() == 0 || !insert_leveled(sst)) {
+        _unleveled_sstables.push_back(sst);
+    }
+    undo_all_insert.cancel();
+    undo_all_runs_insert.cancel();
+}
+
+void leveled_sstable_set::erase(shared_sstable sst) {
+    _all_runs[sst->run_identifier()].erase(sst);
+    _all->erase(sst);
+    if (!erase_leveled(sst)) {
+        _unleveled_sstables.erase(std::remove(_unleveled_sstables.begin(), _unleveled_sstables.end(), sst), _unleveled_sstables.end());
+    }
+}
+
+class leveled_sstable_set::incremental_selector : public incremental_selector_impl {
+    const leveled_sstable_set& _set;
+public:
+    explicit incremental_selector(const leveled_sstable_set& set)
+        : _set(set) {
+    }
+    virtual std::tuple<dht::partition_range, std::vector<shared_sstable>, dht::ring_position_ext> select(const dht::ring_position_view& pos) override {
+        const schema& s = *_set._schema;
+        auto ssts = _set._unleveled_sstables;
+        // The selection holds until the closest sstable boundary after pos,
+        // which is either the end of an sstable containing pos (inclusive),
+        // or the start of the next one (exclusive).
+        const dht::decorated_key* bound = nullptr;
+        bool bound_inclusive = false;
+        auto update_bound = [&] (const dht::decorated_key& dk, bool inclusive) {
+            if (!bound) {
+                bound = &dk;
+                bound_inclusive = inclusive;
+                return;
+            }
+            auto c = dht::ring_position_tri_compare(s, dk, *bound);
+            if (c < 0 || (c == 0 && !inclusive)) {
+                bound = &dk;
+                bound_inclusive = inclusive;
+            }
+        };
+        for (auto& l : _set._levels) {
+            auto i = _set.lower_bound(l, pos);
+            if (i == l.sstables.size()) {
+                continue;
+            }
+            auto& sst = l.sstables[i];
+            if (dht::ring_position_tri_compare(s, sst->get_first_decorated_key(), pos) <= 0) {
+                ssts.push_back(sst);
+                update_bound(sst->get_last_decorated_key(), true);
+            } else {
+                update_bound(sst->get_first_decorated_key(), false);
+            }
+        }
+
+        auto lower_bound = [&] {
+            if (pos.key()) {
+                return dht::partition_range::bound(dht::ring_position(pos.token(), *pos.key()),
+                        pos.is_after_key() == dht::ring_position_view::after_key::no);
+            } else {
+                return dht::partition_range::bound(dht::ring_position(pos.token(), pos.get_token_bound()), true);
+            }
+        }();
+        if (!bound) {
+            return std::make_tuple(dht::partition_range::make_starting_with(std::move(lower_bound)), std::move(ssts), dht::ring_position_view::max());
+        }
+        auto range = dht::partition_range::make(std::move(lower_bound), dht::partition_range::bound(dht::ring_position(*bound), bound_inclusive));
+        auto next = dht::ring_position_ext(dht::ring_position(*bound), dht::ring_position_ext::after_key(bound_inclusive));
+        return std::make_tuple(std::move(range), std::move(ssts), std::move(next));
+    }
+};
+
+std::unique_ptr<incremental_selector_impl> leveled_sstable_set::make_incremental_selector() const {
+    return std::make_unique<incremental_selector>(*this);
+}
+
 time_series_sstable_set::time_series_sstable_set(schema_ptr schema)
     : _schema(std::move(schema))
     , _reversed_schema(_schema->make_reversed())
@@ -650,7 +852,7 @@ std::unique_ptr<sstable_set_impl> compaction_strategy_impl::make_sstable_set(sch
 }
 
 std::unique_ptr<sstable_set_impl> leveled_compaction_strategy::make_sstable_set(schema_ptr schema) const {
-    return std::make_unique<partitioned_sstable_set>(std::move(schema));
+    return std::make_unique<leveled_sstable_set>(std::move(schema));
 }
 
 std::unique_ptr<sstable_set_impl> time_window_compaction_strategy::make_sstable_set(schema_ptr schema) const {
@@ -781,11 +983,10 @@ filter_sstable_for_reader_by_pk(std::vector<shared_sstable>&& sstables, const sc
 // of a range for each clustering component.
 static std::vector<shared_sstable>
 filter_sstable_for_reader_by_ck(std::vector<shared_sstable>&& sstables, replica::column_family& cf, const schema_ptr& schema,
-        const query::partition_slice& slice) {
-    // no clustering filtering is applied if schema defines no clustering key or
-    // compaction strategy thinks it will not benefit from such an optimization,
+        const query::partition_slice& slice, const tracing::trace_state_ptr& trace_state) {
+    // no clustering filtering is applied if schema defines no clustering key
     // or the partition_slice includes static columns.
-    if (!schema->clustering_key_size() || !cf.get_compaction_strategy().use_clustering_key_filter() || slice.static_columns.size()) {
+    if (!schema->clustering_key_size() || slice.static_columns.size()) {
         return std::move(sstables);
     }
 
@@ -802,12 +1003,44 @@ filter_sstable_for_reader_by_ck(std::vector<shared_sstable>&& sstables, replica:
         return std::move(sstables);
     }
 
+    auto size = sstables.size();
     auto skipped = std::partition(sstables.begin(), sstables.end(), [&ranges = ck_filtering_all_ranges] (const shared_sstable& sst) {
         return sst->may_contain_rows(ranges);
     });
     sstables.erase(skipped, sstables.end());
     stats->surviving_sstables_after_clustering_filter += sstables.size();
+    if (sstables.size() != size) {
+        tracing::trace(trace_state, "Clustering key filter skipped {} of {} sstables", size - sstables.size(), size);
+    }
+
+    return std::move(sstables);
+}
 
+// Filter out sstables for reader using the row bloom filter, when the slice
+// names individual rows.
+static std::vector<shared_sstable>
+filter_sstable_for_reader_by_row_bloom_filter(std::vector<shared_sstable>&& sstables, replica::column_family& cf, const schema_ptr& schema,
+        const dht::ring_position& pos, const query::partition_slice& slice, const tracing::trace_state_ptr& trace_state) {
+    if (!schema->clustering_key_size() || slice.static_columns.size()
+            || !std::ranges::any_of(sstables, std::mem_fn(&sstable::has_row_bloom_filter))) {
+        return std::move(sstables);
+    }
+    auto ranges = slice.get_all_ranges();
+    if (ranges.empty() || !std::ranges::all_of(ranges, [&] (const query::clustering_range& r) {
+        return r.is_singular() && r.start()->value().is_full(*schema);
+    })) {
+        return std::move(sstables);
+    }
+    auto pk = key::from_partition_key(*schema, *pos.key());
+    auto size = sstables.size();
+    auto skipped = std::partition(sstables.begin(), sstables.end(), [&] (const shared_sstable& sst) {
+        return sst->row_bloom_filter_may_contain(pk, ranges);
+    });
+    sstables.erase(skipped, sstables.end());
+    cf.cf_stats()->sstables_skipped_by_row_bloom_filter += size - sstables.size();
+    if (sstables.size() != size) {
+        tracing::trace(trace_state, "Row bloom filter skipped {} of {} sstables", size - sstables.size(), size);
+    }
     return std::move(sstables);
 }
 
@@ -836,14 +1069,14 @@ sstable_set_impl::create_single_key_sstable_reader(
         return make_empty_flat_reader_v2(schema, permit);
     }
     auto readers = boost::copy_range<std::vector<flat_mutation_reader_v2>>(
-        filter_sstable_for_reader_by_ck(std::move(selected_sstables), *cf, schema, slice)
+        filter_sstable_for_reader_by_row_bloom_filter(filter_sstable_for_reader_by_ck(std::move(selected_sstables), *cf, schema, slice, trace_state), *cf, schema, pos, slice, trace_state)
         | boost::adaptors::transformed([&] (const shared_sstable& sstable) {
             tracing::trace(trace_state, "Reading key {} from sstable {}", pos, seastar::value_of([&sstable] { return sstable->get_filename(); }));
             return sstable->make_reader(schema, permit, pr, slice, pc, trace_state, fwd);
         })
     );
 
-    // If filter_sstable_for_reader_by_ck filtered any sstable that contains the partition
+    // If filter_sstable_for_reader_by_ck or filter_sstable_for_reader_by_row_bloom_filter filtered any sstable that contains the partition
     // we want to emit partition_start/end if no rows were found,
     // to prevent https://github.com/scylladb/scylla/issues/3552.
     //
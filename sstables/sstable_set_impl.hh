@@ -101,6 +101,48 @@ class partitioned_sstable_set : public sstable_set_impl {
     class incremental_selector;
 };
 
+// specialized for leveled compaction strategy, where the sstables of each
+// level but 0 have disjoint token ranges.
+// Each level is kept as a flat array sorted by key range, searched with a
+// branch-free binary search on the tokens of the last keys. Unlike the
+// interval map of partitioned_sstable_set, this is cheap both to search and
+// to update when there are many sstables.
+class leveled_sstable_set : public sstable_set_impl {
+    // The sstables of a level, with disjoint key ranges, ordered by key range.
+    struct level {
+        // Raw token of the last key of the respective sstable.
+        std::vector<int64_t> last_tokens;
+        std::vector<shared_sstable> sstables;
+    };
+private:
+    schema_ptr _schema;
+    // The level 0 sstables, and sstables overlapping others of their level.
+    std::vector<shared_sstable> _unleveled_sstables;
+    std::vector<level> _levels;
+    lw_shared_ptr<sstable_list> _all;
+    std::unordered_map<run_id, sstable_run> _all_runs;
+private:
+    // Returns the index of the first sstable of the level ending at or after pos.
+    size_t lower_bound(const level& l, dht::ring_position_view pos) const;
+    // Returns false if sst overlaps with another sstable of its level.
+    bool insert_leveled(const shared_sstable& sst);
+    bool erase_leveled(const shared_sstable& sst);
+public:
+    explicit leveled_sstable_set(schema_ptr schema);
+    // Makes a deep copy, including *_all.
+    leveled_sstable_set(const leveled_sstable_set&);
+
+    virtual std::unique_ptr<sstable_set_impl> clone() const override;
+    virtual std::vector<shared_sstable> select(const dht::partition_range& range) const override;
+    virtual std::vector<sstable_run> select_sstable_runs(const std::vector<shared_sstable>& sstables) const override;
+    virtual lw_shared_ptr<sstable_list> all() const override;
+    virtual void for_each_sstable(std::function<void(const shared_sstable&)> func) const override;
+    virtual void insert(shared_sstable sst) override;
+    virtual void erase(shared_sstable sst) override;
+    virtual std::unique_ptr<incremental_selector_impl> make_incremental_selector() const override;
+    class incremental_selector;
+};
+
 class time_series_sstable_set : public sstable_set_impl {
 private:
     using container_t = std::multimap<position_in_partition, shared_sstable, position_in_partition::less_compare>;
@@ -10,6 +10,7 @@
 #include <vector>
 #include <typeinfo>
 #include <limits>
+#include <bit>
 #include <seastar/core/future.hh>
 #include <seastar/core/future-util.hh>
 #include <seastar/core/sstring.hh>
@@ -547,6 +548,7 @@ future<> parse(const schema& schema, sstable_version_types v, random_access_read
     }
     // Delete last element which isn't part of the on-disk format.
     s.positions.pop_back();
+    co_await s.build_token_index();
 }
 
 inline void write(sstable_version_types v, file_writer& out, const summary_entry& entry) {
@@ -1346,6 +1348,12 @@ future<> sstable::read_summary(const io_priority_class& pc) noexcept {
         } else {
             return generate_summary(pc);
         }
+    }).then([this] {
+        auto sampling_level = _manager.config().sstable_summary_sampling_level();
+        if (sampling_level && sampling_level < _components->summary.header.sampling_level) {
+            return downsample_summary(_components->summary, sampling_level);
+        }
+        return make_ready_future<>();
     });
 }
 
@@ -1410,7 +1418,9 @@ future<> sstable::update_info_for_opened_data() {
                                                                    index_page_cache_metrics,
                                                                    _manager.get_cache_tracker().get_lru(),
                                                                    _manager.get_cache_tracker().region(),
-                                                                   _index_file_size);
+                                                                   _index_file_size,
+                                                                   sstring(),
+                                                                   _manager.get_secondary_page_cache());
             _index_file = make_cached_seastar_file(*_cached_index_file);
         });
     }).then([this] {
@@ -1484,15 +1494,38 @@ future<> sstable::read_filter(const io_priority_class& pc) {
         utils::filter_format format = (_version >= sstable_version_types::mc)
                                       ? utils::filter_format::m_format
                                       : utils::filter_format::k_l_format;
-        _components->filter = utils::filter::create_filter(filter.hashes, std::move(bs), format);
+        _components->filter = utils::filter::create_filter_from_disk(filter.hashes, std::move(bs), format);
     });
 }
 
+void sstable::load_row_bloom_filter() {
+    if (!_components->scylla_metadata) {
+        return;
+    }
+    auto& data = _components->scylla_metadata->data;
+    auto* rf = data.get<scylla_metadata_type::RowBloomFilter, filter>();
+    if (!rf) {
+        return;
+    }
+    auto nr_bits = rf->buckets.elements.size() * std::numeric_limits<typename decltype(rf->buckets.elements)::value_type>::digits;
+    large_bitset bs(nr_bits, std::move(rf->buckets.elements));
+    _components->row_bloom_filter = utils::filter::create_filter_from_disk(rf->hashes, std::move(bs), utils::filter_format::m_format);
+    // The bits now live in _components->row_bloom_filter, see row_bloom_filter_memory_size().
+    // The tag stays, so the metadata still shows the sstable has a row bloom filter.
+    rf->buckets.elements = {};
+}
+
 void sstable::write_filter(const io_priority_class& pc) {
     if (!has_component(component_type::Filter)) {
         return;
     }
 
+    if (auto sbf = dynamic_cast<utils::filter::split_block_bloom_filter*>(_components->filter.get())) {
+        auto filter_ref = sstables::filter_ref(sbf->serialized_hashes(), sbf->bits().get_storage());
+        write_simple<component_type::Filter>(filter_ref, pc);
+        return;
+    }
+
     auto f = static_cast<utils::filter::murmur3_bloom_filter *>(_components->filter.get());
 
     auto&& bs = f->bits();
@@ -1507,6 +1540,7 @@ future<> sstable::load(const io_priority_class& pc) noexcept {
         // read scylla-meta after toc. Might need it to parse
         // rest (hint extensions)
         return read_scylla_metadata(pc).then([this, &pc] {
+            load_row_bloom_filter();
             // Read statistics ahead of others - if summary is missing
             // we'll attempt to re-generate it and we need statistics for that
             return read_statistics(pc).then([this, &pc] {
@@ -1561,6 +1595,40 @@ void prepare_summary(summary& s, uint64_t expected_partition_count, uint32_t min
     s.header.memory_size = 0;
 }
 
+future<> downsample_summary(summary& s, uint32_t sampling_level) {
+    const int current_sampling_level = s.header.sampling_level;
+    const auto start_points = downsampling::get_start_points(current_sampling_level, sampling_level);
+    auto removed = [&] (size_t i) {
+        return std::ranges::any_of(start_points, [&] (int start) {
+            return i >= size_t(start) && (i - start) % current_sampling_level == 0;
+        });
+    };
+
+    // The keys kept are copied, so that the memory of the others is freed.
+    summary ds;
+    ds.header = s.header;
+    ds.header.sampling_level = sampling_level;
+    ds.first_key = std::move(s.first_key);
+    ds.last_key = std::move(s.last_key);
+    for (size_t i = 0; i < s.entries.size(); ++i) {
+        if (!removed(i)) {
+            const auto& e = s.entries[i];
+            ds.entries.push_back({e.token, ds.add_summary_data(e.key), e.position});
+        }
+        co_await coroutine::maybe_yield();
+    }
+
+    ds.header.size = ds.entries.size();
+    ds.header.memory_size = ds.header.size * sizeof(uint32_t);
+    ds.positions.reserve(ds.entries.size());
+    for (const auto& e : ds.entries) {
+        ds.positions.push_back(ds.header.memory_size);
+        ds.header.memory_size += e.key.size() + sizeof(e.position);
+    }
+    co_await ds.build_token_index();
+    s = std::move(ds);
+}
+
 future<> seal_summary(summary& s,
         std::optional<key>&& first_key,
         std::optional<key>&& last_key,
@@ -1583,9 +1651,34 @@ future<> seal_summary(summary& s,
     return do_for_each(s.entries, [&s] (summary_entry& e) {
         s.positions.push_back(s.header.memory_size);
         s.header.memory_size += e.key.size() + sizeof(e.position);
+    }).then([&s] {
+        return s.build_token_index();
     });
 }
 
+future<> summary_ka::build_token_index() {
+    token_index = {};
+    // Small summaries are cheap to binary search as is.
+    static constexpr size_t min_entries = 64;
+    if (entries.size() < min_entries) {
+        co_return;
+    }
+    // Aim for about one entry per bucket, tokens are uniformly distributed.
+    auto bits = std::min<unsigned>(std::bit_width(entries.size() - 1), 32);
+    token_index_shift = 64 - bits;
+    const size_t buckets = size_t(1) << bits;
+    token_index.reserve(buckets + 1);
+    size_t idx = 0;
+    for (size_t b = 0; b < buckets; ++b) {
+        while (idx < entries.size() && token_index_bucket(entries[idx].token) < b) {
+            ++idx;
+        }
+        token_index.push_back(idx);
+        co_await coroutine::maybe_yield();
+    }
+    token_index.push_back(entries.size());
+}
+
 static
 void
 populate_statistics_offsets(sstable_version_types v, statistics& s) {
@@ -1696,7 +1789,7 @@ sstable::read_scylla_metadata(const io_priority_class& pc) noexcept {
 
 void
 sstable::write_scylla_metadata(const io_priority_class& pc, shard_id shard, sstable_enabled_features features, struct run_identifier identifier,
-        std::optional<scylla_metadata::large_data_stats> ld_stats, sstring origin) {
+        std::optional<scylla_metadata::large_data_stats> ld_stats, sstring origin, std::optional<filter> row_bloom_filter) {
     auto&& first_key = get_first_decorated_key();
     auto&& last_key = get_last_decorated_key();
     auto sm = create_sharding_metadata(_schema, first_key, last_key, shard);
@@ -1729,8 +1822,41 @@ sstable::write_scylla_metadata(const io_priority_class& pc, shard_id shard, ssta
     scylla_metadata::scylla_build_id build_id;
     build_id.value = bytes(to_bytes_view(sstring_view(get_build_id())));
     _components->scylla_metadata->data.set<scylla_metadata_type::ScyllaBuildId>(std::move(build_id));
+    if (row_bloom_filter) {
+        _components->scylla_metadata->data.set<scylla_metadata_type::RowBloomFilter>(std::move(*row_bloom_filter));
+    }
 
     write_simple<component_type::Scylla>(*_components->scylla_metadata, pc);
+    // The writer keeps the row bloom filter in _components->row_bloom_filter, don't hold its bits twice.
+    if (auto* rf = _components->scylla_metadata->data.get<scylla_metadata_type::RowBloomFilter, filter>()) {
+        rf->buckets.elements = {};
+    }
+}
+
+utils::hashed_key sstable::make_row_bloom_filter_key(const key& pk, const clustering_key_prefix* ck) {
+    if (!ck) {
+        return utils::make_hashed_key(bytes_view(pk));
+    }
+    // A full clustering key has a non-empty representation, so this can't
+    // be mistaken for the key of the partition itself.
+    auto pk_bytes = bytes_view(pk);
+    auto ck_bytes = ck->representation();
+    bytes b(bytes::initialized_later(), pk_bytes.size() + ck_bytes.size());
+    auto out = std::copy(pk_bytes.begin(), pk_bytes.end(), b.begin());
+    for (auto frag : fragment_range(ck_bytes)) {
+        out = std::copy(frag.begin(), frag.end(), out);
+    }
+    return utils::make_hashed_key(b);
+}
+
+bool sstable::row_bloom_filter_may_contain(const key& pk, const query::clustering_row_ranges& singular_ranges) const {
+    auto& f = _components->row_bloom_filter;
+    if (!f || f->is_present(make_row_bloom_filter_key(pk, nullptr))) {
+        return true;
+    }
+    return std::ranges::any_of(singular_ranges, [&] (const query::clustering_range& r) {
+        return f->is_present(make_row_bloom_filter_key(pk, &r.start()->value()));
+    });
 }
 
 bool sstable::may_contain_rows(const query::clustering_row_ranges& ranges) const {
@@ -2214,6 +2340,25 @@ future<> sstable::create_links_and_mark_for_removal(const sstring& dir, generati
     return create_links_common(dir, generation, true /* mark_for_removal */);
 }
 
+future<> sstable::snapshot(const sstring& dir) const {
+    // The TOC is linked last, once all the other components are linked and
+    // synced, so that a crash can't leave an sstable with a TOC and missing
+    // components in the snapshot, to be restored from it later. Linking the
+    // TOC itself is made durable by the caller syncing the directory.
+    sstlog.trace("snapshot: {} -> {}", get_filename(), dir);
+    auto link = [this, &dir] (const sstring& component) {
+        auto src = sstable::filename(_dir, _schema->ks_name(), _schema->cf_name(), _version, _generation, _format, component);
+        auto dst = sstable::filename(dir, _schema->ks_name(), _schema->cf_name(), _version, _generation, _format, component);
+        return sstable_write_io_check(idempotent_link_file, std::move(src), std::move(dst));
+    };
+    auto comps = all_components();
+    co_await coroutine::parallel_for_each(comps, [&link] (const std::pair<component_type, sstring>& p) {
+        return p.first != component_type::TOC ? link(p.second) : make_ready_future<>();
+    });
+    co_await sstable_write_io_check(sync_directory, dir);
+    co_await link(sstable_version_constants::get_component_map(_version).at(component_type::TOC));
+}
+
 future<> sstable::set_generation(generation_type new_generation) {
     sstlog.debug("Setting generation for {} to generation={}", get_filename(), new_generation);
     return create_links(_dir, new_generation).then([this] {
@@ -2267,6 +2412,102 @@ future<> sstable::move_to_quarantine(bool do_sync_dirs) {
     co_await move_to_new_dir(std::move(new_dir), generation(), do_sync_dirs);
 }
 
+// Reads a multi-partition range of an mx sstable in reverse clustering order,
+// one partition at a time. The partitions of the range are looked up in the
+// index, and each one is read by a reversed single-partition reader, which
+// reads the rows backwards from the data file, so unlike make_reversing_reader()
+// this doesn't need to buffer whole partitions in memory.
+class reversed_multi_partition_reader final : public flat_mutation_reader_v2::impl {
+    shared_sstable _sst;
+    const query::partition_slice& _slice;
+    const io_priority_class& _pc;
+    tracing::trace_state_ptr _trace_state;
+    read_monitor& _monitor;
+    const dht::partition_range* _range;
+    index_reader _index;
+    bool _index_positioned = false;
+    // The range of the partition being read, which _partition_reader refers to.
+    std::optional<dht::partition_range> _partition_range;
+    flat_mutation_reader_v2_opt _partition_reader;
+private:
+    future<> close_partition_reader() noexcept {
+        if (auto rd = std::exchange(_partition_reader, std::nullopt)) {
+            co_await rd->close();
+        }
+    }
+
+    // Opens the reader of the next partition of the range, returns false if there is none.
+    future<bool> open_next_partition() {
+        if (!_index_positioned) {
+            co_await _index.advance_to(dht::ring_position_view::for_range_start(*_range));
+            _index_positioned = true;
+        } else {
+            co_await _index.advance_to_next_partition();
+        }
+        if (_index.eof()) {
+            co_return false;
+        }
+        co_await _index.read_partition_data();
+        auto dk = dht::decorate_key(*_schema, _index.get_partition_key());
+        if (_range->after(dk, dht::ring_position_comparator(*_schema))) {
+            co_return false;
+        }
+        _partition_range = dht::partition_range::make_singular(std::move(dk));
+        _partition_reader = mx::make_reader(_sst, _schema, _permit, *_partition_range, _slice, _pc, _trace_state,
+                streamed_mutation::forwarding::no, mutation_reader::forwarding::no, _monitor);
+        co_return true;
+    }
+public:
+    reversed_multi_partition_reader(shared_sstable sst, schema_ptr schema, reader_permit permit, const dht::partition_range& range,
+            const query::partition_slice& slice, const io_priority_class& pc, tracing::trace_state_ptr trace_state, read_monitor& mon)
+        : impl(std::move(schema), permit)
+        , _sst(std::move(sst))
+        , _slice(slice)
+        , _pc(pc)
+        , _trace_state(std::move(trace_state))
+        , _monitor(mon)
+        , _range(&range)
+        , _index(_sst, std::move(permit), pc, _trace_state,
+                use_caching(global_cache_index_pages && !slice.options.contains(query::partition_slice::option::bypass_cache)))
+    { }
+
+    virtual future<> fill_buffer() override {
+        while (!is_buffer_full() && !is_end_of_stream()) {
+            if (!_partition_reader && !co_await open_next_partition()) {
+                _end_of_stream = true;
+                break;
+            }
+            if (co_await fill_buffer_from(*_partition_reader)) {
+                co_await close_partition_reader();
+            }
+        }
+    }
+
+    virtual future<> next_partition() override {
+        clear_buffer_to_next_partition();
+        if (is_buffer_empty()) {
+            co_await close_partition_reader();
+        }
+    }
+
+    virtual future<> fast_forward_to(const dht::partition_range& pr) override {
+        clear_buffer();
+        _end_of_stream = false;
+        co_await close_partition_reader();
+        _range = &pr;
+        _index_positioned = false;
+    }
+
+    virtual future<> fast_forward_to(position_range) override {
+        return make_exception_future<>(make_backtraced_exception_ptr<std::bad_function_call>());
+    }
+
+    virtual future<> close() noexcept override {
+        co_await close_partition_reader();
+        co_await _index.close();
+    }
+};
+
 flat_mutation_reader_v2
 sstable::make_reader(
         schema_ptr schema,
@@ -2278,27 +2519,25 @@ sstable::make_reader(
         streamed_mutation::forwarding fwd,
         mutation_reader::forwarding fwd_mr,
         read_monitor& mon) {
+    ++permit.stats().sstables_read;
     const auto reversed = slice.is_reversed();
     if (_version >= version_types::mc && (!reversed || range.is_singular())) {
         return mx::make_reader(shared_from_this(), std::move(schema), std::move(permit), range, slice, pc, std::move(trace_state), fwd, fwd_mr, mon);
     }
 
-    // Multi-partition reversed queries are not yet supported natively in the mx reader.
-    // Therefore in this case we use `make_reversing_reader` over the forward reader.
-    // FIXME: remove this workaround eventually.
-    auto max_result_size = permit.max_result_size();
-
     if (_version >= version_types::mc) {
-        // The only mx case falling through here is reversed multi-partition reader
-        auto rd = make_reversing_reader(mx::make_reader(shared_from_this(), schema->make_reversed(), std::move(permit),
-                range, half_reverse_slice(*schema, slice), pc, std::move(trace_state), streamed_mutation::forwarding::no, fwd_mr, mon),
-            max_result_size);
+        // The mx reader reverses single partitions only, reversed
+        // multi-partition reads go partition by partition.
+        auto rd = make_flat_mutation_reader_v2<reversed_multi_partition_reader>(shared_from_this(), std::move(schema), std::move(permit),
+                range, slice, pc, std::move(trace_state), mon);
         if (fwd) {
             rd = make_forwardable(std::move(rd));
         }
         return rd;
     }
 
+    auto max_result_size = permit.max_result_size();
+
     if (reversed) {
         // The kl reader does not support reversed queries at all.
         // Perform a forward query on it, then reverse the result.
@@ -2416,11 +2655,12 @@ component_type sstable::component_from_sstring(version_types v, sstring &s) {
 }
 
 input_stream<char> sstable::data_stream(uint64_t pos, size_t len, const io_priority_class& pc,
-        reader_permit permit, tracing::trace_state_ptr trace_state, lw_shared_ptr<file_input_stream_history> history, raw_stream raw) {
+        reader_permit permit, tracing::trace_state_ptr trace_state, lw_shared_ptr<file_input_stream_history> history,
+        raw_stream raw, sparse_read sparse, sequential_read sequential) {
     file_input_stream_options options;
-    options.buffer_size = sstable_buffer_size;
+    options.buffer_size = sequential ? sstable_buffer_size * 4 : sstable_buffer_size;
     options.io_priority_class = pc;
-    options.read_ahead = 4;
+    options.read_ahead = sparse ? 1 : 4;
     options.dynamic_adjustments = std::move(history);
 
     file f = make_tracked_file(_data_file, std::move(permit));
@@ -3266,8 +3506,16 @@ future<> init_metrics() {
             sm::description("Number of partitions read")),
         sm::make_counter("partition_seeks", [] { return sstables_stats::get_shard_stats().partition_seeks; },
             sm::description("Number of partitions seeked")),
+        sm::make_counter("data_skips", [] { return sstables_stats::get_shard_stats().data_skips; },
+            sm::description("Number of forward skips within the data file made by readers")),
+        sm::make_counter("data_bytes_skipped", [] { return sstables_stats::get_shard_stats().data_bytes_skipped; },
+            sm::description("Number of data file bytes skipped over by readers. Skipped bytes which were already read ahead are wasted I/O.")),
         sm::make_counter("row_reads", [] { return sstables_stats::get_shard_stats().row_reads; },
             sm::description("Number of rows read")),
+        sm::make_counter("rows_filtered", [] { return sstables_stats::get_shard_stats().rows_filtered; },
+            sm::description("Number of rows skipped without being read because their clustering key doesn't satisfy the query's filtering restrictions")),
+        sm::make_counter("cell_values_skipped", [] { return sstables_stats::get_shard_stats().cell_values_skipped; },
+            sm::description("Number of cell values skipped without being read because their column was dropped or isn't selected by the query")),
 
         sm::make_counter("capped_local_deletion_time", [] { return sstables_stats::get_shard_stats().capped_local_deletion_time; },
             sm::description("Was local deletion time capped at maximum allowed value in Statistics")),
@@ -104,6 +104,10 @@ class sstables_manager;
 
 extern size_t summary_byte_cost(double summary_ratio);
 
+// Removes the entries of the summary which aren't part of a summary of the
+// given, lower, sampling level.
+future<> downsample_summary(summary& s, uint32_t sampling_level);
+
 struct sstable_writer_config {
     size_t promoted_index_block_size;
     size_t promoted_index_auto_scale_threshold;
@@ -111,11 +115,17 @@ struct sstable_writer_config {
     bool backup = false;
     bool leave_unsealed = false;
     mutation_fragment_stream_validation_level validation_level;
+    // The fraction of partitions validated at the clustering_key level, when
+    // validation_level is lower.
+    double validation_sampling_ratio = 0;
     std::optional<db::replay_position> replay_position;
     std::optional<int> sstable_level;
     write_monitor* monitor = &default_write_monitor();
     run_id run_identifier = run_id::create_random_id();
     size_t summary_byte_cost;
+    bool split_block_filter = false;
+    // Write a filter on (partition key, clustering key) to the scylla metadata.
+    bool row_bloom_filter = false;
     sstring origin;
 
 private:
@@ -419,6 +429,12 @@ class sstable : public enable_lw_shared_from_this<sstable> {
         return create_links(dir, _generation);
     }
 
+    // Hard-links all the components into a snapshot directory, the TOC
+    // last, after syncing the directory. Unlike create_links(), does not go
+    // through a TemporaryTOC. The caller syncs the directory once all the
+    // sstables of the snapshot are linked.
+    future<> snapshot(const sstring& dir) const;
+
     // Delete the sstable by unlinking all sstable files
     // Ignores all errors.
     future<> unlink() noexcept;
@@ -598,9 +614,11 @@ class sstable : public enable_lw_shared_from_this<sstable> {
 
     future<> read_scylla_metadata(const io_priority_class& pc) noexcept;
     void write_scylla_metadata(const io_priority_class& pc, shard_id shard, sstable_enabled_features features, run_identifier identifier,
-            std::optional<scylla_metadata::large_data_stats> ld_stats, sstring origin);
+            std::optional<scylla_metadata::large_data_stats> ld_stats, sstring origin, std::optional<filter> row_bloom_filter = {});
 
     future<> read_filter(const io_priority_class& pc);
+    // Moves the row bloom filter, if any, out of the scylla metadata.
+    void load_row_bloom_filter();
 
     void write_filter(const io_priority_class& pc);
 
@@ -662,9 +680,22 @@ class sstable : public enable_lw_shared_from_this<sstable> {
     //
     // When created with `raw_stream::yes`, the sstable data file will be
     // streamed as-is, without decompressing (if compressed).
+    //
+    // When created with `sparse_read::yes`, the reader is expected to skip
+    // over most of the range (e.g. driven by the promoted index), so
+    // read-ahead is kept to a single buffer, as anything read beyond it is
+    // likely thrown away by the next skip.
+    //
+    // When created with `sequential_read::yes`, the reader is expected to
+    // read the whole range, bypassing the cache (e.g. an export scan), so
+    // larger buffers are read, to keep the reads of the sstables of a scan
+    // long and sequential.
     using raw_stream = bool_class<class raw_stream_tag>;
+    using sparse_read = bool_class<class sparse_read_tag>;
+    using sequential_read = bool_class<class sequential_read_tag>;
     input_stream<char> data_stream(uint64_t pos, size_t len, const io_priority_class& pc,
-            reader_permit permit, tracing::trace_state_ptr trace_state, lw_shared_ptr<file_input_stream_history> history, raw_stream raw = raw_stream::no);
+            reader_permit permit, tracing::trace_state_ptr trace_state, lw_shared_ptr<file_input_stream_history> history,
+            raw_stream raw = raw_stream::no, sparse_read sparse = sparse_read::no, sequential_read sequential = sequential_read::no);
 
     // Read exactly the specific byte range from the data file (after
     // uncompression, if the file is compressed). This can be used to read
@@ -769,6 +800,26 @@ class sstable : public enable_lw_shared_from_this<sstable> {
 
     static utils::hashed_key make_hashed_key(const schema& s, const partition_key& key);
 
+    // Key of the row bloom filter for the given full clustering row of the partition.
+    // With no clustering key, the partition's key in the row bloom filter, which is
+    // present when the partition has tombstones which may cover any of its rows.
+    static utils::hashed_key make_row_bloom_filter_key(const key& pk, const clustering_key_prefix* ck);
+
+    bool has_row_bloom_filter() const {
+        return bool(_components->row_bloom_filter);
+    }
+
+    // The bits of the row bloom filter are only held here, not in the RowBloomFilter
+    // entry of the scylla metadata, which only keeps the number of hashes.
+    uint64_t row_bloom_filter_memory_size() const {
+        return _components->row_bloom_filter ? _components->row_bloom_filter->memory_size() : 0;
+    }
+
+    // Checks the row bloom filter for the given singular ranges of full clustering keys.
+    // Returning false means the sstable has neither any of these rows, nor any
+    // tombstone of the partition which could cover them.
+    bool row_bloom_filter_may_contain(const key& pk, const query::clustering_row_ranges& singular_ranges) const;
+
     filter_tracker& get_filter_tracker() { return _filter_tracker; }
 
     uint64_t filter_get_false_positive() const {
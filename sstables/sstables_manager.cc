@@ -19,8 +19,9 @@ namespace sstables {
 logging::logger smlogger("sstables_manager");
 
 sstables_manager::sstables_manager(
-    db::large_data_handler& large_data_handler, const db::config& dbcfg, gms::feature_service& feat, cache_tracker& ct, size_t available_memory)
-    : _large_data_handler(large_data_handler), _db_config(dbcfg), _features(feat), _cache_tracker(ct)
+    db::large_data_handler& large_data_handler, const db::config& dbcfg, gms::feature_service& feat, cache_tracker& ct, size_t available_memory,
+    utils::secondary_page_cache* secondary_page_cache)
+    : _large_data_handler(large_data_handler), _db_config(dbcfg), _features(feat), _cache_tracker(ct), _secondary_page_cache(secondary_page_cache)
     , _sstable_metadata_concurrency_sem(
         max_count_sstable_metadata_concurrent_reads,
         max_memory_sstable_metadata_concurrent_reads(available_memory),
@@ -60,7 +61,10 @@ sstable_writer_config sstables_manager::configure_writer(sstring origin) const {
     cfg.validation_level = _db_config.enable_sstable_key_validation()
             ? mutation_fragment_stream_validation_level::clustering_key
             : mutation_fragment_stream_validation_level::token;
+    cfg.validation_sampling_ratio = _db_config.sstable_key_validation_sampling_ratio();
     cfg.summary_byte_cost = summary_byte_cost(_db_config.sstable_summary_ratio());
+    cfg.split_block_filter = _db_config.enable_split_block_bloom_filter();
+    cfg.row_bloom_filter = _db_config.enable_sstable_row_bloom_filter();
 
     cfg.origin = std::move(origin);
 
@@ -35,6 +35,8 @@ class config;
 
 namespace gms { class feature_service; }
 
+namespace utils { class secondary_page_cache; }
+
 namespace sstables {
 
 using schema_ptr = lw_shared_ptr<const schema>;
@@ -67,10 +69,12 @@ class sstables_manager {
     bool _closing = false;
     promise<> _done;
     cache_tracker& _cache_tracker;
+    utils::secondary_page_cache* _secondary_page_cache;
 
     reader_concurrency_semaphore _sstable_metadata_concurrency_sem;
 public:
-    explicit sstables_manager(db::large_data_handler& large_data_handler, const db::config& dbcfg, gms::feature_service& feat, cache_tracker&, size_t available_memory);
+    explicit sstables_manager(db::large_data_handler& large_data_handler, const db::config& dbcfg, gms::feature_service& feat, cache_tracker&, size_t available_memory,
+            utils::secondary_page_cache* secondary_page_cache = nullptr);
     virtual ~sstables_manager();
 
     // Constructs a shared sstable
@@ -86,6 +90,8 @@ class sstables_manager {
     virtual sstable_writer_config configure_writer(sstring origin) const;
     const db::config& config() const { return _db_config; }
     cache_tracker& get_cache_tracker() { return _cache_tracker; }
+    // Null when disabled.
+    utils::secondary_page_cache* get_secondary_page_cache() { return _secondary_page_cache; }
 
     void set_format(sstable_version_types format) noexcept { _format = format; }
     sstables::sstable::version_types get_highest_supported_format() const noexcept { return _format; }
@@ -27,7 +27,11 @@ class sstables_stats {
         uint64_t range_partition_reads = 0;
         uint64_t partition_reads = 0;
         uint64_t partition_seeks = 0;
+        uint64_t data_skips = 0;
+        uint64_t data_bytes_skipped = 0;
         uint64_t row_reads = 0;
+        uint64_t rows_filtered = 0;
+        uint64_t cell_values_skipped = 0;
         uint64_t capped_local_deletion_time = 0;
         uint64_t capped_tombstone_deletion_time = 0;
         uint64_t open_for_reading = 0;
@@ -97,10 +101,23 @@ class sstables_stats {
         ++_stats.partition_seeks;
     }
 
+    inline void on_data_skip(uint64_t bytes) noexcept {
+        ++_stats.data_skips;
+        _stats.data_bytes_skipped += bytes;
+    }
+
+    inline void on_cell_value_skip() noexcept {
+        ++_stats.cell_values_skipped;
+    }
+
     inline void on_row_read() noexcept {
         ++_stats.row_reads;
     }
 
+    inline void on_row_filtered() noexcept {
+        ++_stats.rows_filtered;
+    }
+
     inline void on_capped_local_deletion_time() noexcept {
         ++_stats.capped_local_deletion_time;
     }
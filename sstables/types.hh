@@ -170,6 +170,13 @@ struct summary_ka {
     utils::chunked_vector<uint32_t> positions;   // can be large, so use a deque instead of a vector
     utils::chunked_vector<summary_entry> entries;
 
+    // Not part of the on-disk format. Maps the top bits of a token to the
+    // index of the first entry whose token has these or greater top bits,
+    // so that a lookup only has to binary search a handful of entries
+    // instead of the whole summary. Built by build_token_index().
+    utils::chunked_vector<uint32_t> token_index;
+    unsigned token_index_shift = 0;
+
     disk_string<uint32_t> first_key;
     disk_string<uint32_t> last_key;
 
@@ -189,6 +196,7 @@ struct summary_ka {
      */
     uint64_t memory_footprint() const {
         auto sz = sizeof(summary_entry) * entries.size() + sizeof(uint32_t) * positions.size() + sizeof(*this);
+        sz += sizeof(uint32_t) * token_index.size();
         sz += first_key.value.size() + last_key.value.size();
         for (auto& sd : _summary_data) {
             sz += sd.size();
@@ -200,6 +208,21 @@ struct summary_ka {
         return entries.size();
     }
 
+    // (Re)builds token_index from entries. Must be called after entries are
+    // populated, i.e. after parsing or sealing the summary.
+    future<> build_token_index();
+
+    // Returns the sub-range [first, last) of entries which contains the lower
+    // bound of any ring position with token t. Returns the whole range if t
+    // is not a key token or the token index wasn't built.
+    std::pair<size_t, size_t> token_index_range(const dht::token& t) const noexcept {
+        if (token_index.empty() || t._kind != dht::token::kind::key) {
+            return {0, entries.size()};
+        }
+        auto bucket = token_index_bucket(t);
+        return {token_index[bucket], token_index[bucket + 1]};
+    }
+
     bytes_view add_summary_data(bytes_view data) {
         if (_summary_data.empty() || (_summary_index_pos + data.size() > _buffer_size)) {
             _buffer_size = std::min(_buffer_size << 1, 128u << 10);
@@ -214,6 +237,11 @@ struct summary_ka {
         return ret;
     }
 private:
+    size_t token_index_bucket(const dht::token& t) const noexcept {
+        // Bias the token so that unsigned order matches token order.
+        return (uint64_t(t.raw()) ^ (uint64_t(1) << 63)) >> token_index_shift;
+    }
+
     class summary_data_memory {
         unsigned _size;
         std::unique_ptr<bytes::value_type[]> _data;
@@ -529,6 +557,7 @@ enum class scylla_metadata_type : uint32_t {
     SSTableOrigin = 6,
     ScyllaBuildId = 7,
     ScyllaVersion = 8,
+    RowBloomFilter = 9,
 };
 
 // UUID is used for uniqueness across nodes, such that an imported sstable
@@ -577,7 +606,8 @@ struct scylla_metadata {
             disk_tagged_union_member<scylla_metadata_type, scylla_metadata_type::LargeDataStats, large_data_stats>,
             disk_tagged_union_member<scylla_metadata_type, scylla_metadata_type::SSTableOrigin, sstable_origin>,
             disk_tagged_union_member<scylla_metadata_type, scylla_metadata_type::ScyllaBuildId, scylla_build_id>,
-            disk_tagged_union_member<scylla_metadata_type, scylla_metadata_type::ScyllaVersion, scylla_version>
+            disk_tagged_union_member<scylla_metadata_type, scylla_metadata_type::ScyllaVersion, scylla_version>,
+            disk_tagged_union_member<scylla_metadata_type, scylla_metadata_type::RowBloomFilter, filter>
             > data;
 
     sstable_enabled_features get_features() const {
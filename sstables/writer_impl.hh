@@ -35,7 +35,7 @@ struct sstable_writer::writer_impl {
         , _pc(pc)
         , _cfg(cfg)
         , _collector(_schema, sst.get_filename(), sst.manager().get_local_host_id())
-        , _validator(format("sstable writer {}", _sst.get_filename()), _schema, _cfg.validation_level)
+        , _validator(format("sstable writer {}", _sst.get_filename()), _schema, _cfg.validation_level, _cfg.validation_sampling_ratio)
     {}
 
     virtual void consume_new_partition(const dht::decorated_key& dk) = 0;
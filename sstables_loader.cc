@@ -7,6 +7,7 @@
  */
 
 #include <seastar/core/coroutine.hh>
+#include <seastar/core/loop.hh>
 #include <seastar/coroutine/parallel_for_each.hh>
 #include <seastar/rpc/rpc.hh>
 #include "sstables_loader.hh"
@@ -116,123 +117,147 @@ class send_meta_data {
 
 future<> sstables_loader::load_and_stream(sstring ks_name, sstring cf_name,
         ::table_id table_id, std::vector<sstables::shared_sstable> sstables, bool primary_replica_only) {
-    const auto full_partition_range = dht::partition_range::make_open_ended_both_sides();
-    const auto full_token_range = dht::token_range::make_open_ended_both_sides();
-    auto& table = _db.local().find_column_family(table_id);
-    auto s = table.schema();
-    const auto cf_id = s->id();
-    const auto reason = streaming::stream_reason::repair;
     auto erm = _db.local().find_keyspace(ks_name).get_effective_replication_map();
 
     size_t nr_sst_total = sstables.size();
-    size_t nr_sst_current = 0;
+    std::vector<std::vector<sstables::shared_sstable>> batches;
     while (!sstables.empty()) {
-        auto ops_uuid = streaming::plan_id{utils::make_random_uuid()};
-        auto sst_set = make_lw_shared<sstables::sstable_set>(sstables::make_partitioned_sstable_set(s, false));
+        auto& batch = batches.emplace_back();
         size_t batch_sst_nr = 16;
-        std::vector<sstring> sst_names;
-        std::vector<sstables::shared_sstable> sst_processed;
-        size_t estimated_partitions = 0;
         while (batch_sst_nr-- && !sstables.empty()) {
-            auto sst = sstables.back();
-            estimated_partitions += sst->estimated_keys_for_range(full_token_range);
-            sst_names.push_back(sst->get_filename());
-            sst_set->insert(sst);
-            sst_processed.push_back(sst);
+            batch.push_back(sstables.back());
             sstables.pop_back();
         }
+    }
 
-        llog.info("load_and_stream: started ops_uuid={}, process [{}-{}] out of {} sstables={}",
-                ops_uuid, nr_sst_current, nr_sst_current + sst_processed.size(), nr_sst_total, sst_names);
-
-        auto start_time = std::chrono::steady_clock::now();
-        inet_address_vector_replica_set current_targets;
-        std::unordered_map<gms::inet_address, send_meta_data> metas;
-        size_t num_partitions_processed = 0;
-        size_t num_bytes_read = 0;
-        nr_sst_current += sst_processed.size();
-        auto permit = co_await _db.local().obtain_reader_permit(table, "sstables_loader::load_and_stream()", db::no_timeout);
-        auto reader = mutation_fragment_v1_stream(table.make_streaming_reader(s, std::move(permit), full_partition_range, sst_set));
-        std::exception_ptr eptr;
-        bool failed = false;
+    // Each batch is read by its own reader and streamed with its own set of
+    // sinks, so while one batch waits for the replicas to take its fragments,
+    // the next one can be read from disk. Once one fails, no new batch is
+    // started.
+    size_t nr_sst_current = 0;
+    bool failed = false;
+    co_await max_concurrent_for_each(batches, max_concurrent_batches, [&] (std::vector<sstables::shared_sstable>& batch) -> future<> {
+        if (failed) {
+            co_return;
+        }
+        auto nr_sst_first = std::exchange(nr_sst_current, nr_sst_current + batch.size());
         try {
-            netw::messaging_service& ms = _messaging;
-            while (auto mf = co_await reader()) {
-                bool is_partition_start = mf->is_partition_start();
-                if (is_partition_start) {
-                    ++num_partitions_processed;
-                    auto& start = mf->as_partition_start();
-                    const auto& current_dk = start.key();
+            co_await load_and_stream_batch(ks_name, cf_name, table_id, erm, std::move(batch), nr_sst_first, nr_sst_total, primary_replica_only);
+        } catch (...) {
+            failed = true;
+            throw;
+        }
+    });
+}
 
-                    current_targets = erm->get_natural_endpoints(current_dk.token());
-                    if (primary_replica_only && current_targets.size() > 1) {
-                        current_targets.resize(1);
-                    }
-                    llog.trace("load_and_stream: ops_uuid={}, current_dk={}, current_targets={}", ops_uuid,
-                            current_dk.token(), current_targets);
-                    for (auto& node : current_targets) {
-                        if (!metas.contains(node)) {
-                            auto [sink, source] = co_await ms.make_sink_and_source_for_stream_mutation_fragments(reader.schema()->version(),
-                                    ops_uuid, cf_id, estimated_partitions, reason, netw::messaging_service::msg_addr(node));
-                            llog.debug("load_and_stream: ops_uuid={}, make sink and source for node={}", ops_uuid, node);
-                            metas.emplace(node, send_meta_data(node, std::move(sink), std::move(source)));
-                            metas.at(node).receive();
-                        }
+future<> sstables_loader::load_and_stream_batch(const sstring& ks_name, const sstring& cf_name,
+        ::table_id table_id, locator::effective_replication_map_ptr erm, std::vector<sstables::shared_sstable> sst_processed,
+        size_t nr_sst_current, size_t nr_sst_total, bool primary_replica_only) {
+    const auto full_partition_range = dht::partition_range::make_open_ended_both_sides();
+    const auto full_token_range = dht::token_range::make_open_ended_both_sides();
+    auto& table = _db.local().find_column_family(table_id);
+    auto s = table.schema();
+    const auto cf_id = s->id();
+    const auto reason = streaming::stream_reason::repair;
+
+    auto ops_uuid = streaming::plan_id{utils::make_random_uuid()};
+    auto sst_set = make_lw_shared<sstables::sstable_set>(sstables::make_partitioned_sstable_set(s, false));
+    std::vector<sstring> sst_names;
+    size_t estimated_partitions = 0;
+    for (auto& sst : sst_processed) {
+        estimated_partitions += sst->estimated_keys_for_range(full_token_range);
+        sst_names.push_back(sst->get_filename());
+        sst_set->insert(sst);
+    }
+
+    llog.info("load_and_stream: started ops_uuid={}, process [{}-{}] out of {} sstables={}",
+            ops_uuid, nr_sst_current, nr_sst_current + sst_processed.size(), nr_sst_total, sst_names);
+
+    auto start_time = std::chrono::steady_clock::now();
+    inet_address_vector_replica_set current_targets;
+    std::unordered_map<gms::inet_address, send_meta_data> metas;
+    size_t num_partitions_processed = 0;
+    size_t num_bytes_read = 0;
+    auto permit = co_await _db.local().obtain_reader_permit(table, "sstables_loader::load_and_stream()", db::no_timeout);
+    auto reader = mutation_fragment_v1_stream(table.make_streaming_reader(s, std::move(permit), full_partition_range, sst_set));
+    std::exception_ptr eptr;
+    bool failed = false;
+    try {
+        netw::messaging_service& ms = _messaging;
+        while (auto mf = co_await reader()) {
+            bool is_partition_start = mf->is_partition_start();
+            if (is_partition_start) {
+                ++num_partitions_processed;
+                auto& start = mf->as_partition_start();
+                const auto& current_dk = start.key();
+
+                current_targets = erm->get_natural_endpoints(current_dk.token());
+                if (primary_replica_only && current_targets.size() > 1) {
+                    current_targets.resize(1);
+                }
+                llog.trace("load_and_stream: ops_uuid={}, current_dk={}, current_targets={}", ops_uuid,
+                        current_dk.token(), current_targets);
+                for (auto& node : current_targets) {
+                    if (!metas.contains(node)) {
+                        auto [sink, source] = co_await ms.make_sink_and_source_for_stream_mutation_fragments(reader.schema()->version(),
+                                ops_uuid, cf_id, estimated_partitions, reason, netw::messaging_service::msg_addr(node));
+                        llog.debug("load_and_stream: ops_uuid={}, make sink and source for node={}", ops_uuid, node);
+                        metas.emplace(node, send_meta_data(node, std::move(sink), std::move(source)));
+                        metas.at(node).receive();
                     }
                 }
-                frozen_mutation_fragment fmf = freeze(*s, *mf);
-                num_bytes_read += fmf.representation().size();
-                co_await coroutine::parallel_for_each(current_targets, [&metas, &fmf, is_partition_start] (const gms::inet_address& node) {
-                    return metas.at(node).send(fmf, is_partition_start);
-                });
             }
-        } catch (...) {
-            failed = true;
-            eptr = std::current_exception();
-            llog.warn("load_and_stream: ops_uuid={}, ks={}, table={}, send_phase, err={}",
-                    ops_uuid, ks_name, cf_name, eptr);
+            frozen_mutation_fragment fmf = freeze(*s, *mf);
+            num_bytes_read += fmf.representation().size();
+            co_await coroutine::parallel_for_each(current_targets, [&metas, &fmf, is_partition_start] (const gms::inet_address& node) {
+                return metas.at(node).send(fmf, is_partition_start);
+            });
         }
-        co_await reader.close();
+    } catch (...) {
+        failed = true;
+        eptr = std::current_exception();
+        llog.warn("load_and_stream: ops_uuid={}, ks={}, table={}, send_phase, err={}",
+                ops_uuid, ks_name, cf_name, eptr);
+    }
+    co_await reader.close();
+    try {
+        co_await coroutine::parallel_for_each(metas.begin(), metas.end(), [failed] (std::pair<const gms::inet_address, send_meta_data>& pair) {
+            auto& meta = pair.second;
+            return meta.finish(failed);
+        });
+    } catch (...) {
+        failed = true;
+        eptr = std::current_exception();
+        llog.warn("load_and_stream: ops_uuid={}, ks={}, table={}, finish_phase, err={}",
+                ops_uuid, ks_name, cf_name, eptr);
+    }
+    if (!failed) {
         try {
-            co_await coroutine::parallel_for_each(metas.begin(), metas.end(), [failed] (std::pair<const gms::inet_address, send_meta_data>& pair) {
-                auto& meta = pair.second;
-                return meta.finish(failed);
+            co_await coroutine::parallel_for_each(sst_processed, [&] (sstables::shared_sstable& sst) {
+                llog.debug("load_and_stream: ops_uuid={}, ks={}, table={}, remove sst={}",
+                        ops_uuid, ks_name, cf_name, sst->component_filenames());
+                return sst->unlink();
             });
         } catch (...) {
             failed = true;
             eptr = std::current_exception();
-            llog.warn("load_and_stream: ops_uuid={}, ks={}, table={}, finish_phase, err={}",
+            llog.warn("load_and_stream: ops_uuid={}, ks={}, table={}, del_sst_phase, err={}",
                     ops_uuid, ks_name, cf_name, eptr);
         }
-        if (!failed) {
-            try {
-                co_await coroutine::parallel_for_each(sst_processed, [&] (sstables::shared_sstable& sst) {
-                    llog.debug("load_and_stream: ops_uuid={}, ks={}, table={}, remove sst={}",
-                            ops_uuid, ks_name, cf_name, sst->component_filenames());
-                    return sst->unlink();
-                });
-            } catch (...) {
-                failed = true;
-                eptr = std::current_exception();
-                llog.warn("load_and_stream: ops_uuid={}, ks={}, table={}, del_sst_phase, err={}",
-                        ops_uuid, ks_name, cf_name, eptr);
-            }
-        }
-        auto duration = std::chrono::duration_cast<std::chrono::duration<float>>(std::chrono::steady_clock::now() - start_time).count();
-        for (auto& [node, meta] : metas) {
-            llog.info("load_and_stream: ops_uuid={}, ks={}, table={}, target_node={}, num_partitions_sent={}, num_bytes_sent={}",
-                    ops_uuid, ks_name, cf_name, node, meta.num_partitions_sent(), meta.num_bytes_sent());
-        }
-        auto partition_rate = std::fabs(duration) > FLT_EPSILON ? num_partitions_processed / duration : 0;
-        auto bytes_rate = std::fabs(duration) > FLT_EPSILON ? num_bytes_read / duration / 1024 / 1024 : 0;
-        auto status = failed ? "failed" : "succeeded";
-        llog.info("load_and_stream: finished ops_uuid={}, ks={}, table={}, partitions_processed={} partitions, bytes_processed={} bytes, partitions_per_second={} partitions/s, bytes_per_second={} MiB/s, duration={} s, status={}",
-                ops_uuid, ks_name, cf_name, num_partitions_processed, num_bytes_read, partition_rate, bytes_rate, duration, status);
-        if (failed) {
-            std::rethrow_exception(eptr);
-        }
     }
-    co_return;
+    auto duration = std::chrono::duration_cast<std::chrono::duration<float>>(std::chrono::steady_clock::now() - start_time).count();
+    for (auto& [node, meta] : metas) {
+        llog.info("load_and_stream: ops_uuid={}, ks={}, table={}, target_node={}, num_partitions_sent={}, num_bytes_sent={}",
+                ops_uuid, ks_name, cf_name, node, meta.num_partitions_sent(), meta.num_bytes_sent());
+    }
+    auto partition_rate = std::fabs(duration) > FLT_EPSILON ? num_partitions_processed / duration : 0;
+    auto bytes_rate = std::fabs(duration) > FLT_EPSILON ? num_bytes_read / duration / 1024 / 1024 : 0;
+    auto status = failed ? "failed" : "succeeded";
+    llog.info("load_and_stream: finished ops_uuid={}, ks={}, table={}, partitions_processed={} partitions, bytes_processed={} bytes, partitions_per_second={} partitions/s, bytes_per_second={} MiB/s, duration={} s, status={}",
+            ops_uuid, ks_name, cf_name, num_partitions_processed, num_bytes_read, partition_rate, bytes_rate, duration, status);
+    if (failed) {
+        std::rethrow_exception(eptr);
+    }
 }
 
 // For more details, see the commends on column_family::load_new_sstables
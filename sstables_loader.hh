@@ -11,6 +11,7 @@
 #include <seastar/core/sharded.hh>
 #include "schema_fwd.hh"
 #include "sstables/shared_sstable.hh"
+#include "locator/abstract_replication_strategy.hh"
 
 using namespace seastar;
 
@@ -47,6 +48,13 @@ class sstables_loader : public seastar::peering_sharded_service<sstables_loader>
     future<> load_and_stream(sstring ks_name, sstring cf_name,
             table_id, std::vector<sstables::shared_sstable> sstables,
             bool primary_replica_only);
+    future<> load_and_stream_batch(const sstring& ks_name, const sstring& cf_name,
+            table_id, locator::effective_replication_map_ptr erm,
+            std::vector<sstables::shared_sstable> sstables,
+            size_t nr_sst_current, size_t nr_sst_total, bool primary_replica_only);
+
+    // The number of batches of sstables a shard streams at a time.
+    static constexpr size_t max_concurrent_batches = 2;
 
 public:
     sstables_loader(sharded<replica::database>& db,
@@ -15,6 +15,7 @@
 #include "db/view/view_update_checks.hh"
 #include "sstables/sstables.hh"
 #include "sstables/sstables_manager.hh"
+#include "mutation_writer/size_based_splitting_writer.hh"
 
 namespace streaming {
 
@@ -37,13 +38,21 @@ std::function<future<> (flat_mutation_reader_v2)> make_streaming_consumer(sstrin
             auto make_interposer_consumer = [&cs, offstrategy] (const mutation_source_metadata& ms_meta, reader_consumer_v2 end_consumer) mutable {
                 // postpone data segregation to off-strategy compaction if enabled
                 if (offstrategy) {
+                    // ...but write the stream, which is ordered, as a run of sstables no larger than
+                    // those of the strategy, that reshape can move into a level without rewriting it.
+                    if (auto max_size = cs.max_sstable_size()) {
+                        return reader_consumer_v2([max_size = *max_size, end_consumer = std::move(end_consumer)] (flat_mutation_reader_v2 reader) mutable {
+                            return mutation_writer::segregate_by_size(std::move(reader), max_size, std::move(end_consumer));
+                        });
+                    }
                     return end_consumer;
                 }
                 return cs.make_interposer_consumer(ms_meta, std::move(end_consumer));
             };
 
+            auto run_id = sstables::run_id::create_random_id();
             auto consumer = make_interposer_consumer(metadata,
-                    [cf = std::move(cf), adjusted_estimated_partitions, use_view_update_path, &vug, origin = std::move(origin), offstrategy, reason] (flat_mutation_reader_v2 reader) {
+                    [cf = std::move(cf), adjusted_estimated_partitions, use_view_update_path, &vug, origin = std::move(origin), offstrategy, reason, run_id] (flat_mutation_reader_v2 reader) {
                 sstables::shared_sstable sst;
                 try {
                     sst = use_view_update_path ? cf->make_streaming_staging_sstable() : cf->make_streaming_sstable_for_write();
@@ -54,10 +63,11 @@ std::function<future<> (flat_mutation_reader_v2)> make_streaming_consumer(sstrin
                 }
                 schema_ptr s = reader.schema();
                 auto& pc = service::get_local_streaming_priority();
+                auto cfg = cf->get_sstables_manager().configure_writer(origin);
+                // All the sstables written from the stream are disjoint, and form a run.
+                cfg.run_identifier = run_id;
 
-                return sst->write_components(std::move(reader), adjusted_estimated_partitions, s,
-                                             cf->get_sstables_manager().configure_writer(origin),
-                                             encoding_stats{}, pc).then([sst] {
+                return sst->write_components(std::move(reader), adjusted_estimated_partitions, s, cfg, encoding_stats{}, pc).then([sst] {
                     return sst->open_data();
                 }).then([cf, sst, offstrategy, reason, origin] {
                     if (offstrategy && sstables::repair_origin == origin) {
@@ -19,6 +19,7 @@
 #include "streaming/stream_plan.hh"
 #include <seastar/core/sleep.hh>
 #include <seastar/core/thread.hh>
+#include <seastar/core/loop.hh>
 #include "streaming/stream_state.hh"
 #include "streaming/stream_session_state.hh"
 #include "streaming/stream_exception.hh"
@@ -404,8 +405,10 @@ void stream_session::start_streaming_files() {
     if (!_transfers.empty()) {
         set_state(stream_session_state::STREAMING);
     }
+    // Tables are sent a few at a time, so that a large table doesn't leave
+    // the rest of the bandwidth unused while it's sent alone.
     //FIXME: discarded future.
-    (void)do_for_each(_transfers.begin(), _transfers.end(), [this] (auto& item) {
+    (void)max_concurrent_for_each(_transfers, max_concurrent_transfers, [this] (auto& item) {
         sslog.debug("[Stream #{}] Start to send cf_id={}", this->plan_id(), item.first);
         return item.second.execute();
     }).then([this] {
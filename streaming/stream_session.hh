@@ -138,6 +138,8 @@ class stream_session : public enable_shared_from_this<stream_session> {
     std::vector<stream_request> _requests;
     // streaming tasks are created and managed per ColumnFamily ID
     std::map<table_id, stream_transfer_task> _transfers;
+    // The number of tables of _transfers sent concurrently
+    static constexpr size_t max_concurrent_transfers = 4;
     // data receivers, filled after receiving prepare message
     std::map<table_id, stream_receive_task> _receivers;
     //private final StreamingMetrics metrics;
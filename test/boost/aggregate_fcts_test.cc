@@ -272,3 +272,42 @@ SEASTAR_TEST_CASE(test_minmax_on_set) {
         }
     });
 }
+
+SEASTAR_TEST_CASE(test_approximate_aggregates) {
+    return do_with_cql_env_thread([&] (auto& e) {
+        e.execute_cql("CREATE TABLE test (p int, c int, v int, d double, t text, PRIMARY KEY (p, c))").get();
+
+        auto first_row = [&] (sstring query) {
+            auto msg = e.execute_cql(query).get0();
+            return dynamic_cast<cql_transport::messages::result_message::rows&>(*msg).rs().result_set().rows().front();
+        };
+
+        {
+            auto row = first_row("SELECT approx_count_distinct(v), approx_median(d) FROM test");
+            BOOST_REQUIRE_EQUAL(value_cast<int64_t>(long_type->deserialize(*row[0])), 0);
+            BOOST_REQUIRE(!row[1]);
+        }
+
+        for (int i = 0; i < 1000; ++i) {
+            e.execute_cql(format("INSERT INTO test (p, c, v, d, t) VALUES ({}, {}, {}, {}, '{}')", i % 10, i, i % 300, i, i % 50)).get();
+        }
+
+        {
+            auto row = first_row("SELECT approx_count_distinct(v), approx_count_distinct(t), approx_count_distinct(p) FROM test");
+            BOOST_REQUIRE_CLOSE(double(value_cast<int64_t>(long_type->deserialize(*row[0]))), 300, 5);
+            BOOST_REQUIRE_CLOSE(double(value_cast<int64_t>(long_type->deserialize(*row[1]))), 50, 5);
+            BOOST_REQUIRE_CLOSE(double(value_cast<int64_t>(long_type->deserialize(*row[2]))), 10, 5);
+        }
+        {
+            auto row = first_row("SELECT approx_median(d), approx_percentile_90(c), approx_percentile_99(d) FROM test");
+            BOOST_REQUIRE_CLOSE(value_cast<double>(double_type->deserialize(*row[0])), 500, 2);
+            BOOST_REQUIRE_CLOSE(value_cast<double>(double_type->deserialize(*row[1])), 900, 2);
+            BOOST_REQUIRE_CLOSE(value_cast<double>(double_type->deserialize(*row[2])), 990, 1);
+        }
+        {
+            auto row = first_row("SELECT approx_count_distinct(v), approx_median(c) FROM test WHERE p = 3");
+            BOOST_REQUIRE_CLOSE(double(value_cast<int64_t>(long_type->deserialize(*row[0]))), 30, 5);
+            BOOST_REQUIRE_CLOSE(value_cast<double>(double_type->deserialize(*row[1])), 498, 2);
+        }
+    });
+}
@@ -157,6 +157,33 @@ SEASTAR_TEST_CASE(test_password_authenticator_operations) {
     }, cfg);
 }
 
+SEASTAR_TEST_CASE(test_password_authenticator_remembers_verified_credentials) {
+    auto cfg = make_shared<db::config>();
+    cfg->authenticator(sstring(auth::password_authenticator_name));
+
+    return do_with_cql_env_thread([](cql_test_env& env) {
+        const sstring username("fisk");
+
+        auth::role_config config;
+        config.can_login = true;
+        auth::authentication_options options;
+        options.password = "notter";
+        auth::create_role(env.local_auth_service(), username, config, options).get();
+
+        // The second login is served from the remembered credentials, which
+        // must still tell a wrong password apart.
+        authenticate(env, username, "notter").get();
+        authenticate(env, username, "notter").get();
+        require_throws<exceptions::authentication_exception>(authenticate(env, username, "hejkotte")).get();
+
+        // Changing the password invalidates them.
+        options.password = "hejkotte";
+        auth::alter_role(env.local_auth_service(), username, auth::role_config_update{}, options).get();
+        require_throws<exceptions::authentication_exception>(authenticate(env, username, "notter")).get();
+        authenticate(env, username, "hejkotte").get();
+    }, cfg);
+}
+
 namespace {
 
 /// Asserts that table is protected from alterations that can brick a node.
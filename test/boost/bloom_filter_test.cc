@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2023-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <seastar/testing/test_case.hh>
+#include <seastar/testing/thread_test_case.hh>
+
+#include "test/lib/random_utils.hh"
+#include "test/lib/log.hh"
+
+#include "utils/bloom_filter.hh"
+
+using namespace seastar;
+
+static std::vector<bytes> make_keys(size_t n) {
+    std::vector<bytes> keys;
+    keys.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        keys.push_back(tests::random::get_bytes(16));
+    }
+    return keys;
+}
+
+static double false_positive_rate(utils::i_filter& f, size_t probes) {
+    size_t positives = 0;
+    for (size_t i = 0; i < probes; ++i) {
+        // Longer than the inserted keys, so never one of them.
+        positives += f.is_present(tests::random::get_bytes(20));
+    }
+    return double(positives) / probes;
+}
+
+SEASTAR_THREAD_TEST_CASE(test_split_block_filter_has_no_false_negatives) {
+    auto keys = make_keys(10000);
+    auto f = utils::i_filter::get_split_block_filter(keys.size(), 0.01);
+    for (auto& k : keys) {
+        f->add(k);
+    }
+    for (auto& k : keys) {
+        BOOST_REQUIRE(f->is_present(k));
+        BOOST_REQUIRE(f->is_present(utils::make_hashed_key(k)));
+    }
+}
+
+SEASTAR_THREAD_TEST_CASE(test_split_block_filter_false_positive_rate) {
+    for (auto fp_chance : {0.1, 0.01, 0.001}) {
+        auto keys = make_keys(20000);
+        auto f = utils::i_filter::get_split_block_filter(keys.size(), fp_chance);
+        for (auto& k : keys) {
+            f->add(k);
+        }
+        auto rate = false_positive_rate(*f, 100000);
+        testlog.info("fp_chance={} measured={}", fp_chance, rate);
+        // Allow some slack for randomness.
+        BOOST_REQUIRE_LT(rate, fp_chance * 1.5);
+    }
+}
+
+SEASTAR_THREAD_TEST_CASE(test_split_block_filter_round_trip_through_storage) {
+    auto keys = make_keys(1000);
+    auto f = utils::i_filter::get_split_block_filter(keys.size(), 0.01);
+    for (auto& k : keys) {
+        f->add(k);
+    }
+    auto& sbf = dynamic_cast<utils::filter::split_block_bloom_filter&>(*f);
+    auto& storage = sbf.bits().get_storage();
+    auto copy = utils::chunked_vector<uint64_t>(storage.begin(), storage.end());
+    auto nr_bits = copy.size() * 64;
+    auto loaded = utils::filter::create_filter_from_disk(sbf.serialized_hashes(), large_bitset(nr_bits, std::move(copy)), utils::filter_format::m_format);
+    BOOST_REQUIRE(dynamic_cast<utils::filter::split_block_bloom_filter*>(loaded.get()));
+    for (auto& k : keys) {
+        BOOST_REQUIRE(loaded->is_present(k));
+    }
+
+    // A standard filter is still recognized as such.
+    auto bf = utils::i_filter::get_filter(keys.size(), 0.01, utils::filter_format::m_format);
+    auto& mbf = static_cast<utils::filter::murmur3_bloom_filter&>(*bf);
+    auto& bf_storage = mbf.bits().get_storage();
+    auto bf_copy = utils::chunked_vector<uint64_t>(bf_storage.begin(), bf_storage.end());
+    auto bf_loaded = utils::filter::create_filter_from_disk(mbf.num_hashes(), large_bitset(bf_copy.size() * 64, std::move(bf_copy)), utils::filter_format::m_format);
+    BOOST_REQUIRE(dynamic_cast<utils::filter::murmur3_bloom_filter*>(bf_loaded.get()));
+}
+
+SEASTAR_THREAD_TEST_CASE(test_batched_add_matches_add) {
+    auto keys = make_keys(1000);
+    std::vector<utils::hashed_key> hashed;
+    for (auto& k : keys) {
+        hashed.push_back(utils::make_hashed_key(k));
+    }
+    auto check = [&] (utils::filter_ptr one_by_one, utils::filter_ptr batched, auto get_storage) {
+        for (auto& k : keys) {
+            one_by_one->add(k);
+        }
+        auto batch = std::span<const utils::hashed_key>(hashed);
+        while (!batch.empty()) {
+            auto n = std::min<size_t>(batch.size(), 7);
+            batched->add_hashed(batch.first(n));
+            batch = batch.subspan(n);
+        }
+        auto& a = get_storage(*one_by_one);
+        auto& b = get_storage(*batched);
+        BOOST_REQUIRE(std::equal(a.begin(), a.end(), b.begin(), b.end()));
+    };
+    check(utils::i_filter::get_filter(keys.size(), 0.01, utils::filter_format::m_format),
+          utils::i_filter::get_filter(keys.size(), 0.01, utils::filter_format::m_format),
+          [] (utils::i_filter& f) -> const utils::chunked_vector<uint64_t>& {
+              return static_cast<utils::filter::bloom_filter&>(f).bits().get_storage();
+          });
+    check(utils::i_filter::get_split_block_filter(keys.size(), 0.01),
+          utils::i_filter::get_split_block_filter(keys.size(), 0.01),
+          [] (utils::i_filter& f) -> const utils::chunked_vector<uint64_t>& {
+              return static_cast<utils::filter::split_block_bloom_filter&>(f).bits().get_storage();
+          });
+}
@@ -297,6 +297,51 @@ class garbage_file_impl : public file_impl {
 };
 
 #ifndef SEASTAR_DEFAULT_ALLOCATOR // Eviction works only with the seastar allocator
+SEASTAR_THREAD_TEST_CASE(test_eviction_to_secondary_cache) {
+    auto page = cached_file::page_size;
+    auto file_size = page * 2 + 12;
+    test_file tf = make_test_file(file_size);
+
+    tmpdir cache_dir;
+    utils::secondary_page_cache secondary(cache_dir.path() / "cache", page * 16);
+    auto stop_secondary = defer([&] { secondary.stop().get(); });
+    while (!secondary.ready()) {
+        thread::yield();
+    }
+
+    {
+        cached_file::metrics metrics;
+        logalloc::region region;
+        cached_file cf(tf.f, metrics, cf_lru, region, tf.contents.size(), {}, &secondary);
+
+        BOOST_REQUIRE_EQUAL(tf.contents, read_to_string(cf, 0));
+        BOOST_REQUIRE_EQUAL(3, metrics.page_misses);
+        BOOST_REQUIRE_EQUAL(0, secondary.get_metrics().hits);
+
+        with_allocator(region.allocator(), [] {
+            cf_lru.evict_all();
+        });
+        BOOST_REQUIRE_EQUAL(3, metrics.page_evictions);
+
+        // Evicted pages are written in the background.
+        while (secondary.get_metrics().writes < 3) {
+            thread::yield();
+        }
+
+        BOOST_REQUIRE_EQUAL(tf.contents, read_to_string(cf, 0));
+        BOOST_REQUIRE_EQUAL(6, metrics.page_misses);
+        BOOST_REQUIRE_EQUAL(3, secondary.get_metrics().hits);
+        BOOST_REQUIRE_EQUAL(file_size, secondary.get_metrics().bytes_read);
+
+        // Pages still in the secondary cache are not written again.
+        with_allocator(region.allocator(), [] {
+            cf_lru.evict_all();
+        });
+        BOOST_REQUIRE_EQUAL(3, secondary.get_metrics().writes);
+        BOOST_REQUIRE_EQUAL(0, secondary.get_metrics().dropped_writes);
+    }
+}
+
 SEASTAR_THREAD_TEST_CASE(test_stress_eviction) {
     auto page_size = cached_file::page_size;
     auto n_pages = 8'000'000 / page_size;
@@ -35,3 +35,38 @@ BOOST_AUTO_TEST_CASE(test_caching_options) {
         BOOST_REQUIRE_THROW(caching_options::from_sstring(in_str), std::exception);
     }
 }
+
+BOOST_AUTO_TEST_CASE(test_caching_options_max_share) {
+    using string_map = std::map<sstring, sstring>;
+    {
+        caching_options co = caching_options::from_map({{"keys", "ALL"}, {"rows_per_partition", "ALL"}});
+        BOOST_REQUIRE_EQUAL(co.max_share(), 1);
+        BOOST_REQUIRE(!co.to_map().contains("max_share"));
+    }
+    {
+        string_map in_map = {{"keys", "ALL"}, {"rows_per_partition", "ALL"}, {"max_share", "0.25"}};
+        caching_options co = caching_options::from_map(in_map);
+        BOOST_REQUIRE_EQUAL(co.max_share(), 0.25);
+        BOOST_REQUIRE(co.to_map() == in_map);
+        BOOST_REQUIRE(co != caching_options::from_map({{"keys", "ALL"}, {"rows_per_partition", "ALL"}}));
+    }
+    BOOST_REQUIRE_THROW(caching_options::from_map({{"max_share", "0"}}), std::exception);
+    BOOST_REQUIRE_THROW(caching_options::from_map({{"max_share", "1.5"}}), std::exception);
+    BOOST_REQUIRE_THROW(caching_options::from_map({{"max_share", "half"}}), std::exception);
+}
+
+BOOST_AUTO_TEST_CASE(test_caching_options_coalesce_reads) {
+    using string_map = std::map<sstring, sstring>;
+    {
+        caching_options co = caching_options::from_map({{"keys", "ALL"}, {"rows_per_partition", "ALL"}});
+        BOOST_REQUIRE(!co.coalesce_reads());
+        BOOST_REQUIRE(!co.to_map().contains("coalesce_reads"));
+    }
+    {
+        string_map in_map = {{"keys", "ALL"}, {"rows_per_partition", "ALL"}, {"coalesce_reads", "true"}};
+        caching_options co = caching_options::from_map(in_map);
+        BOOST_REQUIRE(co.coalesce_reads());
+        BOOST_REQUIRE(co.to_map() == in_map);
+        BOOST_REQUIRE(co != caching_options::from_map({{"keys", "ALL"}, {"rows_per_partition", "ALL"}}));
+    }
+}
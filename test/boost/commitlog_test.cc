@@ -35,6 +35,7 @@
 #include "db/commitlog/rp_set.hh"
 #include "db/extensions.hh"
 #include "log.hh"
+#include "schema_builder.hh"
 #include "service/priority_manager.hh"
 #include "test/lib/exception_utils.hh"
 #include "test/lib/cql_test_env.hh"
@@ -716,6 +717,51 @@ SEASTAR_TEST_CASE(test_commitlog_add_entries) {
     });
 }
 
+SEASTAR_TEST_CASE(test_commitlog_compressed_entries) {
+    commitlog::config cfg;
+    cfg.compress_entries = true;
+
+    return cl_test(cfg, [](commitlog& log) {
+        return seastar::async([&] {
+            auto s = schema_builder("ks", "cf")
+                    .with_column("pk", utf8_type, column_kind::partition_key)
+                    .with_column("v", utf8_type)
+                    .build();
+
+            std::vector<frozen_mutation> mutations;
+            std::vector<replay_position> rps;
+            // A compressible one, and one too small to be compressed.
+            for (auto value : {sstring(4096, 'a'), sstring("b")}) {
+                mutation m(s, partition_key::from_single_value(*s, to_bytes("key")));
+                m.set_clustered_cell(clustering_key::make_empty(), "v", data_value(value), api::new_timestamp());
+                mutations.emplace_back(freeze(m));
+                commitlog_entry_writer cew(s, mutations.back(), db::commitlog::force_sync::no);
+                rps.emplace_back(log.add_entry(s->id(), cew, db::no_timeout).get0().release());
+            }
+            log.sync_all_segments().get();
+
+            auto segments = log.get_active_segment_names();
+            BOOST_REQUIRE(!segments.empty());
+
+            size_t read = 0;
+            for (auto& seg : segments) {
+                BOOST_REQUIRE_EQUAL(commitlog::descriptor(seg).ver, commitlog::descriptor::segment_version_3);
+                db::commitlog::read_log_file(seg, db::commitlog::descriptor::FILENAME_PREFIX, service::get_local_commitlog_priority(), [&](db::commitlog::buffer_and_replay_position buf_rp) {
+                    auto i = std::find(rps.begin(), rps.end(), buf_rp.position);
+                    BOOST_REQUIRE(i != rps.end());
+                    commitlog_entry_reader r(buf_rp.buffer);
+                    BOOST_CHECK_EQUAL(mutations.at(std::distance(rps.begin(), i)).unfreeze(s), r.mutation().unfreeze(s));
+                    ++read;
+                    return make_ready_future<>();
+                }).get();
+            }
+            BOOST_REQUIRE_EQUAL(read, rps.size());
+            // The compressible entry took less space than its value.
+            BOOST_REQUIRE_LT(rps[1].pos - rps[0].pos, 4096);
+        });
+    });
+}
+
 SEASTAR_TEST_CASE(test_commitlog_new_segment_odsync){
     commitlog::config cfg;
     cfg.commitlog_segment_size_in_mb = 1;
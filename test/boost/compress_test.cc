@@ -6,11 +6,12 @@
  * SPDX-License-Identifier: AGPL-3.0-or-later
  */
 
-#define BOOST_TEST_MODULE core
-
 #include <boost/test/unit_test.hpp>
 
+#include <seastar/testing/thread_test_case.hh>
+
 #include "sstables/compress.hh"
+#include "compress.hh"
 
 BOOST_AUTO_TEST_CASE(segmented_offsets_basic_functionality) {
     sstables::compression::segmented_offsets offsets;
@@ -143,3 +144,53 @@ BOOST_AUTO_TEST_CASE(segmented_offsets_corner_cases) {
     BOOST_REQUIRE(accessor.at(4079) == 4079);
     BOOST_REQUIRE(accessor.at(4080) == 4080);
 }
+
+SEASTAR_THREAD_TEST_CASE(zstd_dictionary_training_round_trip) {
+    auto c = compressor::create({
+        {compression_parameters::SSTABLE_COMPRESSION, "ZstdCompressor"},
+        {"dictionary_size_kb", "4"},
+    });
+    BOOST_REQUIRE(c);
+    BOOST_REQUIRE_GT(c->dictionary_training_size(), 0);
+
+    // Small, repetitive rows, which is what the dictionary is for.
+    auto make_chunk = [] (int seed) {
+        sstring data;
+        for (int i = 0; data.size() < 4096; ++i) {
+            data += format("{{\"id\": {}, \"name\": \"user-{}\", \"status\": \"active\", \"score\": {}}}", seed * 1000 + i, i * 7, i % 13);
+        }
+        data.resize(4096);
+        return temporary_buffer<char>(data.data(), data.size());
+    };
+    std::vector<temporary_buffer<char>> samples;
+    size_t size = 0;
+    for (int i = 0; size < c->dictionary_training_size(); ++i) {
+        samples.push_back(make_chunk(i));
+        size += samples.back().size();
+    }
+
+    // Training doesn't run on the reactor, its result is only delivered
+    // once the reactor polls for it.
+    auto training = c->train_dictionary(samples);
+    BOOST_REQUIRE(!training.available());
+    auto trained = training.get();
+    BOOST_REQUIRE(trained);
+    BOOST_REQUIRE_EQUAL(trained->dictionary_training_size(), 0);
+    auto opts = trained->options();
+    BOOST_REQUIRE(opts.contains("dictionary"));
+
+    // Recreate the compressor from its options, like a reader does from CompressionInfo.
+    opts.emplace(compression_parameters::SSTABLE_COMPRESSION, "ZstdCompressor");
+    auto reader = compressor::create(opts);
+
+    auto input = make_chunk(12345);
+    std::vector<char> compressed(trained->compress_max_size(input.size()));
+    auto len = trained->compress(input.get(), input.size(), compressed.data(), compressed.size());
+    std::vector<char> output(input.size());
+    auto out_len = reader->uncompress(compressed.data(), len, output.data(), output.size());
+    BOOST_REQUIRE_EQUAL(out_len, input.size());
+    BOOST_REQUIRE(std::equal(output.begin(), output.end(), input.begin()));
+
+    // An untrained compressor has nothing to train on.
+    BOOST_REQUIRE(!c->train_dictionary({}).get());
+}
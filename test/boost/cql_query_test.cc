@@ -26,6 +26,7 @@
 #include <seastar/core/future-util.hh>
 #include <seastar/core/sleep.hh>
 #include "transport/messages/result_message.hh"
+#include "sstables/stats.hh"
 #include "utils/big_decimal.hh"
 #include "types/user.hh"
 #include "types/map.hh"
@@ -33,6 +34,7 @@
 #include "types/set.hh"
 #include "db/config.hh"
 #include "cql3/cql_config.hh"
+#include "cql3/prepared_statements_cache.hh"
 #include "compaction/compaction_manager.hh"
 #include "test/lib/exception_utils.hh"
 #include "utils/rjson.hh"
@@ -2522,6 +2524,28 @@ APPLY BATCH;)"
     });
 }
 
+SEASTAR_TEST_CASE(test_batch_merges_mutations_of_partition) {
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        e.execute_cql("create table cf (p1 int, c1 int, r1 int, PRIMARY KEY (p1, c1));").get();
+        auto& stats = e.local_qp().get_cql_stats();
+        const auto mutations = stats.mutations_in_batches;
+        const auto partitions = stats.partitions_in_batches;
+        e.execute_cql(R"(BEGIN UNLOGGED BATCH
+insert into cf (p1, c1, r1) values (1, 1, 100);
+insert into cf (p1, c1, r1) values (1, 2, 200);
+update cf set r1 = 300 where p1 = 1 and c1 = 3;
+insert into cf (p1, c1, r1) values (2, 1, 400);
+APPLY BATCH;)").get();
+        BOOST_REQUIRE_EQUAL(stats.mutations_in_batches - mutations, 4);
+        BOOST_REQUIRE_EQUAL(stats.partitions_in_batches - partitions, 2);
+        assert_that(e.execute_cql("select c1, r1 from cf where p1 = 1").get0()).is_rows().with_rows({
+            {int32_type->decompose(1), int32_type->decompose(100)},
+            {int32_type->decompose(2), int32_type->decompose(200)},
+            {int32_type->decompose(3), int32_type->decompose(300)},
+        });
+    });
+}
+
 SEASTAR_TEST_CASE(test_in_restriction) {
     return do_with_cql_env_thread([] (cql_test_env& e) {
         e.execute_cql("create table tir (p1 int, c1 int, r1 int, PRIMARY KEY (p1, c1));").get();
@@ -5003,6 +5027,41 @@ SEASTAR_TEST_CASE(test_counter_column_added_into_non_counter_table) {
     });
 }
 
+static future<> test_coalesced_counter_updates(shared_ptr<db::config> db_config) {
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        cquery_nofail(e, "CREATE TABLE t (pk int, ck int, c counter, PRIMARY KEY(pk, ck))");
+
+        // Updates to the same partition, of the same and of different rows,
+        // all arriving within the window of the first one.
+        std::vector<future<>> updates;
+        for (int i = 0; i < 10; ++i) {
+            updates.push_back(e.execute_cql(format("UPDATE t SET c = c + {} WHERE pk = 0 AND ck = {}", i, i % 2)).discard_result());
+        }
+        when_all_succeed(updates.begin(), updates.end()).get();
+        require_rows(e, "SELECT ck, c FROM t WHERE pk = 0", {
+            {int32_type->decompose(0), long_type->decompose(int64_t(0 + 2 + 4 + 6 + 8))},
+            {int32_type->decompose(1), long_type->decompose(int64_t(1 + 3 + 5 + 7 + 9))},
+        });
+
+        // And the counter shards they were turned into add up with the
+        // ones of later updates.
+        cquery_nofail(e, "UPDATE t SET c = c + 100 WHERE pk = 0 AND ck = 0");
+        require_rows(e, "SELECT c FROM t WHERE pk = 0 AND ck = 0", {{long_type->decompose(int64_t(120))}});
+    }, cql_test_config(db_config));
+}
+
+SEASTAR_TEST_CASE(test_coalesced_counter_updates_on_leader) {
+    auto db_config = make_shared<db::config>();
+    db_config->counter_update_coalescing_window_in_us(100000);
+    return test_coalesced_counter_updates(std::move(db_config));
+}
+
+SEASTAR_TEST_CASE(test_coalesced_counter_updates_on_coordinator) {
+    auto db_config = make_shared<db::config>();
+    db_config->coordinator_counter_update_coalescing_window_in_us(100000);
+    return test_coalesced_counter_updates(std::move(db_config));
+}
+
 SEASTAR_THREAD_TEST_CASE(test_invalid_using_timestamps) {
     do_with_cql_env_thread([] (cql_test_env& e) {
         auto now_nano = std::chrono::duration_cast<std::chrono::nanoseconds>(db_clock::now().time_since_epoch()).count();
@@ -5331,7 +5390,64 @@ SEASTAR_TEST_CASE(test_parallelized_select_sum_group_by) {
             {int32_type->decompose(int32_t(0)), int32_type->decompose(int32_t((value_count - 1) * value_count / 2))}
         });
 
-        BOOST_CHECK_EQUAL(stat_parallelized, qp.get_cql_stats().select_parallelized);
+        BOOST_CHECK_EQUAL(stat_parallelized + 1, qp.get_cql_stats().select_parallelized);
+
+        // Groups which span clustering rows are not parallelized.
+        msg = e.execute_cql("SELECT k, c, SUM(v) FROM tbl GROUP BY k, c;").get();
+        assert_that(msg).is_rows().with_size(2 * value_count);
+
+        BOOST_CHECK_EQUAL(stat_parallelized + 1, qp.get_cql_stats().select_parallelized);
+    });
+}
+
+SEASTAR_TEST_CASE(test_parallelized_select_group_by_paging) {
+    return do_with_cql_env_thread([](cql_test_env& e) {
+        auto& qp = e.local_qp();
+        auto stat_parallelized = qp.get_cql_stats().select_parallelized;
+
+        e.execute_cql("CREATE TABLE tbl (k int, c int, v int, PRIMARY KEY (k, c));").get();
+        const int partitions = 10;
+        const int rows = 5;
+        std::vector<std::vector<bytes_opt>> expected_rows;
+        for (int k = 0; k < partitions; k++) {
+            for (int c = 0; c < rows; c++) {
+                e.execute_cql(format("INSERT INTO tbl (k, c, v) VALUES ({:d}, {:d}, {:d});", k, c, k * c)).get();
+            }
+            expected_rows.push_back({int32_type->decompose(k), long_type->decompose(int64_t(rows)), int32_type->decompose(k * (rows - 1))});
+        }
+
+        auto fetch_all = [&] (const sstring& query, int32_t page_size) {
+            std::vector<std::vector<bytes_opt>> fetched;
+            lw_shared_ptr<service::pager::paging_state> paging_state;
+            bool more = true;
+            while (more) {
+                auto qo = std::make_unique<cql3::query_options>(db::consistency_level::LOCAL_ONE, std::vector<cql3::raw_value>{},
+                        cql3::query_options::specific_options{page_size, paging_state, {}, api::new_timestamp()});
+                auto result = e.execute_cql(query, std::move(qo)).get0();
+                auto rows = dynamic_pointer_cast<cql_transport::messages::result_message::rows>(result);
+                BOOST_REQUIRE(rows);
+                BOOST_REQUIRE_LE(rows->rs().result_set().size(), size_t(page_size));
+                for (auto& row : rows->rs().result_set().rows()) {
+                    fetched.push_back(row);
+                }
+                more = has_more_pages(result);
+                paging_state = extract_paging_state(result);
+                BOOST_REQUIRE(!more || paging_state);
+            }
+            std::sort(fetched.begin(), fetched.end(), [] (const std::vector<bytes_opt>& a, const std::vector<bytes_opt>& b) {
+                return value_cast<int32_t>(int32_type->deserialize(*a[0])) < value_cast<int32_t>(int32_type->deserialize(*b[0]));
+            });
+            return fetched;
+        };
+
+        auto fetched = fetch_all("SELECT k, COUNT(*), MAX(v) FROM tbl GROUP BY k;", 3);
+        BOOST_REQUIRE_EQUAL(fetched.size(), expected_rows.size());
+        BOOST_REQUIRE(fetched == expected_rows);
+        BOOST_CHECK_LT(stat_parallelized, qp.get_cql_stats().select_parallelized);
+
+        // The limit counts groups.
+        fetched = fetch_all("SELECT k, COUNT(*), MAX(v) FROM tbl GROUP BY k LIMIT 4;", 3);
+        BOOST_REQUIRE_EQUAL(fetched.size(), 4);
     });
 }
 
@@ -5430,6 +5546,34 @@ SEASTAR_TEST_CASE(test_not_parallelized_select_uda) {
     });
 }
 
+SEASTAR_TEST_CASE(test_uda_folds_inputs_in_order) {
+    return with_udf_enabled([](cql_test_env& e) {
+        // Not commutative, so folding the inputs out of order, or twice,
+        // changes the result.
+        e.execute_cql("CREATE FUNCTION row_fct(acc bigint, val int) "
+                        "RETURNS NULL ON NULL INPUT "
+                        "RETURNS bigint "
+                        "LANGUAGE lua "
+                        "AS $$ "
+                        "return (acc * 3 + val) % 1000000007 "
+                        "$$;").get0();
+        e.execute_cql("CREATE AGGREGATE aggr(int) "
+                        "SFUNC row_fct "
+                        "STYPE bigint "
+                        "INITCOND 1;").get0();
+        e.execute_cql("CREATE TABLE tbl (p int, c int, PRIMARY KEY (p, c));").get();
+        // More rows than the aggregate buffers before calling the function.
+        int value_count = 300;
+        int64_t expected = 1;
+        for (int i = 0; i < value_count; i++) {
+            e.execute_cql(format("INSERT INTO tbl (p, c) VALUES (0, {:d});", i)).get();
+            expected = (expected * 3 + i) % 1000000007;
+        }
+        auto msg = e.execute_cql("SELECT aggr(c) FROM tbl WHERE p = 0;").get();
+        assert_that(msg).is_rows().with_rows({{long_type->decompose(expected)}});
+    });
+}
+
 cql3::raw_value make_collection_raw_value(size_t size_to_write, const std::vector<cql3::raw_value>& elements_to_write) {
     cql_serialization_format sf = cql_serialization_format::latest();
 
@@ -5717,3 +5861,73 @@ SEASTAR_TEST_CASE(test_setting_synchronous_updates_property) {
         );
     });
 }
+
+SEASTAR_TEST_CASE(test_omitted_unselected_cell_values_keep_rows_alive) {
+    return do_with_cql_env_thread([](cql_test_env& e) {
+        e.execute_cql("CREATE TABLE t (p int, c int, a int, b int, s int static, PRIMARY KEY (p, c))").get();
+        e.execute_cql("INSERT INTO t (p, c, a, b) VALUES (0, 0, 1, 1)").get();
+        // Rows without a marker, alive through the unselected column only.
+        e.execute_cql("UPDATE t SET b = 2 WHERE p = 0 AND c = 1").get();
+        e.execute_cql("UPDATE t SET b = 3 WHERE p = 0 AND c = 2").get();
+        e.execute_cql("UPDATE t SET s = 5 WHERE p = 0").get();
+        e.db().invoke_on_all([] (replica::database& db) { return db.flush_all_memtables(); }).get();
+        // Deletes the only cell of the row, from another source.
+        e.execute_cql("DELETE b FROM t WHERE p = 0 AND c = 2").get();
+
+        auto values_skipped = [] {
+            return smp::map_reduce0([] { return sstables::sstables_stats::get_shard_stats().cell_values_skipped; }, uint64_t(0), std::plus<uint64_t>()).get0();
+        };
+        auto skipped_before = values_skipped();
+
+        for (auto bypass_cache : {"", " BYPASS CACHE"}) {
+            for (auto where : {" WHERE p = 0", ""}) {
+                auto msg = e.execute_cql(format("SELECT c, a FROM t{}{}", where, bypass_cache)).get0();
+                assert_that(msg).is_rows().with_rows({
+                    {int32_type->decompose(0), int32_type->decompose(1)},
+                    {int32_type->decompose(1), std::nullopt},
+                });
+
+                msg = e.execute_cql(format("SELECT COUNT(*) FROM t{}{}", where, bypass_cache)).get0();
+                assert_that(msg).is_rows().with_rows({{long_type->decompose(int64_t(2))}});
+            }
+        }
+
+        BOOST_REQUIRE_GT(values_skipped(), skipped_before);
+    });
+}
+
+SEASTAR_TEST_CASE(test_unprepared_statement_cache) {
+    auto db_config = make_shared<db::config>();
+    return do_with_cql_env_thread([db_config] (cql_test_env& e) {
+        e.execute_cql("CREATE TABLE t (p int PRIMARY KEY, v int)").get();
+        e.execute_cql("INSERT INTO t (p, v) VALUES (1, 1)").get();
+
+        auto& stats = cql3::unprepared_statements_cache::shard_stats();
+        auto hits = stats.hits;
+        assert_that(e.execute_cql("SELECT * FROM t WHERE p = 1").get0()).is_rows().with_rows({
+            {int32_type->decompose(1), int32_type->decompose(1)},
+        });
+        assert_that(e.execute_cql("SELECT * FROM t WHERE p = 1").get0()).is_rows().with_rows({
+            {int32_type->decompose(1), int32_type->decompose(1)},
+        });
+        BOOST_REQUIRE_EQUAL(stats.hits, hits + 1);
+
+        // Altering the table drops the statements which use it.
+        e.execute_cql("ALTER TABLE t ADD w int").get();
+        e.execute_cql("INSERT INTO t (p, v, w) VALUES (1, 1, 2)").get();
+        assert_that(e.execute_cql("SELECT * FROM t WHERE p = 1").get0()).is_rows().with_rows({
+            {int32_type->decompose(1), int32_type->decompose(1), int32_type->decompose(2)},
+        });
+
+        // Schema statements aren't cached.
+        hits = stats.hits;
+        e.execute_cql("CREATE TABLE IF NOT EXISTS t (p int PRIMARY KEY)").get();
+        e.execute_cql("CREATE TABLE IF NOT EXISTS t (p int PRIMARY KEY)").get();
+        BOOST_REQUIRE_EQUAL(stats.hits, hits);
+
+        db_config->enable_unprepared_statement_cache.set(false);
+        hits = stats.hits;
+        e.execute_cql("SELECT * FROM t WHERE p = 1").get();
+        BOOST_REQUIRE_EQUAL(stats.hits, hits);
+    }, cql_test_config(db_config));
+}
@@ -829,6 +829,42 @@ SEASTAR_TEST_CASE(toppartitions_cross_shard_schema_ptr) {
     });
 }
 
+SEASTAR_THREAD_TEST_CASE(continuous_toppartitions) {
+    auto db_cfg_ptr = make_shared<db::config>();
+    db_cfg_ptr->continuous_toppartitions_capacity(100, db::config::config_source::CommandLine);
+    do_with_cql_env_thread([] (cql_test_env& e) {
+        e.execute_cql("CREATE TABLE ks.tab (id int PRIMARY KEY)").get();
+        auto q = e.prepare("INSERT INTO ks.tab(id) VALUES(?)").get0();
+        for (auto i = 0; i != 10; ++i) {
+            e.execute_prepared(q, {cql3::raw_value::make_value(int32_type->decompose(0))}).get();
+        }
+        e.execute_prepared(q, {cql3::raw_value::make_value(int32_type->decompose(1))}).get();
+
+        auto res = db::toppartitions_query::gather_continuous(e.db()).get0();
+        // Writes to system tables are tracked too.
+        std::vector<unsigned> tab_counts;
+        for (auto& c : res.write.top(100)) {
+            if (c.item.schema->cf_name() == "tab") {
+                tab_counts.push_back(c.count);
+            }
+        }
+        BOOST_REQUIRE(tab_counts == std::vector<unsigned>({10, 1}));
+
+        e.db().invoke_on_all([] (replica::database& db) {
+            db.reset_continuous_toppartitions();
+        }).get();
+        e.execute_prepared(q, {cql3::raw_value::make_value(int32_type->decompose(1))}).get();
+        res = db::toppartitions_query::gather_continuous(e.db()).get0();
+        tab_counts.clear();
+        for (auto& c : res.write.top(100)) {
+            if (c.item.schema->cf_name() == "tab") {
+                tab_counts.push_back(c.count);
+            }
+        }
+        BOOST_REQUIRE(tab_counts == std::vector<unsigned>({1}));
+    }, db_cfg_ptr).get();
+}
+
 SEASTAR_THREAD_TEST_CASE(read_max_size) {
     do_with_cql_env_thread([] (cql_test_env& e) {
         e.execute_cql("CREATE TABLE test (pk text, ck int, v text, PRIMARY KEY (pk, ck));").get();
@@ -10,6 +10,7 @@
 #include <boost/test/unit_test.hpp>
 #include <utility>
 #include "cql3/expr/expression.hh"
+#include "cql3/expr/compiled_restriction.hh"
 #include "utils/overloaded_functor.hh"
 #include <cassert>
 #include "cql3/query_options.hh"
@@ -376,3 +377,24 @@ BOOST_AUTO_TEST_CASE(boolean_factors_test) {
         )
     );
 }
+
+BOOST_AUTO_TEST_CASE(compiled_restriction_fixed_width_keys_order_like_values) {
+    auto check_order = [] (std::vector<data_value> ascending, uint8_t width, bool is_signed) {
+        std::optional<uint64_t> prev;
+        for (const auto& v : ascending) {
+            auto key = compiled_restriction::fixed_width_key(managed_bytes(v.serialize_nonnull()), width, is_signed);
+            BOOST_REQUIRE(key);
+            if (prev) {
+                BOOST_REQUIRE_LT(*prev, *key);
+            }
+            prev = key;
+        }
+        // Empty values have no key.
+        BOOST_REQUIRE(!compiled_restriction::fixed_width_key(managed_bytes(), width, is_signed));
+    };
+    check_order({std::numeric_limits<int32_t>::min(), -1, 0, 1, std::numeric_limits<int32_t>::max()}, 4, true);
+    check_order({std::numeric_limits<int64_t>::min(), int64_t(-1), int64_t(0), int64_t(1) << 40, std::numeric_limits<int64_t>::max()}, 8, true);
+    check_order({int16_t(-300), int16_t(-1), int16_t(0), int16_t(300)}, 2, true);
+    check_order({data_value(simple_date_native_type{0}), data_value(simple_date_native_type{1u << 31}),
+            data_value(simple_date_native_type{std::numeric_limits<uint32_t>::max()})}, 4, false);
+}
@@ -22,6 +22,7 @@
 #include <seastar/core/future-util.hh>
 #include <seastar/core/sleep.hh>
 #include "transport/messages/result_message.hh"
+#include "sstables/stats.hh"
 #include "utils/big_decimal.hh"
 #include "types/list.hh"
 #include "types/set.hh"
@@ -1153,3 +1154,67 @@ SEASTAR_TEST_CASE(test_filtering) {
 
     });
 }
+
+SEASTAR_TEST_CASE(test_filtering_on_clustering_key_in_sstables) {
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        e.execute_cql("CREATE TABLE t (p int, c1 int, c2 int, v int, PRIMARY KEY(p, c1, c2));").get();
+        for (int c1 = 0; c1 < 4; ++c1) {
+            for (int c2 = 0; c2 < 4; ++c2) {
+                e.execute_cql(format("INSERT INTO t(p, c1, c2, v) VALUES (0, {}, {}, {})", c1, c2, c1 * 4 + c2)).get();
+            }
+        }
+        e.db().invoke_on_all([] (replica::database& db) { return db.flush_all_memtables(); }).get();
+        // A newer version of a row dropped by the sstables, in the memtable.
+        e.execute_cql("UPDATE t SET v = 100 WHERE p = 0 AND c1 = 0 AND c2 = 0").get();
+
+        auto rows_filtered = [] {
+            return smp::map_reduce0([] { return sstables::sstables_stats::get_shard_stats().rows_filtered; }, uint64_t(0), std::plus<uint64_t>()).get0();
+        };
+        auto filtered_before = rows_filtered();
+
+        for (auto bypass_cache : {"", " BYPASS CACHE"}) {
+            auto msg = e.execute_cql(format("SELECT v FROM t WHERE c2 = 1 ALLOW FILTERING{}", bypass_cache)).get0();
+            assert_that(msg).is_rows().with_rows({{int32_type->decompose(1)}, {int32_type->decompose(5)}, {int32_type->decompose(9)}, {int32_type->decompose(13)}});
+
+            msg = e.execute_cql(format("SELECT v FROM t WHERE c2 IN (0, 3) AND c1 < 2 ALLOW FILTERING{}", bypass_cache)).get0();
+            assert_that(msg).is_rows().with_rows({{int32_type->decompose(100)}, {int32_type->decompose(3)}, {int32_type->decompose(4)}, {int32_type->decompose(7)}});
+
+            msg = e.execute_cql(format("SELECT v FROM t WHERE c2 > 1 AND c2 <= 2 AND v > 5 ALLOW FILTERING{}", bypass_cache)).get0();
+            assert_that(msg).is_rows().with_rows({{int32_type->decompose(6)}, {int32_type->decompose(10)}, {int32_type->decompose(14)}});
+        }
+
+        // Only the reads which bypass the cache drop rows in the sstable reader.
+        BOOST_REQUIRE_GT(rows_filtered(), filtered_before);
+    });
+}
+
+SEASTAR_TEST_CASE(test_filtering_prepared_with_bind_variables) {
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        e.execute_cql("CREATE TABLE t (p int, c int, s text static, v varint, PRIMARY KEY (p, c)) WITH CLUSTERING ORDER BY (c DESC);").get();
+        for (int p = 0; p < 2; ++p) {
+            e.execute_cql(format("INSERT INTO t (p, s) VALUES ({}, '{}')", p, p ? "b" : "a")).get();
+            for (int c = 0; c < 4; ++c) {
+                e.execute_cql(format("INSERT INTO t (p, c, v) VALUES ({}, {}, {})", p, c, c)).get();
+            }
+        }
+
+        // The restrictions are compiled once for every execution, with the values bound to it.
+        auto id = e.prepare("SELECT p, c FROM t WHERE c >= ? AND s IN (?, ?) AND v < ? ALLOW FILTERING").get0();
+        auto execute = [&] (int c, sstring s1, sstring s2, int v) {
+            return e.execute_prepared(id, {
+                cql3::raw_value::make_value(int32_type->decompose(c)),
+                cql3::raw_value::make_value(utf8_type->decompose(s1)),
+                cql3::raw_value::make_value(utf8_type->decompose(s2)),
+                cql3::raw_value::make_value(varint_type->from_string(format("{}", v))),
+            }).get0();
+        };
+        assert_that(execute(1, "b", "x", 3)).is_rows().with_rows_ignore_order({
+            {int32_type->decompose(1), int32_type->decompose(2)},
+            {int32_type->decompose(1), int32_type->decompose(1)},
+        });
+        assert_that(execute(0, "x", "a", 1)).is_rows().with_rows({
+            {int32_type->decompose(0), int32_type->decompose(0)},
+        });
+        assert_that(execute(2, "c", "d", 4)).is_rows().is_empty();
+    });
+}
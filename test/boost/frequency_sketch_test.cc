@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2022-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#define BOOST_TEST_MODULE core
+
+#include <boost/test/unit_test.hpp>
+#include "utils/frequency_sketch.hh"
+
+BOOST_AUTO_TEST_CASE(test_estimates_follow_accesses) {
+    utils::frequency_sketch sketch(1024);
+
+    BOOST_REQUIRE_EQUAL(sketch.estimate(1), 0);
+
+    // The first access only goes to the doorkeeper.
+    sketch.record(1);
+    BOOST_REQUIRE_EQUAL(sketch.estimate(1), 1);
+
+    for (unsigned i = 0; i < 5; ++i) {
+        sketch.record(1);
+    }
+    BOOST_REQUIRE_GE(sketch.estimate(1), 6);
+
+    // Counters saturate.
+    for (unsigned i = 0; i < 100; ++i) {
+        sketch.record(1);
+    }
+    BOOST_REQUIRE_EQUAL(sketch.estimate(1), 16);
+}
+
+BOOST_AUTO_TEST_CASE(test_scan_does_not_beat_hot_keys) {
+    utils::frequency_sketch sketch(1 << 16);
+
+    const uint64_t hot_keys = 100;
+    for (unsigned round = 0; round < 8; ++round) {
+        for (uint64_t k = 0; k < hot_keys; ++k) {
+            sketch.record(k);
+        }
+    }
+    // A scan touching each key once.
+    for (uint64_t k = 1000; k < 11000; ++k) {
+        sketch.record(k);
+    }
+
+    unsigned max_scanned = 0;
+    for (uint64_t k = 1000; k < 11000; ++k) {
+        max_scanned = std::max(max_scanned, sketch.estimate(k));
+    }
+    for (uint64_t k = 0; k < hot_keys; ++k) {
+        BOOST_REQUIRE_GT(sketch.estimate(k), max_scanned);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_aging) {
+    utils::frequency_sketch sketch(4096);
+
+    for (unsigned i = 0; i < 9; ++i) {
+        sketch.record(1);
+    }
+    const auto before = sketch.estimate(1);
+    BOOST_REQUIRE_EQUAL(sketch.resets(), 0);
+
+    // Accesses to other keys eventually age the counters.
+    while (sketch.resets() == 0) {
+        sketch.record(2);
+    }
+    BOOST_REQUIRE_LE(sketch.estimate(1), before / 2);
+}
@@ -23,6 +23,14 @@
 #include <seastar/core/coroutine.hh>
 #include "readers/from_mutations_v2.hh"
 #include "readers/mutation_fragment_v1_stream.hh"
+#include "service/batched_mutation.hh"
+#include "idl/frozen_mutation.dist.hh"
+#include "idl/per_partition_rate_limit_info.dist.hh"
+#include "idl/batched_mutation.dist.hh"
+#include "serializer_impl.hh"
+#include "idl/frozen_mutation.dist.impl.hh"
+#include "idl/per_partition_rate_limit_info.dist.impl.hh"
+#include "idl/batched_mutation.dist.impl.hh"
 
 static schema_builder new_table() {
     return { "some_keyspace", "some_table" };
@@ -213,3 +221,28 @@ SEASTAR_TEST_CASE(frozen_mutation_is_consumed_in_order) {
     validate_consume(s, fm, m);
     co_await validate_consume_gently(s, fm, m);
 }
+
+SEASTAR_THREAD_TEST_CASE(test_batched_mutation_serialization) {
+    for_each_mutation([] (const mutation& m) {
+        auto fm = make_lw_shared<const frozen_mutation>(freeze(m));
+
+        // The mutations of a MUTATION_BATCH message are shared with their
+        // write handlers, and serialize like a mutation of a MUTATION message.
+        BOOST_REQUIRE_EQUAL(ser::serialize_to_buffer<bytes>(fm), ser::serialize_to_buffer<bytes>(*fm));
+
+        std::vector<service::batched_mutation> batch;
+        batch.push_back(service::batched_mutation{fm, 1, std::monostate()});
+        batch.push_back(service::batched_mutation{fm, 2, db::per_partition_rate_limit::account_and_enforce{7}});
+        auto buf = ser::serialize_to_buffer<bytes>(batch);
+        auto received = ser::deserialize_from_buffer(buf, boost::type<std::vector<service::batched_mutation>>());
+
+        BOOST_REQUIRE_EQUAL(received.size(), 2);
+        BOOST_REQUIRE_EQUAL(received[0].response_id, 1);
+        BOOST_REQUIRE(std::holds_alternative<std::monostate>(received[0].rate_limit_info));
+        BOOST_REQUIRE_EQUAL(received[1].response_id, 2);
+        BOOST_REQUIRE_EQUAL(std::get<db::per_partition_rate_limit::account_and_enforce>(received[1].rate_limit_info).random_variable, 7);
+        for (auto& bm : received) {
+            assert_that(bm.fm->unfreeze(m.schema())).is_equal_to(m);
+        }
+    });
+}
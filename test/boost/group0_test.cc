@@ -16,6 +16,8 @@
 #include "utils/error_injection.hh"
 #include "transport/messages/result_message.hh"
 #include "service/migration_manager.hh"
+#include "service/raft/raft_group0_client.hh"
+#include "data_dictionary/keyspace_metadata.hh"
 #include "seastar/core/metrics_api.hh"
 
 static future<utils::chunked_vector<std::vector<bytes_opt>>> fetch_rows(cql_test_env& e, std::string_view cql) {
@@ -233,3 +235,32 @@ SEASTAR_TEST_CASE(test_concurrent_group0_modifications) {
 
     }, raft_cql_test_config());
 }
+
+SEASTAR_TEST_CASE(test_group0_schema_changes_from_two_creators) {
+    return do_with_cql_env([] (cql_test_env& e) -> future<> {
+        auto& rclient = e.get_raft_group0_client();
+        auto& mm = e.migration_manager().local();
+
+        auto make_command = [&] (sstring ks_name, gms::inet_address creator) -> future<service::group0_command> {
+            auto guard = co_await mm.start_group0_operation();
+            auto ksm = data_dictionary::keyspace_metadata::new_keyspace(ks_name, "org.apache.cassandra.locator.SimpleStrategy", {{"replication_factor", "1"}}, true);
+            auto muts = mm.prepare_new_keyspace_announcement(ksm, guard.write_timestamp());
+            auto cmd = rclient.prepare_command(service::schema_change{.mutations{muts.begin(), muts.end()}}, guard, "test");
+            // Unconditional, so that both commands apply regardless of their order in the log.
+            cmd.prev_state_id = std::nullopt;
+            cmd.creator_addr = creator;
+            co_return cmd;
+        };
+
+        auto size = co_await get_history_size(e);
+        auto cmd1 = co_await make_command("new_ks1", gms::inet_address("127.0.0.1"));
+        auto cmd2 = co_await make_command("new_ks2", gms::inet_address("127.0.0.2"));
+
+        // Commands added together are appended and applied in one batch.
+        co_await when_all_succeed(rclient.add_entry_unguarded(std::move(cmd1)), rclient.add_entry_unguarded(std::move(cmd2))).discard_result();
+
+        BOOST_REQUIRE(e.local_db().has_keyspace("new_ks1"));
+        BOOST_REQUIRE(e.local_db().has_keyspace("new_ks2"));
+        BOOST_REQUIRE_EQUAL(co_await get_history_size(e), size + 2);
+    }, raft_cql_test_config());
+}
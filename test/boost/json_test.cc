@@ -54,3 +54,17 @@ BOOST_AUTO_TEST_CASE(test_parsing_map_from_null) {
     BOOST_REQUIRE(map1 == map2);
     BOOST_REQUIRE(map1 == empty_map);
 }
+
+BOOST_AUTO_TEST_CASE(test_parsing_chunked_content) {
+    const std::string_view json = R"({"a": [1, 2.5, "three", {"b": null}], "c": "a longer string value", "d": true})";
+    const auto expected = rjson::parse(json);
+    for (size_t chunk_size : {1, 2, 3, 7, 16, 1000}) {
+        rjson::chunked_content content;
+        for (size_t pos = 0; pos < json.size(); pos += chunk_size) {
+            auto chunk = json.substr(pos, chunk_size);
+            content.emplace_back(chunk.data(), chunk.size());
+        }
+        BOOST_REQUIRE_EQUAL(rjson::parse(std::move(content)), expected);
+    }
+    BOOST_REQUIRE_THROW(rjson::parse(rjson::chunked_content{}), rjson::error);
+}
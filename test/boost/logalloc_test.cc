@@ -11,6 +11,7 @@
 #include <boost/intrusive/parent_from_member.hpp>
 #include <algorithm>
 #include <chrono>
+#include <numeric>
 #include <random>
 
 #include <seastar/core/circular_buffer.hh>
@@ -96,6 +97,40 @@ SEASTAR_TEST_CASE(test_compaction) {
     });
 }
 
+SEASTAR_THREAD_TEST_CASE(test_compact_sparse_segments) {
+    region reg;
+
+    auto sparse_segments = [] {
+        auto hist = shard_tracker().segment_occupancy(false);
+        return std::accumulate(hist.begin(), hist.begin() + 5, uint64_t(0));
+    };
+
+    std::vector<managed_ref<int>> allocated;
+    with_allocator(reg.allocator(), [&] {
+        for (int i = 0; i < 32 * 1024 * 8; i++) {
+            allocated.push_back(make_managed<int>());
+        }
+        // Leave every segment about a third full.
+        for (size_t i = 0; i < allocated.size(); ++i) {
+            if (i % 3) {
+                allocated[i] = {};
+            }
+        }
+    });
+    BOOST_REQUIRE_GT(sparse_segments(), 0);
+
+    auto reclaim_counter = reg.reclaim_counter();
+    while (shard_tracker().compact_sparse_segments(0.5)) {
+        seastar::thread::yield();
+    }
+    BOOST_REQUIRE(reg.reclaim_counter() != reclaim_counter);
+    BOOST_REQUIRE_GT(reg.occupancy().used_fraction(), 0.5);
+
+    with_allocator(reg.allocator(), [&] {
+        allocated.clear();
+    });
+}
+
 SEASTAR_TEST_CASE(test_occupancy) {
     return seastar::async([] {
         region reg;
@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2022-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#define BOOST_TEST_MODULE core
+
+#include <boost/test/unit_test.hpp>
+#include "backlog_controller.hh"
+
+using namespace std::chrono_literals;
+
+static constexpr float min_shares = 10;
+static constexpr float max_shares = 1010;
+
+static float next_shares(float shares, std::optional<std::chrono::microseconds> latency, std::chrono::microseconds target = 10ms) {
+    return maintenance_controller::next_shares(shares, latency, target, min_shares, max_shares);
+}
+
+BOOST_AUTO_TEST_CASE(test_shares_halved_above_target) {
+    BOOST_REQUIRE_EQUAL(next_shares(max_shares, 20ms), 505);
+    BOOST_REQUIRE_EQUAL(next_shares(505, 11ms), 252.5);
+}
+
+BOOST_AUTO_TEST_CASE(test_shares_grow_linearly_below_target) {
+    // A tenth of the [min, max] range per interval.
+    BOOST_REQUIRE_EQUAL(next_shares(min_shares, 5ms), 110);
+    BOOST_REQUIRE_EQUAL(next_shares(110, 5ms), 210);
+    // Reaching the target isn't exceeding it.
+    BOOST_REQUIRE_EQUAL(next_shares(210, 10ms), 310);
+    // Neither is having no foreground requests.
+    BOOST_REQUIRE_EQUAL(next_shares(310, std::nullopt), 410);
+
+    // A spike cuts through the ramp.
+    BOOST_REQUIRE_EQUAL(next_shares(next_shares(410, 5ms), 20ms), 255);
+}
+
+BOOST_AUTO_TEST_CASE(test_shares_clamped) {
+    BOOST_REQUIRE_EQUAL(next_shares(15, 20ms), min_shares);
+    BOOST_REQUIRE_EQUAL(next_shares(min_shares, 20ms), min_shares);
+    BOOST_REQUIRE_EQUAL(next_shares(950, 5ms), max_shares);
+    BOOST_REQUIRE_EQUAL(next_shares(max_shares, 5ms), max_shares);
+
+    // Out of range shares, e.g. after the limits were changed, are brought into it.
+    BOOST_REQUIRE_EQUAL(next_shares(5000, 20ms), max_shares);
+    BOOST_REQUIRE_EQUAL(next_shares(1, 5ms), 101);
+
+    // A minimum above the maximum is lowered to it, and the shares never drop below 1.
+    BOOST_REQUIRE_EQUAL(maintenance_controller::next_shares(100, 20ms, 10ms, 500, 200), 200);
+    BOOST_REQUIRE_EQUAL(maintenance_controller::next_shares(1, 20ms, 10ms, 0, 200), 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_shares_maximal_without_target) {
+    BOOST_REQUIRE_EQUAL(next_shares(min_shares, 20ms, 0ms), max_shares);
+    BOOST_REQUIRE_EQUAL(next_shares(500, std::nullopt, 0ms), max_shares);
+    BOOST_REQUIRE_EQUAL(next_shares(max_shares, 5ms, 0ms), max_shares);
+}
@@ -311,6 +311,47 @@ SEASTAR_TEST_CASE(test_virtual_dirty_accounting_on_flush) {
     });
 }
 
+SEASTAR_TEST_CASE(test_memtable_writes_in_place_unless_pinned) {
+    return seastar::async([] {
+        schema_ptr s = schema_builder("ks", "cf")
+                .with_column("pk", bytes_type, column_kind::partition_key)
+                .with_column("col", bytes_type, column_kind::regular_column)
+                .build();
+
+        tests::reader_concurrency_semaphore_wrapper semaphore;
+
+        dirty_memory_manager mgr;
+        replica::table_stats tbl_stats;
+
+        auto mt = make_lw_shared<replica::memtable>(s, mgr, tbl_stats);
+
+        auto m = make_ring(s, 1).front();
+        auto write = [&] {
+            auto update = m;
+            update.set_clustered_cell(clustering_key::make_empty(), to_bytes("col"), data_value(bytes("v")), next_timestamp());
+            mt->apply(std::move(update));
+        };
+
+        write();
+        write();
+        BOOST_REQUIRE_EQUAL(tbl_stats.memtable_app_stats.partition_writes_in_place, 2);
+        BOOST_REQUIRE_EQUAL(tbl_stats.memtable_app_stats.partition_versions_created, 0);
+
+        // A reader inside the partition pins its latest version, so a write
+        // goes to a new one, which the following writes are merged into.
+        flat_mutation_reader_v2_opt rd = mt->make_flat_reader(s, semaphore.make_permit());
+        auto close_rd = deferred_close(*rd);
+        rd->set_max_buffer_size(1);
+        rd->fill_buffer().get();
+
+        write();
+        BOOST_REQUIRE_EQUAL(tbl_stats.memtable_app_stats.partition_versions_created, 1);
+        write();
+        BOOST_REQUIRE_EQUAL(tbl_stats.memtable_app_stats.partition_writes_in_place, 3);
+        BOOST_REQUIRE_EQUAL(tbl_stats.memtable_app_stats.partition_versions_created, 1);
+    });
+}
+
 // Reproducer for #1753
 SEASTAR_TEST_CASE(test_partition_version_consistency_after_lsa_compaction_happens) {
     return seastar::async([] {
@@ -883,6 +924,48 @@ SEASTAR_TEST_CASE(memtable_flush_compresses_mutations) {
     }, db_config);
 }
 
+SEASTAR_TEST_CASE(test_flush_invalidates_cache_of_write_mostly_table) {
+    auto db_config = make_shared<db::config>();
+    db_config->cache_update_min_reads_per_write(1);
+    return do_with_cql_env_thread([](cql_test_env& env) {
+        env.execute_cql("CREATE TABLE ks.cf (pk int PRIMARY KEY, v int)").get();
+        replica::table& t = env.local_db().find_column_family("ks", "cf");
+        schema_ptr s = t.schema();
+
+        // A key of this shard, so that the reads below are counted by t.
+        int32_t pk = 0;
+        while (dht::shard_of(*s, dht::decorate_key(*s, partition_key::from_single_value(*s, serialized(pk))).token()) != this_shard_id()) {
+            ++pk;
+        }
+        auto write = [&] (int32_t v) {
+            mutation m(s, partition_key::from_single_value(*s, serialized(pk)));
+            m.set_clustered_cell(clustering_key::make_empty(), to_bytes("v"), data_value(v), api::new_timestamp());
+            t.apply(m);
+        };
+        auto read = [&] (int32_t v) {
+            assert_that(env.execute_cql(format("SELECT v FROM ks.cf WHERE pk = {}", pk)).get0())
+                .is_rows().with_rows({{int32_type->decompose(v)}});
+        };
+
+        for (int32_t v = 0; v < 10; ++v) {
+            write(v);
+        }
+        t.flush().get();
+        BOOST_REQUIRE_EQUAL(t.get_stats().cache_updates_invalidated, 1);
+        BOOST_REQUIRE_EQUAL(t.get_stats().cache_updates_merged, 0);
+        read(9);
+
+        write(10);
+        for (int i = 0; i < 10; ++i) {
+            read(10);
+        }
+        t.flush().get();
+        BOOST_REQUIRE_EQUAL(t.get_stats().cache_updates_invalidated, 1);
+        BOOST_REQUIRE_EQUAL(t.get_stats().cache_updates_merged, 1);
+        read(10);
+    }, db_config);
+}
+
 SEASTAR_TEST_CASE(sstable_compaction_does_not_resurrect_data) {
     auto db_config = make_shared<db::config>();
     db_config->enable_cache.set(false);
@@ -643,3 +643,39 @@ SEASTAR_THREAD_TEST_CASE(test_mutation_fragment_stream_validator_mixed_api_usage
     BOOST_REQUIRE(validator(dk0));
     BOOST_REQUIRE(!validator(dk0));
 }
+
+SEASTAR_THREAD_TEST_CASE(test_mutation_fragment_stream_validating_filter_sampling) {
+    simple_schema ss;
+
+    const auto dkeys = ss.make_pkeys(4);
+    const auto ck0 = ss.make_ckey(0);
+    const auto ck1 = ss.make_ckey(1);
+
+    reader_concurrency_semaphore sem(reader_concurrency_semaphore::for_tests{}, get_name(), 1, 100);
+    auto stop_sem = deferred_stop(sem);
+    auto permit = sem.make_tracking_only_permit(ss.schema().get(), get_name(), db::no_timeout);
+
+    mutation_fragment_stream_validating_filter validator(get_name(), *ss.schema(), mutation_fragment_stream_validation_level::token, 0.5);
+
+    // Every other partition, starting with the first, is validated fully, so
+    // the clustering rows out of order are detected in those only.
+    for (unsigned i = 0; i < dkeys.size(); ++i) {
+        BOOST_REQUIRE(validator(dkeys[i]));
+        BOOST_REQUIRE(validator(mutation_fragment_v2(*ss.schema(), permit, partition_start(dkeys[i], {}))));
+        BOOST_REQUIRE(validator(ss.make_row_v2(permit, ck1, "v")));
+        if (i % 2 == 0) {
+            BOOST_REQUIRE_THROW(validator(ss.make_row_v2(permit, ck0, "v")), invalid_mutation_fragment_stream);
+        } else {
+            BOOST_REQUIRE(validator(ss.make_row_v2(permit, ck0, "v")));
+        }
+        BOOST_REQUIRE(validator.on_end_of_partition());
+    }
+    validator.on_end_of_stream();
+
+    BOOST_REQUIRE_EQUAL(validator.partitions_sampled(), 2);
+    BOOST_REQUIRE_EQUAL(validator.fragments_validated(), 16);
+    BOOST_REQUIRE_EQUAL(validator.fragments_fully_validated(), 8);
+
+    // Tokens are validated in all partitions.
+    BOOST_REQUIRE_THROW(validator(dkeys[0]), invalid_mutation_fragment_stream);
+}
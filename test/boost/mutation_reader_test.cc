@@ -2283,6 +2283,96 @@ SEASTAR_THREAD_TEST_CASE(test_multishard_combining_reader_next_partition) {
     }).get();
 }
 
+SEASTAR_THREAD_TEST_CASE(test_multishard_read_ahead_concurrency_grows_and_shrinks) {
+    auto concurrency = multishard_read_ahead_concurrency(4, std::numeric_limits<uint64_t>::max());
+    BOOST_REQUIRE_EQUAL(concurrency.get(), 1);
+
+    // Doubled on each empty buffer, up to the number of shards.
+    for (auto expected : {2u, 4u, 4u}) {
+        concurrency.on_buffer_fill();
+        concurrency.on_empty_buffer_after_crossing_shards(1, 0);
+        BOOST_REQUIRE_EQUAL(concurrency.get(), expected);
+    }
+
+    // Decreased by one once a whole round of read-aheads was in time.
+    for (unsigned i = 0; i < 3; ++i) {
+        concurrency.on_shard_reached(true, false);
+        BOOST_REQUIRE_EQUAL(concurrency.get(), 4);
+    }
+    concurrency.on_shard_reached(true, false);
+    BOOST_REQUIRE_EQUAL(concurrency.get(), 3);
+
+    // A read-ahead which didn't make it starts a new round.
+    concurrency.on_shard_reached(true, false);
+    concurrency.on_shard_reached(true, false);
+    concurrency.on_shard_reached(false, false);
+    concurrency.on_shard_reached(true, false);
+    concurrency.on_shard_reached(true, false);
+    BOOST_REQUIRE_EQUAL(concurrency.get(), 3);
+    // One still in progress doesn't.
+    concurrency.on_shard_reached(false, true);
+    concurrency.on_shard_reached(true, false);
+    BOOST_REQUIRE_EQUAL(concurrency.get(), 2);
+
+    concurrency.on_shard_reached(true, false);
+    concurrency.on_shard_reached(true, false);
+    BOOST_REQUIRE_EQUAL(concurrency.get(), 1);
+    for (unsigned i = 0; i < 3; ++i) {
+        concurrency.on_shard_reached(true, false);
+        BOOST_REQUIRE_EQUAL(concurrency.get(), 1);
+    }
+}
+
+SEASTAR_THREAD_TEST_CASE(test_multishard_read_ahead_concurrency_halved_on_queued_reads) {
+    auto concurrency = multishard_read_ahead_concurrency(8, std::numeric_limits<uint64_t>::max());
+    for (unsigned i = 0; i < 3; ++i) {
+        concurrency.on_buffer_fill();
+        concurrency.on_empty_buffer_after_crossing_shards(1, 0);
+    }
+    BOOST_REQUIRE_EQUAL(concurrency.get(), 8);
+
+    for (auto expected : {4u, 2u, 1u, 1u}) {
+        concurrency.on_buffer_fill();
+        concurrency.on_empty_buffer_after_crossing_shards(1, 3);
+        BOOST_REQUIRE_EQUAL(concurrency.get(), expected);
+    }
+
+    // Grows again once the queue is gone.
+    concurrency.on_buffer_fill();
+    concurrency.on_empty_buffer_after_crossing_shards(1, 0);
+    BOOST_REQUIRE_EQUAL(concurrency.get(), 2);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_multishard_read_ahead_concurrency_capped_by_row_limit) {
+    auto concurrency = multishard_read_ahead_concurrency(8, 10);
+    BOOST_REQUIRE_EQUAL(concurrency.max_useful_concurrency(), 8);
+
+    auto fill_buffer = [&] (unsigned rows) {
+        concurrency.on_buffer_fill();
+        for (unsigned i = 0; i < rows; ++i) {
+            concurrency.on_row_emitted();
+        }
+    };
+
+    // 4 rows per buffer, 6 rows to go: 2 buffers.
+    fill_buffer(4);
+    BOOST_REQUIRE_EQUAL(concurrency.max_useful_concurrency(), 2);
+    concurrency.on_empty_buffer_after_crossing_shards(1, 0);
+    BOOST_REQUIRE_EQUAL(concurrency.get(), 2);
+    concurrency.on_empty_buffer_after_crossing_shards(1, 0);
+    BOOST_REQUIRE_EQUAL(concurrency.get(), 2);
+
+    // 2 rows to go: 1 buffer.
+    fill_buffer(4);
+    BOOST_REQUIRE_EQUAL(concurrency.max_useful_concurrency(), 1);
+    concurrency.on_empty_buffer_after_crossing_shards(1, 0);
+    BOOST_REQUIRE_EQUAL(concurrency.get(), 1);
+
+    // Past the limit, the reader still needs its current shard.
+    fill_buffer(4);
+    BOOST_REQUIRE_EQUAL(concurrency.max_useful_concurrency(), 1);
+}
+
 // Test the multishard streaming reader in the context it was designed to work
 // in: as a mean to read data belonging to a shard according to a different
 // sharding configuration.
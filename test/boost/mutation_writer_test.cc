@@ -20,6 +20,7 @@
 #include "mutation_writer/multishard_writer.hh"
 #include "mutation_writer/timestamp_based_splitting_writer.hh"
 #include "mutation_writer/partition_based_splitting_writer.hh"
+#include "mutation_writer/size_based_splitting_writer.hh"
 #include "test/lib/cql_test_env.hh"
 #include "test/lib/flat_mutation_reader_assertions.hh"
 #include "test/lib/mutation_assertions.hh"
@@ -522,3 +523,61 @@ SEASTAR_THREAD_TEST_CASE(test_partition_based_splitting_mutation_writer) {
     }
 
 }
+
+SEASTAR_THREAD_TEST_CASE(test_size_based_splitting_mutation_writer) {
+    tests::reader_concurrency_semaphore_wrapper semaphore;
+    auto random_spec = tests::make_random_schema_specification(
+            get_name(),
+            std::uniform_int_distribution<size_t>(1, 2),
+            std::uniform_int_distribution<size_t>(0, 2),
+            std::uniform_int_distribution<size_t>(1, 2),
+            std::uniform_int_distribution<size_t>(0, 1));
+
+    auto random_schema = tests::random_schema{tests::random::get_int<uint32_t>(), *random_spec};
+
+    const auto input_mutations = tests::generate_random_mutations(
+            random_schema,
+            tests::default_timestamp_generator(),
+            tests::no_expiry_expiry_generator(),
+            std::uniform_int_distribution<size_t>(100, 1000), // partitions
+            std::uniform_int_distribution<size_t>(1, 4), // rows
+            std::uniform_int_distribution<size_t>(0, 1)).get(); // range tombstones
+
+    testlog.info("input_mutations.size()={}", input_mutations.size());
+
+    for (const size_t max_size : {1'000, 100'000, 100'000'000}) {
+        // Consumers of earlier streams may still run when later ones start.
+        std::list<std::vector<mutation>> output_mutations;
+        auto consumer = [&] (flat_mutation_reader_v2 rd) {
+            auto& muts = output_mutations.emplace_back();
+            return async([&muts, rd = std::move(rd)] () mutable {
+                auto close_rd = deferred_close(rd);
+                while (auto mut_opt = read_mutation_from_flat_mutation_reader(rd).get0()) {
+                    muts.emplace_back(std::move(*mut_opt));
+                }
+            });
+        };
+        mutation_writer::segregate_by_size(
+                make_flat_mutation_reader_from_mutations_v2(random_schema.schema(), semaphore.make_permit(), input_mutations),
+                max_size,
+                consumer).get();
+        testlog.info("Split with max_size={} into {} streams", max_size, output_mutations.size());
+
+        if (max_size == 100'000'000) {
+            BOOST_REQUIRE_EQUAL(output_mutations.size(), 1);
+        } else {
+            BOOST_REQUIRE_GT(output_mutations.size(), 1);
+        }
+
+        // The streams are consecutive pieces of the input.
+        auto it = input_mutations.begin();
+        for (auto& muts : output_mutations) {
+            BOOST_REQUIRE(!muts.empty());
+            for (auto& mut : muts) {
+                BOOST_REQUIRE(it != input_mutations.end());
+                assert_that(mut).is_equal_to(*it++);
+            }
+        }
+        BOOST_REQUIRE(it == input_mutations.end());
+    }
+}
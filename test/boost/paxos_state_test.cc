@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2022-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include <seastar/testing/thread_test_case.hh>
+
+#include "service/paxos/paxos_state.hh"
+#include "service/paxos/proposal.hh"
+#include "schema_builder.hh"
+#include "mutation.hh"
+#include "frozen_mutation.hh"
+
+using namespace service::paxos;
+
+static constexpr size_t max_memory = 1024 * 1024;
+
+static schema_ptr make_schema() {
+    return schema_builder("ks", "cf")
+            .with_column("pk", int32_type, column_kind::partition_key)
+            .with_column("v", int32_type)
+            .build();
+}
+
+static partition_key make_key(const schema& s, int32_t k) {
+    return partition_key::from_single_value(s, int32_type->decompose(k));
+}
+
+// Ballots of the current time, so that the cached states don't expire, in
+// the order of `n`.
+static utils::UUID make_ballot(int n) {
+    static const auto base = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch());
+    return utils::UUID_gen::get_random_time_UUID_from_micros(base + std::chrono::microseconds(n));
+}
+
+static proposal make_proposal(schema_ptr s, const partition_key& key, const utils::UUID& ballot, int32_t value) {
+    mutation m(s, key);
+    m.set_clustered_cell(clustering_key::make_empty(), "v", data_value(value), utils::UUID_gen::micros_timestamp(ballot));
+    return proposal(ballot, freeze(m));
+}
+
+SEASTAR_THREAD_TEST_CASE(test_state_cache_applies_writes_by_their_timestamps) {
+    auto s = make_schema();
+    auto key = make_key(*s, 1);
+    paxos_state::state_cache cache;
+
+    // A state with a promise only. What's missing from it isn't newer than the promise.
+    cache.insert(*s, key, paxos_state(make_ballot(2), std::nullopt, std::nullopt), cache.generation(), max_memory);
+    BOOST_REQUIRE(cache.get(*s, key));
+
+    // An older promise loses to the cached one.
+    cache.apply_promise(*s, key, make_ballot(1));
+    BOOST_REQUIRE_EQUAL(cache.get(*s, key)->promised_ballot(), make_ballot(2));
+
+    // A newer proposal wins over the promise, and over the unknown accepted proposal.
+    cache.apply_proposal(*s, make_proposal(s, key, make_ballot(3), 3));
+    auto state = cache.get(*s, key);
+    BOOST_REQUIRE(state);
+    BOOST_REQUIRE_EQUAL(state->promised_ballot(), make_ballot(3));
+    BOOST_REQUIRE(state->accepted_proposal());
+    BOOST_REQUIRE_EQUAL(state->accepted_proposal()->ballot, make_ballot(3));
+
+    // A newer promise keeps the accepted proposal.
+    cache.apply_promise(*s, key, make_ballot(4));
+    state = cache.get(*s, key);
+    BOOST_REQUIRE_EQUAL(state->promised_ballot(), make_ballot(4));
+    BOOST_REQUIRE_EQUAL(state->accepted_proposal()->ballot, make_ballot(3));
+
+    // An older proposal loses to the promise, and to the accepted proposal.
+    cache.apply_proposal(*s, make_proposal(s, key, make_ballot(2), 2));
+    state = cache.get(*s, key);
+    BOOST_REQUIRE_EQUAL(state->promised_ballot(), make_ballot(4));
+    BOOST_REQUIRE_EQUAL(state->accepted_proposal()->ballot, make_ballot(3));
+}
+
+SEASTAR_THREAD_TEST_CASE(test_state_cache_drops_writes_which_may_lose) {
+    auto s = make_schema();
+    auto key = make_key(*s, 1);
+    paxos_state::state_cache cache;
+
+    // The accepted proposal of the table, if any, may be as new as the promise.
+    cache.insert(*s, key, paxos_state(make_ballot(2), std::nullopt, std::nullopt), cache.generation(), max_memory);
+    cache.apply_proposal(*s, make_proposal(s, key, make_ballot(1), 1));
+    BOOST_REQUIRE(!cache.get(*s, key));
+}
+
+SEASTAR_THREAD_TEST_CASE(test_state_cache_generation) {
+    auto s = make_schema();
+    auto key = make_key(*s, 1);
+    auto other_key = make_key(*s, 2);
+    paxos_state::state_cache cache;
+    const paxos_state state(make_ballot(1), std::nullopt, std::nullopt);
+
+    // A write of a key which is not cached, while a state is loaded, may
+    // be missing from it.
+    auto generation = cache.generation();
+    cache.apply_decision(*s, make_proposal(s, other_key, make_ballot(2), 2));
+    cache.insert(*s, key, state, generation, max_memory);
+    BOOST_REQUIRE(!cache.get(*s, key));
+
+    generation = cache.generation();
+    cache.apply_prune(*s, other_key, make_ballot(2));
+    cache.insert(*s, key, state, generation, max_memory);
+    BOOST_REQUIRE(!cache.get(*s, key));
+
+    // So may a failed write, whether its key was cached or not.
+    generation = cache.generation();
+    cache.write_failed(*s, other_key);
+    cache.insert(*s, key, state, generation, max_memory);
+    BOOST_REQUIRE(!cache.get(*s, key));
+
+    // Writes of cached keys don't race with loads.
+    cache.insert(*s, other_key, state, cache.generation(), max_memory);
+    generation = cache.generation();
+    cache.apply_promise(*s, other_key, make_ballot(3));
+    cache.insert(*s, key, state, generation, max_memory);
+    BOOST_REQUIRE(cache.get(*s, key));
+}
+
+SEASTAR_THREAD_TEST_CASE(test_state_cache_learn_and_prune) {
+    auto s = make_schema();
+    auto key = make_key(*s, 1);
+    paxos_state::state_cache cache;
+
+    auto accepted = make_proposal(s, key, make_ballot(1), 1);
+    cache.insert(*s, key, paxos_state(make_ballot(1), accepted, std::nullopt), cache.generation(), max_memory);
+
+    // Learning a decision deletes the accepted proposal.
+    cache.apply_decision(*s, make_proposal(s, key, make_ballot(2), 2));
+    auto state = cache.get(*s, key);
+    BOOST_REQUIRE(state);
+    BOOST_REQUIRE(!state->accepted_proposal());
+    BOOST_REQUIRE(state->most_recent_commit());
+    BOOST_REQUIRE_EQUAL(state->most_recent_commit()->ballot, make_ballot(2));
+
+    // Pruning deletes the mutation of the decision, not the decision.
+    cache.apply_prune(*s, key, make_ballot(2));
+    state = cache.get(*s, key);
+    BOOST_REQUIRE(state);
+    BOOST_REQUIRE(state->most_recent_commit());
+    BOOST_REQUIRE(state->most_recent_commit()->update.unfreeze(s).partition().empty());
+
+    // A failed learn drops the key.
+    cache.write_failed(*s, key);
+    BOOST_REQUIRE(!cache.get(*s, key));
+
+    // A decision which may lose to the table's one drops the key.
+    cache.insert(*s, key, paxos_state(make_ballot(3), std::nullopt, std::nullopt), cache.generation(), max_memory);
+    cache.apply_decision(*s, make_proposal(s, key, make_ballot(2), 2));
+    BOOST_REQUIRE(!cache.get(*s, key));
+}
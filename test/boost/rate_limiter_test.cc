@@ -18,6 +18,9 @@
 
 using namespace seastar;
 using test_rate_limiter = db::generic_rate_limiter<seastar::manual_clock>;
+using test_count_min_rate_limiter = db::generic_rate_limiter<seastar::manual_clock, db::count_min_rate_limiter_base>;
+
+static constexpr size_t test_sketch_size = 1 << 20;
 
 future<> step_seconds(int seconds) {
     for (int i = 0; i < seconds; i++) {
@@ -128,3 +131,92 @@ SEASTAR_TEST_CASE(test_rate_limiter_account_operation) {
     }
     BOOST_REQUIRE(encountered_rejection);
 }
+
+SEASTAR_TEST_CASE(test_count_min_rate_limiter_never_underestimates) {
+    const uint64_t token_count = 100 * 1000;
+    test_count_min_rate_limiter::label lbl;
+
+    // Small enough for many collisions
+    test_count_min_rate_limiter limiter(64 * 1024);
+    BOOST_REQUIRE_EQUAL(limiter.memory_usage(), 64 * 1024);
+
+    for (uint64_t i = 0; i < 3; i++) {
+        for (uint64_t token = 0; token < token_count; token++) {
+            BOOST_REQUIRE_GE(limiter.increase_and_get_counter(lbl, token), i + 1);
+            co_await maybe_yield();
+        }
+    }
+    BOOST_REQUIRE_GT(limiter.error_bound(), 0);
+
+    // A hot partition's count stays close to its true count
+    const uint64_t hot_token = token_count;
+    uint64_t count = 0;
+    for (int i = 0; i < 1000; i++) {
+        count = limiter.increase_and_get_counter(lbl, hot_token);
+    }
+    BOOST_REQUIRE_GE(count, 1000);
+    BOOST_REQUIRE_LE(count, 1000 + limiter.error_bound());
+}
+
+SEASTAR_TEST_CASE(test_count_min_rate_limiter_partition_label_separation) {
+    const uint64_t token_count = 30;
+    const uint64_t repeat_count = 10;
+    std::vector<test_count_min_rate_limiter::label> labels{3};
+
+    test_count_min_rate_limiter limiter(test_sketch_size);
+
+    for (uint64_t i = 0; i < repeat_count; i++) {
+        for (uint64_t token = 0; token < token_count; token++) {
+            for (auto& l : labels) {
+                BOOST_REQUIRE_EQUAL(limiter.increase_and_get_counter(l, token), i + 1);
+                co_await maybe_yield();
+            }
+        }
+    }
+}
+
+SEASTAR_TEST_CASE(test_count_min_rate_limiter_halving_over_time) {
+    test_count_min_rate_limiter::label lbl;
+    test_count_min_rate_limiter limiter(test_sketch_size);
+
+    for (int i = 0; i < 16; i++) {
+        limiter.increase_and_get_counter(lbl, 0);
+    }
+
+    // Should be cut in half
+    co_await step_seconds(1);
+    BOOST_REQUIRE_EQUAL(limiter.increase_and_get_counter(lbl, 0), (16 / 2) + 1);
+
+    // Should decrease four times (9 -> 2)
+    co_await step_seconds(2);
+    BOOST_REQUIRE_EQUAL(limiter.increase_and_get_counter(lbl, 0), (9 / 4) + 1);
+
+    // Should be reset
+    co_await step_seconds(40);
+    BOOST_REQUIRE_EQUAL(limiter.increase_and_get_counter(lbl, 0), 1);
+
+    // Workaround for seastar#1072, see test_rate_limiter_time_window_wraparound_handling
+    co_await seastar::sleep(std::chrono::seconds(1));
+}
+
+SEASTAR_TEST_CASE(test_count_min_rate_limiter_account_operation) {
+    const uint64_t limit = 1;
+    const int ops_per_loop = 1000;
+    test_count_min_rate_limiter::label lbl;
+
+    test_count_min_rate_limiter limiter(test_sketch_size);
+
+    db::per_partition_rate_limit::account_and_enforce info {
+        .random_variable = UINT32_MAX,
+    };
+
+    bool encountered_rejection = false;
+    for (int i = 0; i < ops_per_loop; i++) {
+        if (limiter.account_operation(lbl, 0, limit, info) == test_count_min_rate_limiter::can_proceed::no) {
+            encountered_rejection = true;
+            break;
+        }
+        co_await maybe_yield();
+    }
+    BOOST_REQUIRE(encountered_rejection);
+}
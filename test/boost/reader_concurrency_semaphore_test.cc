@@ -416,6 +416,9 @@ SEASTAR_TEST_CASE(reader_restriction_file_tracking) {
             auto buf5 = tracked_file.dma_read_bulk<char>(0, 0).get0();
             BOOST_REQUIRE_EQUAL(-1 * 1024, semaphore.available_resources().memory);
 
+            // The bytes read are accounted to the permit.
+            BOOST_REQUIRE_EQUAL(permit.stats().disk_bytes_read, 5 * 1024);
+
             // Reassing buf1, should still have the same amount of units.
             buf1 = tracked_file.dma_read_bulk<char>(0, 0).get0();
             BOOST_REQUIRE_EQUAL(-1 * 1024, semaphore.available_resources().memory);
@@ -490,6 +493,44 @@ SEASTAR_TEST_CASE(reader_concurrency_semaphore_timeout) {
     });
 }
 
+SEASTAR_THREAD_TEST_CASE(test_reader_concurrency_semaphore_sheds_reads_past_deadline) {
+    reader_concurrency_semaphore semaphore(reader_concurrency_semaphore::for_tests{}, get_name(), 1, replica::new_reader_base_cost);
+    auto stop_sem = deferred_stop(semaphore);
+
+    // Reads executed via the ready list feed the average read time.
+    BOOST_REQUIRE(semaphore.average_read_time() == std::chrono::steady_clock::duration::zero());
+    semaphore.with_permit(nullptr, "read", replica::new_reader_base_cost, db::no_timeout, [] (reader_permit) {
+        return sleep(std::chrono::milliseconds(1));
+    }).get();
+    BOOST_REQUIRE(semaphore.average_read_time() > std::chrono::steady_clock::duration::zero());
+
+    auto wait_for_admission = [&] (std::chrono::steady_clock::duration avg_read_time, db::timeout_clock::duration time_left) {
+        semaphore.set_average_read_time_for_tests(avg_read_time);
+        reader_permit_opt blocker = semaphore.obtain_permit(nullptr, "blocker", replica::new_reader_base_cost, db::no_timeout).get();
+
+        auto executed = make_lw_shared<bool>(false);
+        auto read_fut = semaphore.with_permit(nullptr, "queued-read", replica::new_reader_base_cost, db::timeout_clock::now() + time_left,
+                [executed] (reader_permit) {
+            *executed = true;
+            return make_ready_future<>();
+        });
+        BOOST_REQUIRE_EQUAL(semaphore.waiters(), 1);
+
+        blocker = {};
+        return read_fut.then([executed] {
+            BOOST_REQUIRE(*executed);
+        });
+    };
+
+    // Reads with less time left than reads take are failed without executing them.
+    BOOST_REQUIRE_THROW(wait_for_admission(std::chrono::hours(1), std::chrono::minutes(1)).get(), semaphore_timed_out);
+    BOOST_REQUIRE_EQUAL(semaphore.get_stats().total_reads_shed_due_to_deadline, 1);
+
+    // The others are admitted.
+    wait_for_admission(std::chrono::milliseconds(1), std::chrono::hours(1)).get();
+    BOOST_REQUIRE_EQUAL(semaphore.get_stats().total_reads_shed_due_to_deadline, 1);
+}
+
 SEASTAR_TEST_CASE(reader_concurrency_semaphore_max_queue_length) {
     return async([&] () {
         reader_concurrency_semaphore semaphore(reader_concurrency_semaphore::for_tests{}, get_name(), 1, replica::new_reader_base_cost, 2);
@@ -957,3 +998,32 @@ SEASTAR_THREAD_TEST_CASE(test_reader_concurrency_semaphore_evict_inactive_reads_
         handles.clear();
     }
 }
+
+SEASTAR_THREAD_TEST_CASE(test_reader_concurrency_semaphore_evicts_costly_inactive_reads_last) {
+    simple_schema s;
+    reader_concurrency_semaphore semaphore(reader_concurrency_semaphore::no_limits{}, get_name());
+    auto stop_sem = deferred_stop(semaphore);
+
+    auto register_read = [&] (reader_concurrency_semaphore::resume_cost cost) {
+        return semaphore.register_inactive_read(make_empty_flat_reader_v2(s.schema(), semaphore.make_tracking_only_permit(s.schema().get(), get_name(), db::no_timeout)), cost);
+    };
+
+    auto costly = register_read(reader_concurrency_semaphore::resume_cost::high);
+    auto cheap1 = register_read(reader_concurrency_semaphore::resume_cost::low);
+    auto cheap2 = register_read(reader_concurrency_semaphore::resume_cost::low);
+
+    // Cheap reads go first, in the order of their registration.
+    BOOST_REQUIRE(semaphore.try_evict_one_inactive_read());
+    BOOST_REQUIRE(!cheap1);
+    BOOST_REQUIRE(cheap2);
+    BOOST_REQUIRE(costly);
+
+    BOOST_REQUIRE(semaphore.try_evict_one_inactive_read());
+    BOOST_REQUIRE(!cheap2);
+    BOOST_REQUIRE(costly);
+
+    BOOST_REQUIRE(semaphore.try_evict_one_inactive_read());
+    BOOST_REQUIRE(!costly);
+
+    BOOST_REQUIRE(!semaphore.try_evict_one_inactive_read());
+}
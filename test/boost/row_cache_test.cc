@@ -4084,3 +4084,100 @@ SEASTAR_TEST_CASE(test_eviction_of_upper_bound_of_population_range) {
         read(0, 3);
     });
 }
+
+SEASTAR_TEST_CASE(test_per_table_partition_occupancy) {
+    return seastar::async([] {
+        auto s1 = make_schema();
+        auto s2 = schema_builder("ks", "cf2")
+            .with_column("pk", bytes_type, column_kind::partition_key)
+            .with_column("v", bytes_type, column_kind::regular_column)
+            .build();
+        tests::reader_concurrency_semaphore_wrapper semaphore;
+        auto mt1 = make_lw_shared<replica::memtable>(s1);
+        auto mt2 = make_lw_shared<replica::memtable>(s2);
+
+        cache_tracker tracker;
+        row_cache cache1(s1, snapshot_source_from_snapshot(mt1->as_data_source()), tracker);
+        row_cache cache2(s2, snapshot_source_from_snapshot(mt2->as_data_source()), tracker);
+
+        for (int i = 0; i < 10; i++) {
+            cache1.populate(make_new_mutation(s1));
+        }
+        std::vector<mutation> mutations;
+        for (int i = 0; i < 3; i++) {
+            mutations.push_back(make_new_mutation(s2));
+            cache2.populate(mutations.back());
+        }
+        BOOST_REQUIRE_EQUAL(cache1.partitions(), 10);
+        BOOST_REQUIRE_EQUAL(cache2.partitions(), 3);
+        BOOST_REQUIRE_EQUAL(tracker.partitions(), 13);
+
+        cache2.invalidate(row_cache::external_updater([] {}), dht::partition_range::make_singular(mutations[0].decorated_key())).get();
+        BOOST_REQUIRE_EQUAL(cache2.partitions(), 2);
+
+        while (tracker.partitions() > 0) {
+            logalloc::shard_tracker().reclaim(100);
+        }
+        BOOST_REQUIRE_EQUAL(cache1.partitions(), 0);
+        BOOST_REQUIRE_EQUAL(cache2.partitions(), 0);
+    });
+}
+
+SEASTAR_TEST_CASE(test_cached_keys) {
+    return seastar::async([] {
+        auto s = make_schema();
+        auto mt = make_lw_shared<replica::memtable>(s);
+        cache_tracker tracker;
+        row_cache cache(s, snapshot_source_from_snapshot(mt->as_data_source()), tracker);
+
+        BOOST_REQUIRE(cache.cached_keys(dht::ring_position_view::min(), 10).empty());
+
+        std::vector<dht::decorated_key> keys;
+        for (int i = 0; i < 10; i++) {
+            auto m = make_new_mutation(s);
+            keys.push_back(m.decorated_key());
+            cache.populate(m);
+        }
+        std::sort(keys.begin(), keys.end(), dht::ring_position_less_comparator(*s));
+
+        std::vector<dht::decorated_key> found;
+        while (true) {
+            auto pos = found.empty() ? dht::ring_position_view::min() : dht::ring_position_view(found.back());
+            auto batch = cache.cached_keys(pos, 3);
+            if (batch.empty()) {
+                break;
+            }
+            BOOST_REQUIRE_LE(batch.size(), 3);
+            std::move(batch.begin(), batch.end(), std::back_inserter(found));
+        }
+        BOOST_REQUIRE_EQUAL(found.size(), keys.size());
+        for (size_t i = 0; i < keys.size(); ++i) {
+            BOOST_REQUIRE(found[i].equal(*s, keys[i]));
+        }
+    });
+}
+
+SEASTAR_TEST_CASE(test_partition_absent_hits) {
+    return seastar::async([] {
+        auto s = make_schema();
+        auto m = make_new_mutation(s);
+        tests::reader_concurrency_semaphore_wrapper semaphore;
+
+        cache_tracker tracker;
+        row_cache cache(s, snapshot_source_from_snapshot(make_source_with(m)), tracker);
+
+        // The full scan makes the whole ring continuous.
+        assert_that(cache.make_reader(s, semaphore.make_permit(), query::full_partition_range))
+            .produces(m)
+            .produces_end_of_stream();
+
+        auto absent = dht::partition_range::make_singular(make_new_mutation(s).decorated_key());
+        auto hits = tracker.get_stats().partition_hits;
+        auto misses = tracker.get_stats().partition_misses;
+        assert_that(cache.make_reader(s, semaphore.make_permit(), absent))
+            .produces_end_of_stream();
+        BOOST_REQUIRE_EQUAL(tracker.get_stats().partition_absent_hits, 1);
+        BOOST_REQUIRE_EQUAL(tracker.get_stats().partition_hits, hits);
+        BOOST_REQUIRE_EQUAL(tracker.get_stats().partition_misses, misses);
+    });
+}
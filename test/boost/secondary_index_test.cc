@@ -1997,3 +1997,58 @@ SEASTAR_TEST_CASE(test_returning_failure_from_ghost_rows_deletion) {
         }
     });
 }
+
+SEASTAR_TEST_CASE(test_covering_index) {
+    return do_with_cql_env_thread([] (auto& e) {
+        cquery_nofail(e, "CREATE TABLE t (p int, c int, v int, a int, b int, PRIMARY KEY (p, c))");
+        assert_that_failed(e.execute_cql("CREATE INDEX ON t(v) INCLUDE (c)"));
+        assert_that_failed(e.execute_cql("CREATE INDEX ON t(v) INCLUDE (v)"));
+        assert_that_failed(e.execute_cql("CREATE INDEX ON t(v) INCLUDE (a, a)"));
+        assert_that_failed(e.execute_cql("CREATE INDEX ON t(v) INCLUDE (x)"));
+        cquery_nofail(e, "CREATE INDEX ON t(v) INCLUDE (a)");
+        cquery_nofail(e, "INSERT INTO t (p, c, v, a, b) VALUES (1, 1, 1, 10, 100)");
+        cquery_nofail(e, "INSERT INTO t (p, c, v, a, b) VALUES (1, 2, 2, 20, 200)");
+        cquery_nofail(e, "INSERT INTO t (p, c, v, a, b) VALUES (2, 1, 1, 30, 300)");
+        // The included column is maintained on updates of the base table.
+        cquery_nofail(e, "UPDATE t SET a = 40 WHERE p = 2 AND c = 1");
+
+        auto& stats = e.local_qp().get_cql_stats();
+        const auto covered_reads = stats.secondary_index_covered_reads;
+        eventually([&] {
+            auto msg = cquery_nofail(e, "SELECT p, c, a FROM t WHERE v = 1");
+            assert_that(msg).is_rows().with_rows_ignore_order({
+                {int32_type->decompose(1), int32_type->decompose(1), int32_type->decompose(10)},
+                {int32_type->decompose(2), int32_type->decompose(1), int32_type->decompose(40)},
+            });
+        });
+        BOOST_REQUIRE_GT(stats.secondary_index_covered_reads, covered_reads);
+
+        // A column the index doesn't include is read from the base table.
+        const auto covered_reads_before_base_read = stats.secondary_index_covered_reads;
+        auto msg = cquery_nofail(e, "SELECT a, b FROM t WHERE v = 2");
+        assert_that(msg).is_rows().with_rows({
+            {int32_type->decompose(20), int32_type->decompose(200)},
+        });
+        BOOST_REQUIRE_EQUAL(stats.secondary_index_covered_reads, covered_reads_before_base_read);
+
+        // Paging over the index alone returns every row once.
+        std::vector<bytes_opt> paged;
+        lw_shared_ptr<service::pager::paging_state> paging_state;
+        for (int page = 0; page < 3; ++page) {
+            auto qo = std::make_unique<cql3::query_options>(db::consistency_level::LOCAL_ONE, std::vector<cql3::raw_value>{},
+                    cql3::query_options::specific_options{1, paging_state, {}, api::new_timestamp()});
+            auto res = e.execute_cql("SELECT a FROM t WHERE v = 1", std::move(qo)).get0();
+            auto rows = dynamic_pointer_cast<cql_transport::messages::result_message::rows>(res);
+            for (const auto& row : rows->rs().result_set().rows()) {
+                paged.push_back(row[0]);
+            }
+            auto state = rows->rs().get_metadata().paging_state();
+            if (!state || !rows->rs().get_metadata().flags().contains(cql3::metadata::flag::HAS_MORE_PAGES)) {
+                break;
+            }
+            paging_state = make_lw_shared<service::pager::paging_state>(*state);
+        }
+        std::sort(paged.begin(), paged.end());
+        BOOST_REQUIRE(paged == std::vector<bytes_opt>({int32_type->decompose(10), int32_type->decompose(40)}));
+    });
+}
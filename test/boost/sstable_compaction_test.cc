@@ -30,6 +30,7 @@
 #include <seastar/core/seastar.hh>
 #include <seastar/core/do_with.hh>
 #include "compaction/compaction_manager.hh"
+#include "locator/token_metadata.hh"
 #include "test/lib/tmpdir.hh"
 #include "dht/i_partitioner.hh"
 #include "dht/murmur3_partitioner.hh"
@@ -1064,6 +1065,114 @@ SEASTAR_TEST_CASE(check_overlapping) {
   });
 }
 
+// Compacting complementary sub-ranges of the same input yields all the
+// partitions, each from exactly one of the compactions.
+SEASTAR_TEST_CASE(sub_range_compaction_test) {
+    BOOST_REQUIRE(smp::count == 1);
+    return test_env::do_with_async([] (test_env& env) {
+        auto s = schema_builder("tests", "sub_range_compaction_test")
+                .with_column("id", utf8_type, column_kind::partition_key)
+                .with_column("value", int32_type).build();
+
+        auto tmp = tmpdir();
+        auto sst_gen = [&env, s, &tmp, gen = make_lw_shared<unsigned>(1)] () mutable {
+            return env.make_sstable(s, tmp.path().string(), (*gen)++, sstables::get_highest_sstable_version(), big);
+        };
+
+        auto keys = token_generation_for_current_shard(4);
+        auto make_insert = [&] (const sstring& key, api::timestamp_type ts) {
+            mutation m(s, partition_key::from_exploded(*s, {to_bytes(key)}));
+            m.set_clustered_cell(clustering_key::make_empty(), bytes("value"), data_value(int32_t(ts)), ts);
+            return m;
+        };
+        std::vector<mutation> first, second, merged;
+        for (auto& [key, token] : keys) {
+            first.push_back(make_insert(key, 1));
+            second.push_back(make_insert(key, 2));
+            merged.push_back(first.back() + second.back());
+        }
+        auto input = std::vector<shared_sstable>{make_sstable_containing(sst_gen, first), make_sstable_containing(sst_gen, second)};
+
+        auto compact = [&] (dht::partition_range range) {
+            column_family_for_tests cf(env.manager(), s);
+            auto stop_cf = deferred_stop(cf);
+            for (auto&& sst : input) {
+                column_family_test(cf).add_sstable(sst).get();
+            }
+            auto desc = sstables::compaction_descriptor(input, default_priority_class());
+            desc.sub_range = std::move(range);
+            auto res = compact_sstables(cf.get_compaction_manager(), std::move(desc), *cf, sst_gen).get0();
+            BOOST_REQUIRE_EQUAL(res.new_sstables.size(), 1);
+            return res.new_sstables.front();
+        };
+
+        auto split = dht::ring_position::starting_at(keys[2].second);
+        assert_that(sstable_reader(compact(dht::partition_range::make_ending_with({split, false})), s, env.make_reader_permit()))
+                .produces(merged[0])
+                .produces(merged[1])
+                .produces_end_of_stream();
+        assert_that(sstable_reader(compact(dht::partition_range::make_starting_with({split, true})), s, env.make_reader_permit()))
+                .produces(merged[2])
+                .produces(merged[3])
+                .produces_end_of_stream();
+    });
+}
+
+// Disjoint sstables with nothing to purge are moved to the target level
+// without being rewritten.
+SEASTAR_TEST_CASE(move_without_rewrite_test) {
+    BOOST_REQUIRE(smp::count == 1);
+    return test_env::do_with_async([] (test_env& env) {
+        auto s = schema_builder("tests", "move_without_rewrite_test")
+                .with_column("id", utf8_type, column_kind::partition_key)
+                .with_column("value", int32_type).build();
+
+        auto tmp = tmpdir();
+        auto sst_gen = [&env, s, &tmp, gen = make_lw_shared<unsigned>(1)] () mutable {
+            return env.make_sstable(s, tmp.path().string(), (*gen)++, env.manager().get_highest_supported_format(), big);
+        };
+
+        auto keys = token_generation_for_current_shard(4);
+        std::vector<mutation> muts;
+        for (auto& [key, token] : keys) {
+            mutation m(s, partition_key::from_exploded(*s, {to_bytes(key)}));
+            m.set_clustered_cell(clustering_key::make_empty(), bytes("value"), data_value(int32_t(1)), 1);
+            muts.push_back(std::move(m));
+        }
+        auto input = std::vector<shared_sstable>{
+            make_sstable_containing(sst_gen, {muts[0], muts[1]}),
+            make_sstable_containing(sst_gen, {muts[2], muts[3]}),
+        };
+
+        auto compact = [&] (std::vector<shared_sstable> to_compact) {
+            column_family_for_tests cf(env.manager(), s);
+            auto stop_cf = deferred_stop(cf);
+            for (auto&& sst : input) {
+                column_family_test(cf).add_sstable(sst).get();
+            }
+            return compact_sstables(cf.get_compaction_manager(), sstables::compaction_descriptor(std::move(to_compact), default_priority_class(), 1), *cf, sst_gen).get0().new_sstables;
+        };
+
+        auto moved = compact(input);
+        BOOST_REQUIRE_EQUAL(moved.size(), input.size());
+        for (size_t i = 0; i < moved.size(); ++i) {
+            BOOST_REQUIRE_EQUAL(moved[i]->get_sstable_level(), 1);
+            BOOST_REQUIRE(moved[i]->generation() != input[i]->generation());
+            // The data file is the very same.
+            BOOST_REQUIRE_EQUAL(moved[i]->data_size(), input[i]->data_size());
+            BOOST_REQUIRE(input[i]->get_sstable_level() == 0);
+        }
+        assert_that(sstable_reader(moved[1], s, env.make_reader_permit()))
+                .produces(muts[2])
+                .produces(muts[3])
+                .produces_end_of_stream();
+
+        // Overlapping sstables are compacted into one.
+        auto overlapping = make_sstable_containing(sst_gen, {muts[1], muts[2]});
+        BOOST_REQUIRE_EQUAL(compact({input[0], overlapping}).size(), 1);
+    });
+}
+
 SEASTAR_TEST_CASE(tombstone_purge_test) {
     BOOST_REQUIRE(smp::count == 1);
     return test_env::do_with_async([] (test_env& env) {
@@ -1729,6 +1838,62 @@ SEASTAR_TEST_CASE(time_window_strategy_correctness_test) {
 
 // Check that TWCS will only perform size-tiered on the current window and also
 // the past windows that were already previously compacted into a single SSTable.
+// Sstables spanning several windows, like those a flush writes the late
+// writes to old windows into, are compacted among themselves, lazily.
+SEASTAR_TEST_CASE(time_window_strategy_overflow_test) {
+    using namespace std::chrono;
+
+    return test_env::do_with_async([] (test_env& env) {
+        auto s = schema_builder("tests", "time_window_strategy_overflow_test")
+                .with_column("id", utf8_type, column_kind::partition_key)
+                .with_column("value", int32_type).build();
+
+        auto tmp = tmpdir();
+        auto sst_gen = [&env, s, &tmp, gen = make_lw_shared<unsigned>(1)] () mutable {
+            return env.make_sstable(s, tmp.path().string(), (*gen)++, sstables::get_highest_sstable_version(), big);
+        };
+        auto make_insert = [&] (sstring key, api::timestamp_type t) {
+            mutation m(s, partition_key::from_exploded(*s, {to_bytes(key)}));
+            m.set_clustered_cell(clustering_key::make_empty(), bytes("value"), data_value(int32_t(1)), t);
+            return m;
+        };
+
+        auto cs = sstables::make_compaction_strategy(sstables::compaction_strategy_type::time_window,
+                {{"compaction_window_unit", "HOURS"}, {"compaction_window_size", "1"}});
+        api::timestamp_type now = api::timestamp_clock::now().time_since_epoch().count();
+        auto hours_ago = [now] (int n) {
+            return now - duration_cast<microseconds>(hours(n)).count();
+        };
+
+        std::vector<shared_sstable> overflow;
+        for (int i = 0; i < 4; ++i) {
+            overflow.push_back(make_sstable_containing(sst_gen, {
+                make_insert(format("old{}", i), hours_ago(5)),
+                make_insert(format("late{}", i), hours_ago(3)),
+            }));
+        }
+        auto current = make_sstable_containing(sst_gen, {make_insert("current", now)});
+        auto candidates = overflow;
+        candidates.push_back(current);
+
+        column_family_for_tests cf(env.manager(), s);
+        auto close_cf = deferred_stop(cf);
+        auto table_s = make_table_state_for_test(cf, env);
+        auto control = make_strategy_control_for_test(false);
+
+        auto desc = cs.get_sstables_for_compaction(*table_s, *control, candidates);
+        BOOST_REQUIRE(boost::copy_range<std::unordered_set<shared_sstable>>(desc.sstables) ==
+                boost::copy_range<std::unordered_set<shared_sstable>>(overflow));
+
+        // Not enough overflow sstables to be worth merging yet.
+        candidates.erase(candidates.begin());
+        BOOST_REQUIRE(cs.get_sstables_for_compaction(*table_s, *control, candidates).sstables.empty());
+
+        // Windows are compacted independently by major compaction.
+        BOOST_REQUIRE_EQUAL(cs.split_major_compaction_input(candidates).size(), 2);
+    });
+}
+
 SEASTAR_TEST_CASE(time_window_strategy_size_tiered_behavior_correctness) {
     using namespace std::chrono;
 
@@ -1896,6 +2061,73 @@ SEASTAR_TEST_CASE(size_tiered_beyond_max_threshold_test) {
   });
 }
 
+SEASTAR_TEST_CASE(size_tiered_duplicate_keys_per_byte_test) {
+    return test_env::do_with_async([] (test_env& env) {
+        auto s = schema_builder("tests", "size_tiered_duplicate_keys_per_byte_test")
+                .with_column("id", utf8_type, column_kind::partition_key)
+                .with_column("value", int32_type).build();
+        auto tmp = tmpdir();
+        auto sst_gen = [&env, s, &tmp, gen = make_lw_shared<unsigned>(1)] () mutable {
+            return env.make_sstable(s, tmp.path().string(), (*gen)++, sstables::get_highest_sstable_version(), big);
+        };
+        auto keys = token_generation_for_current_shard(8);
+        auto make_sst = [&] (size_t first, size_t last) {
+            std::vector<mutation> muts;
+            for (auto i = first; i < last; ++i) {
+                mutation m(s, partition_key::from_exploded(*s, {to_bytes(keys[i].first)}));
+                m.set_clustered_cell(clustering_key::make_empty(), bytes("value"), data_value(int32_t(i)), 1);
+                muts.push_back(std::move(m));
+            }
+            return make_sstable_containing(sst_gen, std::move(muts));
+        };
+        auto a = make_sst(0, 4);
+        auto a_overwrite = make_sst(0, 4);
+        auto b = make_sst(4, 8);
+
+        auto duplicates = sstables::size_tiered_compaction_strategy::duplicate_keys_per_byte({a, a_overwrite});
+        BOOST_REQUIRE_GT(duplicates, 0);
+        BOOST_REQUIRE_GT(duplicates, sstables::size_tiered_compaction_strategy::duplicate_keys_per_byte({a, b}));
+        BOOST_REQUIRE_EQUAL(sstables::size_tiered_compaction_strategy::duplicate_keys_per_byte({a}), 0);
+    });
+}
+
+SEASTAR_TEST_CASE(incremental_compaction_strategy_runs_test) {
+  return test_env::do_with([] (test_env& env) {
+    column_family_for_tests cf(env.manager());
+    auto s = cf.schema();
+    auto cs = sstables::make_compaction_strategy(sstables::compaction_strategy_type::incremental, {{"sstable_size_in_mb", "1"}});
+    auto keys = token_generation_for_current_shard(8);
+
+    // min_threshold runs of two fragments each, and a much larger run. The
+    // fragments are similar in size to the large run, but the runs are not.
+    std::vector<sstables::shared_sstable> candidates;
+    int64_t gen = 1;
+    int min_threshold = s->min_compaction_threshold();
+    for (int r = 0; r < min_threshold; ++r) {
+        auto id = sstables::run_id::create_random_id();
+        for (int f = 0; f < 2; ++f) {
+            auto sst = sstable_for_overlapping_test(env, s, gen++, keys[f * 4].first, keys[f * 4 + 3].first);
+            sstables::test(sst).set_data_file_size(1024);
+            sstables::test(sst).set_run_identifier(id);
+            candidates.push_back(std::move(sst));
+        }
+    }
+    auto large = sstable_for_overlapping_test(env, s, gen++, keys[0].first, keys[7].first);
+    sstables::test(large).set_data_file_size(uint64_t(1) << 30);
+    candidates.push_back(large);
+
+    auto table_s = make_table_state_for_test(cf, env);
+    auto strategy_c = make_strategy_control_for_test(false);
+    auto desc = cs.get_sstables_for_compaction(*table_s, *strategy_c, candidates);
+    BOOST_REQUIRE_EQUAL(desc.sstables.size(), size_t(min_threshold * 2));
+    BOOST_REQUIRE_EQUAL(desc.fan_in(), unsigned(min_threshold));
+    BOOST_REQUIRE(std::find(desc.sstables.begin(), desc.sstables.end(), large) == desc.sstables.end());
+    // The output is a run of fragments of sstable_size_in_mb.
+    BOOST_REQUIRE_EQUAL(desc.max_sstable_bytes, uint64_t(1) << 20);
+    return cf.stop_and_keep_alive();
+  });
+}
+
 SEASTAR_TEST_CASE(sstable_expired_data_ratio) {
     return test_env::do_with_async([] (test_env& env) {
         auto tmp = tmpdir();
@@ -4411,6 +4643,66 @@ SEASTAR_TEST_CASE(stcs_reshape_overlapping_test) {
     });
 }
 
+SEASTAR_TEST_CASE(test_stcs_single_key_reader_clustering_filtering) {
+    return test_env::do_with_async([] (test_env& env) {
+        auto builder = schema_builder("tests", "stcs_single_key_reader_clustering_filtering")
+                .with_column("pk", int32_type, column_kind::partition_key)
+                .with_column("ck", int32_type, column_kind::clustering_key)
+                .with_column("v", int32_type);
+        builder.set_compaction_strategy(sstables::compaction_strategy_type::size_tiered);
+        auto s = builder.build();
+
+        auto tmp = tmpdir();
+        auto sst_gen = [&env, s, &tmp, gen = make_lw_shared<unsigned>(1)]() {
+            return env.make_sstable(s, tmp.path().string(), (*gen)++, sstables::sstable::version_types::md, big);
+        };
+
+        auto make_row = [&] (int32_t pk, int32_t ck) {
+            mutation m(s, partition_key::from_single_value(*s, int32_type->decompose(pk)));
+            m.set_clustered_cell(clustering_key::from_single_value(*s, int32_type->decompose(ck)), to_bytes("v"), int32_t(ck), api::new_timestamp());
+            return m;
+        };
+
+        auto sst1 = make_sstable_containing(sst_gen, {make_row(0, 0)});
+        auto sst2 = make_sstable_containing(sst_gen, {make_row(0, 10)});
+        auto dkey = sst1->get_first_decorated_key();
+
+        auto cm = compaction_manager_for_testing();
+        replica::column_family::config cfg = env.make_table_config();
+        replica::cf_stats cf_stats{0};
+        cfg.cf_stats = &cf_stats;
+        cfg.datadir = tmp.path().string();
+        auto tracker = make_lw_shared<cache_tracker>();
+        cell_locker_stats cl_stats;
+        replica::column_family cf(s, cfg, replica::column_family::no_commitlog(), *cm, env.manager(), cl_stats, *tracker);
+        cf.mark_ready_for_writes();
+        cf.start();
+
+        auto cs = sstables::make_compaction_strategy(sstables::compaction_strategy_type::size_tiered, {});
+        auto set = cs.make_sstable_set(s);
+        set.insert(std::move(sst1));
+        set.insert(std::move(sst2));
+
+        reader_permit permit = env.make_reader_permit();
+        utils::estimated_histogram eh;
+        auto pr = dht::partition_range::make_singular(dkey);
+        auto slice = partition_slice_builder(*s)
+                    .with_range(query::clustering_range::make_singular(clustering_key_prefix::from_single_value(*s, int32_type->decompose(10))))
+                    .build();
+
+        auto reader = set.create_single_key_sstable_reader(
+                &cf, s, permit, eh, pr, slice, default_priority_class(),
+                tracing::trace_state_ptr(), ::streamed_mutation::forwarding::no,
+                ::mutation_reader::forwarding::no);
+        auto close_reader = deferred_close(reader);
+        assert_that(std::move(reader)).produces(make_row(0, 10)).produces_end_of_stream();
+
+        // Only the sstable with the row is read.
+        BOOST_REQUIRE_EQUAL(cf_stats.sstables_checked_by_clustering_filter, 2);
+        BOOST_REQUIRE_EQUAL(cf_stats.surviving_sstables_after_clustering_filter, 1);
+    });
+}
+
 // Regression test for #8432
 SEASTAR_TEST_CASE(test_twcs_single_key_reader_filtering) {
     return test_env::do_with_async([] (test_env& env) {
@@ -4484,6 +4776,34 @@ SEASTAR_TEST_CASE(test_twcs_single_key_reader_filtering) {
     });
 }
 
+SEASTAR_THREAD_TEST_CASE(test_repair_history_map_find) {
+    auto range = [] (int64_t start, int64_t end) {
+        return locator::token_metadata::range_to_interval(dht::token_range(
+                dht::token_range::bound(dht::token::from_int64(start), false),
+                dht::token_range::bound(dht::token::from_int64(end), true)));
+    };
+    auto t1 = gc_clock::time_point(gc_clock::duration(100));
+    auto t2 = gc_clock::time_point(gc_clock::duration(200));
+
+    repair_history_map m;
+    m.update(range(0, 100), t1);
+    m.update(range(100, 200), t1);
+    // Adjacent ranges repaired at the same time are coalesced.
+    BOOST_REQUIRE_EQUAL(m.map.iterative_size(), 1);
+
+    BOOST_REQUIRE(!m.find(dht::token::from_int64(0)));
+    BOOST_REQUIRE(m.find(dht::token::from_int64(1)) == t1);
+    BOOST_REQUIRE(m.find(dht::token::from_int64(150)) == t1);
+    BOOST_REQUIRE(!m.find(dht::token::from_int64(201)));
+
+    // Updates invalidate the segment remembered by find().
+    BOOST_REQUIRE(m.find(dht::token::from_int64(150)) == t1);
+    m.update(range(120, 180), t2);
+    BOOST_REQUIRE(m.find(dht::token::from_int64(150)) == t2);
+    BOOST_REQUIRE(m.find(dht::token::from_int64(110)) == t1);
+    BOOST_REQUIRE(m.find(dht::token::from_int64(190)) == t1);
+}
+
 SEASTAR_TEST_CASE(max_ongoing_compaction_test) {
     return test_env::do_with_async([] (test_env& env) {
         BOOST_REQUIRE(smp::count == 1);
@@ -4858,6 +5178,64 @@ SEASTAR_TEST_CASE(test_major_does_not_miss_data_in_memtable) {
     });
 }
 
+// An sstable of expired data, which doesn't overlap anything older, is
+// garbage collected on its own.
+SEASTAR_TEST_CASE(tombstone_gc_compaction_test) {
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        e.execute_cql("create table ks.queue (pk int primary key, v int) with gc_grace_seconds = 0 and "
+                "compaction = {'class': 'SizeTieredCompactionStrategy', 'tombstone_compaction_interval': '0'}").get();
+        auto& db = e.local_db();
+        auto& t = db.find_column_family("ks", "queue");
+        // Keep regular compaction from picking the sstable first.
+        t.disable_auto_compaction().get();
+        for (int i = 0; i < 10; ++i) {
+            e.execute_cql(format("insert into ks.queue (pk, v) values ({}, {}) using ttl 1", i, i)).get();
+        }
+        t.flush().get();
+        BOOST_REQUIRE_EQUAL(t.get_sstables()->size(), 1);
+        // Let the cells expire.
+        sleep(std::chrono::seconds(2)).get();
+
+        auto& cm = db.get_compaction_manager();
+        auto stats = cm.get_stats();
+        cm.perform_tombstone_gc_compaction(t.as_table_state()).get();
+        BOOST_REQUIRE_EQUAL(cm.get_stats().tombstone_gc_compactions, stats.tombstone_gc_compactions + 1);
+        BOOST_REQUIRE_GT(cm.get_stats().tombstone_gc_tombstones_purged, stats.tombstone_gc_tombstones_purged);
+        BOOST_REQUIRE_EQUAL(t.get_sstables()->size(), 0);
+    });
+}
+
+SEASTAR_TEST_CASE(read_amplification_gain_test) {
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        auto& db = e.local_db();
+        auto populate = [&] (sstring name) -> replica::table& {
+            e.execute_cql(format("create table ks.{} (pk int, ck int, v int, primary key (pk, ck))", name)).get();
+            auto& t = db.find_column_family("ks", name);
+            t.disable_auto_compaction().get();
+            for (int i = 0; i < 4; ++i) {
+                e.execute_cql(format("insert into ks.{} (pk, ck, v) values (0, {}, {})", name, i, i)).get();
+                t.flush().get();
+            }
+            return t;
+        };
+        auto& read = populate("read");
+        auto& unread = populate("unread");
+        for (int i = 0; i < 10; ++i) {
+            e.execute_cql("select * from ks.read where pk = 0").get();
+        }
+        // Let some time pass for the read rate.
+        sleep(std::chrono::milliseconds(100)).get();
+
+        auto& cm = db.get_compaction_manager();
+        auto gain = [&] (replica::table& t) {
+            auto sstables = boost::copy_range<std::vector<sstables::shared_sstable>>(*t.get_sstables());
+            return cm.read_amplification_gain(t.as_table_state(), sstables::compaction_descriptor(std::move(sstables), default_priority_class()));
+        };
+        BOOST_REQUIRE_GT(gain(read), 0);
+        BOOST_REQUIRE_EQUAL(gain(unread), 0);
+    });
+}
+
 SEASTAR_TEST_CASE(simple_backlog_controller_test) {
     auto run_controller_test = [] (sstables::compaction_strategy_type compaction_strategy_type, test_env& env) {
         /////////////
@@ -3391,3 +3391,52 @@ SEASTAR_TEST_CASE(find_first_position_in_partition_from_sstable_test) {
         }
     });
 }
+
+SEASTAR_TEST_CASE(test_row_bloom_filter) {
+    return test_env::do_with_async([] (test_env& env) {
+        simple_schema table;
+        const unsigned rows_per_part = 10;
+
+        auto plain_key = table.make_pkey(0);
+        auto deleted_key = table.make_pkey(1);
+        mutation plain(table.schema(), plain_key);
+        mutation deleted(table.schema(), deleted_key);
+        for (unsigned i = 0; i < rows_per_part; ++i) {
+            table.add_row(plain, table.make_ckey(i), "v");
+            table.add_row(deleted, table.make_ckey(i), "v");
+        }
+        table.delete_range(deleted, table.make_ckey_range(rows_per_part, 2 * rows_per_part));
+        std::vector<mutation> muts{plain, deleted};
+        std::sort(muts.begin(), muts.end(), mutation_decorated_key_less_comparator());
+
+        tmpdir dir;
+        sstable_writer_config cfg = env.manager().configure_writer();
+        cfg.row_bloom_filter = true;
+        auto sst = make_sstable_easy(env, dir.path(), make_flat_mutation_reader_from_mutations_v2(table.schema(), env.make_reader_permit(), muts), cfg);
+        BOOST_REQUIRE(sst->has_row_bloom_filter());
+        BOOST_REQUIRE_GT(sst->row_bloom_filter_memory_size(), 0);
+        // The filter stays visible in the scylla metadata, without its bits.
+        auto* rf = sst->get_scylla_metadata()->data.get<sstables::scylla_metadata_type::RowBloomFilter, sstables::filter>();
+        BOOST_REQUIRE(rf);
+        BOOST_REQUIRE_GT(rf->hashes, 0);
+        BOOST_REQUIRE(rf->buckets.elements.empty());
+
+        auto may_contain = [&] (const dht::decorated_key& dk, unsigned ck) {
+            query::clustering_row_ranges ranges{query::clustering_range::make_singular(table.make_ckey(ck))};
+            return sst->row_bloom_filter_may_contain(sstables::key::from_partition_key(*table.schema(), dk.key()), ranges);
+        };
+        unsigned false_positives = 0;
+        for (unsigned i = 0; i < rows_per_part; ++i) {
+            BOOST_REQUIRE(may_contain(plain_key, i));
+            BOOST_REQUIRE(may_contain(deleted_key, i));
+            // Rows of a partition with range tombstones can't be ruled out.
+            BOOST_REQUIRE(may_contain(deleted_key, rows_per_part + i));
+            false_positives += may_contain(plain_key, rows_per_part + i);
+        }
+        BOOST_REQUIRE_LT(false_positives, rows_per_part / 2);
+
+        cfg.row_bloom_filter = false;
+        auto no_filter = make_sstable_easy(env, dir.path(), make_flat_mutation_reader_from_mutations_v2(table.schema(), env.make_reader_permit(), muts), cfg, 2);
+        BOOST_REQUIRE(!no_filter->has_row_bloom_filter());
+    });
+}
@@ -13,6 +13,8 @@
 #include "sstables/sstable_set.hh"
 #include "sstables/sstables.hh"
 #include "test/lib/simple_schema.hh"
+#include "test/lib/sstable_utils.hh"
+#include "test/lib/random_utils.hh"
 #include "readers/from_mutations_v2.hh"
 
 static sstables::sstable_set make_sstable_set(schema_ptr schema, lw_shared_ptr<sstable_list> all = {}, bool use_level_metadata = true) {
@@ -85,3 +87,76 @@ SEASTAR_TEST_CASE(test_time_series_sstable_set_read_modify_write) {
         return make_ready_future<>();
     });
 }
+
+SEASTAR_TEST_CASE(test_leveled_sstable_set_selection) {
+    return test_env::do_with_async([] (test_env& env) {
+        simple_schema ss;
+        auto s = ss.schema();
+        const unsigned nr_keys = 64;
+        auto keys = make_local_keys(nr_keys, s);
+        auto dks = boost::copy_range<std::vector<dht::decorated_key>>(keys | boost::adaptors::transformed([&] (const sstring& k) {
+            return ss.make_pkey(k);
+        }));
+
+        int64_t gen = 1;
+        auto make_sst = [&] (unsigned first, unsigned last, uint32_t level) {
+            auto sst = env.make_sstable(s, "", gen++, sstables::get_highest_sstable_version(), sstables::sstable::format_types::big);
+            sstables::test(sst).set_values_for_leveled_strategy(0, level, 0, keys[first], keys[last]);
+            return sst;
+        };
+
+        auto leveled = sstables::sstable_set(std::make_unique<leveled_sstable_set>(s), s);
+        auto reference = make_sstable_set(s, make_lw_shared<sstable_list>());
+        auto insert = [&] (shared_sstable sst) {
+            leveled.insert(sst);
+            reference.insert(sst);
+        };
+        std::vector<shared_sstable> erasable;
+        for (unsigned i = 0; i < 4; ++i) {
+            auto first = tests::random::get_int<unsigned>(0, nr_keys - 1);
+            insert(make_sst(first, tests::random::get_int<unsigned>(first, nr_keys - 1), 0));
+        }
+        for (unsigned i = 0; i + 1 < nr_keys; i += 2) {
+            insert(make_sst(i, i + 1, 1));
+        }
+        for (unsigned i = 0; i + 2 < nr_keys; i += 4) {
+            auto sst = make_sst(i, i + 2, 2);
+            erasable.push_back(sst);
+            insert(sst);
+        }
+        // Overlaps with other sstables of its level.
+        insert(make_sst(1, 5, 2));
+        // Shares a boundary with the previous sstable of its level.
+        insert(make_sst(2, 3, 3));
+        insert(make_sst(3, 7, 3));
+
+        auto gens = [] (const std::vector<shared_sstable>& ssts) {
+            return boost::copy_range<std::set<int64_t>>(ssts | boost::adaptors::transformed([] (const shared_sstable& sst) {
+                return generation_value(sst->generation());
+            }));
+        };
+        auto check = [&] {
+            BOOST_REQUIRE_EQUAL(leveled.all()->size(), reference.all()->size());
+            for (unsigned i = 0; i < nr_keys; ++i) {
+                auto pr = dht::partition_range::make_singular(dks[i]);
+                BOOST_REQUIRE_EQUAL(gens(leveled.select(pr)), gens(reference.select(pr)));
+                auto j = tests::random::get_int<unsigned>(i, nr_keys - 1);
+                auto range = dht::partition_range::make({dks[i], j == i || tests::random::get_bool()}, {dks[j], j == i || tests::random::get_bool()});
+                BOOST_REQUIRE_EQUAL(gens(leveled.select(range)), gens(reference.select(range)));
+            }
+            BOOST_REQUIRE_EQUAL(gens(leveled.select(query::full_partition_range)), gens(reference.select(query::full_partition_range)));
+
+            auto sel = leveled.make_incremental_selector();
+            for (unsigned i = 0; i < nr_keys; ++i) {
+                auto selection = sel.select(dks[i]);
+                BOOST_REQUIRE_EQUAL(gens(selection.sstables), gens(reference.select(dht::partition_range::make_singular(dks[i]))));
+            }
+        };
+        check();
+        for (auto& sst : erasable) {
+            leveled.erase(sst);
+            reference.erase(sst);
+        }
+        check();
+    });
+}
@@ -17,6 +17,7 @@
 #include "sstables/sstables.hh"
 #include "compaction/compaction_manager.hh"
 #include "sstables/key.hh"
+#include "sstables/downsampling.hh"
 #include "test/lib/sstable_utils.hh"
 #include <seastar/testing/test_case.hh>
 #include "schema.hh"
@@ -29,6 +30,7 @@
 #include "test/lib/test_services.hh"
 #include "cell_locking.hh"
 #include "sstables/sstable_mutation_reader.hh"
+#include "test/lib/random_utils.hh"
 
 #include <boost/range/combine.hpp>
 
@@ -170,6 +172,68 @@ SEASTAR_TEST_CASE(missing_summary_first_last_sane) {
     });
 }
 
+SEASTAR_TEST_CASE(summary_token_index_narrows_lookup) {
+    sstables::summary s;
+    std::vector<int64_t> tokens;
+    for (int i = 0; i < 1000; ++i) {
+        tokens.push_back(tests::random::get_int<int64_t>(std::numeric_limits<int64_t>::min() + 1, std::numeric_limits<int64_t>::max()));
+    }
+    std::sort(tokens.begin(), tokens.end());
+    for (auto t : tokens) {
+        s.entries.push_back({dht::token(dht::token::kind::key, t), bytes_view(), 0});
+    }
+    co_await s.build_token_index();
+    BOOST_REQUIRE(!s.token_index.empty());
+
+    auto token_less = [] (const summary_entry& e, const dht::token& t) { return e.token < t; };
+    auto check = [&] (dht::token t) {
+        auto [first, last] = s.token_index_range(t);
+        BOOST_REQUIRE_LE(first, last);
+        auto expected = std::distance(s.entries.begin(), std::lower_bound(s.entries.begin(), s.entries.end(), t, token_less));
+        auto actual = std::distance(s.entries.begin(), std::lower_bound(s.entries.begin() + first, s.entries.begin() + last, t, token_less));
+        BOOST_REQUIRE_EQUAL(expected, actual);
+    };
+    for (auto t : tokens) {
+        check(dht::token(dht::token::kind::key, t));
+        if (t < std::numeric_limits<int64_t>::max()) {
+            check(dht::token(dht::token::kind::key, t + 1));
+        }
+    }
+    for (int i = 0; i < 1000; ++i) {
+        check(dht::token(dht::token::kind::key, tests::random::get_int<int64_t>()));
+    }
+    check(dht::minimum_token());
+    check(dht::maximum_token());
+}
+
+SEASTAR_TEST_CASE(summary_downsampling_keeps_original_indexes) {
+    sstables::summary s;
+    s.header.min_index_interval = 128;
+    s.header.sampling_level = downsampling::BASE_SAMPLING_LEVEL;
+    const int64_t count = downsampling::BASE_SAMPLING_LEVEL * 4;
+    for (int64_t i = 0; i < count; ++i) {
+        auto key = s.add_summary_data(int64_type->decompose(i));
+        s.entries.push_back({dht::token(dht::token::kind::key, i), key, uint64_t(i)});
+    }
+    s.header.size = s.entries.size();
+
+    for (int level : {96, 64, 32, 1}) {
+        co_await downsample_summary(s, level);
+        BOOST_REQUIRE_EQUAL(s.header.sampling_level, uint32_t(level));
+        BOOST_REQUIRE_EQUAL(s.entries.size(), size_t(count * level / downsampling::BASE_SAMPLING_LEVEL));
+        BOOST_REQUIRE_EQUAL(s.header.size, s.entries.size());
+        BOOST_REQUIRE_EQUAL(s.positions.size(), s.entries.size());
+        // The entries kept are the ones get_effective_index_interval_after_index()
+        // expects of a summary of this sampling level.
+        const auto& original_indexes = downsampling::get_original_indexes(level);
+        for (size_t i = 0; i < s.entries.size(); ++i) {
+            uint64_t expected = (i / level) * downsampling::BASE_SAMPLING_LEVEL + original_indexes[i % level];
+            BOOST_REQUIRE_EQUAL(s.entries[i].position, expected);
+            BOOST_REQUIRE(s.entries[i].key == bytes_view(int64_type->decompose(int64_t(expected))));
+        }
+    }
+}
+
 static future<sstable_ptr> do_write_sst(test_env& env, schema_ptr schema, sstring load_dir, sstring write_dir, unsigned long generation) {
     return env.reusable_sst(std::move(schema), load_dir, generation).then([write_dir, generation] (sstable_ptr sst) {
         sstables::test(sst).change_generation_number(generation + 1);
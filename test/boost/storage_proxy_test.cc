@@ -15,6 +15,8 @@
 #include "test/lib/mutation_source_test.hh"
 #include "test/lib/result_set_assertions.hh"
 #include "service/storage_proxy.hh"
+#include "service/read_coalescing.hh"
+#include "service/replica_load.hh"
 #include "query_ranges_to_vnodes.hh"
 #include "partition_slice_builder.hh"
 #include "schema_builder.hh"
@@ -103,3 +105,256 @@ SEASTAR_TEST_CASE(test_get_restricted_ranges) {
         });
     });
 }
+
+SEASTAR_TEST_CASE(test_range_scan_concurrency_controller) {
+    using namespace std::chrono_literals;
+    using controller = service::range_scan_concurrency_controller;
+    constexpr uint64_t unlimited = std::numeric_limits<uint64_t>::max();
+
+    {
+        // Empty ranges grow the concurrency.
+        controller c(1024 * 1024);
+        BOOST_REQUIRE_EQUAL(c.concurrency(), 1);
+        c.on_round_completed(1, 0, 0, 0, 100, unlimited, 1ms, 10s);
+        BOOST_REQUIRE_EQUAL(c.concurrency(), controller::max_growth);
+        c.on_round_completed(controller::max_growth, 0, 0, 0, 100, unlimited, 1ms, 10s);
+        BOOST_REQUIRE_EQUAL(c.concurrency(), controller::max_growth * controller::max_growth);
+    }
+
+    {
+        // With a known density, the remaining limit is what matters.
+        controller c(1024 * 1024);
+        c.on_round_completed(1, 0, 0, 0, 100, unlimited, 1ms, 10s);
+        c.on_round_completed(4, 10, 10, 100, 90, unlimited, 1ms, 10s);
+        // 2 rows per range, 90 rows remaining, plus the margin.
+        BOOST_REQUIRE_EQUAL(c.concurrency(), 4 * controller::max_growth);
+        c.on_round_completed(16, 30, 30, 300, 1, unlimited, 1ms, 10s);
+        BOOST_REQUIRE_EQUAL(c.concurrency(), 1);
+    }
+
+    {
+        // The results of a round are expected to fit in the budget.
+        controller c(1000);
+        c.on_round_completed(1, 10, 10, 400, unlimited, unlimited, 1ms, 10s);
+        BOOST_REQUIRE_EQUAL(c.concurrency(), 2);
+    }
+
+    {
+        // Slow rounds back off.
+        controller c(1024 * 1024);
+        c.on_round_completed(1, 0, 0, 0, 100, unlimited, 1ms, 10s);
+        c.on_round_completed(4, 0, 0, 0, 100, unlimited, 1ms, 10s);
+        BOOST_REQUIRE_EQUAL(c.concurrency(), 16);
+        c.on_round_completed(16, 0, 0, 0, 100, unlimited, 3s, 5s);
+        BOOST_REQUIRE_EQUAL(c.concurrency(), 8);
+    }
+
+    return make_ready_future<>();
+}
+
+SEASTAR_TEST_CASE(test_range_scan_context_cache) {
+    using namespace std::chrono_literals;
+    using cache_type = service::range_scan_context_cache;
+    const auto now = cache_type::clock_type::now();
+    const auto id = query_id::create_random_id();
+
+    service::range_scan_concurrency_controller c(1024 * 1024);
+    c.on_round_completed(1, 0, 0, 0, 100, 100, 1ms, 10s);
+    BOOST_REQUIRE_EQUAL(c.concurrency(), 4);
+
+    {
+        // The next page resumes with the concurrency, once.
+        cache_type cache;
+        cache.put(id, c, now);
+        auto resumed = cache.take(id, now + 1s);
+        BOOST_REQUIRE(resumed);
+        BOOST_REQUIRE_EQUAL(resumed->concurrency(), 4);
+        BOOST_REQUIRE(!cache.take(id, now + 1s));
+        BOOST_REQUIRE_EQUAL(cache.size(), 0);
+    }
+
+    {
+        // Scans which don't come back in time start over.
+        cache_type cache;
+        cache.put(id, c, now);
+        BOOST_REQUIRE(!cache.take(id, now + cache_type::ttl));
+        BOOST_REQUIRE_EQUAL(cache.size(), 0);
+    }
+
+    {
+        // Expired and excess entries are dropped, oldest first.
+        cache_type cache;
+        cache.put(id, c, now);
+        for (size_t i = 0; i < cache_type::max_entries; ++i) {
+            cache.put(query_id::create_random_id(), c, now + 1s);
+        }
+        BOOST_REQUIRE_EQUAL(cache.size(), cache_type::max_entries);
+        BOOST_REQUIRE(!cache.take(id, now + 1s));
+        cache.put(query_id::create_random_id(), c, now + cache_type::ttl + 1s);
+        BOOST_REQUIRE_EQUAL(cache.size(), 1);
+    }
+
+    return make_ready_future<>();
+}
+
+SEASTAR_TEST_CASE(test_row_level_read_repair_differing_ranges) {
+    auto s = schema_builder("ks", "cf")
+            .with_column("pk", int32_type, column_kind::partition_key)
+            .with_column("ck", int32_type, column_kind::clustering_key)
+            .with_column("v", int32_type, column_kind::regular_column)
+            .build();
+    auto ck = [&] (int i) {
+        return clustering_key::from_single_value(*s, int32_type->decompose(i));
+    };
+    auto block = [&] (int last, uint64_t hash) {
+        return service::clustering_block_digest{ck(last), hash, 100};
+    };
+    auto digests = [&] (std::vector<service::clustering_block_digest> blocks) {
+        return service::partition_block_digests{0, std::move(blocks), true};
+    };
+    const query::clustering_row_ranges full{query::clustering_range::make_open_ended_both_sides()};
+    auto check = [&] (const std::optional<service::differing_ranges>& result, const query::clustering_row_ranges& expected) {
+        BOOST_REQUIRE(result);
+        auto tri_cmp = clustering_key::tri_compare(*s);
+        BOOST_REQUIRE(std::equal(result->ranges.begin(), result->ranges.end(), expected.begin(), expected.end(),
+                [&] (const query::clustering_range& a, const query::clustering_range& b) { return a.equal(b, tri_cmp); }));
+    };
+
+    // Only the middle block differs.
+    auto result = service::find_differing_ranges(*s, full, {
+            digests({block(10, 1), block(20, 2), block(30, 3)}),
+            digests({block(10, 1), block(20, 4), block(30, 3)}),
+    });
+    check(result, {
+            query::clustering_range::make({ck(10), false}, {ck(20), true}),
+            query::clustering_range::make_starting_with({ck(30), false}),
+    });
+    BOOST_REQUIRE_EQUAL(result->same_size, 200);
+
+    // A missing row which ends a block changes only the blocks around it.
+    result = service::find_differing_ranges(*s, full, {
+            digests({block(10, 1), block(20, 2), block(30, 3)}),
+            digests({block(10, 1), block(30, 3)}),
+    });
+    check(result, {
+            query::clustering_range::make_starting_with({ck(10), false}),
+    });
+    result = service::find_differing_ranges(*s, full, {
+            digests({block(10, 1), block(20, 2), block(30, 3), block(40, 4)}),
+            digests({block(10, 1), block(30, 5), block(40, 4)}),
+    });
+    check(result, {
+            query::clustering_range::make({ck(10), false}, {ck(30), true}),
+            query::clustering_range::make_starting_with({ck(40), false}),
+    });
+
+    // Nothing to narrow down.
+    BOOST_REQUIRE(!service::find_differing_ranges(*s, full, {
+            digests({block(10, 1)}),
+            digests({block(10, 2)}),
+    }));
+    BOOST_REQUIRE(!service::find_differing_ranges(*s, full, {
+            digests({block(10, 1), block(20, 2)}),
+            digests({block(10, 1), block(20, 2)}),
+    }));
+    auto incomplete = digests({block(10, 1), block(20, 4)});
+    incomplete.complete = false;
+    BOOST_REQUIRE(!service::find_differing_ranges(*s, full, {
+            digests({block(10, 1), block(20, 2)}),
+            incomplete,
+    }));
+
+    return make_ready_future<>();
+}
+
+SEASTAR_TEST_CASE(test_read_coalescing_identical_reads) {
+    auto s = schema_builder("ks", "cf")
+            .with_column("pk", int32_type, column_kind::partition_key)
+            .with_column("ck", int32_type, column_kind::clustering_key)
+            .with_column("v", int32_type, column_kind::regular_column)
+            .build();
+    auto pr = [&] (int pk) {
+        return dht::partition_range::make_singular(dht::decorate_key(*s, partition_key::from_single_value(*s, int32_type->decompose(pk))));
+    };
+    auto ck = [&] (int i) {
+        return clustering_key::from_single_value(*s, int32_type->decompose(i));
+    };
+    auto cmd = [&] (query::clustering_row_ranges ranges, uint64_t row_limit = query::max_rows) {
+        auto slice = partition_slice_builder(*s).with_ranges(std::move(ranges)).build();
+        return query::read_command(s->id(), s->version(), std::move(slice), query::max_result_size(1 << 20), query::tombstone_limit::max,
+                query::row_limit(row_limit));
+    };
+    const auto cl = db::consistency_level::QUORUM;
+    const query::clustering_row_ranges full{query::clustering_range::make_open_ended_both_sides()};
+    const query::clustering_row_ranges from_10{query::clustering_range::make_starting_with({ck(10), true})};
+
+    auto a = cmd(full);
+    // The query time is not compared.
+    auto b = cmd(full);
+    b.timestamp = a.timestamp + std::chrono::seconds(1);
+    BOOST_REQUIRE(service::can_coalesce_read(a, {pr(1)}));
+    BOOST_REQUIRE(!service::can_coalesce_read(a, {pr(1), pr(2)}));
+    BOOST_REQUIRE(!service::can_coalesce_read(a, {query::full_partition_range}));
+    BOOST_REQUIRE(service::are_identical_reads(*s, a, pr(1), b, pr(1)));
+    BOOST_REQUIRE_EQUAL(service::coalesced_read_hash(a, pr(1), cl, 3), service::coalesced_read_hash(b, pr(1), cl, 3));
+
+    // Reads of other partitions, rows or limits are not identical.
+    BOOST_REQUIRE(!service::are_identical_reads(*s, a, pr(1), b, pr(2)));
+    BOOST_REQUIRE(!service::are_identical_reads(*s, a, pr(1), cmd(from_10), pr(1)));
+    BOOST_REQUIRE(!service::are_identical_reads(*s, cmd(from_10), pr(1), cmd({query::clustering_range::make_starting_with({ck(10), false})}), pr(1)));
+    BOOST_REQUIRE(service::are_identical_reads(*s, cmd(from_10), pr(1), cmd(from_10), pr(1)));
+    BOOST_REQUIRE(!service::are_identical_reads(*s, a, pr(1), cmd(full, 10), pr(1)));
+
+    // Timeouts of the same power of two are in the same class.
+    BOOST_REQUIRE_EQUAL(service::coalesced_read_timeout_class(std::chrono::milliseconds(5000)),
+            service::coalesced_read_timeout_class(std::chrono::milliseconds(4500)));
+    BOOST_REQUIRE_NE(service::coalesced_read_timeout_class(std::chrono::milliseconds(5000)),
+            service::coalesced_read_timeout_class(std::chrono::milliseconds(1000)));
+    return make_ready_future<>();
+}
+
+SEASTAR_TEST_CASE(test_replica_load_tracker) {
+    using namespace std::chrono_literals;
+    service::replica_load_tracker load;
+    const gms::inet_address a("127.0.0.1");
+    const gms::inet_address b("127.0.0.2");
+    auto now = service::replica_load_tracker::clock_type::now();
+
+    // Replicas without replies have no cost, and are never avoided.
+    BOOST_REQUIRE(!load.cost(a, now));
+    load.on_request(a);
+    load.on_completion(a, 1000us, now);
+    BOOST_REQUIRE(!load.prefer(a, b, now));
+    BOOST_REQUIRE(!load.prefer(b, a, now));
+
+    load.on_request(b);
+    load.on_completion(b, 1000us, now);
+    BOOST_REQUIRE_EQUAL(*load.cost(a, now), 1000);
+    // Equal, or close, costs don't prefer either replica.
+    BOOST_REQUIRE(!load.prefer(a, b, now));
+    load.on_request(b);
+    BOOST_REQUIRE_EQUAL(*load.cost(b, now), 2000);
+    BOOST_REQUIRE(load.prefer(a, b, now));
+    BOOST_REQUIRE(!load.prefer(b, a, now));
+    load.on_completion(b, std::nullopt, now);
+    BOOST_REQUIRE(!load.prefer(a, b, now));
+
+    // A slow reply moves the average towards it, more the later it comes.
+    load.on_request(b);
+    load.on_completion(b, 10000us, now + 100ms);
+    const double after_100ms = *load.cost(b, now + 100ms);
+    BOOST_REQUIRE_GT(after_100ms, 1000);
+    BOOST_REQUIRE_LT(after_100ms, 10000);
+    load.on_request(b);
+    load.on_completion(b, 10000us, now + 5s);
+    BOOST_REQUIRE_GT(*load.cost(b, now + 5s), 9900);
+    BOOST_REQUIRE(load.prefer(a, b, now + 1s));
+
+    // Old replies no longer tell the cost.
+    BOOST_REQUIRE(!load.cost(a, now + 3s));
+    BOOST_REQUIRE(!load.prefer(a, b, now + 3s));
+
+    load.drop(b);
+    BOOST_REQUIRE(!load.cost(b, now + 5s));
+    return make_ready_future<>();
+}
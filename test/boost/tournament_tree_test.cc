@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2022-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#define BOOST_TEST_MODULE core
+
+#include <boost/test/unit_test.hpp>
+#include <functional>
+#include <queue>
+#include <random>
+#include "utils/tournament_tree.hh"
+
+BOOST_AUTO_TEST_CASE(test_merges_sorted_streams) {
+    std::vector<std::vector<int>> streams(5);
+    for (int i = 0; i < 100; ++i) {
+        streams[i % 3 ? i % 5 : 0].push_back(i);
+    }
+
+    using entry = std::pair<int, size_t>;
+    utils::tournament_tree<entry, std::less<entry>> tree;
+    std::vector<size_t> positions(streams.size());
+    for (size_t s = 0; s < streams.size(); ++s) {
+        tree.push({streams[s][positions[s]++], s});
+    }
+
+    std::vector<int> merged;
+    while (!tree.empty()) {
+        auto [v, s] = tree.pop();
+        merged.push_back(v);
+        if (positions[s] < streams[s].size()) {
+            tree.push({streams[s][positions[s]++], s});
+        }
+    }
+    BOOST_REQUIRE_EQUAL(merged.size(), 100);
+    BOOST_REQUIRE(std::is_sorted(merged.begin(), merged.end()));
+}
+
+BOOST_AUTO_TEST_CASE(test_random_operations_match_priority_queue) {
+    std::mt19937 rng(0);
+    utils::tournament_tree<int, std::less<int>> tree;
+    std::priority_queue<int, std::vector<int>, std::greater<int>> expected;
+
+    for (int op = 0; op < 100000; ++op) {
+        if (expected.empty() || rng() % 3 != 0) {
+            int v = rng() % 1000;
+            tree.push(v);
+            expected.push(v);
+        } else {
+            BOOST_REQUIRE_EQUAL(tree.front(), expected.top());
+            BOOST_REQUIRE_EQUAL(tree.pop(), expected.top());
+            expected.pop();
+        }
+        BOOST_REQUIRE_EQUAL(tree.size(), expected.size());
+        if (rng() % 1000 == 0) {
+            tree.clear();
+            expected = {};
+            BOOST_REQUIRE(tree.empty());
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_for_each_visits_all_values) {
+    utils::tournament_tree<int, std::less<int>> tree;
+    for (int i = 0; i < 10; ++i) {
+        tree.push(i);
+    }
+    tree.pop();
+    tree.pop();
+
+    std::vector<int> values;
+    tree.for_each([&] (int v) { values.push_back(v); });
+    std::sort(values.begin(), values.end());
+    BOOST_REQUIRE(values == std::vector<int>({2, 3, 4, 5, 6, 7, 8, 9}));
+}
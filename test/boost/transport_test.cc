@@ -8,9 +8,12 @@
 
 #include <seastar/testing/thread_test_case.hh>
 
+#include "transport/compression_policy.hh"
 #include "transport/request.hh"
 #include "transport/response.hh"
 
+#include <zstd.h>
+
 #include "test/lib/random_utils.hh"
 
 namespace cql3 {
@@ -152,3 +155,61 @@ SEASTAR_THREAD_TEST_CASE(test_response_request_reader) {
     BOOST_CHECK_EQUAL(req.read_short(), 1);
     BOOST_CHECK_EQUAL(req.read_string(), "zed");
 }
+
+SEASTAR_THREAD_TEST_CASE(test_zstd_compressed_response) {
+    static constexpr auto version = 4;
+    auto make_response = [] {
+        auto res = cql_transport::response(0, cql_transport::cql_binary_opcode::RESULT, tracing::trace_state_ptr());
+        for (int i = 0; i < 100; ++i) {
+            res.write_string("a string which repeats");
+        }
+        return res;
+    };
+
+    auto plain = make_response();
+    auto plain_msg = plain.make_message(version, cql_transport::cql_compression::none).release();
+    auto plain_length = plain_msg.len();
+    auto plain_buf = fragmented_temporary_buffer(plain_msg.release(), plain_length);
+    auto plain_body = linearized(fragmented_temporary_buffer::view(plain_buf)).substr(9);
+
+    auto compressed = make_response();
+    auto msg = compressed.make_message(version, cql_transport::cql_compression::zstd, 3).release();
+    auto total_length = msg.len();
+    auto buf = fragmented_temporary_buffer(msg.release(), total_length);
+    auto frame = linearized(fragmented_temporary_buffer::view(buf));
+    BOOST_CHECK_EQUAL(unsigned(frame[1]), unsigned(cql_transport::cql_frame_flags::compression));
+    auto body = frame.substr(9);
+    BOOST_REQUIRE_LT(body.size(), plain_body.size());
+
+    bytes uncompressed(bytes::initialized_later(), plain_body.size());
+    auto ret = ZSTD_decompress(uncompressed.data(), uncompressed.size(), body.data(), body.size());
+    BOOST_REQUIRE(!ZSTD_isError(ret));
+    BOOST_CHECK_EQUAL(ret, plain_body.size());
+    BOOST_CHECK_EQUAL(uncompressed, plain_body);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_compression_policy) {
+    using cql_transport::compression_policy;
+    compression_policy policy;
+    BOOST_CHECK(!policy.should_compress(100, 256));
+    BOOST_CHECK(policy.should_compress(256, 256));
+
+    // Responses which compress well keep being compressed.
+    for (uint64_t size = 0; size < 2 * compression_policy::window_size; size += 1000) {
+        BOOST_REQUIRE(policy.should_compress(1000, 256));
+        policy.on_compressed(1000, 500, 0.9);
+    }
+    const auto saved = policy.bytes_saved();
+    BOOST_CHECK_GT(saved, 0);
+
+    // A window of responses which don't is followed by uncompressed ones.
+    for (uint64_t size = 0; size < compression_policy::window_size; size += 1000) {
+        BOOST_REQUIRE(policy.should_compress(1000, 256));
+        policy.on_compressed(1000, 1010, 0.9);
+    }
+    BOOST_CHECK_LT(policy.bytes_saved(), saved);
+    for (unsigned i = 0; i < compression_policy::backoff_responses; ++i) {
+        BOOST_REQUIRE(!policy.should_compress(1000, 256));
+    }
+    BOOST_CHECK(policy.should_compress(1000, 256));
+}
@@ -950,3 +950,30 @@ SEASTAR_TEST_CASE(test_simple_type_compatibility) {
     }
     return make_ready_future<>();
 }
+
+BOOST_AUTO_TEST_CASE(test_value_tri_comparator) {
+    auto check = [] (data_type type, std::vector<data_value> values) {
+        std::vector<bytes> serialized;
+        for (auto& v : values) {
+            serialized.push_back(v.serialize_nonnull());
+        }
+        serialized.push_back(bytes());
+        for (auto t : {type, data_type(reversed_type_impl::get_instance(type))}) {
+            value_tri_comparator cmp(*t);
+            for (auto& v1 : serialized) {
+                for (auto& v2 : serialized) {
+                    BOOST_REQUIRE(cmp(bytes_view(v1), bytes_view(v2)) == t->compare(v1, v2));
+                    BOOST_REQUIRE(cmp(managed_bytes_view(v1), managed_bytes_view(v2)) == t->compare(v1, v2));
+                }
+            }
+        }
+    };
+
+    check(int32_type, {int32_t(-1), int32_t(0), int32_t(1), std::numeric_limits<int32_t>::min(), std::numeric_limits<int32_t>::max()});
+    check(long_type, {int64_t(-1), int64_t(0), int64_t(1), std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max()});
+    check(timestamp_type, {db_clock::time_point(db_clock::duration(-1)), db_clock::time_point(db_clock::duration(0)), db_clock::now()});
+    check(utf8_type, {sstring(""), sstring("a"), sstring("ab"), sstring("b")});
+    check(timeuuid_type, {timeuuid_native_type{utils::UUID_gen::get_time_UUID()}, timeuuid_native_type{utils::UUID_gen::get_time_UUID()},
+            timeuuid_native_type{utils::UUID_gen::min_time_UUID()}});
+    check(double_type, {-1.0, 0.0, 1.0});
+}
@@ -142,6 +142,28 @@ SEASTAR_TEST_CASE(test_builder_with_multiple_partitions) {
     });
 }
 
+SEASTAR_THREAD_TEST_CASE(test_builder_with_concurrent_flushes) {
+    cql_test_config test_cfg;
+    test_cfg.db_config->view_building_concurrency(8);
+
+    do_with_cql_env_thread([] (cql_test_env& e) {
+        e.execute_cql("create table cf (p int, c int, v int, primary key (p, c))").get();
+
+        for (auto i = 0; i < 1024; ++i) {
+            e.execute_cql(format("insert into cf (p, c, v) values ({:d}, {:d}, 0)", i % 100, i)).get();
+        }
+
+        auto f = e.local_view_builder().wait_until_built("ks", "vcf");
+        e.execute_cql("create materialized view vcf as select * from cf "
+                      "where p is not null and c is not null and v is not null "
+                      "primary key (v, c, p)").get();
+
+        f.get();
+        auto msg = e.execute_cql("select count(*) from vcf where v = 0").get0();
+        assert_that(msg).is_rows().with_rows({{{long_type->decompose(1024L)}}});
+    }, std::move(test_cfg)).get();
+}
+
 SEASTAR_TEST_CASE(test_builder_with_multiple_partitions_of_batch_size_rows) {
     return do_with_cql_env_thread([] (cql_test_env& e) {
         e.execute_cql("create table cf (p int, c int, v int, primary key (p, c))").get();
@@ -46,6 +46,9 @@ void check_bytes_and_roundtrip(typename Vint::value_type value, BytesInspector&&
 
     const auto deserialized = Vint::deserialize(view);
     BOOST_REQUIRE_EQUAL(deserialized, value);
+    if (size == 1) {
+        BOOST_REQUIRE_EQUAL(Vint::deserialize_single_byte(view[0]), value);
+    }
     test_serialized_size_from_first_byte<Vint>(size, view);
 };
 
@@ -137,3 +140,12 @@ BOOST_AUTO_TEST_CASE(sanity_signed_examples) {
 BOOST_AUTO_TEST_CASE(sanity_signed_sweep) {
     check_roundtrip_sweep<signed_vint>(100'000, random_engine());
 }
+
+BOOST_AUTO_TEST_CASE(single_byte_values) {
+    for (int64_t value = -64; value < 64; ++value) {
+        check_roundtrip<signed_vint>(value);
+    }
+    for (uint64_t value = 0; value < 128; ++value) {
+        check_roundtrip<unsigned_vint>(value);
+    }
+}
@@ -207,6 +207,26 @@ def test_paging_with_desc_clustering_order(cql, test_keyspace):
         stmt = SimpleStatement(f"SELECT * FROM {table} WHERE c = 42", fetch_size=1)
         assert len([row for row in cql.execute(stmt)]) == 3
 
+# Test that when an index matches many rows of the same base partitions,
+# which are read together, they are all returned, in the same order as a
+# full scan returns them, with or without paging and in either clustering
+# order.
+@pytest.mark.parametrize("order", ["asc", "desc"])
+def test_index_many_rows_per_partition(cql, test_keyspace, order):
+    schema = 'p int, c int, x int, primary key (p,c)'
+    extra = f'with clustering order by (c {order})'
+    with new_test_table(cql, test_keyspace, schema, extra) as table:
+        cql.execute(f"CREATE INDEX ON {table}(x)")
+        stmt = cql.prepare(f"INSERT INTO {table}(p,c,x) VALUES (?, ?, ?)")
+        for p in range(3):
+            for c in range(30):
+                cql.execute(stmt, [p, c, c % 3])
+        expected = [(row.p, row.c) for row in cql.execute(f"SELECT p, c, x FROM {table}") if row.x == 1]
+        assert len(expected) == 30
+        for fetch_size in [None, 4, 7]:
+            result = cql.execute(SimpleStatement(f"SELECT p, c FROM {table} WHERE x = 1", fetch_size=fetch_size))
+            assert [(row.p, row.c) for row in result] == expected
+
 # Test that deleting a base partition works fine, even if it produces a large batch
 # of individual view updates. Refs #8852 - view updates used to be applied with
 # per-partition granularity, but after fixing the issue it's no longer the case,
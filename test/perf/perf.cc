@@ -51,6 +51,10 @@ std::ostream&
 operator<<(std::ostream& os, const perf_result& result) {
     fmt::print(os, "{:.2f} tps ({:5.1f} allocs/op, {:5.1f} tasks/op, {:7.0f} insns/op, {:8} errors)",
             result.throughput, result.mallocs_per_op, result.tasks_per_op, result.instructions_per_op, result.errors);
+    if (result.latencies.count()) {
+        fmt::print(os, " latency [us]: p50 {}, p99 {}, p999 {}, max {}",
+                result.latencies.percentile(0.5), result.latencies.percentile(0.99), result.latencies.percentile(0.999), result.latencies.max());
+    }
     return os;
 }
 
@@ -12,6 +12,9 @@
 #include <seastar/core/future-util.hh>
 #include <seastar/core/distributed.hh>
 #include <seastar/core/weak_ptr.hh>
+#include <seastar/core/semaphore.hh>
+#include <seastar/core/gate.hh>
+#include <seastar/core/sleep.hh>
 #include <seastar/coroutine/as_future.hh>
 #include "seastarx.hh"
 #include "utils/extremum_tracking.hh"
@@ -53,6 +56,10 @@ struct executor_shard_stats {
     uint64_t tasks_executed = 0;
     uint64_t instructions_retired = 0;
     uint64_t errors = 0;
+    // Microseconds from when each invocation was due to its completion.
+    // Only collected at a fixed rate, and not a counter: the difference of
+    // two snapshots keeps the histogram of the later one.
+    utils::estimated_histogram latencies{200};
 };
 
 inline
@@ -63,6 +70,7 @@ operator+(executor_shard_stats a, executor_shard_stats b) {
     a.tasks_executed += b.tasks_executed;
     a.instructions_retired += b.instructions_retired;
     a.errors += b.errors;
+    a.latencies.merge(b.latencies);
     return a;
 }
 
@@ -82,15 +90,22 @@ uint64_t perf_mallocs();
 
 // Drives concurrent and continuous execution of given asynchronous action
 // until a deadline. Counts invocations and collects statistics.
+//
+// With a non-zero rate, invocations are instead started at that many per
+// second regardless of how fast earlier ones complete, with at most
+// n_workers in flight, and their latencies are recorded.
 template <typename Func>
 class executor {
+    using clk = std::chrono::steady_clock;
     const Func _func;
     const lowres_clock::time_point _end_at;
     const uint64_t _end_at_count;
     const unsigned _n_workers;
     const bool _stop_on_error;
+    const unsigned _rate;
     uint64_t _count;
     uint64_t _errors;
+    utils::estimated_histogram _latencies{200};
     linux_perf_event _instructions_retired_counter = linux_perf_event::user_instructions_retired();
 private:
     executor_shard_stats executor_shard_stats_snapshot();
@@ -107,13 +122,50 @@ class executor {
             }
         }
     }
+    future<> run_one(clk::time_point due, semaphore_units<> units, std::exception_ptr& error) {
+        future<> f = co_await coroutine::as_future(_func());
+        // Measured from when the invocation was due rather than from when
+        // it started, so that waiting behind a stalled one is accounted for.
+        _latencies.add(std::chrono::duration_cast<std::chrono::microseconds>(clk::now() - due).count());
+        if (f.failed()) {
+            ++_errors;
+            if (_stop_on_error && !error) [[unlikely]] {
+                error = f.get_exception();
+            } else {
+                f.ignore_ready_future();
+            }
+        }
+    }
+    future<> run_open_loop() {
+        const auto interval = std::chrono::duration_cast<clk::duration>(std::chrono::duration<double>(1.0 / _rate));
+        const auto start = clk::now();
+        semaphore in_flight(_n_workers);
+        gate pending;
+        std::exception_ptr error;
+        for (uint64_t i = 0; !error && (_end_at_count ? _count < _end_at_count : lowres_clock::now() < _end_at); ++i) {
+            auto due = start + i * interval;
+            if (auto now = clk::now(); now < due) {
+                co_await seastar::sleep(due - now);
+            }
+            auto units = co_await get_units(in_flight, 1);
+            ++_count;
+            (void)with_gate(pending, [this, due, units = std::move(units), &error] () mutable {
+                return run_one(due, std::move(units), error);
+            });
+        }
+        co_await pending.close();
+        if (error) {
+            std::rethrow_exception(std::move(error));
+        }
+    }
 public:
-    executor(unsigned n_workers, Func func, lowres_clock::time_point end_at, uint64_t end_at_count = 0, bool stop_on_error = true)
+    executor(unsigned n_workers, Func func, lowres_clock::time_point end_at, uint64_t end_at_count = 0, bool stop_on_error = true, unsigned rate = 0)
             : _func(std::move(func))
             , _end_at(end_at)
             , _end_at_count(end_at_count)
             , _n_workers(n_workers)
             , _stop_on_error(stop_on_error)
+            , _rate(rate)
             , _count(0)
             , _errors(0)
     { }
@@ -123,9 +175,10 @@ class executor {
         auto stats_start = executor_shard_stats_snapshot();
         _instructions_retired_counter.enable();
         auto idx = boost::irange(0, (int)_n_workers);
-        return parallel_for_each(idx.begin(), idx.end(), [this] (auto idx) mutable {
+        auto f = _rate ? run_open_loop() : parallel_for_each(idx.begin(), idx.end(), [this] (auto idx) mutable {
             return this->run_worker();
-        }).then([this, stats_start] {
+        });
+        return f.then([this, stats_start] {
             _instructions_retired_counter.disable();
             auto stats_end = executor_shard_stats_snapshot();
             return stats_end - stats_start;
@@ -146,6 +199,7 @@ executor<Func>::executor_shard_stats_snapshot() {
         .tasks_executed = perf_tasks_processed(),
         .instructions_retired = _instructions_retired_counter.read(),
         .errors = _errors,
+        .latencies = _latencies,
     };
 }
 
@@ -155,6 +209,8 @@ struct perf_result {
     double tasks_per_op;
     double instructions_per_op;
     uint64_t errors;
+    // Empty unless run at a fixed rate, see executor.
+    utils::estimated_histogram latencies{200};
 };
 
 std::ostream& operator<<(std::ostream& os, const perf_result& result);
@@ -185,7 +241,7 @@ std::ostream& operator<<(std::ostream& os, const perf_result_with_aio_writes& re
 template <typename Res, typename Func, typename UpdateFunc = void(*)(const Res&, const executor_shard_stats&)>
 requires (std::is_base_of_v<perf_result, Res> && std::is_invocable_v<UpdateFunc, Res&, const executor_shard_stats&>)
 static
-std::vector<Res> time_parallel_ex(Func func, unsigned concurrency_per_core, int iterations = 5, unsigned operations_per_shard = 0, bool stop_on_error = true, UpdateFunc uf = [](const auto&, const auto&) {}) {
+std::vector<Res> time_parallel_ex(Func func, unsigned concurrency_per_core, int iterations = 5, unsigned operations_per_shard = 0, bool stop_on_error = true, UpdateFunc uf = [](const auto&, const auto&) {}, unsigned rate_per_core = 0) {
     using clk = std::chrono::steady_clock;
     if (operations_per_shard) {
         iterations = 1;
@@ -196,7 +252,7 @@ std::vector<Res> time_parallel_ex(Func func, unsigned concurrency_per_core, int
         auto end_at = lowres_clock::now() + std::chrono::seconds(1);
         distributed<executor<Func>> exec;
         Res result;
-        exec.start(concurrency_per_core, func, std::move(end_at), operations_per_shard, stop_on_error).get();
+        exec.start(concurrency_per_core, func, std::move(end_at), operations_per_shard, stop_on_error, rate_per_core).get();
         auto stop_exec = defer([&exec] {
             exec.stop().get();
         });
@@ -210,6 +266,7 @@ std::vector<Res> time_parallel_ex(Func func, unsigned concurrency_per_core, int
         result.tasks_per_op = double(stats.tasks_executed) / stats.invocations;
         result.instructions_per_op = double(stats.instructions_retired) / stats.invocations;
         result.errors = stats.errors;
+        result.latencies = stats.latencies;
 
         uf(result, stats);
 
@@ -221,8 +278,9 @@ std::vector<Res> time_parallel_ex(Func func, unsigned concurrency_per_core, int
 
 template <typename Func>
 static
-std::vector<perf_result> time_parallel(Func func, unsigned concurrency_per_core, int iterations = 5, unsigned operations_per_shard = 0, bool stop_on_error = true) {
-    return time_parallel_ex<perf_result>(std::move(func), concurrency_per_core, iterations, operations_per_shard, stop_on_error);
+std::vector<perf_result> time_parallel(Func func, unsigned concurrency_per_core, int iterations = 5, unsigned operations_per_shard = 0, bool stop_on_error = true, unsigned rate_per_core = 0) {
+    return time_parallel_ex<perf_result>(std::move(func), concurrency_per_core, iterations, operations_per_shard, stop_on_error,
+            [] (const auto&, const auto&) {}, rate_per_core);
 }
 
 template<typename Func>
@@ -16,6 +16,9 @@
 #include <seastar/core/app-template.hh>
 #include <seastar/core/coroutine.hh>
 #include <seastar/core/reactor.hh>
+#include <seastar/core/gate.hh>
+#include <seastar/core/semaphore.hh>
+#include <seastar/core/sleep.hh>
 #include <seastar/core/on_internal_error.hh>
 #include <seastar/testing/test_runner.hh>
 
@@ -30,11 +33,15 @@
 #include "db/extensions.hh"
 #include "db/commitlog/commitlog.hh"
 #include "utils/UUID_gen.hh"
+#include "utils/estimated_histogram.hh"
 
 struct test_config {
     unsigned concurrency;
     unsigned duration_in_seconds;
     unsigned operations_per_shard = 0;
+    // Writes per second and shard, issued regardless of how fast they
+    // complete. Zero runs concurrency writers back to back instead.
+    unsigned rate = 0;
 
     size_t min_data_size;
     size_t max_data_size;
@@ -45,13 +52,26 @@ struct test_config {
 
 using clperf_result = perf_result_with_aio_writes;
 
-static void write_json_result(std::string result_file, const test_config& cfg, clperf_result median, double mad, double max, double min) {
+// Latencies of all writes of the run, in microseconds, and the reactor
+// time spent per write.
+struct latency_result {
+    utils::estimated_histogram histogram{200};
+    double cpu_us_per_op = 0;
+};
+
+static void write_json_result(std::string result_file, const test_config& cfg, const db::commitlog::config& cl_cfg,
+        clperf_result median, double mad, double max, double min, const latency_result& lat) {
     Json::Value results;
 
     Json::Value params;
     params["concurrency"] = cfg.concurrency;
     params["cpus"] = smp::count;
     params["duration"] = cfg.duration_in_seconds;
+    params["rate"] = cfg.rate;
+    params["commitlog-sync"] = cl_cfg.mode == db::commitlog::sync_mode::BATCH ? "batch" : "periodic";
+    params["commitlog-sync-batch-max-delay-in-us"] = Json::UInt64(cl_cfg.batch_max_delay.count());
+    params["commitlog-segment-size-in-mb"] = Json::UInt64(cl_cfg.commitlog_segment_size_in_mb);
+    params["commitlog-use-o-dsync"] = cl_cfg.use_o_dsync;
 
     params["min-data-size"] = cfg.min_data_size;
     params["max-data-size"] = cfg.max_data_size;
@@ -71,8 +91,33 @@ static void write_json_result(std::string result_file, const test_config& cfg, c
     stats["mad tps"] = mad;
     stats["max tps"] = max;
     stats["min tps"] = min;
+    stats["cpu_us_per_op"] = lat.cpu_us_per_op;
     results["stats"] = std::move(stats);
 
+    Json::Value latency;
+    auto& h = lat.histogram;
+    latency["count"] = Json::Int64(h.count());
+    latency["mean"] = Json::Int64(h.mean());
+    latency["min"] = Json::Int64(h.min());
+    latency["p50"] = Json::Int64(h.percentile(0.5));
+    latency["p90"] = Json::Int64(h.percentile(0.9));
+    latency["p99"] = Json::Int64(h.percentile(0.99));
+    latency["p999"] = Json::Int64(h.percentile(0.999));
+    latency["max"] = Json::Int64(h.max());
+    // Non-empty buckets, as [upper bound, count] pairs. The last bucket
+    // holds all values above the highest offset, its bound is -1.
+    Json::Value buckets(Json::arrayValue);
+    for (size_t i = 0; i < h.buckets.size(); ++i) {
+        if (h.buckets[i]) {
+            Json::Value b(Json::arrayValue);
+            b.append(Json::Int64(i < h.bucket_offsets.size() ? h.bucket_offsets[i] : -1));
+            b.append(Json::Int64(h.buckets[i]));
+            buckets.append(std::move(b));
+        }
+    }
+    latency["buckets"] = std::move(buckets);
+    results["latency_us"] = std::move(latency);
+
     std::string test_type = "commitlog_write";
     results["test_properties"]["type"] = test_type;
 
@@ -103,12 +148,38 @@ static void write_json_result(std::string result_file, const test_config& cfg, c
 }
 
 struct commitlog_service {
+    using clock = std::chrono::steady_clock;
+
+    // Counters of a shard, the difference of two snapshots describes a run.
+    struct shard_stats {
+        uint64_t ops = 0;
+        uint64_t errors = 0;
+        uint64_t allocations = 0;
+        uint64_t tasks_executed = 0;
+        uint64_t aio_writes = 0;
+        uint64_t aio_write_bytes = 0;
+        std::chrono::nanoseconds busy_time{0};
+
+        shard_stats operator-(const shard_stats& o) const {
+            return {ops - o.ops, errors - o.errors, allocations - o.allocations, tasks_executed - o.tasks_executed,
+                    aio_writes - o.aio_writes, aio_write_bytes - o.aio_write_bytes, busy_time - o.busy_time};
+        }
+        shard_stats operator+(const shard_stats& o) const {
+            return {ops + o.ops, errors + o.errors, allocations + o.allocations, tasks_executed + o.tasks_executed,
+                    aio_writes + o.aio_writes, aio_write_bytes + o.aio_write_bytes, busy_time + o.busy_time};
+        }
+    };
+
     test_config cfg;
     std::uniform_int_distribution<unsigned> delay_dist;
     std::uniform_int_distribution<size_t> size_dist;
     std::optional<db::commitlog> log;
     std::optional<db::commitlog::flush_handler_anchor> fa;
     timer<> flush_timer;
+    table_id id = table_id(utils::UUID_gen::get_time_UUID());
+    utils::estimated_histogram latencies{200};
+    uint64_t ops = 0;
+    uint64_t errors = 0;
 
     commitlog_service(const test_config& c)
         : cfg(c)
@@ -133,32 +204,116 @@ struct commitlog_service {
             flush_timer.arm(std::chrono::milliseconds(delay_dist(tests::random::gen())));
         }
     }
+
+    shard_stats snapshot() const {
+        return shard_stats{
+            .ops = ops,
+            .errors = errors,
+            .allocations = perf_mallocs(),
+            .tasks_executed = perf_tasks_processed(),
+            .aio_writes = engine().get_io_stats().aio_writes,
+            .aio_write_bytes = engine().get_io_stats().aio_write_bytes,
+            .busy_time = engine().total_busy_time(),
+        };
+    }
+
+    // Writes an entry, and records its latency since start.
+    future<> write(clock::time_point start) {
+        size_t size = size_dist(tests::random::gen());
+        try {
+            auto h = co_await log->add_mutation(id, size, db::commitlog::force_sync::no, [size](db::commitlog::output& dst) {
+                dst.fill('1', size);
+            });
+            h.release();
+        } catch (...) {
+            ++errors;
+            throw;
+        }
+        ++ops;
+        latencies.add(std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - start).count());
+    }
+
+    // Issues cfg.rate writes per second for the duration, without waiting
+    // for earlier writes to complete, up to cfg.concurrency of them in flight.
+    // Latencies are taken from the time a write was due, so that a stalled
+    // commitlog doesn't hide them, even when the cap delays the writes.
+    // Fails with the first error once all writes are done, if any failed.
+    future<> run_open_loop() {
+        auto interval = std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(1.0 / cfg.rate));
+        auto start = clock::now();
+        auto end = start + std::chrono::seconds(cfg.duration_in_seconds);
+        seastar::gate pending;
+        seastar::semaphore in_flight(cfg.concurrency);
+        std::exception_ptr first_error;
+        auto errors_before = errors;
+        for (uint64_t i = 0; ; ++i) {
+            auto due = start + i * interval;
+            if (due >= end) {
+                break;
+            }
+            auto now = clock::now();
+            if (now < due) {
+                co_await seastar::sleep(due - now);
+            }
+            auto units = co_await get_units(in_flight, 1);
+            (void)with_gate(pending, [this, due, &first_error, units = std::move(units)] () mutable {
+                return write(due).handle_exception([&first_error] (std::exception_ptr ep) {
+                    if (!first_error) {
+                        first_error = std::move(ep);
+                    }
+                }).finally([units = std::move(units)] {});
+            });
+        }
+        co_await pending.close();
+        if (first_error) {
+            throw std::runtime_error(format("{} of the open loop writes failed, the first with: {}", errors - errors_before, first_error));
+        }
+    }
 };
 
 static std::vector<clperf_result> do_commitlog_test(distributed<commitlog_service>& cls, test_config& cfg) {
-    auto uuid = table_id(utils::UUID_gen::get_time_UUID());
-
     return time_parallel_ex<clperf_result>([&] {
-        auto& log = cls.local();
-        size_t size = log.size_dist(tests::random::gen());
-        return log.log->add_mutation(uuid, size, db::commitlog::force_sync::no, [size](db::commitlog::output& dst) {
-            dst.fill('1', size);
-        }).then([](db::rp_handle h) {
-            h.release();
-        });
+        return cls.local().write(commitlog_service::clock::now());
     }, cfg.concurrency, cfg.duration_in_seconds, cfg.operations_per_shard, true, &clperf_result::update);
 }
 
+static std::vector<clperf_result> do_commitlog_open_loop_test(distributed<commitlog_service>& cls, test_config& cfg) {
+    using shard_stats = commitlog_service::shard_stats;
+    auto snapshot = [&] {
+        return cls.map_reduce0(std::mem_fn(&commitlog_service::snapshot), shard_stats(), std::plus<shard_stats>()).get0();
+    };
+    auto before = snapshot();
+    auto start = std::chrono::steady_clock::now();
+    cls.invoke_on_all(std::mem_fn(&commitlog_service::run_open_loop)).get();
+    auto duration = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    auto stats = snapshot() - before;
+
+    clperf_result result;
+    result.throughput = stats.ops / duration;
+    result.mallocs_per_op = double(stats.allocations) / stats.ops;
+    result.tasks_per_op = double(stats.tasks_executed) / stats.ops;
+    // Not counted, the writes aren't issued by an executor.
+    result.instructions_per_op = 0;
+    result.errors = stats.errors;
+    result.aio_writes = double(stats.aio_writes) / stats.ops;
+    result.aio_write_bytes = double(stats.aio_write_bytes) / stats.ops;
+    std::cout << result << std::endl;
+    return {result};
+}
+
 int main(int argc, char** argv) {
     namespace bpo = boost::program_options;
     app_template app;
     app.add_options()
         ("random-seed", boost::program_options::value<unsigned>(), "Random number generator seed")
         ("duration", bpo::value<unsigned>()->default_value(5), "test duration in seconds")
-        ("concurrency", bpo::value<unsigned>()->default_value(100), "workers per core")
+        ("concurrency", bpo::value<unsigned>()->default_value(100), "workers per core, or writes in flight per core with --rate")
         ("operations-per-shard", bpo::value<unsigned>(), "run this many operations per shard (overrides duration)")
 
+        ("rate", bpo::value<unsigned>()->default_value(0), "writes per second per core, issued without waiting for completion (0: run concurrency writers back to back)")
+
         ("commitlog-sync", bpo::value<sstring>(), "commitlog sync method (pediodic/batch)")
+        ("commitlog-sync-batch-max-delay-in-us", bpo::value<unsigned>(), "how long a write in \"batch\" mode waits for others to share its sync (0: no group commit)")
         ("commitlog-segment-size-in-mb", bpo::value<unsigned>(), "commitlog segment size")
         ("commitlog-total-space-in-mb", bpo::value<unsigned>(), "total commitlog size")
         ("commitlog-sync-period-in-ms", bpo::value<unsigned>(), "how long the system waits for other writes before performing a sync in \"periodic\" mode")
@@ -192,6 +347,9 @@ int main(int argc, char** argv) {
         if (app.configuration().contains("commitlog-sync")) {
             db_cfg->commitlog_sync(app.configuration()["commitlog-sync"].as<sstring>());
         }
+        if (app.configuration().contains("commitlog-sync-batch-max-delay-in-us")) {
+            db_cfg->commitlog_sync_batch_max_delay_in_us(app.configuration()["commitlog-sync-batch-max-delay-in-us"].as<unsigned>());
+        }
         if (app.configuration().contains("commitlog-segment-size-in-mb")) {
             db_cfg->commitlog_segment_size_in_mb(app.configuration()["commitlog-segment-size-in-mb"].as<unsigned>());
         }
@@ -211,13 +369,14 @@ int main(int argc, char** argv) {
         auto cfg = test_config();
         cfg.duration_in_seconds = app.configuration()["duration"].as<unsigned>();
         cfg.concurrency = app.configuration()["concurrency"].as<unsigned>();
+        cfg.rate = app.configuration()["rate"].as<unsigned>();
         if (app.configuration().contains("operations-per-shard")) {
             cfg.operations_per_shard = app.configuration()["operations-per-shard"].as<unsigned>();
         }
         cfg.min_data_size = app.configuration()["min-data-size"].as<size_t>();
         cfg.max_data_size = app.configuration()["max-data-size"].as<size_t>();
         cfg.min_flush_delay_in_ms = app.configuration()["min-flush-delay-in-ms"].as<uint64_t>();
-        cfg.max_flush_delay_in_ms = app.configuration()["min-flush-delay-in-ms"].as<uint64_t>();
+        cfg.max_flush_delay_in_ms = app.configuration()["max-flush-delay-in-ms"].as<uint64_t>();
 
         if (cfg.min_data_size > cfg.max_data_size) {
             cfg.max_data_size = cfg.min_data_size;
@@ -242,10 +401,25 @@ int main(int argc, char** argv) {
             if (cfg.max_data_size > test_commitlog.local().log->max_record_size()) {
                 throw std::invalid_argument(sstring("Too large max data size: ") + std::to_string(cfg.max_data_size));
             }
+            auto busy_time = [&] {
+                return test_commitlog.map_reduce0([] (commitlog_service&) { return engine().total_busy_time(); },
+                        std::chrono::nanoseconds(0), std::plus<std::chrono::nanoseconds>());
+            };
+            auto busy_before = co_await busy_time();
             // test "framework" expects seastar thread
             auto results = co_await seastar::async([&] {
-                return do_commitlog_test(test_commitlog, cfg);
+                return cfg.rate ? do_commitlog_open_loop_test(test_commitlog, cfg) : do_commitlog_test(test_commitlog, cfg);
+            });
+            auto busy = co_await busy_time() - busy_before;
+
+            latency_result lat;
+            lat.histogram = co_await test_commitlog.map_reduce0([] (commitlog_service& s) { return s.latencies; },
+                    utils::estimated_histogram(200), [] (utils::estimated_histogram a, const utils::estimated_histogram& b) {
+                return a.merge(b);
             });
+            if (lat.histogram.count()) {
+                lat.cpu_us_per_op = std::chrono::duration<double, std::micro>(busy).count() / lat.histogram.count();
+            }
 
             auto compare_throughput = [] (perf_result a, perf_result b) { return a.throughput < b.throughput; };
             std::sort(results.begin(), results.end(), compare_throughput);
@@ -260,9 +434,12 @@ int main(int argc, char** argv) {
             std::sort(absolute_deviations.begin(), absolute_deviations.end());
             auto mad = absolute_deviations[results.size() / 2];
             std::cout << format("\nmedian {}\nmedian absolute deviation: {:.2f}\nmaximum: {:.2f}\nminimum: {:.2f}\n", median_result, mad, max, min);
+            auto& h = lat.histogram;
+            std::cout << format("latency [us]: mean {} p50 {} p90 {} p99 {} p99.9 {} max {}\ncpu per write [us]: {:.2f}\n",
+                    h.mean(), h.percentile(0.5), h.percentile(0.9), h.percentile(0.99), h.percentile(0.999), h.max(), lat.cpu_us_per_op);
 
             if (app.configuration().contains("json-result")) {
-                write_json_result(app.configuration()["json-result"].as<std::string>(), cfg, median_result, mad, max, min);
+                write_json_result(app.configuration()["json-result"].as<std::string>(), cfg, cl_cfg, median_result, mad, max, min, lat);
             }
         } catch (...) {
             ex = std::current_exception();
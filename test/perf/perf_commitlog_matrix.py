@@ -0,0 +1,104 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+#
+# Copyright (C) 2022-present ScyllaDB
+#
+#
+# SPDX-License-Identifier: AGPL-3.0-or-later
+#
+
+# Runs perf_commitlog over the cross product of the given sync modes, segment
+# sizes, entry sizes and arrival rates, and writes the results of all runs as
+# one JSON document. With --baseline, the runs are compared with those of an
+# earlier document with the same parameters, and the script fails if any of
+# them regressed by more than --threshold.
+
+import argparse
+import itertools
+import json
+import os
+import subprocess
+import sys
+import tempfile
+
+cmdline_parser = argparse.ArgumentParser(formatter_class=argparse.ArgumentDefaultsHelpFormatter)
+cmdline_parser.add_argument('perf_commitlog', help='path to the perf_commitlog executable')
+cmdline_parser.add_argument('-o', '--output', default='perf_commitlog_matrix.json', help='name of the output file')
+cmdline_parser.add_argument('--sync-modes', default='periodic,batch,group',
+                            help='comma-separated list of sync modes, "group" is batch mode with --group-commit-delay-in-us')
+cmdline_parser.add_argument('--group-commit-delay-in-us', default=200, type=int, help='maximum group commit delay of the "group" mode')
+cmdline_parser.add_argument('--segment-sizes-in-mb', default='32', help='comma-separated list of segment sizes')
+cmdline_parser.add_argument('--data-sizes', default='512,4096,102400', help='comma-separated list of entry sizes')
+cmdline_parser.add_argument('--rates', default='0', help='comma-separated list of writes per second per core, 0 for a closed loop')
+cmdline_parser.add_argument('--duration', default=10, type=int, help='duration of each run in seconds')
+cmdline_parser.add_argument('--baseline', help='JSON file written by an earlier run, to compare with')
+cmdline_parser.add_argument('--threshold', default=0.1, type=float, help='relative change of throughput or p99 latency reported as a regression')
+cmdline_parser.add_argument('extra_args', nargs=argparse.REMAINDER, help='arguments passed to perf_commitlog as they are, after --')
+
+args = cmdline_parser.parse_args()
+
+
+def split(values, conv=str):
+    return [conv(v) for v in values.split(',') if v]
+
+
+def run_key(params):
+    return (params['sync'], params['segment-size-in-mb'], params['data-size'], params['rate'])
+
+
+def run(sync, segment_size, data_size, rate):
+    cmd = [args.perf_commitlog,
+           '--duration', str(args.duration),
+           '--commitlog-segment-size-in-mb', str(segment_size),
+           '--min-data-size', str(data_size),
+           '--max-data-size', str(data_size),
+           '--rate', str(rate),
+           '--commitlog-sync', 'periodic' if sync == 'periodic' else 'batch']
+    if sync == 'group':
+        cmd += ['--commitlog-sync-batch-max-delay-in-us', str(args.group_commit_delay_in_us)]
+    extra = args.extra_args[1:] if args.extra_args[:1] == ['--'] else args.extra_args
+    with tempfile.TemporaryDirectory() as tmp:
+        result_file = os.path.join(tmp, 'result.json')
+        cmd += ['--json-result', result_file] + extra
+        print(' '.join(cmd), flush=True)
+        subprocess.run(cmd, check=True)
+        with open(result_file) as f:
+            result = json.load(f)
+    result['matrix'] = {
+        'sync': sync,
+        'segment-size-in-mb': segment_size,
+        'data-size': data_size,
+        'rate': rate,
+    }
+    return result
+
+
+def compare(results, baseline):
+    base = {run_key(r['matrix']): r for r in baseline['runs']}
+    regressions = []
+    for r in results:
+        b = base.get(run_key(r['matrix']))
+        if not b:
+            continue
+        tps, base_tps = r['stats']['median tps'], b['stats']['median tps']
+        p99, base_p99 = r['latency_us']['p99'], b['latency_us']['p99']
+        if base_tps and tps < base_tps * (1 - args.threshold):
+            regressions.append(f'{run_key(r["matrix"])}: throughput {base_tps:.2f} -> {tps:.2f} tps')
+        if base_p99 and p99 > base_p99 * (1 + args.threshold):
+            regressions.append(f'{run_key(r["matrix"])}: p99 latency {base_p99} -> {p99} us')
+    return regressions
+
+
+results = [run(*params) for params in itertools.product(split(args.sync_modes), split(args.segment_sizes_in_mb, int),
+                                                        split(args.data_sizes, int), split(args.rates, int))]
+
+with open(args.output, 'w') as f:
+    json.dump({'runs': results}, f, indent=4)
+
+if args.baseline:
+    with open(args.baseline) as f:
+        regressions = compare(results, json.load(f))
+    for r in regressions:
+        print(f'Regression: {r}')
+    if regressions:
+        sys.exit(1)
@@ -9,20 +9,102 @@
 
 import argparse
 import json
-import matplotlib.pyplot as plt
+import math
+import os
+import statistics
+import sys
 
 cmdline_parser = argparse.ArgumentParser(formatter_class=argparse.ArgumentDefaultsHelpFormatter)
-cmdline_parser.add_argument('results', nargs=1, help='JSON file with full perf_fast_forward results')
+cmdline_parser.add_argument('results', nargs=1, help='JSON file with full perf_fast_forward results, or with --compare, an output directory of perf_fast_forward')
 cmdline_parser.add_argument('-o', '--output', help='name of the output file')
 cmdline_parser.add_argument('--histogram', action='store_true', help='plot a histogram of the frag/s results')
 cmdline_parser.add_argument('--histogram-bins-count', default=50, help='number of histogram bins')
 cmdline_parser.add_argument('--histogram-stats', default='frag/s', help='comma-separated list of result statistic to prepare histograms of')
+cmdline_parser.add_argument('--compare', metavar='BASELINE', help='compare the full results of each test case with the ones of the same test case in this baseline file or output directory, '
+                            'and exit with 1 if any regressed')
+cmdline_parser.add_argument('--compare-stats', default='frag/s,aio,(KiB),allocs,tasks,insns/f', help='comma-separated list of result statistics to compare')
+cmdline_parser.add_argument('--threshold', type=float, default=5, help='relative change of a statistic, in percent, above which it is considered regressed')
 
 args = cmdline_parser.parse_args()
 
+# Statistics for which a higher value is better, for all others lower is.
+higher_is_better = {'frag/s', 'mad f/s', 'max f/s', 'min f/s', 'iterations', 'frags', 'cpu'}
+
+# Two-sided 95% critical values of Student's t distribution, by degrees of
+# freedom. Above 30 the normal approximation is close enough.
+t_95 = [12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+        2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+        2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042]
+
+
+def confidence_interval(values):
+    """Mean of the values and the half-width of its 95% confidence interval."""
+    mean = statistics.mean(values)
+    if len(values) < 2:
+        return mean, math.inf
+    t = t_95[len(values) - 2] if len(values) - 1 <= len(t_95) else 1.96
+    return mean, t * statistics.stdev(values) / math.sqrt(len(values))
+
+
+def full_results(path):
+    """Maps the path of each full results file, relative to path, to its statistics."""
+    if os.path.isfile(path):
+        return {os.path.basename(path): json.loads(open(path).read())['results']['stats']}
+    results = {}
+    for root, _, files in os.walk(path):
+        for name in files:
+            if name.endswith('.all.json'):
+                file = os.path.join(root, name)
+                results[os.path.relpath(file, path)] = json.loads(open(file).read())['results']['stats']
+    return results
+
+
+def compare(baseline_path, results_path):
+    baseline = full_results(baseline_path)
+    results = full_results(results_path)
+    if os.path.isfile(baseline_path) and os.path.isfile(results_path):
+        name = os.path.basename(results_path)
+        baseline = {name: list(baseline.values())[0]}
+        results = {name: list(results.values())[0]}
+    compare_stats = args.compare_stats.split(',')
+    regressions = 0
+    for test_case in sorted(results.keys() & baseline.keys()):
+        for stat in compare_stats:
+            old_values = [s[stat] for s in baseline[test_case] if stat in s]
+            new_values = [s[stat] for s in results[test_case] if stat in s]
+            if not old_values or not new_values:
+                continue
+            old, old_ci = confidence_interval(old_values)
+            new, new_ci = confidence_interval(new_values)
+            change = (new - old) / old * 100 if old else (0 if new == old else math.inf)
+            worse = -change if stat in higher_is_better else change
+            # A change is only significant if the confidence intervals of
+            # the two means don't overlap.
+            significant = abs(new - old) > old_ci + new_ci
+            verdict = ''
+            if significant and worse > args.threshold:
+                verdict = 'REGRESSION'
+                regressions += 1
+            elif significant and -worse > args.threshold:
+                verdict = 'improvement'
+            print('{} {}: {:.2f} +- {:.2f} -> {:.2f} +- {:.2f} ({:+.1f}%) {}'.format(
+                test_case, stat, old, old_ci, new, new_ci, change, verdict).rstrip())
+    for test_case in sorted(baseline.keys() - results.keys()):
+        print('{}: missing from the results'.format(test_case))
+    for test_case in sorted(results.keys() - baseline.keys()):
+        print('{}: missing from the baseline'.format(test_case))
+    print('{} regression(s) above {}%'.format(regressions, args.threshold))
+    return regressions
+
+
+if args.compare:
+    sys.exit(1 if compare(args.compare, args.results[0]) else 0)
+
 results = json.loads(open(args.results[0]).read())
 
 if args.histogram:
+    import matplotlib.pyplot as plt
+
     histogram_stats = args.histogram_stats.split(',')
 
     stats = results['results']['stats']
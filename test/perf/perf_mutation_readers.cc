@@ -7,6 +7,7 @@
  */
 
 #include <boost/range/adaptors.hpp>
+#include <boost/range/algorithm/heap_algorithm.hpp>
 
 #include <seastar/core/sleep.hh>
 #include <seastar/testing/perf_tests.hh>
@@ -21,6 +22,7 @@
 #include "readers/empty_v2.hh"
 #include "readers/combined.hh"
 #include "replica/memtable.hh"
+#include "utils/tournament_tree.hh"
 
 namespace tests {
 
@@ -33,12 +35,13 @@ class combined {
     std::vector<std::vector<mutation>> _disjoint_interleaved;
     std::vector<std::vector<mutation>> _disjoint_ranges;
     std::vector<std::vector<mutation>> _overlapping_partitions_disjoint_rows;
+    std::vector<std::vector<mutation>> _many_overlapping_partitions_disjoint_rows;
 private:
     static std::vector<mutation> create_one_row(simple_schema&, reader_permit);
     static std::vector<mutation> create_single_stream(simple_schema&, reader_permit);
     static std::vector<std::vector<mutation>> create_disjoint_interleaved_streams(simple_schema&, reader_permit);
     static std::vector<std::vector<mutation>> create_disjoint_ranges_streams(simple_schema&, reader_permit);
-    static std::vector<std::vector<mutation>> create_overlapping_partitions_disjoint_rows_streams(simple_schema&, reader_permit);
+    static std::vector<std::vector<mutation>> create_overlapping_partitions_disjoint_rows_streams(simple_schema&, reader_permit, int streams = 4);
 protected:
     simple_schema& schema() const { return _schema; }
     reader_permit permit() const { return _permit; }
@@ -53,6 +56,10 @@ class combined {
     const std::vector<std::vector<mutation>>& overlapping_partitions_disjoint_rows_streams() const {
         return _overlapping_partitions_disjoint_rows;
     }
+    // As many streams as a read merges on a size-tiered table.
+    const std::vector<std::vector<mutation>>& many_overlapping_partitions_disjoint_rows_streams() const {
+        return _many_overlapping_partitions_disjoint_rows;
+    }
     future<> consume_all(flat_mutation_reader_v2 mr) const;
 public:
     combined()
@@ -63,6 +70,7 @@ class combined {
         , _disjoint_interleaved(create_disjoint_interleaved_streams(_schema, _permit))
         , _disjoint_ranges(create_disjoint_ranges_streams(_schema, _permit))
         , _overlapping_partitions_disjoint_rows(create_overlapping_partitions_disjoint_rows_streams(_schema, _permit))
+        , _many_overlapping_partitions_disjoint_rows(create_overlapping_partitions_disjoint_rows_streams(_schema, _permit, 24))
     { }
 };
 
@@ -120,10 +128,10 @@ std::vector<std::vector<mutation>> combined::create_disjoint_ranges_streams(simp
     return mss;
 }
 
-std::vector<std::vector<mutation>> combined::create_overlapping_partitions_disjoint_rows_streams(simple_schema& s, reader_permit permit) {
+std::vector<std::vector<mutation>> combined::create_overlapping_partitions_disjoint_rows_streams(simple_schema& s, reader_permit permit, int streams) {
     auto keys = s.make_pkeys(4);
     std::vector<std::vector<mutation>> mss;
-    for (int i = 0; i < 4; i++) {
+    for (int i = 0; i < streams; i++) {
         mss.emplace_back(boost::copy_range<std::vector<mutation>>(
             keys
             | boost::adaptors::transformed([&] (auto& dkey) {
@@ -222,6 +230,18 @@ PERF_TEST_F(combined, overlapping_partitions_disjoint_rows)
     ));
 }
 
+PERF_TEST_F(combined, many_overlapping_partitions_disjoint_rows)
+{
+    return consume_all(make_combined_reader(schema().schema(), permit(),
+        boost::copy_range<std::vector<flat_mutation_reader_v2>>(
+            many_overlapping_partitions_disjoint_rows_streams()
+            | boost::adaptors::transformed([this] (auto&& ms) {
+                return make_flat_mutation_reader_from_mutations_v2(schema().schema(), permit(), std::move(ms));
+            })
+        )
+    ));
+}
+
 struct mutation_bounds {
     mutation m;
     position_in_partition lower;
@@ -307,6 +327,83 @@ PERF_TEST_F(clustering_combined, ranges_specialized)
         schema().schema(), permit(), streamed_mutation::forwarding::no, std::move(q)));
 }
 
+// Merges sorted streams of interleaved clustering positions, the way
+// mutation_reader_merger merges the fragments of the readers of a partition,
+// once with a binary heap, which it used to do, and once with a tournament
+// tree, which it does now.
+class position_merger {
+    mutable simple_schema _schema;
+    std::vector<std::vector<position_in_partition>> _streams;
+protected:
+    struct entry {
+        const position_in_partition* position;
+        size_t stream;
+        size_t index;
+    };
+
+    const std::vector<std::vector<position_in_partition>>& streams() const { return _streams; }
+    position_in_partition::less_compare less() const { return position_in_partition::less_compare(*_schema.schema()); }
+public:
+    static constexpr size_t stream_count = 24;
+    static constexpr size_t positions_per_stream = 256;
+
+    position_merger() {
+        _streams.resize(stream_count);
+        for (size_t i = 0; i < positions_per_stream; ++i) {
+            for (size_t j = 0; j < stream_count; ++j) {
+                _streams[j].push_back(position_in_partition::for_key(_schema.make_ckey(i * stream_count + j)));
+            }
+        }
+    }
+};
+
+PERF_TEST_F(position_merger, heap)
+{
+    auto cmp = [less = less()] (const entry& a, const entry& b) {
+        return less(*b.position, *a.position);
+    };
+    std::vector<entry> heap;
+    heap.reserve(streams().size());
+    for (size_t i = 0; i < streams().size(); ++i) {
+        heap.push_back(entry{&streams()[i].front(), i, 0});
+    }
+    boost::range::make_heap(heap, cmp);
+    size_t merged = 0;
+    while (!heap.empty()) {
+        boost::range::pop_heap(heap, cmp);
+        auto e = heap.back();
+        heap.pop_back();
+        perf_tests::do_not_optimize(e);
+        ++merged;
+        if (++e.index < streams()[e.stream].size()) {
+            heap.push_back(entry{&streams()[e.stream][e.index], e.stream, e.index});
+            boost::range::push_heap(heap, cmp);
+        }
+    }
+    return merged;
+}
+
+PERF_TEST_F(position_merger, tournament_tree)
+{
+    auto cmp = [less = less()] (const entry& a, const entry& b) {
+        return less(*a.position, *b.position);
+    };
+    utils::tournament_tree<entry, decltype(cmp)> tree(cmp);
+    for (size_t i = 0; i < streams().size(); ++i) {
+        tree.push(entry{&streams()[i].front(), i, 0});
+    }
+    size_t merged = 0;
+    while (!tree.empty()) {
+        auto e = tree.pop();
+        perf_tests::do_not_optimize(e);
+        ++merged;
+        if (++e.index < streams()[e.stream].size()) {
+            tree.push(entry{&streams()[e.stream][e.index], e.stream, e.index});
+        }
+    }
+    return merged;
+}
+
 class memtable {
     static constexpr size_t partition_count = 1000;
     static constexpr size_t row_count = 50;
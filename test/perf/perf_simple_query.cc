@@ -71,6 +71,9 @@ struct test_config {
     bool counters;
     bool flush_memtables;
     unsigned operations_per_shard = 0;
+    // Requests per second and shard, issued regardless of how fast they
+    // complete. Zero runs concurrency requests back to back instead.
+    unsigned rate = 0;
     bool stop_on_error;
     sstring timeout;
     bool bypass_cache;
@@ -96,6 +99,7 @@ std::ostream& operator<<(std::ostream& os, const test_config::frontend_type& f)
 std::ostream& operator<<(std::ostream& os, const test_config& cfg) {
     return os << "{partitions=" << cfg.partitions
            << ", concurrency=" << cfg.concurrency
+           << ", rate=" << cfg.rate
            << ", mode=" << cfg.mode
            << ", frontend=" << cfg.frontend
            << ", query_single_key=" << (cfg.query_single_key ? "yes" : "no")
@@ -140,7 +144,7 @@ static std::vector<perf_result> test_read(cql_test_env& env, test_config& cfg) {
     return time_parallel([&env, &cfg, id] {
             bytes key = make_random_key(cfg);
             return env.execute_prepared(id, {{cql3::raw_value::make_value(std::move(key))}}).discard_result();
-        }, cfg.concurrency, cfg.duration_in_seconds, cfg.operations_per_shard, cfg.stop_on_error);
+        }, cfg.concurrency, cfg.duration_in_seconds, cfg.operations_per_shard, cfg.stop_on_error, cfg.rate);
 }
 
 static std::vector<perf_result> test_write(cql_test_env& env, test_config& cfg) {
@@ -159,7 +163,7 @@ static std::vector<perf_result> test_write(cql_test_env& env, test_config& cfg)
     return time_parallel([&env, &cfg, id] {
             bytes key = make_random_key(cfg);
             return env.execute_prepared(id, {{cql3::raw_value::make_value(std::move(key))}}).discard_result();
-        }, cfg.concurrency, cfg.duration_in_seconds, cfg.operations_per_shard, cfg.stop_on_error);
+        }, cfg.concurrency, cfg.duration_in_seconds, cfg.operations_per_shard, cfg.stop_on_error, cfg.rate);
 }
 
 static std::vector<perf_result> test_delete(cql_test_env& env, test_config& cfg) {
@@ -173,7 +177,7 @@ static std::vector<perf_result> test_delete(cql_test_env& env, test_config& cfg)
     return time_parallel([&env, &cfg, id] {
             bytes key = make_random_key(cfg);
             return env.execute_prepared(id, {{cql3::raw_value::make_value(std::move(key))}}).discard_result();
-        }, cfg.concurrency, cfg.duration_in_seconds, cfg.operations_per_shard, cfg.stop_on_error);
+        }, cfg.concurrency, cfg.duration_in_seconds, cfg.operations_per_shard, cfg.stop_on_error, cfg.rate);
 }
 
 static std::vector<perf_result> test_counter_update(cql_test_env& env, test_config& cfg) {
@@ -192,7 +196,7 @@ static std::vector<perf_result> test_counter_update(cql_test_env& env, test_conf
     return time_parallel([&env, &cfg, id] {
             bytes key = make_random_key(cfg);
             return env.execute_prepared(id, {{cql3::raw_value::make_value(std::move(key))}}).discard_result();
-        }, cfg.concurrency, cfg.duration_in_seconds, cfg.operations_per_shard, cfg.stop_on_error);
+        }, cfg.concurrency, cfg.duration_in_seconds, cfg.operations_per_shard, cfg.stop_on_error, cfg.rate);
 }
 
 static schema_ptr make_counter_schema(std::string_view ks_name) {
@@ -305,7 +309,7 @@ static std::vector<perf_result> test_alternator_read(service::client_state& stat
         content.emplace_back(key.data(), key.size(), deleter{});
         content.emplace_back(postfix.data(), postfix.size(), deleter{});
         return executor.get_item(state, tracing::trace_state_ptr(), empty_service_permit(), rjson::parse(std::move(content))).discard_result();
-    }, cfg.concurrency, cfg.duration_in_seconds, cfg.operations_per_shard, cfg.stop_on_error);
+    }, cfg.concurrency, cfg.duration_in_seconds, cfg.operations_per_shard, cfg.stop_on_error, cfg.rate);
 }
 
 static std::vector<perf_result> test_alternator_write(service::client_state& state, alternator::executor& executor, test_config& cfg) {
@@ -348,7 +352,7 @@ static std::vector<perf_result> test_alternator_write(service::client_state& sta
         content.emplace_back(key.data(), key.size(), deleter{});
         content.emplace_back(postfix.data(), postfix.size(), deleter{});
         return executor.update_item(state, tracing::trace_state_ptr(), empty_service_permit(), rjson::parse(std::move(content))).discard_result();
-    }, cfg.concurrency, cfg.duration_in_seconds, cfg.operations_per_shard, cfg.stop_on_error);
+    }, cfg.concurrency, cfg.duration_in_seconds, cfg.operations_per_shard, cfg.stop_on_error, cfg.rate);
 }
 
 static std::vector<perf_result> test_alternator_delete(service::client_state& state, noncopyable_function<void()> flush_memtables,
@@ -367,7 +371,7 @@ static std::vector<perf_result> test_alternator_delete(service::client_state& st
             }
         )";
         return executor.delete_item(state, tracing::trace_state_ptr(), empty_service_permit(), rjson::parse(json)).discard_result();
-    }, cfg.concurrency, cfg.duration_in_seconds, cfg.operations_per_shard, cfg.stop_on_error);
+    }, cfg.concurrency, cfg.duration_in_seconds, cfg.operations_per_shard, cfg.stop_on_error, cfg.rate);
 }
 
 static std::vector<perf_result> do_alternator_test(std::string isolation_level,
@@ -441,7 +445,20 @@ static std::vector<perf_result> do_cql_test(cql_test_env& env, test_config& cfg)
     abort();
 }
 
-void write_json_result(std::string result_file, const test_config& cfg, perf_result median, double mad, double max, double min) {
+static Json::Value latency_to_json(const utils::estimated_histogram& h) {
+    Json::Value latency;
+    latency["count"] = Json::Int64(h.count());
+    latency["p50"] = Json::Int64(h.percentile(0.5));
+    latency["p90"] = Json::Int64(h.percentile(0.9));
+    latency["p99"] = Json::Int64(h.percentile(0.99));
+    latency["p999"] = Json::Int64(h.percentile(0.999));
+    latency["max"] = Json::Int64(h.max());
+    return latency;
+}
+
+// The results are expected in the order they were measured, one per second.
+void write_json_result(std::string result_file, const test_config& cfg, const std::vector<perf_result>& series,
+        perf_result median, double mad, double max, double min) {
     Json::Value results;
 
     Json::Value params;
@@ -449,6 +466,7 @@ void write_json_result(std::string result_file, const test_config& cfg, perf_res
     params["partitions"] = cfg.partitions;
     params["cpus"] = smp::count;
     params["duration"] = cfg.duration_in_seconds;
+    params["rate"] = cfg.rate;
     params["concurrency,partitions,cpus,duration"] = fmt::format("{},{},{},{}", cfg.concurrency, cfg.partitions, smp::count, cfg.duration_in_seconds);
     results["parameters"] = std::move(params);
 
@@ -462,6 +480,20 @@ void write_json_result(std::string result_file, const test_config& cfg, perf_res
     stats["min tps"] = min;
     results["stats"] = std::move(stats);
 
+    if (cfg.rate) {
+        utils::estimated_histogram all_latencies{200};
+        Json::Value time_series(Json::arrayValue);
+        for (const auto& r : series) {
+            all_latencies.merge(r.latencies);
+            auto point = latency_to_json(r.latencies);
+            point["tps"] = r.throughput;
+            point["errors"] = Json::UInt64(r.errors);
+            time_series.append(std::move(point));
+        }
+        results["latency_us"] = latency_to_json(all_latencies);
+        results["time_series"] = std::move(time_series);
+    }
+
     std::string test_type;
     switch (cfg.mode) {
     case test_config::run_mode::read: test_type = "read"; break;
@@ -511,6 +543,7 @@ int main(int argc, char** argv) {
         ("query-single-key", "test reading with a single key instead of random keys")
         ("concurrency", bpo::value<unsigned>()->default_value(100), "workers per core")
         ("operations-per-shard", bpo::value<unsigned>(), "run this many operations per shard (overrides duration)")
+        ("rate", bpo::value<unsigned>()->default_value(0), "requests per second per core, issued without waiting for completion, with at most concurrency in flight (0: run concurrency workers back to back)")
         ("counters", "test counters")
         ("flush", "flush memtables before test")
         ("json-result", bpo::value<std::string>(), "name of the json result file")
@@ -544,6 +577,7 @@ int main(int argc, char** argv) {
             cfg.partitions = app.configuration()["partitions"].as<unsigned>();
             cfg.duration_in_seconds = app.configuration()["duration"].as<unsigned>();
             cfg.concurrency = app.configuration()["concurrency"].as<unsigned>();
+            cfg.rate = app.configuration()["rate"].as<unsigned>();
             cfg.query_single_key = app.configuration().contains("query-single-key");
             cfg.counters = app.configuration().contains("counters");
             cfg.flush_memtables = app.configuration().contains("flush");
@@ -569,8 +603,9 @@ int main(int argc, char** argv) {
                     ? do_cql_test(env, cfg)
                     : do_alternator_test(app.configuration()["alternator"].as<std::string>(),
                             env.local_client_state(), env.qp(), env.migration_manager(), env.gossiper(), cfg);
+            auto series = results;
 
-            auto compare_throughput = [] (perf_result a, perf_result b) { return a.throughput < b.throughput; };
+            auto compare_throughput = [] (const perf_result& a, const perf_result& b) { return a.throughput < b.throughput; };
             std::sort(results.begin(), results.end(), compare_throughput);
             auto median_result = results[results.size() / 2];
             auto median = median_result.throughput;
@@ -585,7 +620,7 @@ int main(int argc, char** argv) {
             std::cout << format("\nmedian {}\nmedian absolute deviation: {:.2f}\nmaximum: {:.2f}\nminimum: {:.2f}\n", median_result, mad, max, min);
 
             if (app.configuration().contains("json-result")) {
-                write_json_result(app.configuration()["json-result"].as<std::string>(), cfg, median_result, mad, max, min);
+                write_json_result(app.configuration()["json-result"].as<std::string>(), cfg, series, median_result, mad, max, min);
             }
           }, std::move(cfg));
         });
@@ -52,12 +52,22 @@ future<> test_sequential_read(distributed<perf_sstable_test_env>& dt) {
     return time_runs(iterations, parallelism, dt, &perf_sstable_test_env::read_sequential_partitions);
 }
 
+future<> test_filter_probe(distributed<perf_sstable_test_env>& dt) {
+    return time_runs(iterations, parallelism, dt, &perf_sstable_test_env::probe_filter);
+}
+
+future<> test_single_partition_read(distributed<perf_sstable_test_env>& dt) {
+    return time_runs(iterations, parallelism, dt, &perf_sstable_test_env::read_single_partitions);
+}
+
 enum class test_modes {
     sequential_read,
     index_read,
     write,
     index_write,
     compaction,
+    filter_probe,
+    single_partition_read,
 };
 
 static std::unordered_map<sstring, test_modes> test_mode = {
@@ -66,6 +76,8 @@ static std::unordered_map<sstring, test_modes> test_mode = {
     {"write", test_modes::write },
     {"index_write", test_modes::index_write },
     {"compaction", test_modes::compaction },
+    {"filter_probe", test_modes::filter_probe },
+    {"single_partition_read", test_modes::single_partition_read },
 };
 
 int main(int argc, char** argv) {
@@ -80,7 +92,9 @@ int main(int argc, char** argv) {
         ("num_columns", bpo::value<unsigned>()->default_value(5), "number of columns per row")
         ("column_size", bpo::value<unsigned>()->default_value(64), "size in bytes for each column")
         ("sstables", bpo::value<unsigned>()->default_value(1), "number of sstables (valid only for compaction mode)")
-        ("mode", bpo::value<sstring>()->default_value("index_write"), "one of: sequential_read, index_read, write, compaction, index_write (default)")
+        ("mode", bpo::value<sstring>()->default_value("index_write"), "one of: sequential_read, index_read, write, compaction, filter_probe, single_partition_read, index_write (default)")
+        ("lookups", bpo::value<unsigned>()->default_value(100000), "number of keys looked up per run (filter_probe and single_partition_read modes)")
+        ("compressor", bpo::value<sstring>()->default_value(""), "compressor class of written sstables, or none (default: the table default)")
         ("testdir", bpo::value<sstring>()->default_value("/var/lib/scylla/perf-tests"), "directory in which to store the sstables")
         ("compaction-strategy", bpo::value<sstring>()->default_value("SizeTieredCompactionStrategy"), "compaction strategy to use, one of "
              "(SizeTieredCompactionStrategy, LeveledCompactionStrategy, DateTieredCompactionStrategy, TimeWindowCompactionStrategy)")
@@ -96,6 +110,8 @@ int main(int argc, char** argv) {
         cfg.key_size = app.configuration()["key_size"].as<unsigned>();
         cfg.buffer_size = app.configuration()["buffer_size"].as<unsigned>() << 10;
         cfg.sstables = app.configuration()["sstables"].as<unsigned>();
+        cfg.lookups = app.configuration()["lookups"].as<unsigned>();
+        cfg.compressor = app.configuration()["compressor"].as<sstring>();
         sstring dir = app.configuration()["testdir"].as<sstring>();
         cfg.dir = dir;
         auto mode = test_mode[app.configuration()["mode"].as<sstring>()];
@@ -111,9 +127,16 @@ int main(int argc, char** argv) {
         return test->start(std::move(cfg)).then([mode, dir, test] {
             engine().at_exit([test] { return test->stop(); });
             if ((mode == test_modes::index_read) ||
-               (mode == test_modes::sequential_read)) {
-                return test->invoke_on_all([] (perf_sstable_test_env &t) {
-                    return t.load_sstables(iterations);
+               (mode == test_modes::sequential_read) ||
+               (mode == test_modes::filter_probe) ||
+               (mode == test_modes::single_partition_read)) {
+                return test->invoke_on_all([mode] (perf_sstable_test_env &t) {
+                    return t.load_sstables(iterations).then([&t, mode] {
+                        if ((mode == test_modes::filter_probe) || (mode == test_modes::single_partition_read)) {
+                            return t.load_keys();
+                        }
+                        return make_ready_future<>();
+                    });
                 }).then_wrapped([] (future<> f) {
                     try {
                         f.get();
@@ -132,6 +155,10 @@ int main(int argc, char** argv) {
                 return test_index_read(*test).then([test] {});
             } else if (mode == test_modes::sequential_read) {
                 return test_sequential_read(*test).then([test] {});
+            } else if (mode == test_modes::filter_probe) {
+                return test_filter_probe(*test).then([test] {});
+            } else if (mode == test_modes::single_partition_read) {
+                return test_single_partition_read(*test).then([test] {});
             } else if ((mode == test_modes::index_write) || (mode == test_modes::write)) {
                 return test_write(*test).then([test] {});
             } else if (mode == test_modes::compaction) {
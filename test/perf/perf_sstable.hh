@@ -39,6 +39,11 @@ class perf_sstable_test_env {
         sstring dir;
         sstables::compaction_strategy_type compaction_strategy;
         api::timestamp_type timestamp_range;
+        // Class of the compressor of written sstables, "none" to disable
+        // compression, empty for the table default.
+        sstring compressor;
+        // Keys looked up per run by the single-key modes.
+        unsigned lookups;
     };
 
 private:
@@ -68,6 +73,10 @@ class perf_sstable_test_env {
     std::uniform_int_distribution<char> _distribution;
     lw_shared_ptr<replica::memtable> _mt;
     std::vector<shared_sstable> _sst;
+    // Keys of _sst[0] in random order, and as many random keys that most
+    // likely aren't in it.
+    std::vector<dht::decorated_key> _keys;
+    std::vector<partition_key> _absent_keys;
 
     schema_ptr create_schema(sstables::compaction_strategy_type type) {
         std::vector<schema::column> columns;
@@ -91,6 +100,11 @@ class perf_sstable_test_env {
             "Perf tests"
         ));
         builder.set_compaction_strategy(type);
+        if (_cfg.compressor == "none") {
+            builder.set_compressor_params(compression_parameters::no_compression());
+        } else if (!_cfg.compressor.empty()) {
+            builder.set_compressor_params(compression_parameters({{compression_parameters::SSTABLE_COMPRESSION, _cfg.compressor}}));
+        }
         return builder.build(schema_builder::compact_storage::no);
     }
 
@@ -126,6 +140,18 @@ class perf_sstable_test_env {
         return _sst.back()->load();
     }
 
+    future<> load_keys() {
+        auto entries = co_await test(_sst[0]).read_indexes(_env.make_reader_permit());
+        if (entries.empty()) {
+            throw std::invalid_argument("The test sstable has no partitions");
+        }
+        for (auto& e : entries) {
+            _keys.push_back(dht::decorate_key(*s, std::move(e.key)));
+            _absent_keys.push_back(partition_key::from_deeply_exploded(*s, { random_key() }));
+        }
+        std::shuffle(_keys.begin(), _keys.end(), _generator);
+    }
+
     using clk = std::chrono::steady_clock;
     static auto now() {
         return clk::now();
@@ -211,6 +237,42 @@ class perf_sstable_test_env {
         });
     }
 
+    // Probes the partition filter with _cfg.lookups keys, alternating
+    // between keys of the sstable and absent ones.
+    future<double> probe_filter(int idx) {
+        const auto start = perf_sstable_test_env::now();
+        for (unsigned i = 0; i < _cfg.lookups; ++i) {
+            if (i % 2) {
+                _sst[0]->filter_has_key(*s, _absent_keys[i / 2 % _absent_keys.size()]);
+            } else if (!_sst[0]->filter_has_key(*s, _keys[i / 2 % _keys.size()].key())) {
+                throw std::runtime_error("The filter is missing a key of the sstable");
+            }
+        }
+        const auto end = perf_sstable_test_env::now();
+        auto duration = std::chrono::duration<double>(end - start).count();
+        return make_ready_future<double>(_cfg.lookups / duration);
+    }
+
+    // Reads _cfg.lookups partitions of the sstable by key, each with its
+    // own reader, so that every read goes through the index.
+    future<double> read_single_partitions(int idx) {
+        const auto start = perf_sstable_test_env::now();
+        for (unsigned i = 0; i < _cfg.lookups; ++i) {
+            auto& dk = _keys[i % _keys.size()];
+            auto pr = dht::partition_range::make_singular(dk);
+            co_await with_closeable(_sst[0]->make_reader(s, _env.make_reader_permit(), pr, s->full_slice()), [] (auto& r) {
+                return read_mutation_from_flat_mutation_reader(r).then([] (mutation_opt m) {
+                    if (!m) {
+                        throw std::runtime_error("A partition of the sstable wasn't found");
+                    }
+                });
+            });
+        }
+        const auto end = perf_sstable_test_env::now();
+        auto duration = std::chrono::duration<double>(end - start).count();
+        co_return _cfg.lookups / duration;
+    }
+
     future<double> read_sequential_partitions(int idx) {
         return with_closeable(_sst[0]->make_reader(s, _env.make_reader_permit(), query::full_partition_range, s->full_slice()), [this] (auto& r) {
             auto start = perf_sstable_test_env::now();
@@ -0,0 +1,34 @@
+#
+# SPDX-License-Identifier: AGPL-3.0-or-later
+#
+
+import pytest
+import redis
+import logging
+from util import random_string, connect
+
+logger = logging.getLogger('redis-test')
+
+def test_lpush_rpush_lrange(redis_host, redis_port):
+    r = connect(redis_host, redis_port)
+    key = random_string(10)
+    r.delete(key)
+
+    assert r.rpush(key, 'b', 'c') == 2
+    assert r.lpush(key, 'a', 'z') == 4
+    assert r.rpush(key, 'd') == 5
+    assert r.lrange(key, 0, -1) == ['z', 'a', 'b', 'c', 'd']
+    assert r.lrange(key, 1, 2) == ['a', 'b']
+    assert r.lrange(key, -2, -1) == ['c', 'd']
+    assert r.lrange(key, 3, 100) == ['c', 'd']
+    assert r.lrange(key, 4, 2) == []
+    assert r.llen(key) == 5
+    r.delete(key)
+    assert r.llen(key) == 0
+    assert r.lrange(key, 0, -1) == []
+
+def test_lpush_wrong_number_of_arguments(redis_host, redis_port):
+    r = connect(redis_host, redis_port)
+    with pytest.raises(redis.exceptions.ResponseError) as excinfo:
+        r.execute_command("LPUSH testkey")
+    assert "wrong number of arguments for 'lpush' command" in str(excinfo.value)
@@ -0,0 +1,25 @@
+#
+# SPDX-License-Identifier: AGPL-3.0-or-later
+#
+
+import pytest
+import redis
+import logging
+from util import random_string, connect
+
+logger = logging.getLogger('redis-test')
+
+def test_sadd_smembers(redis_host, redis_port):
+    r = connect(redis_host, redis_port)
+    key = random_string(10)
+    r.delete(key)
+
+    assert r.sadd(key, 'a', 'b', 'a') == 2
+    assert r.sadd(key, 'b', 'c') == 1
+    assert r.smembers(key) == {'a', 'b', 'c'}
+    assert r.scard(key) == 3
+    assert r.sismember(key, 'a') == 1
+    assert r.sismember(key, 'd') == 0
+    r.delete(key)
+    assert r.smembers(key) == set()
+    assert r.scard(key) == 0
@@ -231,3 +231,31 @@ def test_strlen_wrongtype(redis_host, redis_port):
         r.strlen(key1)
     except redis.exceptions.ResponseError as ex:
         assert str(ex) == 'WRONGTYPE Operation against a key holding the wrong kind of value'
+
+def test_mset_mget(redis_host, redis_port):
+    r = connect(redis_host, redis_port)
+    items = {random_string(10): random_string(10) for i in range(50)}
+    missing = random_string(10)
+    r.delete(missing)
+
+    assert r.mset(items) == True
+    keys = list(items.keys())
+    keys.insert(25, missing)
+    assert r.mget(keys) == [items.get(key) for key in keys]
+
+# The requests of a pipeline are replied in order, and see the effects of
+# the writes before them in the pipeline.
+def test_pipeline(redis_host, redis_port):
+    r = connect(redis_host, redis_port)
+    key = random_string(10)
+    vals = [random_string(10) for i in range(10)]
+    p = r.pipeline(transaction=False)
+    for val in vals:
+        p.set(key, val)
+        p.get(key)
+        p.echo(val)
+    expected = []
+    for val in vals:
+        expected += [True, val, val]
+    assert p.execute() == expected
+    r.delete(key)
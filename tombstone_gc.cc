@@ -141,11 +141,8 @@ gc_clock::time_point tombstone_gc_state::get_gc_before_for_key(schema_ptr s, con
         auto repair_timestamp = gc_clock::time_point::min();
         auto m = get_repair_history_map_for_table(s->id());
         if (m) {
-            const auto it = m->map.find(dk.token());
-            if (it == m->map.end()) {
-                gc_before = gc_clock::time_point::min();
-            } else {
-                repair_timestamp = it->second;
+            if (auto t = m->find(dk.token())) {
+                repair_timestamp = *t;
                 gc_before = saturating_subtract(repair_timestamp, propagation_delay);
             }
         }
@@ -158,7 +155,7 @@ gc_clock::time_point tombstone_gc_state::get_gc_before_for_key(schema_ptr s, con
 
 void tombstone_gc_state::update_repair_time(table_id id, const dht::token_range& range, gc_clock::time_point repair_time) {
     auto m = get_or_create_repair_history_map_for_table(id);
-    m->map += std::make_pair(locator::token_metadata::range_to_interval(range), repair_time);
+    m->update(locator::token_metadata::range_to_interval(range), repair_time);
 }
 
 static bool needs_repair_before_gc(const replica::database& db, sstring ks_name) {
@@ -8,6 +8,7 @@
 
 #include <boost/algorithm/string.hpp>
 #include <boost/algorithm/string/join.hpp>
+#include <boost/range/irange.hpp>
 #include <filesystem>
 #include <source_location>
 #include <fmt/chrono.h>
@@ -910,14 +911,21 @@ void validate_operation(schema_ptr schema, reader_permit permit, const std::vect
     }
     const auto merge = vm.count("merge");
     sstables::compaction_data info;
-    consume_sstables(schema, permit, sstables, merge, true, [&info] (flat_mutation_reader_v2& rd, sstables::sstable* sst) {
-        if (sst) {
-            sst_log.info("validating {}", sst->get_filename());
-        }
-        const auto errors = sstables::scrub_validate_mode_validate_reader(std::move(rd), info).get();
-        sst_log.info("validated {}: {}", sst ? sst->get_filename() : "the stream", errors == 0 ? "valid" : "invalid");
-        return stop_iteration::no;
-    });
+    if (merge) {
+        consume_sstables(schema, permit, sstables, merge, true, [&info] (flat_mutation_reader_v2& rd, sstables::sstable* sst) {
+            const auto errors = sstables::scrub_validate_mode_validate_reader(std::move(rd), info).get();
+            sst_log.info("validated the stream: {}", errors == 0 ? "valid" : "invalid");
+            return stop_iteration::no;
+        });
+        return;
+    }
+    const auto concurrency = std::max(vm["concurrency"].as<unsigned>(), 1u);
+    size_t done = 0;
+    max_concurrent_for_each(sstables, concurrency, [&] (const sstables::shared_sstable& sst) -> future<> {
+        sst_log.info("validating {}", sst->get_filename());
+        const auto errors = co_await sstables::scrub_validate_mode_validate_reader(sst->make_crawling_reader(schema, permit), info);
+        sst_log.info("validated {} ({}/{}): {}", sst->get_filename(), ++done, sstables.size(), errors == 0 ? "valid" : "invalid");
+    }).get();
 }
 
 void dump_index_operation(schema_ptr schema, reader_permit permit, const std::vector<sstables::shared_sstable>& sstables,
@@ -1334,6 +1342,7 @@ const char* to_string(sstables::scylla_metadata_type t) {
         case sstables::scylla_metadata_type::SSTableOrigin: return "sstable_origin";
         case sstables::scylla_metadata_type::ScyllaVersion: return "scylla_version";
         case sstables::scylla_metadata_type::ScyllaBuildId: return "scylla_build_id";
+        case sstables::scylla_metadata_type::RowBloomFilter: return "row_bloom_filter";
     }
     std::abort();
 }
@@ -1350,9 +1359,10 @@ const char* to_string(sstables::large_data_type t) {
 
 class scylla_metadata_visitor : public boost::static_visitor<> {
     json_writer& _writer;
+    const sstables::sstable& _sst;
 
 public:
-    scylla_metadata_visitor(json_writer& writer) : _writer(writer) { }
+    scylla_metadata_visitor(json_writer& writer, const sstables::sstable& sst) : _writer(writer), _sst(sst) { }
 
     void operator()(const sstables::sharding_metadata& val) const {
         _writer.StartArray();
@@ -1427,6 +1437,15 @@ class scylla_metadata_visitor : public boost::static_visitor<> {
         }
         _writer.EndObject();
     }
+    void operator()(const sstables::filter& val) const {
+        _writer.StartObject();
+        _writer.Key("hashes");
+        _writer.Uint(val.hashes);
+        // The bits are moved out of the metadata, into the loaded row bloom filter.
+        _writer.Key("size_bytes");
+        _writer.Uint64(_sst.row_bloom_filter_memory_size());
+        _writer.EndObject();
+    }
     template <typename Size>
     void operator()(const sstables::disk_string<Size>& val) const {
         _writer.String(disk_string_to_string(val));
@@ -1456,7 +1475,7 @@ void dump_scylla_metadata_operation(schema_ptr schema, reader_permit permit, con
             continue;
         }
         for (const auto& [k, v] : m->data.data) {
-            boost::apply_visitor(scylla_metadata_visitor(writer), v);
+            boost::apply_visitor(scylla_metadata_visitor(writer, *sst), v);
         }
         writer.EndObject();
     }
@@ -1464,15 +1483,27 @@ void dump_scylla_metadata_operation(schema_ptr schema, reader_permit permit, con
 }
 
 void validate_checksums_operation(schema_ptr schema, reader_permit permit, const std::vector<sstables::shared_sstable>& sstables,
-        sstables::sstables_manager& sst_man, const bpo::variables_map&) {
+        sstables::sstables_manager& sst_man, const bpo::variables_map& vm) {
     if (sstables.empty()) {
         throw std::runtime_error("error: no sstables specified on the command line");
     }
 
-    for (auto& sst : sstables) {
-        const auto valid = sstables::validate_checksums(sst, permit, default_priority_class()).get();
-        sst_log.info("validated the checksums of {}: {}", sst->get_filename(), valid ? "valid" : "invalid");
+    const auto concurrency = std::max(vm["concurrency"].as<unsigned>(), 1u);
+    std::vector<char> valid(sstables.size(), false);
+    size_t done = 0;
+    max_concurrent_for_each(boost::irange(size_t(0), sstables.size()), concurrency, [&] (size_t i) -> future<> {
+        const auto& sst = sstables[i];
+        valid[i] = co_await sstables::validate_checksums(sst, permit, default_priority_class());
+        sst_log.info("validated the checksums of {} ({}/{}): {}", sst->get_filename(), ++done, sstables.size(), valid[i] ? "valid" : "invalid");
+    }).get();
+
+    json_writer writer;
+    writer.StartObject();
+    for (size_t i = 0; i < sstables.size(); ++i) {
+        writer.SstableKey(*sstables[i]);
+        writer.Bool(valid[i]);
     }
+    writer.EndObject();
 }
 
 void decompress_operation(schema_ptr schema, reader_permit permit, const std::vector<sstables::shared_sstable>& sstables,
@@ -2423,6 +2454,67 @@ void write_operation(schema_ptr schema, reader_permit permit, const std::vector<
     sst->write_components(std::move(reader), 1, schema, writer_cfg, encoding_stats{}).get();
 }
 
+void rewrite_operation(schema_ptr schema, reader_permit permit, const std::vector<sstables::shared_sstable>& sstables,
+        sstables::sstables_manager& manager, const bpo::variables_map& vm) {
+    if (sstables.empty()) {
+        throw std::runtime_error("error: no sstables specified on the command line");
+    }
+    if (!vm.count("generation")) {
+        throw std::invalid_argument("error: missing required option '--generation'");
+    }
+    const auto output_dir = vm["output-dir"].as<std::string>();
+    const auto first_generation = vm["generation"].as<int64_t>();
+    const auto concurrency = std::max(vm["concurrency"].as<unsigned>(), 1u);
+    const auto format = sstables::sstable_format_types::big;
+    const auto version = vm.count("sstable-version")
+            ? sstables::from_string(vm["sstable-version"].as<std::string>())
+            : sstables::get_highest_sstable_version();
+
+    schema_builder builder(schema);
+    if (vm.count("compression") || vm.count("chunk-length-in-kb")) {
+        std::map<sstring, sstring> options;
+        if (vm.count("compression")) {
+            // The options of the old compressor may not apply to the new one.
+            options.emplace(compression_parameters::SSTABLE_COMPRESSION, vm["compression"].as<std::string>());
+        } else {
+            options = schema->get_compressor_params().get_options();
+            if (options.empty()) {
+                throw std::invalid_argument("error: '--chunk-length-in-kb' requires a compressed schema or '--compression'");
+            }
+        }
+        if (vm.count("chunk-length-in-kb")) {
+            options[compression_parameters::CHUNK_LENGTH_KB] = fmt::format("{}", vm["chunk-length-in-kb"].as<unsigned>());
+        }
+        auto cp = options.at(compression_parameters::SSTABLE_COMPRESSION) == "none"
+                ? compression_parameters::no_compression()
+                : compression_parameters(options);
+        cp.validate();
+        builder.set_compressor_params(cp);
+    }
+    if (vm.count("bloom-filter-fp-chance")) {
+        builder.set_bloom_filter_fp_chance(vm["bloom-filter-fp-chance"].as<double>());
+    }
+    auto output_schema = builder.build();
+
+    for (size_t i = 0; i < sstables.size(); ++i) {
+        auto generation = sstables::generation_type(first_generation + i);
+        auto sst_name = sstables::sstable::filename(output_dir, schema->ks_name(), schema->cf_name(), version, generation, format, component_type::Data);
+        if (file_exists(sst_name).get()) {
+            throw std::runtime_error(fmt::format("error: cannot create output sstable {}, file already exists", sst_name));
+        }
+    }
+
+    auto writer_cfg = manager.configure_writer("scylla-sstable");
+    size_t done = 0;
+    max_concurrent_for_each(boost::irange(size_t(0), sstables.size()), concurrency, [&] (size_t i) -> future<> {
+        const auto& sst = sstables[i];
+        auto new_sst = manager.make_sstable(output_schema, output_dir, sstables::generation_type(first_generation + i), version, format);
+        co_await new_sst->write_components(sst->make_reader(schema, permit, query::full_partition_range, schema->full_slice()),
+                sst->get_estimated_key_count(), output_schema, writer_cfg, sst->get_encoding_stats_for_compaction());
+        sst_log.info("rewrote {} into {} ({}/{})", sst->get_filename(), new_sst->get_filename(), ++done, sstables.size());
+    }).get();
+}
+
 template <typename SstableConsumer>
 void sstable_consumer_operation(schema_ptr schema, reader_permit permit, const std::vector<sstables::shared_sstable>& sstables,
         sstables::sstables_manager& sst_man, const bpo::variables_map& vm) {
@@ -2501,6 +2593,11 @@ const std::vector<option> all_options {
     typed_option<std::string>("output-dir", ".", "directory to place the output files to"),
     typed_option<int64_t>("generation", "generation of generated sstable"),
     typed_option<std::string>("validation-level", "clustering_key", "degree of validation on the output, one of (partition_region, token, partition_key, clustering_key)"),
+    typed_option<unsigned>("concurrency", 4, "number of sstables to process in parallel"),
+    typed_option<std::string>("compression", "compressor class of the output, one of (LZ4Compressor, SnappyCompressor, DeflateCompressor, ZstdCompressor, none), default: the one of the schema"),
+    typed_option<unsigned>("chunk-length-in-kb", "compression chunk length of the output, a power of 2, default: the one of the schema"),
+    typed_option<double>("bloom-filter-fp-chance", "false-positive chance of the bloom filter of the output, default: the one of the schema"),
+    typed_option<std::string>("sstable-version", "sstable format version of the output, one of (mc, md, me), default: the highest supported"),
 };
 
 const std::vector<operation> operations{
@@ -2943,13 +3040,15 @@ on the fragment level. The following things are validated:
   changes) are allowed to have weakly monotonically increasing positions.
 * The stream ends with a partition-end fragment.
 
+Unless --merge is used, up to --concurrency sstables are validated in parallel.
+
 [1] Although partitions are said to be unordered, this is only true w.r.t. the
 data type of the key components. Partitions are ordered according to their tokens
 (hashes), so partitions are unordered in the sense that a hash-table is
 unordered: they have a random order as perceived by they user but they have a
 well defined internal order.
 )",
-            {"merge"},
+            {"merge", "concurrency"},
             validate_operation},
     {"validate-checksums",
             "Validate the checksums of the sstable(s)",
@@ -2969,11 +3068,15 @@ This operation reads the entire Data.db and validates both kind of checksums
 against the data. Errors found are logged to stderr. The output just contains a
 bool for each sstable that is true if the sstable matches all checksums.
 
+Up to --concurrency sstables are validated in parallel, progress is logged to
+stderr as each sstable is done.
+
 The content is dumped in JSON, using the following schema:
 
 $ROOT := { "$sstable_path": Bool, ... }
 
 )",
+            {"concurrency"},
             validate_checksums_operation},
     {"decompress",
             "Decompress sstable(s)",
@@ -3038,6 +3141,28 @@ for tests.
 )",
             {"input-file", "output-dir", "generation", "validation-level"},
             write_operation},
+    {"rewrite",
+            "Rewrite sstable(s) with different options",
+R"(
+Read each of the sstables and write its content into a new sstable, with
+the compression, chunk length, bloom filter false-positive chance or
+sstable format version given on the command line. Options which are not
+given are taken from the schema. This allows changing these options of
+existing data without waiting for compaction to rewrite it, e.g. in the
+upload directory, or on a node which is down.
+
+The content of the sstables is not changed, in particular sstables are
+not merged and expired data is not purged. For every input sstable, an
+output sstable is written to --output-dir (the local directory by
+default), with the BIG format and the generations starting at
+--generation, in the order of the input. If any output sstable clashes
+with an existing sstable, nothing is written.
+
+Up to --concurrency sstables are rewritten in parallel, progress is
+logged to stderr as each sstable is done.
+)",
+            {"output-dir", "generation", "concurrency", "compression", "chunk-length-in-kb", "bloom-filter-fp-chance", "sstable-version"},
+            rewrite_operation},
 };
 
 } // anonymous namespace
@@ -38,6 +38,16 @@ struct trace_state::params_values {
     std::optional<db::consistency_level> serial_cl;
     std::optional<int32_t> page_size;
     std::vector<prepared_statement_info> prepared_statements;
+
+    struct stage_time {
+        uint64_t count = 0;
+        elapsed_clock::duration total{0};
+
+        sstring to_string() const {
+            return format("{:d}us in {:d}", std::chrono::duration_cast<std::chrono::microseconds>(total).count(), count);
+        }
+    };
+    std::map<std::string_view, stage_time> stage_times;
 };
 
 trace_state::params_values* trace_state::params_ptr::get_ptr_safe() {
@@ -117,6 +127,16 @@ void trace_state::set_user_timestamp(api::timestamp_type val) {
     _params_ptr->user_timestamp.emplace(val);
 }
 
+void trace_state::add_stage_time(const char* stage, elapsed_clock::duration d) noexcept {
+    try {
+        auto& st = _params_ptr->stage_times[stage];
+        ++st.count;
+        st.total += d;
+    } catch (...) {
+        ++_local_tracing_ptr->stats.trace_errors;
+    }
+}
+
 void trace_state::add_prepared_statement(prepared_checked_weak_ptr& prepared) {
     _params_ptr->prepared_statements.emplace_back(prepared->checked_weak_from_this());
 }
@@ -173,6 +193,10 @@ void trace_state::build_parameters_map() {
         params_map.emplace("user_timestamp", seastar::format("{:d}", *vals.user_timestamp));
     }
 
+    for (const auto& [stage, st] : vals.stage_times) {
+        params_map.emplace(format("stage_time[{}]", stage), st.to_string());
+    }
+
     auto& prepared_statements = vals.prepared_statements;
 
     if (!prepared_statements.empty()) {
@@ -267,6 +291,15 @@ void trace_state::stop_foreground_and_write() noexcept {
                     _records->drop_records();
                 }
             }
+        } else if (_params_ptr && !_params_ptr->stage_times.empty()) {
+            // Secondary sessions have no parameters, trace the times instead.
+            try {
+                trace(join(sstring(", "), _params_ptr->stage_times | boost::adaptors::transformed([] (const auto& e) {
+                    return format("{}: {}", e.first, e.second.to_string());
+                })));
+            } catch (...) {
+                ++_local_tracing_ptr->stats.trace_errors;
+            }
         }
 
         set_state(state::background);
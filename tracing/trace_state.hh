@@ -374,6 +374,20 @@ class trace_state final {
      */
     void set_user_timestamp(api::timestamp_type val);
 
+    /**
+     * Account time spent in a stage of the request, e.g. waiting for the
+     * admission of a read.
+     *
+     * The number of times each stage was entered and the total time spent
+     * in it are stored in the params<string, string> map of a primary
+     * session, with a 'stage_time[<stage>]' key, and traced as a single
+     * event at the end of a secondary one.
+     *
+     * @param stage the name of the stage, has to be a string literal
+     * @param d the time spent in the stage
+     */
+    void add_stage_time(const char* stage, elapsed_clock::duration d) noexcept;
+
     /**
      * Store a pointer to a prepared statement that is being traced.
      *
@@ -484,6 +498,7 @@ class trace_state final {
     friend void add_query(const trace_state_ptr& p, sstring_view val);
     friend void add_session_param(const trace_state_ptr& p, sstring_view key, sstring_view val);
     friend void set_user_timestamp(const trace_state_ptr& p, api::timestamp_type val);
+    friend void add_stage_time(const trace_state_ptr& p, const char* stage, elapsed_clock::duration d) noexcept;
     friend void add_prepared_statement(const trace_state_ptr& p, prepared_checked_weak_ptr& prepared);
     friend void set_username(const trace_state_ptr& p, const std::optional<auth::authenticated_user>& user);
     friend void add_table_name(const trace_state_ptr& p, const sstring& ks_name, const sstring& cf_name);
@@ -629,6 +644,35 @@ inline void add_session_param(const trace_state_ptr& p, sstring_view key, sstrin
     }
 }
 
+inline void add_stage_time(const trace_state_ptr& p, const char* stage, elapsed_clock::duration d) noexcept {
+    if (p) {
+        p->add_stage_time(stage, d);
+    }
+}
+
+/**
+ * Accounts the time from its construction until stop() to a stage of a
+ * traced request. Doesn't read the clock when the request isn't traced.
+ */
+class stage_timer {
+    trace_state_ptr _tr;
+    const char* _stage;
+    elapsed_clock::time_point _start;
+public:
+    stage_timer(trace_state_ptr tr, const char* stage) noexcept
+        : _tr(std::move(tr))
+        , _stage(stage)
+        , _start(_tr ? elapsed_clock::now() : elapsed_clock::time_point())
+    { }
+
+    void stop() noexcept {
+        if (_tr) {
+            add_stage_time(_tr, _stage, elapsed_clock::now() - _start);
+            _tr = nullptr;
+        }
+    }
+};
+
 inline void set_user_timestamp(const trace_state_ptr& p, api::timestamp_type val) {
     if (p) {
         p->set_user_timestamp(val);
@@ -0,0 +1,65 @@
+/*
+ * Copyright (C) 2022-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace cql_transport {
+
+/// Decides which responses of a connection which negotiated compression are
+/// compressed.
+///
+/// Responses smaller than a minimum size aren't worth the CPU. The sizes of
+/// the compressed responses are measured over windows of window_size
+/// uncompressed bytes, and after a window whose ratio of compressed to
+/// uncompressed size is worse than the maximum, the next backoff_responses
+/// responses are sent uncompressed.
+class compression_policy {
+public:
+    static constexpr uint64_t window_size = 1 << 20;
+    static constexpr unsigned backoff_responses = 1024;
+private:
+    uint64_t _window_uncompressed = 0;
+    uint64_t _window_compressed = 0;
+    unsigned _skipped_responses = 0;
+    int64_t _bytes_saved = 0;
+public:
+    bool should_compress(size_t size, size_t min_size) {
+        if (size < min_size) {
+            return false;
+        }
+        if (_skipped_responses) {
+            --_skipped_responses;
+            return false;
+        }
+        return true;
+    }
+
+    void on_compressed(size_t uncompressed_size, size_t compressed_size, double max_ratio) {
+        _bytes_saved += int64_t(uncompressed_size) - int64_t(compressed_size);
+        _window_uncompressed += uncompressed_size;
+        _window_compressed += compressed_size;
+        if (_window_uncompressed >= window_size) {
+            if (_window_compressed > _window_uncompressed * max_ratio) {
+                _skipped_responses = backoff_responses;
+            }
+            _window_uncompressed = 0;
+            _window_compressed = 0;
+        }
+    }
+
+    /// The number of bytes compression saved, negative if the compressed
+    /// responses were larger than the uncompressed ones.
+    int64_t bytes_saved() const {
+        return _bytes_saved;
+    }
+};
+
+}
@@ -265,6 +265,25 @@ class request_reader {
 
         return options;
     }
+
+    // Reads only the consistency and the values of the options, for routing
+    // the request before it is processed. Returns false, and reads nothing
+    // past the flags, if the values are named, as they can't be matched to
+    // their positions without the prepared metadata.
+    bool read_positional_values(uint8_t version, std::vector<cql3::raw_value_view>& values) {
+        read_short();
+        if (version == 1) {
+            return false;
+        }
+        auto flags = enum_set<options_flag_enum>::from_mask(read_byte());
+        if (flags.contains<options_flag::NAMES_FOR_VALUES>()) {
+            return false;
+        }
+        if (flags.contains<options_flag::VALUES>()) {
+            read_value_view_list(version, values);
+        }
+        return true;
+    }
 };
 
 }
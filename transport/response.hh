@@ -79,8 +79,9 @@ class response {
     void write(const cql3::prepared_metadata& m, uint8_t version);
 
     // Make a non-owning scattered_message of the response. Remains valid as long
-    // as the response object is alive.
-    scattered_message<char> make_message(uint8_t version, cql_compression compression);
+    // as the response object is alive. The compression level is only used by
+    // zstd, where 0 is its default level.
+    scattered_message<char> make_message(uint8_t version, cql_compression compression, int compression_level = 0);
 
     cql_binary_opcode opcode() const {
         return _opcode;
@@ -89,9 +90,10 @@ class response {
         return _body.size();
     }
 private:
-    void compress(cql_compression compression);
+    void compress(cql_compression compression, int compression_level);
     void compress_lz4();
     void compress_snappy();
+    void compress_zstd(int compression_level);
 
     template <typename CqlFrameHeaderType>
     sstring make_frame_one(uint8_t version, size_t length) {
@@ -52,6 +52,7 @@
 
 #include <snappy-c.h>
 #include <lz4.h>
+#include <zstd.h>
 
 #include "response.hh"
 #include "request.hh"
@@ -132,6 +133,16 @@ sstring to_string(const event::schema_change::target_type t) {
     assert(false && "unreachable");
 }
 
+sstring to_string(cql_compression c) {
+    switch (c) {
+    case cql_compression::none:   return "none";
+    case cql_compression::lz4:    return "lz4";
+    case cql_compression::snappy: return "snappy";
+    case cql_compression::zstd:   return "zstd";
+    }
+    throw std::invalid_argument("unknown compression algorithm");
+}
+
 event::event_type parse_event_type(const sstring& value)
 {
     if (value == "TOPOLOGY_CHANGE") {
@@ -153,6 +164,11 @@ cql_server::cql_server(distributed<cql3::query_processor>& qp, auth::service& au
     , _config(config)
     , _max_request_size(config.max_request_size)
     , _max_concurrent_requests(db_cfg.max_concurrent_requests_per_shard)
+    , _forward_execute_to_owner_shard(db_cfg.forward_execute_to_owner_shard)
+    , _zstd_compression_level(db_cfg.native_transport_zstd_compression_level)
+    , _compression_min_size(db_cfg.native_transport_compression_min_size)
+    , _compression_max_ratio(db_cfg.native_transport_compression_max_ratio)
+    , _max_connection_memory_fraction(db_cfg.native_transport_max_connection_memory_fraction)
     , _memory_available(ml.get_semaphore())
     , _notifier(std::make_unique<event_notifier>(*this))
     , _auth_service(auth_service)
@@ -180,6 +196,10 @@ cql_server::cql_server(distributed<cql3::query_processor>& qp, auth::service& au
         sm::make_counter("execute_requests", _stats.execute_requests,
                         sm::description("Counts the total number of received CQL EXECUTE messages.")),
 
+        sm::make_counter("execute_requests_forwarded", _stats.execute_requests_forwarded,
+                        sm::description("Counts the CQL EXECUTE messages received on a shard which doesn't own their partition and forwarded to the owning shard before processing, "
+                                            "instead of crossing shards while they are executed.")),
+
         sm::make_counter("batch_requests", _stats.batch_requests,
                         sm::description("Counts the total number of received CQL BATCH messages.")),
 
@@ -198,6 +218,13 @@ cql_server::cql_server(distributed<cql3::query_processor>& qp, auth::service& au
         sm::make_gauge("requests_serving", _stats.requests_serving,
                         sm::description("Holds a number of requests that are being processed right now.")),
 
+        sm::make_counter("responses_written", _stats.responses_written,
+                        sm::description("Counts the responses written to client connections.")),
+
+        sm::make_counter("response_flushes", _stats.response_flushes,
+                        sm::description("Counts the flushes of responses to client connections. Responses queued one behind the other are written together, "
+                                            "so responses_written divided by this is the number of responses per flush.")),
+
         sm::make_gauge("requests_blocked_memory_current", [this] { return _memory_available.waiters(); },
                         sm::description(
                             seastar::format("Holds the number of requests that are currently blocked due to reaching the memory quota limit ({}B). "
@@ -209,6 +236,9 @@ cql_server::cql_server(distributed<cql3::query_processor>& qp, auth::service& au
         sm::make_counter("requests_shed", _stats.requests_shed,
                         sm::description("Holds an incrementing counter with the requests that were shed due to overload (threshold configured via max_concurrent_requests_per_shard). "
                                             "The first derivative of this value shows how often we shed requests due to overload in the \"CQL transport\" component.")),
+        sm::make_counter("requests_blocked_connection_memory", _stats.requests_blocked_connection_memory,
+                        sm::description("Counts the requests which waited for memory because the in-flight requests of their connection reached its share of the memory quota "
+                                            "(configured via native_transport_max_connection_memory_fraction). Reading from such a connection pauses until some of its requests complete.")),
         sm::make_gauge("requests_memory_available", [this] { return _memory_available.current(); },
                         sm::description(
                             seastar::format("Holds the amount of available memory for admitting new requests (max is {}B)."
@@ -520,6 +550,8 @@ cql_server::connection::connection(cql_server& server, socket_address server_add
     , _server(server)
     , _server_addr(server_addr)
     , _client_state(service::client_state::external_tag{}, server._auth_service, &server._sl_controller, server.timeout_config(), addr)
+    , _request_memory_budget(std::max<size_t>(server._max_request_size * std::clamp(server._max_connection_memory_fraction(), 0.0, 1.0), 1))
+    , _request_memory_available(_request_memory_budget)
 {
     _shedding_timer.set_callback([this] {
         clogger.debug("Shedding all incoming requests due to overload");
@@ -556,6 +588,10 @@ client_data cql_server::connection::make_client_data() const {
     } else if (_authenticating) {
         cd.connection_stage = client_connection_stage::authenticating;
     }
+    if (_compression != cql_compression::none) {
+        cd.compression = to_string(_compression);
+        cd.compression_bytes_saved = _compression_policy.bytes_saved();
+    }
     return cd;
 }
 
@@ -628,60 +664,70 @@ future<> cql_server::connection::process_request() {
             });
         }
 
-        const auto shedding_timeout = std::chrono::milliseconds(50);
-        auto fut = allow_shedding
-                ? get_units(_server._memory_available, mem_estimate, shedding_timeout).then_wrapped([this, length = f.length] (auto f) {
-                    try {
-                        return make_ready_future<semaphore_units<>>(f.get0());
-                    } catch (semaphore_timed_out sto) {
-                        // Cancel shedding in case no more requests are going to do that on completion
-                        if (_pending_requests_gate.get_count() == 0) {
-                            _shed_incoming_requests = false;
+        // A request can't take more than the budget of the connection, so
+        // that it can always run alone.
+        const size_t connection_mem_estimate = std::min<size_t>(mem_estimate, _request_memory_budget);
+        if (_request_memory_available.available_units() < ssize_t(connection_mem_estimate)) {
+            ++_server._stats.requests_blocked_connection_memory;
+        }
+        // The next frame isn't read before the connection has the memory for
+        // this one, which pushes back on the client through TCP.
+        return get_units(_request_memory_available, connection_mem_estimate).then([this, f, mem_estimate, allow_shedding, op, stream, tracing_requested] (semaphore_units<> connection_mem_permit) mutable {
+            const auto shedding_timeout = std::chrono::milliseconds(50);
+            auto fut = allow_shedding
+                    ? get_units(_server._memory_available, mem_estimate, shedding_timeout).then_wrapped([this, length = f.length] (auto f) {
+                        try {
+                            return make_ready_future<semaphore_units<>>(f.get0());
+                        } catch (semaphore_timed_out sto) {
+                            // Cancel shedding in case no more requests are going to do that on completion
+                            if (_pending_requests_gate.get_count() == 0) {
+                                _shed_incoming_requests = false;
+                            }
+                            return _read_buf.skip(length).then([sto = std::move(sto)] () mutable {
+                                return make_exception_future<semaphore_units<>>(std::move(sto));
+                            });
                         }
-                        return _read_buf.skip(length).then([sto = std::move(sto)] () mutable {
-                            return make_exception_future<semaphore_units<>>(std::move(sto));
-                        });
-                    }
-                })
-                : get_units(_server._memory_available, mem_estimate);
-        if (_server._memory_available.waiters()) {
-            if (allow_shedding && !_shedding_timer.armed()) {
-                _shedding_timer.arm(shedding_timeout);
+                    })
+                    : get_units(_server._memory_available, mem_estimate);
+            if (_server._memory_available.waiters()) {
+                if (allow_shedding && !_shedding_timer.armed()) {
+                    _shedding_timer.arm(shedding_timeout);
+                }
+                ++_server._stats.requests_blocked_memory;
             }
-            ++_server._stats.requests_blocked_memory;
-        }
 
-        return fut.then_wrapped([this, length = f.length, flags = f.flags, op, stream, tracing_requested] (auto mem_permit_fut) {
-          if (mem_permit_fut.failed()) {
-              // Ignore semaphore errors - they are expected if load shedding took place
-              mem_permit_fut.ignore_ready_future();
-              return make_ready_future<>();
-          }
-          semaphore_units<> mem_permit = mem_permit_fut.get0();
-          return this->read_and_decompress_frame(length, flags).then([this, op, stream, tracing_requested, mem_permit = make_service_permit(std::move(mem_permit))] (fragmented_temporary_buffer buf) mutable {
-
-            ++_server._stats.requests_served;
-            ++_server._stats.requests_serving;
-
-            _pending_requests_gate.enter();
-            auto leave = defer([this] {
-                _shedding_timer.cancel();
-                _shed_incoming_requests = false;
-                _pending_requests_gate.leave();
-            });
-            auto istream = buf.get_istream();
-            (void)_process_request_stage(this, istream, op, stream, seastar::ref(_client_state), tracing_requested, mem_permit)
-                    .then_wrapped([this, buf = std::move(buf), mem_permit, leave = std::move(leave)] (future<foreign_ptr<std::unique_ptr<cql_server::response>>> response_f) mutable {
-                try {
-                    write_response(response_f.get0(), std::move(mem_permit), _compression);
-                    _ready_to_respond = _ready_to_respond.finally([leave = std::move(leave)] {});
-                } catch (...) {
-                    clogger.error("request processing failed: {}", std::current_exception());
-                }
-            });
+            return fut.then_wrapped([this, length = f.length, flags = f.flags, op, stream, tracing_requested, connection_mem_permit = std::move(connection_mem_permit)] (auto mem_permit_fut) mutable {
+              if (mem_permit_fut.failed()) {
+                  // Ignore semaphore errors - they are expected if load shedding took place
+                  mem_permit_fut.ignore_ready_future();
+                  return make_ready_future<>();
+              }
+              semaphore_units<> mem_permit = mem_permit_fut.get0();
+              return this->read_and_decompress_frame(length, flags).then([this, op, stream, tracing_requested, mem_permit = make_service_permit(std::move(mem_permit)), connection_mem_permit = std::move(connection_mem_permit)] (fragmented_temporary_buffer buf) mutable {
+
+                ++_server._stats.requests_served;
+                ++_server._stats.requests_serving;
+
+                _pending_requests_gate.enter();
+                auto leave = defer([this] {
+                    _shedding_timer.cancel();
+                    _shed_incoming_requests = false;
+                    _pending_requests_gate.leave();
+                });
+                auto istream = buf.get_istream();
+                (void)_process_request_stage(this, istream, op, stream, seastar::ref(_client_state), tracing_requested, mem_permit)
+                        .then_wrapped([this, buf = std::move(buf), mem_permit, leave = std::move(leave), connection_mem_permit = std::move(connection_mem_permit)] (future<foreign_ptr<std::unique_ptr<cql_server::response>>> response_f) mutable {
+                    try {
+                        write_response(response_f.get0(), std::move(mem_permit), _compression);
+                        _ready_to_respond = _ready_to_respond.finally([leave = std::move(leave), connection_mem_permit = std::move(connection_mem_permit)] {});
+                    } catch (...) {
+                        clogger.error("request processing failed: {}", std::current_exception());
+                    }
+                });
 
-            return make_ready_future<>();
-          });
+                return make_ready_future<>();
+              });
+            });
         });
     });
 }
@@ -703,6 +749,31 @@ void on_compression_buffer_use() {
     }
 }
 
+struct zstd_cctx_deleter {
+    void operator()(ZSTD_CCtx* ctx) const noexcept { ZSTD_freeCCtx(ctx); }
+};
+
+struct zstd_dctx_deleter {
+    void operator()(ZSTD_DCtx* ctx) const noexcept { ZSTD_freeDCtx(ctx); }
+};
+
+// zstd contexts, reused by all connections of the shard.
+ZSTD_CCtx* zstd_cctx() {
+    static thread_local std::unique_ptr<ZSTD_CCtx, zstd_cctx_deleter> ctx(ZSTD_createCCtx());
+    if (!ctx) {
+        throw std::bad_alloc();
+    }
+    return ctx.get();
+}
+
+ZSTD_DCtx* zstd_dctx() {
+    static thread_local std::unique_ptr<ZSTD_DCtx, zstd_dctx_deleter> ctx(ZSTD_createDCtx());
+    if (!ctx) {
+        throw std::bad_alloc();
+    }
+    return ctx.get();
+}
+
 }
 
 future<fragmented_temporary_buffer> cql_server::connection::read_and_decompress_frame(size_t length, uint8_t flags)
@@ -752,6 +823,29 @@ future<fragmented_temporary_buffer> cql_server::connection::read_and_decompress_
                 on_compression_buffer_use();
                 return uncomp;
             });
+        } else if (_compression == cql_compression::zstd) {
+            return _buffer_reader.read_exactly(_read_buf, length).then([this] (fragmented_temporary_buffer buf) {
+                auto in = input_buffer.get_linearized_view(fragmented_temporary_buffer::view(buf));
+                auto uncomp_len = ZSTD_getFrameContentSize(in.data(), in.size());
+                if (uncomp_len == ZSTD_CONTENTSIZE_UNKNOWN || uncomp_len == ZSTD_CONTENTSIZE_ERROR) {
+                    throw std::runtime_error("CQL frame zstd uncompressed size is unknown");
+                }
+                if (uncomp_len > _server._max_request_size) {
+                    throw std::runtime_error(fmt::format("CQL frame zstd uncompressed size {} is larger than the maximum request size {}", uncomp_len, _server._max_request_size));
+                }
+                auto uncomp = output_buffer.make_fragmented_temporary_buffer(uncomp_len, fragmented_temporary_buffer::default_fragment_size, [&] (bytes_mutable_view out) {
+                    auto ret = ZSTD_decompressDCtx(zstd_dctx(), out.data(), out.size(), in.data(), in.size());
+                    if (ZSTD_isError(ret)) {
+                        throw std::runtime_error(fmt::format("CQL frame zstd uncompression failure: {}", ZSTD_getErrorName(ret)));
+                    }
+                    if (ret != out.size()) {
+                        throw std::runtime_error("Malformed CQL frame - provided uncompressed size different than real uncompressed size");
+                    }
+                    return ret;
+                });
+                on_compression_buffer_use();
+                return uncomp;
+            });
         } else {
             throw exceptions::protocol_exception(format("Unknown compression algorithm"));
         }
@@ -771,6 +865,8 @@ future<std::unique_ptr<cql_server::response>> cql_server::connection::process_st
              _compression = cql_compression::lz4;
          } else if (compression == "snappy") {
              _compression = cql_compression::snappy;
+         } else if (compression == "zstd") {
+             _compression = cql_compression::zstd;
          } else {
              throw exceptions::protocol_exception(format("Unknown compression algorithm: {}", compression));
          }
@@ -971,7 +1067,7 @@ process_execute_internal(service::client_state& client_state, distributed<cql3::
 
     // First, try to lookup in the cache of already authorized statements. If the corresponding entry is not found there
     // look for the prepared statement and then authorize it.
-    auto prepared = qp.local().get_prepared(client_state.user(), cache_key);
+    auto prepared = qp.local().get_prepared(client_state, cache_key);
     if (!prepared) {
         needs_authorization = true;
         prepared = qp.local().get_prepared(cache_key);
@@ -1039,9 +1135,59 @@ process_execute_internal(service::client_state& client_state, distributed<cql3::
     });
 }
 
+// Finds the shard which owns the partition of an EXECUTE request, from the
+// values bound to the partition key of its prepared statement, reading no
+// more of the request than that. Returns nothing if the statement isn't for
+// a single partition, or the request can't be routed without processing it;
+// it is then processed on the shard which received it, as it would be anyway.
+static std::optional<unsigned> owner_shard_of_execute(cql3::query_processor& qp, fragmented_temporary_buffer::istream is,
+        cql_protocol_version_type version) {
+    try {
+        bytes_ostream linearization_buffer;
+        request_reader in(std::move(is), linearization_buffer);
+        cql3::prepared_cache_key_type cache_key(in.read_short_bytes());
+        auto prepared = qp.get_prepared(cache_key);
+        if (!prepared || prepared->partition_key_bind_indices.empty()) {
+            return std::nullopt;
+        }
+        std::vector<cql3::raw_value_view> values;
+        if (!in.read_positional_values(version, values) || values.size() != prepared->bound_names.size()) {
+            return std::nullopt;
+        }
+        std::vector<bytes> components;
+        components.reserve(prepared->partition_key_bind_indices.size());
+        for (auto i : prepared->partition_key_bind_indices) {
+            if (i >= values.size() || !values[i].is_value()) {
+                return std::nullopt;
+            }
+            components.push_back(to_bytes(values[i]));
+        }
+        const auto& spec = *prepared->bound_names.front();
+        auto s = qp.db().find_schema(spec.ks_name, spec.cf_name);
+        auto key = partition_key::from_exploded(*s, components);
+        return dht::shard_of(*s, dht::get_token(*s, key));
+    } catch (...) {
+        // A malformed request fails where it is processed.
+        return std::nullopt;
+    }
+}
+
 future<cql_server::result_with_foreign_response_ptr> cql_server::connection::process_execute(uint16_t stream, request_reader in,
         service::client_state& client_state, service_permit permit, tracing::trace_state_ptr trace_state) {
     ++_server._stats.execute_requests;
+    // Executing a request for a partition owned by another shard crosses to
+    // that shard for every local replica operation, so rather forward the
+    // whole request there once. Traced requests aren't forwarded, as their
+    // tracing begins while they are processed on the receiving shard.
+    if (_server._forward_execute_to_owner_shard() && !trace_state && smp::count > 1) {
+        auto shard = owner_shard_of_execute(_server._query_processor.local(), in.get_stream(), _version);
+        if (shard && *shard != this_shard_id()) {
+            ++_server._stats.execute_requests_forwarded;
+            auto bounce_msg = ::make_shared<messages::result_message::bounce_to_shard>(*shard, cql3::computed_function_values{});
+            return process_on_shard(std::move(bounce_msg), stream, in.get_stream(), client_state, std::move(permit), std::move(trace_state),
+                    process_execute_internal);
+        }
+    }
     return process(stream, in, client_state, std::move(permit), std::move(trace_state), process_execute_internal);
 }
 
@@ -1090,7 +1236,7 @@ process_batch_internal(service::client_state& client_state, distributed<cql3::qu
 
             // First, try to lookup in the cache of already authorized statements. If the corresponding entry is not found there
             // look for the prepared statement and then authorize it.
-            ps = qp.local().get_prepared(client_state.user(), cache_key);
+            ps = qp.local().get_prepared(client_state, cache_key);
             if (!ps) {
                 ps = qp.local().get_prepared(cache_key);
                 if (!ps) {
@@ -1334,6 +1480,7 @@ std::unique_ptr<cql_server::response> cql_server::connection::make_supported(int
     opts.insert({"CQL_VERSION", cql3::query_processor::CQL_VERSION});
     opts.insert({"COMPRESSION", "lz4"});
     opts.insert({"COMPRESSION", "snappy"});
+    opts.insert({"COMPRESSION", "zstd"});
     if (_server._config.allow_shard_aware_drivers) {
         opts.insert({"SCYLLA_SHARD", format("{:d}", this_shard_id())});
         opts.insert({"SCYLLA_NR_SHARDS", format("{:d}", smp::count)});
@@ -1478,20 +1625,42 @@ cql_server::connection::make_schema_change_event(const event::schema_change& eve
     return response;
 }
 
+// Responses written one after the other are flushed together, up to this many,
+// so that pipelined responses don't wait behind too many others.
+static constexpr unsigned max_responses_per_flush = 128;
+
 void cql_server::connection::write_response(foreign_ptr<std::unique_ptr<cql_server::response>>&& response, service_permit permit, cql_compression compression)
 {
+    ++_queued_responses;
     _ready_to_respond = _ready_to_respond.then([this, compression, response = std::move(response), permit = std::move(permit)] () mutable {
-        auto message = response->make_message(_version, compression);
+        if (compression != cql_compression::none && !_compression_policy.should_compress(response->size(), _server._compression_min_size())) {
+            compression = cql_compression::none;
+        }
+        const auto uncompressed_size = response->size();
+        auto message = response->make_message(_version, compression, _server._zstd_compression_level());
+        if (compression != cql_compression::none) {
+            _compression_policy.on_compressed(uncompressed_size, response->size(), _server._compression_max_ratio());
+        }
         message.on_delete([response = std::move(response)] { });
+        --_queued_responses;
+        ++_unflushed_responses;
+        ++_server._stats.responses_written;
         return _write_buf.write(std::move(message)).then([this] {
+            // The responses queued behind this one are written into the same
+            // buffer and leave with the flush after the last of them.
+            if (_queued_responses && _unflushed_responses < max_responses_per_flush) {
+                return make_ready_future<>();
+            }
+            _unflushed_responses = 0;
+            ++_server._stats.response_flushes;
             return _write_buf.flush();
         });
     });
 }
 
-scattered_message<char> cql_server::response::make_message(uint8_t version, cql_compression compression) {
+scattered_message<char> cql_server::response::make_message(uint8_t version, cql_compression compression, int compression_level) {
     if (compression != cql_compression::none) {
-        compress(compression);
+        compress(compression, compression_level);
     }
     scattered_message<char> msg;
     auto frame = make_frame(version, _body.size());
@@ -1502,7 +1671,7 @@ scattered_message<char> cql_server::response::make_message(uint8_t version, cql_
     return msg;
 }
 
-void cql_server::response::compress(cql_compression compression)
+void cql_server::response::compress(cql_compression compression, int compression_level)
 {
     switch (compression) {
     case cql_compression::lz4:
@@ -1511,6 +1680,9 @@ void cql_server::response::compress(cql_compression compression)
     case cql_compression::snappy:
         compress_snappy();
         break;
+    case cql_compression::zstd:
+        compress_zstd(compression_level);
+        break;
     default:
         throw std::invalid_argument("Invalid CQL compression algorithm");
     }
@@ -1562,6 +1734,24 @@ void cql_server::response::compress_snappy()
     on_compression_buffer_use();
 }
 
+void cql_server::response::compress_zstd(int compression_level)
+{
+    using namespace compression_buffers;
+    auto view = input_buffer.get_linearized_view(_body);
+    const char* input = reinterpret_cast<const char*>(view.data());
+    size_t input_len = view.size();
+
+    size_t output_len = ZSTD_compressBound(input_len);
+    _body = output_buffer.make_buffer(output_len, [&] (bytes_mutable_view output_view) {
+        auto ret = ZSTD_compressCCtx(zstd_cctx(), output_view.data(), output_view.size(), input, input_len, compression_level);
+        if (ZSTD_isError(ret)) {
+            throw std::runtime_error(fmt::format("CQL frame zstd compression failure: {}", ZSTD_getErrorName(ret)));
+        }
+        return ret;
+    });
+    on_compression_buffer_use();
+}
+
 void cql_server::response::serialize(const event::schema_change& event, uint8_t version)
 {
     if (version >= 3) {
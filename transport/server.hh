@@ -32,6 +32,7 @@
 #include "utils/chunked_vector.hh"
 #include "exceptions/coordinator_result.hh"
 #include "db/operation_type.hh"
+#include "transport/compression_policy.hh"
 
 namespace cql3 {
 
@@ -69,6 +70,7 @@ enum class cql_compression {
     none,
     lz4,
     snappy,
+    zstd,
 };
 
 enum cql_frame_flags {
@@ -133,6 +135,9 @@ class cql_server : public seastar::peering_sharded_service<cql_server>, public g
         uint32_t requests_serving;
         uint64_t requests_blocked_memory;
         uint64_t requests_shed;
+        uint64_t requests_blocked_connection_memory;
+        uint64_t responses_written;
+        uint64_t response_flushes;
 
         // cql message stats
         uint64_t startups;
@@ -141,6 +146,7 @@ class cql_server : public seastar::peering_sharded_service<cql_server>, public g
         uint64_t query_requests;
         uint64_t prepare_requests;
         uint64_t execute_requests;
+        uint64_t execute_requests_forwarded;
         uint64_t batch_requests;
         uint64_t register_requests;
 
@@ -155,6 +161,11 @@ class cql_server : public seastar::peering_sharded_service<cql_server>, public g
     cql_server_config _config;
     size_t _max_request_size;
     utils::updateable_value<uint32_t> _max_concurrent_requests;
+    utils::updateable_value<bool> _forward_execute_to_owner_shard;
+    utils::updateable_value<int> _zstd_compression_level;
+    utils::updateable_value<uint32_t> _compression_min_size;
+    utils::updateable_value<double> _compression_max_ratio;
+    utils::updateable_value<double> _max_connection_memory_fraction;
     semaphore& _memory_available;
     seastar::metrics::metric_groups _metrics;
     std::unique_ptr<event_notifier> _notifier;
@@ -189,11 +200,20 @@ class cql_server : public seastar::peering_sharded_service<cql_server>, public g
         fragmented_temporary_buffer::reader _buffer_reader;
         cql_protocol_version_type _version = 0;
         cql_compression _compression = cql_compression::none;
+        compression_policy _compression_policy;
+        // Responses passed to write_response() and not written yet, and
+        // responses written since the last flush.
+        unsigned _queued_responses = 0;
+        unsigned _unflushed_responses = 0;
         cql_serialization_format _cql_serialization_format = cql_serialization_format::latest();
         service::client_state _client_state;
         timer<lowres_clock> _shedding_timer;
         bool _shed_incoming_requests = false;
         unsigned _request_cpu = 0;
+        // The memory the in-flight requests of the connection can hold, out
+        // of the memory of the shard for requests.
+        size_t _request_memory_budget;
+        semaphore _request_memory_available;
         bool _ready = false;
         bool _authenticating = false;
 
@@ -2390,6 +2390,43 @@ std::strong_ordering abstract_type::compare(managed_bytes_view v1, managed_bytes
     }
 }
 
+value_tri_comparator::value_tri_comparator(const abstract_type& t)
+    : _type(&t)
+    , _method(method::generic)
+    , _reversed(false)
+{
+    const abstract_type* underlying = &t;
+    if (t.is_reversed()) {
+        underlying = static_cast<const reversed_type_impl&>(t).underlying_type().get();
+    }
+    switch (underlying->get_kind()) {
+    case abstract_type::kind::ascii:
+    case abstract_type::kind::utf8:
+    case abstract_type::kind::bytes:
+    case abstract_type::kind::inet:
+    case abstract_type::kind::duration:
+    case abstract_type::kind::date:
+        _method = method::unsigned_bytes;
+        break;
+    case abstract_type::kind::int32:
+        _method = method::int32;
+        break;
+    case abstract_type::kind::long_kind:
+    case abstract_type::kind::timestamp:
+    case abstract_type::kind::time:
+        _method = method::int64;
+        break;
+    case abstract_type::kind::timeuuid:
+        _method = method::timeuuid;
+        break;
+    default:
+        // Reversed types compare themselves.
+        return;
+    }
+    _type = underlying;
+    _reversed = t.is_reversed();
+}
+
 bool abstract_type::equal(bytes_view v1, bytes_view v2) const {
     return ::visit(*this, [&](const auto& t) {
         if (is_byte_order_equal_visitor{}(t)) {
@@ -753,6 +753,83 @@ bool equal(data_type t, managed_bytes_view e1, managed_bytes_view e2) {
     return t->equal(e1, e2);
 }
 
+// Compares values of a type like abstract_type::compare(), but with the comparison
+// of common fixed-width and byte-ordered types inlined, avoiding the out-of-line
+// call and the dispatch on the type's kind for every value.
+// Selected once per type, e.g. when building the compound type of a key.
+class value_tri_comparator {
+    enum class method : uint8_t {
+        generic,
+        unsigned_bytes,
+        int32,
+        int64,
+        timeuuid,
+    };
+    // The underlying type for reversed types with a specialized method.
+    const abstract_type* _type;
+    method _method;
+    bool _reversed;
+private:
+    static bool is_contiguous_of_size(managed_bytes_view v, size_t size) noexcept {
+        return v.current_fragment().size() == size && v.size_bytes() == size;
+    }
+
+    template <typename T>
+    static std::optional<T> read_fixed(managed_bytes_view v) noexcept {
+        if (is_contiguous_of_size(v, sizeof(T))) [[likely]] {
+            return net::ntoh(read_unaligned<T>(v.current_fragment().data()));
+        }
+        return std::nullopt;
+    }
+
+    template <typename T>
+    std::strong_ordering compare_fixed(managed_bytes_view v1, managed_bytes_view v2) const {
+        auto a = read_fixed<T>(v1);
+        auto b = read_fixed<T>(v2);
+        if (a && b) [[likely]] {
+            return *a <=> *b;
+        }
+        // Empty, fragmented or malformed values.
+        return _type->compare(v1, v2);
+    }
+
+    std::strong_ordering compare_timeuuid(managed_bytes_view v1, managed_bytes_view v2) const {
+        if (is_contiguous_of_size(v1, 16) && is_contiguous_of_size(v2, 16)) [[likely]] {
+            return utils::timeuuid_tri_compare(v1.current_fragment(), v2.current_fragment());
+        }
+        return _type->compare(v1, v2);
+    }
+
+    std::strong_ordering compare(managed_bytes_view v1, managed_bytes_view v2) const {
+        switch (_method) {
+        case method::unsigned_bytes: return compare_unsigned(v1, v2);
+        case method::int32: return compare_fixed<int32_t>(v1, v2);
+        case method::int64: return compare_fixed<int64_t>(v1, v2);
+        case method::timeuuid: return compare_timeuuid(v1, v2);
+        case method::generic: break;
+        }
+        return _type->compare(v1, v2);
+    }
+public:
+    explicit value_tri_comparator(const abstract_type& t);
+
+    std::strong_ordering operator()(managed_bytes_view v1, managed_bytes_view v2) const {
+        return _reversed ? compare(v2, v1) : compare(v1, v2);
+    }
+    std::strong_ordering operator()(bytes_view v1, bytes_view v2) const {
+        return (*this)(managed_bytes_view(v1), managed_bytes_view(v2));
+    }
+
+    // For lexicographical_tri_compare() and prefix_equality_tri_compare(), which
+    // pass the comparator of the component first.
+    struct component_tri_compare {
+        template <typename View>
+        std::strong_ordering operator()(const value_tri_comparator& cmp, const View& v1, const View& v2) const {
+            return cmp(v1, v2);
+        }
+    };
+};
+
 class row_tombstone;
 
 class collection_type_impl;
@@ -0,0 +1,53 @@
+/*
+ * Copyright (C) 2022-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <thread>
+#include <type_traits>
+
+#include <seastar/core/alien.hh>
+#include <seastar/core/future.hh>
+#include <seastar/core/reactor.hh>
+#include <seastar/core/smp.hh>
+
+namespace utils {
+
+/// Runs func in a thread of its own and returns its result on the calling shard.
+///
+/// For long computations which can't yield, typically calls into third-party
+/// libraries, and which would stall the reactor if run on it. func runs
+/// outside of the reactor, so it may only use the objects it owns and the
+/// ones the caller keeps alive until the returned future resolves, and it
+/// must not use any seastar facility.
+template <typename Func>
+requires std::is_nothrow_invocable_v<Func>
+seastar::future<std::invoke_result_t<Func>> run_in_alien_thread(Func func) {
+    using result_type = std::invoke_result_t<Func>;
+    // Only touched on the calling shard, apart from the result, which the
+    // thread sets before handing the state back.
+    struct state {
+        seastar::promise<result_type> pr;
+        std::optional<result_type> result;
+    };
+    auto st = std::make_unique<state>();
+    auto fut = st->pr.get_future();
+    std::thread([func = std::move(func), st = st.get(), shard = seastar::this_shard_id(), &alien = seastar::engine().alien()] () mutable noexcept {
+        st->result.emplace(func());
+        seastar::alien::run_on(alien, shard, [st] () noexcept {
+            auto owned = std::unique_ptr<state>(st);
+            owned->pr.set_value(std::move(*owned->result));
+        });
+    }).detach();
+    st.release();
+    return fut;
+}
+
+} // namespace utils
@@ -20,6 +20,16 @@
 #include <cstdlib>
 #include "bloom_filter.hh"
 
+#ifdef __x86_64__
+#include <x86intrin.h>
+#define arch_target(name) [[gnu::target(name)]]
+#else
+#define arch_target(name)
+#endif
+#ifdef __aarch64__
+#include <arm_neon.h>
+#endif
+
 namespace utils {
 namespace filter {
 
@@ -69,10 +79,135 @@ void bloom_filter::add(const bytes_view& key) {
     });
 }
 
+void bloom_filter::add_hashed(std::span<const hashed_key> keys) {
+    // Prefetch the first bit of every key before setting any, so that the
+    // cache misses of the keys overlap.
+    for (auto& k : keys) {
+        for_each_index(k, 1, _bitset.size(), _format, [this] (auto i) {
+            __builtin_prefetch(_bitset.words(i / 64), 1);
+            return stop_iteration::yes;
+        });
+    }
+    for (auto& k : keys) {
+        for_each_index(k, _hash_count, _bitset.size(), _format, [this] (auto i) {
+            _bitset.set(i);
+            return stop_iteration::no;
+        });
+    }
+}
+
 bool bloom_filter::is_present(const bytes_view& key) {
     return is_present(make_hashed_key(key));
 }
 
+// Odd constants used to derive the bit of each word of a block from a key,
+// as in the Parquet split block bloom filter.
+static constexpr std::array<uint32_t, split_block_bloom_filter::words_per_block> split_block_salts = {
+    0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+    0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U,
+};
+
+// The block is 4 64-bit words of the bitset. Word i of the block is the
+// (i % 2)-th 32-bit half of bitset word i / 2, starting from the least
+// significant one, which is also the memory order on little endian machines.
+static inline uint64_t split_block_mask(uint32_t key, size_t word) noexcept {
+    auto lo = uint64_t(1) << ((key * split_block_salts[2 * word]) >> 27);
+    auto hi = uint64_t(1) << ((key * split_block_salts[2 * word + 1]) >> 27);
+    return lo | (hi << 32);
+}
+
+arch_target("default") bool split_block_test(const uint64_t* block, uint32_t key) noexcept {
+#ifdef __aarch64__
+    const uint32x4_t one = vdupq_n_u32(1);
+    const uint32x4_t k = vdupq_n_u32(key);
+    auto mask = [&] (const uint32_t* salts) {
+        return vshlq_u32(one, vreinterpretq_s32_u32(vshrq_n_u32(vmulq_u32(k, vld1q_u32(salts)), 27)));
+    };
+    auto words = reinterpret_cast<const uint32_t*>(block);
+    auto m_lo = mask(split_block_salts.data());
+    auto m_hi = mask(split_block_salts.data() + 4);
+    auto ok = vandq_u32(vceqq_u32(vandq_u32(vld1q_u32(words), m_lo), m_lo),
+                        vceqq_u32(vandq_u32(vld1q_u32(words + 4), m_hi), m_hi));
+    return vminvq_u32(ok) == 0xffffffffU;
+#else
+    bool result = true;
+    for (size_t i = 0; i < 4; ++i) {
+        auto m = split_block_mask(key, i);
+        result &= (block[i] & m) == m;
+    }
+    return result;
+#endif
+}
+
+#ifdef __x86_64__
+arch_target("avx2") bool split_block_test(const uint64_t* block, uint32_t key) noexcept {
+    const __m256i salts = _mm256_setr_epi32(
+            split_block_salts[0], split_block_salts[1], split_block_salts[2], split_block_salts[3],
+            split_block_salts[4], split_block_salts[5], split_block_salts[6], split_block_salts[7]);
+    // 1. Multiply the key by the salts, the top 5 bits of every product select a bit of the word
+    __m256i shifts = _mm256_srli_epi32(_mm256_mullo_epi32(_mm256_set1_epi32(key), salts), 27);
+    // 2. Turn them into single-bit masks
+    __m256i mask = _mm256_sllv_epi32(_mm256_set1_epi32(1), shifts);
+    // 3. Check that all of them are set in the block
+    return _mm256_testc_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(block)), mask);
+}
+#endif
+
+split_block_bloom_filter::split_block_bloom_filter(bitmap&& bs) noexcept
+    : _bitset(std::move(bs))
+    , _blocks(_bitset.size() / bits_per_block)
+{
+    _stats.memory_size += memory_size();
+}
+
+split_block_bloom_filter::~split_block_bloom_filter() noexcept {
+    _stats.memory_size -= memory_size();
+}
+
+size_t split_block_bloom_filter::block_of(hashed_key key) const noexcept {
+    // Maps the hash uniformly on [0, _blocks) without a division.
+    return (static_cast<unsigned __int128>(key.hash()[0]) * _blocks) >> 64;
+}
+
+bool split_block_bloom_filter::is_present(hashed_key key) {
+    if (!_blocks) {
+        return true;
+    }
+    auto block = _bitset.words(block_of(key) * (bits_per_block / 64));
+    return split_block_test(block, static_cast<uint32_t>(key.hash()[1]));
+}
+
+void split_block_bloom_filter::add(const bytes_view& key) {
+    add(make_hashed_key(key));
+}
+
+void split_block_bloom_filter::add_hashed(std::span<const hashed_key> keys) {
+    if (!_blocks) {
+        return;
+    }
+    for (auto& k : keys) {
+        __builtin_prefetch(_bitset.words(block_of(k) * (bits_per_block / 64)), 1);
+    }
+    for (auto& k : keys) {
+        add(k);
+    }
+}
+
+void split_block_bloom_filter::add(hashed_key hk) {
+    if (!_blocks) {
+        return;
+    }
+    auto block = _bitset.words(block_of(hk) * (bits_per_block / 64));
+    auto k = static_cast<uint32_t>(hk.hash()[1]);
+    for (size_t i = 0; i < 4; ++i) {
+        block[i] |= split_block_mask(k, i);
+    }
+}
+
+bool split_block_bloom_filter::is_present(const bytes_view& key) {
+    return is_present(make_hashed_key(key));
+}
+
 filter_ptr create_filter(int hash, large_bitset&& bitset, filter_format format) {
     return std::make_unique<murmur3_bloom_filter>(hash, std::move(bitset), format);
 }
@@ -83,5 +218,12 @@ filter_ptr create_filter(int hash, int64_t num_elements, int buckets_per, filter
     large_bitset bitset(num_bits);
     return std::make_unique<murmur3_bloom_filter>(hash, std::move(bitset), format);
 }
+
+filter_ptr create_filter_from_disk(uint32_t hashes, large_bitset&& bitset, filter_format format) {
+    if (hashes & split_block_bloom_filter::format_marker) {
+        return std::make_unique<split_block_bloom_filter>(std::move(bitset));
+    }
+    return create_filter(hashes, std::move(bitset), format);
+}
 }
 }
@@ -42,6 +42,7 @@ class bloom_filter: public i_filter {
     ~bloom_filter() noexcept;
 
     virtual void add(const bytes_view& key) override;
+    virtual void add_hashed(std::span<const hashed_key> keys) override;
 
     virtual bool is_present(const bytes_view& key) override;
 
@@ -60,6 +61,8 @@ class bloom_filter: public i_filter {
     static const stats& get_shard_stats() noexcept {
         return _shard_stats;
     }
+
+    friend class split_block_bloom_filter;
 };
 
 struct murmur3_bloom_filter: public bloom_filter {
@@ -69,6 +72,56 @@ struct murmur3_bloom_filter: public bloom_filter {
     {}
 };
 
+// A bloom filter which confines all bits of a key to a single 256-bit
+// block, so that a lookup costs a single cache miss instead of one per hash.
+// Each block is made of 8 32-bit words and a key sets exactly one bit in
+// each word (see "Cache-, Hash- and Space-Efficient Bloom Filters" by Putze
+// et al. and the Parquet split block bloom filter).
+//
+// On disk it uses the same layout as bloom_filter, with format_marker set in
+// the hash count so that it can be told apart from it.
+class split_block_bloom_filter: public i_filter {
+public:
+    using bitmap = large_bitset;
+
+    static constexpr size_t words_per_block = 8;
+    static constexpr size_t bits_per_block = words_per_block * 32;
+    // Set in the hash count field of Filter.db. Versions which don't know
+    // about this filter see a negative hash count, and end up with a filter
+    // which considers every key present.
+    static constexpr uint32_t format_marker = uint32_t(1) << 31;
+private:
+    bitmap _bitset;
+    size_t _blocks;
+    bloom_filter::stats& _stats = bloom_filter::_shard_stats;
+
+    size_t block_of(hashed_key key) const noexcept;
+public:
+    explicit split_block_bloom_filter(bitmap&& bs) noexcept;
+    ~split_block_bloom_filter() noexcept;
+
+    bitmap& bits() { return _bitset; }
+    uint32_t serialized_hashes() const { return format_marker | words_per_block; }
+
+    virtual void add(const bytes_view& key) override;
+    virtual void add_hashed(std::span<const hashed_key> keys) override;
+    void add(hashed_key key);
+
+    virtual bool is_present(const bytes_view& key) override;
+
+    virtual bool is_present(hashed_key key) override;
+
+    virtual void clear() override {
+        _bitset.clear();
+    }
+
+    virtual void close() override { }
+
+    virtual size_t memory_size() override {
+        return _bitset.memory_size();
+    }
+};
+
 struct always_present_filter: public i_filter {
 
     virtual bool is_present(const bytes_view& key) override {
@@ -81,6 +134,8 @@ struct always_present_filter: public i_filter {
 
     virtual void add(const bytes_view& key) override { }
 
+    virtual void add_hashed(std::span<const hashed_key> keys) override { }
+
     virtual void clear() override { }
 
     virtual void close() override { }
@@ -92,5 +147,7 @@ struct always_present_filter: public i_filter {
 
 filter_ptr create_filter(int hash, large_bitset&& bitset, filter_format format);
 filter_ptr create_filter(int hash, int64_t num_elements, int buckets_per, filter_format format);
+// Creates a filter read from Filter.db, which may be a split_block_bloom_filter.
+filter_ptr create_filter_from_disk(uint32_t hashes, large_bitset&& bitset, filter_format format);
 }
 }
@@ -12,6 +12,7 @@
 #include "utils/div_ceil.hh"
 #include "utils/bptree.hh"
 #include "utils/lru.hh"
+#include "utils/secondary_page_cache.hh"
 #include "tracing/trace_state.hh"
 
 #include <seastar/core/file.hh>
@@ -27,6 +28,9 @@ using namespace seastar;
 /// Caches contents with page granularity (4 KiB).
 /// Cached pages are evicted by the LRU or manually using the invalidate_*() method family, or when the object is destroyed.
 ///
+/// Pages evicted by the LRU are kept in the secondary page cache, if one is given, which is checked on misses
+/// before reading from the file.
+///
 /// Concurrent reading is allowed.
 ///
 /// The object is movable but this is only allowed before readers are created.
@@ -154,49 +158,77 @@ class cached_file {
 
     offset_type _last_page_size;
     page_idx_type _last_page;
+
+    utils::secondary_page_cache* _secondary;
+    utils::secondary_page_cache::file_id _secondary_id;
 private:
+    // Populates the cache with pages starting at idx from buf, and returns the first one.
+    cached_page::ptr_type populate(page_idx_type idx, temporary_buffer<char> buf) {
+        cached_page::ptr_type first_page;
+        while (buf.size()) {
+            auto this_size = std::min(page_size, buf.size());
+            // _cache.emplace() needs to run under allocating section even though it lives in the std space
+            // because bplus::tree operations are not reentrant, so we need to prevent memory reclamation.
+            auto it_and_flag = _as(_region, [&] {
+                auto this_buf = buf.share();
+                this_buf.trim(this_size);
+                return _cache.emplace(idx, this, idx, std::move(this_buf));
+            });
+            buf.trim_front(this_size);
+            ++idx;
+            cached_page &cp = *it_and_flag.first;
+            if (it_and_flag.second) {
+                ++_metrics.page_populations;
+                _metrics.cached_bytes += cp.size_in_allocator();
+                _cached_bytes += cp.size_in_allocator();
+            }
+            if (!first_page) {
+                first_page = cp.share();
+            }
+        }
+        return first_page;
+    }
+
     future<cached_page::ptr_type> get_page_ptr(page_idx_type idx,
             page_count_type read_ahead,
             const io_priority_class& pc,
-            tracing::trace_state_ptr trace_state) {
+            tracing::trace_state_ptr trace_state,
+            reader_permit::read_stats* stats = nullptr) {
         auto i = _cache.lower_bound(idx);
         if (i != _cache.end() && i->idx == idx) {
             ++_metrics.page_hits;
+            if (stats) {
+                ++stats->cached_file_page_hits;
+            }
             tracing::trace(trace_state, "page cache hit: file={}, page={}", _file_name, idx);
             cached_page& cp = *i;
             return make_ready_future<cached_page::ptr_type>(cp.share());
         }
         tracing::trace(trace_state, "page cache miss: file={}, page={}, readahead={}", _file_name, idx, read_ahead);
         ++_metrics.page_misses;
+        if (stats) {
+            ++stats->cached_file_page_misses;
+        }
         size_t size = (idx + read_ahead) > _last_page
                 ? (_last_page_size + (_last_page - idx) * page_size)
                 : read_ahead * page_size;
-        return _file.dma_read_exactly<char>(idx * page_size, size, pc)
-            .then([this, idx] (temporary_buffer<char>&& buf) mutable {
-                cached_page::ptr_type first_page;
-                while (buf.size()) {
-                    auto this_size = std::min(page_size, buf.size());
-                    // _cache.emplace() needs to run under allocating section even though it lives in the std space
-                    // because bplus::tree operations are not reentrant, so we need to prevent memory reclamation.
-                    auto it_and_flag = _as(_region, [&] {
-                        auto this_buf = buf.share();
-                        this_buf.trim(this_size);
-                        return _cache.emplace(idx, this, idx, std::move(this_buf));
-                    });
-                    buf.trim_front(this_size);
-                    ++idx;
-                    cached_page &cp = *it_and_flag.first;
-                    if (it_and_flag.second) {
-                        ++_metrics.page_populations;
-                        _metrics.cached_bytes += cp.size_in_allocator();
-                        _cached_bytes += cp.size_in_allocator();
-                    }
-                    if (!first_page) {
-                        first_page = cp.share();
-                    }
-                }
-                return first_page;
-            });
+        auto read_file = [this, idx, size, &pc] {
+            return _file.dma_read_exactly<char>(idx * page_size, size, pc)
+                .then([this, idx] (temporary_buffer<char>&& buf) mutable {
+                    return populate(idx, std::move(buf));
+                });
+        };
+        if (!_secondary) {
+            return read_file();
+        }
+        return _secondary->get(_secondary_id, idx, pc).then([this, idx, read_file, trace_state] (temporary_buffer<char> buf) {
+            if (!buf) {
+                return read_file();
+            }
+            tracing::trace(trace_state, "page cache: secondary hit: file={}, page={}", _file_name, idx);
+            // Read-ahead is given up on, further pages are likely in the secondary cache too.
+            return make_ready_future<cached_page::ptr_type>(populate(idx, std::move(buf)));
+        });
     }
     future<temporary_buffer<char>> get_page(page_idx_type idx,
                                             page_count_type count,
@@ -305,7 +337,7 @@ class cached_file {
             auto units = get_page_units(_size_hint);
             page_count_type readahead = div_ceil(_size_hint, page_size);
             _size_hint = page_size;
-            return _cached_file->get_page_ptr(_page_idx, readahead, *_pc, _trace_state).then(
+            return _cached_file->get_page_ptr(_page_idx, readahead, *_pc, _trace_state, _permit ? &_permit->stats() : nullptr).then(
                     [this, units = std::move(units)] (cached_page::ptr_type page) mutable {
                 size_t size = _page_idx == _cached_file->_last_page
                         ? _cached_file->_last_page_size
@@ -349,7 +381,9 @@ class cached_file {
     /// \param m Metrics object which should be updated from operations on this object.
     ///          The metrics object can be shared by many cached_file instances, in which case it
     ///          will reflect the sum of operations on all cached_file instances.
-    cached_file(file f, cached_file::metrics& m, lru& l, logalloc::region& reg, offset_type size, sstring file_name = {})
+    /// \param secondary When engaged, pages evicted by the LRU are kept there.
+    cached_file(file f, cached_file::metrics& m, lru& l, logalloc::region& reg, offset_type size, sstring file_name = {},
+                utils::secondary_page_cache* secondary = nullptr)
         : _file(std::move(f))
         , _file_name(std::move(file_name))
         , _metrics(m)
@@ -357,6 +391,8 @@ class cached_file {
         , _region(reg)
         , _cache(page_idx_less_comparator())
         , _size(size)
+        , _secondary(secondary)
+        , _secondary_id(secondary ? secondary->register_file() : 0)
     {
         offset_type last_byte_offset = _size ? (_size - 1) : 0;
         _last_page_size = (last_byte_offset % page_size) + (_size ? 1 : 0);
@@ -367,6 +403,9 @@ class cached_file {
     cached_file(const cached_file&) = delete;
 
     ~cached_file() {
+        if (_secondary) {
+            _secondary->invalidate(_secondary_id);
+        }
         evict_range(_cache.begin(), _cache.end());
         assert(_cache.empty());
     }
@@ -465,6 +504,9 @@ class cached_file {
 
 inline
 void cached_file::cached_page::on_evicted() noexcept {
+    if (parent->_secondary) {
+        parent->_secondary->put(parent->_secondary_id, idx, _lsa_buf.get(), _lsa_buf.size());
+    }
     parent->on_evicted(*this);
     with_allocator(standard_allocator(), [this] {
         cached_file::cache_type::iterator it(this);
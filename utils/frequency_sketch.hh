@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2022-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace utils {
+
+/// \brief Approximate access frequency of keys, in the spirit of TinyLFU.
+///
+/// A count-min sketch of 4-bit counters, which is aged by halving all
+/// counters after a number of accesses proportional to its size, so that the
+/// estimates reflect recent history. Keys are given as 64-bit hashes.
+///
+/// The first access of a key since the last aging only sets its bits in the
+/// doorkeeper, a bloom filter which is cleared when aging. This keeps keys
+/// accessed once, which is the bulk of the keys in scans, out of the counters.
+///
+/// Neither recording nor estimating allocates.
+class frequency_sketch {
+    static constexpr unsigned depth = 4;
+    static constexpr uint64_t max_count = 15;
+    static constexpr uint64_t counters_per_word = 16;
+
+    std::vector<uint64_t> _table;
+    std::vector<uint64_t> _doorkeeper;
+    uint64_t _table_mask;
+    uint64_t _doorkeeper_mask;
+    uint64_t _samples = 0;
+    uint64_t _sample_size;
+    uint64_t _resets = 0;
+private:
+    static uint64_t mix(uint64_t h, unsigned i) noexcept {
+        static constexpr uint64_t seeds[] = {
+            0xc3a5c85c97cb3127ULL, 0xb492b66fbe98f273ULL, 0x9ae16a3b2f90404fULL, 0xcbf29ce484222325ULL,
+            0x84222325cbf29ce4ULL, 0xff51afd7ed558ccdULL,
+        };
+        h = (h ^ seeds[i]) * 0x9e3779b97f4a7c15ULL;
+        return h ^ (h >> 32);
+    }
+    // Position of the i-th counter of the key: (word, shift).
+    std::pair<uint64_t, unsigned> counter_of(uint64_t h, unsigned i) const noexcept {
+        auto m = mix(h, i);
+        return {m & _table_mask, unsigned((m >> 58) & (counters_per_word - 1)) * 4};
+    }
+    bool doorkeeper_contains(uint64_t h) const noexcept {
+        for (unsigned i = 0; i < 2; ++i) {
+            auto bit = mix(h, depth + i) & _doorkeeper_mask;
+            if (!(_doorkeeper[bit / 64] & (uint64_t(1) << (bit % 64)))) {
+                return false;
+            }
+        }
+        return true;
+    }
+    void doorkeeper_add(uint64_t h) noexcept {
+        for (unsigned i = 0; i < 2; ++i) {
+            auto bit = mix(h, depth + i) & _doorkeeper_mask;
+            _doorkeeper[bit / 64] |= uint64_t(1) << (bit % 64);
+        }
+    }
+    void reset() noexcept {
+        for (auto& w : _table) {
+            w = (w >> 1) & 0x7777777777777777ULL;
+        }
+        std::fill(_doorkeeper.begin(), _doorkeeper.end(), 0);
+        _samples /= 2;
+        ++_resets;
+    }
+public:
+    /// \brief Creates a sketch for tracking about \p capacity distinct keys.
+    explicit frequency_sketch(size_t capacity)
+        : _table(std::bit_ceil(std::max<size_t>(capacity / counters_per_word, 1)))
+        , _doorkeeper(std::bit_ceil(std::max<size_t>(capacity / 64, 1)))
+        , _table_mask(_table.size() - 1)
+        , _doorkeeper_mask(_doorkeeper.size() * 64 - 1)
+        , _sample_size(std::max<size_t>(capacity, 1) * 10)
+    { }
+
+    /// \brief Records an access to the key.
+    void record(uint64_t h) noexcept {
+        if (!doorkeeper_contains(h)) {
+            doorkeeper_add(h);
+        } else {
+            for (unsigned i = 0; i < depth; ++i) {
+                auto [word, shift] = counter_of(h, i);
+                if (((_table[word] >> shift) & max_count) != max_count) {
+                    _table[word] += uint64_t(1) << shift;
+                }
+            }
+        }
+        if (++_samples >= _sample_size) {
+            reset();
+        }
+    }
+
+    /// \brief Returns the estimated number of recent accesses to the key.
+    unsigned estimate(uint64_t h) const noexcept {
+        uint64_t count = max_count;
+        for (unsigned i = 0; i < depth; ++i) {
+            auto [word, shift] = counter_of(h, i);
+            count = std::min(count, (_table[word] >> shift) & max_count);
+        }
+        return count + doorkeeper_contains(h);
+    }
+
+    /// \brief Number of times the sketch was aged.
+    ///
+    /// Users keeping estimates around can use it to age them as well.
+    uint64_t resets() const noexcept {
+        return _resets;
+    }
+};
+
+} // namespace utils
@@ -11,6 +11,7 @@
 #include "bloom_filter.hh"
 #include "bloom_calculations.hh"
 #include <seastar/core/thread.hh>
+#include <seastar/core/align.hh>
 
 namespace utils {
 static logging::logger filterlog("bloom_filter");
@@ -31,6 +32,28 @@ filter_ptr i_filter::get_filter(int64_t num_elements, double max_false_pos_proba
     return filter::create_filter(spec.K, num_elements, spec.buckets_per_element, fformat);
 }
 
+filter_ptr i_filter::get_split_block_filter(int64_t num_elements, double max_false_pos_probability) {
+    assert(seastar::thread::running_in_thread());
+
+    if (max_false_pos_probability > 1.0) {
+        throw std::invalid_argument(format("Invalid probability {:f}: must be lower than 1.0", max_false_pos_probability));
+    }
+
+    if (max_false_pos_probability == 1.0) {
+        return std::make_unique<filter::always_present_filter>();
+    }
+
+    int buckets_per_element = bloom_calculations::max_buckets_per_element(num_elements);
+    auto spec = bloom_calculations::compute_bloom_spec(buckets_per_element, max_false_pos_probability);
+    // Confining the bits of a key to a block makes the false positive rate of a
+    // split block filter worse than that of a standard one of the same size, by
+    // up to about 20% more bits needed for the false positive chances used in
+    // practice. Compensate for that.
+    int64_t num_bits = (num_elements * spec.buckets_per_element * 6) / 5 + bloom_calculations::EXCESS;
+    num_bits = align_up<int64_t>(num_bits, filter::split_block_bloom_filter::bits_per_block);
+    return std::make_unique<filter::split_block_bloom_filter>(large_bitset(num_bits));
+}
+
 hashed_key make_hashed_key(bytes_view b) {
     std::array<uint64_t, 2> h;
     utils::murmur_hash::hash3_x64_128(b, 0, h);
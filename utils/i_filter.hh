@@ -9,6 +9,8 @@
  */
 #pragma once
 
+#include <span>
+
 #include "bytes.hh"
 #include "bloom_calculations.hh"
 
@@ -38,6 +40,10 @@ struct i_filter {
     virtual ~i_filter() {}
 
     virtual void add(const bytes_view& key) = 0;
+    // Adds keys hashed with make_hashed_key(). Implementations may overlap
+    // the memory accesses of the keys, so batching keys pays off for large
+    // filters.
+    virtual void add_hashed(std::span<const hashed_key> keys) = 0;
     virtual bool is_present(const bytes_view& key) = 0;
     virtual bool is_present(hashed_key) = 0;
     virtual void clear() = 0;
@@ -53,5 +59,12 @@ struct i_filter {
      *         filter.
      */
     static filter_ptr get_filter(int64_t num_elements, double max_false_pos_prob, filter_format format);
+
+    /**
+     * @return The smallest split_block_bloom_filter that can provide about
+     *         the given false positive probability rate for the given number
+     *         of elements.
+     */
+    static filter_ptr get_split_block_filter(int64_t num_elements, double max_false_pos_prob);
 };
 }
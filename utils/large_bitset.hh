@@ -58,6 +58,16 @@ class large_bitset {
     }
     void clear();
 
+    // Access to the words backing the bitset, for callers operating on
+    // several bits at a time. Words of an aligned group of 4 are contiguous
+    // in memory, since the chunk capacity of the storage is a multiple of 4.
+    const int_type* words(size_t word_idx) const {
+        return &_storage[word_idx];
+    }
+    int_type* words(size_t word_idx) {
+        return &_storage[word_idx];
+    }
+
     const utils::chunked_vector<int_type>& get_storage() const {
         return _storage;
     }
@@ -493,6 +493,8 @@ class tracker::impl {
     size_t compact_and_evict(size_t reserve_segments, size_t bytes, is_preemptible p);
     void full_compaction();
     void reclaim_all_free_segments();
+    size_t compact_sparse_segments(float max_occupancy);
+    tracker::segment_occupancy_histogram segment_occupancy(bool evictable) const;
     occupancy_stats global_occupancy() const noexcept;
     occupancy_stats region_occupancy() const noexcept;
     occupancy_stats occupancy() const noexcept;
@@ -582,6 +584,14 @@ void tracker::reclaim_all_free_segments() {
     return _impl->reclaim_all_free_segments();
 }
 
+size_t tracker::compact_sparse_segments(float max_occupancy) {
+    return _impl->compact_sparse_segments(max_occupancy);
+}
+
+tracker::segment_occupancy_histogram tracker::segment_occupancy(bool evictable) const {
+    return _impl->segment_occupancy(evictable);
+}
+
 tracker& shard_tracker() noexcept {
     return tracker_instance;
 }
@@ -612,6 +622,8 @@ struct alignas(segment_size) segment {
 };
 
 static constexpr size_t max_managed_object_size = segment_size * 0.1;
+// Size of the transparent huge pages backing the memory of the shard.
+static constexpr size_t huge_page_size = 2 << 20;
 static constexpr auto max_used_space_ratio_for_compaction = 0.85;
 static constexpr size_t max_used_space_for_compaction = segment_size * max_used_space_ratio_for_compaction;
 static constexpr size_t min_free_space_for_compaction = segment_size - max_used_space_for_compaction;
@@ -1044,6 +1056,9 @@ class segment_pool {
     void free_segment(segment*) noexcept;
     void free_segment(segment*, segment_descriptor&) noexcept;
     size_t segments_in_use() const noexcept;
+    // Number of huge pages spanned by segments owned by LSA, in use or free.
+    size_t huge_pages_owned() const noexcept;
+    size_t owned_segments() const noexcept { return _segments_in_use + _free_segments; }
     size_t current_emergency_reserve_goal() const noexcept { return _current_emergency_reserve_goal; }
     void set_emergency_reserve_max(size_t new_size) noexcept { _emergency_reserve_max = new_size; }
     size_t emergency_reserve_max() const noexcept { return _emergency_reserve_max; }
@@ -1432,6 +1447,22 @@ size_t segment_pool::segments_in_use() const noexcept {
     return _segments_in_use;
 }
 
+size_t segment_pool::huge_pages_owned() const noexcept {
+    // Owned segments are iterated in address order, so those sharing a huge page are adjacent.
+    size_t pages = 0;
+    uintptr_t last_page = 0;
+    for (size_t idx = _lsa_owned_segments_bitmap.find_first_set();
+            idx != utils::dynamic_bitset::npos;
+            idx = _lsa_owned_segments_bitmap.find_next_set(idx)) {
+        auto page = reinterpret_cast<uintptr_t>(segment_from_idx(idx)) / huge_page_size;
+        if (!pages || page != last_page) {
+            ++pages;
+            last_page = page;
+        }
+    }
+    return pages;
+}
+
 reclaim_timer::reclaim_timer(const char* name, is_preemptible preemptible, size_t memory_to_release, size_t segments_to_release, tracker::impl& tracker, segment_pool& segment_pool, extra_logger extra_logs)
     : _duration_threshold(
             // We only report reclaim stalls when their measured duration is
@@ -2208,6 +2239,13 @@ class region_impl final : public basic_region_impl {
         return _segment_descs.one_of_largest().occupancy();
     }
 
+    void add_segment_occupancy(tracker::segment_occupancy_histogram& hist) const noexcept {
+        for (const auto& desc : _segment_descs) {
+            auto bucket = size_t(desc.occupancy().used_fraction() * hist.size());
+            ++hist[std::min(bucket, hist.size() - 1)];
+        }
+    }
+
     // Compacts a single segment, most appropriate for it
     void compact() noexcept {
         compaction_lock _(*this);
@@ -2572,6 +2610,54 @@ idle_cpu_handler_result tracker::impl::compact_on_idle(work_waiting_on_reactor c
     return idle_cpu_handler_result::interrupted_by_higher_priority_task;
 }
 
+size_t tracker::impl::compact_sparse_segments(float max_occupancy) {
+    if (_reclaiming_disabled_depth) {
+        return 0;
+    }
+    reclaiming_lock rl(*this);
+    segment_pool::reservation_goal open_emergency_pool(*_segment_pool, 0);
+
+    auto cmp = [] (region::impl* c1, region::impl* c2) {
+        if (c1->is_compactible() != c2->is_compactible()) {
+            return !c1->is_compactible();
+        }
+        return c2->min_occupancy() < c1->min_occupancy();
+    };
+
+    boost::range::make_heap(_regions, cmp);
+
+    size_t compacted = 0;
+    while (!_regions.empty()) {
+        boost::range::pop_heap(_regions, cmp);
+        region::impl* r = _regions.back();
+
+        if (!r->is_compactible() || r->min_occupancy().used_fraction() >= max_occupancy) {
+            boost::range::push_heap(_regions, cmp);
+            break;
+        }
+
+        r->compact();
+        ++compacted;
+
+        boost::range::push_heap(_regions, cmp);
+        if (need_preempt()) {
+            break;
+        }
+    }
+    llogger.debug("Compacted {} sparse segments", compacted);
+    return compacted;
+}
+
+tracker::segment_occupancy_histogram tracker::impl::segment_occupancy(bool evictable) const {
+    tracker::segment_occupancy_histogram hist{};
+    for (const region::impl* r : _regions) {
+        if (r->is_evictable() == evictable) {
+            r->add_segment_occupancy(hist);
+        }
+    }
+    return hist;
+}
+
 size_t tracker::impl::reclaim(size_t memory_to_release, is_preemptible preempt) {
     if (_reclaiming_disabled_depth) {
         return 0;
@@ -2790,6 +2876,15 @@ tracker::impl::impl() : _segment_pool(std::make_unique<logalloc::segment_pool>(*
         sm::make_gauge("occupancy", [this] { return region_occupancy().used_fraction() * 100; },
                        sm::description("Holds a current portion (in percents) of the used memory.")),
 
+        sm::make_gauge("huge_pages_owned", [this] { return _segment_pool->huge_pages_owned(); },
+                       sm::description("Holds a current number of 2MB pages spanned by LSA segments. Segments scattered over more pages than needed increase TLB misses.")),
+
+        sm::make_gauge("huge_page_occupancy", [this] {
+                            auto pages = _segment_pool->huge_pages_owned();
+                            return pages ? 100.0 * _segment_pool->owned_segments() * segment_size / (pages * huge_page_size) : 100.0;
+                        },
+                       sm::description("Holds a current portion (in percents) of the 2MB pages spanned by LSA segments which is covered by them.")),
+
         sm::make_counter("segments_compacted", [this] { return _segment_pool->statistics().segments_compacted; },
                         sm::description("Counts a number of compacted segments.")),
 
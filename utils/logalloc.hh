@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <array>
 #include <memory>
 #include <seastar/core/memory.hh>
 #include <seastar/core/condition-variable.hh>
@@ -136,6 +137,21 @@ class tracker {
 
     void reclaim_all_free_segments();
 
+    // Compacts segments of compactible regions, sparsest first, while they
+    // are used less than max_occupancy (a fraction), until the task quota is
+    // exhausted. Doesn't evict. Regions with reclaiming disabled are skipped.
+    // Returns the number of segments compacted, which is 0 if no compactible
+    // region has such segments left, and also if reclaiming is disabled on
+    // the shard, e.g. while the tracker is already compacting or reclaiming.
+    //
+    // Invalidates references to objects in all compactible and evictable regions.
+    size_t compact_sparse_segments(float max_occupancy);
+
+    // The number of closed segments of the evictable (cache) or the
+    // non-evictable (e.g. memtable) regions, by occupancy, in 10% wide buckets.
+    using segment_occupancy_histogram = std::array<uint64_t, 10>;
+    segment_occupancy_histogram segment_occupancy(bool evictable) const;
+
     occupancy_stats global_occupancy() const noexcept;
 
     // Returns aggregate statistics for all pools.
@@ -30,48 +30,65 @@ class chunked_content_stream {
 private:
     chunked_content _content;
     chunked_content::iterator _current_chunk;
-    // _count only needed for Tell(). 32 bits is enough, we don't allow
-    // more than 16 MB requests anyway.
-    unsigned _count;
+    // The current chunk, and the position in it, kept as pointers so that
+    // taking a character, which the parser does for every character of the
+    // document, doesn't touch the chunk itself. Unless at eof(), _pos is
+    // before _end.
+    const char* _chunk_begin = nullptr;
+    const char* _pos = nullptr;
+    const char* _end = nullptr;
+    // The size of the chunks before the current one, only needed for
+    // Tell(). 32 bits is enough, we don't allow more than 16 MB requests
+    // anyway.
+    unsigned _count = 0;
+
+    void start_chunk() {
+        if (eof()) {
+            _chunk_begin = _pos = _end = nullptr;
+        } else {
+            _chunk_begin = _pos = _current_chunk->get();
+            _end = _pos + _current_chunk->size();
+        }
+    }
+    void next_chunk() {
+        _count += _end - _chunk_begin;
+        *_current_chunk = temporary_buffer<char>();
+        ++_current_chunk;
+        start_chunk();
+    }
 public:
     typedef char Ch;
     chunked_content_stream(chunked_content&& content)
         : _content(std::move(content))
         , _current_chunk(_content.begin())
-    {}
+    {
+        start_chunk();
+    }
     bool eof() const {
         return _current_chunk == _content.end();
     }
     // Methods needed by rapidjson's Stream concept (see
     // https://rapidjson.org/classrapidjson_1_1_stream.html):
     char Peek() const {
-        if (eof()) {
-            // Rapidjson's Stream concept does not have the explicit notion of
-            // an "end of file". Instead, reading after the end of stream will
-            // return a null byte. This makes these streams appear like null-
-            // terminated C strings. It is good enough for reading JSON, which
-            // anyway can't include bare null characters.
-            return '\0';
-        } else {
-            return *_current_chunk->begin();
-        }
+        // Rapidjson's Stream concept does not have the explicit notion of
+        // an "end of file". Instead, reading after the end of stream will
+        // return a null byte. This makes these streams appear like null-
+        // terminated C strings. It is good enough for reading JSON, which
+        // anyway can't include bare null characters.
+        return _pos != _end ? *_pos : '\0';
     }
     char Take() {
-        if (eof()) {
+        if (_pos == _end) {
             return '\0';
-        } else {
-            char ret = *_current_chunk->begin();
-            _current_chunk->trim_front(1);
-            ++_count;
-            if (_current_chunk->empty()) {
-                *_current_chunk = temporary_buffer<char>();
-                ++_current_chunk;
-            }
-            return ret;
         }
+        char ret = *_pos++;
+        if (_pos == _end) {
+            next_chunk();
+        }
+        return ret;
     }
     size_t Tell() const {
-        return _count;
+        return _count + (_pos - _chunk_begin);
     }
     // Not used in input streams, but unfortunately we still need to implement
     Ch* PutBegin() { RAPIDJSON_ASSERT(false); return 0; }
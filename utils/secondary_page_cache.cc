@@ -0,0 +1,252 @@
+/*
+ * Copyright (C) 2022-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/metrics.hh>
+#include <seastar/core/seastar.hh>
+
+#include "utils/secondary_page_cache.hh"
+#include "utils/crc.hh"
+#include "log.hh"
+#include "seastarx.hh"
+
+namespace utils {
+
+static logging::logger spclog("secondary_page_cache");
+
+static uint32_t page_checksum(const char* data, size_t size) {
+    crc32 c;
+    c.process(reinterpret_cast<const uint8_t*>(data), size);
+    return c.get();
+}
+
+secondary_page_cache::secondary_page_cache(std::filesystem::path path, size_t size)
+    : _path(std::move(path))
+    , _slots(std::max<size_t>(size / page_size, 1))
+    , _writer_wakeup([this] { wake_up_writer(); })
+{
+    _buffers.reserve(max_pending_writes);
+    for (size_t i = 0; i < max_pending_writes; ++i) {
+        auto p = static_cast<char*>(::aligned_alloc(page_size, page_size));
+        if (!p) {
+            throw std::bad_alloc();
+        }
+        _buffers.emplace_back(p);
+        _free_buffers.push_back(p);
+    }
+    register_metrics();
+    _writer = run();
+    _writer_wakeup.arm_periodic(writer_wakeup_period);
+}
+
+secondary_page_cache::~secondary_page_cache() {
+    assert(_stopping);
+}
+
+future<> secondary_page_cache::stop() noexcept {
+    _stopping = true;
+    _ready = false;
+    _writer_wakeup.cancel();
+    _pending_cv.broadcast();
+    co_await std::move(_writer);
+    co_await _reads.close();
+    _pending.clear();
+    if (_file) {
+        try {
+            co_await _file.close();
+        } catch (...) {
+            spclog.warn("Failed to close {}: {}", _path.native(), std::current_exception());
+        }
+    }
+}
+
+future<> secondary_page_cache::run() {
+    try {
+        _file = co_await open_file_dma(_path.native(), open_flags::rw | open_flags::create | open_flags::truncate);
+        co_await _file.truncate(_slots.size() * page_size);
+    } catch (...) {
+        spclog.warn("Failed to create {}, disabling the secondary page cache: {}", _path.native(), std::current_exception());
+        co_return;
+    }
+    spclog.info("Using {} as a secondary page cache of {} pages", _path.native(), _slots.size());
+    _ready = !_stopping;
+    while (!_stopping) {
+        co_await _pending_cv.wait([this] { return _stopping || !_pending.empty(); });
+        auto batch = std::exchange(_pending, {});
+        for (auto& w : batch) {
+            if (!_stopping) {
+                co_await write(w);
+            }
+            _free_buffers.push_back(w.buf);
+        }
+    }
+}
+
+void secondary_page_cache::wake_up_writer() noexcept {
+    if (!_pending.empty()) {
+        _pending_cv.signal();
+    }
+}
+
+future<> secondary_page_cache::write(pending_write w) {
+    auto s = _next_slot++ % _slots.size();
+    release_slot(s);
+    try {
+        co_await _file.dma_write(s * page_size, w.buf, page_size);
+    } catch (...) {
+        ++_metrics.failed_writes;
+        spclog.debug("Failed to write slot {}: {}", s, std::current_exception());
+        co_return;
+    }
+    // The file may have been invalidated while writing.
+    auto it = _index.find(w.file);
+    if (it == _index.end()) {
+        co_return;
+    }
+    auto& sl = _slots[s];
+    sl.file = w.file;
+    sl.idx = w.idx;
+    sl.size = w.size;
+    sl.checksum = page_checksum(w.buf, w.size);
+    sl.valid = true;
+    it->second[w.idx] = s;
+    ++_metrics.writes;
+    _metrics.bytes_written += page_size;
+}
+
+std::optional<secondary_page_cache::slot_idx_type> secondary_page_cache::find_slot(file_id f, page_idx_type idx) const noexcept {
+    auto it = _index.find(f);
+    if (it == _index.end()) {
+        return std::nullopt;
+    }
+    auto pit = it->second.find(idx);
+    if (pit == it->second.end()) {
+        return std::nullopt;
+    }
+    return pit->second;
+}
+
+void secondary_page_cache::release_slot(slot_idx_type s) noexcept {
+    auto& sl = _slots[s];
+    if (sl.valid) {
+        auto it = _index.find(sl.file);
+        if (it != _index.end()) {
+            auto pit = it->second.find(sl.idx);
+            if (pit != it->second.end() && pit->second == s) {
+                it->second.erase(pit);
+            }
+        }
+    }
+    sl.valid = false;
+    ++sl.version;
+}
+
+secondary_page_cache::file_id secondary_page_cache::register_file() {
+    auto f = _next_file_id++;
+    _index.emplace(f, std::unordered_map<page_idx_type, slot_idx_type>());
+    return f;
+}
+
+void secondary_page_cache::invalidate(file_id f) noexcept {
+    auto it = _index.find(f);
+    if (it == _index.end()) {
+        return;
+    }
+    for (auto& [idx, s] : it->second) {
+        _slots[s].valid = false;
+        ++_slots[s].version;
+    }
+    _index.erase(it);
+    std::erase_if(_pending, [&] (const pending_write& w) {
+        if (w.file == f) {
+            _free_buffers.push_back(w.buf);
+            return true;
+        }
+        return false;
+    });
+}
+
+void secondary_page_cache::put(file_id f, page_idx_type idx, const char* data, size_t size) noexcept {
+    if (!_ready) {
+        return;
+    }
+    if (find_slot(f, idx)) {
+        // Still there since the page was last read from this tier.
+        return;
+    }
+    if (_free_buffers.empty() || size > page_size) {
+        ++_metrics.dropped_writes;
+        return;
+    }
+    auto buf = _free_buffers.back();
+    _free_buffers.pop_back();
+    std::copy_n(data, size, buf);
+    _pending.push_back(pending_write{f, idx, size, buf});
+}
+
+future<temporary_buffer<char>> secondary_page_cache::get(file_id f, page_idx_type idx, const io_priority_class& pc) {
+    // Lookups come with the misses which evict pages, write the pages queued
+    // so far without waiting for the timer.
+    wake_up_writer();
+    auto s = _ready ? find_slot(f, idx) : std::nullopt;
+    if (!s) {
+        ++_metrics.misses;
+        co_return temporary_buffer<char>();
+    }
+    auto version = _slots[*s].version;
+    auto holder = _reads.hold();
+    temporary_buffer<char> buf;
+    try {
+        buf = co_await _file.dma_read_exactly<char>(*s * page_size, page_size, pc);
+    } catch (...) {
+        ++_metrics.failed_reads;
+        spclog.debug("Failed to read slot {}: {}", *s, std::current_exception());
+        co_return temporary_buffer<char>();
+    }
+    auto& sl = _slots[*s];
+    if (!sl.valid || sl.version != version) {
+        ++_metrics.misses;
+        co_return temporary_buffer<char>();
+    }
+    buf.trim(sl.size);
+    if (page_checksum(buf.get(), buf.size()) != sl.checksum) {
+        ++_metrics.checksum_mismatches;
+        spclog.warn("Checksum mismatch in slot {} of {}, dropping it", *s, _path.native());
+        release_slot(*s);
+        co_return temporary_buffer<char>();
+    }
+    ++_metrics.hits;
+    _metrics.bytes_read += buf.size();
+    co_return buf;
+}
+
+void secondary_page_cache::register_metrics() {
+    namespace sm = seastar::metrics;
+    _metric_groups.add_group("sstables", {
+        sm::make_counter("index_page_secondary_cache_hits", _metrics.hits,
+            sm::description("Index page lookups served from the secondary page cache")),
+        sm::make_counter("index_page_secondary_cache_misses", _metrics.misses,
+            sm::description("Index page lookups missing in the secondary page cache")),
+        sm::make_counter("index_page_secondary_cache_writes", _metrics.writes,
+            sm::description("Evicted index pages written to the secondary page cache")),
+        sm::make_counter("index_page_secondary_cache_dropped_writes", _metrics.dropped_writes,
+            sm::description("Evicted index pages not written to the secondary page cache because of too many pending writes")),
+        sm::make_counter("index_page_secondary_cache_errors", [this] { return _metrics.failed_writes + _metrics.failed_reads + _metrics.checksum_mismatches; },
+            sm::description("Failed reads, writes and checksum mismatches of the secondary page cache")),
+        sm::make_counter("index_page_secondary_cache_bytes_written", _metrics.bytes_written,
+            sm::description("Bytes written to the secondary page cache")),
+        sm::make_counter("index_page_secondary_cache_bytes_read", _metrics.bytes_read,
+            sm::description("Bytes served from the secondary page cache")),
+        sm::make_gauge("index_page_secondary_cache_write_amplification", [this] {
+                return double(_metrics.bytes_written) / std::max<uint64_t>(_metrics.bytes_read, 1);
+            },
+            sm::description("Bytes written to the secondary page cache per byte served from it")),
+    });
+}
+
+} // namespace utils
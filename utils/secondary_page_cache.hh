@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2022-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <seastar/core/file.hh>
+#include <seastar/core/condition-variable.hh>
+#include <seastar/core/gate.hh>
+#include <seastar/core/metrics_registration.hh>
+#include <seastar/core/temporary_buffer.hh>
+#include <seastar/core/timer.hh>
+
+#include <boost/container/static_vector.hpp>
+
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace utils {
+
+/// \brief A second tier for cached_file pages, kept in a file on a local device.
+///
+/// Pages evicted from the in-memory page cache are written to fixed-size slots
+/// of the file, which are reused in FIFO order, and are read back from there on
+/// the next miss instead of going to the primary disk.
+///
+/// The contents are only valid for the lifetime of the process, so the slot map
+/// is kept in memory together with a CRC32 of each slot, which is validated on
+/// reads. Mismatching slots are dropped and read from the primary disk.
+///
+/// Evictions come from memory reclamation, so put() doesn't allocate. Pages are
+/// copied into a fixed pool of write buffers, pages evicted while the pool is
+/// exhausted are not written. Waking up the writer schedules a task, so put()
+/// leaves it to a timer and to get(), which run outside of reclamation.
+class secondary_page_cache {
+public:
+    static constexpr size_t page_size = 4096;
+    static constexpr size_t max_pending_writes = 64;
+    // How often the writer is woken up to write the pages queued by put().
+    static constexpr auto writer_wakeup_period = std::chrono::milliseconds(10);
+
+    // Identifies a file of which pages are cached.
+    using file_id = uint64_t;
+    using page_idx_type = uint64_t;
+
+    struct metrics {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t writes = 0;
+        uint64_t dropped_writes = 0;
+        uint64_t failed_writes = 0;
+        uint64_t failed_reads = 0;
+        uint64_t checksum_mismatches = 0;
+        uint64_t bytes_written = 0;
+        uint64_t bytes_read = 0;
+    };
+private:
+    using slot_idx_type = uint64_t;
+
+    struct slot {
+        file_id file = 0;
+        page_idx_type idx = 0;
+        uint32_t checksum = 0;
+        uint32_t size = 0;
+        // Bumped whenever the slot is reused, so that reads racing with
+        // a write to their slot can tell.
+        uint64_t version = 0;
+        bool valid = false;
+    };
+
+    struct pending_write {
+        file_id file;
+        page_idx_type idx;
+        size_t size;
+        char* buf;
+    };
+
+    struct buffer_deleter {
+        void operator()(char* p) const noexcept { ::free(p); }
+    };
+
+    std::filesystem::path _path;
+    std::vector<slot> _slots;
+    slot_idx_type _next_slot = 0;
+    // Slots holding the pages of each registered file.
+    std::unordered_map<file_id, std::unordered_map<page_idx_type, slot_idx_type>> _index;
+    file_id _next_file_id = 1;
+
+    std::vector<std::unique_ptr<char, buffer_deleter>> _buffers;
+    boost::container::static_vector<char*, max_pending_writes> _free_buffers;
+    boost::container::static_vector<pending_write, max_pending_writes> _pending;
+
+    seastar::file _file;
+    bool _ready = false;
+    bool _stopping = false;
+    seastar::condition_variable _pending_cv;
+    seastar::timer<seastar::lowres_clock> _writer_wakeup;
+    seastar::gate _reads;
+    seastar::future<> _writer = seastar::make_ready_future<>();
+
+    metrics _metrics;
+    seastar::metrics::metric_groups _metric_groups;
+private:
+    seastar::future<> run();
+    seastar::future<> write(pending_write w);
+    // Must not be called from memory reclamation.
+    void wake_up_writer() noexcept;
+    std::optional<slot_idx_type> find_slot(file_id f, page_idx_type idx) const noexcept;
+    void release_slot(slot_idx_type s) noexcept;
+    void register_metrics();
+public:
+    /// \brief Creates a tier of the given size in the file at path.
+    ///
+    /// The file is created (or truncated) in the background, until it is
+    /// ready, lookups miss and evicted pages are not written.
+    secondary_page_cache(std::filesystem::path path, size_t size);
+    ~secondary_page_cache();
+
+    secondary_page_cache(const secondary_page_cache&) = delete;
+    secondary_page_cache(secondary_page_cache&&) = delete;
+
+    /// \brief Waits for pending I/O and closes the file.
+    seastar::future<> stop() noexcept;
+
+    /// \brief Returns a new identifier for pages of a file.
+    ///
+    /// The caller must call invalidate() on it when the file is gone.
+    file_id register_file();
+
+    /// \brief Forgets all pages of the file.
+    void invalidate(file_id f) noexcept;
+
+    /// \brief Stores a page which is being evicted from memory.
+    ///
+    /// Doesn't allocate. The page may not be stored, e.g. when too many
+    /// writes are in flight.
+    void put(file_id f, page_idx_type idx, const char* data, size_t size) noexcept;
+
+    /// \brief Reads a page.
+    ///
+    /// Returns an empty buffer if the page is not present, or fails validation.
+    seastar::future<seastar::temporary_buffer<char>> get(file_id f, page_idx_type idx, const seastar::io_priority_class& pc);
+
+    /// \brief Returns true once the file is open and pages are stored.
+    bool ready() const noexcept {
+        return _ready;
+    }
+
+    const metrics& get_metrics() const noexcept {
+        return _metrics;
+    }
+};
+
+} // namespace utils
@@ -0,0 +1,215 @@
+/*
+ * Copyright (C) 2022-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <numbers>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+#include <seastar/core/byteorder.hh>
+
+#include "bytes.hh"
+
+namespace utils {
+
+/// A t-digest: an estimator of the quantiles of a distribution, with a bounded
+/// size, which can be merged with the t-digests of other samples of it.
+///
+/// The values added are clustered into centroids, which have a mean and a
+/// weight. The centroids near the extreme quantiles are kept small, so the
+/// estimates of these are more accurate than the ones of the median. There
+/// are at most compression centroids, so a digest takes at most 16 bytes times
+/// the compression, see Dunning and Ertl, "Computing Extremely Accurate
+/// Quantiles Using t-Digests".
+class tdigest {
+public:
+    struct centroid {
+        double mean;
+        double weight;
+    };
+private:
+    double _compression;
+    std::vector<centroid> _centroids;
+    // Values, or centroids of other digests, not yet merged into _centroids.
+    std::vector<centroid> _unmerged;
+    double _min = std::numeric_limits<double>::infinity();
+    double _max = -std::numeric_limits<double>::infinity();
+private:
+    // The k1 scale function, and its inverse.
+    double scale(double q) const {
+        return _compression / (2 * std::numbers::pi) * std::asin(2 * q - 1);
+    }
+    double inverse_scale(double k) const {
+        return (std::sin(std::min(k * 2 * std::numbers::pi / _compression, std::numbers::pi / 2)) + 1) / 2;
+    }
+    size_t unmerged_limit() const {
+        return std::max<size_t>(size_t(_compression) * 4, 64);
+    }
+public:
+    explicit tdigest(double compression = 100) : _compression(compression) {}
+
+    bool empty() const {
+        return _centroids.empty() && _unmerged.empty();
+    }
+
+    void add(double value, double weight = 1) {
+        if (std::isnan(value)) {
+            return;
+        }
+        _min = std::min(_min, value);
+        _max = std::max(_max, value);
+        _unmerged.push_back(centroid{value, weight});
+        if (_unmerged.size() >= unmerged_limit()) {
+            compress();
+        }
+    }
+
+    void merge(const tdigest& other) {
+        if (other.empty()) {
+            return;
+        }
+        _min = std::min(_min, other._min);
+        _max = std::max(_max, other._max);
+        _unmerged.insert(_unmerged.end(), other._centroids.begin(), other._centroids.end());
+        _unmerged.insert(_unmerged.end(), other._unmerged.begin(), other._unmerged.end());
+        compress();
+    }
+
+    /// Merges the values and centroids added into as few centroids as the
+    /// compression allows.
+    void compress() {
+        if (_unmerged.empty()) {
+            return;
+        }
+        _unmerged.insert(_unmerged.end(), _centroids.begin(), _centroids.end());
+        std::sort(_unmerged.begin(), _unmerged.end(), [] (const centroid& a, const centroid& b) { return a.mean < b.mean; });
+        double total = 0;
+        for (const auto& c : _unmerged) {
+            total += c.weight;
+        }
+        _centroids.clear();
+        auto cur = _unmerged.front();
+        double weight_so_far = 0;
+        double weight_limit = total * inverse_scale(scale(0) + 1);
+        for (auto it = std::next(_unmerged.begin()); it != _unmerged.end(); ++it) {
+            if (weight_so_far + cur.weight + it->weight <= weight_limit) {
+                cur.weight += it->weight;
+                cur.mean += (it->mean - cur.mean) * it->weight / cur.weight;
+            } else {
+                weight_so_far += cur.weight;
+                _centroids.push_back(cur);
+                weight_limit = total * inverse_scale(scale(weight_so_far / total) + 1);
+                cur = *it;
+            }
+        }
+        _centroids.push_back(cur);
+        _unmerged.clear();
+    }
+
+    /// The estimate of the q-quantile, for q in [0, 1], of the values added,
+    /// or nullopt if none were.
+    std::optional<double> quantile(double q) {
+        compress();
+        if (_centroids.empty()) {
+            return std::nullopt;
+        }
+        if (q <= 0) {
+            return _min;
+        }
+        if (q >= 1) {
+            return _max;
+        }
+        double total = 0;
+        for (const auto& c : _centroids) {
+            total += c.weight;
+        }
+        // The weight of a centroid is taken to be spread around its mean,
+        // which is at the middle of its weight, and the quantiles between
+        // the means are interpolated.
+        const double target = q * total;
+        double weight_so_far = 0;
+        for (size_t i = 0; i < _centroids.size(); ++i) {
+            const auto& c = _centroids[i];
+            const double mid = weight_so_far + c.weight / 2;
+            if (target < mid) {
+                if (i == 0) {
+                    return _min + (c.mean - _min) * target / mid;
+                }
+                const auto& prev = _centroids[i - 1];
+                const double prev_mid = weight_so_far - prev.weight / 2;
+                return prev.mean + (c.mean - prev.mean) * (target - prev_mid) / (mid - prev_mid);
+            }
+            weight_so_far += c.weight;
+        }
+        const auto& last = _centroids.back();
+        const double last_mid = total - last.weight / 2;
+        return last.mean + (_max - last.mean) * (target - last_mid) / (total - last_mid);
+    }
+
+    /// Serializes the digest, compressed, as its compression and the minimum
+    /// and maximum values added, followed by the mean and weight of every
+    /// centroid, all as big-endian doubles.
+    bytes serialize() const {
+        if (!_unmerged.empty()) {
+            auto compressed = *this;
+            compressed.compress();
+            return compressed.serialize();
+        }
+        bytes out(bytes::initialized_later(), sizeof(double) * (3 + 2 * _centroids.size()));
+        auto p = reinterpret_cast<char*>(out.begin());
+        auto put = [&p] (double v) {
+            write_be<uint64_t>(p, std::bit_cast<uint64_t>(v));
+            p += sizeof(uint64_t);
+        };
+        put(_compression);
+        put(_min);
+        put(_max);
+        for (const auto& c : _centroids) {
+            put(c.mean);
+            put(c.weight);
+        }
+        return out;
+    }
+
+    /// Deserializes the output of serialize().
+    ///
+    /// @exception std::invalid_argument the bytes are not in that format.
+    static tdigest deserialize(bytes_view in) {
+        if (in.size() < sizeof(double) * 3 || in.size() % (sizeof(double) * 2) != sizeof(double)) {
+            throw std::invalid_argument("invalid t-digest size");
+        }
+        auto p = reinterpret_cast<const char*>(in.begin());
+        auto get = [&p] {
+            auto v = std::bit_cast<double>(read_be<uint64_t>(p));
+            p += sizeof(uint64_t);
+            return v;
+        };
+        tdigest d(get());
+        if (!(d._compression >= 1)) {
+            throw std::invalid_argument("invalid t-digest compression");
+        }
+        d._min = get();
+        d._max = get();
+        const size_t centroids = (in.size() / sizeof(double) - 3) / 2;
+        d._centroids.reserve(centroids);
+        for (size_t i = 0; i < centroids; ++i) {
+            auto mean = get();
+            auto weight = get();
+            d._centroids.push_back(centroid{mean, weight});
+        }
+        return d;
+    }
+};
+
+} // namespace utils
@@ -0,0 +1,168 @@
+/*
+ * Copyright (C) 2022-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <optional>
+#include <utility>
+
+#include "utils/small_vector.hh"
+
+namespace utils {
+
+/// \brief A priority queue for merging sorted streams, as a tournament tree.
+///
+/// The values are held in slots, the leaves of a complete binary tree, each
+/// internal node of which records the winner, that is the slot with the
+/// smaller value, of the match between its two children. Pushing a value
+/// into a slot, or popping the winner out of its slot, replays the matches on
+/// the path from the slot to the root only, so that every operation costs
+/// exactly log2(capacity) comparisons, of which the ones against empty slots
+/// don't call the comparator. A binary heap takes up to twice as many
+/// comparisons to pop, with the number depending on the values, and moves the
+/// values around as it sifts them.
+///
+/// A slot freed by pop() is the first to be reused by push(), which keeps the
+/// values of a stream which keeps winning on the same path.
+///
+/// Values which compare equal are popped in no particular order.
+template <typename T, typename Less, size_t InlineCapacity = 4>
+class tournament_tree {
+    using index_type = uint32_t;
+
+    [[no_unique_address]] Less _less;
+    // The number of slots is zero or a power of two.
+    utils::small_vector<std::optional<T>, InlineCapacity> _slots;
+    // _winners[n] is the slot which won the match of internal node n. Node 1
+    // is the root, the children of node n are 2n and 2n+1, and node
+    // capacity() + s is the leaf of slot s. _winners[0] is unused.
+    utils::small_vector<index_type, InlineCapacity> _winners;
+    // Free slots, the most recently freed last.
+    utils::small_vector<index_type, InlineCapacity> _free;
+    size_t _size = 0;
+private:
+    index_type capacity() const noexcept {
+        return _slots.size();
+    }
+
+    index_type winner_of(index_type node) const noexcept {
+        return node >= capacity() ? node - capacity() : _winners[node];
+    }
+
+    index_type play(index_type a, index_type b) const {
+        if (!_slots[b]) {
+            return a;
+        }
+        if (!_slots[a]) {
+            return b;
+        }
+        return _less(*_slots[b], *_slots[a]) ? b : a;
+    }
+
+    void replay(index_type slot) {
+        for (auto node = (capacity() + slot) / 2; node > 0; node /= 2) {
+            _winners[node] = play(winner_of(2 * node), winner_of(2 * node + 1));
+        }
+    }
+
+    void grow() {
+        const index_type old_capacity = capacity();
+        const index_type new_capacity = old_capacity ? 2 * old_capacity : 2;
+        _slots.resize(new_capacity);
+        _winners.resize(new_capacity);
+        _free.reserve(new_capacity);
+        for (index_type s = new_capacity; s > old_capacity; --s) {
+            _free.push_back(s - 1);
+        }
+        // The leaves moved, so all matches are replayed.
+        for (index_type node = new_capacity - 1; node > 0; --node) {
+            _winners[node] = play(winner_of(2 * node), winner_of(2 * node + 1));
+        }
+    }
+
+    index_type top() const noexcept {
+        return capacity() > 1 ? _winners[1] : 0;
+    }
+public:
+    explicit tournament_tree(Less less = Less())
+        : _less(std::move(less))
+    { }
+
+    tournament_tree(tournament_tree&&) = default;
+    tournament_tree& operator=(tournament_tree&&) = default;
+
+    bool empty() const noexcept {
+        return _size == 0;
+    }
+
+    size_t size() const noexcept {
+        return _size;
+    }
+
+    /// The smallest value. The tree must not be empty.
+    const T& front() const noexcept {
+        assert(!empty());
+        return *_slots[top()];
+    }
+
+    T& front() noexcept {
+        assert(!empty());
+        return *_slots[top()];
+    }
+
+    void push(T value) {
+        if (_free.empty()) {
+            grow();
+        }
+        auto slot = _free.back();
+        _free.pop_back();
+        _slots[slot].emplace(std::move(value));
+        ++_size;
+        replay(slot);
+    }
+
+    /// Removes and returns the smallest value. The tree must not be empty.
+    T pop() {
+        assert(!empty());
+        auto slot = top();
+        T value = std::move(*_slots[slot]);
+        _slots[slot].reset();
+        --_size;
+        _free.push_back(slot);
+        replay(slot);
+        return value;
+    }
+
+    /// Calls func with every value, in no particular order.
+    template <typename Func>
+    void for_each(Func&& func) const {
+        for (auto& slot : _slots) {
+            if (slot) {
+                func(*slot);
+            }
+        }
+    }
+
+    /// Removes all values, keeping the capacity.
+    void clear() noexcept {
+        if (empty()) {
+            return;
+        }
+        _free.clear();
+        for (index_type s = capacity(); s > 0; --s) {
+            _slots[s - 1].reset();
+            _free.push_back(s - 1);
+        }
+        // All slots are empty, so any winner of its subtree is valid.
+        _size = 0;
+    }
+};
+
+}
@@ -50,6 +50,12 @@ struct unsigned_vint final {
     static value_type deserialize(bytes_view v);
 
     static vint_size_type serialized_size_from_first_byte(bytes::value_type first_byte);
+
+    // Decodes a vint which is a single byte, i.e. one whose first byte has the
+    // most significant bit clear.
+    static value_type deserialize_single_byte(bytes::value_type first_byte) noexcept {
+        return value_type(first_byte);
+    }
 };
 
 struct signed_vint final {
@@ -62,4 +68,9 @@ struct signed_vint final {
     static value_type deserialize(bytes_view v);
 
     static vint_size_type serialized_size_from_first_byte(bytes::value_type first_byte);
+
+    static value_type deserialize_single_byte(bytes::value_type first_byte) noexcept {
+        const auto n = unsigned_vint::deserialize_single_byte(first_byte);
+        return static_cast<value_type>((n >> 1) ^ -(n & 1));
+    }
 };
@@ -7,20 +7,55 @@
  */
 
 #include <seastar/core/aligned_buffer.hh>
+#include <seastar/core/coroutine.hh>
 
 // We need to use experimental features of the zstd library (to allocate compression/decompression context),
 // which are available only when the library is linked statically.
 #define ZSTD_STATIC_LINKING_ONLY
 #include "zstd.h"
+#include "zdict.h"
 
 #include "compress.hh"
+#include "utils/alien_thread.hh"
+#include "utils/base64.hh"
 #include "utils/class_registrator.hh"
 
 static const sstring COMPRESSION_LEVEL = "compression_level";
+// Size of the dictionary to train from the beginning of each sstable, 0 disables training.
+static const sstring DICTIONARY_SIZE_KB = "dictionary_size_kb";
+// The trained dictionary, base64 encoded. Stored in CompressionInfo and not
+// settable by the user.
+static const sstring DICTIONARY = "dictionary";
 static const sstring COMPRESSOR_NAME = compressor::namespace_prefix + "ZstdCompressor";
 
+// Options are stored as strings with a 16-bit length, and the dictionary is
+// base64 encoded on top of that.
+static constexpr size_t max_dictionary_size_kb = 32;
+// The dictionary is trained on this many times its size of uncompressed data.
+static constexpr size_t dictionary_sample_ratio = 64;
+// Chunks are cut into samples of this size for training, which is closer to
+// the size of the rows which repeat in the data than a whole chunk is.
+static constexpr size_t dictionary_sample_size = 1024;
+
+struct zstd_cdict_deleter {
+    void operator()(ZSTD_CDict* d) const noexcept { ZSTD_freeCDict(d); }
+};
+
+struct zstd_ddict_deleter {
+    void operator()(ZSTD_DDict* d) const noexcept { ZSTD_freeDDict(d); }
+};
+
 class zstd_processor : public compressor {
     int _compression_level = 3;
+    int _chunk_len;
+    size_t _dictionary_size = 0;
+
+    // Trained dictionary, empty if none.
+    std::vector<char> _dictionary;
+    // Digested forms of _dictionary, created on first use since a reader
+    // needs only the decompression one and a writer only the compression one.
+    mutable std::unique_ptr<ZSTD_CDict, zstd_cdict_deleter> _cdict;
+    mutable std::unique_ptr<ZSTD_DDict, zstd_ddict_deleter> _ddict;
 
     // Manages memory for the compression context.
     std::unique_ptr<char[], free_deleter> _cctx_raw;
@@ -42,6 +77,9 @@ class zstd_processor : public compressor {
 
     std::set<sstring> option_names() const override;
     std::map<sstring, sstring> options() const override;
+
+    size_t dictionary_training_size() const override;
+    future<ptr_type> train_dictionary(const std::vector<temporary_buffer<char>>& samples) const override;
 };
 
 zstd_processor::zstd_processor(const opt_getter& opts)
@@ -71,9 +109,32 @@ zstd_processor::zstd_processor(const opt_getter& opts)
        // This parameter has already been validated.
        ? std::stoi(*chunk_len_kb) * 1024
        : compression_parameters::DEFAULT_CHUNK_LENGTH;
+    _chunk_len = chunk_len;
+
+    auto dictionary_size_kb = opts(DICTIONARY_SIZE_KB);
+    if (dictionary_size_kb) {
+        size_t kb;
+        try {
+            kb = std::stoul(*dictionary_size_kb);
+        } catch (const std::exception& e) {
+            throw exceptions::syntax_exception(
+                format("Invalid integer value {} for {}", *dictionary_size_kb, DICTIONARY_SIZE_KB));
+        }
+        if (kb > max_dictionary_size_kb) {
+            throw exceptions::configuration_exception(
+                format("{} must be between 0 and {}, got {}", DICTIONARY_SIZE_KB, max_dictionary_size_kb, kb));
+        }
+        _dictionary_size = kb * 1024;
+    }
+
+    auto dictionary = opts(DICTIONARY);
+    if (dictionary) {
+        auto b = base64_decode(*dictionary);
+        _dictionary.assign(reinterpret_cast<const char*>(b.data()), reinterpret_cast<const char*>(b.data()) + b.size());
+    }
 
     // We assume that the uncompressed input length is always <= chunk_len.
-    auto cparams = ZSTD_getCParams(_compression_level, chunk_len, 0);
+    auto cparams = ZSTD_getCParams(_compression_level, chunk_len, _dictionary.size());
     auto cctx_size = ZSTD_estimateCCtxSize_usingCParams(cparams);
     // According to the ZSTD documentation, pointer to the context buffer must be 8-bytes aligned.
     _cctx_raw = allocate_aligned_buffer<char>(cctx_size, 8);
@@ -91,7 +152,18 @@ zstd_processor::zstd_processor(const opt_getter& opts)
 }
 
 size_t zstd_processor::uncompress(const char* input, size_t input_len, char* output, size_t output_len) const {
-    auto ret = ZSTD_decompressDCtx(_dctx, output, output_len, input, input_len);
+    size_t ret;
+    if (_dictionary.empty()) {
+        ret = ZSTD_decompressDCtx(_dctx, output, output_len, input, input_len);
+    } else {
+        if (!_ddict) {
+            _ddict.reset(ZSTD_createDDict_byReference(_dictionary.data(), _dictionary.size()));
+            if (!_ddict) {
+                throw std::runtime_error("Unable to create ZSTD decompression dictionary");
+            }
+        }
+        ret = ZSTD_decompress_usingDDict(_dctx, output, output_len, input, input_len, _ddict.get());
+    }
     if (ZSTD_isError(ret)) {
         throw std::runtime_error( format("ZSTD decompression failure: {}", ZSTD_getErrorName(ret)));
     }
@@ -100,7 +172,21 @@ size_t zstd_processor::uncompress(const char* input, size_t input_len, char* out
 
 
 size_t zstd_processor::compress(const char* input, size_t input_len, char* output, size_t output_len) const {
-    auto ret = ZSTD_compressCCtx(_cctx, output, output_len, input, input_len, _compression_level);
+    size_t ret;
+    if (_dictionary.empty()) {
+        ret = ZSTD_compressCCtx(_cctx, output, output_len, input, input_len, _compression_level);
+    } else {
+        if (!_cdict) {
+            // Use the same parameters the static context was sized for.
+            auto cparams = ZSTD_getCParams(_compression_level, _chunk_len, _dictionary.size());
+            _cdict.reset(ZSTD_createCDict_advanced(_dictionary.data(), _dictionary.size(),
+                    ZSTD_dlm_byRef, ZSTD_dct_auto, cparams, ZSTD_defaultCMem));
+            if (!_cdict) {
+                throw std::runtime_error("Unable to create ZSTD compression dictionary");
+            }
+        }
+        ret = ZSTD_compress_usingCDict(_cctx, output, output_len, input, input_len, _cdict.get());
+    }
     if (ZSTD_isError(ret)) {
         throw std::runtime_error( format("ZSTD compression failure: {}", ZSTD_getErrorName(ret)));
     }
@@ -112,11 +198,61 @@ size_t zstd_processor::compress_max_size(size_t input_len) const {
 }
 
 std::set<sstring> zstd_processor::option_names() const {
-    return {COMPRESSION_LEVEL};
+    return {COMPRESSION_LEVEL, DICTIONARY_SIZE_KB};
 }
 
 std::map<sstring, sstring> zstd_processor::options() const {
-    return {{COMPRESSION_LEVEL, std::to_string(_compression_level)}};
+    std::map<sstring, sstring> ret{{COMPRESSION_LEVEL, std::to_string(_compression_level)}};
+    if (_dictionary_size) {
+        ret.emplace(DICTIONARY_SIZE_KB, std::to_string(_dictionary_size / 1024));
+    }
+    if (!_dictionary.empty()) {
+        ret.emplace(DICTIONARY, base64_encode(bytes_view(reinterpret_cast<const int8_t*>(_dictionary.data()), _dictionary.size())));
+    }
+    return ret;
+}
+
+size_t zstd_processor::dictionary_training_size() const {
+    return _dictionary.empty() ? _dictionary_size * dictionary_sample_ratio : 0;
+}
+
+future<compressor::ptr_type> zstd_processor::train_dictionary(const std::vector<temporary_buffer<char>>& samples) const {
+    if (!_dictionary_size || !_dictionary.empty()) {
+        co_return ptr_type();
+    }
+
+    std::vector<char> sample_data;
+    std::vector<size_t> sample_sizes;
+    for (auto& s : samples) {
+        sample_data.insert(sample_data.end(), s.begin(), s.end());
+        for (size_t pos = 0; pos < s.size(); pos += dictionary_sample_size) {
+            sample_sizes.push_back(std::min(dictionary_sample_size, s.size() - pos));
+        }
+    }
+
+    // Training takes tens of milliseconds even on small samples, and can't be
+    // preempted, so it runs in a thread of its own. It only touches the
+    // buffers, which stay alive on this frame.
+    std::vector<char> dictionary(_dictionary_size);
+    auto ret = co_await utils::run_in_alien_thread([&] () noexcept {
+        return ZDICT_trainFromBuffer(dictionary.data(), dictionary.size(), sample_data.data(), sample_sizes.data(), sample_sizes.size());
+    });
+    if (ZDICT_isError(ret)) {
+        // Typically there's not enough data to train on, e.g. for small sstables.
+        co_return ptr_type();
+    }
+    dictionary.resize(ret);
+
+    auto opts = options();
+    opts.emplace(DICTIONARY, base64_encode(bytes_view(reinterpret_cast<const int8_t*>(dictionary.data()), dictionary.size())));
+    opts.emplace(compression_parameters::CHUNK_LENGTH_KB, std::to_string(_chunk_len / 1024));
+    co_return seastar::make_shared<zstd_processor>([&opts] (const sstring& key) -> opt_string {
+        auto i = opts.find(key);
+        if (i == opts.end()) {
+            return std::nullopt;
+        }
+        return i->second;
+    });
 }
 
 static const class_registrator<compressor, zstd_processor, const compressor::opt_getter&>